@@ -0,0 +1,225 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file EpochRing.hpp
+ * A fixed-capacity, time-ordered ring buffer of epochs of data.
+ */
+
+#ifndef GNSSTK_EPOCHRING_HPP
+#define GNSSTK_EPOCHRING_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "CommonTime.hpp"
+#include "Exception.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup ClockModel
+      //@{
+
+      /**
+       * A time history of epochs of data (e.g. ObsEpoch or ORDEpoch)
+       * for the streaming case, where epochs arrive in time order and
+       * only the most recent ones are needed. It holds at most
+       * capacity() epochs; adding a new epoch to a full ring discards
+       * the oldest, and its storage is reused. Epochs are found by
+       * time with a binary search, so it can stand in for the
+       * std::map-based ObsEpochMap and ORDEpochMap where those are
+       * used as a sliding window.
+       *
+       * Index 0 is the oldest epoch held.
+       */
+   template <class T>
+   class EpochRing
+   {
+   public:
+         /** Constructor.
+          * @param[in] cap maximum number of epochs held, > 0.
+          * @throw InvalidParameter if cap is 0. */
+      explicit EpochRing(size_t cap)
+            : slots(cap), times(cap), head(0), count(0)
+      {
+         if (cap == 0)
+         {
+            InvalidParameter e("EpochRing capacity must be positive");
+            GNSSTK_THROW(e);
+         }
+      }
+
+         /// Return the number of epochs held.
+      size_t size() const
+      { return count; }
+
+         /// Return the maximum number of epochs held.
+      size_t capacity() const
+      { return slots.size(); }
+
+         /// Return true if no epochs are held.
+      bool empty() const
+      { return count == 0; }
+
+         /// Discard all epochs.
+      void clear()
+      { head = count = 0; }
+
+         /** Return the epoch for time t, creating an empty one if there
+          * is none, like std::map::operator[]. A new epoch must be
+          * later than all those held; if the ring is full the oldest
+          * is discarded.
+          * @throw InvalidRequest if t is new and not later than back(). */
+      T& operator[](const CommonTime& t)
+      {
+         if (count > 0 && !(times[phys(count-1)] < t))
+         {
+            T *p = find(t);
+            if (p == NULL)
+            {
+               InvalidRequest e("EpochRing epochs must be added in time"
+                                " order");
+               GNSSTK_THROW(e);
+            }
+            return *p;
+         }
+         size_t i;
+         if (count < slots.size())
+         {
+            i = phys(count);
+            count++;
+         }
+         else
+         {
+            i = head;
+            head = phys(1);
+         }
+         times[i] = t;
+         slots[i] = T();
+         return slots[i];
+      }
+
+         /// Return the epoch at time t, or NULL if there is none.
+      T* find(const CommonTime& t)
+      {
+         size_t i = lowerBound(t);
+         if (i < count && times[phys(i)] == t)
+            return &slots[phys(i)];
+         return NULL;
+      }
+
+         /// Return the epoch at time t, or NULL if there is none.
+      const T* find(const CommonTime& t) const
+      {
+         size_t i = lowerBound(t);
+         if (i < count && times[phys(i)] == t)
+            return &slots[phys(i)];
+         return NULL;
+      }
+
+         /// Return the index of the first epoch not earlier than t, or
+         /// size() if there is none.
+      size_t lowerBound(const CommonTime& t) const
+      {
+         size_t lo(0), hi(count);
+         while (lo < hi)
+         {
+            size_t mid = lo + (hi - lo) / 2;
+            if (times[phys(mid)] < t)
+               lo = mid + 1;
+            else
+               hi = mid;
+         }
+         return lo;
+      }
+
+         /// Return the i-th oldest epoch.
+      T& at(size_t i)
+      { return slots[phys(checked(i))]; }
+
+         /// Return the i-th oldest epoch.
+      const T& at(size_t i) const
+      { return slots[phys(checked(i))]; }
+
+         /// Return the time of the i-th oldest epoch.
+      const CommonTime& timeAt(size_t i) const
+      { return times[phys(checked(i))]; }
+
+         /// Return the oldest epoch.
+      T& front()
+      { return at(0); }
+
+         /// Return the most recent epoch.
+      T& back()
+      { return at(count-1); }
+
+         /// Discard epochs earlier than t.
+      void eraseBefore(const CommonTime& t)
+      {
+         size_t n = lowerBound(t);
+         head = phys(n);
+         count -= n;
+      }
+
+   private:
+         /// Convert an index from the oldest to an index into slots.
+      size_t phys(size_t i) const
+      { return (head + i) % slots.size(); }
+
+         /// @throw InvalidRequest if i is out of range
+      size_t checked(size_t i) const
+      {
+         if (i >= count)
+         {
+            InvalidRequest e("EpochRing index out of range");
+            GNSSTK_THROW(e);
+         }
+         return i;
+      }
+
+      std::vector<T> slots;             ///< the epochs
+      std::vector<CommonTime> times;    ///< the time of each slot
+      size_t head;                      ///< slot of the oldest epoch
+      size_t count;                     ///< number of epochs held
+   };
+
+      //@}
+
+} // namespace
+
+#endif
@@ -0,0 +1,241 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file ORDBatch.cpp
+ * Observed range deviations of all the satellites of one receiver epoch.
+ */
+
+#include "ORDBatch.hpp"
+#include "YDSTime.hpp"
+
+namespace gnsstk
+{
+   ORDBatch::ORDBatch(
+      NavLibrary& nl,
+      EllipsoidModel& ell,
+      bool svt,
+      NavSearchOrder ord,
+      SVHealth xh,
+      NavValidityType val)
+         : haveIono(false), navLib(nl), em(ell), svTime(svt), order(ord),
+           xmitHealth(xh), validity(val), userTrop(NULL), ionoStore(NULL),
+           ionoBand(CarrierBand::L1), lastDoy(-1), haveGeo(false)
+   {
+   }
+
+
+   static bool samePosition(const Position& a, const Position& b)
+   {
+      return (a.getCoordinateSystem() == b.getCoordinateSystem() &&
+              a[0] == b[0] && a[1] == b[1] && a[2] == b[2]);
+   }
+
+
+   void ORDBatch::prepare(const CommonTime& t, const Position& rxpos, size_t n)
+   {
+      time = t;
+      sat.resize(n);
+      valid.assign(n, 0);
+      ord.assign(n, 0.0);
+      rho.assign(n, 0.0);
+      iono.assign(n, 0.0);
+      trop.assign(n, 0.0);
+      azimuth.assign(n, 0.0f);
+      elevation.assign(n, 0.0f);
+      health.assign(n, vshort());
+      iodc.assign(n, vshort());
+
+      bool newRx(!haveGeo || !samePosition(rxpos, lastRx));
+      if (newRx)
+      {
+         lastRx = rxpos;
+         gx = rxpos;
+         gx.asGeodetic(&em);
+         haveGeo = true;
+      }
+      if (userTrop == NULL)
+      {
+         int doy(static_cast<YDSTime>(t).doy);
+         if (newRx || doy != lastDoy)
+         {
+            nbTrop = NBTropModel(gx.getAltitude(),
+                                 gx.getGeodeticLatitude(),
+                                 doy);
+            lastDoy = doy;
+         }
+      }
+   }
+
+
+   void ORDBatch::computeRange(size_t i, double obs, const Position& rxpos)
+   {
+      // as in ObsRngDev::computeOrdRx() and computeOrdTx()
+      if (svTime)
+      {
+         rho[i] = cer.ComputeAtTransmitSvTime(time, obs, rxpos, sat[i],
+                                              navLib, order, xmitHealth,
+                                              validity);
+      }
+      else
+      {
+         rho[i] = cer.ComputeAtTransmitTime(time, obs, rxpos, sat[i],
+                                            navLib, order, xmitHealth,
+                                            validity);
+         iodc[i] = cer.iodc;
+         health[i] = cer.health;
+      }
+      azimuth[i] = cer.azimuth;
+      elevation[i] = cer.elevation;
+      ord[i] = obs - rho[i];
+
+      // as in ObsRngDev::computeTrop()
+      const TropModel& tm(userTrop ? *userTrop : nbTrop);
+      trop[i] = tm.correction(elevation[i]);
+      ord[i] -= trop[i];
+   }
+
+
+   size_t ORDBatch::compute(const CommonTime& t,
+                            const Position& rxpos,
+                            const std::vector<SatID>& sats,
+                            const std::vector<double>& prange)
+   {
+      if (sats.size() != prange.size())
+      {
+         InvalidParameter e("ORDBatch: satellites and pseudoranges differ"
+                            " in size");
+         GNSSTK_THROW(e);
+      }
+      prepare(t, rxpos, sats.size());
+      haveIono = (ionoStore != NULL);
+
+      size_t nvalid(0);
+      for (size_t i = 0; i < sats.size(); i++)
+      {
+         sat[i] = sats[i];
+         try
+         {
+            computeRange(i, prange[i], rxpos);
+         }
+         catch (InvalidRequest& e)
+         {
+            continue;
+         }
+         if (ionoStore)
+         {
+            iono[i] = ionoStore->getCorrection(time, gx, elevation[i],
+                                               azimuth[i], ionoBand);
+            ord[i] -= iono[i];
+         }
+         valid[i] = 1;
+         nvalid++;
+      }
+      return nvalid;
+   }
+
+
+   size_t ORDBatch::computeDual(const CommonTime& t,
+                                const Position& rxpos,
+                                const std::vector<SatID>& sats,
+                                const std::vector<double>& prange1,
+                                const std::vector<double>& prange2,
+                                double gamma)
+   {
+      if (sats.size() != prange1.size() || sats.size() != prange2.size())
+      {
+         InvalidParameter e("ORDBatch: satellites and pseudoranges differ"
+                            " in size");
+         GNSSTK_THROW(e);
+      }
+      prepare(t, rxpos, sats.size());
+      haveIono = true;
+
+      size_t nvalid(0);
+      for (size_t i = 0; i < sats.size(); i++)
+      {
+         sat[i] = sats[i];
+         // for dual-frequency see IS-GPS-200, section 20.3.3.3.3.3
+         double icpr = (prange2[i] - gamma * prange1[i])/(1-gamma);
+         iono[i] = prange1[i] - icpr;
+         try
+         {
+            computeRange(i, icpr, rxpos);
+         }
+         catch (InvalidRequest& e)
+         {
+            continue;
+         }
+         valid[i] = 1;
+         nvalid++;
+      }
+      return nvalid;
+   }
+
+
+   ObsRngDev ORDBatch::getORD(size_t i) const
+   {
+      ObsRngDev rv;
+      rv.obstime = time;
+      rv.svid = sat[i];
+      rv.ord = ord[i];
+      rv.wonky = 0;
+      rv.azimuth = azimuth[i];
+      rv.elevation = elevation[i];
+      rv.health = health[i];
+      rv.iodc = iodc[i];
+      rv.rho = rho[i];
+      if (haveIono)
+         rv.iono = iono[i];
+      rv.trop = trop[i];
+      return rv;
+   }
+
+
+   void ORDBatch::getORDEpoch(ORDEpoch& oe) const
+   {
+      oe.ords.clear();
+      oe.time = time;
+      oe.wonky = false;
+      oe.clockOffset = vdouble();
+      oe.clockResidual = vdouble();
+      for (size_t i = 0; i < sat.size(); i++)
+         if (valid[i])
+            oe.ords[sat[i]] = getORD(i);
+   }
+}
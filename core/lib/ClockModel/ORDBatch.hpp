@@ -0,0 +1,222 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file ORDBatch.hpp
+ * Observed range deviations of all the satellites of one receiver epoch.
+ */
+
+#ifndef ORDBATCH_HPP
+#define ORDBATCH_HPP
+
+#include <vector>
+
+#include "CommonTime.hpp"
+#include "EphemerisRange.hpp"
+#include "IonoModelStore.hpp"
+#include "NBTropModel.hpp"
+#include "NavLibrary.hpp"
+#include "ORDEpoch.hpp"
+#include "Position.hpp"
+#include "SatID.hpp"
+#include "TropModel.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup ClockModel
+      //@{
+
+      /**
+       * Compute the observed range deviations (ORDs) of all the
+       * satellites seen by one receiver at one epoch, leaving the
+       * results in arrays parallel to the input satellites.
+       *
+       * The results are those of constructing an ObsRngDev for each
+       * satellite with the same arguments, but the work that does not
+       * depend on the satellite is done once per epoch rather than
+       * once per ORD: the geodetic receiver position, the default
+       * (NB) trop model, which only changes with the receiver position
+       * and day of year, and the range computation object. Output
+       * arrays are reused from epoch to epoch.
+       *
+       * A satellite for which there is no ephemeris does not stop the
+       * epoch (ObsRngDev throws); it is marked in the valid array.
+       *
+       * @code
+       * ORDBatch batch(navLib, em);
+       * batch.setIonoModel(&ionoStore, CarrierBand::L1);
+       * for each epoch:
+       *    batch.compute(time, rxpos, sats, pranges);
+       *    batch.getORDEpoch(oe);
+       * @endcode
+       */
+   class ORDBatch
+   {
+   public:
+         /**
+          * @param[in] navLib A store of either broadcast or precise
+          *   ephemerides.
+          * @param[in] em An EllipsoidModel for the geodetic receiver
+          *   position used by the default trop model and iono model.
+          * @param[in] svTime True if pseudoranges are in SV time,
+          *   false for RX time.
+          * @param[in] order Specify whether to search by receiver
+          *   behavior or by nearest to when in time.
+          * @param[in] xmitHealth The desired health status of the
+          *   satellite transmitting the nav data.
+          * @param[in] valid Specify whether to search only for valid
+          *   or invalid messages, or both.
+          */
+      ORDBatch(NavLibrary& navLib,
+               EllipsoidModel& em,
+               bool svTime = false,
+               NavSearchOrder order = NavSearchOrder::User,
+               SVHealth xmitHealth = SVHealth::Any,
+               NavValidityType valid = NavValidityType::ValidOnly);
+
+         /**
+          * Use a user-specified trop model; NULL (the default) selects
+          * an NBTropModel for the receiver position and day of year.
+          * The model must outlive the batch.
+          */
+      void setTropModel(const TropModel* tm)
+      { userTrop = tm; }
+
+         /**
+          * Apply a single-frequency nav-message based iono correction on
+          * the given band; NULL (the default) applies none. The store
+          * must outlive the batch. Not used by computeDual().
+          */
+      void setIonoModel(const IonoModelStore* ion,
+                        CarrierBand band = CarrierBand::L1)
+      { ionoStore = ion; ionoBand = band; }
+
+         /**
+          * Compute the ORDs of one epoch of single-frequency
+          * pseudoranges.
+          * @param[in] time The time of the observations.
+          * @param[in] rxpos The earth-centered, earth-fixed receiver
+          *   position.
+          * @param[in] sats The satellites observed.
+          * @param[in] prange The pseudoranges, parallel to sats.
+          * @return the number of valid ORDs.
+          * @throw InvalidParameter if the arrays differ in size.
+          * @throw Exception from the iono model (e.g. none for time).
+          */
+      size_t compute(const CommonTime& time,
+                     const Position& rxpos,
+                     const std::vector<SatID>& sats,
+                     const std::vector<double>& prange);
+
+         /**
+          * Compute the ORDs of one epoch of dual-frequency
+          * pseudoranges, with the dual-frequency iono correction.
+          * @param[in] time The time of the observations.
+          * @param[in] rxpos The earth-centered, earth-fixed receiver
+          *   position.
+          * @param[in] sats The satellites observed.
+          * @param[in] prange1 Pseudoranges on the first carrier.
+          * @param[in] prange2 Pseudoranges on the second carrier.
+          * @param[in] gamma \f$\gamma_{12} = (f_{1}/f_{2})^2\f$
+          * @return the number of valid ORDs.
+          * @throw InvalidParameter if the arrays differ in size.
+          */
+      size_t computeDual(const CommonTime& time,
+                         const Position& rxpos,
+                         const std::vector<SatID>& sats,
+                         const std::vector<double>& prange1,
+                         const std::vector<double>& prange2,
+                         double gamma = GAMMA_GPS);
+
+         /// Return the number of satellites in the last epoch computed.
+      size_t size() const
+      { return sat.size(); }
+
+         /// Return the i-th result of the last epoch as an ObsRngDev.
+      ObsRngDev getORD(size_t i) const;
+
+         /**
+          * Replace the contents of an ORDEpoch with the valid ORDs of
+          * the last epoch computed, for use with ObsClockModel.
+          */
+      void getORDEpoch(ORDEpoch& oe) const;
+
+         // Results of the last epoch, parallel to the input satellites.
+      CommonTime time;               ///< time of the epoch
+      std::vector<SatID> sat;        ///< satellites
+      std::vector<char> valid;       ///< 1 if the ORD was computed
+      std::vector<double> ord;       ///< observed range deviations
+      std::vector<double> rho;       ///< expected geometric range
+      std::vector<double> iono;      ///< iono correction, if any
+      std::vector<double> trop;      ///< trop correction
+      std::vector<float> azimuth;    ///< SV azimuth (degrees)
+      std::vector<float> elevation;  ///< SV elevation (degrees)
+      std::vector<vshort> health;    ///< SV health bits (RX time only)
+      std::vector<vshort> iodc;      ///< ephemeris IODC (RX time only)
+      bool haveIono;                 ///< true if iono is set
+
+   private:
+         /// Set up the per-epoch state and size the arrays.
+      void prepare(const CommonTime& t, const Position& rxpos, size_t n);
+
+         /// Compute the range part of the ORD of satellite i.
+      void computeRange(size_t i, double obs, const Position& rxpos);
+
+      NavLibrary& navLib;
+      EllipsoidModel& em;
+      bool svTime;
+      NavSearchOrder order;
+      SVHealth xmitHealth;
+      NavValidityType validity;
+      const TropModel* userTrop;
+      const IonoModelStore* ionoStore;
+      CarrierBand ionoBand;
+
+         // per-epoch state, kept while the receiver and day don't change
+      CorrectedEphemerisRange cer;
+      Position lastRx;           ///< receiver position of gx and nbTrop
+      Position gx;               ///< lastRx, geodetic
+      int lastDoy;               ///< day of year of nbTrop
+      bool haveGeo;              ///< gx is valid
+      NBTropModel nbTrop;        ///< default trop model, for lastRx, lastDoy
+   };
+
+      //@}
+}
+
+#endif
@@ -46,6 +46,7 @@
 #define ORDEPOCH_HPP
 
 #include <map>
+#include "EpochRing.hpp"
 #include "Exception.hpp"
 #include "ObsRngDev.hpp"
 #include "ClockModel.hpp"
@@ -113,6 +114,9 @@ namespace gnsstk
       // this is a store of ORDs over time
    typedef std::map<gnsstk::CommonTime, gnsstk::ORDEpoch> ORDEpochMap;
 
+      // this is a bounded store of the most recent ORDs, for streaming use
+   typedef EpochRing<gnsstk::ORDEpoch> ORDEpochRing;
+
       //@}
 }
 #endif
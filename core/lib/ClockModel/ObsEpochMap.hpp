@@ -48,6 +48,7 @@
 #include <iostream>
 
 #include "CommonTime.hpp"
+#include "EpochRing.hpp"
 #include "SvObsEpoch.hpp"
 
 namespace gnsstk
@@ -66,6 +67,10 @@ namespace gnsstk
       /// A time history of the observations collected from a single receiver.
    typedef std::map<CommonTime, ObsEpoch> ObsEpochMap;
 
+      /// A bounded time history of the most recent observations collected
+      /// from a single receiver, for streaming use.
+   typedef EpochRing<ObsEpoch> ObsEpochRing;
+
    std::ostream& operator<<(std::ostream& s, const ObsEpoch& oe) noexcept;
 
       //@}
@@ -36,8 +36,10 @@
 //
 //==============================================================================
 
+#include <mutex>
 #include "TimeString.hpp"
 #include "FileSpecFind.hpp"
+#include "FileSpecIndex.hpp"
 #ifndef WIN32
 #include <glob.h>
 #define PATH_SEP_STRING "/"
@@ -221,6 +223,60 @@ static void globfree(glob_t *pglob)
 
 namespace gnsstk
 {
+      /// Indexes added with FileSpecFind::addIndex(), by file spec.
+   typedef std::map<std::string, std::shared_ptr<FileSpecIndex> > IndexMap;
+
+   static IndexMap& getIndexMap()
+   {
+      static IndexMap indexes;
+      return indexes;
+   }
+
+   static std::mutex& getIndexMutex()
+   {
+      static std::mutex indexMutex;
+      return indexMutex;
+   }
+
+
+   void FileSpecFind ::
+   addIndex(const std::shared_ptr<FileSpecIndex>& index)
+   {
+      std::lock_guard<std::mutex> lock(getIndexMutex());
+      getIndexMap()[index->getSpecString()] = index;
+   }
+
+
+   void FileSpecFind ::
+   removeIndex(const std::string& fileSpec)
+   {
+      std::lock_guard<std::mutex> lock(getIndexMutex());
+      getIndexMap().erase(fileSpec);
+   }
+
+
+   void FileSpecFind ::
+   clearIndexes()
+   {
+      std::lock_guard<std::mutex> lock(getIndexMutex());
+      getIndexMap().clear();
+   }
+
+
+   std::shared_ptr<FileSpecIndex> FileSpecFind ::
+   getIndex(const std::string& fileSpec)
+   {
+      std::lock_guard<std::mutex> lock(getIndexMutex());
+      IndexMap& indexes = getIndexMap();
+      if (indexes.empty())
+         return std::shared_ptr<FileSpecIndex>();
+      IndexMap::const_iterator i = indexes.find(fileSpec);
+      if (i == indexes.end())
+         return std::shared_ptr<FileSpecIndex>();
+      return i->second;
+   }
+
+
    list<string> FileSpecFind ::
    find(const std::string& fileSpecString,
         const gnsstk::CommonTime& start,
@@ -275,6 +331,10 @@ namespace gnsstk
 
       Filter filter;
 
+      std::shared_ptr<FileSpecIndex> index = getIndex(spec);
+      if (index)
+         return index->find(start, end, filter);
+
       return findGlob(start, end, spec, dummyFSTS, filter);
    }
 
@@ -300,10 +360,28 @@ namespace gnsstk
             continue;
          dummyFSTS[fst] = "";
       }
+      std::shared_ptr<FileSpecIndex> index = getIndex(fileSpec);
+      if (index)
+         return index->find(start, end, filter);
       return findGlob(start, end, fileSpec, dummyFSTS, filter);
    }
 
 
+   void FileSpecFind ::
+   globMatches(const std::string& pattern, std::vector<std::string>& matches)
+   {
+      glob_t globbuf;
+      int g = glob(pattern.c_str(), GLOB_ERR|GLOB_NOSORT|GLOB_TILDE, nullptr,
+                   &globbuf);
+      if (g == 0)
+      {
+         for (size_t i = 0; i < globbuf.gl_pathc; i++)
+            matches.push_back(globbuf.gl_pathv[i]);
+      }
+      globfree(&globbuf);
+   }
+
+
    string FileSpecFind ::
    transToken(const string& token)
    {
@@ -40,7 +40,9 @@
 #define FILESPECFIND_HPP
 
 #include <list>
+#include <memory>
 #include <string>
+#include <vector>
 #include "CommonTime.hpp"
 #include "FileSpec.hpp"
 
@@ -48,6 +50,8 @@ class FileSpecFind_T;
 
 namespace gnsstk
 {
+   class FileSpecIndex;
+
       /// @ingroup FileDirProc
       //@{
 
@@ -79,6 +83,9 @@ namespace gnsstk
        *       "/archive/%04Y/%05n/%05n-%04Y%03j-%1r%1t.raw",
        *       fromTime, toTime, fsts);
        * @endcode
+       *
+       * Searches of large directory trees can be answered from an
+       * index of the files instead, see FileSpecIndex and addIndex().
        */
    class FileSpecFind
    {
@@ -147,7 +154,42 @@ namespace gnsstk
          const Filter& filter)
       { return find(fileSpec.getSpecString(), start, end, filter); }
 
+         /** Answer searches for the index's FileSpec from the index
+          * rather than the file system.  This applies to searches
+          * whose file spec string, after any text token has been
+          * replaced with the text in fsts, is the same as the one
+          * the index was made with.  An index added for the same
+          * FileSpec as an earlier one replaces it.
+          * @warning The index is searched as it is and is never
+          *   refreshed here, so files added to or removed from the
+          *   directory tree after it was scanned or loaded won't be
+          *   reflected in the results.  Call FileSpecIndex::refresh()
+          *   on it, while no searches are in progress, to bring it up
+          *   to date.
+          * @param[in] index The index to search.
+          */
+      static void addIndex(const std::shared_ptr<FileSpecIndex>& index);
+
+         /** Stop using an index added with addIndex().
+          * @param[in] fileSpec The file spec string of the index.
+          */
+      static void removeIndex(const std::string& fileSpec);
+
+         /// Stop using all indexes added with addIndex().
+      static void clearIndexes();
+
    private:
+         /// Return the index added for fileSpec, if any.
+      static std::shared_ptr<FileSpecIndex> getIndex(
+         const std::string& fileSpec);
+
+         /** Find the files and directories matching a glob pattern.
+          * @param[in] pattern The glob pattern, as from transToken().
+          * @param[out] matches The matching paths are appended here.
+          */
+      static void globMatches(const std::string& pattern,
+                              std::vector<std::string>& matches);
+
          /** Translates FileSpec formatting tokens into glob expressions.
           * @param[in] token A string containing FileSpec formatting
           *   tokens e.g. %04Y.
@@ -187,6 +229,7 @@ namespace gnsstk
          std::string::size_type pos = 0);
 
       friend class ::FileSpecFind_T;
+      friend class FileSpecIndex;
    };
       //@}
 }
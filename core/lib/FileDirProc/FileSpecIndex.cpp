@@ -0,0 +1,552 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sys/stat.h>
+#include "FileSpecIndex.hpp"
+#include "StringUtils.hpp"
+#include "parallel_for.hpp"
+
+#ifndef WIN32
+#define PATH_SEP_STRING "/"
+#else
+#define PATH_SEP_STRING "/\\"
+#endif
+
+using namespace std;
+
+namespace gnsstk
+{
+      /// Version line at the start of files written by save().
+   static const string indexFileVersion("FileSpecIndex 1");
+
+
+      /// Return the modification time of path, 0 if it can't be had.
+   static time_t getMTime(const string& path)
+   {
+      struct stat st;
+      if (stat(path.c_str(), &st) != 0)
+         return 0;
+      return st.st_mtime;
+   }
+
+
+   FileSpecIndex ::
+   FileSpecIndex(const std::string& fileSpec)
+         : specString(fileSpec), spec(fileSpec)
+   {
+      for (string::size_type ppos = fileSpec.find('%');
+           ppos != string::npos;
+           ppos = fileSpec.find('%', ppos+1))
+      {
+         if ((ppos+1 >= fileSpec.length()) || !isdigit(fileSpec[ppos+1]))
+         {
+            FileSpecException exc("FileSpecIndex needs a width for every"
+                                  " token: " + fileSpec);
+            GNSSTK_THROW(exc);
+         }
+      }
+
+         // Split the spec into levels the same way findGlob does.
+      string::size_type pos = 0;
+      while (true)
+      {
+         string::size_type stokpos = fileSpec.find('%', pos);
+         string::size_type srest =
+            (stokpos == string::npos
+             ? string::npos
+             : fileSpec.find_first_of(PATH_SEP_STRING, stokpos+1));
+         string::size_type stoppos = min(
+            stokpos, fileSpec.find_last_of(PATH_SEP_STRING, stokpos));
+         Level level;
+         level.thisSpec = fileSpec.substr(0, srest);
+         level.pos = pos;
+         level.checkTime = FileSpec(
+            level.thisSpec.substr(stoppos+1)).hasTimeField();
+         levels.push_back(level);
+         levelSpecs.push_back(FileSpec(level.thisSpec));
+         if (srest == string::npos)
+            break;
+         pos = level.thisSpec.length();
+      }
+
+      for (unsigned i = FileSpec::unknown; i < FileSpec::firstTime; i++)
+      {
+         FileSpec::FileSpecType fst = (FileSpec::FileSpecType)i;
+         if ((fst == FileSpec::fixed) || (fst == FileSpec::unknown))
+            continue;
+         if (spec.hasField(fst))
+            fieldTypes.push_back(fst);
+      }
+   }
+
+
+   void FileSpecIndex ::
+   scan(unsigned nthreads)
+   {
+      dirs.clear();
+      vector<pair<string,unsigned> > todo(1, make_pair(string(), 0U));
+      scanFrom(todo, nthreads);
+      rebuild();
+   }
+
+
+   unsigned long FileSpecIndex ::
+   refresh(unsigned nthreads)
+   {
+      vector<DirMap::iterator> all;
+      all.reserve(dirs.size());
+      for (DirMap::iterator i = dirs.begin(); i != dirs.end(); i++)
+         all.push_back(i);
+
+         // Check every directory, listing those that have changed.
+      vector<char> changed(all.size(), 0);
+      vector<Dir> relisted(all.size());
+      parallelFor(all.size(), nthreads,
+                  [&](size_t i)
+                  {
+                     string pattern;
+                     const Dir& dir = all[i]->second;
+                     time_t mtime = getMTime(
+                        getListDir(all[i]->first, dir.level, pattern));
+                     if ((dir.mtime == 0) || (mtime != dir.mtime))
+                     {
+                        changed[i] = 1;
+                        listDir(all[i]->first, dir.level, relisted[i]);
+                     }
+                  });
+
+         // Merge in the new listings, noting paths that have come
+         // and gone so the levels below them can be updated.
+      unsigned long count = 0;
+      vector<string> removed;
+      vector<pair<string,unsigned> > todo;
+      for (size_t i = 0; i < all.size(); i++)
+      {
+         if (!changed[i])
+            continue;
+         count++;
+         Dir& dir = all[i]->second;
+         const vector<string>& oldc(dir.children);
+         const vector<string>& newc(relisted[i].children);
+         set_difference(oldc.begin(), oldc.end(), newc.begin(), newc.end(),
+                        back_inserter(removed));
+         vector<string> added;
+         set_difference(newc.begin(), newc.end(), oldc.begin(), oldc.end(),
+                        back_inserter(added));
+         for (size_t j = 0; j < added.size(); j++)
+            todo.push_back(make_pair(added[j], dir.level+1));
+         dir = std::move(relisted[i]);
+      }
+      for (size_t i = 0; i < removed.size(); i++)
+         erase(removed[i]);
+
+      count += scanFrom(todo, nthreads);
+      if (count > 0)
+         rebuild();
+      return count;
+   }
+
+
+   list<string> FileSpecIndex ::
+   find(const CommonTime& start,
+        const CommonTime& end,
+        const FileSpec::FSTStringMap& fsts)
+      const
+   {
+      return find(start, end, FileSpecFind::Filter());
+   }
+
+
+      /// Order index entries by time.
+   struct EntryTimeLess
+   {
+      template <class Entry>
+      bool operator()(const Entry* l, const CommonTime& r) const
+      { return l->time < r; }
+   };
+
+
+   list<string> FileSpecIndex ::
+   find(const CommonTime& start,
+        const CommonTime& end,
+        const FileSpecFind::Filter& filter)
+      const
+   {
+      list<string> rv;
+      vector<const Entry*>::const_iterator first = sorted.begin(),
+         last = sorted.end();
+
+      if (spec.hasTimeField())
+      {
+         CommonTime fromTimeMatch, toTimeMatch;
+         getTimeMatch(spec, start, end, fromTimeMatch, toTimeMatch);
+            // Make sure from <= t < to can be met.
+         if (toTimeMatch == fromTimeMatch)
+            toTimeMatch += 0.1;
+            // FileSpecFind::findGlob() also checks the time of each
+            // directory at its own resolution, which can only lower
+            // the end of the span.
+         for (size_t i = 0; i+1 < levels.size(); i++)
+         {
+            if (!levels[i].checkTime)
+               continue;
+            CommonTime levelFrom, levelTo;
+            getTimeMatch(levelSpecs[i], start, end, levelFrom, levelTo);
+            if ((levelFrom != levelTo) && (levelTo < toTimeMatch))
+               toTimeMatch = levelTo;
+         }
+         if (toTimeMatch <= fromTimeMatch)
+            return rv;
+         first = lower_bound(sorted.begin(), sorted.end(), fromTimeMatch,
+                             EntryTimeLess());
+         last = lower_bound(first, sorted.end(), toTimeMatch,
+                            EntryTimeLess());
+      }
+
+      for (vector<const Entry*>::const_iterator i = first; i != last; i++)
+      {
+         bool matchedFilter = true;
+         FileSpecFind::Filter::const_iterator fi = filter.begin();
+         while (matchedFilter && (fi != filter.end()))
+         {
+            FileSpecFind::Filter::const_iterator fiEnd =
+               filter.upper_bound(fi->first);
+            vector<FileSpec::FileSpecType>::const_iterator fti =
+               std::find(fieldTypes.begin(), fieldTypes.end(), fi->first);
+            if (fti != fieldTypes.end())
+            {
+               const string& fieldVal = (*i)->fields[fti-fieldTypes.begin()];
+               matchedFilter = false;
+               for (; fi != fiEnd; fi++)
+               {
+                  if (fi->second == fieldVal)
+                  {
+                     matchedFilter = true;
+                     break;
+                  }
+               }
+            }
+            fi = fiEnd;
+         }
+         if (matchedFilter)
+            rv.push_back((*i)->path);
+      }
+      return rv;
+   }
+
+
+   void FileSpecIndex ::
+   save(const std::string& fileName) const
+   {
+      ofstream out(fileName.c_str());
+      if (!out)
+      {
+         FileMissingException exc("Can't write " + fileName);
+         GNSSTK_THROW(exc);
+      }
+      out << indexFileVersion << endl << specString << endl;
+      for (DirMap::const_iterator i = dirs.begin(); i != dirs.end(); i++)
+      {
+         out << "D " << i->second.level << " "
+             << static_cast<long long>(i->second.mtime) << " "
+             << i->first << '\n';
+         for (size_t j = 0; j < i->second.children.size(); j++)
+            out << "C " << i->second.children[j] << '\n';
+         for (size_t j = 0; j < i->second.files.size(); j++)
+            out << "F " << i->second.files[j].path << '\n';
+      }
+      out.close();
+      if (!out)
+      {
+         FileMissingException exc("Error writing " + fileName);
+         GNSSTK_THROW(exc);
+      }
+   }
+
+
+   void FileSpecIndex ::
+   load(const std::string& fileName, unsigned nthreads)
+   {
+      ifstream in(fileName.c_str());
+      if (!in)
+      {
+         FileMissingException exc("Can't read " + fileName);
+         GNSSTK_THROW(exc);
+      }
+      string line;
+      getline(in, line);
+      if (line != indexFileVersion)
+      {
+         FileSpecException exc(fileName + " is not a FileSpecIndex file");
+         GNSSTK_THROW(exc);
+      }
+      getline(in, line);
+      if (line != specString)
+      {
+         FileSpecException exc(fileName + " is an index for " + line);
+         GNSSTK_THROW(exc);
+      }
+
+      DirMap newDirs;
+      vector<Dir*> leaves;
+      Dir* dir = nullptr;
+      while (getline(in, line))
+      {
+         if ((line.length() > 2) && (line[0] == 'D'))
+         {
+            string::size_type p1 = line.find(' ', 2);
+            string::size_type p2 = (p1 == string::npos ? p1 :
+                                    line.find(' ', p1+1));
+            if (p2 == string::npos)
+               break;
+            dir = &newDirs[line.substr(p2+1)];
+            dir->level = StringUtils::asUnsigned(line.substr(2, p1-2));
+            dir->mtime = static_cast<time_t>(
+               StringUtils::asInt(line.substr(p1+1, p2-p1-1)));
+            if ((dir->level >= levels.size()) ||
+                (dir->level+1 == levels.size()))
+            {
+               leaves.push_back(dir);
+            }
+         }
+         else if ((line.length() > 2) && (line[0] == 'C') && dir)
+         {
+            dir->children.push_back(line.substr(2));
+         }
+         else if ((line.length() > 2) && (line[0] == 'F') && dir)
+         {
+            dir->files.push_back(Entry());
+            dir->files.back().path = line.substr(2);
+         }
+         else
+         {
+            FileSpecException exc("Invalid line in " + fileName + ": " +
+                                  line);
+            GNSSTK_THROW(exc);
+         }
+      }
+
+         // Parse the file names.
+      parallelFor(leaves.size(), nthreads,
+                  [&](size_t i)
+                  {
+                     vector<Entry>& files = leaves[i]->files;
+                     size_t n = 0;
+                     for (size_t j = 0; j < files.size(); j++)
+                     {
+                        if (makeEntry(files[j].path, files[j]))
+                        {
+                           if (n != j)
+                              files[n] = std::move(files[j]);
+                           n++;
+                        }
+                     }
+                     files.resize(n);
+                  });
+
+      dirs.swap(newDirs);
+      rebuild();
+   }
+
+
+   void FileSpecIndex ::
+   listDir(const std::string& matched, unsigned level, Dir& dir) const
+   {
+      string pattern;
+      string listed = getListDir(matched, level, pattern);
+      time_t now = time(nullptr);
+      dir.level = level;
+      dir.mtime = getMTime(listed);
+         // A change in the same second as the listing won't change
+         // the modification time, so list it again next time.
+      if (dir.mtime >= now - 1)
+         dir.mtime = 0;
+      dir.children.clear();
+      dir.files.clear();
+
+      vector<string> matches;
+      FileSpecFind::globMatches(pattern, matches);
+      sort(matches.begin(), matches.end());
+      if (level+1 < levels.size())
+      {
+         dir.children.swap(matches);
+      }
+      else
+      {
+         dir.files.reserve(matches.size());
+         for (size_t i = 0; i < matches.size(); i++)
+         {
+            dir.files.push_back(Entry());
+            if (!makeEntry(matches[i], dir.files.back()))
+               dir.files.pop_back();
+         }
+      }
+   }
+
+
+   bool FileSpecIndex ::
+   makeEntry(const std::string& path, Entry& entry) const
+   {
+      try
+      {
+         entry.path = path;
+         if (spec.hasTimeField())
+            entry.time = spec.extractCommonTime(path);
+         entry.fields.resize(fieldTypes.size());
+         for (size_t i = 0; i < fieldTypes.size(); i++)
+            entry.fields[i] = spec.extractField(path, fieldTypes[i]);
+      }
+      catch (Exception& exc)
+      {
+            // not a file name for this spec after all
+         return false;
+      }
+      return true;
+   }
+
+
+   std::string FileSpecIndex ::
+   getListDir(const std::string& matched, unsigned level,
+              std::string& pattern) const
+   {
+      string patternSpec(levels[level].thisSpec);
+      patternSpec.replace(0, levels[level].pos, matched);
+      pattern = FileSpecFind::transToken(patternSpec);
+      string::size_type sep = pattern.find_last_of(PATH_SEP_STRING);
+      if (sep == string::npos)
+         return ".";
+      if (sep == 0)
+         return pattern.substr(0, 1);
+      return pattern.substr(0, sep);
+   }
+
+
+   unsigned long FileSpecIndex ::
+   scanFrom(std::vector<std::pair<std::string,unsigned> >& todo,
+            unsigned nthreads)
+   {
+      unsigned long count = 0;
+      while (!todo.empty())
+      {
+         vector<Dir> listed(todo.size());
+         parallelFor(todo.size(), nthreads,
+                     [&](size_t i)
+                     {
+                        listDir(todo[i].first, todo[i].second, listed[i]);
+                     });
+         count += todo.size();
+         vector<pair<string,unsigned> > next;
+         for (size_t i = 0; i < todo.size(); i++)
+         {
+            Dir& dir = dirs[todo[i].first];
+            dir = std::move(listed[i]);
+            for (size_t j = 0; j < dir.children.size(); j++)
+               next.push_back(make_pair(dir.children[j], dir.level+1));
+         }
+         todo.swap(next);
+      }
+      return count;
+   }
+
+
+   void FileSpecIndex ::
+   erase(const std::string& matched)
+   {
+      DirMap::iterator i = dirs.find(matched);
+      if (i == dirs.end())
+         return;
+      vector<string> children;
+      children.swap(i->second.children);
+      dirs.erase(i);
+      for (size_t j = 0; j < children.size(); j++)
+         erase(children[j]);
+   }
+
+
+   void FileSpecIndex ::
+   getTimeMatch(const FileSpec& fspec,
+                const CommonTime& start,
+                const CommonTime& end,
+                CommonTime& fromTimeMatch,
+                CommonTime& toTimeMatch)
+      const
+   {
+      FileSpec::FSTStringMap dummyFSTS;
+      for (unsigned i = FileSpec::unknown; i < FileSpec::firstTime; i++)
+      {
+         FileSpec::FileSpecType fst = (FileSpec::FileSpecType)i;
+         if ((fst == FileSpec::fixed) || (fst == FileSpec::unknown))
+            continue;
+         dummyFSTS[fst] = "";
+      }
+      fromTimeMatch = fspec.extractCommonTime(
+         fspec.toString(start, dummyFSTS));
+      toTimeMatch = fspec.extractCommonTime(fspec.toString(end, dummyFSTS));
+   }
+
+
+      /// Order index entries by time, then path.
+   struct EntryLess
+   {
+      template <class Entry>
+      bool operator()(const Entry* l, const Entry* r) const
+      {
+         if (l->time < r->time)
+            return true;
+         if (r->time < l->time)
+            return false;
+         return l->path < r->path;
+      }
+   };
+
+
+   void FileSpecIndex ::
+   rebuild()
+   {
+      sorted.clear();
+      for (DirMap::const_iterator i = dirs.begin(); i != dirs.end(); i++)
+      {
+         for (size_t j = 0; j < i->second.files.size(); j++)
+            sorted.push_back(&i->second.files[j]);
+      }
+      sort(sorted.begin(), sorted.end(), EntryLess());
+   }
+}
@@ -0,0 +1,269 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#ifndef FILESPECINDEX_HPP
+#define FILESPECINDEX_HPP
+
+#include <ctime>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include "CommonTime.hpp"
+#include "FileSpec.hpp"
+#include "FileSpecFind.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileDirProc
+      //@{
+
+      /** An index of the existing files matching a FileSpec, so
+       * that searches by time and FileSpec field values don't have
+       * to walk the directory tree.
+       *
+       * The tree is walked once by scan(), which lists the
+       * directories at each level of the FileSpec in parallel.  Each
+       * file is stored with its time and its non-time field values
+       * (station, receiver, etc.) as parsed by the FileSpec.  The
+       * modification time of each directory listed is kept, so
+       * refresh() only needs to list again the directories that
+       * have changed.  The index can be saved to a file and loaded
+       * later to avoid the initial scan.
+       *
+       * Once added with FileSpecFind::addIndex(), an index is used by
+       * FileSpecFind::find() for searches using the same FileSpec
+       * string, so code using FileSpecFind needs no changes.  It
+       * isn't refreshed automatically; searches see the files as of
+       * the last scan(), refresh() or load().
+       *
+       * @code{.cpp}
+       *    std::shared_ptr<gnsstk::FileSpecIndex> index =
+       *       std::make_shared<gnsstk::FileSpecIndex>(
+       *          "/archive/%04Y/%05n/%05n-%04Y%03j-%1r%1t.raw");
+       *    index->scan();
+       *    gnsstk::FileSpecFind::addIndex(index);
+       *       // same as before, but answered from the index
+       *    std::list<std::string> fileList = gnsstk::FileSpecFind::find(
+       *       "/archive/%04Y/%05n/%05n-%04Y%03j-%1r%1t.raw",
+       *       fromTime, toTime, fsts);
+       * @endcode
+       *
+       * @note Each file is checked against the time span and filter
+       *   using the whole path, where FileSpecFind::find() checks
+       *   each directory level separately.  The results are the same
+       *   unless the times or fields in the directory names don't
+       *   agree with those in the file names.
+       * @note An index must not be scanned, refreshed or loaded
+       *   while it is being searched.
+       */
+   class FileSpecIndex
+   {
+   public:
+         /** Set up an empty index for the files matching fileSpec.
+          * @param[in] fileSpec The FileSpec of the files to index.
+          *   All tokens must have a width, so text ("%x") must be
+          *   either given a width or replaced with the text itself,
+          *   as FileSpecFind::find() does with the value in fsts.
+          * @throw FileSpecException if fileSpec is invalid or has a
+          *   token with no width.
+          */
+      explicit FileSpecIndex(const std::string& fileSpec);
+
+         /** Walk the directory tree, replacing the contents of the
+          * index.
+          * @param[in] nthreads The number of threads to list
+          *   directories with, 0 for one per hardware thread.
+          */
+      void scan(unsigned nthreads = 0);
+
+         /** Update the index with changes to the directory tree,
+          * listing only the directories that have been modified
+          * since they were last listed.
+          * @param[in] nthreads The number of threads to use, 0 for
+          *   one per hardware thread.
+          * @return The number of directories listed.
+          */
+      unsigned long refresh(unsigned nthreads = 0);
+
+         /** Search the index for files in a time range.
+          * @param[in] start Files that precede this time will be
+          *   ignored.
+          * @param[in] end Files that are after this time will be
+          *   ignored.
+          * @param[in] fsts Not used, as the FileSpec has no tokens
+          *   without a width.  Present to match FileSpecFind::find().
+          * @return A list of matching file names, in time order.
+          */
+      std::list<std::string> find(
+         const CommonTime& start,
+         const CommonTime& end,
+         const FileSpec::FSTStringMap& fsts = FileSpec::FSTStringMap())
+         const;
+
+         /** Search the index for files in a time range with a set of
+          * allowed FileSpec token values.
+          * @param[in] start Files that precede this time will be
+          *   ignored.
+          * @param[in] end Files that are after this time will be
+          *   ignored.
+          * @param[in] filter Set of allowable values for tokens
+          *   present in the FileSpec (values for tokens not present
+          *   will be ignored).
+          * @return A list of matching file names, in time order.
+          */
+      std::list<std::string> find(
+         const CommonTime& start,
+         const CommonTime& end,
+         const FileSpecFind::Filter& filter) const;
+
+         /** Write the index to a file.
+          * @param[in] fileName The file to write.
+          * @throw FileMissingException if the file can't be written.
+          */
+      void save(const std::string& fileName) const;
+
+         /** Replace the contents of the index with those of a file
+          * written by save().  Use refresh() to bring it up to date.
+          * @param[in] fileName The file to read.
+          * @param[in] nthreads The number of threads to parse file
+          *   names with, 0 for one per hardware thread.
+          * @throw FileMissingException if the file can't be read.
+          * @throw FileSpecException if the file isn't an index for
+          *   this FileSpec.
+          */
+      void load(const std::string& fileName, unsigned nthreads = 0);
+
+         /// Return the FileSpec string the index is for.
+      const std::string& getSpecString() const
+      { return specString; }
+
+         /// Return the number of files in the index.
+      size_t getNumFiles() const
+      { return sorted.size(); }
+
+         /// Return the number of directories listed to build the index.
+      size_t getNumDirs() const
+      { return dirs.size(); }
+
+   private:
+         /// One level of the FileSpec, as in FileSpecFind::findGlob().
+      struct Level
+      {
+            /// The FileSpec up to and including the level's tokens.
+         std::string thisSpec;
+            /// Length of the previous level's thisSpec.
+         std::string::size_type pos;
+            /// true if this level's part of the path has time tokens.
+         bool checkTime;
+      };
+
+         /// A file in the index.
+      struct Entry
+      {
+         std::string path;
+         CommonTime time;
+            /// Values of the non-time fields, as in fieldTypes.
+         std::vector<std::string> fields;
+      };
+
+         /** The results of matching one level of the FileSpec in one
+          * directory.  The directory is given by the path matched at
+          * the previous level. */
+      struct Dir
+      {
+         Dir() : level(0), mtime(0) {}
+         unsigned level;
+            /// Modification time of the directory, 0 if unknown.
+         time_t mtime;
+            /// Paths matched, if level isn't the last level.
+         std::vector<std::string> children;
+            /// Files matched, if level is the last level.
+         std::vector<Entry> files;
+      };
+
+      typedef std::map<std::string, Dir> DirMap;
+
+         /// Match level of the FileSpec in the directory matched.
+      void listDir(const std::string& matched, unsigned level, Dir& dir) const;
+
+         /// Fill in entry for the file path.  Returns false on failure.
+      bool makeEntry(const std::string& path, Entry& entry) const;
+
+         /** Get the directory that listDir() lists.
+          * @return the directory, and the pattern matched in it. */
+      std::string getListDir(const std::string& matched, unsigned level,
+                             std::string& pattern) const;
+
+         /** List the directories in todo and all those under them.
+          * @return the number of directories listed. */
+      unsigned long scanFrom(
+         std::vector<std::pair<std::string,unsigned> >& todo,
+         unsigned nthreads);
+
+         /// Remove the directory matched and those under it.
+      void erase(const std::string& matched);
+
+         /// Rebuild sorted from dirs.
+      void rebuild();
+
+         /** Reduce a time span to the resolution of a FileSpec, as
+          * FileSpecFind::findGlob() does. */
+      void getTimeMatch(const FileSpec& fspec,
+                        const CommonTime& start,
+                        const CommonTime& end,
+                        CommonTime& fromTimeMatch,
+                        CommonTime& toTimeMatch) const;
+
+      std::string specString;
+      FileSpec spec;
+      std::vector<Level> levels;
+         /// FileSpecs of levels[i].thisSpec, for time matching.
+      std::vector<FileSpec> levelSpecs;
+         /// Non-time FileSpecTypes present in the FileSpec.
+      std::vector<FileSpec::FileSpecType> fieldTypes;
+         /// Directories listed, by the path matched at the previous level.
+      DirMap dirs;
+         /// All files in the index, sorted by time then path.
+      std::vector<const Entry*> sorted;
+   };
+
+      //@}
+}
+
+#endif // FILESPECINDEX_HPP
@@ -42,10 +42,13 @@
 #define GNSSTK_FILE_STORE_INCLUDE
 
 #include <vector>
+#include <list>
 #include <map>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include "Exception.hpp"
+#include "CommonTime.hpp"
 
 namespace gnsstk
 {
@@ -58,6 +61,15 @@ namespace gnsstk
        * datastore.  This is intended to support arbitrary file names,
        * not a list of similiar file names. See the FileSpecFind
        * framework for support of that type of file.
+       *
+       * Derived classes may load their data on demand rather than
+       * when a file is added.  Such classes add each file with the
+       * time span it covers, use getFilesForTime() to decide which
+       * files a query needs, and keep track of which of those are
+       * loaded with useFile().  setMaxLoaded() limits the number of
+       * files loaded at once, and trimLoaded() returns the least
+       * recently used files that should be unloaded to stay within
+       * that limit.
        */
    template <class HeaderType> class FileStore
    {
@@ -66,10 +78,28 @@ namespace gnsstk
          /// A store of all headers loaded, indexed by file name
       std::map<std::string, HeaderType> headerMap;
 
+         /// Time span of each file added with one, indexed by file name
+      std::map<std::string, std::pair<CommonTime,CommonTime> > spanMap;
+
+         /** Files whose data are loaded, most recently used first.
+          * Mutable so that data can be loaded by const queries. */
+      mutable std::list<std::string> loadedList;
+
+         /// Maximum number of files to keep loaded, 0 for no limit
+      unsigned maxLoaded;
+
+         /// Copy of t that ignores time system, for comparing spans
+      static CommonTime anyTime(const CommonTime& t)
+      {
+         CommonTime rv(t);
+         rv.setTimeSystem(TimeSystem::Any);
+         return rv;
+      }
+
    public:
 
          /// Constructor.
-      FileStore() noexcept {};
+      FileStore() noexcept : maxLoaded(0) {};
 
          /// destructor
       ~FileStore() {};
@@ -96,6 +126,136 @@ namespace gnsstk
          headerMap.insert(make_pair(fn,header));
       }
 
+         /** Add a filename, with its header and the span of time
+          * its data cover, to the store.
+          * @param[in] fn The file name.
+          * @param[in] header The file's header.
+          * @param[in] begin The time of the file's earliest data.
+          * @param[in] end The time of the file's latest data.
+          * @throw InvalidRequest */
+      void addFile(const std::string& fn, HeaderType& header,
+                   const CommonTime& begin, const CommonTime& end)
+      {
+         addFile(fn, header);
+         spanMap[fn] = std::make_pair(anyTime(begin), anyTime(end));
+      }
+
+         /** Get the span of time covered by a file.  Time systems
+          * are ignored, so begin and end have TimeSystem::Any.
+          * @return false if the file was added without a span. */
+      bool getTimeSpan(const std::string& fn,
+                       CommonTime& begin, CommonTime& end) const
+      {
+         typename std::map<std::string,
+                           std::pair<CommonTime,CommonTime> >::const_iterator
+            si = spanMap.find(fn);
+         if (si == spanMap.end())
+            return false;
+         begin = si->second.first;
+         end = si->second.second;
+         return true;
+      }
+
+         /** Get the names of the files with spans that are needed
+          * for data at time t: those whose spans include t or, if
+          * there are none, the files nearest t before and after it.
+          * Time systems are ignored. */
+      std::vector<std::string> getFilesForTime(const CommonTime& t) const
+      {
+         std::vector<std::string> names;
+         CommonTime at(anyTime(t));
+         typename std::map<std::string,
+                           std::pair<CommonTime,CommonTime> >::const_iterator
+            si, before = spanMap.end(), after = spanMap.end();
+         for (si = spanMap.begin(); si != spanMap.end(); si++)
+         {
+            if (at < si->second.first)
+            {
+               if ((after == spanMap.end()) ||
+                   (si->second.first < after->second.first))
+                  after = si;
+            }
+            else if (si->second.second < at)
+            {
+               if ((before == spanMap.end()) ||
+                   (before->second.second < si->second.second))
+                  before = si;
+            }
+            else
+               names.push_back(si->first);
+         }
+         if (names.empty())
+         {
+            if (before != spanMap.end())
+               names.push_back(before->first);
+            if (after != spanMap.end())
+               names.push_back(after->first);
+         }
+         return names;
+      }
+
+         /** Set the maximum number of files to keep loaded.
+          * @param[in] n The limit, 0 for no limit. */
+      void setMaxLoaded(unsigned n) noexcept
+      { maxLoaded = n; }
+
+         /// Get the maximum number of files to keep loaded, 0 if no limit.
+      unsigned getMaxLoaded() const noexcept
+      { return maxLoaded; }
+
+         /** Mark a file as loaded and most recently used.
+          * @return true if the file was already loaded. */
+      bool useFile(const std::string& fn) const
+      {
+         std::list<std::string>::iterator li =
+            std::find(loadedList.begin(), loadedList.end(), fn);
+         if (li == loadedList.end())
+         {
+            loadedList.push_front(fn);
+            return false;
+         }
+         loadedList.splice(loadedList.begin(), loadedList, li);
+         return true;
+      }
+
+         /** Remove the least recently used files from the loaded
+          * files so that no more than getMaxLoaded() remain.
+          * @param[in] minKeep The number of most recently used files
+          *   to keep regardless of the limit, normally the number
+          *   needed by the current query.
+          * @return The files removed, which the caller should unload. */
+      std::vector<std::string> trimLoaded(size_t minKeep = 0) const
+      {
+         std::vector<std::string> names;
+         size_t keep = std::max<size_t>(maxLoaded, minKeep);
+         if (maxLoaded == 0)
+            return names;
+         while (loadedList.size() > keep)
+         {
+            names.push_back(loadedList.back());
+            loadedList.pop_back();
+         }
+         return names;
+      }
+
+         /// Return true if the file is marked as loaded.
+      bool isLoaded(const std::string& fn) const
+      {
+         return (std::find(loadedList.begin(), loadedList.end(), fn) !=
+                 loadedList.end());
+      }
+
+         /// Get the names of the loaded files, most recently used first.
+      std::vector<std::string> getLoadedFiles() const
+      {
+         return std::vector<std::string>(loadedList.begin(),
+                                         loadedList.end());
+      }
+
+         /// Return the number of files marked as loaded.
+      unsigned nloaded() const noexcept
+      { return loadedList.size(); }
+
          /** Access the header for a given filename
           * @throw InvalidRequest */
       const HeaderType& getHeader(const std::string& fn) const
@@ -112,6 +272,20 @@ namespace gnsstk
             // headerMap, making this function not be side-effect free
       }
 
+         /** Access the header for a given filename, for changes
+          * @throw InvalidRequest */
+      HeaderType& getHeader(const std::string& fn)
+      {
+         typename std::map<std::string, HeaderType>::iterator iter_fn =
+            headerMap.find(fn);
+         if( iter_fn == headerMap.end())
+         {
+            InvalidRequest e("File name not found");
+            GNSSTK_THROW(e);
+         }
+         return iter_fn->second;
+      }
+
          /// dump a list of file names
       void dump(std::ostream& os = std::cout, short detail = 0)
          const noexcept
@@ -135,6 +309,8 @@ namespace gnsstk
          noexcept
       {
          headerMap.clear();
+         spanMap.clear();
+         loadedList.clear();
       }
 
 
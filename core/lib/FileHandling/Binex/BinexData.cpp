@@ -128,20 +128,38 @@ namespace gnsstk
          FFStreamError err(errStrm.str() );
          GNSSTK_THROW(err);
       }
+      return decode((const unsigned char*)inBuffer.data() + offset,
+                    inBuffer.size() - offset, littleEndian);
+   }
+
+
+   // -------------------------------------------------------------------------
+   size_t
+   BinexData::UBNXI::decode(
+      const unsigned char*  inBuffer,
+      size_t                bufSize,
+      bool                  littleEndian)
+   {
       bool more = true;
       for (size = 0, value = 0L; (size < MAX_BYTES) && more; size++)
       {
+         if (size >= bufSize)
+         {
+            size = 0;
+            FFStreamError err("BINEX UBNXI runs past the end of the buffer");
+            GNSSTK_THROW(err);
+         }
          unsigned char mask = (size < 3) ? 0x7f : 0xff;
          if (littleEndian)
          {
-            value |= ( (unsigned long)inBuffer[offset + size] & mask) << (7 * size);
+            value |= ( (unsigned long)inBuffer[size] & mask) << (7 * size);
          }
          else
          {
             value <<= (size < 3) ? 7 : 8;
-            value |= ( (unsigned long)inBuffer[offset + size] & mask);
+            value |= ( (unsigned long)inBuffer[size] & mask);
          }
-         if ( (inBuffer[offset + size] & 0x80) != 0x80)
+         if ( (inBuffer[size] & 0x80) != 0x80)
          {
             more = false;
          }
@@ -435,20 +453,34 @@ namespace gnsstk
       size_t              offset,
       bool                littleEndian)
    {
-      long long          absValue = 0;
-      unsigned char      flags;
-      uint64_t           ull;
-      short              sign;
-
-      if (offset > inBuffer.size() )
+      if (offset > inBuffer.size() ||
+          (offset == inBuffer.size() && offset > 0) )
       {
          std::ostringstream errStrm;
          errStrm << "Invalid offset into BINEX MGFZI input buffer: " << offset;
          FFStreamError err(errStrm.str() );
          GNSSTK_THROW(err);
       }
+      return decode((const unsigned char*)inBuffer.data() + offset,
+                    inBuffer.size() - offset, littleEndian);
+   }
+
 
-      if (inBuffer.size() == 0)
+   // -------------------------------------------------------------------------
+   size_t
+   BinexData::MGFZI::decode(
+      const unsigned char*  inBuffer,
+      size_t                bufSize,
+      bool                  littleEndian)
+   {
+         // Smallest magnitude stored using 1, 2, ... 8 bytes
+      static const unsigned long long bias[8] =
+      {
+         0ULL, 14ULL, 4109ULL, 1052684ULL, 269488139ULL, 68988964874ULL,
+         17661175009289ULL, 4521260802379784ULL
+      };
+
+      if (bufSize == 0)
       {
             // Nothing to decode
          size  = 0;
@@ -456,160 +488,49 @@ namespace gnsstk
          return 0;
       }
          // Isolate sign and byte-length flags
-      flags = littleEndian
-            ? inBuffer[offset] & 0x0f
-            : (inBuffer[offset] >> 4) & 0x0f;
+      unsigned char flags = littleEndian
+                          ? inBuffer[0] & 0x0f
+                          : (inBuffer[0] >> 4) & 0x0f;
 
          // Determine whether the final value is positive or negative.
-      sign = (flags & 0x08) ? -1 : 1;
+      short sign = (flags & 0x08) ? -1 : 1;
 
          // Handle varying byte lengths
       size = (flags & 0x07) + 1;
-      if (size > inBuffer.size() )
+      if (size > bufSize)
       {
          std::ostringstream errStrm;
          errStrm << "BINEX MGFZI is too large for the supplied decode buffer: "
                  << "MGFZI size = " << size << " , buffer size = "
-                 << inBuffer.size();
+                 << bufSize;
          FFStreamError err(errStrm.str() );
          GNSSTK_THROW(err);
       }
 
-      switch (size)
+         // Assemble the bytes in the record's byte order, then drop the
+         // four flag bits.
+      uint64_t ull = 0;
+      for (size_t i = 0; i < size; i++)
       {
-         case 0x01:
-            // Use 1 byte:
-            //
-            ull = parseBuffer(inBuffer, offset, 1);
-            absValue = littleEndian
-                     ? ull >> 4
-                     : ull & 0x0000000fULL;
-            if (sign == -1 && absValue == 0)
-            {
-               // "-0" reserved for "no data" indicator
-               size = 0;
-               // todo - throw
-            }
-            else
-            {
-               value = sign * absValue;
-            }
-            break;
-
-         case 0x02:
-            // Use 2 bytes:
-            //
-            ull = parseBuffer(inBuffer, offset, 2);
-            if (littleEndian != nativeLittleEndian)
-            {
-               reverseBytes(ull);
-               ull >>= 48;
-            }
-            absValue = littleEndian
-                     ? ull >> 4
-                     : ull & 0x0000000000000fffULL;
-            value = sign * (14ULL + absValue);
-            break;
-
-         case 0x03:
-            // Use 3 bytes:
-            //
-            ull = parseBuffer(inBuffer, offset, 3);
-            if (littleEndian != nativeLittleEndian)
-            {
-               reverseBytes(ull);
-               ull >>= 40;
-            }
-            absValue = littleEndian
-                     ? ull >> 4
-                     : ull & 0x00000000000fffffULL;
-            value = sign * (4109ULL + absValue);
-            break;
-
-         case 0x04:
-            // Use 4 bytes:
-            //
-            ull = parseBuffer(inBuffer, offset, 4);
-            if (littleEndian != nativeLittleEndian)
-            {
-               reverseBytes(ull);
-               ull >>= 32;
-            }
-            absValue = littleEndian
-                     ? ull >> 4
-                     : ull & 0x000000000fffffffULL;
-            value = sign * (1052684ULL + absValue);
-            break;
-
-         case 0x05:
-            // Use 5 bytes:
-            //
-            ull = parseBuffer(inBuffer, offset, 5);
-            if (littleEndian != nativeLittleEndian)
-            {
-               reverseBytes(ull);
-               ull >>= 24;
-            }
-            absValue = littleEndian
-                     ? ull >> 4
-                     : ull & 0x0000000fffffffffULL;
-            value = sign * (269488139ULL + absValue);
-            break;
-
-         case 0x06:
-            // Use 6 bytes:
-            //
-            ull = parseBuffer(inBuffer, offset, 6);
-            if (littleEndian != nativeLittleEndian)
-            {
-               reverseBytes(ull);
-               ull >>= 16;
-            }
-            absValue = littleEndian
-                     ? ull >> 4
-                     : ull & 0x00000fffffffffffULL;
-            value = sign * (68988964874ULL + absValue);
-            break;
-
-         case 0x07:
-            // Use 7 bytes:
-            //
-            ull = parseBuffer(inBuffer, offset, 7);
-            if (littleEndian != nativeLittleEndian)
-            {
-               reverseBytes(ull);
-               ull >>= 8;
-            }
-            absValue = littleEndian
-                     ? ull >> 4
-                     : ull & 0x000fffffffffffffULL;
-            value = sign * (17661175009289ULL + absValue);
-            break;
-
-         case 0x08:
-            // Use 8 bytes:
-            //
-            ull = parseBuffer(inBuffer, offset, 8);
-            if (littleEndian != nativeLittleEndian)
-            {
-               reverseBytes(ull);
-            }
-            absValue = littleEndian
-                     ? ull >> 4
-                     : ull & 0x0fffffffffffffffULL;
-            value = sign * (4521260802379784ULL + absValue);
-            break;
-
-         default:
-               // Internal error
-            std::ostringstream errStrm;
-            errStrm << "BINEX MGFZI invalid size: " << size;
-            FFStreamError err(errStrm.str() );
-            size  = 0;
-            GNSSTK_THROW(err);
-            break;
+         if (littleEndian)
+            ull |= (uint64_t)inBuffer[i] << (8 * i);
+         else
+            ull = (ull << 8) | inBuffer[i];
+      }
+      unsigned long long absValue = littleEndian
+                                  ? ull >> 4
+                                  : ull & ((1ULL << (8 * size - 4)) - 1);
 
-      } // switch (flag)
+      if (size == 1 && sign == -1 && absValue == 0)
+      {
+            // "-0" reserved for "no data" indicator
+         size = 0;
+            // todo - throw
+      }
+      else
+      {
+         value = sign * (long long)(bias[size - 1] + absValue);
+      }
       return size;
    }
 
@@ -1429,105 +1350,68 @@ namespace gnsstk
                      const std::string&  message,
                      std::string&        crc) const
    {
-      size_t crcDataLen = head.size() + message.size();
-      size_t crcLen     = 0;
-      unsigned long crcTmp = 0;
+      unsigned char crcBuf[16];
+      size_t crcLen = getCRC(syncByte,
+                             (const unsigned char*)head.data(), head.size(),
+                             (const unsigned char*)message.data(),
+                             message.size(), crcBuf);
+      crc.assign((const char*)crcBuf, crcLen);
+   }
 
-      if (crcDataLen >= 1048576)
+   // -------------------------------------------------------------------------
+   size_t
+   BinexData::getCRC(SyncByte             syncByte,
+                     const unsigned char* head,
+                     size_t               headLen,
+                     const unsigned char* message,
+                     size_t               messageLen,
+                     unsigned char*       crc)
+   {
+      size_t crcDataLen = headLen + messageLen;
+      size_t crcLen     = getCRCLength(syncByte, crcDataLen);
+      uint32_t crcTmp   = 0;
+
+      if (crcLen == 16)
       {
             // @todo - Use 16-byte CRC (128-bit MD5 checksum)
-         crcLen  = 16;
+         return 0;
       }
-      else // (crcLen < 1048576)
+      else if (crcLen == 1)
       {
-         if (syncByte & eEnhancedCRC)
+            // Use 1-byte checksum: 8-bit XOR of all bytes
+         for (size_t b = 0; b < headLen; b++)
          {
-            if (crcDataLen < 128)
-            {
-                  // Use 2-byte CRC (CRC16)
-               BinUtils::CRCParam params(BinUtils::CRC16);
-               crcTmp = BinUtils::computeCRC((const unsigned char*)head.data(),
-                                             head.size(),
-                                             params);
-               params.initial = crcTmp;
-               crcTmp = BinUtils::computeCRC((const unsigned char*)message.data(),
-                                             message.size(),
-                                             params);
-               crcLen = 2;
-            }
-            else
-            {
-                  // Use 4-byte CRC (CRC32)
-               BinUtils::CRCParam params(BinUtils::CRC32);
-               crcTmp = BinUtils::computeCRC((const unsigned char*)head.data(),
-                                             head.size(),
-                                             params);
-               params.initial = crcTmp;
-               crcTmp = BinUtils::computeCRC((const unsigned char*)message.data(),
-                                             message.size(),
-                                             params);
-               crcLen = 4;
-            }
+            crcTmp ^= head[b];
          }
-         else // Regular CRC
+         for (size_t b = 0; b < messageLen; b++)
          {
-            if (crcDataLen < 128)
-            {
-                  // Use 1-byte checksum: 8-bit XOR of all bytes
-               size_t b;
-               const char *ptr;
-               ptr = head.data();
-               for (b = head.size(); b > 0 ; b--, ptr++)
-               {
-                  crcTmp ^= *ptr;
-               }
-               ptr = message.data();
-               for (b = message.size(); b > 0 ; b--, ptr++)
-               {
-                  crcTmp ^= *ptr;
-               }
-               crcLen = 1;
-            }
-            else if (crcDataLen < 4096)
-            {
-                  // Use 2-byte CRC (CRC16)
-               BinUtils::CRCParam params(BinUtils::CRC16);
-               crcTmp = BinUtils::computeCRC((const unsigned char*)head.data(),
-                                             head.size(),
-                                             params);
-               params.initial = crcTmp;
-               crcTmp = BinUtils::computeCRC((const unsigned char*)message.data(),
-                                             message.size(),
-                                             params);
-               crcLen = 2;
-            }
-            else
-            {
-                  // Use 4-byte CRC (CRC32)
-               BinUtils::CRCParam params(BinUtils::CRC32);
-               crcTmp = BinUtils::computeCRC((const unsigned char*)head.data(),
-                                             head.size(),
-                                             params);
-               params.initial = crcTmp;
-               crcTmp = BinUtils::computeCRC((const unsigned char*)message.data(),
-                                             message.size(),
-                                             params);
-               crcLen = 4;
-            }
-         } // Regular CRC
-
-            // Copy the CRC into the output
-         crc.resize(sizeof(crcTmp));
-         BinUtils::encodeVarLE(crcTmp, crc);
-         crc.resize(crcLen);
+            crcTmp ^= message[b];
+         }
+      }
+      else
+      {
+            // Use 2-byte CRC (CRC16) or 4-byte CRC (CRC32); the message
+            // CRC starts from the head CRC.
+         const BinUtils::CRCTable& table = (crcLen == 2)
+                                         ? BinUtils::CRC16Table
+                                         : BinUtils::CRC32Table;
+         crcTmp = table.compute(head, headLen);
+         crcTmp = table.compute(message, messageLen, crcTmp);
+      }
 
-      } // (crcLen < 1048576)
+         // Copy the CRC into the output, least significant byte first
+      for (size_t b = 0; b < crcLen; b++)
+      {
+         crc[b] = (crcTmp >> (8 * b)) & 0xff;
+      }
+      return crcLen;
 
    }  // BinexData::getCRC()
 
    // -------------------------------------------------------------------------
    size_t
-   BinexData::getCRCLength(size_t crcDataLen) const
+   BinexData::getCRCLength(SyncByte syncByte,
+                           size_t   crcDataLen)
    {
       size_t crcLen = 0;
 
@@ -1573,7 +1457,7 @@ namespace gnsstk
    // -------------------------------------------------------------------------
    bool
    BinexData::isHeadSyncByteValid(SyncByte  headSync,
-                                  SyncByte& expectedTailSync) const
+                                  SyncByte& expectedTailSync)
    {
       switch (headSync)
       {
@@ -1609,7 +1493,7 @@ namespace gnsstk
    // -------------------------------------------------------------------------
    bool
    BinexData::isTailSyncByteValid(SyncByte  tailSync,
-                                  SyncByte& expectedHeadSync) const
+                                  SyncByte& expectedHeadSync)
    {
       switch (tailSync)
       {
@@ -219,6 +219,21 @@ namespace gnsstk
                 size_t             offset       = 0,
                 bool               littleEndian = false);
 
+            /**
+             * Attempts to decode a valid UBNXI from bufSize raw bytes,
+             * e.g. a message viewed through BinexScanner, without
+             * copying them.
+             * @param  inBuffer Bytes to decode, in normal order
+             * @param  bufSize Number of bytes available at inBuffer
+             * @param  littleEndian Byte order of the encoded bytes
+             * @return Number of bytes decoded
+             * @throw FFStreamError if the UBNXI runs past bufSize bytes
+             */
+         size_t
+         decode(const unsigned char* inBuffer,
+                size_t               bufSize,
+                bool                 littleEndian = false);
+
             /**
              * Converts the UBNXI to a series of bytes placed in outBuffer.
              * The bytes are output in normal order (i.e. not reversed) but
@@ -416,6 +431,21 @@ namespace gnsstk
                 size_t             offset       = 0,
                 bool               littleEndian = false);
 
+            /**
+             * Attempts to decode a valid MGFZI from bufSize raw bytes,
+             * e.g. a message viewed through BinexScanner, without
+             * copying them.
+             * @param  inBuffer Bytes to decode, in normal order
+             * @param  bufSize Number of bytes available at inBuffer
+             * @param  littleEndian Byte order of the encoded bytes
+             * @return Number of bytes decoded
+             * @throw FFStreamError if the MGFZI runs past bufSize bytes
+             */
+         size_t
+         decode(const unsigned char* inBuffer,
+                size_t               bufSize,
+                bool                 littleEndian = false);
+
             /**
              * Converts the MGFZI to a series of bytes placed in outBuffer.
              * The bytes are output in normal order (i.e. not reversed) but
@@ -881,6 +911,53 @@ namespace gnsstk
       virtual size_t
       getRecord(std::istream& s);
 
+         /**
+          * Determines whether the supplied head sync byte is valid an returns
+          * an expected correosponding tail sync byte if appropriate.
+          */
+      static bool
+      isHeadSyncByteValid(SyncByte  headSync,
+                          SyncByte& expectedTailSync);
+
+         /**
+          * Determines whether the supplied tail sync byte is valid an returns
+          * an expected correosponding head sync byte.
+          */
+      static bool
+      isTailSyncByteValid(SyncByte  tailSync,
+                          SyncByte& expectedHeadSync);
+
+         /**
+          * Returns the number of bytes required to store the CRC of a
+          * record with the given synchronization byte and crcDataLen
+          * bytes of record ID, message length and message.
+          */
+      static size_t
+      getCRCLength(SyncByte syncByte,
+                   size_t   crcDataLen);
+
+         /**
+          * Computes the CRC of a record with the given synchronization
+          * byte from its raw head (record ID and message length, without
+          * the synchronization byte) and message, using table-driven
+          * CRC-16/CRC-32.  Records of 1 MiB or more (MD5) are not
+          * supported and get no CRC.
+          * @param syncByte   Record synchronization byte
+          * @param head       Record ID and message length bytes
+          * @param headLen    Number of bytes at head
+          * @param message    Message bytes
+          * @param messageLen Number of bytes at message
+          * @param crc        Receives the CRC; must have room for 16 bytes
+          * @return Number of bytes of CRC stored at crc
+          */
+      static size_t
+      getCRC(SyncByte             syncByte,
+             const unsigned char* head,
+             size_t               headLen,
+             const unsigned char* message,
+             size_t               messageLen,
+             unsigned char*       crc);
+
    protected:
 
          /**
@@ -921,23 +998,11 @@ namespace gnsstk
           * based on the record's current contents.
           */
       size_t
-      getCRCLength(size_t crcDataLen) const;
-
-         /**
-          * Determines whether the supplied head sync byte is valid an returns
-          * an expected correosponding tail sync byte if appropriate.
-          */
-      bool
-      isHeadSyncByteValid(SyncByte  headSync,
-                          SyncByte& expectedTailSync) const;
+      getCRCLength(size_t crcDataLen) const
+      {
+         return getCRCLength(syncByte, crcDataLen);
+      }
 
-         /**
-          * Determines whether the supplied tail sync byte is valid an returns
-          * an expected correosponding head sync byte.
-          */
-      bool
-      isTailSyncByteValid(SyncByte  tailSync,
-                          SyncByte& expectedHeadSync) const;
          /**
           * Converts a raw sequence of bytes into an unsigned long long integer.
           *
@@ -0,0 +1,310 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file BinexScanner.cpp
+ * Fast forward scanning of BINEX records in memory or in a file
+ */
+
+#include "BinexScanner.hpp"
+#include <sstream>
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace gnsstk
+{
+   const size_t BinexScanner::DEFAULT_BLOCK_SIZE;
+
+   // -------------------------------------------------------------------------
+   void BinexScanner::Record::checkOffset(size_t offset, size_t n) const
+   {
+      if (offset > messageLength || n > messageLength - offset)
+      {
+         std::ostringstream errStrm;
+         errStrm << "Message buffer offset invalid: " << offset;
+         InvalidParameter ip(errStrm.str() );
+         GNSSTK_THROW(ip);
+      }
+   }
+
+   // -------------------------------------------------------------------------
+   void BinexScanner::Record::extractMessageData(size_t& offset,
+                                                 BinexData::UBNXI& data) const
+   {
+      checkOffset(offset, 0);
+      offset += data.decode(message + offset, messageLength - offset,
+                            isLittleEndian());
+   }
+
+   // -------------------------------------------------------------------------
+   void BinexScanner::Record::extractMessageData(size_t& offset,
+                                                 BinexData::MGFZI& data) const
+   {
+      checkOffset(offset, 0);
+      offset += data.decode(message + offset, messageLength - offset,
+                            isLittleEndian());
+   }
+
+   // -------------------------------------------------------------------------
+   void BinexScanner::Record::toBinexData(BinexData& data) const
+   {
+      size_t msgOffset = 0;
+      data.clearMessage();
+      data.setRecordFlags(syncByte);
+      data.setRecordID(recID);
+      data.updateMessageData(msgOffset, (const char*)message, messageLength);
+   }
+
+   // -------------------------------------------------------------------------
+   BinexScanner::BinexScanner(const void* buf, size_t size)
+         : data(static_cast<const unsigned char*>(buf)), dataSize(size),
+           pos(0), dataOffset(0), blockSize(0), mappedBase(nullptr),
+           mappedLength(0), checkCRC(true), resync(false), numSkipped(0),
+           numDiscarded(0)
+   {
+   }
+
+   // -------------------------------------------------------------------------
+   BinexScanner::BinexScanner(const std::string& filename,
+                              bool useMap,
+                              size_t bsize)
+         : data(nullptr), dataSize(0), pos(0), dataOffset(0),
+           blockSize(bsize), mappedBase(nullptr), mappedLength(0),
+           checkCRC(true), resync(false), numSkipped(0), numDiscarded(0)
+   {
+#ifndef WIN32
+      if (useMap)
+      {
+         int fd = ::open(filename.c_str(), O_RDONLY);
+         struct stat st;
+         if (fd >= 0 && ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode))
+         {
+            if (st.st_size == 0)
+            {
+                  // nothing to map, and nothing to read
+               ::close(fd);
+               return;
+            }
+            void *base = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED,
+                                fd, 0);
+            if (base != MAP_FAILED)
+            {
+               ::close(fd);
+               mappedBase   = base;
+               mappedLength = st.st_size;
+               data         = static_cast<const unsigned char*>(base);
+               dataSize     = mappedLength;
+               return;
+            }
+         }
+         if (fd >= 0)
+         {
+            ::close(fd);
+         }
+      }
+#endif
+      strm.open(filename.c_str(), std::ios::in | std::ios::binary);
+      if (!strm)
+      {
+         FileMissingException exc("Unable to open BINEX file " + filename);
+         GNSSTK_THROW(exc);
+      }
+      if (blockSize == 0)
+      {
+         blockSize = DEFAULT_BLOCK_SIZE;
+      }
+   }
+
+   // -------------------------------------------------------------------------
+   BinexScanner::~BinexScanner()
+   {
+#ifndef WIN32
+      if (mappedBase != nullptr)
+      {
+         ::munmap(mappedBase, mappedLength);
+      }
+#endif
+   }
+
+   // -------------------------------------------------------------------------
+   bool BinexScanner::available(size_t n)
+   {
+      if (dataSize - pos >= n)
+      {
+         return true;
+      }
+      if (!strm.is_open() || strm.eof())
+      {
+         return false;
+      }
+
+         // Move the unscanned bytes to the front of the buffer, then
+         // fill the rest of the buffer from the file.
+      size_t keep = dataSize - pos;
+      if (pos > 0 && keep > 0)
+      {
+         std::memmove(&buffer[0], &buffer[pos], keep);
+      }
+      dataOffset += pos;
+      pos = 0;
+      size_t want = std::max(n, blockSize);
+      if (buffer.size() < want)
+      {
+         buffer.resize(want);
+      }
+      strm.read((char*)&buffer[keep], buffer.size() - keep);
+      dataSize = keep + strm.gcount();
+      data     = buffer.empty() ? nullptr : &buffer[0];
+      return dataSize >= n;
+   }
+
+   // -------------------------------------------------------------------------
+   bool BinexScanner::next(Record& rec)
+   {
+         // The longest head: sync byte, and 4-byte ID and length UBNXIs
+      const size_t maxHeadLength = 1 + 2 * BinexData::UBNXI::MAX_BYTES;
+
+      while (available(1))
+      {
+         BinexData::SyncByte sync = data[pos];
+         BinexData::SyncByte tailSync;
+         const char *problem = nullptr;
+
+         if (!BinexData::isHeadSyncByteValid(sync, tailSync))
+         {
+            problem = "Invalid BINEX synchronization byte";
+         }
+         else
+         {
+            bool littleEndian = (sync & BinexData::eBigEndian) == 0;
+            BinexData::UBNXI uRecID, uMsgLen;
+            size_t headLength = 0;
+            available(maxHeadLength);
+            try
+            {
+               size_t avail = dataSize - pos;
+               headLength = 1 + uRecID.decode(data + pos + 1, avail - 1,
+                                              littleEndian);
+               headLength += uMsgLen.decode(data + pos + headLength,
+                                            avail - headLength, littleEndian);
+            }
+            catch (FFStreamError&)
+            {
+                  // Only possible at the end of the input
+               problem = "Incomplete BINEX record";
+            }
+
+            if (problem == nullptr)
+            {
+               size_t msgLen = (unsigned long)uMsgLen;
+               size_t crcLen = BinexData::getCRCLength(
+                  sync, headLength - 1 + msgLen);
+               size_t recSize = headLength + msgLen + crcLen;
+               if (tailSync != 0)
+               {
+                     // reversed record length and tail sync byte
+                  recSize += BinexData::UBNXI(recSize).getSize() + 1;
+               }
+
+               if (!available(recSize))
+               {
+                  problem = "Incomplete BINEX record";
+               }
+               else if (tailSync != 0 && data[pos + recSize - 1] != tailSync)
+               {
+                  problem = "BINEX head/tail synchronization byte mismatch";
+               }
+               else if (!selected.empty() &&
+                        selected.find(uRecID) == selected.end())
+               {
+                     // Skip without checking the CRC
+                  pos += recSize;
+                  numSkipped++;
+                  continue;
+               }
+               else
+               {
+                  const unsigned char *head = data + pos;
+                  const unsigned char *msg = head + headLength;
+                  if (checkCRC && crcLen != 16)
+                  {
+                     unsigned char crc[16];
+                     BinexData::getCRC(sync, head + 1, headLength - 1,
+                                       msg, msgLen, crc);
+                     if (std::memcmp(crc, msg + msgLen, crcLen) != 0)
+                     {
+                        problem = "Bad BINEX CRC";
+                     }
+                  }
+                  if (problem == nullptr)
+                  {
+                     rec.syncByte      = sync;
+                     rec.recID         = uRecID;
+                     rec.record        = head;
+                     rec.size          = recSize;
+                     rec.message       = msg;
+                     rec.messageLength = msgLen;
+                     rec.offset        = dataOffset + pos;
+                     pos += recSize;
+                     return true;
+                  }
+               }
+            }
+         }
+
+            // Not a valid record; move on a byte.
+         pos++;
+         if (!resync)
+         {
+            std::ostringstream errStrm;
+            errStrm << problem << " at offset " << (dataOffset + pos - 1);
+            FFStreamError err(errStrm.str());
+            GNSSTK_THROW(err);
+         }
+         numDiscarded++;
+      }
+      return false;
+   }
+
+} // namespace gnsstk
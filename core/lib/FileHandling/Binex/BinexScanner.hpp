@@ -0,0 +1,271 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file BinexScanner.hpp
+ * Fast forward scanning of BINEX records in memory or in a file
+ */
+
+#ifndef GNSSTK_BINEXSCANNER_HPP
+#define GNSSTK_BINEXSCANNER_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+#include "BinexData.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * This class reads BINEX records forward from a memory buffer or a
+       * file without copying them into BinexData objects.  Each record is
+       * returned as a Record, which points into the scanner's buffer and
+       * decodes message fields in place.  Files are memory-mapped where
+       * the platform allows, and read in large blocks otherwise.
+       *
+       * Records whose IDs have not been selected (see select()) are
+       * skipped using only their head, without checking their CRC.  The
+       * CRCs of the other records are checked with table-driven CRC-16
+       * and CRC-32 unless turned off with setCheckCRC(false).  With
+       * setResync(true), bytes that do not start a valid record are
+       * skipped and counted instead of causing an exception, which suits
+       * long archives with occasional corruption.
+       *
+       * Only forward-readable records are handled; a record starting
+       * with a tail synchronization byte (i.e. a reversed file) is
+       * treated as invalid.  Records of 1 MiB or more are assumed to
+       * carry a 16-byte MD5 checksum, which is not checked.
+       *
+       * @code
+       * BinexScanner scanner("data.bnx");
+       * scanner.select(0x7f);
+       * BinexScanner::Record rec;
+       * while (scanner.next(rec))
+       * {
+       *    size_t offset = 0;
+       *    BinexData::UBNXI subrecord;
+       *    rec.extractMessageData(offset, subrecord);
+       *    ...
+       * }
+       * @endcode
+       *
+       * @sa BinexData for reading and writing individual records.
+       */
+   class BinexScanner
+   {
+   public:
+         /** One BINEX record found by the scanner.  The pointers refer
+          * to the scanner's buffer (or the caller's buffer) and are
+          * valid until the next call to next() or the scanner is
+          * destroyed. */
+      class Record
+      {
+      public:
+         Record()
+               : syncByte(0), recID(BinexData::INVALID_RECORD_ID),
+                 record(nullptr), size(0), message(nullptr),
+                 messageLength(0), offset(0)
+         {}
+
+            /// True if the record's numbers are little endian.
+         bool isLittleEndian() const
+         { return (syncByte & BinexData::eBigEndian) == 0; }
+
+            /**
+             * Decodes a UBNXI from the message at offset, and moves
+             * offset past it, as BinexData::extractMessageData().
+             * @throw InvalidParameter if offset is past the message.
+             * @throw FFStreamError if the UBNXI runs past the message.
+             */
+         void extractMessageData(size_t& offset,
+                                 BinexData::UBNXI& data) const;
+
+            /**
+             * Decodes an MGFZI from the message at offset, and moves
+             * offset past it, as BinexData::extractMessageData().
+             * @throw InvalidParameter if offset is past the message.
+             * @throw FFStreamError if the MGFZI runs past the message.
+             */
+         void extractMessageData(size_t& offset,
+                                 BinexData::MGFZI& data) const;
+
+            /**
+             * Decodes sizeof(T) bytes of the message at offset as a
+             * number in the record's byte order, and moves offset past
+             * them.
+             * @throw InvalidParameter if the data runs past the message.
+             */
+         template<class T>
+         void extractMessageData(size_t& offset,
+                                 T& data) const
+         {
+            checkOffset(offset, sizeof(T));
+            std::memcpy(&data, message + offset, sizeof(T));
+            if (isLittleEndian() != BinexData::nativeLittleEndian)
+            {
+               unsigned char *bytes = reinterpret_cast<unsigned char*>(&data);
+               std::reverse(bytes, bytes + sizeof(T));
+            }
+            offset += sizeof(T);
+         }
+
+            /// Copies the record into a BinexData object.
+         void toBinexData(BinexData& data) const;
+
+         BinexData::SyncByte syncByte;  ///< Head synchronization byte
+         BinexData::RecordID recID;     ///< Record ID
+         const unsigned char* record;   ///< First byte of the record
+         size_t size;                   ///< Number of bytes in the record
+         const unsigned char* message;  ///< First byte of the message
+         size_t messageLength;          ///< Number of bytes in the message
+         uint64_t offset;               ///< Position of record in the input
+
+      private:
+            /// @throw InvalidParameter if [offset,offset+n) isn't in message
+         void checkOffset(size_t offset, size_t n) const;
+      };
+
+         /// Default number of bytes read at a time from unmapped files.
+      static const size_t DEFAULT_BLOCK_SIZE = 4194304;
+
+         /**
+          * Scan records in size bytes at buffer, e.g. a file mapped by
+          * the caller.  The buffer is not copied and must outlive the
+          * scanner.
+          */
+      BinexScanner(const void* buffer,
+                   size_t size);
+
+         /**
+          * Scan records in a file.
+          * @param filename  Name of the file to read.
+          * @param useMap    If true, try to memory-map the file, reading
+          *   it in blocks only if that fails.  If false, always read in
+          *   blocks (e.g. for pipes and special files).
+          * @param blockSize Number of bytes to read at a time when the
+          *   file is not mapped.  The buffer grows if a record is larger.
+          * @throw FileMissingException if the file cannot be opened.
+          */
+      BinexScanner(const std::string& filename,
+                   bool useMap = true,
+                   size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+      ~BinexScanner();
+
+         /** Find the next record, skipping unselected ones.
+          * @param[out] rec The record found.
+          * @return false at the end of the input.
+          * @throw FFStreamError if the input does not continue with a
+          *   valid record and resync is off.  The scanner moves one byte
+          *   on, so calling next() again searches for the next record.
+          */
+      bool next(Record& rec);
+
+         /** Have next() return only records with ID id (may be called
+          * for several IDs).  With no IDs selected, all records are
+          * returned. */
+      void select(BinexData::RecordID id)
+      { selected.insert(id); }
+
+         /// Return all records again.
+      void clearSelection()
+      { selected.clear(); }
+
+         /// Turn checking of record CRCs on (the default) or off.
+      void setCheckCRC(bool check)
+      { checkCRC = check; }
+
+         /// Turn skipping of invalid data on or off (the default).
+      void setResync(bool skip)
+      { resync = skip; }
+
+         /// True if the input file is memory-mapped.
+      bool isMapped() const
+      { return mappedBase != nullptr; }
+
+         /// Position in the input of the next byte to be scanned.
+      uint64_t getOffset() const
+      { return dataOffset + pos; }
+
+         /// Number of valid records skipped because not selected.
+      unsigned long getNumSkipped() const
+      { return numSkipped; }
+
+         /// Number of invalid bytes skipped with resync on.
+      uint64_t getNumDiscarded() const
+      { return numDiscarded; }
+
+   private:
+         // Not copyable, as it may own a mapping or a stream.
+      BinexScanner(const BinexScanner&);
+      BinexScanner& operator=(const BinexScanner&);
+
+         /** Make at least n bytes from pos available, reading more of
+          * the file if needed.  This may move the data in buffer.
+          * @return false if the input ends first. */
+      bool available(size_t n);
+
+      const unsigned char* data;  ///< Input bytes in memory
+      size_t dataSize;            ///< Number of bytes at data
+      size_t pos;                 ///< Next byte to scan in data
+      uint64_t dataOffset;        ///< Position in the input of data[0]
+
+      std::ifstream strm;                 ///< File read in blocks
+      std::vector<unsigned char> buffer;  ///< Blocks read from strm
+      size_t blockSize;                   ///< Bytes to read at a time
+      void* mappedBase;                   ///< return value of mmap(), or null
+      size_t mappedLength;                ///< length of the mapping in bytes
+
+      std::set<BinexData::RecordID> selected;
+      bool checkCRC;
+      bool resync;
+      unsigned long numSkipped;
+      uint64_t numDiscarded;
+   };
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_BINEXSCANNER_HPP
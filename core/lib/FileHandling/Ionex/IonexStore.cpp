@@ -44,6 +44,10 @@
  */
 
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "IonexStore.hpp"
 
 using namespace gnsstk::StringUtils;
@@ -59,7 +63,8 @@ namespace gnsstk
    IonexStore ::
    IonexStore()
          : initialTime(CommonTime::END_OF_TIME),
-           finalTime(CommonTime::BEGINNING_OF_TIME)
+           finalTime(CommonTime::BEGINNING_OF_TIME),
+           epochStep(0.0), lazyLoad(false)
    {
    }
 
@@ -98,12 +103,27 @@ namespace gnsstk
             GNSSTK_THROW(e);
          }
 
-            // keep an inventory of the loaded files
-         addFile(filename,header);
-
             // this map is useful in finding DCB value
          inxDCBMap[header.firstEpoch] = header.svsmap;
 
+         if (lazyLoad)
+         {
+               // keep only the inventory, maps are read by loadForTime
+            addFile(filename, header, header.firstEpoch, header.lastEpoch);
+            if (header.firstEpoch < initialTime)
+            {
+               initialTime = header.firstEpoch;
+            }
+            if (header.lastEpoch > finalTime)
+            {
+               finalTime = header.lastEpoch;
+            }
+            return;
+         }
+
+            // keep an inventory of the loaded files
+         addFile(filename,header);
+
             // object data. If valid, add to the map
          IonexData iod;
          while ( strm >> iod && iod.isValid() )
@@ -122,24 +142,187 @@ namespace gnsstk
       // Insert a new IonexData object into the store
    void IonexStore ::
    addMap(const IonexData& iod)
+   {
+      insertMap(iod);
+
+      if (iod.time < initialTime)
+      {
+         initialTime = iod.time;
+      }
+      if (iod.time > finalTime)
+      {
+         finalTime = iod.time;
+      }
+   }  // End of method 'IonexStore::addMap()'
+
+
+   void IonexStore ::
+   insertMap(const IonexData& iod) const
    {
       CommonTime t(iod.time);
       IonexData::IonexValType type(iod.type);
 
-      if (type != IonexData::UN)
+      if ((type == IonexData::TEC) || (type == IonexData::RMS))
       {
-         inxMaps[t][type] = iod;
+            // find or create the slot for this epoch
+         std::vector<CommonTime>::iterator ei =
+            std::lower_bound(epochs.begin(), epochs.end(), t);
+         size_t k = ei - epochs.begin();
+         if ((ei == epochs.end()) || (*ei != t))
+         {
+            bool append = (ei == epochs.end());
+            epochs.insert(ei, t);
+            grids.insert(grids.begin()+k, IonexGrid());
+
+               // Maps are normally added in time order, so only the
+               // newest spacing needs checking.  Anything else
+               // requires checking them all.
+            if (epochs.size() < 2)
+            {
+               epochStep = 0.0;
+            }
+            else if (append && (epochs.size() > 2))
+            {
+               if (std::abs((epochs[k]-epochs[k-1]) - epochStep) > 1e-6)
+               {
+                  epochStep = 0.0;
+               }
+            }
+            else
+            {
+               updateEpochStep();
+            }
+         }
+
+         IonexGrid& grid(grids[k]);
+         grid.lat0 = iod.lat[0];
+         grid.dlat = iod.lat[2];
+         grid.lon0 = iod.lon[0];
+         grid.dlon = iod.lon[2];
+         grid.hgt0 = iod.hgt[0];
+         grid.dhgt = iod.hgt[2];
+         grid.nlat = iod.dim[0];
+         grid.nlon = iod.dim[1];
+         grid.nhgt = iod.dim[2];
+         grid.ncyc = static_cast<int>((360.0 / std::abs(iod.lon[2])) + 0.5);
+
+         std::vector<float>& values(type == IonexData::TEC ?
+                                    grid.tec : grid.rms);
+         values.resize(iod.data.size());
+         for (size_t i = 0; i < iod.data.size(); i++)
+         {
+            values[i] = (iod.data[i] != 999.9) ?
+               static_cast<float>(iod.data[i]) :
+               std::numeric_limits<float>::quiet_NaN();
+         }
       }
+   }  // End of method 'IonexStore::insertMap()'
 
-      if (t < initialTime)
+
+   void IonexStore ::
+   updateEpochStep() const
+   {
+      if (epochs.size() < 2)
       {
-         initialTime = t;
+         epochStep = 0.0;
+         return;
       }
-      else if (t > finalTime)
+      epochStep = epochs[1] - epochs[0];
+      for (size_t i = 2; i < epochs.size(); i++)
       {
-         finalTime = t;
+         if (std::abs((epochs[i]-epochs[i-1]) - epochStep) > 1e-6)
+         {
+            epochStep = 0.0;
+            break;
+         }
       }
-   }  // End of method 'IonexStore::addMap()'
+   }  // End of method 'IonexStore::updateEpochStep()'
+
+
+   void IonexStore ::
+   loadForTime(const CommonTime& t) const
+   {
+      std::vector<std::string> needed = getFilesForTime(t);
+      for (size_t i = 0; i < needed.size(); i++)
+      {
+         if (!useFile(needed[i]))
+         {
+            readMaps(needed[i]);
+         }
+      }
+      std::vector<std::string> unused = trimLoaded(needed.size());
+      for (size_t i = 0; i < unused.size(); i++)
+      {
+         removeMaps(unused[i]);
+      }
+   }  // End of method 'IonexStore::loadForTime()'
+
+
+   void IonexStore ::
+   readMaps(const std::string& filename) const
+   {
+      IonexStream strm(filename.c_str(), std::ios::in);
+      if (!strm)
+      {
+         FileMissingException e("File " + filename +
+                                " could not be opened.");
+         GNSSTK_THROW(e);
+      }
+      IonexHeader header;
+      strm >> header;
+      IonexData iod;
+      while ( strm >> iod && iod.isValid() )
+      {
+         insertMap(iod);
+      }
+   }  // End of method 'IonexStore::readMaps()'
+
+
+   void IonexStore ::
+   removeMaps(const std::string& filename) const
+   {
+      CommonTime begin, end;
+      if (!getTimeSpan(filename, begin, end))
+      {
+         return;
+      }
+         // maps at the ends of a file's span are usually shared with
+         // the adjacent files, so keep those that other loaded files
+         // still cover
+      std::vector<std::pair<CommonTime,CommonTime> > kept;
+      std::vector<std::string> loaded = getLoadedFiles();
+      for (size_t i = 0; i < loaded.size(); i++)
+      {
+         CommonTime b, e;
+         if (getTimeSpan(loaded[i], b, e))
+         {
+            kept.push_back(std::make_pair(b, e));
+         }
+      }
+      size_t n = 0;
+      for (size_t i = 0; i < epochs.size(); i++)
+      {
+         CommonTime t(epochs[i]);
+         t.setTimeSystem(TimeSystem::Any);
+         bool remove = !((t < begin) || (end < t));
+         for (size_t j = 0; remove && (j < kept.size()); j++)
+         {
+            remove = ((t < kept[j].first) || (kept[j].second < t));
+         }
+         if (!remove)
+         {
+            if (n != i)
+            {
+               epochs[n] = epochs[i];
+               grids[n] = std::move(grids[i]);
+            }
+            n++;
+         }
+      }
+      epochs.resize(n);
+      grids.resize(n);
+      updateEpochStep();
+   }  // End of method 'IonexStore::removeMaps()'
 
 
    void IonexStore ::
@@ -162,7 +345,7 @@ namespace gnsstk
       {
          s << "Data stored for: " << std::endl;
          s << "  # " << fileNames.size() << " files." << std::endl;
-         s << "  # " << inxMaps.size() << " epochs" << std::endl;
+         s << "  # " << epochs.size() << " epochs" << std::endl;
          s << "  # " << "over time span "<< getInitialTime()
            << " to " << getFinalTime() << "." << std::endl;
 
@@ -181,13 +364,11 @@ namespace gnsstk
 
          int ntec(0), nrms(0);
 
-         IonexMap::const_iterator it;
-
-         for (it=inxMaps.begin(); it != inxMaps.end(); it++)
+         for (size_t i = 0; i < epochs.size(); i++)
          {
-            s << it->first << "   ";
+            s << epochs[i] << "   ";
 
-            if ( it->second.count(IonexData::TEC) )
+            if ( !grids[i].tec.empty() )
             {
                ntec++;
                s << " YES ";
@@ -197,7 +378,7 @@ namespace gnsstk
                s << "   ";
             }
 
-            if ( it->second.count(IonexData::RMS) )
+            if ( !grids[i].rms.empty() )
             {
                nrms++;
                s << " YES ";
@@ -208,7 +389,7 @@ namespace gnsstk
             }
 
             s << std::endl;
-         }  // End of 'for (it=inxMaps.begin(); it != inxMaps.end(); it++)...'
+         }  // End of 'for (size_t i = 0; i < epochs.size(); i++)...'
 
          s << "--------------------" << std::endl;
          s << "Total epochs:        "
@@ -224,10 +405,20 @@ namespace gnsstk
    void IonexStore ::
    clear()
    {
-      inxMaps.clear();
+      epochs.clear();
+      grids.clear();
+      epochStep = 0.0;
 
       initialTime = CommonTime::END_OF_TIME;
       finalTime = CommonTime::BEGINNING_OF_TIME;
+
+         // in lazy mode the files are the data, and would otherwise
+         // be read again by the next query
+      if (lazyLoad)
+      {
+         FileStore<IonexHeader>::clear();
+         inxDCBMap.clear();
+      }
    }  // End of method 'IonexStore::clear()'
 
 
@@ -237,9 +428,114 @@ namespace gnsstk
                   const Position& RX,
                   IonexStoreStrategy strategy ) const
    {
-         // Here we store the necessary IONEX-extracted values
-         // (i.e, TEC, RMS, ionosphere height)
-      Triple tecval(0.0,0.0,0.0);
+         // this never should happen but just in case
+      if ( RX.getCoordinateSystem() != Position::Geocentric )
+      {
+         InvalidRequest e("Position object is not in GEOCENTRIC coordinates");
+         GNSSTK_THROW(e);
+      }
+
+         // the height is relative to WGS84.a() to be consistent with
+         // Position::getIonosphericPiercePoint()
+      double lat = RX.theArray[0];
+      double lon = RX.theArray[1];
+      double hgt = RX.theArray[2] - WGS84Ellipsoid().a();
+      double tec, rms;
+
+      interpolate(t, 1, &lat, &lon, &hgt, strategy, &tec, &rms);
+
+         // ionosphere height in meters
+      return Triple(tec, rms, RX.theArray[2]);
+   }  // End of method 'IonexStore::getIonexValue()'
+
+
+   void IonexStore ::
+   getIonexValue( const CommonTime& t,
+                  const std::vector<Position>& RX,
+                  std::vector<Triple>& values,
+                  IonexStoreStrategy strategy ) const
+   {
+      size_t n = RX.size();
+      std::vector<double> lat(n), lon(n), hgt(n), tec(n), rms(n);
+      double a = WGS84Ellipsoid().a();
+
+      for (size_t i = 0; i < n; i++)
+      {
+         if ( RX[i].getCoordinateSystem() != Position::Geocentric )
+         {
+            InvalidRequest e("Position object is not in GEOCENTRIC "
+                             "coordinates");
+            GNSSTK_THROW(e);
+         }
+         lat[i] = RX[i].theArray[0];
+         lon[i] = RX[i].theArray[1];
+         hgt[i] = RX[i].theArray[2] - a;
+      }
+
+      interpolate(t, n, lat.data(), lon.data(), hgt.data(), strategy,
+                  tec.data(), rms.data());
+
+      values.resize(n);
+      for (size_t i = 0; i < n; i++)
+      {
+         values[i] = Triple(tec[i], rms[i], RX[i].theArray[2]);
+      }
+   }  // End of method 'IonexStore::getIonexValue()'
+
+
+   size_t IonexStore ::
+   findEpoch(const CommonTime& t) const
+   {
+      size_t n = epochs.size();
+      if (n < 2)
+      {
+         return 0;
+      }
+
+      size_t k;
+      if (epochStep > 0)
+      {
+         double x = (t - epochs[0]) / epochStep;
+         k = (x > 0) ? static_cast<size_t>(x) : 0;
+         if (k > n-2)
+         {
+            k = n-2;
+         }
+            // guard against round-off in the division
+         if ((k > 0) && (t < epochs[k]))
+         {
+            k--;
+         }
+         else if ((k < n-2) && !(t < epochs[k+1]))
+         {
+            k++;
+         }
+      }
+      else
+      {
+         k = std::upper_bound(epochs.begin(), epochs.end(), t)
+            - epochs.begin();
+         k = (k > 0) ? k-1 : 0;
+         if (k > n-2)
+         {
+            k = n-2;
+         }
+      }
+
+      return k;
+   }  // End of method 'IonexStore::findEpoch()'
+
+
+   void IonexStore ::
+   interpolate( const CommonTime& t, size_t n,
+                const double *lat, const double *lon, const double *hgt,
+                IonexStoreStrategy strategy,
+                double *tec, double *rms ) const
+   {
+      if (lazyLoad)
+      {
+         loadForTime(t);
+      }
 
          // current time check
       if (t < getInitialTime())
@@ -254,14 +550,6 @@ namespace gnsstk
          GNSSTK_THROW(e);
       }
 
-         // this never should happen but just in case
-      Position pos(RX);
-      if ( pos.getSystemName() != "Geocentric" )
-      {
-         InvalidRequest e("Position object is not in GEOCENTRIC coordinates");
-         GNSSTK_THROW(e);
-      }
-
          //let's define the number of maps to be considered
       int nmap;
       switch (strategy)
@@ -282,104 +570,163 @@ namespace gnsstk
          }
       }
 
-         // let's look for valid Ionex maps
-      CommonTime T[2];
-         // iterator
-      IonexMap::const_iterator itm = inxMaps.find(t);
-      try
+         // the maps bracketing t, and their factors (As in Eq.(3),
+         // pag.2 of the manual)
+      size_t k = findEpoch(t);
+      size_t imaps[2] = { k, k };
+      double f[2] = { 1.0, 0.0 };
+      if (epochs.size() > 1)
       {
-         if( itm != inxMaps.end() )              // exact match of t
-         {
-               // get the current map
-            itm = inxMaps.lower_bound(t);
-               // store current and next epoch
-            T[0] = itm->first;
-            T[1] = (++itm)->first;
-         }
-         else                                   // t is between two maps
-         {
-               // get the next valid map
-            itm = inxMaps.lower_bound(t);
-               // store the next and previous epoch
-            T[1] = itm->first;
-            T[0] = (--itm)->first;
-         }  // end of 'if( itm != inxMaps.end() ) ... else ... ''
+         imaps[1] = k+1;
+         f[0] = (epochs[k+1]-t) / (epochs[k+1]-epochs[k]);
+         f[1] = (t-epochs[k]) / (epochs[k+1]-epochs[k]);
       }
-      catch (...)
+      else
       {
-         InvalidRequest e("IonexStore::getIonexValue() ... Invalid time!");
-         GNSSTK_THROW(e);
+         nmap = 1;
       }
 
-         // factors (As in Eq.(3), pag.2 of the manual)
-      double f[2];
-      f[0] = (T[1]-t   ) / (T[1]-T[0]);
-      f[1] = (t   -T[0]) / (T[1]-T[0]);
-
          // if only one map, then we have to use the neareast
-      if( nmap == 1 )
+      if (nmap == 1)
       {
             // closer to the next map
-         if( f[1] > f[0] )
+         if (f[1] > f[0])
          {
-            T[0] = T[1];
+            imaps[0] = imaps[1];
          }
 
             // than the factor is unit
          f[0] = 1.0;
-      }  // if( nmap == 1 )
+      }
+
+      std::fill(tec, tec+n, 0.0);
+      std::fill(rms, rms+n, 0.0);
 
          // loop over the number of maps considered
-      for(int imap = 0; imap < nmap; imap++)
+      for (int imap = 0; imap < nmap; imap++)
       {
             // now let's determine if we keep fixed position or
             // take into account the rotation around the Sun
-         Position pos;
-         if ((strategy == IonexStoreStrategy::Nearest) ||
-             (strategy == IonexStoreStrategy::Consecutive))    // fixed position
-         {
-            pos = RX;
-         }
-         else                                   // rotate the position
+         double rot = 0.0;
+         if ((strategy == IonexStoreStrategy::ConsRot) ||
+             (strategy == IonexStoreStrategy::Rotated))
          {
                // seconds of time to degree (360.0 / 86400.0)
             double sec2deg( 4.16666666666667e-3 );
+            rot = (t - epochs[imaps[imap]]) * sec2deg;
+         }
 
-               // count the rotation
-            pos = RX;
-            pos.theArray[1] = pos.theArray[1] + ( t - T[imap] ) * sec2deg;
-         }  // End of 'if (strategy == Nearest || strategy == Consecutive)...'
-
+         addGridValues(grids[imaps[imap]], n, lat, lon, hgt, rot, f[imap],
+                       tec, rms);
+      }
+   }  // End of method 'IonexStore::interpolate()'
 
-            // iterator to the current map
-         itm = inxMaps.find(T[imap]);
 
-            // map to hold the IONEX types for the current map
-         IonexValTypeMap ivtm = (*itm).second;
+   void IonexStore ::
+   addGridValues( const IonexGrid& grid, size_t n,
+                  const double *lat, const double *lon, const double *hgt,
+                  double rot, double factor, double *tec, double *rms )
+   {
+      if (grid.tec.empty() && grid.rms.empty())
+      {
+         return;
+      }
 
-            // object to hold the corresponding data to the current map
-         IonexData iod;
+         // First locate the lower left hand grid point E00 and the
+         // factors P and Q for every point, then do the bivariate
+         // interpolation (pag.3, IONEX manual) as separate loops
+         // over the contiguous grids.
+      std::vector<size_t> e00(n), e10(n);
+      std::vector<double> xp(n), xq(n);
+      for (size_t i = 0; i < n; i++)
+      {
+            // latitude row, the last row being used only as E01
+         double x = (lat[i] - grid.lat0) / grid.dlat;
+         int ilat = static_cast<int>(std::floor(x));
+         if ((ilat == grid.nlat-1) && (x == ilat))
+         {
+            ilat--;
+         }
+         if ((ilat < 0) || (ilat > grid.nlat-2))
+         {
+            InvalidRequest e( "Irregular latitude. Latitude "
+                              + asString(lat[i]) + " DEG" );
+            GNSSTK_THROW(e);
+         }
 
-            // Compute TEC value
-         if ( ivtm.find(IonexData::TEC) != ivtm.end() )
+            // longitude column, wrapping around the globe
+         double y = (lon[i] + rot - grid.lon0) / grid.dlon;
+         double fy = std::floor(y);
+         int ilon = static_cast<int>(fy) % grid.ncyc;
+         if (ilon < 0)
+         {
+            ilon += grid.ncyc;
+         }
+         int ilon1 = ilon + 1;
+         if (ilon1 >= grid.nlon)
+         {
+            ilon1 -= grid.ncyc;
+         }
+         if ((ilon >= grid.nlon) || (ilon1 < 0) || (ilon1 >= grid.nlon))
          {
-            iod = ivtm[IonexData::TEC];
-            tecval[0] = tecval[0] + f[imap]*iod.getValue(pos);
+            InvalidRequest e( "Irregular longitude. Longitude: "
+                              + asString(lon[i]) + " DEG" );
+            GNSSTK_THROW(e);
          }
 
-            // Compute RMS value
-         if ( ivtm.find(IonexData::RMS) != ivtm.end() )
+            // height layer
+         int ihgt = 0;
+         if (grid.dhgt != 0)
          {
-            iod = ivtm[IonexData::RMS];
-            tecval[1] = tecval[1] + f[imap]*iod.getValue(pos);
+            ihgt = static_cast<int>(
+               std::floor((hgt[i]/1000.0 - grid.hgt0) / grid.dhgt));
+            if ((ihgt < 0) || (ihgt >= grid.nhgt))
+            {
+               InvalidRequest e( "Irregular height. Height: "
+                                 + asString( hgt[i]/1000.0 ) + " km.");
+               GNSSTK_THROW(e);
+            }
          }
-      }  // End of 'for(int imap = 0; imap < nmap; imap++)...'
 
-         // ionosphere height in meters
-      tecval[2] = RX.theArray[2];
+         size_t row = (static_cast<size_t>(ihgt)*grid.nlat + ilat)
+            * grid.nlon;
+         e00[i] = row + ilon;
+         e10[i] = row + ilon1;
+         xp[i] = y - fy;
+         xq[i] = x - ilat;
+      }
 
-      return tecval;
-   }  // End of method 'IonexStore::getIonexValue()'
+      const std::vector<float> *maps[2] = { &grid.tec, &grid.rms };
+      double *out[2] = { tec, rms };
+      size_t nlon = grid.nlon;
+      for (int m = 0; m < 2; m++)
+      {
+         if (maps[m]->empty())
+         {
+            continue;
+         }
+         const float *v = maps[m]->data();
+         double *o = out[m];
+         for (size_t i = 0; i < n; i++)
+         {
+            double p = xp[i], q = xq[i];
+            o[i] += factor *
+               ( (1.0-p) * (1.0-q) * v[e00[i]] +
+                 p  * (1.0-q) * v[e10[i]] +
+                 (1.0-p) *      q  * v[e00[i]+nlon] +
+                 p  *      q  * v[e10[i]+nlon] );
+         }
+            // undefined grid values are NaN and propagate
+         for (size_t i = 0; i < n; i++)
+         {
+            if (std::isnan(o[i]))
+            {
+               FFStreamError e("Undefined TEC/RMS value(s).");
+               GNSSTK_THROW(e);
+            }
+         }
+      }
+   }  // End of method 'IonexStore::addGridValues()'
 
 
    double IonexStore ::
@@ -47,6 +47,7 @@
 #define GNSSTK_IONEXSTORE_HPP
 
 #include <map>
+#include <vector>
 
 #include "FileStore.hpp"
 #include "IonexData.hpp"
@@ -76,6 +77,23 @@ namespace gnsstk
        *          hours. When two consecutive files are loaded the previuous
        *          map for 24:00 UT is overwritten by the new 00:00 UT. This
        *          might affect the interpolation strategy.
+       *
+       * Maps are not kept as IonexData objects.  Each epoch's TEC and
+       * RMS grids are stored as contiguous arrays of float, and when
+       * the epochs are evenly spaced (the usual case) the maps
+       * bracketing a time are found by direct indexing rather than
+       * by searching.
+       *
+       * With setLazyLoad(true), loadFile() reads only the header of
+       * each file, and the maps of a file are read the first time a
+       * query needs them.  Use setMaxLoaded() to limit the number of
+       * files whose maps are kept at once, so that memory use
+       * depends on the span of time being queried rather than the
+       * number of files added.
+       *
+       * @warning In lazy mode, the const query methods load and
+       *   unload maps, so a store must not be queried from more
+       *   than one thread at a time.
        */
    class IonexStore : public FileStore<IonexHeader>
    {
@@ -94,6 +112,16 @@ namespace gnsstk
          /// Insert a new IonexData object into the store
       void addMap(const IonexData& iod);
 
+         /** Choose whether loadFile() reads the maps of a file
+          * immediately (the default) or only when they are needed.
+          * This should be set before loading any files. */
+      void setLazyLoad(bool lazy)
+      { lazyLoad = lazy; }
+
+         /// Return true if maps are read only when needed.
+      bool getLazyLoad() const
+      { return lazyLoad; }
+
          /** Dump the store to the provided std::ostream (std::cout by default).
           *
           * @param[in,out] s   std::ostream object to dump the data to.
@@ -106,7 +134,8 @@ namespace gnsstk
       void dump( std::ostream& s = std::cout,
                  short detail = 0 ) const;
 
-         /// Remove all data
+         /** Remove all data.  In lazy mode, the files added are
+          * also removed. */
       void clear();
 
          /** Get IONEX TEC, RMS and ionosphere height values as a function of
@@ -133,6 +162,35 @@ namespace gnsstk
                             IonexStoreStrategy strategy =
                             IonexStoreStrategy::ConsRot ) const;
 
+         /** Get IONEX TEC, RMS and ionosphere height values for
+          * many ionospheric pierce points at a single epoch.
+          *
+          * This gives the same results as calling the single
+          * position getIonexValue() for each element of \a RX, but
+          * the map selection and time interpolation factors are
+          * computed once, and the spatial interpolation is done in
+          * tight loops over the contiguous grids.
+          *
+          * @param[in] t          Time tag of signal (CommonTime object)
+          * @param[in] RX         Pierce point positions in geocentric
+          *                       coordinates.
+          * @param[out] values    TEC, RMS and ionosphere height for each
+          *                       element of \a RX, as returned by the
+          *                       single position getIonexValue().
+          * @param[in] strategy   Interpolation strategy.  The rotated
+          *                       strategies shift each map in
+          *                       longitude by the Earth's rotation
+          *                       between the map epoch and \a t.
+          * @throw InvalidRequest if \a t is outside the loaded maps, or
+          *   any position is not geocentric or lies outside the grid.
+          * @throw FFStreamError if any grid point used is undefined.
+          */
+      void getIonexValue( const CommonTime& t,
+                          const std::vector<Position>& RX,
+                          std::vector<Triple>& values,
+                          IonexStoreStrategy strategy =
+                          IonexStoreStrategy::ConsRot ) const;
+
          /** Get slant total electron content (STEC) in TECU
           *
           * @param[in] elevation    Time tag of signal (CommonTime object)
@@ -308,14 +366,87 @@ namespace gnsstk
           */
       CommonTime initialTime, finalTime;
 
-         /// The key to this map is IonexValType
-      typedef std::map<IonexData::IonexValType, IonexData> IonexValTypeMap;
-
-         /// The key to this map is the time
-      typedef std::map<CommonTime, IonexValTypeMap> IonexMap;
-
-         /// Map of IONEX maps
-      IonexMap inxMaps;
+         /** TEC and RMS maps for one epoch, kept as flat arrays in
+          * the IONEX order (longitude fastest, then latitude, then
+          * height).  Undefined values are stored as NaN. */
+      struct IonexGrid
+      {
+         double lat0, dlat;      ///< first latitude and spacing, degrees
+         double lon0, dlon;      ///< first longitude and spacing, degrees
+         double hgt0, dhgt;      ///< first height and spacing, km
+         int nlat, nlon, nhgt;   ///< grid dimensions
+         int ncyc;               ///< number of longitude steps in 360 deg
+         std::vector<float> tec; ///< TEC values (TECU), empty if none
+         std::vector<float> rms; ///< RMS values (TECU), empty if none
+      };
+
+         /** Interpolate one grid at a set of pierce points and add
+          * \a factor times the result to \a tec and \a rms.
+          * @param[in] grid the map to interpolate.
+          * @param[in] n the number of pierce points.
+          * @param[in] lat geocentric latitudes in degrees.
+          * @param[in] lon longitudes in degrees.
+          * @param[in] hgt heights above the WGS84 semi-major axis in m.
+          * @param[in] rot longitude shift in degrees applied to \a lon.
+          * @param[in] factor time interpolation factor for this map.
+          * @param[in,out] tec accumulated TEC values.
+          * @param[in,out] rms accumulated RMS values.
+          * @throw InvalidRequest
+          * @throw FFStreamError */
+      static void addGridValues( const IonexGrid& grid, size_t n,
+                                 const double *lat, const double *lon,
+                                 const double *hgt, double rot,
+                                 double factor, double *tec, double *rms );
+
+         /** Compute TEC and RMS for a set of pierce points, given as
+          * separate geocentric coordinate arrays.
+          * @throw InvalidRequest
+          * @throw FFStreamError */
+      void interpolate( const CommonTime& t, size_t n,
+                        const double *lat, const double *lon,
+                        const double *hgt, IonexStoreStrategy strategy,
+                        double *tec, double *rms ) const;
+
+         /** Get the index of the last map epoch at or before \a t,
+          * limited so that the following epoch also exists (when
+          * there is more than one map).
+          * @pre initialTime <= t <= finalTime */
+      size_t findEpoch(const CommonTime& t) const;
+
+         /// Store the TEC or RMS map in iod without updating the time span.
+      void insertMap(const IonexData& iod) const;
+
+         /** Read the maps of every file needed for time t that isn't
+          * already loaded, then unload the least recently used
+          * files beyond the limit set by setMaxLoaded().
+          * @throw FileMissingException */
+      void loadForTime(const CommonTime& t) const;
+
+         /** Read all the maps in a file.
+          * @throw FileMissingException */
+      void readMaps(const std::string& filename) const;
+
+         /// Remove the maps of a file not also covered by a loaded file.
+      void removeMaps(const std::string& filename) const;
+
+         /// Recompute epochStep from epochs.
+      void updateEpochStep() const;
+
+         /** Epochs of the stored maps, in increasing order.  This and
+          * the other map storage are mutable so that maps can be
+          * loaded on demand by queries. */
+      mutable std::vector<CommonTime> epochs;
+
+         /// Maps for each element of epochs.
+      mutable std::vector<IonexGrid> grids;
+
+         /** Spacing of epochs in seconds, or 0 if the epochs are not
+          * evenly spaced, in which case findEpoch() does a binary
+          * search. */
+      mutable double epochStep;
+
+         /// If true, maps are read only when needed.
+      bool lazyLoad;
 
          /// The key of this map is the time (first epoch as in IonexHeader)
       typedef std::map<CommonTime, IonexHeader::SatDCBMap> IonexDCBMap;
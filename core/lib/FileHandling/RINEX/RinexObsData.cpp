@@ -52,9 +52,6 @@ using namespace std;
 namespace gnsstk
 {
 
-      // Definition of static variable to be used across RinexObsData objects
-   CommonTime gnsstk::RinexObsData::previousTime;
-
    void RinexObsData::reallyPutRecord(FFStream& ffs) const
    {
       // is there anything to write?
@@ -257,12 +254,12 @@ namespace gnsstk
       }
       else if (noEpochTime)
       {
-         time = previousTime;
+         time = strm.previousTime;
       }
       else
       {
          time = parseTime(line, hdr);
-         previousTime = time;
+         strm.previousTime = time;
       }
 
       numSvs = asInt(line.substr(29,3));
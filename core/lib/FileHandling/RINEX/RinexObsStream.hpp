@@ -111,6 +111,11 @@ namespace gnsstk
          /// The header for this file.
       RinexObsHeader header;
 
+         /** Time of the previous set of observations read, used for
+          * records with no epoch time. Kept per stream so that
+          * several files may be read concurrently. */
+      CommonTime previousTime;
+
          /// Check if the input stream is the kind of RinexObsStream
       static bool isRinexObsStream(std::istream& i);
 
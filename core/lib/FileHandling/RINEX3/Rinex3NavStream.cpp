@@ -80,4 +80,49 @@ namespace gnsstk
       headerRead = false;
       header = Rinex3NavHeader();
    }
+
+
+   std::streamoff Rinex3NavStream ::
+   findRecord(std::streamoff offset)
+   {
+      std::string line;
+      clear();
+      if (offset > 0)
+      {
+            // skip the rest of a line that starts before offset
+         seekg(offset-1);
+         if (get() != '\n')
+            std::getline(*this, line);
+      }
+      else
+      {
+         seekg(0);
+      }
+      while (true)
+      {
+         std::streamoff pos = tellg();
+         if (!std::getline(*this, line))
+            break;
+         if (!line.empty() && (line[line.length()-1] == '\r'))
+            line.erase(line.length()-1);
+            // Continuation lines are indented 4 (RINEX 3) or 3
+            // (RINEX 2) spaces, epoch lines are not.
+         if (header.version >= 3)
+         {
+            if (!line.empty() && (line[0] != ' '))
+            {
+               seekg(pos);
+               return pos;
+            }
+         }
+         else if ((line.length() >= 3) && (line.compare(0, 3, "   ") != 0))
+         {
+            seekg(pos);
+            return pos;
+         }
+      }
+      clear();
+      seekg(0, std::ios::end);
+      return tellg();
+   }
 }
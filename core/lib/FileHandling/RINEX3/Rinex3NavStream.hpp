@@ -82,6 +82,19 @@ namespace gnsstk
          /// Flag showing whether or not the header has been read.
       bool headerRead;
 
+         /** Find the start of the first record that begins at or
+          * after a byte offset, so that a file can be split into
+          * pieces that are read separately.  The header must have
+          * been read, as the record format depends on the version.
+          * The stream is left positioned at the returned offset.
+          * @param[in] offset The byte offset to start looking at.
+          *   Part of a line at offset is skipped.
+          * @return The byte offset of the first line of the record,
+          *   or of the end of the file if there is no record after
+          *   offset.
+          */
+      std::streamoff findRecord(std::streamoff offset);
+
    private:
          /// initialize internal data structures
       void init();
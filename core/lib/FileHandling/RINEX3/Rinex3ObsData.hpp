@@ -233,6 +233,8 @@ namespace gnsstk
                             const Rinex3ObsHeader& hdr,
                             const TimeSystem& ts) const;
 
+         /// Rinex3ObsIndex uses parseTime() to read only the epoch lines.
+      friend class Rinex3ObsIndex;
 
    }; // End of class 'Rinex3ObsData'
 
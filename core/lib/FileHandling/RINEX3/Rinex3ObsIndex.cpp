@@ -0,0 +1,391 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file Rinex3ObsIndex.cpp
+ * Index of the epoch records in a RINEX observation file by time.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sys/stat.h>
+#include "Rinex3ObsIndex.hpp"
+#include "StringUtils.hpp"
+#include "parallel_for.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+      /// Version line at the start of files written by save().
+   static const string indexFileVersion("Rinex3ObsIndex 1");
+      /// Shortest possible entry line written by save(), "0 0 0 0 0\n".
+   static const size_t minEntryLength = 10;
+
+
+   Rinex3ObsIndex ::
+   Rinex3ObsIndex()
+         : fileSize(0), fileTime(0)
+   {
+   }
+
+
+   void Rinex3ObsIndex ::
+   build(const std::string& fn)
+   {
+      clear();
+      if (!getFileInfo(fn, fileSize, fileTime))
+      {
+         FileMissingException exc("Can't read " + fn);
+         GNSSTK_THROW(exc);
+      }
+      Rinex3ObsStream strm(fn.c_str());
+      if (!strm)
+      {
+         FileMissingException exc("Can't read " + fn);
+         GNSSTK_THROW(exc);
+      }
+      strm.exceptions(std::ios::failbit);
+      Rinex3ObsHeader hdr;
+      strm >> hdr;
+      fileName = fn;
+      if (hdr.version < 3)
+         scanVer2(strm);
+      else
+         scanVer3(strm);
+   }
+
+
+   void Rinex3ObsIndex ::
+   scanVer3(Rinex3ObsStream& strm)
+   {
+      Rinex3ObsData rod;
+      streamoff offset = strm.tellg();
+      unsigned lineNumber = strm.lineNumber;
+      strm.exceptions(std::ios::goodbit);
+      string line;
+      while (getline(strm, line))
+      {
+         Entry entry;
+         entry.offset = offset;
+         entry.lineNumber = lineNumber;
+         offset += line.length() + 1;
+         lineNumber++;
+         if (!line.empty() && (line[line.length()-1] == '\r'))
+            line.erase(line.length()-1);
+         if ((line.length() < 35) || (line[0] != '>') || (line[1] != ' '))
+         {
+            FFStreamError e("Bad epoch line: >" + line + "< at line " +
+                            StringUtils::asString(lineNumber) + " of " +
+                            fileName);
+            GNSSTK_THROW(e);
+         }
+         try
+         {
+            entry.time = rod.parseTime(line, strm.header, strm.timesystem);
+         }
+         catch (Exception& e)
+         {
+            e.addText("At line " + StringUtils::asString(lineNumber) +
+                      " of " + fileName);
+            GNSSTK_RETHROW(e);
+         }
+            // auxiliary header records may have no time
+         if ((entry.time == CommonTime::BEGINNING_OF_TIME) && !entries.empty())
+            entry.time = entries.back().time;
+         entries.push_back(entry);
+            // Skip the satellite or header lines that follow.
+         int numLines = StringUtils::asInt(line.substr(32,3));
+         for (int i = 0; (i < numLines) && getline(strm, line); i++)
+         {
+            offset += line.length() + 1;
+            lineNumber++;
+         }
+      }
+   }
+
+
+   void Rinex3ObsIndex ::
+   scanVer2(Rinex3ObsStream& strm)
+   {
+      Rinex3ObsData rod;
+      while (true)
+      {
+         Entry entry;
+         entry.offset = strm.tellg();
+         entry.lineNumber = strm.lineNumber;
+         if (!(strm >> rod))
+            break;
+         entry.time = rod.time;
+         entries.push_back(entry);
+      }
+   }
+
+
+   void Rinex3ObsIndex ::
+   save(const std::string& indexName) const
+   {
+      ofstream out(indexName.c_str());
+      if (!out)
+      {
+         FileMissingException exc("Can't write " + indexName);
+         GNSSTK_THROW(exc);
+      }
+      TimeSystem ts = (entries.empty() ? TimeSystem::Any :
+                       entries.front().time.getTimeSystem());
+      out << indexFileVersion << endl << fileName << endl
+          << fileSize << " " << static_cast<long long>(fileTime) << " "
+          << entries.size() << " " << static_cast<int>(ts) << endl
+          << setprecision(17);
+      for (size_t i = 0; i < entries.size(); i++)
+      {
+         long day, msod;
+         double fsod;
+         entries[i].time.getInternal(day, msod, fsod);
+         out << day << " " << msod << " " << fsod << " "
+             << static_cast<long long>(entries[i].offset) << " "
+             << entries[i].lineNumber << '\n';
+      }
+      out.close();
+      if (!out)
+      {
+         FileMissingException exc("Error writing " + indexName);
+         GNSSTK_THROW(exc);
+      }
+   }
+
+
+   void Rinex3ObsIndex ::
+   load(const std::string& indexName)
+   {
+      ifstream in(indexName.c_str());
+      if (!in)
+      {
+         FileMissingException exc("Can't read " + indexName);
+         GNSSTK_THROW(exc);
+      }
+      string line, fn;
+      getline(in, line);
+      if (line != indexFileVersion)
+      {
+         FFStreamError exc(indexName + " is not a Rinex3ObsIndex file");
+         GNSSTK_THROW(exc);
+      }
+      getline(in, fn);
+      long long size, mtime;
+      size_t count;
+      int ts;
+      if (!(in >> size >> mtime >> count >> ts))
+      {
+         FFStreamError exc("Invalid header in " + indexName);
+         GNSSTK_THROW(exc);
+      }
+         // Each entry takes at least minEntryLength bytes, so a count
+         // the rest of the file can't hold is damage, not a reason to
+         // allocate that many entries.
+      streamoff here = in.tellg();
+      in.seekg(0, ios::end);
+      streamoff left = in.tellg() - here;
+      in.seekg(here);
+      if (count > static_cast<size_t>(left) / minEntryLength)
+      {
+         FFStreamError exc("Invalid entry count in " + indexName);
+         GNSSTK_THROW(exc);
+      }
+      EntryList newEntries(count);
+      for (size_t i = 0; i < count; i++)
+      {
+         long day, msod;
+         double fsod;
+         long long offset;
+         if (!(in >> day >> msod >> fsod >> offset
+               >> newEntries[i].lineNumber))
+         {
+            FFStreamError exc("Invalid entry " + StringUtils::asString(i) +
+                              " in " + indexName);
+            GNSSTK_THROW(exc);
+         }
+         newEntries[i].time.setInternal(day, msod, fsod,
+                                        static_cast<TimeSystem>(ts));
+         newEntries[i].offset = offset;
+      }
+      fileName = fn;
+      fileSize = size;
+      fileTime = static_cast<time_t>(mtime);
+      entries.swap(newEntries);
+   }
+
+
+   bool Rinex3ObsIndex ::
+   loadOrBuild(const std::string& fn, bool write)
+   {
+      string indexName(getIndexName(fn));
+      long long size;
+      time_t mtime;
+      if (getFileInfo(indexName, size, mtime))
+      {
+         try
+         {
+            load(indexName);
+            fileName = fn;
+            if (isCurrent())
+               return true;
+         }
+         catch (Exception&)
+         {
+               // rebuild a damaged index
+         }
+      }
+      build(fn);
+      if (write)
+      {
+         try
+         {
+            save(indexName);
+         }
+         catch (Exception&)
+         {
+               // The index is still usable without a saved copy,
+               // e.g. when the directory is read-only.
+         }
+      }
+      return false;
+   }
+
+
+   bool Rinex3ObsIndex ::
+   isCurrent() const
+   {
+      long long size;
+      time_t mtime;
+      if (!getFileInfo(fileName, size, mtime))
+         return false;
+      return ((size == fileSize) && (mtime == fileTime));
+   }
+
+
+   size_t Rinex3ObsIndex ::
+   find(const CommonTime& t) const
+   {
+      EntryList::const_iterator i = lower_bound(
+         entries.begin(), entries.end(), t,
+         [](const Entry& e, const CommonTime& ct) { return e.time < ct; });
+      return i - entries.begin();
+   }
+
+
+   void Rinex3ObsIndex ::
+   read(std::vector<Rinex3ObsData>& data, const CommonTime& begin,
+        const CommonTime& end, unsigned nthreads) const
+   {
+      size_t first = find(begin);
+      size_t last = std::max(first, find(end));
+      data.clear();
+      data.resize(last - first);
+      if (data.empty())
+         return;
+
+         // Read the header once here rather than on each thread.
+      Rinex3ObsStream hstrm(fileName.c_str());
+      if (!hstrm)
+      {
+         FileMissingException exc("Can't read " + fileName);
+         GNSSTK_THROW(exc);
+      }
+      hstrm.exceptions(std::ios::failbit);
+      Rinex3ObsHeader hdr;
+      hstrm >> hdr;
+
+         // Use a few chunks per thread to even out the load.
+      nthreads = numThreads(nthreads, data.size());
+      size_t numChunks = std::min(data.size(), size_t(nthreads) * 4);
+      size_t chunkSize = (data.size() + numChunks - 1) / numChunks;
+      parallelFor(numChunks, nthreads,
+                  [&](size_t chunk)
+                  {
+                     size_t b = first + chunk * chunkSize;
+                     size_t e = std::min(b + chunkSize, last);
+                     if (b >= e)
+                        return;
+                     Rinex3ObsStream strm(fileName.c_str());
+                     if (!strm)
+                     {
+                        FileMissingException exc("Can't read " + fileName);
+                        GNSSTK_THROW(exc);
+                     }
+                     strm.exceptions(std::ios::failbit);
+                     strm.header = hstrm.header;
+                     strm.headerRead = true;
+                     strm.timesystem = hstrm.timesystem;
+                     strm.seekRecord(*this, b);
+                     for (size_t i = b; i < e; i++)
+                     {
+                        if (!(strm >> data[i - first]))
+                        {
+                           FFStreamError exc("Unexpected end of " + fileName +
+                                             ", the index may be out of date");
+                           GNSSTK_THROW(exc);
+                        }
+                     }
+                  });
+   }
+
+
+   void Rinex3ObsIndex ::
+   clear()
+   {
+      fileName.clear();
+      fileSize = 0;
+      fileTime = 0;
+      entries.clear();
+   }
+
+
+   bool Rinex3ObsIndex ::
+   getFileInfo(const std::string& fn, long long& size, time_t& mtime)
+   {
+      struct stat st;
+      if (stat(fn.c_str(), &st) != 0)
+         return false;
+      size = st.st_size;
+      mtime = st.st_mtime;
+      return true;
+   }
+
+} // namespace gnsstk
@@ -0,0 +1,230 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file Rinex3ObsIndex.hpp
+ * Index of the epoch records in a RINEX observation file by time.
+ */
+
+#ifndef RINEX3OBSINDEX_HPP
+#define RINEX3OBSINDEX_HPP
+
+#include <ctime>
+#include <ios>
+#include <string>
+#include <vector>
+
+#include "CommonTime.hpp"
+#include "Rinex3ObsData.hpp"
+#include "Rinex3ObsStream.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /** An index of the epoch records in a RINEX observation file,
+       * giving the time and byte offset of each record so that
+       * reading can start anywhere in the file without parsing the
+       * records before it.
+       *
+       * The index is built by build(), which for RINEX 3 files only
+       * parses the epoch lines, and can be saved to a file next to
+       * the observation file so later runs can load it instead.
+       * loadOrBuild() does both: it loads the saved index if it is
+       * still current and builds and saves it otherwise.
+       *
+       * Rinex3ObsStream::seekTime() uses an index to position a
+       * stream at a given time, and read() uses one to read a time
+       * span of the file on several threads at once.
+       *
+       * @code{.cpp}
+       *    gnsstk::Rinex3ObsIndex index;
+       *    index.loadOrBuild("site2900.16o");
+       *    gnsstk::Rinex3ObsStream strm("site2900.16o");
+       *    gnsstk::Rinex3ObsData rod;
+       *    strm.seekTime(index, startTime);
+       *    while ((strm >> rod) && (rod.time < endTime))
+       *    {
+       *       ...
+       *    }
+       * @endcode
+       *
+       * @note The records in the file are expected to be in time
+       *   order, as RINEX requires.  Records with no epoch time
+       *   (auxiliary header records) are given the time of the
+       *   record before them.
+       */
+   class Rinex3ObsIndex
+   {
+   public:
+         /// The position of one epoch record in the file.
+      struct Entry
+      {
+         CommonTime time;        ///< Epoch time of the record.
+         std::streamoff offset;  ///< Byte offset of the epoch line.
+         unsigned lineNumber;    ///< Number of lines before the record.
+      };
+         /// Index entries in file order.
+      typedef std::vector<Entry> EntryList;
+
+         /// Create an empty index.
+      Rinex3ObsIndex();
+
+         /** Index the records of a RINEX observation file, replacing
+          * the contents of this index.
+          * @param[in] fn The observation file to index.
+          * @throw FileMissingException if fn can't be read.
+          * @throw FFStreamError if the header or an epoch line is
+          *   invalid.
+          */
+      void build(const std::string& fn);
+
+         /** Write the index to a file.
+          * @param[in] indexName The file to write.
+          * @throw FileMissingException if the file can't be written.
+          */
+      void save(const std::string& indexName) const;
+
+         /** Replace the contents of this index with those of a file
+          * written by save().
+          * @param[in] indexName The file to read.
+          * @throw FileMissingException if the file can't be read.
+          * @throw FFStreamError if the file isn't a valid index.
+          */
+      void load(const std::string& indexName);
+
+         /** Load the index for a RINEX observation file from
+          * getIndexName(fn) if it is current, otherwise build it and
+          * (if write is true) save it there.
+          * @param[in] fn The observation file to index.
+          * @param[in] write If true, save a newly built index.
+          * @return true if the index was loaded, false if it was
+          *   built.  A failure to save the index isn't an error, the
+          *   index is just built again next time.
+          * @throw FileMissingException if fn can't be read.
+          * @throw FFStreamError if fn is invalid.
+          */
+      bool loadOrBuild(const std::string& fn, bool write = true);
+
+         /// Return the name of the file an index of fn is saved to.
+      static std::string getIndexName(const std::string& fn)
+      { return fn + ".idx"; }
+
+         /** Check whether the indexed file still has the size and
+          * modification time it had when it was indexed.
+          */
+      bool isCurrent() const;
+
+         /** Return the position of the first record with a time at
+          * or after t, or size() if there is none.
+          * @param[in] t The time to look for.  It must be in the
+          *   time system of the file or TimeSystem::Any.
+          */
+      size_t find(const CommonTime& t) const;
+
+         /** Read the records with a time in [begin,end) using
+          * several threads.  The records are split into chunks, each
+          * of which is read by its own stream, and stored in file
+          * order.
+          * @param[out] data The records read.  Records with epoch
+          *   flags 2-5 are included, as they are when reading with
+          *   a stream.
+          * @param[in] begin The earliest time to read.
+          * @param[in] end The time to stop reading at.
+          * @param[in] nthreads The number of threads to use, 0 for
+          *   one per hardware thread.
+          * @throw FileMissingException if the file can't be read.
+          * @throw FFStreamError if a record can't be read.
+          */
+      void read(std::vector<Rinex3ObsData>& data,
+                const CommonTime& begin = CommonTime::BEGINNING_OF_TIME,
+                const CommonTime& end = CommonTime::END_OF_TIME,
+                unsigned nthreads = 0) const;
+
+         /// Return the name of the indexed file.
+      const std::string& getFileName() const
+      { return fileName; }
+
+         /// Return the index entries.
+      const EntryList& getEntries() const
+      { return entries; }
+
+         /// Return the number of records in the index.
+      size_t size() const
+      { return entries.size(); }
+
+         /// Remove all entries.
+      void clear();
+
+   private:
+         /** Add entries for the records of a RINEX 3 file by reading
+          * only the epoch lines.
+          * @param[in] strm The stream the header has been read from.
+          * @throw FFStreamError if an epoch line is invalid.
+          */
+      void scanVer3(Rinex3ObsStream& strm);
+
+         /** Add entries for the records of a RINEX 2 file by reading
+          * each record.
+          * @param[in] strm The stream the header has been read from.
+          * @throw FFStreamError if a record is invalid.
+          */
+      void scanVer2(Rinex3ObsStream& strm);
+
+         /** Get the size and modification time of a file.
+          * @return false if the file can't be found.
+          */
+      static bool getFileInfo(const std::string& fn, long long& size,
+                              time_t& mtime);
+
+         /// The indexed file.
+      std::string fileName;
+         /// Size of fileName when it was indexed.
+      long long fileSize;
+         /// Modification time of fileName when it was indexed.
+      time_t fileTime;
+         /// One entry per epoch record, in file order.
+      EntryList entries;
+   }; // class Rinex3ObsIndex
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // RINEX3OBSINDEX_HPP
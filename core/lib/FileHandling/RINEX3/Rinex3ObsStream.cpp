@@ -42,6 +42,7 @@
  */
 
 #include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsIndex.hpp"
 
 namespace gnsstk
 {
@@ -91,6 +92,7 @@ namespace gnsstk
       headerRead = false;
       header = Rinex3ObsHeader();
       timesystem = TimeSystem::GPS;
+      previousTime = CommonTime::BEGINNING_OF_TIME;
    }
 
 
@@ -102,6 +104,43 @@ namespace gnsstk
    }
 
 
+   bool Rinex3ObsStream ::
+   seekTime(const Rinex3ObsIndex& index, const CommonTime& t)
+   {
+      size_t recNum = index.find(t);
+      seekRecord(index, recNum);
+      return (recNum < index.size());
+   }
+
+
+   void Rinex3ObsStream ::
+   seekRecord(const Rinex3ObsIndex& index, size_t recNum)
+   {
+      if (!headerRead)
+      {
+         Rinex3ObsHeader hdr;
+         *this >> hdr;
+         if (!headerRead)
+         {
+            FFStreamError e("Unable to read the header of " + filename);
+            GNSSTK_THROW(e);
+         }
+      }
+      clear();
+      if (recNum >= index.size())
+      {
+         seekg(0, std::ios::end);
+         return;
+      }
+      const Rinex3ObsIndex::Entry& entry(index.getEntries()[recNum]);
+      seekg(entry.offset, std::ios::beg);
+      lineNumber = entry.lineNumber;
+         // the header counts as the first record
+      recordNumber = recNum + 1;
+      previousTime = entry.time;
+   }
+
+
    bool Rinex3ObsStream ::
    isRinex3ObsStream(std::istream& i)
    {
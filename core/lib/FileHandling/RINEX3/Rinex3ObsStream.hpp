@@ -54,6 +54,8 @@
 
 namespace gnsstk
 {
+   class Rinex3ObsIndex;
+
       /// @ingroup FileHandling
       //@{
 
@@ -112,6 +114,35 @@ namespace gnsstk
          /// Time system for epochs in this file
       TimeSystem timesystem;
 
+         /** Time of the last epoch read, used for RINEX 2 auxiliary
+          * header records that have no epoch time. */
+      CommonTime previousTime;
+
+         /** Position the stream at the first record with a time at
+          * or after t, reading the header first if it hasn't been
+          * read.
+          * @param[in] index The index of the file this stream is
+          *   reading.
+          * @param[in] t The time to look for.  It must be in the time
+          *   system of the file or TimeSystem::Any.
+          * @return false if there is no record at or after t, in
+          *   which case the stream is positioned at the end of the
+          *   file.
+          * @throw FFStreamError if the header can't be read.
+          */
+      bool seekTime(const Rinex3ObsIndex& index, const CommonTime& t);
+
+         /** Position the stream at the start of a record, reading the
+          * header first if it hasn't been read.
+          * @param[in] index The index of the file this stream is
+          *   reading.
+          * @param[in] recNum The position of the record in the
+          *   index.  Values of index.size() or more position the
+          *   stream at the end of the file.
+          * @throw FFStreamError if the header can't be read.
+          */
+      void seekRecord(const Rinex3ObsIndex& index, size_t recNum);
+
          /// Check if the input stream is the kind of Rinex3ObsStream
       static bool isRinex3ObsStream(std::istream& i);
 
@@ -104,7 +104,7 @@ namespace gnsstk
    {
       THROW_IF_INVALID();
 
-      double ddry(2.29951*std::exp((-0.000116 * gcatHeight) ));
+      double ddry(dryZenith(gcatHeight));
 
       return ddry;
    }
@@ -116,10 +116,39 @@ namespace gnsstk
 
       if(elevation < 5.0) return 0.0;
 
-      double d = std::sin(elevation*DEG_TO_RAD);
-      d = SQRT(0.002001+(d*d));
+      return mapping(std::sin(elevation*DEG_TO_RAD));
+   }
+
 
-      return (1.001/d);
+   void GCATTropModel::getComponents(const std::vector<Position>& RX,
+                                     const std::vector<double>& elevation,
+                                     const std::vector<CommonTime>& tt,
+                                     std::vector<Components>& comps)
+   {
+      size_t n = elevation.size();
+      checkBatchSizes(RX.size(), tt.size(), n);
+      comps.resize(n);
+
+      const Position *lastRX = nullptr;
+      double dz(0.0);
+      for(size_t i=0; i<n; i++)
+      {
+         const Position& rx(RX[RX.size() == 1 ? 0 : i]);
+         if(&rx != lastRX)
+         {
+            dz = dryZenith(rx.getAltitude());
+            lastRX = &rx;
+         }
+         comps[i].dryZenith = dz;
+         comps[i].wetZenith = wet_zenith_delay();
+      }
+
+      for(size_t i=0; i<n; i++)
+      {
+         double map = (elevation[i] < 5.0) ? 0.0 :
+            mapping(std::sin(elevation[i]*DEG_TO_RAD));
+         comps[i].dryMap = comps[i].wetMap = map;
+      }
    }
 
 
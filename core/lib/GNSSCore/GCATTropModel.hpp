@@ -40,6 +40,8 @@
 #ifndef GCAT_TROP_MODEL_HPP
 #define GCAT_TROP_MODEL_HPP
 
+#include <cmath>
+#include "MathBase.hpp"
 #include "TropModel.hpp"
 
 namespace gnsstk
@@ -159,6 +161,16 @@ namespace gnsstk
       { return 0.1; };
 
 
+         /** @copydoc TropModel::getComponents()
+          *
+          * Only the receiver height is used from \a RX; \a tt is
+          * not used but must still have a valid size. */
+      virtual void getComponents(const std::vector<Position>& RX,
+                                 const std::vector<double>& elevation,
+                                 const std::vector<CommonTime>& tt,
+                                 std::vector<Components>& comps);
+
+
          /** Compute and return the mapping function for both components of
           * the troposphere.
           *
@@ -203,6 +215,16 @@ namespace gnsstk
 
    private:
 
+         /** Evaluate the mapping function.
+          * @param se Sine of the elevation. */
+      static double mapping(double se)
+      { return (1.001/SQRT(0.002001+(se*se))); }
+
+         /** Evaluate the dry zenith delay.
+          * @param ht Receiver height in meters. */
+      static double dryZenith(double ht)
+      { return 2.29951*std::exp((-0.000116 * ht)); }
+
          /// Receiver height
       double gcatHeight;
    };
@@ -41,6 +41,20 @@
 
 namespace gnsstk
 {
+      // GMF hydrostatic continued fraction coefficients b and c
+   static const double GMF_BH = 0.0029;
+   static const double GMF_C0H = 0.062;
+      // GMF wet continued fraction coefficients b and c
+   static const double GMF_BW = 0.00146;
+   static const double GMF_CW = 0.04391;
+      // coefficients of the hydrostatic height correction
+   static const double GMF_A_HT = 2.53e-5;
+   static const double GMF_B_HT = 5.49e-3;
+   static const double GMF_C_HT = 1.14e-3;
+
+      // annual phase of the model for an MJD
+   static inline double gmfDayFactor(double mjd)
+   { return TWO_PI*(mjd - 44266.0)/365.25; }       // -44239 + 1 - 28
 
    // Constants for Global mapping functions
    const double GlobalTropModel::ADryMean[55] = {
@@ -290,7 +304,6 @@ namespace gnsstk
            longitude(0.0), dayfactor(0.0), undul(0.0)
    {
          // yes setting everything to 0 is the same as IEEE 0.0
-      memset(P, 0, sizeof(P));
       memset(aP, 0, sizeof(aP));
       memset(bP, 0, sizeof(bP));
       TropModel::humid = 50.0;
@@ -355,9 +368,7 @@ namespace gnsstk
 
    double GlobalTropModel::wet_zenith_delay() const
    {
-      double T = temp + CELSIUS_TO_KELVIN;
-      double pwv = 0.01 * humid * ::exp(-37.2465 + (0.213166-0.000256908*T)*T);
-      return (0.0122 + 0.00943 * pwv);
+      return wetZenith(temp, humid);
    }
 
 
@@ -366,50 +377,9 @@ namespace gnsstk
       try { testValidity(); } catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
       if(elevation < 3.0) { return 0.0; }
 
-      double clat = ::cos(latitude*DEG_TO_RAD);
-      double phh, c11h, c10h;
-
-      static const double bh = 0.0029;
-      static const double c0h = 0.062;
-      if(latitude < 0) {
-         phh = PI;
-         c11h = 0.007;
-         c10h = 0.002;
-      }
-      else {
-         phh = 0.0;
-         c11h = 0.005;
-         c10h = 0.001;
-      }
-      double ch = c0h + ((::cos(dayfactor + phh)+1.0)*c11h/2.0 + c10h)*(1.0-clat);
-
-      double am(0.0), aa(0.0);
-      for(int i=0; i<55; i++) {
-         am += (ADryMean[i]*aP[i] + BDryMean[i]*bP[i]) * 1.0e-5;
-         aa += (ADryAmp[i]*aP[i] + BDryAmp[i]*bP[i]) * 1.0e-5;
-      }
-      double ah = am + aa*::cos(dayfactor);
-
-      double sine = ::sin(elevation*DEG_TO_RAD);
-      //std::cout << "sine " << std::fixed << std::setprecision(16) << sine
-      // << std::endl;
-      //std::cout << "ah bh ch " << std::fixed << std::setprecision(16)
-      // << ah << " " << bh << " " << ch << std::endl;
-      double map = (1.0 + ah/(1.0 + bh/(1.0 + ch)))
-                 / (sine + ah/(sine + bh/(sine + ch)));
-      //std::cout << "map0 " << std::fixed << std::setprecision(16) << map
-      // << std::endl;
-
-      // height correction
-      static const double a_ht = 2.53e-5;
-      static const double b_ht = 5.49e-3;
-      static const double c_ht = 1.14e-3;
-
-      map += ( (1.0/sine) - (1.0  + a_ht/(1.0  + b_ht/(1.0  + c_ht)))
-                          / (sine + a_ht/(sine + b_ht/(sine + c_ht)))
-             ) * (height/1000.0);
-
-      return map;
+      double ah, ch, aw;
+      gmfCoeff(site, latitude, dayfactor, ah, ch, aw);
+      return gmfDry(::sin(elevation*DEG_TO_RAD), ah, ch, height);
 
    }  // end GlobalTropModel::dry_mapping_function()
 
@@ -454,38 +424,9 @@ namespace gnsstk
 
       if(elevation < 3.0) { return 0.0; }
 
-      static const double bw = 0.00146;
-      static const double cw = 0.04391;
-
-      double am(0.0), aa(0.0);
-      for(int i=0; i<55; i++) {
-         am += (AWetMean[i]*aP[i] + BWetMean[i]*bP[i]) * 1.0e-5;
-         aa += (AWetAmp[i]*aP[i] + BWetAmp[i]*bP[i]) * 1.0e-5;
-      }
-      double aw = am + aa*::cos(dayfactor);
-
-      double sine = ::sin(elevation*DEG_TO_RAD);
-      //std::cout << "sine " << std::fixed << std::setprecision(16) << sine
-      // << std::endl;
-      //std::cout << "aw bw cw " << std::fixed << std::setprecision(16)
-      // << aw << " " << bw << " " << cw << std::endl;
-      double f1(1.0 + aw/(1.0 + bw/(1.0 + cw)));
-      double f(sine + aw/(sine + bw/(sine + cw)));
-      double map = f1/f;
-
-      /** @note might be easier numerically... map' = map(elev+eps)-map(elev-eps)/2eps
-       *if(doDeriv) {
-       *   double apb(aw+bw);
-       *   double cw2(cw*cw);
-       *   double tmp(sine*(sine + 2*cw) + 2*bw+cw2);
-       *   double fpN(sine*(sine*(tmp-aw) + apb*(1.+3*cw)) + bw*apb-aw*cw2);
-       *   double fpD(sine*(sine*tmp + 2*bw));
-       *   double sinep(::cos(elevation*DEG_TO_RAD));
-       *   deriv = - map * (sinep*fpN/fpD) / f;
-       *}
-      */
-
-      return map;
+      double ah, ch, aw;
+      gmfCoeff(site, latitude, dayfactor, ah, ch, aw);
+      return gmfWet(::sin(elevation*DEG_TO_RAD), aw);
 
    }  // end GlobalTropModel::wet_mapping_function()
 
@@ -495,40 +436,8 @@ namespace gnsstk
       try { testValidity(); }
       catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
 
-      int i;
-
-      // undulation and orthometric height
-      U = 0.0;
-      for(i=0; i<55; i++) U += (Ageoid[i]*aP[i] + Bgeoid[i]*bP[i]);
-      double orthoht(height - U);
-      if(orthoht > HEIGHT_LIMIT)
-      {
-         InvalidTropModel exc("Invalid Global trop model: Rx Height exceeds limit");
-         GNSSTK_THROW(exc);
-      }
-
-      // press at geoid
-      double am(0.0),aa(0.0),v0;
-      for(i=0; i<55; i++) {
-         am += (APressMean[i]*aP[i] + BPressMean[i]*bP[i]);
-         aa += (APressAmp[i]*aP[i] + BPressAmp[i]*bP[i]);
-      }
-      v0 = am + aa * ::cos(dayfactor);
-
-      // pressure at height
-      // @note this implies any orthoht > 1/2.26e-5 == 44247.78m is invalid!
-      P = v0 * ::pow(1.0-2.26e-5*orthoht,5.225);
-
-      // temper on geoid
-      am = aa = 0.0;
-      for(i=0; i<55; i++) {
-         am += (ATempMean[i]*aP[i] + BTempMean[i]*bP[i]);
-         aa += (ATempAmp[i]*aP[i] + BTempAmp[i]*bP[i]);
-      }
-      v0 = am + aa * ::cos(dayfactor);
-
-      // temp at height
-      T = v0 - 6.5e-3 * orthoht;
+      U = site.undul;
+      gpt(site, height, dayfactor, P, T);
    }
 
 
@@ -537,8 +446,7 @@ namespace gnsstk
       if(height != ht) {
          height = ht;
          validHeight = true;
-         validCoeff = false;
-         setValid();          // calls updateGTMCoeff()
+         setValid();          // calls getGPT()
       }
    }
 
@@ -567,12 +475,11 @@ namespace gnsstk
 
    void GlobalTropModel::setTime(const double& mjd)
    {
-      double df(TWO_PI*(mjd - 44266.0)/365.25);       // -44239 + 1 - 28
+      double df(gmfDayFactor(mjd));
       if(df != dayfactor) {
          dayfactor = df;
          validDay = true;
-         validCoeff = false;
-         setValid();
+         setValid();          // calls getGPT()
       }
    }
 
@@ -593,13 +500,19 @@ namespace gnsstk
 
    void GlobalTropModel::setParameters(const CommonTime& time, const Position& rxPos)
    {
-      validDay = validHeight = validLat = validLon = validCoeff = false;
-      setTime(time);
-      setReceiverHeight(rxPos.getHeight());
-      setReceiverLatitude(rxPos.getGeodeticLatitude());
-      setReceiverLongitude(rxPos.getLongitude());
+         // Set the members directly, as the set...() methods do
+         // nothing when a value is unchanged.
+      double lat(rxPos.getGeodeticLatitude()), lon(rxPos.getLongitude());
+      if(!validLat || !validLon || lat != latitude || lon != longitude) {
+         validCoeff = false;
+      }
+      dayfactor = gmfDayFactor(static_cast<MJD>(time).mjd);
+      height = rxPos.getHeight();
+      latitude = lat;
+      longitude = lon;
+      validDay = validHeight = validLat = validLon = true;
 
-      setValid();          // calls updateGTMCoeff()
+      setValid();          // calls updateGTMCoeff() and getGPT()
    }
 
 
@@ -607,9 +520,77 @@ namespace gnsstk
    {
       if(!validLon || !validLat) return;
 
+      sphericalHarmonics(latitude, longitude, aP, bP);
+      siteSums(aP, bP, site);
+   }
+
+
+   void GlobalTropModel::getComponents(const std::vector<Position>& RX,
+                                       const std::vector<double>& elevation,
+                                       const std::vector<CommonTime>& tt,
+                                       std::vector<Components>& comps)
+   {
+      size_t n = elevation.size();
+      checkBatchSizes(RX.size(), tt.size(), n);
+      comps.resize(n);
+
+         // First the per station and per time values, which only
+         // change when the receiver or time does...
+      std::vector<double> ah(n), ch(n), aw(n), ht(n);
+      const Position *lastRX = nullptr;
+      const CommonTime *lastTT = nullptr;
+      const SiteCoeff *sc = nullptr;
+      double lat(0.0), h(0.0), df(0.0), dz(0.0), wz(0.0);
+      double a_h(0.0), c_h(0.0), a_w(0.0);
+      for(size_t i=0; i<n; i++) {
+         const Position& rx(RX[RX.size() == 1 ? 0 : i]);
+         const CommonTime& t(tt[tt.size() == 1 ? 0 : i]);
+         bool changed(false);
+         if(&rx != lastRX) {
+            lat = rx.getGeodeticLatitude();
+            h = rx.getAltitude();
+            sc = &getSiteCoeff(lat, rx.getLongitude());
+            lastRX = &rx;
+            changed = true;
+         }
+         if(&t != lastTT) {
+            double d(gmfDayFactor(static_cast<MJD>(t).mjd));
+            changed = changed || (d != df) || (i == 0);
+            df = d;
+            lastTT = &t;
+         }
+         if(changed) {
+            double P, T;
+            gpt(*sc, h, df, P, T);
+            dz = SaasDryDelay(P, lat, h);
+            wz = wetZenith(T, humid);
+            gmfCoeff(*sc, lat, df, a_h, c_h, a_w);
+         }
+         comps[i].dryZenith = dz;
+         comps[i].wetZenith = wz;
+         ah[i] = a_h;
+         ch[i] = c_h;
+         aw[i] = a_w;
+         ht[i] = h;
+      }
+
+         // ...then the mapping functions over the whole batch
+      for(size_t i=0; i<n; i++) {
+         double sine(::sin(elevation[i]*DEG_TO_RAD));
+         bool ok(elevation[i] >= 3.0);
+         comps[i].dryMap = ok ? gmfDry(sine, ah[i], ch[i], ht[i]) : 0.0;
+         comps[i].wetMap = ok ? gmfWet(sine, aw[i]) : 0.0;
+      }
+   }  // end GlobalTropModel::getComponents()
+
+
+   void GlobalTropModel::sphericalHarmonics(double lat, double lon,
+                                            double a[55], double b[55])
+   {
       // compute Legendre functions and spherical harmonics
       int i,j,k;
-      double sinlat(::sin(latitude*DEG_TO_RAD));
+      double P[10][10];
+      double sinlat(::sin(lat*DEG_TO_RAD));
       for(i=0; i<=9; i++) {
          for(j=0; j<=i; j++) {
             int ir((i-j)/2);
@@ -626,16 +607,129 @@ namespace gnsstk
       }
 
       // spherical harmonics
-      double rlon(longitude*DEG_TO_RAD);
+      double rlon(lon*DEG_TO_RAD);
       i = 0;
       for(j=0; j<=9; j++) {
          for(k=0; k<=j; k++) {
-            aP[i] = P[j][k] * ::cos(k*rlon);
-            bP[i] = P[j][k] * ::sin(k*rlon);
+            a[i] = P[j][k] * ::cos(k*rlon);
+            b[i] = P[j][k] * ::sin(k*rlon);
             i++;
          }
       }
+   }
+
+
+   void GlobalTropModel::siteSums(const double a[55], const double b[55],
+                                  SiteCoeff& sc)
+   {
+      sc.dryMean = sc.dryAmp = sc.wetMean = sc.wetAmp = 0.0;
+      sc.pressMean = sc.pressAmp = sc.tempMean = sc.tempAmp = 0.0;
+      sc.undul = 0.0;
+      for(int i=0; i<55; i++) {
+         sc.dryMean += (ADryMean[i]*a[i] + BDryMean[i]*b[i]) * 1.0e-5;
+         sc.dryAmp += (ADryAmp[i]*a[i] + BDryAmp[i]*b[i]) * 1.0e-5;
+         sc.wetMean += (AWetMean[i]*a[i] + BWetMean[i]*b[i]) * 1.0e-5;
+         sc.wetAmp += (AWetAmp[i]*a[i] + BWetAmp[i]*b[i]) * 1.0e-5;
+         sc.undul += (Ageoid[i]*a[i] + Bgeoid[i]*b[i]);
+         sc.pressMean += (APressMean[i]*a[i] + BPressMean[i]*b[i]);
+         sc.pressAmp += (APressAmp[i]*a[i] + BPressAmp[i]*b[i]);
+         sc.tempMean += (ATempMean[i]*a[i] + BTempMean[i]*b[i]);
+         sc.tempAmp += (ATempAmp[i]*a[i] + BTempAmp[i]*b[i]);
+      }
+   }
+
+
+   const GlobalTropModel::SiteCoeff& GlobalTropModel::getSiteCoeff(
+      double lat, double lon)
+   {
+      std::pair<double,double> key(lat, lon);
+      std::map<std::pair<double,double>, SiteCoeff>::const_iterator it =
+         siteCache.find(key);
+      if(it != siteCache.end()) {
+         return it->second;
+      }
+      if(siteCache.size() >= SITE_CACHE_SIZE) {
+         siteCache.clear();
+      }
+      double a[55], b[55];
+      sphericalHarmonics(lat, lon, a, b);
+      SiteCoeff& sc(siteCache[key]);
+      siteSums(a, b, sc);
+      return sc;
+   }
+
+
+   void GlobalTropModel::gpt(const SiteCoeff& sc, double ht, double df,
+                             double& P, double& T)
+   {
+      // orthometric height
+      double orthoht(ht - sc.undul);
+      if(orthoht > HEIGHT_LIMIT)
+      {
+         InvalidTropModel exc("Invalid Global trop model: Rx Height exceeds limit");
+         GNSSTK_THROW(exc);
+      }
+
+      // press at geoid
+      double v0 = sc.pressMean + sc.pressAmp * ::cos(df);
+
+      // pressure at height
+      // @note this implies any orthoht > 1/2.26e-5 == 44247.78m is invalid!
+      P = v0 * ::pow(1.0-2.26e-5*orthoht,5.225);
+
+      // temper on geoid
+      v0 = sc.tempMean + sc.tempAmp * ::cos(df);
+
+      // temp at height
+      T = v0 - 6.5e-3 * orthoht;
+   }
+
+
+   void GlobalTropModel::gmfCoeff(const SiteCoeff& sc, double lat, double df,
+                                  double& ah, double& ch, double& aw)
+   {
+      double clat = ::cos(lat*DEG_TO_RAD);
+      double phh, c11h, c10h;
+      if(lat < 0) {
+         phh = PI;
+         c11h = 0.007;
+         c10h = 0.002;
+      }
+      else {
+         phh = 0.0;
+         c11h = 0.005;
+         c10h = 0.001;
+      }
+      ch = GMF_C0H + ((::cos(df + phh)+1.0)*c11h/2.0 + c10h)*(1.0-clat);
+      double cdf(::cos(df));
+      ah = sc.dryMean + sc.dryAmp*cdf;
+      aw = sc.wetMean + sc.wetAmp*cdf;
+   }
 
+
+   double GlobalTropModel::gmfDry(double sine, double ah, double ch, double ht)
+   {
+      double map = mariniMapping(sine, ah, GMF_BH, ch);
+
+      // height correction
+      map += ( (1.0/sine) - mariniMapping(sine, GMF_A_HT, GMF_B_HT, GMF_C_HT)
+             ) * (ht/1000.0);
+
+      return map;
+   }
+
+
+   double GlobalTropModel::gmfWet(double sine, double aw)
+   {
+      return mariniMapping(sine, aw, GMF_BW, GMF_CW);
+   }
+
+
+   double GlobalTropModel::wetZenith(double T, double rh)
+   {
+      T += CELSIUS_TO_KELVIN;
+      double pwv = 0.01 * rh * ::exp(-37.2465 + (0.213166-0.000256908*T)*T);
+      return (0.0122 + 0.00943 * pwv);
    }
 
 
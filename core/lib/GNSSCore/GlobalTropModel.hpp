@@ -45,6 +45,9 @@
 #ifndef GLOBAL_TROP_MODEL_HPP
 #define GLOBAL_TROP_MODEL_HPP
 
+#include <map>
+#include <utility>
+
 #include "CommonTime.hpp"
 #include "TropModel.hpp"
 
@@ -188,6 +191,21 @@ namespace gnsstk
          return correction(RX,SV);
       }
 
+         /** @copydoc TropModel::getComponents()
+          *
+          * The spherical harmonic expansions of GPT and GMF depend
+          * only on the receiver latitude and longitude, so their sums
+          * are cached per station (across calls), leaving only the
+          * annual term, the height reduction and the continued
+          * fractions to be computed per observation.  The current
+          * humidity is used for the wet zenith delay.
+          * @throw InvalidTropModel if a receiver height exceeds the
+          *   model limit. */
+      virtual void getComponents(const std::vector<Position>& RX,
+                                 const std::vector<double>& elevation,
+                                 const std::vector<CommonTime>& tt,
+                                 std::vector<Components>& comps);
+
          /** Compute and return the zenith delay for hydrostatic (dry)
           * component of the troposphere. Use the Saastamoinen value.
           * Ref. Davis etal 1985 and Leick, 3rd ed, pg 197.
@@ -308,13 +326,88 @@ namespace gnsstk
       GNSSTK_EXPORT
       static const double HEIGHT_LIMIT;
 
+         /// Sums of the spherical harmonic expansions at one location.
+      struct SiteCoeff
+      {
+         double dryMean, dryAmp;       ///< GMF hydrostatic coefficient a
+         double wetMean, wetAmp;       ///< GMF wet coefficient a
+         double pressMean, pressAmp;   ///< GPT pressure at the geoid
+         double tempMean, tempAmp;     ///< GPT temperature at the geoid
+         double undul;                 ///< geoid undulation
+      };
+
+         /// Maximum number of stations kept in siteCache.
+      static const size_t SITE_CACHE_SIZE = 10000;
+
       double height, latitude, longitude, dayfactor, undul;
-      double P[10][10], aP[55], bP[55];
+      double aP[55], bP[55];
       bool validHeight, validLat, validLon, validDay, validCoeff;
 
+         /// Sums for the current latitude and longitude.
+      SiteCoeff site;
+
+         /// Sums for stations seen by getComponents(), keyed by (lat,lon).
+      std::map<std::pair<double,double>, SiteCoeff> siteCache;
+
       /// Update coefficients when latitude and/or longitude changes
       void updateGTMCoeff();
 
+         /** Compute the spherical harmonics of degree and order 9.
+          * @param lat Latitude in degrees.
+          * @param lon Longitude in degrees.
+          * @param[out] a Cosine terms.
+          * @param[out] b Sine terms. */
+      static void sphericalHarmonics(double lat, double lon,
+                                     double a[55], double b[55]);
+
+         /** Sum the model expansions for the given spherical harmonics.
+          * @param[in] a Cosine terms.
+          * @param[in] b Sine terms.
+          * @param[out] sc The sums. */
+      static void siteSums(const double a[55], const double b[55],
+                           SiteCoeff& sc);
+
+         /** Return the sums for a station, computing and caching them
+          * if this station has not been seen before. */
+      const SiteCoeff& getSiteCoeff(double lat, double lon);
+
+         /** Compute GPT pressure and temperature at height.
+          * @param[in] sc Sums for the receiver location.
+          * @param[in] ht Ellipsoidal height in meters.
+          * @param[in] df Day factor (annual phase in radians).
+          * @param[out] P Pressure in millibars.
+          * @param[out] T Temperature in degrees Celsius.
+          * @throw InvalidTropModel if the height exceeds HEIGHT_LIMIT. */
+      static void gpt(const SiteCoeff& sc, double ht, double df,
+                      double& P, double& T);
+
+         /** Compute the GMF continued fraction coefficients that vary
+          * with location and time.
+          * @param[in] sc Sums for the receiver location.
+          * @param[in] lat Latitude in degrees.
+          * @param[in] df Day factor (annual phase in radians).
+          * @param[out] ah Hydrostatic coefficient a.
+          * @param[out] ch Hydrostatic coefficient c.
+          * @param[out] aw Wet coefficient a. */
+      static void gmfCoeff(const SiteCoeff& sc, double lat, double df,
+                           double& ah, double& ch, double& aw);
+
+         /** Evaluate the GMF hydrostatic mapping function.
+          * @param sine Sine of the elevation.
+          * @param ah,ch Coefficients from gmfCoeff().
+          * @param ht Ellipsoidal height in meters. */
+      static double gmfDry(double sine, double ah, double ch, double ht);
+
+         /** Evaluate the GMF wet mapping function.
+          * @param sine Sine of the elevation.
+          * @param aw Coefficient from gmfCoeff(). */
+      static double gmfWet(double sine, double aw);
+
+         /** Compute the wet zenith delay.
+          * @param T Temperature in degrees Celsius.
+          * @param rh Relative humidity in percent. */
+      static double wetZenith(double T, double rh);
+
          /** Utility to test valid flags
           * @throw InvalidTropModel
           */
@@ -328,9 +421,11 @@ namespace gnsstk
       {
          try{
             valid = validHeight && validLat && validLon && validDay;
-            if(valid && !validCoeff) {
-               updateGTMCoeff();
-               validCoeff = true;
+            if(valid) {
+               if(!validCoeff) {
+                  updateGTMCoeff();
+                  validCoeff = true;
+               }
                getGPT(press,temp,undul);
             }
          } catch(Exception& e) { GNSSTK_RETHROW(e); }
@@ -37,6 +37,7 @@
 //==============================================================================
 
 
+#include <algorithm>
 #include "YDSTime.hpp"
 #include "NeillTropModel.hpp"
 
@@ -94,6 +95,77 @@ namespace gnsstk
      0.00084795348, 0.0017037206 };
 
 
+      /* Compute the hydrostatic mapping function coefficients for
+       * a latitude (degrees) and day of year. */
+   static void neillDryCoeff(double latitude, int doy,
+                             double& a, double& b, double& c)
+   {
+      double lat, t, ct;
+      lat = fabs(latitude);         // degrees
+      t = static_cast<double>(doy) - 28.0;  // mid-winter
+
+      if(latitude < 0.0)              // southern hemisphere
+      {
+         t += 365.25/2.;
+      }
+
+      t *= 360.0/365.25;            // convert to degrees
+      ct = ::cos(t*DEG_TO_RAD);
+
+      if(lat < 15.0)
+      {
+         a = NeillDryA[0];
+         b = NeillDryB[0];
+         c = NeillDryC[0];
+      }
+      else if(lat < 75.)      // coefficients are for 15,30,45,60,75 deg
+      {
+         int i=int(lat/15.0)-1;
+         double frac=(lat-15.*(i+1))/15.;
+         a = NeillDryA[i] + frac*(NeillDryA[i+1]-NeillDryA[i]);
+         b = NeillDryB[i] + frac*(NeillDryB[i+1]-NeillDryB[i]);
+         c = NeillDryC[i] + frac*(NeillDryC[i+1]-NeillDryC[i]);
+
+         a -= ct * (NeillDryA1[i] + frac*(NeillDryA1[i+1]-NeillDryA1[i]));
+         b -= ct * (NeillDryB1[i] + frac*(NeillDryB1[i+1]-NeillDryB1[i]));
+         c -= ct * (NeillDryC1[i] + frac*(NeillDryC1[i+1]-NeillDryC1[i]));
+      }
+      else
+      {
+         a = NeillDryA[4] - ct * NeillDryA1[4];
+         b = NeillDryB[4] - ct * NeillDryB1[4];
+         c = NeillDryC[4] - ct * NeillDryC1[4];
+      }
+   }
+
+
+      // Compute the wet mapping function coefficients for a latitude.
+   static void neillWetCoeff(double latitude, double& a, double& b, double& c)
+   {
+      double lat = fabs(latitude);         // degrees
+      if(lat < 15.0)
+      {
+         a = NeillWetA[0];
+         b = NeillWetB[0];
+         c = NeillWetC[0];
+      }
+      else if(lat < 75.)          // coefficients are for 15,30,45,60,75 deg
+      {
+         int i=int(lat/15.0)-1;
+         double frac=(lat-15.*(i+1))/15.;
+         a = NeillWetA[i] + frac*(NeillWetA[i+1]-NeillWetA[i]);
+         b = NeillWetB[i] + frac*(NeillWetB[i+1]-NeillWetB[i]);
+         c = NeillWetC[i] + frac*(NeillWetC[i+1]-NeillWetC[i]);
+      }
+      else
+      {
+         a = NeillWetA[4];
+         b = NeillWetB[4];
+         c = NeillWetC[4];
+      }
+   }
+
+
    double NeillTropModel::correction(double elevation) const
    {
       THROW_IF_INVALID_DETAILED();
@@ -205,7 +277,7 @@ namespace gnsstk
       THROW_IF_INVALID();
 
          // Note: 1.013*2.27 = 2.29951
-      double ddry( 2.29951*std::exp( (-0.000116 * NeillHeight) ) );
+      double ddry( dryZenith(NeillHeight) );
 
          /* where does above come from? Not Neill 1996
           * probably ought to use SaasDryDelay
@@ -225,95 +297,99 @@ namespace gnsstk
          return 0.0;
       }
 
-      double lat, t, ct;
-      lat = fabs(NeillLat);         // degrees
-      t = static_cast<double>(NeillDOY) - 28.0;  // mid-winter
+      double a, b, c;
+      neillDryCoeff(NeillLat, NeillDOY, a, b, c);
+      return dryMapping(::sin(elevation*DEG_TO_RAD), a, b, c, NeillHeight);
+   }
 
-      if(NeillLat < 0.0)              // southern hemisphere
-      {
-         t += 365.25/2.;
-      }
 
-      t *= 360.0/365.25;            // convert to degrees
-      ct = ::cos(t*DEG_TO_RAD);
+   double NeillTropModel::wet_mapping_function(double elevation) const
+   {
+      THROW_IF_INVALID_DETAILED();
 
-      double a, b, c;
-      if(lat < 15.0)
+      if(elevation < 3.0)
       {
-         a = NeillDryA[0];
-         b = NeillDryB[0];
-         c = NeillDryC[0];
+         return 0.0;
       }
-      else if(lat < 75.)      // coefficients are for 15,30,45,60,75 deg
-      {
-         int i=int(lat/15.0)-1;
-         double frac=(lat-15.*(i+1))/15.;
-         a = NeillDryA[i] + frac*(NeillDryA[i+1]-NeillDryA[i]);
-         b = NeillDryB[i] + frac*(NeillDryB[i+1]-NeillDryB[i]);
-         c = NeillDryC[i] + frac*(NeillDryC[i+1]-NeillDryC[i]);
 
-         a -= ct * (NeillDryA1[i] + frac*(NeillDryA1[i+1]-NeillDryA1[i]));
-         b -= ct * (NeillDryB1[i] + frac*(NeillDryB1[i+1]-NeillDryB1[i]));
-         c -= ct * (NeillDryC1[i] + frac*(NeillDryC1[i+1]-NeillDryC1[i]));
-      }
-      else
-      {
-         a = NeillDryA[4] - ct * NeillDryA1[4];
-         b = NeillDryB[4] - ct * NeillDryB1[4];
-         c = NeillDryC[4] - ct * NeillDryC1[4];
-      }
+      double a, b, c;
+      neillWetCoeff(NeillLat, a, b, c);
+      return mariniMapping(::sin(elevation*DEG_TO_RAD), a, b, c);
 
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
+   }  // end NeillTropModel::wet_mapping_function()
+
+
+   double NeillTropModel::dryMapping(double se, double a, double b, double c,
+                                     double ht)
+   {
+      double map = mariniMapping(se, a, b, c);
 
-      a = 0.0000253;
-      b = 0.00549;
-      c = 0.00114;
-      map += ( NeillHeight/1000.0 ) *
-         ( 1./se - ( (1.+a/(1.+b/(1.+c))) / (se+a/(se+b/(se+c))) ) );
+         // height correction
+      map += ( ht/1000.0 ) *
+         ( 1./se - mariniMapping(se, 0.0000253, 0.00549, 0.00114) );
 
       return map;
    }
 
 
-   double NeillTropModel::wet_mapping_function(double elevation) const
+   void NeillTropModel::getComponents(const std::vector<Position>& RX,
+                                      const std::vector<double>& elevation,
+                                      const std::vector<CommonTime>& tt,
+                                      std::vector<Components>& comps)
    {
-      THROW_IF_INVALID_DETAILED();
-
-      if(elevation < 3.0)
+      size_t n = elevation.size();
+      checkBatchSizes(RX.size(), tt.size(), n);
+      comps.resize(n);
+
+         // First the per station and per day coefficients, which only
+         // change when the receiver or day does...
+      std::vector<double> coeff(7*n);
+      const Position *lastRX = nullptr;
+      const CommonTime *lastTT = nullptr;
+      double lat(0.0), ht(0.0), dz(0.0);
+      double cf[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+      int doy(0);
+      for(size_t i=0; i<n; i++)
       {
-         return 0.0;
+         const Position& rx(RX[RX.size() == 1 ? 0 : i]);
+         const CommonTime& t(tt[tt.size() == 1 ? 0 : i]);
+         bool changed(false);
+         if(&rx != lastRX)
+         {
+            lat = rx.getGeodeticLatitude();
+            ht = rx.getHeight();
+            dz = dryZenith(ht);
+            neillWetCoeff(lat, cf[3], cf[4], cf[5]);
+            lastRX = &rx;
+            changed = true;
+         }
+         if(&t != lastTT)
+         {
+            int d = static_cast<int>((static_cast<YDSTime>(t)).doy);
+            changed = changed || (d != doy);
+            doy = d;
+            lastTT = &t;
+         }
+         if(changed)
+         {
+            neillDryCoeff(lat, doy, cf[0], cf[1], cf[2]);
+         }
+         comps[i].dryZenith = dz;
+         comps[i].wetZenith = wet_zenith_delay();
+         std::copy(cf, cf+6, &coeff[7*i]);
+         coeff[7*i+6] = ht;
       }
 
-      double a,b,c,lat;
-      lat = fabs(NeillLat);         // degrees
-      if(lat < 15.0)
-      {
-         a = NeillWetA[0];
-         b = NeillWetB[0];
-         c = NeillWetC[0];
-      }
-      else if(lat < 75.)          // coefficients are for 15,30,45,60,75 deg
+         // ...then the mapping functions over the whole batch
+      for(size_t i=0; i<n; i++)
       {
-         int i=int(lat/15.0)-1;
-         double frac=(lat-15.*(i+1))/15.;
-         a = NeillWetA[i] + frac*(NeillWetA[i+1]-NeillWetA[i]);
-         b = NeillWetB[i] + frac*(NeillWetB[i+1]-NeillWetB[i]);
-         c = NeillWetC[i] + frac*(NeillWetC[i+1]-NeillWetC[i]);
-      }
-      else
-      {
-         a = NeillWetA[4];
-         b = NeillWetB[4];
-         c = NeillWetC[4];
+         const double *c = &coeff[7*i];
+         double se = ::sin(elevation[i]*DEG_TO_RAD);
+         bool ok(elevation[i] >= 3.0);
+         comps[i].dryMap = ok ? dryMapping(se, c[0], c[1], c[2], c[6]) : 0.0;
+         comps[i].wetMap = ok ? mariniMapping(se, c[3], c[4], c[5]) : 0.0;
       }
-
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = ( 1.+ a/ (1.+ b/(1.+c) ) ) / (se + a/(se + b/(se+c) ) );
-
-      return map;
-
-   }  // end NeillTropModel::wet_mapping_function()
+   }  // end NeillTropModel::getComponents()
 
 
    void NeillTropModel::setWeather()
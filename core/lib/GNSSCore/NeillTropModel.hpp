@@ -40,6 +40,7 @@
 #ifndef NEILL_TROP_MODEL_HPP
 #define NEILL_TROP_MODEL_HPP
 
+#include <cmath>
 #include "TropModel.hpp"
 
 namespace gnsstk
@@ -243,6 +244,16 @@ namespace gnsstk
       virtual double wet_mapping_function(double elevation) const;
 
 
+         /** @copydoc TropModel::getComponents()
+          *
+          * The mapping function coefficients are interpolated in
+          * latitude once per station and day, and the continued
+          * fractions are then evaluated over the whole batch. */
+      virtual void getComponents(const std::vector<Position>& RX,
+                                 const std::vector<double>& elevation,
+                                 const std::vector<CommonTime>& tt,
+                                 std::vector<Components>& comps);
+
          /** This method configure the model to estimate the weather using
           * height, latitude and day of year (DOY). It is called
           * automatically when setting those parameters.
@@ -299,6 +310,19 @@ namespace gnsstk
 
 
    private:
+         /** Evaluate the dry zenith delay.
+          * @param ht Receiver height in meters. */
+      static double dryZenith(double ht)
+      { return 2.29951*std::exp( (-0.000116 * ht) ); }
+
+         /** Evaluate the hydrostatic mapping function including the
+          * height correction.
+          * @param se Sine of the elevation.
+          * @param a,b,c Continued fraction coefficients.
+          * @param ht Receiver height in meters. */
+      static double dryMapping(double se, double a, double b, double c,
+                               double ht);
+
       double NeillHeight;
       double NeillLat;
       int NeillDOY;
@@ -82,6 +82,82 @@ namespace gnsstk
    }  // end TropModel::correction(RX,SV,TT)
 
 
+   void TropModel::getComponents(const std::vector<Position>& RX,
+                                 const std::vector<double>& elevation,
+                                 const std::vector<CommonTime>& tt,
+                                 std::vector<Components>& comps)
+   {
+      size_t n = elevation.size();
+      checkBatchSizes(RX.size(), tt.size(), n);
+      comps.resize(n);
+
+      const Position *lastRX = nullptr;
+      const CommonTime *lastTT = nullptr;
+      int lastDOY = -1;
+      double dz = 0.0, wz = 0.0;
+      for (size_t i = 0; i < n; i++)
+      {
+         const Position& rx(RX[RX.size() == 1 ? 0 : i]);
+         const CommonTime& t(tt[tt.size() == 1 ? 0 : i]);
+         bool changed = false;
+         if (&rx != lastRX)
+         {
+            setReceiverHeight(rx.getHeight());
+            setReceiverLatitude(rx.getGeodeticLatitude());
+            setReceiverLongitude(rx.getLongitude());
+            lastRX = &rx;
+            changed = true;
+         }
+         if (&t != lastTT)
+         {
+            int doy = static_cast<YDSTime>(t).doy;
+            if (doy != lastDOY)
+            {
+               setDayOfYear(doy);
+               lastDOY = doy;
+               changed = true;
+            }
+            lastTT = &t;
+         }
+         if (changed)
+         {
+            dz = dry_zenith_delay();
+            wz = wet_zenith_delay();
+         }
+
+         Components& c(comps[i]);
+         c.dryZenith = dz;
+         c.wetZenith = wz;
+         if (elevation[i] < 0.0)
+         {
+            c.dryMap = c.wetMap = 0.0;
+         }
+         else
+         {
+            c.dryMap = dry_mapping_function(elevation[i]);
+            c.wetMap = wet_mapping_function(elevation[i]);
+         }
+      }
+   }  // end TropModel::getComponents()
+
+
+   void TropModel::checkBatchSizes(size_t nRX, size_t nTT, size_t n)
+   {
+      if ((nRX != 1) && (nRX != n))
+      {
+         InvalidParameter e("Number of receiver positions must be 1 or"
+                            " the number of elevations");
+         GNSSTK_THROW(e);
+      }
+      if ((nTT != 1) && (nTT != n))
+      {
+         InvalidParameter e("Number of time tags must be 1 or the number"
+                            " of elevations");
+         GNSSTK_THROW(e);
+      }
+   }
+
+
    void TropModel::setWeather(const double& T,
                               const double& P,
                               const double& H)
@@ -45,6 +45,8 @@
 #ifndef TROP_MODEL_HPP
 #define TROP_MODEL_HPP
 
+#include <vector>
+
 #include "Exception.hpp"
 #include "ObsEpochMap.hpp"
 #include "WxObsMap.hpp"
@@ -166,6 +168,57 @@ namespace gnsstk
                                 const CommonTime& tt)
       { Position R(RX),S(SV);  return TropModel::correction(R,S,tt); }
 
+         /// Zenith delays and mapping functions for one observation.
+      struct Components
+      {
+         double dryZenith;    ///< hydrostatic (dry) zenith delay, meters
+         double wetZenith;    ///< wet zenith delay, meters
+         double dryMap;       ///< hydrostatic (dry) mapping function
+         double wetMap;       ///< wet mapping function
+
+            /// Return the full tropospheric delay, in meters.
+         double delay() const
+         { return dryZenith*dryMap + wetZenith*wetMap; }
+      };
+
+         /** Compute the zenith delays and mapping functions for a
+          * batch of observations, e.g. many stations and satellites
+          * at once.
+          *
+          * Element i of \a comps holds what the zenith delay and
+          * mapping function methods return once the model has been
+          * set up for receiver \a RX[i] at time \a tt[i], so that
+          * comps[i].delay() is the tropospheric delay for
+          * elevation[i].  The mapping functions are zero for
+          * negative elevations and for elevations below the model's
+          * cut-off.  Observations should be grouped by receiver and
+          * time, as values are only recomputed when these change.
+          *
+          * The default implementation sets the receiver height,
+          * latitude, longitude and day of year using the set...()
+          * methods, and then calls the zenith delay and mapping
+          * function methods.  Models whose coefficients depend on
+          * position or time override this to cache per-station
+          * constants and to evaluate the mapping functions over the
+          * whole batch, without changing the model's own receiver
+          * and time settings.
+          *
+          * @param[in] RX Receiver positions, either one per elevation
+          *   or a single position used for all of them.
+          * @param[in] elevation Elevations of the satellites as seen at
+          *   the receivers, in degrees.
+          * @param[in] tt Time tags, either one per elevation or a
+          *   single time used for all of them.
+          * @param[out] comps Zenith delays and mapping functions for
+          *   each elevation.
+          * @throw InvalidParameter if \a RX or \a tt has the wrong size.
+          * @throw InvalidTropModel
+          */
+      virtual void getComponents(const std::vector<Position>& RX,
+                                 const std::vector<double>& elevation,
+                                 const std::vector<CommonTime>& tt,
+                                 std::vector<Components>& comps);
+
          /** Compute and return the zenith delay for hydrostatic (dry)
           * component of the troposphere, in meters.
           * @throw InvalidTropModel
@@ -276,6 +329,25 @@ namespace gnsstk
          const double& ht, double& T, double& P, double& H);
 
    protected:
+         /** Evaluate the continued fraction of Marini (1972), as
+          * normalized by Herring (1992), that is the basis of most
+          * mapping functions.
+          * @param sine Sine of the elevation angle.
+          * @param a,b,c Coefficients of the continued fraction.
+          * @return (1+a/(1+b/(1+c))) / (sine+a/(sine+b/(sine+c))) */
+      static double mariniMapping(double sine, double a, double b, double c)
+      {
+         return (1.0 + a/(1.0 + b/(1.0 + c)))
+            / (sine + a/(sine + b/(sine + c)));
+      }
+
+         /** Check the sizes of the getComponents() inputs.
+          * @param nRX Number of receiver positions.
+          * @param nTT Number of time tags.
+          * @param n Number of elevations.
+          * @throw InvalidParameter unless nRX and nTT are 1 or n. */
+      static void checkBatchSizes(size_t nRX, size_t nTT, size_t n);
+
       bool valid;           ///< true only if current model parameters are valid
       double temp;          ///< latest value of temperature (kelvin or celsius)
       double press;         ///< latest value of pressure (millibars)
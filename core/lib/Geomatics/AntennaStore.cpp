@@ -43,9 +43,11 @@
  * compute PCOs at any (elevation, azimuth). */
 
 #include "AntennaStore.hpp"
+#include <cmath>
 #include "Matrix.hpp"
 #include "Position.hpp"
 #include "SolarPosition.hpp"
+#include "StringUtils.hpp"
 #include "SunEarthSatGeometry.hpp"
 
 using namespace std;
@@ -64,6 +66,30 @@ namespace gnsstk
          GNSSTK_THROW(e);
       }
 
+         // recompile any grids of this name into temporaries first, so that
+         // the store is unchanged if one of them fails
+      vector<size_t> indexes;
+      vector<PCVGrid> grids;
+      for (size_t i = 0; i < pcvGrids.size(); i++)
+      {
+         if (pcvGrids[i].name == name)
+         {
+            PCVGrid grid;
+            grid.name = name;
+            grid.freq = pcvGrids[i].freq;
+            try
+            {
+               compileGrid(antdata, grid);
+            }
+            catch (Exception& e)
+            {
+               GNSSTK_RETHROW(e);
+            }
+            indexes.push_back(i);
+            grids.push_back(grid);
+         }
+      }
+
          // is the name already in the store?
       map<string, AntexData>::iterator it;
       it = antennaMap.find(name);
@@ -74,6 +100,12 @@ namespace gnsstk
 
          // add the new data
       antennaMap[name] = antdata;
+
+         // swap in the new grids, keeping their handles
+      for (size_t k = 0; k < indexes.size(); k++)
+      {
+         std::swap(pcvGrids[indexes[k]], grids[k]);
+      }
    }
 
       /* Get the antenna data for the given name from the store.
@@ -516,6 +548,287 @@ namespace gnsstk
       return tp;
    }
 
+   int AntennaStore::getPCVHandle(const string& name, const string& freq)
+   {
+      pair<string, string> key(name, freq);
+      map<pair<string, string>, int>::const_iterator kt = handleMap.find(key);
+      if (kt != handleMap.end())
+      {
+         return kt->second;
+      }
+
+      map<string, AntexData>::const_iterator it = antennaMap.find(name);
+      if (it == antennaMap.end())
+      {
+         InvalidRequest ir("Antenna " + name + " not found in store");
+         GNSSTK_THROW(ir);
+      }
+
+      PCVGrid grid;
+      grid.name = name;
+      grid.freq = freq;
+      try
+      {
+         compileGrid(it->second, grid);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+
+      int handle = pcvGrids.size();
+      pcvGrids.push_back(grid);
+      handleMap[key] = handle;
+      return handle;
+   }
+
+      /* Compile the PCVs of the given antenna and frequency into grid. The
+         NOAZI entry (azimuth -1) is used only if there is no azimuth
+         dependence; a single azimuth or zenith node is duplicated so that
+         every grid has at least one cell.
+      */
+   void AntennaStore::compileGrid(const AntexData& ant, PCVGrid& grid)
+   {
+      map<string, AntexData::antennaPCOandPCVData>::const_iterator it;
+      it = ant.freqPCVmap.find(grid.freq);
+      if (it == ant.freqPCVmap.end())
+      {
+         InvalidRequest ir("Frequency " + grid.freq + " not found for antenna "
+                           + grid.name);
+         GNSSTK_THROW(ir);
+      }
+      const AntexData::antennaPCOandPCVData& antpco = it->second;
+      const AntexData::azimZenMap& azzenmap = antpco.PCVvalue;
+
+      grid.isRx = ant.isRxAntenna;
+      for (int i = 0; i < 3; i++)
+         grid.PCO[i] = antpco.PCOvalue[i];
+
+         // collect the azimuth rows
+      vector<double> azims;
+      vector<const AntexData::zenOffsetMap*> rows;
+      AntexData::azimZenMap::const_iterator jt;
+      if (!antpco.hasAzimuth)
+      {
+         if (!azzenmap.empty())
+         {
+            rows.push_back(&azzenmap.begin()->second);
+            azims.push_back(0.0);
+         }
+      }
+      else
+      {
+         for (jt = azzenmap.begin(); jt != azzenmap.end(); ++jt)
+         {
+            if (jt->first < 0.0)
+               continue; // NOAZI
+            azims.push_back(jt->first);
+            rows.push_back(&jt->second);
+         }
+      }
+      if (rows.empty() || rows[0]->empty())
+      {
+         InvalidRequest ir("No PCVs for antenna " + grid.name + " frequency "
+                           + grid.freq);
+         GNSSTK_THROW(ir);
+      }
+
+         // the azimuths must be regular from 0, and close the circle
+      static const double tol(1.e-6);
+      if (rows.size() == 1)
+      {
+         grid.daz = 360.0;
+         rows.push_back(rows[0]);
+      }
+      else
+      {
+         grid.daz = azims[1] - azims[0];
+         bool ok(::fabs(azims[0]) < tol && grid.daz > 0.0);
+         for (size_t i = 2; ok && i < azims.size(); i++)
+            ok = ::fabs(azims[i] - i * grid.daz) < tol;
+         double last = azims.size() * grid.daz;
+         if (ok && ::fabs(azims.back() - 360.0) > tol)
+         {  // wrap around to azimuth 0
+            ok = ::fabs(last - 360.0) < tol;
+            rows.push_back(rows[0]);
+         }
+         if (!ok)
+         {
+            InvalidRequest ir("Azimuths are not regular for antenna "
+                              + grid.name + " frequency " + grid.freq);
+            GNSSTK_THROW(ir);
+         }
+      }
+      grid.naz = rows.size();
+
+         // the zenith angles must be regular and the same in every row
+      const AntexData::zenOffsetMap& first(*rows[0]);
+      vector<double> zens;
+      AntexData::zenOffsetMap::const_iterator kt;
+      for (kt = first.begin(); kt != first.end(); ++kt)
+         zens.push_back(kt->first);
+      grid.zen0 = zens[0];
+      grid.dzen = (zens.size() > 1 ? zens[1] - zens[0] : 1.0);
+      bool ok(grid.dzen > 0.0);
+      for (size_t i = 2; ok && i < zens.size(); i++)
+         ok = ::fabs(zens[i] - grid.zen0 - i * grid.dzen) < tol;
+      for (size_t i = 1; ok && i < rows.size(); i++)
+         ok = (rows[i]->size() == zens.size() &&
+               ::fabs(rows[i]->begin()->first - grid.zen0) < tol);
+      if (!ok)
+      {
+         InvalidRequest ir("Zenith angles are not regular for antenna "
+                           + grid.name + " frequency " + grid.freq);
+         GNSSTK_THROW(ir);
+      }
+      grid.nzen = (zens.size() > 1 ? zens.size() : 2);
+
+         // node values, azimuth major
+      vector<double> val(grid.naz * grid.nzen);
+      for (int i = 0; i < grid.naz; i++)
+      {
+         int j(0);
+         for (kt = rows[i]->begin(); kt != rows[i]->end(); ++kt, ++j)
+            val[i * grid.nzen + j] = kt->second;
+         if (j == 1)
+            val[i * grid.nzen + 1] = val[i * grid.nzen];
+      }
+
+         // bilinear coefficients of each cell
+      grid.coef.resize(4 * (grid.naz - 1) * (grid.nzen - 1));
+      for (int i = 0; i < grid.naz - 1; i++)
+      {
+         for (int j = 0; j < grid.nzen - 1; j++)
+         {
+            const double v00 = val[i * grid.nzen + j];
+            const double v01 = val[i * grid.nzen + j + 1];
+            const double v10 = val[(i + 1) * grid.nzen + j];
+            const double v11 = val[(i + 1) * grid.nzen + j + 1];
+            double *c = &grid.coef[4 * (i * (grid.nzen - 1) + j)];
+            c[0] = v00;
+            c[1] = v10 - v00;
+            c[2] = v01 - v00;
+            c[3] = v11 - v10 - v01 + v00;
+         }
+      }
+   }
+
+      /* Interpolate the grid; zenith angles beyond the ends of the grid take
+         the value at the end, as in AntexData. */
+   double AntennaStore::evaluateGrid(const PCVGrid& grid, double azim,
+                                     double zen)
+   {
+      azim = std::fmod(azim, 360.0);
+      if (azim < 0.0)
+         azim += 360.0;
+
+      double u = azim / grid.daz;
+      int i = int(u);
+      if (i > grid.naz - 2)
+         i = grid.naz - 2;
+      const double fa = u - i;
+
+      double v = (zen - grid.zen0) / grid.dzen;
+      if (v < 0.0)
+         v = 0.0;
+      else if (v > grid.nzen - 1)
+         v = grid.nzen - 1;
+      int j = int(v);
+      if (j > grid.nzen - 2)
+         j = grid.nzen - 2;
+      const double fz = v - j;
+
+      const double *c = &grid.coef[4 * (i * (grid.nzen - 1) + j)];
+      return c[0] + fa * (c[1] + fz * c[3]) + fz * c[2];
+   }
+
+   const AntennaStore::PCVGrid& AntennaStore::checkGrid(int handle) const
+   {
+      if (handle < 0 || handle >= int(pcvGrids.size()))
+      {
+         InvalidRequest ir("Invalid PCV handle " + StringUtils::asString(handle));
+         GNSSTK_THROW(ir);
+      }
+      return pcvGrids[handle];
+   }
+
+   double AntennaStore::getPhaseCenterVariation(int handle, double azimuth,
+                                                double elev_nadir) const
+   {
+      double pcv;
+      try
+      {
+         getPhaseCenterVariation(handle, 1, &azimuth, &elev_nadir, &pcv);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      return pcv;
+   }
+
+   void AntennaStore::getPhaseCenterVariation(int handle, size_t n,
+                                              const double *azimuth,
+                                              const double *elev_nadir,
+                                              double *pcv) const
+   {
+      try
+      {
+         const PCVGrid& grid(checkGrid(handle));
+         for (size_t k = 0; k < n; k++)
+         {
+            if (elev_nadir[k] < 0.0 || elev_nadir[k] > 90.0)
+            {
+               InvalidRequest ir("Invalid elevation/nadir angle");
+               GNSSTK_THROW(ir);
+            }
+            double zen = (grid.isRx ? 90. - elev_nadir[k] : elev_nadir[k]);
+            pcv[k] = evaluateGrid(grid, azimuth[k], zen);
+         }
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   void AntennaStore::getPhaseCenterVariation(int handle,
+                                              const vector<double>& azimuth,
+                                              const vector<double>& elev_nadir,
+                                              vector<double>& pcv) const
+   {
+      if (azimuth.size() != elev_nadir.size())
+      {
+         InvalidRequest ir("Azimuth and elevation arrays differ in length");
+         GNSSTK_THROW(ir);
+      }
+      pcv.resize(azimuth.size());
+      if (azimuth.empty())
+         return;
+      try
+      {
+         getPhaseCenterVariation(handle, azimuth.size(), &azimuth[0],
+                                 &elev_nadir[0], &pcv[0]);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   Triple AntennaStore::getPhaseCenterOffset(int handle) const
+   {
+      try
+      {
+         const PCVGrid& grid(checkGrid(handle));
+         return Triple(grid.PCO[0], grid.PCO[1], grid.PCO[2]);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
       // dump the store
    void AntennaStore::dump(ostream& s, short detail)
    {
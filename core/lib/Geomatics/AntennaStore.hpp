@@ -145,8 +145,16 @@ namespace gnsstk
       /// get the number of antennas stored
       unsigned int size() const { return antennaMap.size(); }
 
-      /// clear the store of all information
-      void clear() { antennaMap.clear(); }
+         /**
+          clear the store of all information; this invalidates all handles
+          returned by getPCVHandle().
+         */
+      void clear()
+      {
+         antennaMap.clear();
+         pcvGrids.clear();
+         handleMap.clear();
+      }
 
          /**
           call to have satellite antennas included in store
@@ -215,10 +223,109 @@ namespace gnsstk
       Triple ComToPcVector(const SatID& sidr, const CommonTime& ct,
                            const Triple& satVector) const;
 
+         /**
+          Resolve an antenna name and frequency to an integer handle for the
+          fast PCV functions below. On the first call for a given pair the
+          PCVs are compiled into a dense, regular (azimuth, zenith) grid of
+          bilinear interpolation coefficients; later calls return the same
+          handle. The grid is a copy, so the handle remains valid, and refers
+          to the same data, until clear() is called; adding an antenna with the
+          same name recompiles the grids of that name in place.
+          @param name  antenna name, as in getAntenna()
+          @param freq  frequency e.g. G01, as in AntexData
+          @return handle, a small non-negative integer
+          @throw InvalidRequest if the name or frequency is not in the store,
+                  or if the PCVs are not on a regular grid
+         */
+      int getPCVHandle(const std::string& name, const std::string& freq);
+
+         /**
+          Compute the phase center variation for the given handle; the result
+          is the same as AntexData::getPhaseCenterVariation() for the antenna
+          and frequency of the handle.
+          @param handle     returned by getPCVHandle()
+          @param azimuth    azimuth in degrees, as in AntexData
+          @param elev_nadir elevation (receiver) or nadir angle (satellite)
+                            in degrees, as in AntexData
+          @return PCV in millimeters
+          @throw InvalidRequest if the handle is invalid, or the elevation or
+                  nadir angle is not within 0 to 90 degrees
+         */
+      double getPhaseCenterVariation(int handle, double azimuth,
+                                     double elev_nadir) const;
+
+         /**
+          Compute the phase center variation for the given handle at many
+          (azimuth, elevation/nadir) pairs; cf. the single point version.
+          @param handle     returned by getPCVHandle()
+          @param n          number of points
+          @param azimuth    array of n azimuths in degrees
+          @param elev_nadir array of n elevation or nadir angles in degrees
+          @param pcv        output array of n PCVs in millimeters
+          @throw InvalidRequest as for the single point version
+         */
+      void getPhaseCenterVariation(int handle, std::size_t n,
+                                   const double *azimuth,
+                                   const double *elev_nadir,
+                                   double *pcv) const;
+
+         /// Vector version of the batch getPhaseCenterVariation()
+      void getPhaseCenterVariation(int handle,
+                                   const std::vector<double>& azimuth,
+                                   const std::vector<double>& elev_nadir,
+                                   std::vector<double>& pcv) const;
+
+         /**
+          Return the phase center offset (mm) for the given handle, as
+          AntexData::getPhaseCenterOffset().
+          @throw InvalidRequest if the handle is invalid
+         */
+      Triple getPhaseCenterOffset(int handle) const;
+
       /// dump the store
       void dump(std::ostream& s = std::cout, short detail = 0);
 
    private:
+         /**
+          PCVs of one antenna and frequency on a regular grid, with azimuth
+          0 to 360 degrees inclusive and zenith angle from zen0 in steps of
+          dzen. Each cell holds the coefficients c of the bilinear form
+          c[0] + c[1]*fa + c[2]*fz + c[3]*fa*fz, where fa and fz are the
+          fractional positions within the cell.
+         */
+      struct PCVGrid
+      {
+         std::string name;          ///< antenna name
+         std::string freq;          ///< frequency
+         bool isRx;                 ///< elev_nadir is an elevation
+         double PCO[3];             ///< phase center offset (mm)
+         double daz;                ///< azimuth step (deg)
+         double zen0;               ///< first zenith angle (deg)
+         double dzen;               ///< zenith step (deg)
+         int naz;                   ///< number of azimuth nodes, >= 2
+         int nzen;                  ///< number of zenith nodes, >= 2
+         std::vector<double> coef;  ///< 4 per cell, azimuth major
+      };
+
+         /**
+          Compile the PCVs of the given antenna and frequency into grid.
+          @throw InvalidRequest if the frequency is missing, or the PCVs are
+                  not on a regular grid
+         */
+      static void compileGrid(const AntexData& ant, PCVGrid& grid);
+
+         /// Interpolate the grid; zen is the zenith (or nadir) angle
+      static double evaluateGrid(const PCVGrid& grid, double azim, double zen);
+
+      /// Return the grid of the given handle; throw InvalidRequest if invalid
+      const PCVGrid& checkGrid(int handle) const;
+
+      /// compiled PCV grids, indexed by handle
+      std::vector<PCVGrid> pcvGrids;
+
+      /// map from (antenna name, frequency) to handle
+      std::map<std::pair<std::string, std::string>, int> handleMap;
+
       /// List of receiver names to include in store
       std::vector<std::string> namesToInclude;
 
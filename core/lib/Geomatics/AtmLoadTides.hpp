@@ -112,6 +112,25 @@ namespace gnsstk
       Triple computeDisplacement(std::string site, EphTime t,
                                  double UT1mUTC = 0);
 
+         /**
+          Return the 12 loading coefficients of the given site, in mm, in the
+          order used by computeDisplacement(): radial, north-south and
+          east-west rows of (cos1, sin1, cos2, sin2).
+          @param site  string Input name of the site.
+          @return const reference to the coefficients
+          @throw if the site has not been initialized. */
+      const std::vector<double>& getCoefficients(const std::string& site) const
+      {
+         std::map<std::string, std::vector<double>>::const_iterator it;
+         it = coefficientMap.find(site);
+         if (it == coefficientMap.end())
+         {
+            GNSSTK_THROW(
+               Exception("Site not found in atmospheric loading store"));
+         }
+         return it->second;
+      }
+
          /**
           Return the recorded latitude, longitude and ht(=0) for the given site.
           Return value of (0.0,0.0,0.0) probably means the position was not
@@ -54,6 +54,7 @@ namespace gnsstk
    void EOPStore::addEOP(int mjd, EarthOrientation& eop)
    {
       mapMJD_EOP[mjd] = eop;
+      clearCache();
 
       if (begMJD == -1 || endMJD == -1)
       {
@@ -229,6 +230,8 @@ namespace gnsstk
          return;
       }
 
+      clearCache();
+
       map<int, EarthOrientation>::iterator it;
       it = mapMJD_EOP.lower_bound(mjdmin);
       if (it != mapMJD_EOP.begin())
@@ -328,67 +331,77 @@ namespace gnsstk
          // get MJD(UTC)
       double mjdUTC(mjd);
 
-         // find 4 points surrounding the time of interest ----------------
-      map<int, EarthOrientation>::iterator lowit, hiit, it;
-      it = lowit = mapMJD_EOP.find(int(mjdUTC));
-      (hiit = it)++;
-      if (lowit == mapMJD_EOP.end() || hiit == mapMJD_EOP.end())
-      {
-         InvalidRequest ir("Requested time lies outside the store");
-         GNSSTK_THROW(ir);
-      }
-      if (mapMJD_EOP.size() < 4)
+         // same query as last time
+      if (mjdUTC == lastMJD && conv == lastConv)
       {
-         InvalidRequest ir("Store contains less than 4 entries");
-         GNSSTK_THROW(ir);
+         return lastEOP;
       }
 
-         // low and hi must span 4 entries and bracket t
-      (it = lowit)--;
-      if (it == mapMJD_EOP.end())
-      {
-         hiit++;
-         hiit++; // L t . . H
-      }
-      else
+         // find 4 points surrounding the time of interest, unless they are
+         // already held from a previous query on the same day
+      if (int(mjdUTC) != cacheMJD)
       {
-         lowit = it;
-         (it = hiit)++;
+         map<int, EarthOrientation>::iterator lowit, hiit, it;
+         it = lowit = mapMJD_EOP.find(int(mjdUTC));
+         (hiit = it)++;
+         if (lowit == mapMJD_EOP.end() || hiit == mapMJD_EOP.end())
+         {
+            InvalidRequest ir("Requested time lies outside the store");
+            GNSSTK_THROW(ir);
+         }
+
+            // low and hi must span 4 entries and bracket t
+         (it = lowit)--;
          if (it == mapMJD_EOP.end())
          {
-            lowit--; // L . . t H
+            hiit++;
+            hiit++; // L t . . H
          }
          else
          {
-            hiit = it; // L . t . H
+            lowit = it;
+            (it = hiit)++;
+            if (it == mapMJD_EOP.end())
+            {
+               lowit--; // L . . t H
+            }
+            else
+            {
+               hiit = it; // L . t . H
+            }
          }
-      }
 
-         /* fill arrays for Lagrange interpolation -----------------------
-            LOG(INFO) << " LAGINT at " << fixed << setprecision(9) << mjdUTC <<
-            "(UTC)"; */
-      vector<double> vtime, vX, vY, vdT;
-      for (it = lowit; it != mapMJD_EOP.end(); ++it)
-      {
-         vtime.push_back(double(it->first));
-         vX.push_back(it->second.xp);
-         vY.push_back(it->second.yp);
-            /* LOG(INFO) << " xy " << fixed << setprecision(10) <<
-               double(it->first)
-                 << " " << it->second.xp << " " << it->second.yp; */
-         vdT.push_back(it->second.UT1mUTC);
-         if (it == hiit)
+            // fill arrays for Lagrange interpolation -----------------------
+         cacheTime.clear();
+         cacheX.clear();
+         cacheY.clear();
+         cacheDT.clear();
+         for (it = lowit; it != mapMJD_EOP.end(); ++it)
          {
-            break;
+            cacheTime.push_back(double(it->first));
+            cacheX.push_back(it->second.xp);
+            cacheY.push_back(it->second.yp);
+            cacheDT.push_back(it->second.UT1mUTC);
+            if (it == hiit)
+            {
+               break;
+            }
          }
+         cacheMJD = int(mjdUTC);
       }
 
          // let EarthOrientation do the interpolation and correction -----
+         // (it modifies the UT1-UTC array, so pass a copy)
+      vector<double> vdT(cacheDT);
       EarthOrientation eo;
       EphTime ttag;
       ttag.setMJD(mjdUTC);
       ttag.setTimeSystem(TimeSystem::UTC);
-      eo.interpolateEOP(ttag, vtime, vX, vY, vdT, conv);
+      eo.interpolateEOP(ttag, cacheTime, cacheX, cacheY, vdT, conv);
+
+      lastMJD  = mjdUTC;
+      lastConv = conv;
+      lastEOP  = eo;
 
       return eo;
    }
@@ -50,6 +50,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 // GNSSTk
 #include "EOPPrediction.hpp"
 #include "EarthOrientation.hpp"
@@ -74,9 +75,34 @@ namespace gnsstk
          /// first and last times in the store, -1 if store is empty.
       int begMJD, endMJD;
 
+         /**
+          Interpolation state kept by getEOP(): the integer MJD whose
+          bracketing entries are held in the arrays (-1 if none), and the
+          arrays themselves, so that queries within the same day do not search
+          the map again.
+         */
+      int cacheMJD;
+      std::vector<double> cacheTime, cacheX, cacheY, cacheDT;
+
+         /// the most recent result of getEOP(), with its time and convention
+      double lastMJD;
+      IERSConvention lastConv;
+      EarthOrientation lastEOP;
+
+         /// forget the interpolation state; called whenever the store changes
+      void clearCache()
+      {
+         cacheMJD = -1;
+         lastMJD  = -1.0;
+      }
+
    public:
          /// Constructor
-      EOPStore() : begMJD(-1), endMJD(-1) {}
+      EOPStore()
+            : begMJD(-1), endMJD(-1), cacheMJD(-1), lastMJD(-1.0),
+              lastConv(IERSConvention::Unknown)
+      {
+      }
 
          /// Add to the store directly
       void addEOP(int MJD, EarthOrientation& eop);
@@ -133,6 +159,7 @@ namespace gnsstk
       {
          mapMJD_EOP.clear();
          begMJD = endMJD = -1;
+         clearCache();
       }
 
          /**
@@ -155,7 +182,9 @@ namespace gnsstk
           code in class EarthOrientation. This routine pulls data from the map
           for 4 entries surrounding the input time; this array of data is passed
           to class EarthOrientation to perform the interpolation and
-          corrections.
+          corrections. The four entries are kept between calls, as is the
+          last result, so repeated queries within one day, or at one time, are
+          cheap.
           @param mjd MJD(UTC) time of interest
           @param conv IERSConvention to be used.
           @throw InvalidRequest if the integer MJD falls outside the store,
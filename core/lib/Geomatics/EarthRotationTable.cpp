@@ -0,0 +1,327 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file EarthRotationTable.cpp
+    class gnsstk::EarthRotationTable tabulates the ECEF-to-inertial rotation
+    and its rate on a time grid and interpolates between the nodes.
+*/
+
+//------------------------------------------------------------------------------------
+#include "EarthRotationTable.hpp"
+#include <cmath>
+
+//------------------------------------------------------------------------------------
+using namespace std;
+
+namespace gnsstk
+{
+      /// seconds from t0 to t, both in the same time system
+   static double secondsSince(const EphTime& t, const EphTime& t0)
+   {
+      return double(t.lMJD() - t0.lMJD()) * 86400.0 +
+             (t.secOfDay() - t0.secOfDay());
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthRotationTable::compute(EOPStore& store, const IERSConvention& conv,
+                                    const EphTime& beg, const EphTime& end,
+                                    double dt, int n, bool reduced)
+   {
+      try
+      {
+         if (dt <= 0.0 || n < 2)
+         {
+            InvalidRequest ir("Step must be positive and order at least 2");
+            GNSSTK_THROW(ir);
+         }
+
+         EphTime tb(beg), te(end);
+         tb.convertSystemTo(TimeSystem::TT);
+         te.convertSystemTo(TimeSystem::TT);
+         double sec = secondsSince(te, tb);
+         if (sec <= 0.0)
+         {
+            InvalidRequest ir("End time must follow begin time");
+            GNSSTK_THROW(ir);
+         }
+
+            // empty the table until it is complete
+         nnodes = 0;
+         begTT  = tb;
+         span   = sec;
+         step   = dt;
+         order  = n;
+
+            // enough nodes to cover the span, and at least one interpolation
+         int nn = int(std::ceil(span / step - 1.e-9)) + 1;
+         if (nn < order)
+         {
+            nn = order;
+         }
+
+         denom.resize(order);
+         for (int j = 0; j < order; j++)
+         {
+            denom[j] = 1.0;
+            for (int m = 0; m < order; m++)
+            {
+               if (m != j)
+               {
+                  denom[j] *= double(j - m);
+               }
+            }
+         }
+
+         nodes.resize(9 * nn);
+         for (int k = 0; k < nn; k++)
+         {
+            EphTime tt(begTT);
+            tt += k * step;
+            EphTime tu(tt);
+            tu.convertSystemTo(TimeSystem::UTC);
+            EarthOrientation eo = store.getEOP(tu.dMJD(), conv);
+            Matrix<double> R    = eo.ECEFtoInertial(tt, reduced);
+            for (int i = 0; i < 3; i++)
+            {
+               for (int j = 0; j < 3; j++)
+               {
+                  nodes[9 * k + 3 * i + j] = R(i, j);
+               }
+            }
+         }
+
+         nnodes = nn;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+      // private
+   void EarthRotationTable::interpolate(const EphTime& t, double R[9],
+                                        double Rdot[9]) const
+   {
+      if (nnodes == 0)
+      {
+         InvalidRequest ir("Table has not been computed");
+         GNSSTK_THROW(ir);
+      }
+
+      EphTime tt(t);
+      tt.convertSystemTo(TimeSystem::TT);
+      double sec = secondsSince(tt, begTT);
+      if (sec < -1.e-6 || sec > span + 1.e-6)
+      {
+         InvalidRequest ir("Requested time lies outside the table");
+         GNSSTK_THROW(ir);
+      }
+
+         // first node of the interpolation, centering t where possible
+      double s = sec / step;
+      int i0   = int(std::floor(s)) - order / 2 + 1;
+      if (i0 < 0)
+      {
+         i0 = 0;
+      }
+      if (i0 > nnodes - order)
+      {
+         i0 = nnodes - order;
+      }
+      s -= i0;
+
+      int i, j, m;
+      for (i = 0; i < 9; i++)
+      {
+         R[i] = Rdot[i] = 0.0;
+      }
+
+         // Lagrange basis l_j(s) and its derivative, accumulated together
+      const double *node = &nodes[9 * i0];
+      for (j = 0; j < order; j++, node += 9)
+      {
+         double p = 1.0, dp = 0.0;
+         for (m = 0; m < order; m++)
+         {
+            if (m != j)
+            {
+               dp = dp * (s - m) + p;
+               p *= (s - m);
+            }
+         }
+         p /= denom[j];
+         dp /= denom[j] * step; // per second
+         for (i = 0; i < 9; i++)
+         {
+            R[i] += p * node[i];
+            Rdot[i] += dp * node[i];
+         }
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   Matrix<double> EarthRotationTable::ECEFtoInertial(const EphTime& t) const
+   {
+      Matrix<double> R, Rdot;
+      ECEFtoInertial(t, R, Rdot);
+      return R;
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthRotationTable::ECEFtoInertial(const EphTime& t, Matrix<double>& R,
+                                           Matrix<double>& Rdot) const
+   {
+      try
+      {
+         double r[9], rdot[9];
+         interpolate(t, r, rdot);
+         R    = Matrix<double>(3, 3);
+         Rdot = Matrix<double>(3, 3);
+         for (int i = 0; i < 3; i++)
+         {
+            for (int j = 0; j < 3; j++)
+            {
+               R(i, j)    = r[3 * i + j];
+               Rdot(i, j) = rdot[3 * i + j];
+            }
+         }
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthRotationTable::ECEFtoInertial(const vector<EphTime>& t,
+                                           const vector<Triple>& pos,
+                                           const vector<Triple>& vel,
+                                           vector<Triple>& ipos,
+                                           vector<Triple>& ivel) const
+   {
+      try
+      {
+         transform(t, pos, vel, ipos, ivel, true);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthRotationTable::InertialtoECEF(const vector<EphTime>& t,
+                                           const vector<Triple>& pos,
+                                           const vector<Triple>& vel,
+                                           vector<Triple>& epos,
+                                           vector<Triple>& evel) const
+   {
+      try
+      {
+         transform(t, pos, vel, epos, evel, false);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+      // private
+   void EarthRotationTable::transform(const vector<EphTime>& t,
+                                      const vector<Triple>& pos,
+                                      const vector<Triple>& vel,
+                                      vector<Triple>& opos,
+                                      vector<Triple>& ovel,
+                                      bool toInertial) const
+   {
+      size_t n = pos.size();
+      if ((t.size() != n && t.size() != 1) || (!vel.empty() && vel.size() != n))
+      {
+         InvalidRequest ir("Inconsistent array sizes");
+         GNSSTK_THROW(ir);
+      }
+
+      opos.resize(n);
+      ovel.resize(vel.empty() ? 0 : n);
+
+         /* the rotation is interpolated only when the time changes; the
+            element index is transposed for the inverse rotation */
+      double R[9], Rdot[9];
+      int e[9];
+      for (int i = 0; i < 3; i++)
+      {
+         for (int j = 0; j < 3; j++)
+         {
+            e[3 * i + j] = (toInertial ? 3 * i + j : 3 * j + i);
+         }
+      }
+
+      for (size_t k = 0; k < n; k++)
+      {
+         if (k == 0 || (t.size() > 1 &&
+                        (t[k].lMJD() != t[k - 1].lMJD() ||
+                         t[k].secOfDay() != t[k - 1].secOfDay() ||
+                         t[k].getTimeSystem() != t[k - 1].getTimeSystem())))
+         {
+            interpolate(t.size() == 1 ? t[0] : t[k], R, Rdot);
+         }
+
+         const Triple& p = pos[k];
+         for (int i = 0; i < 3; i++)
+         {
+            opos[k][i] = R[e[3 * i]] * p[0] + R[e[3 * i + 1]] * p[1] +
+                         R[e[3 * i + 2]] * p[2];
+         }
+         if (!vel.empty())
+         {
+            const Triple& v = vel[k];
+            for (int i = 0; i < 3; i++)
+            {
+               ovel[k][i] = R[e[3 * i]] * v[0] + R[e[3 * i + 1]] * v[1] +
+                            R[e[3 * i + 2]] * v[2] +
+                            Rdot[e[3 * i]] * p[0] + Rdot[e[3 * i + 1]] * p[1] +
+                            Rdot[e[3 * i + 2]] * p[2];
+            }
+         }
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+} // end namespace gnsstk
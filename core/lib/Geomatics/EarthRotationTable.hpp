@@ -0,0 +1,198 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file EarthRotationTable.hpp
+    class gnsstk::EarthRotationTable tabulates the ECEF-to-inertial rotation
+    and its rate on a time grid and interpolates between the nodes. */
+
+#ifndef CLASS_EARTHROTATIONTABLE_INCLUDE
+#define CLASS_EARTHROTATIONTABLE_INCLUDE
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <vector>
+// GNSSTk
+#include "EOPStore.hpp"
+#include "EphTime.hpp"
+#include "Exception.hpp"
+#include "IERSConvention.hpp"
+#include "Matrix.hpp"
+#include "Triple.hpp"
+
+//------------------------------------------------------------------------------------
+namespace gnsstk
+{
+
+      /**
+       Tabulated transformation between the ECEF (terrestrial) and the
+       conventional inertial (celestial) frames. EarthOrientation::
+       ECEFtoInertial() evaluates the full precession-nutation series on every
+       call, which dominates the cost of converting long, densely sampled
+       orbits. This class evaluates it once per node of a uniform grid (in TT,
+       so leap seconds do not break the grid), using EOPs from an EOPStore,
+       and then interpolates the nine matrix elements with a Lagrange
+       polynomial of the chosen order, which also yields the rate of the
+       rotation. With the default 300 second step and order 10 the
+       interpolated matrix and its rate agree with the direct computation to
+       better than 1e-13 per element (1e-13 rad is about 0.6 micrometer at
+       the Earth's surface).
+
+       The table is read-only once computed, so one table may be shared by
+       several threads.
+      */
+   class EarthRotationTable
+   {
+   public:
+         /// Constructor; the table is empty until compute() is called.
+      EarthRotationTable() : span(0.0), step(0.0), order(0), nnodes(0) {}
+
+         /**
+          Fill the table.
+          @param store EOPStore holding EOPs that cover beg to end, plus the
+                   half-width of the interpolation.
+          @param conv IERSConvention to be used.
+          @param beg first time of interest, in any system EphTime allows.
+          @param end last time of interest, in any system EphTime allows.
+          @param step spacing of the nodes in seconds.
+          @param order number of nodes used by each interpolation, at least 2.
+          @param reduced passed to EarthOrientation::ECEFtoInertial().
+          @throw InvalidRequest if end is not after beg, step is not positive,
+                  order is less than 2, or the store does not cover the grid.
+          @throw Exception if the TimeSystem of beg or end is Unknown.
+         */
+      void compute(EOPStore& store, const IERSConvention& conv,
+                   const EphTime& beg, const EphTime& end,
+                   double step = 300.0, int order = 10,
+                   bool reduced = false);
+
+         /// @return true if compute() has filled the table.
+      bool isValid() const { return nnodes > 0; }
+
+         /// @return time (TT) of the first node.
+      EphTime getFirstTime() const { return begTT; }
+
+         /// @return spacing of the nodes in seconds.
+      double getStep() const { return step; }
+
+         /// @return number of nodes used by each interpolation.
+      int getOrder() const { return order; }
+
+         /// @return number of nodes in the table.
+      int size() const { return nnodes; }
+
+         /**
+          Interpolate the ECEF-to-inertial rotation at time t.
+          @param t time of interest, between the beg and end given to compute().
+          @return 3x3 rotation matrix, as EarthOrientation::ECEFtoInertial().
+          @throw InvalidRequest if the table is empty or t is outside it.
+         */
+      Matrix<double> ECEFtoInertial(const EphTime& t) const;
+
+         /**
+          Interpolate the ECEF-to-inertial rotation and its time derivative.
+          @param t time of interest, between the beg and end given to compute().
+          @param R output 3x3 rotation matrix.
+          @param Rdot output 3x3 derivative of R, per second.
+          @throw InvalidRequest if the table is empty or t is outside it.
+         */
+      void ECEFtoInertial(const EphTime& t, Matrix<double>& R,
+                          Matrix<double>& Rdot) const;
+
+         /**
+          Transform arrays of ECEF positions and velocities to the inertial
+          frame, ri = R*re and vi = R*ve + Rdot*re.
+          @param t times, either one per position or a single time for all.
+          @param pos ECEF positions (m).
+          @param vel ECEF velocities (m/s), same length as pos, or empty if
+                  velocities are not wanted.
+          @param ipos output inertial positions (m).
+          @param ivel output inertial velocities (m/s), empty if vel is.
+          @throw InvalidRequest if the array sizes are inconsistent, the table
+                  is empty or any time is outside it.
+         */
+      void ECEFtoInertial(const std::vector<EphTime>& t,
+                          const std::vector<Triple>& pos,
+                          const std::vector<Triple>& vel,
+                          std::vector<Triple>& ipos,
+                          std::vector<Triple>& ivel) const;
+
+         /**
+          Transform arrays of inertial positions and velocities to the ECEF
+          frame, re = R'*ri and ve = R'*vi + Rdot'*ri; the inverse of
+          ECEFtoInertial(). Arguments as for ECEFtoInertial().
+          @throw InvalidRequest if the array sizes are inconsistent, the table
+                  is empty or any time is outside it.
+         */
+      void InertialtoECEF(const std::vector<EphTime>& t,
+                          const std::vector<Triple>& pos,
+                          const std::vector<Triple>& vel,
+                          std::vector<Triple>& epos,
+                          std::vector<Triple>& evel) const;
+
+   private:
+         /**
+          Interpolate the nine elements (row major) of the rotation and its
+          rate at time t.
+          @throw InvalidRequest if the table is empty or t is outside it.
+         */
+      void interpolate(const EphTime& t, double R[9], double Rdot[9]) const;
+
+         /// Common part of the two batch transforms.
+      void transform(const std::vector<EphTime>& t,
+                     const std::vector<Triple>& pos,
+                     const std::vector<Triple>& vel,
+                     std::vector<Triple>& opos, std::vector<Triple>& ovel,
+                     bool toInertial) const;
+
+      EphTime begTT; ///< time (TT) of the first node
+      double span;   ///< seconds from the first node to the requested end
+      double step;   ///< seconds between nodes
+      int order;     ///< number of nodes in each interpolation
+      int nnodes;    ///< number of nodes in the table
+
+         /// Lagrange denominators PROD(m!=j)(j-m), j=0..order-1
+      std::vector<double> denom;
+
+         /// nine rotation elements (row major) at each node
+      std::vector<double> nodes;
+
+   }; // end class EarthRotationTable
+
+} // end namespace gnsstk
+
+#endif // CLASS_EARTHROTATIONTABLE_INCLUDE
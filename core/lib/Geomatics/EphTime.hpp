@@ -148,6 +148,9 @@ namespace gnsstk
          system = sys;
       }
 
+         /// @return the TimeSystem
+      TimeSystem getTimeSystem() const { return system; }
+
          /**
           set to value of full MJD
           @param mjd long double MJD
@@ -97,6 +97,7 @@
 #define FDIFF_FILTER_INCLUDE
 
 #include "RobustStats.hpp"
+#include "SlidingStats.hpp"
 #include "Stats.hpp"
 #include "StatsFilterHit.hpp"
 #include "StringUtils.hpp"
@@ -356,8 +357,8 @@ namespace gnsstk
       Avec.clear();
 
       // compute stats on sigmas and data in a sliding window of width Nwind
-      gnsstk::TwoSampleStats<T> fstats; // stats on the first diffs in window
-      gnsstk::TwoSampleStats<T> dstats; // stats on the data in window
+      gnsstk::SlidingStats<T> fstats; // stats on the first diffs in window
+      gnsstk::SlidingStats<T> dstats; // stats on the data in window
       std::vector<T> slopes;           // store slopes, for robust stats
 
       // loop over all data, computing first difference and stats in sliding
@@ -91,7 +91,9 @@
 #define FIRST_DIFF_FILTER_INCLUDE
 
 #include "RobustStats.hpp"
+#include "SlidingStats.hpp"
 #include "Stats.hpp"
+#include <algorithm>
 #include <vector>
 //#include "StringUtils.hpp"       // TEMP
 //#include "logstream.hpp"         // TEMP
@@ -246,6 +248,12 @@ namespace gnsstk
          */
       std::vector<Analysis> analvec;
 
+         /// comparison for the binary search of analvec by index
+      static bool lessIndex(const Analysis& A, unsigned int index)
+      {
+         return A.index < index;
+      }
+
          /// vector of FilterHit, generated by analyze(), also for use in dump()
       std::vector<FilterHit<T>> results;
 
@@ -498,7 +506,7 @@ namespace gnsstk
       const unsigned int N(4);
       unsigned int i, j;
       std::ostringstream oss;
-      gnsstk::Stats<double> pstats, fstats; // TD? TwoSampleStats
+      gnsstk::SlidingStats<double> pstats, fstats; // TD? two-sample
 
       if (dump)
       {
@@ -732,16 +740,15 @@ namespace gnsstk
       int j(-1);
       unsigned int i, k;
       fe.min = fe.max = fe.med = fe.mad = T(0);
-      for (i = 0; i < analvec.size(); i++)
-         if (analvec[i].index == fe.index)
-         {
-            j = i;
-            break;
-         }
-      if (j == -1)
+      // analvec is filled in order of index
+      typename std::vector<Analysis>::const_iterator it =
+         std::lower_bound(analvec.begin(), analvec.end(), fe.index,
+                          lessIndex);
+      if (it == analvec.end() || it->index != fe.index)
       {
          return;
       }
+      j = it - analvec.begin();
       k = fe.index + fe.npts; // last index in this seg is k-1
 
       // don't include the step in stats for a segment that starts with a slip
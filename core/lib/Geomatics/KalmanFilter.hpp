@@ -47,9 +47,12 @@
 #include "SRIFilter.hpp"
 #include "Vector.hpp"
 #include "logstream.hpp"
+#include <cmath>
+#include <iomanip>
 #include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace gnsstk
 {
@@ -251,6 +254,14 @@ namespace gnsstk
       } SmootherStoreRec;
       std::map<int, SmootherStoreRec> SmootherStore;
 
+         /**
+          if positive, states that have not been observed (had a non-zero
+          partial) for this many seconds are marginalized after each MU
+         */
+      double dropAfter;
+         /// time at which each state was last observed, used with dropAfter
+      std::map<std::string, double> lastObserved;
+
    public:
       // functions
       // -----------------------------------------------------------------------------
@@ -337,7 +348,7 @@ namespace gnsstk
          : NTU(0), NMU(0), NSU(0), Nstate(0), stage(Unknown), Nnoise(0),
            extended(false), smoother(false), doSRISU(true), doOutput(true),
            doInversions(true), singular(true), timeReversed(false),
-           dryRun(false)
+           dryRun(false), dropAfter(0.0)
       {
       }
 
@@ -345,7 +356,7 @@ namespace gnsstk
           Constructor given an initial Namelist for the filter state
           @param NL Namelist of the filter states (determines Nstate)
          */
-      KalmanFilter(const gnsstk::Namelist& NL) { Reset(NL); }
+      KalmanFilter(const gnsstk::Namelist& NL) : dropAfter(0.0) { Reset(NL); }
 
          /**
           Reset or recreate filter - use this after the empty constructor
@@ -764,6 +775,12 @@ namespace gnsstk
 
                inverted = false;
                NMU++;
+
+               if (dropAfter > 0.0)
+               {
+                  updateObserved();
+                  dropUnobserved(dropAfter);
+               }
             }
 
             return ret;
@@ -954,7 +971,134 @@ namespace gnsstk
          /// get number of measurements processed
       int getNMU() { return NMU; }
 
+         /**
+          if T > 0, marginalize states not observed for T seconds after each
+          MU; T <= 0 turns this off (the default). The derived class must
+          then build Partials using getNames(), as the state may shrink.
+         */
+      void setDropUnobserved(double T) { dropAfter = T; }
+      double getDropUnobserved() { return dropAfter; }
+
+         /**
+          Eliminate (marginalize) the given states from the filter, keeping
+          the information on all the others; names not in the state are
+          ignored. State and Cov are compacted to match. Not allowed in a
+          smoother, since the stored time updates would no longer fit.
+          @param drops Namelist of states to eliminate
+          @throw Exception if the filter is a smoother
+         */
+      void marginalizeStates(const gnsstk::Namelist& drops)
+      {
+         if (isSmoother())
+         {
+            gnsstk::Exception e("Cannot marginalize states in a smoother");
+            GNSSTK_THROW(e);
+         }
+         try
+         {
+            const gnsstk::Namelist NL(srif.getNames());
+            std::vector<unsigned int> keep;
+            for (unsigned int i = 0; i < NL.size(); i++)
+            {
+               if (drops.index(NL.getName(i)) == -1)
+               {
+                  keep.push_back(i);
+               }
+               else
+               {
+                  lastObserved.erase(NL.getName(i));
+               }
+            }
+            if (keep.size() == NL.size())
+            {
+               return;
+            }
+
+            if (!dryRun)
+            {
+               srif.marginalize(drops);
+            }
+            Nstate = keep.size();
+
+               // the marginal state and covariance are just the kept parts
+            if (State.size() == NL.size() && Cov.rows() == NL.size())
+            {
+               gnsstk::Vector<double> X(Nstate);
+               gnsstk::Matrix<double> C(Nstate, Nstate);
+               for (unsigned int i = 0; i < keep.size(); i++)
+               {
+                  X(i) = State(keep[i]);
+                  for (unsigned int j = 0; j < keep.size(); j++)
+                     C(i, j) = Cov(keep[i], keep[j]);
+               }
+               State = X;
+               Cov   = C;
+            }
+            else
+            {
+               State    = gnsstk::Vector<double>(Nstate, 0.0);
+               Cov      = gnsstk::Matrix<double>(Nstate, Nstate, 0.0);
+               inverted = false;
+            }
+         }
+         catch (gnsstk::Exception& e)
+         {
+            e.addText("marginalizeStates");
+            GNSSTK_RETHROW(e);
+         }
+      }
+
+         /**
+          Marginalize all states that have not been observed for more than T
+          seconds, as recorded at each MU when setDropUnobserved() is on.
+          States with no record are considered observed now.
+          @param T seconds a state may go unobserved before it is dropped
+          @return number of states dropped
+         */
+      int dropUnobserved(double T)
+      {
+         const gnsstk::Namelist NL(srif.getNames());
+         gnsstk::Namelist drops;
+         for (unsigned int i = 0; i < NL.size(); i++)
+         {
+            std::map<std::string, double>::iterator it =
+               lastObserved.find(NL.getName(i));
+            if (it == lastObserved.end())
+            {
+               lastObserved[NL.getName(i)] = time;
+            }
+            else if (::fabs(time - it->second) > T)
+            {
+               drops += NL.getName(i);
+            }
+         }
+         if (drops.size() > 0)
+         {
+            LOG(DEBUG) << "Drop unobserved states " << drops << " at "
+                       << std::fixed << std::setprecision(3) << time;
+            marginalizeStates(drops);
+         }
+         return drops.size();
+      }
+
    private:
+         /// record the current time for every state with a non-zero partial
+      void updateObserved()
+      {
+         const gnsstk::Namelist NL(srif.getNames());
+         for (unsigned int j = 0; j < Partials.cols() && j < NL.size(); j++)
+         {
+            for (unsigned int i = 0; i < Partials.rows(); i++)
+            {
+               if (Partials(i, j) != 0.0)
+               {
+                  lastObserved[NL.getName(j)] = time;
+                  break;
+               }
+            }
+         }
+      }
+
          // --------------------------------------------------------------------------
          /**
           for internal use in constructors and by Reset. Create SRIF and
@@ -977,6 +1121,7 @@ namespace gnsstk
 
          // clear smoother store
          SmootherStore.clear();
+         lastObserved.clear();
       }
 
          /** For internal use to invert the SRIF to get State and Covariance */
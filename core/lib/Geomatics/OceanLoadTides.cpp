@@ -454,64 +454,9 @@ namespace gnsstk
             GNSSTK_THROW(e);
          }
 
-            // compute time argument
-         EphTime ttag(time);
-         ttag.convertSystemTo(TimeSystem::UTC);
-         double dayfr(ttag.secOfDay() / 86400.0);
-         ttag.convertSystemTo(TimeSystem::TT);
-            // T = EarthOrientation::CoordTransTime()
-         double T((ttag.dMJD() - 51544.5) / 36525.0);
-
-            // get the Delauney arguments and frequencies at t
-         double Del[5], freqDel[5]; // degrees and cycles/day
-         Del[0] =
-            134.9634025100 + // EarthOrientation::L()
-            T * (477198.8675605000 +
-                 T * (0.0088553333 + T * (0.0000143431 + T * (-0.0000000680))));
-         Del[1] =
-            357.5291091806 + // EarthOrientation::Lp()
-            T *
-               (35999.0502911389 +
-                T * (-0.0001536667 + T * (0.0000000378 + T * (-0.0000000032))));
-         Del[2] =
-            93.2720906200 + // EarthOrientation::F()
-            T *
-               (483202.0174577222 +
-                T * (-0.0035420000 + T * (-0.0000002881 + T * (0.0000000012))));
-         Del[3] =
-            297.8501954694 + // EarthOrientation::D()
-            T *
-               (445267.1114469445 +
-                T * (-0.0017696111 + T * (0.0000018314 + T * (-0.0000000088))));
-         Del[4] =
-            125.0445550100 + // EarthOrientation::Omega2003()
-            T * (-1934.1362619722 +
-                 T * (0.0020756111 + T * (0.0000021394 + T * (-0.0000000165))));
-         for (i = 0; i < 5; i++)
-            Del[i] = ::fmod(Del[i], 360.0);
-         freqDel[0] = 0.0362916471 + 0.0000000013 * T;
-         freqDel[1] = 0.0027377786;
-         freqDel[2] = 0.0367481951 - 0.0000000005 * T;
-         freqDel[3] = 0.0338631920 - 0.0000000003 * T;
-         freqDel[4] = -0.0001470938 + 0.0000000003 * T;
-
-            // convert to Doodson (Darwin) variables
+            // compute the Doodson arguments and frequencies at time
          double Dood[6], freqDood[6];
-         Dood[0] = 360.0 * dayfr - Del[3];
-         Dood[1] = Del[2] + Del[4];
-         Dood[2] = Dood[1] - Del[3];
-         Dood[3] = Dood[1] - Del[0];
-         Dood[4] = -Del[4];
-         Dood[5] = Dood[2] - Del[1];
-         for (i = 0; i < 6; i++)
-            Dood[i] = ::fmod(Dood[i], 360.0);
-
-         freqDood[0] = 1.0 - freqDel[3];
-         freqDood[1] = freqDel[2] + freqDel[4];
-         freqDood[2] = freqDood[1] - freqDel[3];
-         freqDood[3] = freqDood[1] - freqDel[0];
-         freqDood[4] = -freqDel[4];
-         freqDood[5] = freqDood[2] - freqDel[1];
+         doodsonArguments(time, Dood, freqDood);
 
             // find amplitudes and phases for vertical, west and south components,
             // for all 342 derived tides, from standard tides
@@ -654,6 +599,417 @@ namespace gnsstk
 
    } // end Triple OceanLoadTides::computeDisplacement
 
+   //---------------------------------------------------------------------------------
+   void OceanLoadTides::getHarmonics(const string& site, vector<double>& harm)
+   {
+      try
+      {
+         if (!isValid(site))
+         {
+            Exception e("Site " + site + " has not been initialized.");
+            GNSSTK_THROW(e);
+         }
+
+         const vector<double>& coeff(coefficientMap[site]);
+
+            // standard tides, as in computeDisplacement()
+         static const NVector SchInd[] = {
+            {2, 0, 0, 0, 0, 0},  {2, 2, -2, 0, 0, 0}, {2, -1, 0, 1, 0, 0},
+            {2, 2, 0, 0, 0, 0},  {1, 1, 0, 0, 0, 0},  {1, -1, 0, 0, 0, 0},
+            {1, 1, -2, 0, 0, 0}, {1, -2, 0, 1, 0, 0}, {0, 2, 0, 0, 0, 0},
+            {0, 1, 0, -1, 0, 0}, {0, 0, 2, 0, 0, 0},
+         };
+
+            // With all Doodson arguments zero, deriveTides() returns the phase
+            // of each derived tide relative to its own astronomical argument,
+            // so that the displacement at any time is
+            //    sum_j amp_j * cos(arg_j(t) + phs_j).
+            // The frequencies, which only select the spline value, are taken
+            // at J2000; their drift is negligible.
+         double Dood[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, freqDood[6];
+         double freqDel[5];
+         freqDel[0]  = 0.0362916471;
+         freqDel[1]  = 0.0027377786;
+         freqDel[2]  = 0.0367481951;
+         freqDel[3]  = 0.0338631920;
+         freqDel[4]  = -0.0001470938;
+         freqDood[0] = 1.0 - freqDel[3];
+         freqDood[1] = freqDel[2] + freqDel[4];
+         freqDood[2] = freqDood[1] - freqDel[3];
+         freqDood[3] = freqDood[1] - freqDel[0];
+         freqDood[4] = -freqDel[4];
+         freqDood[5] = freqDood[2] - freqDel[1];
+
+         harm.assign(6 * NDER, 0.0);
+         double amp[NSTD], phs[NSTD], ampDer[NDER], phsDer[NDER], freq[NDER];
+            // component order in output is N, E, U; in coeff it is U, W, S
+         static const int first[3] = {22, 11, 0};
+         static const double sign[3] = {-1.0, -1.0, 1.0};
+         for (int c = 0; c < 3; c++)
+         {
+            for (int i = 0; i < NSTD; i++)
+            {
+               amp[i] = coeff[first[c] + i];
+               phs[i] = -coeff[first[c] + 33 + i];
+            }
+            int nder = deriveTides(SchInd, amp, phs, Dood, freqDood, ampDer,
+                                   phsDer, freq, NSTD);
+            if (nder != NDER)
+            {
+               Exception e("Site " + site + " does not define all tides");
+               GNSSTK_THROW(e);
+            }
+            for (int j = 0; j < NDER; j++)
+            {
+               double a(sign[c] * ampDer[j]), p(phsDer[j] * DEG_TO_RAD);
+               harm[2 * c * NDER + j]        = a * ::cos(p);
+               harm[(2 * c + 1) * NDER + j] = -a * ::sin(p);
+            }
+         }
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (exception& e)
+      {
+         Exception E("std except: " + string(e.what()));
+         GNSSTK_THROW(E);
+      }
+      catch (...)
+      {
+         Exception e("Unknown exception");
+         GNSSTK_THROW(e);
+      }
+   } // end void OceanLoadTides::getHarmonics
+
+   //---------------------------------------------------------------------------------
+   void OceanLoadTides::tideArguments(const EphTime& time, vector<double>& cosArg,
+                                      vector<double>& sinArg)
+   {
+      try
+      {
+         double Dood[6], freqDood[6];
+         doodsonArguments(time, Dood, freqDood);
+
+         cosArg.resize(NDER);
+         sinArg.resize(NDER);
+         for (int j = 0; j < NDER; j++)
+         {
+            double arg(0.0);
+            for (int k = 0; k < 6; k++)
+            {
+               arg += DerInd[j].n[k] * Dood[k];
+            }
+            arg       = ::fmod(arg, 360.0) * DEG_TO_RAD;
+            cosArg[j] = ::cos(arg);
+            sinArg[j] = ::sin(arg);
+         }
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   } // end void OceanLoadTides::tideArguments
+
+   //---------------------------------------------------------------------------------
+   void OceanLoadTides::doodsonArguments(const EphTime& time, double Dood[6],
+                                         double freqDood[6])
+   {
+      int i;
+
+         // compute time argument
+      EphTime ttag(time);
+      ttag.convertSystemTo(TimeSystem::UTC);
+      double dayfr(ttag.secOfDay() / 86400.0);
+      ttag.convertSystemTo(TimeSystem::TT);
+         // T = EarthOrientation::CoordTransTime()
+      double T((ttag.dMJD() - 51544.5) / 36525.0);
+
+         // get the Delauney arguments and frequencies at t
+      double Del[5], freqDel[5]; // degrees and cycles/day
+      Del[0] =
+         134.9634025100 + // EarthOrientation::L()
+         T * (477198.8675605000 +
+              T * (0.0088553333 + T * (0.0000143431 + T * (-0.0000000680))));
+      Del[1] =
+         357.5291091806 + // EarthOrientation::Lp()
+         T * (35999.0502911389 +
+              T * (-0.0001536667 + T * (0.0000000378 + T * (-0.0000000032))));
+      Del[2] =
+         93.2720906200 + // EarthOrientation::F()
+         T * (483202.0174577222 +
+              T * (-0.0035420000 + T * (-0.0000002881 + T * (0.0000000012))));
+      Del[3] =
+         297.8501954694 + // EarthOrientation::D()
+         T * (445267.1114469445 +
+              T * (-0.0017696111 + T * (0.0000018314 + T * (-0.0000000088))));
+      Del[4] =
+         125.0445550100 + // EarthOrientation::Omega2003()
+         T * (-1934.1362619722 +
+              T * (0.0020756111 + T * (0.0000021394 + T * (-0.0000000165))));
+      for (i = 0; i < 5; i++)
+         Del[i] = ::fmod(Del[i], 360.0);
+      freqDel[0] = 0.0362916471 + 0.0000000013 * T;
+      freqDel[1] = 0.0027377786;
+      freqDel[2] = 0.0367481951 - 0.0000000005 * T;
+      freqDel[3] = 0.0338631920 - 0.0000000003 * T;
+      freqDel[4] = -0.0001470938 + 0.0000000003 * T;
+
+         // convert to Doodson (Darwin) variables
+      Dood[0] = 360.0 * dayfr - Del[3];
+      Dood[1] = Del[2] + Del[4];
+      Dood[2] = Dood[1] - Del[3];
+      Dood[3] = Dood[1] - Del[0];
+      Dood[4] = -Del[4];
+      Dood[5] = Dood[2] - Del[1];
+      for (i = 0; i < 6; i++)
+         Dood[i] = ::fmod(Dood[i], 360.0);
+
+      freqDood[0] = 1.0 - freqDel[3];
+      freqDood[1] = freqDel[2] + freqDel[4];
+      freqDood[2] = freqDood[1] - freqDel[3];
+      freqDood[3] = freqDood[1] - freqDel[0];
+      freqDood[4] = -freqDel[4];
+      freqDood[5] = freqDood[2] - freqDel[1];
+
+   } // end void OceanLoadTides::doodsonArguments
+
+   //---------------------------------------------------------------------------------
+   /* Tables of the 342 derived tides, used by deriveTides() and by the
+      harmonic expansion (getHarmonics(), tideArguments()). */
+   // indexes for std tides: M2, S2, N2, K2, K1,  O1,  P1,  Q1,  Mf,  Mm, Ssa
+   const int OceanLoadTides::stdindex[] = {0,   1,   2,   3,   109, 110,
+                                           111, 112, 263, 264, 265};
+
+   const double OceanLoadTides::DerAmp[] = {
+      .632208,  .294107,  .121046,  .079915,  .023818,  -.023589, .022994,
+      .019333,  -.017871, .017192,  .016018,  .004671,  -.004662, -.004519,
+      .004470,  .004467,  .002589,  -.002455, -.002172, .001972,  .001947,
+      .001914,  -.001898, .001802,  .001304,  .001170,  .001130,  .001061,
+      -.001022, -.001017, .001014,  .000901,  -.000857, .000855,  .000855,
+      .000772,  .000741,  .000741,  -.000721, .000698,  .000658,  .000654,
+      -.000653, .000633,  .000626,  -.000598, .000590,  .000544,  .000479,
+      -.000464, .000413,  -.000390, .000373,  .000366,  .000366,  -.000360,
+      -.000355, .000354,  .000329,  .000328,  .000319,  .000302,  .000279,
+      -.000274, -.000272, .000248,  -.000225, .000224,  -.000223, -.000216,
+      .000211,  .000209,  .000194,  .000185,  -.000174, -.000171, .000159,
+      .000131,  .000127,  .000120,  .000118,  .000117,  .000108,  .000107,
+      .000105,  -.000102, .000102,  .000099,  -.000096, .000095,  -.000089,
+      -.000085, -.000084, -.000081, -.000077, -.000072, -.000067, .000066,
+      .000064,  .000063,  .000063,  .000063,  .000062,  .000062,  -.000060,
+      .000056,  .000053,  .000051,  .000050,  .368645,  -.262232, -.121995,
+      -.050208, .050031,  -.049470, .020620,  .020613,  .011279,  -.009530,
+      -.009469, -.008012, .007414,  -.007300, .007227,  -.007131, -.006644,
+      .005249,  .004137,  .004087,  .003944,  .003943,  .003420,  .003418,
+      .002885,  .002884,  .002160,  -.001936, .001934,  -.001798, .001690,
+      .001689,  .001516,  .001514,  -.001511, .001383,  .001372,  .001371,
+      -.001253, -.001075, .001020,  .000901,  .000865,  -.000794, .000788,
+      .000782,  -.000747, -.000745, .000670,  -.000603, -.000597, .000542,
+      .000542,  -.000541, -.000469, -.000440, .000438,  .000422,  .000410,
+      -.000374, -.000365, .000345,  .000335,  -.000321, -.000319, .000307,
+      .000291,  .000290,  -.000289, .000286,  .000275,  .000271,  .000263,
+      -.000245, .000225,  .000225,  .000221,  -.000202, -.000200, -.000199,
+      .000192,  .000183,  .000183,  .000183,  -.000170, .000169,  .000168,
+      .000162,  .000149,  -.000147, -.000141, .000138,  .000136,  .000136,
+      .000127,  .000127,  -.000126, -.000121, -.000121, .000117,  -.000116,
+      -.000114, -.000114, -.000114, .000114,  .000113,  .000109,  .000108,
+      .000106,  -.000106, -.000106, .000105,  .000104,  -.000103, -.000100,
+      -.000100, -.000100, .000099,  -.000098, .000093,  .000093,  .000090,
+      -.000088, .000083,  -.000083, -.000082, -.000081, -.000079, -.000077,
+      -.000075, -.000075, -.000075, .000071,  .000071,  -.000071, .000068,
+      .000068,  .000065,  .000065,  .000064,  .000064,  .000064,  -.000064,
+      -.000060, .000056,  .000056,  .000053,  .000053,  .000053,  -.000053,
+      .000053,  .000053,  .000052,  .000050,  -.066607, -.035184, -.030988,
+      .027929,  -.027616, -.012753, -.006728, -.005837, -.005286, -.004921,
+      -.002884, -.002583, -.002422, .002310,  .002283,  -.002037, .001883,
+      -.001811, -.001687, -.001004, -.000925, -.000844, .000766,  .000766,
+      -.000700, -.000495, -.000492, .000491,  .000483,  .000437,  -.000416,
+      -.000384, .000374,  -.000312, -.000288, -.000273, .000259,  .000245,
+      -.000232, .000229,  -.000216, .000206,  -.000204, -.000202, .000200,
+      .000195,  -.000190, .000187,  .000180,  -.000179, .000170,  .000153,
+      -.000137, -.000119, -.000119, -.000112, -.000110, -.000110, .000107,
+      -.000095, -.000095, -.000091, -.000090, -.000081, -.000079, -.000079,
+      .000077,  -.000073, .000069,  -.000067, -.000066, .000065,  .000064,
+      -.000062, .000060,  .000059,  -.000056, .000055,  -.000051};
+
+   const OceanLoadTides::NVector OceanLoadTides::DerInd[] = {
+      {2, 0, 0, 0, 0, 0},    {2, 2, -2, 0, 0, 0},
+      {2, -1, 0, 1, 0, 0}, // M2,S2,N2
+      {2, 2, 0, 0, 0, 0},    {2, 2, 0, 0, 1, 0},
+      {2, 0, 0, 0, -1, 0}, // K2,x,x
+      {2, -1, 2, -1, 0, 0},  {2, -2, 2, 0, 0, 0},
+      {2, 1, 0, -1, 0, 0},   {2, 2, -3, 0, 0, 1},
+      {2, -2, 0, 2, 0, 0},   {2, -3, 2, 1, 0, 0},
+      {2, 1, -2, 1, 0, 0},   {2, -1, 0, 1, -1, 0},
+      {2, 3, 0, -1, 0, 0},   {2, 1, 0, 1, 0, 0},
+      {2, 2, 0, 0, 2, 0},    {2, 2, -1, 0, 0, -1},
+      {2, 0, -1, 0, 0, 1},   {2, 1, 0, 1, 1, 0},
+      {2, 3, 0, -1, 1, 0},   {2, 0, 1, 0, 0, -1},
+      {2, 0, -2, 2, 0, 0},   {2, -3, 0, 3, 0, 0},
+      {2, -2, 3, 0, 0, -1},  {2, 4, 0, 0, 0, 0},
+      {2, -1, 1, 1, 0, -1},  {2, -1, 3, -1, 0, -1},
+      {2, 2, 0, 0, -1, 0},   {2, -1, -1, 1, 0, 1},
+      {2, 4, 0, 0, 1, 0},    {2, -3, 4, -1, 0, 0},
+      {2, -1, 2, -1, -1, 0}, {2, 3, -2, 1, 0, 0},
+      {2, 1, 2, -1, 0, 0},   {2, -4, 2, 2, 0, 0},
+      {2, 4, -2, 0, 0, 0},   {2, 0, 2, 0, 0, 0},
+      {2, -2, 2, 0, -1, 0},  {2, 2, -4, 0, 0, 2},
+      {2, 2, -2, 0, -1, 0},  {2, 1, 0, -1, -1, 0},
+      {2, -1, 1, 0, 0, 0},   {2, 2, -1, 0, 0, 1},
+      {2, 2, 1, 0, 0, -1},   {2, -2, 0, 2, -1, 0},
+      {2, -2, 4, -2, 0, 0},  {2, 2, 2, 0, 0, 0},
+      {2, -4, 4, 0, 0, 0},   {2, -1, 0, -1, -2, 0},
+      {2, 1, 2, -1, 1, 0},   {2, -1, -2, 3, 0, 0},
+      {2, 3, -2, 1, 1, 0},   {2, 4, 0, -2, 0, 0},
+      {2, 0, 0, 2, 0, 0},    {2, 0, 2, -2, 0, 0},
+      {2, 0, 2, 0, 1, 0},    {2, -3, 3, 1, 0, -1},
+      {2, 0, 0, 0, -2, 0},   {2, 4, 0, 0, 2, 0},
+      {2, 4, -2, 0, 1, 0},   {2, 0, 0, 0, 0, 2},
+      {2, 1, 0, 1, 2, 0},    {2, 0, -2, 0, -2, 0},
+      {2, -2, 1, 0, 0, 1},   {2, -2, 1, 2, 0, -1},
+      {2, -1, 1, -1, 0, 1},  {2, 5, 0, -1, 0, 0},
+      {2, 1, -3, 1, 0, 1},   {2, -2, -1, 2, 0, 1},
+      {2, 3, 0, -1, 2, 0},   {2, 1, -2, 1, -1, 0},
+      {2, 5, 0, -1, 1, 0},   {2, -4, 0, 4, 0, 0},
+      {2, -3, 2, 1, -1, 0},  {2, -2, 1, 1, 0, 0},
+      {2, 4, 0, -2, 1, 0},   {2, 0, 0, 2, 1, 0},
+      {2, -5, 4, 1, 0, 0},   {2, 0, 2, 0, 2, 0},
+      {2, -1, 2, 1, 0, 0},   {2, 5, -2, -1, 0, 0},
+      {2, 1, -1, 0, 0, 0},   {2, 2, -2, 0, 0, 2},
+      {2, -5, 2, 3, 0, 0},   {2, -1, -2, 1, -2, 0},
+      {2, -3, 5, -1, 0, -1}, {2, -1, 0, 0, 0, 1},
+      {2, -2, 0, 0, -2, 0},  {2, 0, -1, 1, 0, 0},
+      {2, -3, 1, 1, 0, 1},   {2, 3, 0, -1, -1, 0},
+      {2, 1, 0, 1, -1, 0},   {2, -1, 2, 1, 1, 0},
+      {2, 0, -3, 2, 0, 1},   {2, 1, -1, -1, 0, 1},
+      {2, -3, 0, 3, -1, 0},  {2, 0, -2, 2, -1, 0},
+      {2, -4, 3, 2, 0, -1},  {2, -1, 0, 1, -2, 0},
+      {2, 5, 0, -1, 2, 0},   {2, -4, 5, 0, 0, -1},
+      {2, -2, 4, 0, 0, -2},  {2, -1, 0, 1, 0, 2},
+      {2, -2, -2, 4, 0, 0},  {2, 3, -2, -1, -1, 0},
+      {2, -2, 5, -2, 0, -1}, {2, 0, -1, 0, -1, 1},
+      {2, 5, -2, -1, 1, 0},  {1, 1, 0, 0, 0, 0},
+      {1, -1, 0, 0, 0, 0}, // x,K1,O1
+      {1, 1, -2, 0, 0, 0},   {1, -2, 0, 1, 0, 0},
+      {1, 1, 0, 0, 1, 0}, // P1,Q1,x
+      {1, -1, 0, 0, -1, 0},  {1, 2, 0, -1, 0, 0},
+      {1, 0, 0, 1, 0, 0},    {1, 3, 0, 0, 0, 0},
+      {1, -2, 2, -1, 0, 0},  {1, -2, 0, 1, -1, 0},
+      {1, -3, 2, 0, 0, 0},   {1, 0, 0, -1, 0, 0},
+      {1, 1, 0, 0, -1, 0},   {1, 3, 0, 0, 1, 0},
+      {1, 1, -3, 0, 0, 1},   {1, -3, 0, 2, 0, 0},
+      {1, 1, 2, 0, 0, 0},    {1, 0, 0, 1, 1, 0},
+      {1, 2, 0, -1, 1, 0},   {1, 0, 2, -1, 0, 0},
+      {1, 2, -2, 1, 0, 0},   {1, 3, -2, 0, 0, 0},
+      {1, -1, 2, 0, 0, 0},   {1, 1, 1, 0, 0, -1},
+      {1, 1, -1, 0, 0, 1},   {1, 4, 0, -1, 0, 0},
+      {1, -4, 2, 1, 0, 0},   {1, 0, -2, 1, 0, 0},
+      {1, -2, 2, -1, -1, 0}, {1, 3, 0, -2, 0, 0},
+      {1, -1, 0, 2, 0, 0},   {1, -1, 0, 0, -2, 0},
+      {1, 3, 0, 0, 2, 0},    {1, -3, 2, 0, -1, 0},
+      {1, 4, 0, -1, 1, 0},   {1, 0, 0, -1, -1, 0},
+      {1, 1, -2, 0, -1, 0},  {1, -3, 0, 2, -1, 0},
+      {1, 1, 0, 0, 2, 0},    {1, 1, -1, 0, 0, -1},
+      {1, -1, -1, 0, 0, 1},  {1, 0, 2, -1, 1, 0},
+      {1, -1, 1, 0, 0, -1},  {1, -1, -2, 2, 0, 0},
+      {1, 2, -2, 1, 1, 0},   {1, -4, 0, 3, 0, 0},
+      {1, -1, 2, 0, 1, 0},   {1, 3, -2, 0, 1, 0},
+      {1, 2, 0, -1, -1, 0},  {1, 0, 0, 1, -1, 0},
+      {1, -2, 2, 1, 0, 0},   {1, 4, -2, -1, 0, 0},
+      {1, -3, 3, 0, 0, -1},  {1, -2, 1, 1, 0, -1},
+      {1, -2, 3, -1, 0, -1}, {1, 0, -2, 1, -1, 0},
+      {1, -2, -1, 1, 0, 1},  {1, 4, -2, 1, 0, 0},
+      {1, -4, 4, -1, 0, 0},  {1, -4, 2, 1, -1, 0},
+      {1, 5, -2, 0, 0, 0},   {1, 3, 0, -2, 1, 0},
+      {1, -5, 2, 2, 0, 0},   {1, 2, 0, 1, 0, 0},
+      {1, 1, 3, 0, 0, -1},   {1, -2, 0, 1, -2, 0},
+      {1, 4, 0, -1, 2, 0},   {1, 1, -4, 0, 0, 2},
+      {1, 5, 0, -2, 0, 0},   {1, -1, 0, 2, 1, 0},
+      {1, -2, 1, 0, 0, 0},   {1, 4, -2, 1, 1, 0},
+      {1, -3, 4, -2, 0, 0},  {1, -1, 3, 0, 0, -1},
+      {1, 3, -3, 0, 0, 1},   {1, 5, -2, 0, 1, 0},
+      {1, 1, 2, 0, 1, 0},    {1, 2, 0, 1, 1, 0},
+      {1, -5, 4, 0, 0, 0},   {1, -2, 0, -1, -2, 0},
+      {1, 5, 0, -2, 1, 0},   {1, 1, 2, -2, 0, 0},
+      {1, 1, -2, 2, 0, 0},   {1, -2, 2, 1, 1, 0},
+      {1, 0, 3, -1, 0, -1},  {1, 2, -3, 1, 0, 1},
+      {1, -2, -2, 3, 0, 0},  {1, -1, 2, -2, 0, 0},
+      {1, -4, 3, 1, 0, -1},  {1, -4, 0, 3, -1, 0},
+      {1, -1, -2, 2, -1, 0}, {1, -2, 0, 3, 0, 0},
+      {1, 4, 0, -3, 0, 0},   {1, 0, 1, 1, 0, -1},
+      {1, 2, -1, -1, 0, 1},  {1, 2, -2, 1, -1, 0},
+      {1, 0, 0, -1, -2, 0},  {1, 2, 0, 1, 2, 0},
+      {1, 2, -2, -1, -1, 0}, {1, 0, 0, 1, 2, 0},
+      {1, 0, 1, 0, 0, 0},    {1, 2, -1, 0, 0, 0},
+      {1, 0, 2, -1, -1, 0},  {1, -1, -2, 0, -2, 0},
+      {1, -3, 1, 0, 0, 1},   {1, 3, -2, 0, -1, 0},
+      {1, -1, -1, 0, -1, 1}, {1, 4, -2, -1, 1, 0},
+      {1, 2, 1, -1, 0, -1},  {1, 0, -1, 1, 0, 1},
+      {1, -2, 4, -1, 0, 0},  {1, 4, -4, 1, 0, 0},
+      {1, -3, 1, 2, 0, -1},  {1, -3, 3, 0, -1, -1},
+      {1, 1, 2, 0, 2, 0},    {1, 1, -2, 0, -2, 0},
+      {1, 3, 0, 0, 3, 0},    {1, -1, 2, 0, -1, 0},
+      {1, -2, 1, -1, 0, 1},  {1, 0, -3, 1, 0, 1},
+      {1, -3, -1, 2, 0, 1},  {1, 2, 0, -1, 2, 0},
+      {1, 6, -2, -1, 0, 0},  {1, 2, 2, -1, 0, 0},
+      {1, -1, 1, 0, -1, -1}, {1, -2, 3, -1, -1, -1},
+      {1, -1, 0, 0, 0, 2},   {1, -5, 0, 4, 0, 0},
+      {1, 1, 0, 0, 0, -2},   {1, -2, 1, 1, -1, -1},
+      {1, 1, -1, 0, 1, 1},   {1, 1, 2, 0, 0, -2},
+      {1, -3, 1, 1, 0, 0},   {1, -4, 4, -1, -1, 0},
+      {1, 1, 0, -2, -1, 0},  {1, -2, -1, 1, -1, 1},
+      {1, -3, 2, 2, 0, 0},   {1, 5, -2, -2, 0, 0},
+      {1, 3, -4, 2, 0, 0},   {1, 1, -2, 0, 0, 2},
+      {1, -1, 4, -2, 0, 0},  {1, 2, 2, -1, 1, 0},
+      {1, -5, 2, 2, -1, 0},  {1, 1, -3, 0, -1, 1},
+      {1, 1, 1, 0, 1, -1},   {1, 6, -2, -1, 1, 0},
+      {1, -2, 2, -1, -2, 0}, {1, 4, -2, 1, 2, 0},
+      {1, -6, 4, 1, 0, 0},   {1, 5, -4, 0, 0, 0},
+      {1, -3, 4, 0, 0, 0},   {1, 1, 2, -2, 1, 0},
+      {1, -2, 1, 0, -1, 0},  {0, 2, 0, 0, 0, 0}, // x,x,Mf
+      {0, 1, 0, -1, 0, 0},   {0, 0, 2, 0, 0, 0},
+      {0, 0, 0, 0, 1, 0}, // Mm,SSa
+      {0, 2, 0, 0, 1, 0},    {0, 3, 0, -1, 0, 0},
+      {0, 1, -2, 1, 0, 0},   {0, 2, -2, 0, 0, 0},
+      {0, 3, 0, -1, 1, 0},   {0, 0, 1, 0, 0, -1},
+      {0, 2, 0, -2, 0, 0},   {0, 2, 0, 0, 2, 0},
+      {0, 3, -2, 1, 0, 0},   {0, 1, 0, -1, -1, 0},
+      {0, 1, 0, -1, 1, 0},   {0, 4, -2, 0, 0, 0},
+      {0, 1, 0, 1, 0, 0},    {0, 0, 3, 0, 0, -1},
+      {0, 4, 0, -2, 0, 0},   {0, 3, -2, 1, 1, 0},
+      {0, 3, -2, -1, 0, 0},  {0, 4, -2, 0, 1, 0},
+      {0, 0, 2, 0, 1, 0},    {0, 1, 0, 1, 1, 0},
+      {0, 4, 0, -2, 1, 0},   {0, 3, 0, -1, 2, 0},
+      {0, 5, -2, -1, 0, 0},  {0, 1, 2, -1, 0, 0},
+      {0, 1, -2, 1, -1, 0},  {0, 1, -2, 1, 1, 0},
+      {0, 2, -2, 0, -1, 0},  {0, 2, -3, 0, 0, 1},
+      {0, 2, -2, 0, 1, 0},   {0, 0, 2, -2, 0, 0},
+      {0, 1, -3, 1, 0, 1},   {0, 0, 0, 0, 2, 0},
+      {0, 0, 1, 0, 0, 1},    {0, 1, 2, -1, 1, 0},
+      {0, 3, 0, -3, 0, 0},   {0, 2, 1, 0, 0, -1},
+      {0, 1, -1, -1, 0, 1},  {0, 1, 0, 1, 2, 0},
+      {0, 5, -2, -1, 1, 0},  {0, 2, -1, 0, 0, 1},
+      {0, 2, 2, -2, 0, 0},   {0, 1, -1, 0, 0, 0},
+      {0, 5, 0, -3, 0, 0},   {0, 2, 0, -2, 1, 0},
+      {0, 1, 1, -1, 0, -1},  {0, 3, -4, 1, 0, 0},
+      {0, 0, 2, 0, 2, 0},    {0, 2, 0, -2, -1, 0},
+      {0, 4, -3, 0, 0, 1},   {0, 3, -1, -1, 0, 1},
+      {0, 0, 2, 0, 0, -2},   {0, 3, -3, 1, 0, 1},
+      {0, 2, -4, 2, 0, 0},   {0, 4, -2, -2, 0, 0},
+      {0, 3, 1, -1, 0, -1},  {0, 5, -4, 1, 0, 0},
+      {0, 3, -2, -1, -1, 0}, {0, 3, -2, 1, 2, 0},
+      {0, 4, -4, 0, 0, 0},   {0, 6, -2, -2, 0, 0},
+      {0, 5, 0, -3, 1, 0},   {0, 4, -2, 0, 2, 0},
+      {0, 2, 2, -2, 1, 0},   {0, 0, 4, 0, 0, -2},
+      {0, 3, -1, 0, 0, 0},   {0, 3, -3, -1, 0, 1},
+      {0, 4, 0, -2, 2, 0},   {0, 1, -2, -1, -1, 0},
+      {0, 2, -1, 0, 0, -1},  {0, 4, -4, 2, 0, 0},
+      {0, 2, 1, 0, 1, -1},   {0, 3, -2, -1, 1, 0},
+      {0, 4, -3, 0, 1, 1},   {0, 2, 0, 0, 3, 0},
+      {0, 6, -4, 0, 0, 0},
+   };
+
    //---------------------------------------------------------------------------------
    int OceanLoadTides::deriveTides(const NVector SchInd[], const double amp[],
                                    const double phs[], const double Dood[],
@@ -661,238 +1017,6 @@ namespace gnsstk
                                    double phsDer[], double freqDer[],
                                    const int Nin)
    {
-         // indexes for std tides: M2, S2, N2, K2, K1,  O1,  P1,  Q1,  Mf,  Mm, Ssa
-      static const int stdindex[] = {0,   1,   2,   3,   109, 110,
-                                     111, 112, 263, 264, 265};
-
-      static const double DerAmp[] = {
-         .632208,  .294107,  .121046,  .079915,  .023818,  -.023589, .022994,
-         .019333,  -.017871, .017192,  .016018,  .004671,  -.004662, -.004519,
-         .004470,  .004467,  .002589,  -.002455, -.002172, .001972,  .001947,
-         .001914,  -.001898, .001802,  .001304,  .001170,  .001130,  .001061,
-         -.001022, -.001017, .001014,  .000901,  -.000857, .000855,  .000855,
-         .000772,  .000741,  .000741,  -.000721, .000698,  .000658,  .000654,
-         -.000653, .000633,  .000626,  -.000598, .000590,  .000544,  .000479,
-         -.000464, .000413,  -.000390, .000373,  .000366,  .000366,  -.000360,
-         -.000355, .000354,  .000329,  .000328,  .000319,  .000302,  .000279,
-         -.000274, -.000272, .000248,  -.000225, .000224,  -.000223, -.000216,
-         .000211,  .000209,  .000194,  .000185,  -.000174, -.000171, .000159,
-         .000131,  .000127,  .000120,  .000118,  .000117,  .000108,  .000107,
-         .000105,  -.000102, .000102,  .000099,  -.000096, .000095,  -.000089,
-         -.000085, -.000084, -.000081, -.000077, -.000072, -.000067, .000066,
-         .000064,  .000063,  .000063,  .000063,  .000062,  .000062,  -.000060,
-         .000056,  .000053,  .000051,  .000050,  .368645,  -.262232, -.121995,
-         -.050208, .050031,  -.049470, .020620,  .020613,  .011279,  -.009530,
-         -.009469, -.008012, .007414,  -.007300, .007227,  -.007131, -.006644,
-         .005249,  .004137,  .004087,  .003944,  .003943,  .003420,  .003418,
-         .002885,  .002884,  .002160,  -.001936, .001934,  -.001798, .001690,
-         .001689,  .001516,  .001514,  -.001511, .001383,  .001372,  .001371,
-         -.001253, -.001075, .001020,  .000901,  .000865,  -.000794, .000788,
-         .000782,  -.000747, -.000745, .000670,  -.000603, -.000597, .000542,
-         .000542,  -.000541, -.000469, -.000440, .000438,  .000422,  .000410,
-         -.000374, -.000365, .000345,  .000335,  -.000321, -.000319, .000307,
-         .000291,  .000290,  -.000289, .000286,  .000275,  .000271,  .000263,
-         -.000245, .000225,  .000225,  .000221,  -.000202, -.000200, -.000199,
-         .000192,  .000183,  .000183,  .000183,  -.000170, .000169,  .000168,
-         .000162,  .000149,  -.000147, -.000141, .000138,  .000136,  .000136,
-         .000127,  .000127,  -.000126, -.000121, -.000121, .000117,  -.000116,
-         -.000114, -.000114, -.000114, .000114,  .000113,  .000109,  .000108,
-         .000106,  -.000106, -.000106, .000105,  .000104,  -.000103, -.000100,
-         -.000100, -.000100, .000099,  -.000098, .000093,  .000093,  .000090,
-         -.000088, .000083,  -.000083, -.000082, -.000081, -.000079, -.000077,
-         -.000075, -.000075, -.000075, .000071,  .000071,  -.000071, .000068,
-         .000068,  .000065,  .000065,  .000064,  .000064,  .000064,  -.000064,
-         -.000060, .000056,  .000056,  .000053,  .000053,  .000053,  -.000053,
-         .000053,  .000053,  .000052,  .000050,  -.066607, -.035184, -.030988,
-         .027929,  -.027616, -.012753, -.006728, -.005837, -.005286, -.004921,
-         -.002884, -.002583, -.002422, .002310,  .002283,  -.002037, .001883,
-         -.001811, -.001687, -.001004, -.000925, -.000844, .000766,  .000766,
-         -.000700, -.000495, -.000492, .000491,  .000483,  .000437,  -.000416,
-         -.000384, .000374,  -.000312, -.000288, -.000273, .000259,  .000245,
-         -.000232, .000229,  -.000216, .000206,  -.000204, -.000202, .000200,
-         .000195,  -.000190, .000187,  .000180,  -.000179, .000170,  .000153,
-         -.000137, -.000119, -.000119, -.000112, -.000110, -.000110, .000107,
-         -.000095, -.000095, -.000091, -.000090, -.000081, -.000079, -.000079,
-         .000077,  -.000073, .000069,  -.000067, -.000066, .000065,  .000064,
-         -.000062, .000060,  .000059,  -.000056, .000055,  -.000051};
-
-      static const NVector DerInd[] = {
-         {2, 0, 0, 0, 0, 0},    {2, 2, -2, 0, 0, 0},
-         {2, -1, 0, 1, 0, 0}, // M2,S2,N2
-         {2, 2, 0, 0, 0, 0},    {2, 2, 0, 0, 1, 0},
-         {2, 0, 0, 0, -1, 0}, // K2,x,x
-         {2, -1, 2, -1, 0, 0},  {2, -2, 2, 0, 0, 0},
-         {2, 1, 0, -1, 0, 0},   {2, 2, -3, 0, 0, 1},
-         {2, -2, 0, 2, 0, 0},   {2, -3, 2, 1, 0, 0},
-         {2, 1, -2, 1, 0, 0},   {2, -1, 0, 1, -1, 0},
-         {2, 3, 0, -1, 0, 0},   {2, 1, 0, 1, 0, 0},
-         {2, 2, 0, 0, 2, 0},    {2, 2, -1, 0, 0, -1},
-         {2, 0, -1, 0, 0, 1},   {2, 1, 0, 1, 1, 0},
-         {2, 3, 0, -1, 1, 0},   {2, 0, 1, 0, 0, -1},
-         {2, 0, -2, 2, 0, 0},   {2, -3, 0, 3, 0, 0},
-         {2, -2, 3, 0, 0, -1},  {2, 4, 0, 0, 0, 0},
-         {2, -1, 1, 1, 0, -1},  {2, -1, 3, -1, 0, -1},
-         {2, 2, 0, 0, -1, 0},   {2, -1, -1, 1, 0, 1},
-         {2, 4, 0, 0, 1, 0},    {2, -3, 4, -1, 0, 0},
-         {2, -1, 2, -1, -1, 0}, {2, 3, -2, 1, 0, 0},
-         {2, 1, 2, -1, 0, 0},   {2, -4, 2, 2, 0, 0},
-         {2, 4, -2, 0, 0, 0},   {2, 0, 2, 0, 0, 0},
-         {2, -2, 2, 0, -1, 0},  {2, 2, -4, 0, 0, 2},
-         {2, 2, -2, 0, -1, 0},  {2, 1, 0, -1, -1, 0},
-         {2, -1, 1, 0, 0, 0},   {2, 2, -1, 0, 0, 1},
-         {2, 2, 1, 0, 0, -1},   {2, -2, 0, 2, -1, 0},
-         {2, -2, 4, -2, 0, 0},  {2, 2, 2, 0, 0, 0},
-         {2, -4, 4, 0, 0, 0},   {2, -1, 0, -1, -2, 0},
-         {2, 1, 2, -1, 1, 0},   {2, -1, -2, 3, 0, 0},
-         {2, 3, -2, 1, 1, 0},   {2, 4, 0, -2, 0, 0},
-         {2, 0, 0, 2, 0, 0},    {2, 0, 2, -2, 0, 0},
-         {2, 0, 2, 0, 1, 0},    {2, -3, 3, 1, 0, -1},
-         {2, 0, 0, 0, -2, 0},   {2, 4, 0, 0, 2, 0},
-         {2, 4, -2, 0, 1, 0},   {2, 0, 0, 0, 0, 2},
-         {2, 1, 0, 1, 2, 0},    {2, 0, -2, 0, -2, 0},
-         {2, -2, 1, 0, 0, 1},   {2, -2, 1, 2, 0, -1},
-         {2, -1, 1, -1, 0, 1},  {2, 5, 0, -1, 0, 0},
-         {2, 1, -3, 1, 0, 1},   {2, -2, -1, 2, 0, 1},
-         {2, 3, 0, -1, 2, 0},   {2, 1, -2, 1, -1, 0},
-         {2, 5, 0, -1, 1, 0},   {2, -4, 0, 4, 0, 0},
-         {2, -3, 2, 1, -1, 0},  {2, -2, 1, 1, 0, 0},
-         {2, 4, 0, -2, 1, 0},   {2, 0, 0, 2, 1, 0},
-         {2, -5, 4, 1, 0, 0},   {2, 0, 2, 0, 2, 0},
-         {2, -1, 2, 1, 0, 0},   {2, 5, -2, -1, 0, 0},
-         {2, 1, -1, 0, 0, 0},   {2, 2, -2, 0, 0, 2},
-         {2, -5, 2, 3, 0, 0},   {2, -1, -2, 1, -2, 0},
-         {2, -3, 5, -1, 0, -1}, {2, -1, 0, 0, 0, 1},
-         {2, -2, 0, 0, -2, 0},  {2, 0, -1, 1, 0, 0},
-         {2, -3, 1, 1, 0, 1},   {2, 3, 0, -1, -1, 0},
-         {2, 1, 0, 1, -1, 0},   {2, -1, 2, 1, 1, 0},
-         {2, 0, -3, 2, 0, 1},   {2, 1, -1, -1, 0, 1},
-         {2, -3, 0, 3, -1, 0},  {2, 0, -2, 2, -1, 0},
-         {2, -4, 3, 2, 0, -1},  {2, -1, 0, 1, -2, 0},
-         {2, 5, 0, -1, 2, 0},   {2, -4, 5, 0, 0, -1},
-         {2, -2, 4, 0, 0, -2},  {2, -1, 0, 1, 0, 2},
-         {2, -2, -2, 4, 0, 0},  {2, 3, -2, -1, -1, 0},
-         {2, -2, 5, -2, 0, -1}, {2, 0, -1, 0, -1, 1},
-         {2, 5, -2, -1, 1, 0},  {1, 1, 0, 0, 0, 0},
-         {1, -1, 0, 0, 0, 0}, // x,K1,O1
-         {1, 1, -2, 0, 0, 0},   {1, -2, 0, 1, 0, 0},
-         {1, 1, 0, 0, 1, 0}, // P1,Q1,x
-         {1, -1, 0, 0, -1, 0},  {1, 2, 0, -1, 0, 0},
-         {1, 0, 0, 1, 0, 0},    {1, 3, 0, 0, 0, 0},
-         {1, -2, 2, -1, 0, 0},  {1, -2, 0, 1, -1, 0},
-         {1, -3, 2, 0, 0, 0},   {1, 0, 0, -1, 0, 0},
-         {1, 1, 0, 0, -1, 0},   {1, 3, 0, 0, 1, 0},
-         {1, 1, -3, 0, 0, 1},   {1, -3, 0, 2, 0, 0},
-         {1, 1, 2, 0, 0, 0},    {1, 0, 0, 1, 1, 0},
-         {1, 2, 0, -1, 1, 0},   {1, 0, 2, -1, 0, 0},
-         {1, 2, -2, 1, 0, 0},   {1, 3, -2, 0, 0, 0},
-         {1, -1, 2, 0, 0, 0},   {1, 1, 1, 0, 0, -1},
-         {1, 1, -1, 0, 0, 1},   {1, 4, 0, -1, 0, 0},
-         {1, -4, 2, 1, 0, 0},   {1, 0, -2, 1, 0, 0},
-         {1, -2, 2, -1, -1, 0}, {1, 3, 0, -2, 0, 0},
-         {1, -1, 0, 2, 0, 0},   {1, -1, 0, 0, -2, 0},
-         {1, 3, 0, 0, 2, 0},    {1, -3, 2, 0, -1, 0},
-         {1, 4, 0, -1, 1, 0},   {1, 0, 0, -1, -1, 0},
-         {1, 1, -2, 0, -1, 0},  {1, -3, 0, 2, -1, 0},
-         {1, 1, 0, 0, 2, 0},    {1, 1, -1, 0, 0, -1},
-         {1, -1, -1, 0, 0, 1},  {1, 0, 2, -1, 1, 0},
-         {1, -1, 1, 0, 0, -1},  {1, -1, -2, 2, 0, 0},
-         {1, 2, -2, 1, 1, 0},   {1, -4, 0, 3, 0, 0},
-         {1, -1, 2, 0, 1, 0},   {1, 3, -2, 0, 1, 0},
-         {1, 2, 0, -1, -1, 0},  {1, 0, 0, 1, -1, 0},
-         {1, -2, 2, 1, 0, 0},   {1, 4, -2, -1, 0, 0},
-         {1, -3, 3, 0, 0, -1},  {1, -2, 1, 1, 0, -1},
-         {1, -2, 3, -1, 0, -1}, {1, 0, -2, 1, -1, 0},
-         {1, -2, -1, 1, 0, 1},  {1, 4, -2, 1, 0, 0},
-         {1, -4, 4, -1, 0, 0},  {1, -4, 2, 1, -1, 0},
-         {1, 5, -2, 0, 0, 0},   {1, 3, 0, -2, 1, 0},
-         {1, -5, 2, 2, 0, 0},   {1, 2, 0, 1, 0, 0},
-         {1, 1, 3, 0, 0, -1},   {1, -2, 0, 1, -2, 0},
-         {1, 4, 0, -1, 2, 0},   {1, 1, -4, 0, 0, 2},
-         {1, 5, 0, -2, 0, 0},   {1, -1, 0, 2, 1, 0},
-         {1, -2, 1, 0, 0, 0},   {1, 4, -2, 1, 1, 0},
-         {1, -3, 4, -2, 0, 0},  {1, -1, 3, 0, 0, -1},
-         {1, 3, -3, 0, 0, 1},   {1, 5, -2, 0, 1, 0},
-         {1, 1, 2, 0, 1, 0},    {1, 2, 0, 1, 1, 0},
-         {1, -5, 4, 0, 0, 0},   {1, -2, 0, -1, -2, 0},
-         {1, 5, 0, -2, 1, 0},   {1, 1, 2, -2, 0, 0},
-         {1, 1, -2, 2, 0, 0},   {1, -2, 2, 1, 1, 0},
-         {1, 0, 3, -1, 0, -1},  {1, 2, -3, 1, 0, 1},
-         {1, -2, -2, 3, 0, 0},  {1, -1, 2, -2, 0, 0},
-         {1, -4, 3, 1, 0, -1},  {1, -4, 0, 3, -1, 0},
-         {1, -1, -2, 2, -1, 0}, {1, -2, 0, 3, 0, 0},
-         {1, 4, 0, -3, 0, 0},   {1, 0, 1, 1, 0, -1},
-         {1, 2, -1, -1, 0, 1},  {1, 2, -2, 1, -1, 0},
-         {1, 0, 0, -1, -2, 0},  {1, 2, 0, 1, 2, 0},
-         {1, 2, -2, -1, -1, 0}, {1, 0, 0, 1, 2, 0},
-         {1, 0, 1, 0, 0, 0},    {1, 2, -1, 0, 0, 0},
-         {1, 0, 2, -1, -1, 0},  {1, -1, -2, 0, -2, 0},
-         {1, -3, 1, 0, 0, 1},   {1, 3, -2, 0, -1, 0},
-         {1, -1, -1, 0, -1, 1}, {1, 4, -2, -1, 1, 0},
-         {1, 2, 1, -1, 0, -1},  {1, 0, -1, 1, 0, 1},
-         {1, -2, 4, -1, 0, 0},  {1, 4, -4, 1, 0, 0},
-         {1, -3, 1, 2, 0, -1},  {1, -3, 3, 0, -1, -1},
-         {1, 1, 2, 0, 2, 0},    {1, 1, -2, 0, -2, 0},
-         {1, 3, 0, 0, 3, 0},    {1, -1, 2, 0, -1, 0},
-         {1, -2, 1, -1, 0, 1},  {1, 0, -3, 1, 0, 1},
-         {1, -3, -1, 2, 0, 1},  {1, 2, 0, -1, 2, 0},
-         {1, 6, -2, -1, 0, 0},  {1, 2, 2, -1, 0, 0},
-         {1, -1, 1, 0, -1, -1}, {1, -2, 3, -1, -1, -1},
-         {1, -1, 0, 0, 0, 2},   {1, -5, 0, 4, 0, 0},
-         {1, 1, 0, 0, 0, -2},   {1, -2, 1, 1, -1, -1},
-         {1, 1, -1, 0, 1, 1},   {1, 1, 2, 0, 0, -2},
-         {1, -3, 1, 1, 0, 0},   {1, -4, 4, -1, -1, 0},
-         {1, 1, 0, -2, -1, 0},  {1, -2, -1, 1, -1, 1},
-         {1, -3, 2, 2, 0, 0},   {1, 5, -2, -2, 0, 0},
-         {1, 3, -4, 2, 0, 0},   {1, 1, -2, 0, 0, 2},
-         {1, -1, 4, -2, 0, 0},  {1, 2, 2, -1, 1, 0},
-         {1, -5, 2, 2, -1, 0},  {1, 1, -3, 0, -1, 1},
-         {1, 1, 1, 0, 1, -1},   {1, 6, -2, -1, 1, 0},
-         {1, -2, 2, -1, -2, 0}, {1, 4, -2, 1, 2, 0},
-         {1, -6, 4, 1, 0, 0},   {1, 5, -4, 0, 0, 0},
-         {1, -3, 4, 0, 0, 0},   {1, 1, 2, -2, 1, 0},
-         {1, -2, 1, 0, -1, 0},  {0, 2, 0, 0, 0, 0}, // x,x,Mf
-         {0, 1, 0, -1, 0, 0},   {0, 0, 2, 0, 0, 0},
-         {0, 0, 0, 0, 1, 0}, // Mm,SSa
-         {0, 2, 0, 0, 1, 0},    {0, 3, 0, -1, 0, 0},
-         {0, 1, -2, 1, 0, 0},   {0, 2, -2, 0, 0, 0},
-         {0, 3, 0, -1, 1, 0},   {0, 0, 1, 0, 0, -1},
-         {0, 2, 0, -2, 0, 0},   {0, 2, 0, 0, 2, 0},
-         {0, 3, -2, 1, 0, 0},   {0, 1, 0, -1, -1, 0},
-         {0, 1, 0, -1, 1, 0},   {0, 4, -2, 0, 0, 0},
-         {0, 1, 0, 1, 0, 0},    {0, 0, 3, 0, 0, -1},
-         {0, 4, 0, -2, 0, 0},   {0, 3, -2, 1, 1, 0},
-         {0, 3, -2, -1, 0, 0},  {0, 4, -2, 0, 1, 0},
-         {0, 0, 2, 0, 1, 0},    {0, 1, 0, 1, 1, 0},
-         {0, 4, 0, -2, 1, 0},   {0, 3, 0, -1, 2, 0},
-         {0, 5, -2, -1, 0, 0},  {0, 1, 2, -1, 0, 0},
-         {0, 1, -2, 1, -1, 0},  {0, 1, -2, 1, 1, 0},
-         {0, 2, -2, 0, -1, 0},  {0, 2, -3, 0, 0, 1},
-         {0, 2, -2, 0, 1, 0},   {0, 0, 2, -2, 0, 0},
-         {0, 1, -3, 1, 0, 1},   {0, 0, 0, 0, 2, 0},
-         {0, 0, 1, 0, 0, 1},    {0, 1, 2, -1, 1, 0},
-         {0, 3, 0, -3, 0, 0},   {0, 2, 1, 0, 0, -1},
-         {0, 1, -1, -1, 0, 1},  {0, 1, 0, 1, 2, 0},
-         {0, 5, -2, -1, 1, 0},  {0, 2, -1, 0, 0, 1},
-         {0, 2, 2, -2, 0, 0},   {0, 1, -1, 0, 0, 0},
-         {0, 5, 0, -3, 0, 0},   {0, 2, 0, -2, 1, 0},
-         {0, 1, 1, -1, 0, -1},  {0, 3, -4, 1, 0, 0},
-         {0, 0, 2, 0, 2, 0},    {0, 2, 0, -2, -1, 0},
-         {0, 4, -3, 0, 0, 1},   {0, 3, -1, -1, 0, 1},
-         {0, 0, 2, 0, 0, -2},   {0, 3, -3, 1, 0, 1},
-         {0, 2, -4, 2, 0, 0},   {0, 4, -2, -2, 0, 0},
-         {0, 3, 1, -1, 0, -1},  {0, 5, -4, 1, 0, 0},
-         {0, 3, -2, -1, -1, 0}, {0, 3, -2, 1, 2, 0},
-         {0, 4, -4, 0, 0, 0},   {0, 6, -2, -2, 0, 0},
-         {0, 5, 0, -3, 1, 0},   {0, 4, -2, 0, 2, 0},
-         {0, 2, 2, -2, 1, 0},   {0, 0, 4, 0, 0, -2},
-         {0, 3, -1, 0, 0, 0},   {0, 3, -3, -1, 0, 1},
-         {0, 4, 0, -2, 2, 0},   {0, 1, -2, -1, -1, 0},
-         {0, 2, -1, 0, 0, -1},  {0, 4, -4, 2, 0, 0},
-         {0, 2, 1, 0, 1, -1},   {0, 3, -2, -1, 1, 0},
-         {0, 4, -3, 0, 1, 1},   {0, 2, 0, 0, 3, 0},
-         {0, 6, -4, 0, 0, 0},
-      };
-
       if ((int)(sizeof(DerAmp) / sizeof(double)) != NDER ||
           (int)(sizeof(DerInd) / sizeof(NVector)) != NDER)
       {
@@ -145,6 +145,36 @@ namespace gnsstk
          */
       Triple computeDisplacement(std::string site, EphTime t);
 
+         /**
+          Return the harmonic expansion of the displacement of the given site:
+          6*numberOfHarmonics() coefficients, in blocks of numberOfHarmonics()
+          for North-cos, North-sin, East-cos, East-sin, Up-cos and Up-sin, such
+          that the North component at time t is
+             sum_j (Ncos[j]*cosArg[j] + Nsin[j]*sinArg[j])
+          where cosArg and sinArg come from tideArguments(t). This is
+          time-independent, and so may be computed once per site; together
+          with tideArguments() it reproduces computeDisplacement() while
+          sharing the expensive per-epoch work among many sites.
+          @param site  string Input name of the site.
+          @param harm  vector<double> Output coefficients in meters.
+          @throw Exception if the site has not been initialized.
+         */
+      void getHarmonics(const std::string& site, std::vector<double>& harm);
+
+         /**
+          Compute the cosine and sine of the astronomical argument of each of
+          the derived tides at the given time, for use with getHarmonics().
+          @param t       EphTime Input time of interest.
+          @param cosArg  vector<double> Output cosines, numberOfHarmonics() long.
+          @param sinArg  vector<double> Output sines, numberOfHarmonics() long.
+          @throw Exception if the time system is unknown.
+         */
+      static void tideArguments(const EphTime& t, std::vector<double>& cosArg,
+                                std::vector<double>& sinArg);
+
+         /// Return the number of derived tides used in the harmonic expansion.
+      static int numberOfHarmonics() { return NDER; }
+
          /**
           Return the recorded latitude, longitude and ht(=0) for the given site.
           Return value of (0.0,0.0,0.0) probably means the position was not
@@ -193,6 +223,24 @@ namespace gnsstk
          /// Number of derived tides computed by deriveTides()
       static const int NDER;
 
+         /// Indexes in DerInd of the standard tides
+      static const int stdindex[];
+
+         /// Amplitudes of the derived tides
+      static const double DerAmp[];
+
+         /// Cartwright-Tayler numbers of the derived tides
+      static const NVector DerInd[];
+
+         /**
+          Compute the Doodson arguments and their frequencies at the given time.
+          @param t         EphTime Input time of interest.
+          @param Dood      array of 6 Doodson arguments at time t in degrees
+          @param freqDood  array of 6 Doodson frequencies at time in cycles/day
+         */
+      static void doodsonArguments(const EphTime& t, double Dood[6],
+                                   double freqDood[6]);
+
          /**
           Derive the 342 tides from the standard 11 tides using cubic spline
           interpolation. Called by computeDisplacements()
@@ -468,7 +468,7 @@ int Robust::RobustPolyFit(double *xd, const double *td, int nd, int N,
          ResCopy = Res = D - P * Coeff;
 #endif
 
-            // compute median and MAD. NB Median() will sort the vector...
+            // compute median and MAD. NB Median() will reorder the vector...
          mad = MedianAbsoluteDeviation(&(ResCopy[0]), ResCopy.size(), median);
 
             // recompute weights
@@ -48,11 +48,16 @@
 
 //------------------------------------------------------------------------------------
 // system includes
+#include <algorithm>
 #include <cmath>
+#include <exception>
 #include <string>
+#include <utility>
+#include <vector>
 
 // GNSSTk
 #include "Exception.hpp"
+#include "parallel_for.hpp"
 
 namespace gnsstk
 {
@@ -127,8 +132,27 @@ namespace gnsstk
    } // end insert sort
 
       /**
-       Quick sort in memory, with insert sort for small arrays.
-       operator>() and operator<() must be defined for T,
+       Adapt a Qsort_compare-style comparison function to the strict weak
+       ordering used by the standard algorithms.
+      */
+   template <typename T> class QsortLess
+   {
+   public:
+         /// constructor, from the comparison function
+      QsortLess(int (*c)(const T& , const T& )) : comp(c) {}
+         /// return true if a sorts before b
+      bool operator()(const T& a, const T& b) const { return comp(a, b) < 0; }
+         /// return true if a.first sorts before b.first
+      template <typename S>
+      bool operator()(const std::pair<T,S>& a, const std::pair<T,S>& b) const
+      { return comp(a.first, b.first) < 0; }
+   private:
+      int (*comp)(const T& , const T& ); ///< the comparison function
+   };
+
+      /**
+       Sort in memory, using std::sort (introsort, O(n log n) in the worst
+       case). operator>() and operator<() must be defined for T,
        and a user comparison function comp(T,T) may be passed to
        override the default Qsort_compare().
        @param sa is the array of type T to be sorted.
@@ -139,51 +163,17 @@ namespace gnsstk
    void QSort(T *sa, int na,
               int (*comp)(const T& , const T& ) = gnsstk::Qsort_compare)
    {
-      int i, j, nr;
-      T stemp, spart;
-      while (1)
+      if (!sa || na < 2)
       {
-         if (na < 8)
-         { // use insert sort for small arrays
-            insert(sa, na, comp);
-            return;
-         }
-         spart = sa[na / 2]; // pick middle element as pivot
-         i     = -1;
-         j     = na;
-         while (1)
-         {
-            do
-            { // find first element to move right
-               i = i + 1;
-            } while (comp(sa[i], spart) < 0);
-            do
-            { // find first element to move left
-               j = j - 1;
-            } while (comp(sa[j], spart) > 0);
-            // if the boundaries have met,
-            // through paritioning,
-            if (i >= j)
-            {
-               break;
-            }
-            // swap i and j elements
-            stemp = sa[i];
-            sa[i] = sa[j];
-            sa[j] = stemp;
-         }
-         nr = na - i;
-         if (i < (na / 2))
-         {                      // now sort each partition
-            QSort(sa, i, comp); // sort left side
-            sa = &sa[i];        // sort right side here
-            na = nr;            // memsort(&(sa[i]),nr,comp);
-         }
-         else
-         {
-            QSort(&(sa[i]), nr, comp); // sort right side
-            na = i;
-         }
+         return;
+      }
+      if (comp == &gnsstk::Qsort_compare<T>)
+      {
+         std::sort(sa, sa + na);
+      }
+      else
+      {
+         std::sort(sa, sa + na, QsortLess<T>(comp));
       }
    } // end QSort
 
@@ -218,7 +208,8 @@ namespace gnsstk
    } // end insert sort
 
       /**
-       Quick sort of one vector, keeping another parallel.
+       Sort of one vector, keeping another parallel.
+       The pairs are sorted together, rather than swapping in two arrays.
        See the single-vector version of QSort.
        @param sa is the array of type T to be sorted.
        @param pa is the array of type S to be kept parallel to the first.
@@ -229,56 +220,22 @@ namespace gnsstk
    void QSort(T *sa, S *pa, int na,
               int (*comp)(const T& , const T& ) = gnsstk::Qsort_compare)
    {
-      int i, j, nr;
-      T stemp, spart;
-      S ptemp;
-      while (1)
+      if (!sa || !pa || na < 2)
       {
-         if (na < 8)
-         { // use insert sort for small arrays
-            insert(sa, pa, na, comp);
-            return;
-         }
-         spart = sa[na / 2]; // pick middle element as pivot
-         i     = -1;
-         j     = na;
-         while (1)
-         {
-            do
-            { // find first element to move right
-               i = i + 1;
-            } while (comp(sa[i], spart) < 0);
-            do
-            { // find first element to move left
-               j = j - 1;
-            } while (comp(sa[j], spart) > 0);
-            // if the boundaries have met,
-            // through paritioning,
-            if (i >= j)
-            {
-               break;
-            }
-            // swap i and j elements
-            stemp = sa[i];
-            ptemp = pa[i];
-            sa[i] = sa[j];
-            pa[i] = pa[j];
-            sa[j] = stemp;
-            pa[j] = ptemp;
-         }
-         nr = na - i;
-         if (i < (na / 2))
-         {                          // now sort each partition
-            QSort(sa, pa, i, comp); // sort left side
-            sa = &sa[i];            // sort right side here
-            pa = &pa[i];
-            na = nr; // memsort(&(sa[i]),nr,comp);
-         }
-         else
-         {
-            QSort(&(sa[i]), &(pa[i]), nr, comp); // sort right side
-            na = i;
-         }
+         return;
+      }
+      int i;
+      std::vector< std::pair<T,S> > both(na);
+      for (i = 0; i < na; i++)
+      {
+         both[i].first  = sa[i];
+         both[i].second = pa[i];
+      }
+      std::sort(both.begin(), both.end(), QsortLess<T>(comp));
+      for (i = 0; i < na; i++)
+      {
+         sa[i] = both[i].first;
+         pa[i] = both[i].second;
       }
    } // end QSort
 
@@ -349,12 +306,32 @@ namespace gnsstk
       /// Robust statistics.
    namespace Robust
    {
+      /** Compute the median of an array of length nd by selection
+       * (std::nth_element), which is O(nd) rather than the O(nd log nd)
+       * of a sort. The array is reordered; there is no checking of input.
+       * @param xd         array of data, reordered on output.
+       * @param nd         length of array xd, > 0.
+       * @return median of the data in array xd.
+       */
+      template <typename T> T SelectMedian(T *xd, const int nd)
+      {
+         const int k(nd / 2);
+         std::nth_element(xd, xd + k, xd + nd);
+         if (nd % 2)
+         {
+            return xd[k];
+         }
+         // xd[0..k-1] are all <= xd[k]; the largest is the other middle value
+         return (*std::max_element(xd, xd + k) + xd[k]) / T(2);
+      }
+
       /** Compute median of an array of length nd;
-       * array xd is returned sorted, unless save_flag is true.
+       * array xd is returned reordered (but not sorted), unless save_flag
+       * is true. The median is found by selection, not by sorting.
        * @param xd         array of data.
        * @param nd         length of array xd.
        * @param save_flag if true (default) array xd will NOT be
-       *                      changed, otherwise it will be sorted.
+       *                      changed, otherwise it will be reordered.
        * @return median of the data in array xd.
        * @throw Exception
        */
@@ -368,45 +345,17 @@ namespace gnsstk
 
          try
          {
-            int i;
-            T med, *save = NULL;
-
-            if (save_flag)
-            {
-               save = new T[nd];
-               if (!save)
-               {
-                  Exception e("Could not allocate temporary array");
-                  GNSSTK_THROW(e);
-               }
-               for (i = 0; i < nd; i++)
-                  save[i] = xd[i];
-            }
-
-            QSort(xd, nd);
-
-            if (nd % 2)
-            {
-               med = xd[(nd + 1) / 2 - 1];
-            }
-            else
-            {
-               med = (xd[nd / 2 - 1] + xd[nd / 2]) / T(2);
-            }
-
-            // restore original data from temporary
             if (save_flag)
             {
-               for (i = 0; i < nd; i++)
-                  xd[i] = save[i];
-               delete[] save;
+               std::vector<T> work(xd, xd + nd);
+               return SelectMedian(&work[0], nd);
             }
-
-            return med;
+            return SelectMedian(xd, nd);
          }
-         catch (Exception &e)
+         catch (std::exception& e)
          {
-            GNSSTK_RETHROW(e);
+            Exception E("std except: " + std::string(e.what()));
+            GNSSTK_THROW(E);
          }
 
       } // end Median
@@ -454,6 +403,7 @@ namespace gnsstk
 
       /** Compute the median absolute deviation of a double array
        * of length nd, as well as the median (M = Median(xd,nd));
+       * both are found by selection, not by sorting.
        * @note this routine will trash the array xd unless
        * save_flag is true (default).
        * @param xd array of data (input).
@@ -466,51 +416,37 @@ namespace gnsstk
       template <typename T>
       T MedianAbsoluteDeviation(T *xd, int nd, T& M, bool save_flag = true)
       {
-         int i;
-         T mad, *save;
-
          if (!xd || nd < 2)
          {
             Exception e("Invalid input");
             GNSSTK_THROW(e);
          }
 
-         // store data in a temporary array
-         if (save_flag)
+         try
          {
-            save = new T[nd];
-            if (!save)
+            // work in a copy if the data is to be saved; order doesn't matter
+            std::vector<T> work;
+            T *wd(xd);
+            if (save_flag)
             {
-               Exception e("Could not allocate temporary array");
-               GNSSTK_THROW(e);
+               work.assign(xd, xd + nd);
+               wd = &work[0];
             }
-            for (i = 0; i < nd; i++)
-               save[i] = xd[i];
-         }
 
-         // get the median (don't care if xd gets sorted...)
-         M = Median(xd, nd, false);
+            M = SelectMedian(wd, nd);
 
-         // compute xd=abs(xd-M)
-         for (i = 0; i < nd; i++)
-            xd[i] = ABSOLUTE(xd[i] - M);
+            // compute abs(xd-M), and normalize its median to get mad
+            for (int i = 0; i < nd; i++)
+               wd[i] = ABSOLUTE(wd[i] - M);
 
-         // sort xd in ascending order
-         QSort(xd, nd);
-
-         // find median and normalize to get mad
-         mad = Median(xd, nd, false) / T(RobustTuningE);
-
-         // restore original data from temporary
-         if (save_flag)
+            return SelectMedian(wd, nd) / T(RobustTuningE);
+         }
+         catch (std::exception& e)
          {
-            for (i = 0; i < nd; i++)
-               xd[i] = save[i];
-            delete[] save;
+            Exception E("std except: " + std::string(e.what()));
+            GNSSTK_THROW(E);
          }
 
-         return mad;
-
       } // end MedianAbsoluteDeviation
 
       /** Compute the median absolute deviation of a double array
@@ -522,6 +458,289 @@ namespace gnsstk
          return MedianAbsoluteDeviation(xd, nd, M, save_flag);
       }
 
+      /** Compute the weighted median of an array of length nd, with
+       * weights wd: the value at which the cumulative weight of the sorted
+       * data reaches half the total weight. If it reaches exactly half
+       * between two values, their average is returned, so that with equal
+       * weights this is Median(); data with zero weight are skipped in
+       * choosing those two values. The value is found by weighted selection
+       * on (data,weight) pairs, O(nd), without sorting either array.
+       * @param xd array of data, not changed.
+       * @param wd array of weights, parallel to xd, each >= 0.
+       * @param nd length of arrays xd and wd.
+       * @return weighted median of the data in array xd.
+       * @throw Exception if input is invalid or the weights sum to zero.
+       */
+      template <typename T>
+      T WeightedMedian(const T *xd, const T *wd, const int nd)
+      {
+         if (!xd || !wd || nd < 1)
+         {
+            Exception e("Invalid input");
+            GNSSTK_THROW(e);
+         }
+
+         try
+         {
+            int i, lo(0), hi(nd), mid;
+            T wtot(0), wbelow(0), wleft, below(0);
+            bool haveBelow(false);
+            std::vector< std::pair<T,T> > xw(nd);
+            for (i = 0; i < nd; i++)
+            {
+               if (wd[i] < T(0))
+               {
+                  Exception e("Invalid input: negative weight");
+                  GNSSTK_THROW(e);
+               }
+               xw[i] = std::make_pair(xd[i], wd[i]);
+               wtot += wd[i];
+            }
+            if (wtot <= T(0))
+            {
+               Exception e("Invalid input: weights sum to zero");
+               GNSSTK_THROW(e);
+            }
+            const T half(wtot / T(2));
+            const QsortLess<T> less(gnsstk::Qsort_compare<T>);
+
+            // the answer is in xw[lo..hi-1]; wbelow is the weight of the
+            // data before lo, and below the largest of those data with
+            // non-zero weight, if haveBelow
+            while (true)
+            {
+               mid = lo + (hi - lo) / 2;
+               std::nth_element(xw.begin() + lo, xw.begin() + mid,
+                                xw.begin() + hi, less);
+               wleft = wbelow;
+               for (i = lo; i < mid; i++)
+                  wleft += xw[i].second;
+
+               if (wleft > half)
+               {
+                  hi = mid;
+               }
+               else if (wleft + xw[mid].second >= half)
+               {
+                  if (wleft < half && wleft + xw[mid].second > half)
+                  {
+                     return xw[mid].first;
+                  }
+                  // exactly half below or through mid: average the nearest
+                  // data on either side that carry weight; data with zero
+                  // weight do not move the cumulative weight, so they are
+                  // skipped
+                  T lower(below), upper(xw[mid].first);
+                  if (wleft < half)
+                  {
+                     // exactly half through mid, which has weight
+                     lower = xw[mid].first;
+                  }
+                  else
+                  {
+                     for (i = lo; i < mid; i++)
+                        if (xw[i].second > T(0) &&
+                            (!haveBelow || xw[i].first > lower))
+                        {
+                           lower = xw[i].first;
+                           haveBelow = true;
+                        }
+                  }
+                  if (wleft < half || xw[mid].second == T(0))
+                  {
+                     // all data after mid are >= xw[mid]
+                     bool haveAbove(false);
+                     for (i = mid + 1; i < nd; i++)
+                        if (xw[i].second > T(0) &&
+                            (!haveAbove || xw[i].first < upper))
+                        {
+                           upper = xw[i].first;
+                           haveAbove = true;
+                        }
+                  }
+                  return (lower + upper) / T(2);
+               }
+               else
+               {
+                  wbelow = wleft + xw[mid].second;
+                  for (i = lo; i <= mid; i++)
+                     if (xw[i].second > T(0) &&
+                         (!haveBelow || xw[i].first > below))
+                     {
+                        below = xw[i].first;
+                        haveBelow = true;
+                     }
+                  lo     = mid + 1;
+               }
+            }
+         }
+         catch (Exception& e)
+         {
+            GNSSTK_RETHROW(e);
+         }
+         catch (std::exception& e)
+         {
+            Exception E("std except: " + std::string(e.what()));
+            GNSSTK_THROW(E);
+         }
+
+      } // end WeightedMedian
+
+      /** Compute the median of a large array using threads. A sample of
+       * the data gives bounds that bracket the median; one parallel pass
+       * counts the data below the bounds and gathers the data between
+       * them, and the median is selected from that small set. If the
+       * bounds miss (unusual data), the serial Median() is used.
+       * The result is the same as Median(). Arrays smaller than 2^17 are
+       * done serially.
+       * @param xd         array of data, not changed.
+       * @param nd         length of array xd.
+       * @param nthreads   number of threads, 0 for one per hardware thread.
+       * @return median of the data in array xd.
+       * @throw Exception
+       */
+      template <typename T>
+      T ParallelMedian(const T *xd, const int nd, unsigned nthreads = 0)
+      {
+         if (!xd || nd < 2)
+         {
+            Exception e("Invalid input");
+            GNSSTK_THROW(e);
+         }
+
+         try
+         {
+            const size_t n(nd), k(n / 2), minChunk(1 << 16);
+            const unsigned nchunk(numThreads(nthreads, n / minChunk));
+            if (n < 2 * minChunk || nchunk < 2)
+            {
+               std::vector<T> work(xd, xd + nd);
+               return SelectMedian(&work[0], nd);
+            }
+
+            // bounds from a regular sample; the rank of the median in the
+            // sample has a spread of ~sqrt(ns)/2, so allow 3*sqrt(ns)
+            const size_t ns(std::min(n / 8, size_t(1 << 16))), stride(n / ns);
+            std::vector<T> samp(ns);
+            for (size_t i = 0; i < ns; i++)
+               samp[i] = xd[i * stride];
+            std::sort(samp.begin(), samp.end());
+            const size_t ks((k * ns) / n),
+               del(3 * size_t(std::sqrt(double(ns))));
+            const T a(samp[ks > del ? ks - del : 0]);
+            const T b(samp[std::min(ks + del, ns - 1)]);
+
+            // one pass: count data below a, gather data in [a,b]
+            std::vector<size_t> nbelow(nchunk, 0);
+            std::vector< std::vector<T> > inside(nchunk);
+            parallelFor(nchunk, nchunk, [&](size_t c) {
+               const size_t beg(c * n / nchunk), end((c + 1) * n / nchunk);
+               for (size_t i = beg; i < end; i++)
+               {
+                  if (xd[i] < a)
+                  {
+                     nbelow[c]++;
+                  }
+                  else if (!(b < xd[i]))
+                  {
+                     inside[c].push_back(xd[i]);
+                  }
+               }
+            });
+
+            size_t below(0), nin(0);
+            for (unsigned c = 0; c < nchunk; c++)
+            {
+               below += nbelow[c];
+               nin += inside[c].size();
+            }
+            // both middle values (k-1 and k if n is even) must be inside
+            if (below + (n % 2 ? 0 : 1) > k || k >= below + nin)
+            {
+               std::vector<T> work(xd, xd + nd);
+               return SelectMedian(&work[0], nd);
+            }
+
+            std::vector<T> mid;
+            mid.reserve(nin);
+            for (unsigned c = 0; c < nchunk; c++)
+            {
+               mid.insert(mid.end(), inside[c].begin(), inside[c].end());
+               std::vector<T>().swap(inside[c]);
+            }
+            const size_t r(k - below);
+            std::nth_element(mid.begin(), mid.begin() + r, mid.end());
+            if (n % 2)
+            {
+               return mid[r];
+            }
+            return (*std::max_element(mid.begin(), mid.begin() + r) + mid[r]) /
+                   T(2);
+         }
+         catch (Exception& e)
+         {
+            GNSSTK_RETHROW(e);
+         }
+         catch (std::exception& e)
+         {
+            Exception E("std except: " + std::string(e.what()));
+            GNSSTK_THROW(E);
+         }
+
+      } // end ParallelMedian
+
+      /** Compute the median absolute deviation, and the median M, of a
+       * large array using threads; see ParallelMedian() and
+       * MedianAbsoluteDeviation(). The array is not changed.
+       * @param xd array of data (input).
+       * @param nd length of array xd (input).
+       * @param M median of data in array xd (output).
+       * @param nthreads number of threads, 0 for one per hardware thread.
+       * @return median absolute deviation of data in array xd.
+       * @throw Exception
+       */
+      template <typename T>
+      T ParallelMAD(const T *xd, const int nd, T& M, unsigned nthreads = 0)
+      {
+         if (!xd || nd < 2)
+         {
+            Exception e("Invalid input");
+            GNSSTK_THROW(e);
+         }
+
+         try
+         {
+            const size_t n(nd), minChunk(1 << 16);
+            const unsigned nchunk(numThreads(nthreads, n / minChunk));
+            if (n < 2 * minChunk || nchunk < 2)
+            {
+               std::vector<T> work(xd, xd + nd);
+               return MedianAbsoluteDeviation(&work[0], nd, M, false);
+            }
+
+            M = ParallelMedian(xd, nd, nthreads);
+
+            std::vector<T> dev(n);
+            parallelFor(nchunk, nchunk, [&](size_t c) {
+               const size_t beg(c * n / nchunk), end((c + 1) * n / nchunk);
+               for (size_t i = beg; i < end; i++)
+                  dev[i] = ABSOLUTE(xd[i] - M);
+            });
+
+            return ParallelMedian(&dev[0], nd, nthreads) / T(RobustTuningE);
+         }
+         catch (Exception& e)
+         {
+            GNSSTK_RETHROW(e);
+         }
+         catch (std::exception& e)
+         {
+            Exception E("std except: " + std::string(e.what()));
+            GNSSTK_THROW(E);
+         }
+
+      } // end ParallelMAD
+
       /** Compute the m-estimate. Iteratively determine the m-estimate, which
        * is a measure of mean or median, but is less sensitive to outliers.
        * M is the median (M=Median(xd,nd)), and MAD is the
@@ -1011,6 +1011,128 @@ namespace gnsstk
       }
    }
 
+      /* -----------------------------------------------------------------------------
+         Eliminate (marginalize) state elements and collapse the SRI. Moving
+         state c to the front of R leaves a full first column in rows 0..c;
+         Givens rotations of rows (a-1,a), a=c..1, restore the triangle and
+         leave the information on state c in the first row, which is dropped.
+         All eliminations are done in place, through the lists of live rows and
+         columns, and R is copied once at the end. */
+   void SRI::marginalize(const vector<unsigned int>& indexes)
+   {
+      const unsigned int n = R.rows();
+      unsigned int i, k;
+      for (k = 0; k < indexes.size(); k++)
+      {
+         if (indexes[k] >= n)
+         {
+            MatrixException me("Invalid index in marginalize: " +
+                               asString<int>(indexes[k]));
+            GNSSTK_THROW(me);
+         }
+      }
+
+      vector<unsigned int> drops(indexes);
+      sort(drops.begin(), drops.end());
+      drops.erase(unique(drops.begin(), drops.end()), drops.end());
+      if (drops.empty())
+      {
+         return;
+      }
+      if (drops.size() == n)
+      {
+         *this = SRI(0);
+         return;
+      }
+
+      try
+      {
+            // physical rows and columns of R still in the SRI
+         vector<unsigned int> rows(n), cols(n);
+         for (i = 0; i < n; i++)
+         {
+            rows[i] = cols[i] = i;
+         }
+
+         for (k = 0; k < drops.size(); k++)
+         {
+               // logical index of this state in the current SRI
+            const unsigned int c =
+               lower_bound(cols.begin(), cols.end(), drops[k]) - cols.begin();
+            const unsigned int m = cols.size();
+            const unsigned int jc = cols[c];
+            for (unsigned int a = c; a > 0; a--)
+            {
+               const unsigned int p = rows[a - 1], q = rows[a];
+               double y = R(q, jc);
+               if (y == 0.0)
+               {
+                  continue;
+               }
+               double x = R(p, jc);
+               double r = ::sqrt(x * x + y * y);
+               double cs = x / r, sn = y / r;
+               for (unsigned int b = a - 1; b < m; b++)
+               {
+                  const unsigned int j = cols[b];
+                  double rp = R(p, j), rq = R(q, j);
+                  R(p, j) = cs * rp + sn * rq;
+                  R(q, j) = -sn * rp + cs * rq;
+               }
+               double zp = Z(p), zq = Z(q);
+               Z(p) = cs * zp + sn * zq;
+               Z(q) = -sn * zp + cs * zq;
+               R(q, jc) = 0.0;
+            }
+               // first row now holds all the information on state c
+            rows.erase(rows.begin());
+            cols.erase(cols.begin() + c);
+         }
+
+            // compact
+         const unsigned int m = cols.size();
+         Matrix<double> Rnew(m, m, 0.0);
+         Vector<double> Znew(m);
+         vector<string> labels(m);
+         for (unsigned int j = 0; j < m; j++)
+         {
+            Znew(j) = Z(rows[j]);
+            labels[j] = names.getName(cols[j]);
+            for (i = 0; i <= j; i++)
+            {
+               Rnew(i, j) = R(rows[i], cols[j]);
+            }
+         }
+         R = Rnew;
+         Z = Znew;
+         names = Namelist(labels);
+      }
+      catch (MatrixException& me)
+      {
+         GNSSTK_RETHROW(me);
+      }
+      catch (VectorException& ve)
+      {
+         GNSSTK_RETHROW(ve);
+      }
+   }
+
+      /* -----------------------------------------------------------------------------
+         Namelist version of marginalize(). */
+   void SRI::marginalize(const Namelist& drops)
+   {
+      vector<unsigned int> indexes;
+      for (unsigned int i = 0; i < drops.size(); i++)
+      {
+         int in = names.index(drops.getName(i));
+         if (in > -1)
+         {
+            indexes.push_back(in);
+         }
+      }
+      marginalize(indexes);
+   }
+
       /*------------------------------------------------------------------------------
          Add a priori or 'constraint' information
          Prefer addAPrioriInformation(inverse(Cov), inverse(Cov)*X); */
@@ -439,6 +439,27 @@ namespace gnsstk
       void stateFixAndRemove(const Namelist& drops,
                              const Vector<double>& values);
 
+         /**
+          Eliminate (marginalize) the given state elements, and collapse the
+          SRI by removing them. Unlike stateFixAndRemove(), no value is
+          assumed for the dropped states; the remaining states keep exactly
+          the information they had, marginalized over the dropped ones, and
+          keep their order in the Namelist. Each state is eliminated by a sweep
+          of Givens rotations over the rows of R above it, so the cost is
+          proportional to n times the index of the state; the SRI is compacted
+          once, at the end. Duplicate indexes are ignored.
+          @param indexes of the elements to eliminate
+          @throw MatrixException if an index is out of range
+         */
+      void marginalize(const std::vector<unsigned int>& indexes);
+
+         /**
+          Namelist version of marginalize(); names not found are ignored.
+          @param drops Namelist of states to eliminate
+          @throw MatrixException
+         */
+      void marginalize(const Namelist& drops);
+
          /**
           Add a priori or constraint information in the form of an ordinary
           state vector and covariance matrix. The matrix must be non-singular.
@@ -46,6 +46,8 @@
  *             by G.J. Bierman, Academic Press, 1977.
  */
 
+#include <algorithm>
+#include <iterator>
 #include "SRIFilter.hpp"
 #include "RobustStats.hpp"
 #include "StringUtils.hpp"
@@ -230,6 +232,129 @@ namespace gnsstk
       }
    }
 
+   //---------------------------------------------------------------------------------
+      /* SRIF (Kalman) measurement update for sparse partials and block
+         structured R, one row of H at a time.
+         Returns unwhitened residuals in D */
+   void SRIFilter::measurementUpdateSparse(const SparseMatrix<double>& H,
+                                           Vector<double>& D,
+                                           const SparseMatrix<double>& CM)
+   {
+      RowStructure rs;
+      measurementUpdateSparse(H, D, CM, rs);
+   }
+
+   //---------------------------------------------------------------------------------
+   void SRIFilter::measurementUpdateSparse(const SparseMatrix<double>& H,
+                                           Vector<double>& D,
+                                           const SparseMatrix<double>& CM,
+                                           RowStructure& rs)
+   {
+      if (H.cols() != R.cols() || H.rows() != D.size() ||
+          (&CM != &SRINullSparseMatrix &&
+           (CM.rows() != D.size() || CM.cols() != D.size())))
+      {
+         string msg("\nInvalid input dimensions:\n  SRI is ");
+         msg += asString<int>(R.rows()) + "x" + asString<int>(R.cols()) +
+                ",\n  Partials is " + asString<int>(H.rows()) + "x" +
+                asString<int>(H.cols()) + ",\n  Data has length " +
+                asString<int>(D.size());
+         if (&CM != &SRINullSparseMatrix)
+         {
+            msg += ",\n  and Cov is " + asString<int>(CM.rows()) + "x" +
+                   asString<int>(CM.cols());
+         }
+
+         MatrixException me(msg);
+         GNSSTK_THROW(me);
+      }
+
+      try
+      {
+         unsigned int i, j, k;
+         const unsigned int m(H.rows());
+
+            // measurement sigmas, from the diagonal CM
+         Vector<double> sig(m, 1.0);
+         if (&CM != &SRINullSparseMatrix)
+         {
+            vector<unsigned int> rows, cols;
+            vector<double> vals;
+            CM.flatten(rows, cols, vals);
+            sig = 0.0;
+            for (k = 0; k < vals.size(); k++)
+            {
+               if (rows[k] != cols[k])
+               {
+                  MatrixException me("Measurement covariance is not diagonal");
+                  GNSSTK_THROW(me);
+               }
+               sig(rows[k]) = vals[k];
+            }
+            for (i = 0; i < m; i++)
+            {
+               if (sig(i) <= 0.0)
+               {
+                  MatrixException me("Measurement covariance is not positive"
+                                     " at row " + asString<int>(i));
+                  GNSSTK_THROW(me);
+               }
+               sig(i) = ::sqrt(sig(i));
+            }
+         }
+
+            // non-zero partials, ordered by row then column
+         vector<unsigned int> hrows, hcols;
+         vector<double> hvals;
+         H.flatten(hrows, hcols, hvals);
+
+         if (rs.size() != R.rows())
+         {
+            rowStructure(rs);
+         }
+
+         k = 0;
+         for (i = 0; i < m; i++)
+         {
+            vector<unsigned int> S;
+            unsigned int kb(k);
+            for ( ; k < hrows.size() && hrows[k] == i; k++)
+               S.push_back(hcols[k]);
+            if (S.empty())
+            {
+               continue;                  // no information, D(i) unchanged
+            }
+
+            closeStructure(rs, S);
+
+               // this row's whitened partials and data, on the block
+            Matrix<double> Rc;
+            Vector<double> Zc;
+            gatherBlock(S, Rc, Zc);
+            Matrix<double> A(1, S.size() + 1, 0.0);
+            for (j = kb; j < k; j++)
+            {
+               A(0, lower_bound(S.begin(), S.end(), hcols[j]) - S.begin()) =
+                  hvals[j] / sig(i);
+            }
+            A(0, S.size()) = D(i) / sig(i);
+
+            SrifMU(Rc, Zc, A);
+
+            scatterBlock(S, Rc, Zc, rs);
+            D(i) = A(0, S.size()) * sig(i);
+         }
+      }
+      catch (MatrixException& me)
+      {
+         GNSSTK_RETHROW(me);
+      }
+      catch (VectorException& ve)
+      {
+         GNSSTK_RETHROW(ve);
+      }
+   }
+
    //---------------------------------------------------------------------------------
       // SRIF (Kalman) time update see SrifTU for doc.
    void SRIFilter::timeUpdate(Matrix<double>& PhiInv, Matrix<double>& Rw,
@@ -246,6 +371,111 @@ namespace gnsstk
       }
    }
 
+   //---------------------------------------------------------------------------------
+      // SRIF (Kalman) time update with identity transition and random walk
+      // process noise on some states, restricted to the coupled block of R.
+   void SRIFilter::timeUpdateSparse(const vector<unsigned int>& indexes,
+                                    const Vector<double>& sigma)
+   {
+      RowStructure rs;
+      timeUpdateSparse(indexes, sigma, rs);
+   }
+
+   //---------------------------------------------------------------------------------
+   void SRIFilter::timeUpdateSparse(const vector<unsigned int>& indexes,
+                                    const Vector<double>& sigma,
+                                    RowStructure& rs)
+   {
+      const unsigned int n(R.rows());
+      unsigned int i, j, k;
+
+      if (indexes.size() != sigma.size())
+      {
+         MatrixException me("Invalid input dimensions: " +
+                            asString<int>(indexes.size()) + " indexes and " +
+                            asString<int>(sigma.size()) + " sigmas");
+         GNSSTK_THROW(me);
+      }
+      for (k = 0; k < indexes.size(); k++)
+      {
+         if (indexes[k] >= n || sigma(k) <= 0.0)
+         {
+            MatrixException me("Invalid process noise: index " +
+                               asString<int>(indexes[k]) + " sigma " +
+                               asString<double>(sigma(k)));
+            GNSSTK_THROW(me);
+         }
+      }
+
+      try
+      {
+            /* the rows of R with non-zero elements in the columns of the
+               noisy states, closed over the structure of R */
+         vector<unsigned int> S;
+         for (k = 0; k < indexes.size(); k++)
+         {
+            j = indexes[k];
+            for (i = 0; i <= j; i++)
+            {
+               if (R(i, j) != 0.0)
+               {
+                  S.push_back(i);
+               }
+            }
+         }
+         if (S.empty())
+         {
+            return;                       // no information to de-weight
+         }
+
+         if (rs.size() != n)
+         {
+            rowStructure(rs);
+         }
+         closeStructure(rs, S);
+
+            // noisy states that are in the block; the others have no
+            // information, so their noise has no effect
+         vector<unsigned int> pos;
+         vector<double> sig;
+         for (k = 0; k < indexes.size(); k++)
+         {
+            vector<unsigned int>::iterator it =
+               lower_bound(S.begin(), S.end(), indexes[k]);
+            if (it != S.end() && *it == indexes[k])
+            {
+               pos.push_back(it - S.begin());
+               sig.push_back(sigma(k));
+            }
+         }
+         if (pos.empty())
+         {
+            return;
+         }
+
+         const unsigned int nc(S.size()), ns(pos.size());
+         Matrix<double> Rc;
+         Vector<double> Zc;
+         gatherBlock(S, Rc, Zc);
+         Matrix<double> PhiInv(ident<double>(nc));
+         Matrix<double> Rw(ns, ns, 0.0), G(nc, ns, 0.0), Rwx(ns, nc, 0.0);
+         Vector<double> Zw(ns, 0.0);
+         for (k = 0; k < ns; k++)
+         {
+            Rw(k, k)      = 1.0 / sig[k];
+            G(pos[k], k)  = 1.0;
+         }
+
+         SrifTU(Rc, Zc, PhiInv, Rw, G, Zw, Rwx);
+
+         scatterBlock(S, Rc, Zc, rs);
+      }
+      catch (MatrixException& me)
+      {
+         GNSSTK_RETHROW(me);
+      }
+   }
+
    //---------------------------------------------------------------------------------
       // SRIF (Kalman) smoother update see SrifSU for doc.
    void SRIFilter::smootherUpdate(Matrix<double>& Phi, Matrix<double>& Rw,
@@ -572,6 +802,98 @@ namespace gnsstk
       }
    } // end SrifTU
 
+   //---------------------------------------------------------------------------------
+   void SRIFilter::rowStructure(RowStructure& rs) const
+   {
+      const unsigned int n(R.rows());
+      rs.assign(n, vector<unsigned int>());
+         // column by column, to follow the storage of Matrix
+      for (unsigned int j = 0; j < n; j++)
+      {
+         for (unsigned int i = 0; i <= j; i++)
+         {
+            if (R(i, j) != 0.0)
+            {
+               rs[i].push_back(j);
+            }
+         }
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void SRIFilter::closeStructure(const RowStructure& rs,
+                                  vector<unsigned int>& S)
+   {
+      sort(S.begin(), S.end());
+      S.erase(unique(S.begin(), S.end()), S.end());
+      vector<unsigned int> todo(S), merged;
+      while (!todo.empty())
+      {
+            // columns of the new rows that are not yet in S
+         vector<unsigned int> add;
+         for (unsigned int k = 0; k < todo.size(); k++)
+         {
+            const vector<unsigned int>& cols(rs[todo[k]]);
+            for (unsigned int j = 0; j < cols.size(); j++)
+            {
+               if (!binary_search(S.begin(), S.end(), cols[j]))
+               {
+                  add.push_back(cols[j]);
+               }
+            }
+         }
+         sort(add.begin(), add.end());
+         add.erase(unique(add.begin(), add.end()), add.end());
+         merged.clear();
+         std::merge(S.begin(), S.end(), add.begin(), add.end(),
+               back_inserter(merged));
+         S.swap(merged);
+         todo.swap(add);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void SRIFilter::gatherBlock(const vector<unsigned int>& S,
+                               Matrix<double>& Rc, Vector<double>& Zc) const
+   {
+      const unsigned int nc(S.size());
+      Rc = Matrix<double>(nc, nc, 0.0);
+      Zc = Vector<double>(nc);
+      for (unsigned int j = 0; j < nc; j++)
+      {
+         Zc(j) = Z(S[j]);
+         for (unsigned int i = 0; i <= j; i++)
+         {
+            Rc(i, j) = R(S[i], S[j]);
+         }
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void SRIFilter::scatterBlock(const vector<unsigned int>& S,
+                                const Matrix<double>& Rc,
+                                const Vector<double>& Zc,
+                                RowStructure& rs)
+   {
+      const unsigned int nc(S.size());
+      for (unsigned int i = 0; i < nc; i++)
+      {
+         rs[S[i]].clear();
+      }
+      for (unsigned int j = 0; j < nc; j++)
+      {
+         Z(S[j]) = Zc(j);
+         for (unsigned int i = 0; i <= j; i++)
+         {
+            R(S[i], S[j]) = Rc(i, j);
+            if (Rc(i, j) != 0.0)
+            {
+               rs[S[i]].push_back(S[j]);
+            }
+         }
+      }
+   }
+
    //---------------------------------------------------------------------------------
       /* Kalman smoother update.
          This routine uses the Householder transformation to propagate the SRIF
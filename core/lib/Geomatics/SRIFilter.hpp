@@ -51,6 +51,7 @@
 //------------------------------------------------------------------------------------
 // system
 #include <ostream>
+#include <vector>
 // GNSSTk
 #include "Matrix.hpp"
 #include "Vector.hpp"
@@ -93,6 +94,11 @@ namespace gnsstk
    class SRIFilter : public SRI
    {
    public:
+         /// Row structure of R, used by the sparse updates: element i is the
+         /// sorted list of columns (at or right of the diagonal) of the
+         /// non-zero elements of row i.
+      typedef std::vector< std::vector<unsigned int> > RowStructure;
+
          /// empty constructor
       SRIFilter();
 
@@ -159,6 +165,77 @@ namespace gnsstk
       void measurementUpdate(const SparseMatrix<double>& H, Vector<double>& D,
                         const SparseMatrix<double>& CM = SRINullSparseMatrix);
 
+         /**
+          SRIF (Kalman) measurement update for large, sparse problems. Each row
+          of H is processed in turn, and only the states reachable from that
+          row's non-zero partials through the non-zero structure of R take
+          part; this set is closed, in the sense that the rows of R in it have
+          non-zero elements only in its columns, so the Householder update of
+          those rows and columns is exactly the update of the whole SRI. For
+          R with block structure (e.g. block diagonal, or 'arrowhead', i.e.
+          blocks coupled only through a set of global states) and rows of H
+          with a few non-zero partials, the cost scales with the size of the
+          blocks touched and not with the dimension of the SRI.
+          The result is the same as measurementUpdate() called with one row
+          at a time.
+          @param H  Partials matrix, dimension MxN.
+          @param D  Data vector, length M; on output D is post-fit residuals,
+                    each that of its own row update.
+          @param CM Measurement covariance matrix, dimension MxM, which must be
+                    diagonal.
+          @throw MatrixException if dimension N does not match dimension of
+               SRI, or if other dimensions are inconsistent, or if CM is not
+               diagonal and positive.
+         */
+      void measurementUpdateSparse(const SparseMatrix<double>& H,
+                        Vector<double>& D,
+                        const SparseMatrix<double>& CM = SRINullSparseMatrix);
+
+         /**
+          measurementUpdateSparse() with the row structure of R kept by the
+          caller, so that R is not rescanned, at O(n^2) cost, on every call.
+          @param H  Partials matrix, dimension MxN.
+          @param D  Data vector, length M; on output D is post-fit residuals.
+          @param CM Measurement covariance matrix, dimension MxM, diagonal.
+          @param rs Row structure of R: rs[i] is the sorted list of columns of
+                    the non-zero elements of row i. If its length is not N it
+                    is built from R; on output it includes the fill-in of this
+                    update. It must be cleared if R is changed by any other
+                    method.
+          @throw MatrixException as measurementUpdateSparse().
+         */
+      void measurementUpdateSparse(const SparseMatrix<double>& H,
+                                   Vector<double>& D,
+                                   const SparseMatrix<double>& CM,
+                                   RowStructure& rs);
+
+         /**
+          SRIF (Kalman) time update for large, sparse problems in which the
+          state transition is identity and some of the states have random walk
+          (or, with large sigma, white) process noise - e.g. receiver clocks,
+          troposphere or ionosphere delays. This is timeUpdate() with
+          PhiInv = identity, G = the columns of identity at the given indexes,
+          Rw = diagonal(1/sigma) and Zw = 0, but as in
+          measurementUpdateSparse() only the rows and columns of R coupled
+          to the noisy states take part. The smoother outputs (Rw, Zw, Rwx)
+          are not produced; use timeUpdate() if they are needed.
+          @param indexes indexes in the SRI of the states with process noise.
+          @param sigma   process noise sigma of each state in indexes.
+          @throw MatrixException if an index is out of range, the lengths of
+                 indexes and sigma differ or a sigma is not positive.
+         */
+      void timeUpdateSparse(const std::vector<unsigned int>& indexes,
+                            const Vector<double>& sigma);
+
+         /**
+          timeUpdateSparse() with the row structure of R kept by the caller;
+          see measurementUpdateSparse() for the row structure rs.
+          @throw MatrixException as timeUpdateSparse().
+         */
+      void timeUpdateSparse(const std::vector<unsigned int>& indexes,
+                            const Vector<double>& sigma,
+                            RowStructure& rs);
+
          /**
           SRIF (Kalman) time update
           This routine uses the Householder transformation to propagate the
@@ -428,6 +505,28 @@ namespace gnsstk
                             Matrix<T>& Rw, Matrix<T>& G, Vector<T>& Zw,
                             Matrix<T>& Rwx);
 
+         /** For each row of R, collect the columns (at or right of the
+          * diagonal) holding non-zero elements.
+          * @param[out] rs rs[i] is the sorted list of columns for row i. */
+      void rowStructure(RowStructure& rs) const;
+
+         /** Extend the sorted set of indexes S until, for every row i in S,
+          * all the non-zero columns rs[i] are also in S.
+          * @param[in] rs row structure from rowStructure().
+          * @param[in,out] S the set to close, sorted on output. */
+      static void closeStructure(const RowStructure& rs,
+                                 std::vector<unsigned int>& S);
+
+         /** Copy the block of R and Z at indexes S into Rc and Zc. */
+      void gatherBlock(const std::vector<unsigned int>& S,
+                       Matrix<double>& Rc, Vector<double>& Zc) const;
+
+         /** Copy Rc and Zc back into R and Z at indexes S, and update the row
+          * structure of those rows. */
+      void scatterBlock(const std::vector<unsigned int>& S,
+                        const Matrix<double>& Rc, const Vector<double>& Zc,
+                        RowStructure& rs);
+
          /// initialization used by constructors
       void defaults()
       {
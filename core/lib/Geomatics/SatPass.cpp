@@ -109,6 +109,8 @@ namespace gnsstk
          indexForLabel[obstypes[i]] = i;
          labelForIndex[i]           = obstypes[i];
       }
+      spdvector.clear();
+      spdvector.setNumObs(obstypes.size());
    }
 
    SatPass& SatPass::operator=(const SatPass& right)
@@ -123,9 +125,7 @@ namespace gnsstk
          firstTime     = right.firstTime;
          lastTime      = right.lastTime;
          ngood         = right.ngood;
-         spdvector.resize(right.spdvector.size());
-         for (int i = 0; i < right.spdvector.size(); i++)
-            spdvector[i] = right.spdvector[i];
+         spdvector     = right.spdvector;
       }
 
       return *this;
@@ -164,12 +164,12 @@ namespace gnsstk
                      StringUtils::asString(ssi.size()));
          GNSSTK_THROW(e);
       }
-      if (spdvector.size() > 0 && spdvector[0].data.size() != data.size())
+      if (spdvector.numObs() != data.size())
       {
          Exception e(
             "Error - addData passed different dimension that earlier!" +
             StringUtils::asString(data.size()) +
-            " != " + StringUtils::asString(spdvector[0].data.size()));
+            " != " + StringUtils::asString(spdvector.numObs()));
          GNSSTK_THROW(e);
       }
 
@@ -204,7 +204,7 @@ namespace gnsstk
       RinexObsData::RinexSatMap::const_iterator it;
       RinexObsData::RinexObsTypeMap::const_iterator jt;
       map<string, unsigned int>::const_iterator kt;
-      SatPassData spd(indexForLabel.size());
+      SatPassData spd(spdvector.numObs());
 
          // loop over satellites
       for (it = robs.obs.begin(); it != robs.obs.end(); it++)
@@ -1140,6 +1140,7 @@ namespace gnsstk
          newSP.Status        = Status;
          newSP.indexForLabel = indexForLabel;
          newSP.labelForIndex = labelForIndex;
+         newSP.spdvector.setNumObs(spdvector.numObs());
 
          oldgood = ngood;
          ngood = ilast = 0;
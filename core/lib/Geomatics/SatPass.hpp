@@ -41,6 +41,7 @@
 #ifndef GNSSTK_SATELLITE_PASS_INCLUDE
 #define GNSSTK_SATELLITE_PASS_INCLUDE
 
+#include <algorithm>
 #include <map>
 #include <ostream>
 #include <string>
@@ -148,6 +149,186 @@ namespace gnsstk
          }
       }; // end struct SatPassData
 
+      struct SatPassDataConstRef;
+
+         /**
+          struct SatPassDataRef, for internal use only, refers to the data of
+          one epoch held in a SatPassArena; it has the same members as
+          SatPassData, so spdvector[i].data[k] etc. work as before.
+          Assigning to it copies the data of the other epoch.
+         */
+      struct SatPassDataRef
+      {
+         unsigned short& flag;
+         unsigned int& userflag;
+         unsigned int& ndt;
+         double& toffset;
+         double* data;
+         unsigned short *lli, *ssi;
+         unsigned int nobs; ///< number of data types
+
+         SatPassDataRef(unsigned short& f, unsigned int& u, unsigned int& n,
+                        double& t, double* d, unsigned short* l,
+                        unsigned short* s, unsigned int no)
+            : flag(f), userflag(u), ndt(n), toffset(t), data(d), lli(l),
+              ssi(s), nobs(no)
+         {}
+
+         SatPassDataRef& operator=(const SatPassDataConstRef& right);
+
+         SatPassDataRef& operator=(const SatPassDataRef& right);
+
+         SatPassDataRef& operator=(const SatPassData& right);
+      }; // end struct SatPassDataRef
+
+         /// read-only counterpart of SatPassDataRef
+      struct SatPassDataConstRef
+      {
+         const unsigned short& flag;
+         const unsigned int& userflag;
+         const unsigned int& ndt;
+         const double& toffset;
+         const double* data;
+         const unsigned short *lli, *ssi;
+         unsigned int nobs; ///< number of data types
+
+         SatPassDataConstRef(const unsigned short& f, const unsigned int& u,
+                             const unsigned int& n, const double& t,
+                             const double* d, const unsigned short* l,
+                             const unsigned short* s, unsigned int no)
+            : flag(f), userflag(u), ndt(n), toffset(t), data(d), lli(l),
+              ssi(s), nobs(no)
+         {}
+
+         SatPassDataConstRef(const SatPassDataRef& r)
+            : flag(r.flag), userflag(r.userflag), ndt(r.ndt),
+              toffset(r.toffset), data(r.data), lli(r.lli), ssi(r.ssi),
+              nobs(r.nobs)
+         {}
+
+            /// copy out the data of this epoch
+         operator SatPassData() const
+         {
+            SatPassData spd(nobs);
+            spd.flag     = flag;
+            spd.userflag = userflag;
+            spd.ndt      = ndt;
+            spd.toffset  = toffset;
+            std::copy(data, data + nobs, spd.data.begin());
+            std::copy(lli, lli + nobs, spd.lli.begin());
+            std::copy(ssi, ssi + nobs, spd.ssi.begin());
+            return spd;
+         }
+      }; // end struct SatPassDataConstRef
+
+         /**
+          class SatPassArena, for internal use only, holds the data of all the
+          epochs in a pass in a few flat arrays: one of per-epoch flags and
+          times, and one each of data, lli and ssi, with the values for epoch
+          i at [i*nobs, (i+1)*nobs). This replaces a vector of SatPassData,
+          which made three small allocations per epoch. It supports the part
+          of the std::vector interface used by SatPass and its friends.
+         */
+      class SatPassArena
+      {
+      public:
+         SatPassArena(unsigned int n = 0) : nobs(n) {}
+
+            /// set the number of data types; only allowed when empty
+         void setNumObs(unsigned int n)
+         {
+            if (!epochs.empty() && n != nobs)
+            {
+               Exception e("SatPassArena::setNumObs() on non-empty arena");
+               GNSSTK_THROW(e);
+            }
+            nobs = n;
+         }
+
+         unsigned int numObs() const { return nobs; }
+
+         size_t size() const { return epochs.size(); }
+
+         bool empty() const { return epochs.empty(); }
+
+         void clear()
+         {
+            epochs.clear();
+            obs.clear();
+            lli.clear();
+            ssi.clear();
+         }
+
+         void reserve(size_t n)
+         {
+            epochs.reserve(n);
+            obs.reserve(n * nobs);
+            lli.reserve(n * nobs);
+            ssi.reserve(n * nobs);
+         }
+
+            /// new epochs are as for SatPassData(nobs)
+         void resize(size_t n)
+         {
+            epochs.resize(n);
+            obs.resize(n * nobs, 0.0);
+            lli.resize(n * nobs, 0);
+            ssi.resize(n * nobs, 0);
+         }
+
+         void push_back(const SatPassData& spd)
+         {
+            if (spd.data.size() != nobs || spd.lli.size() != nobs ||
+                spd.ssi.size() != nobs)
+            {
+               Exception e("SatPassArena::push_back() wrong number of data");
+               GNSSTK_THROW(e);
+            }
+            resize(size() + 1);
+            (*this)[size() - 1] = spd;
+         }
+
+            /// copies through SatPassData, so r may refer to this arena
+         void push_back(const SatPassDataConstRef& r)
+         {
+            push_back(SatPassData(r));
+         }
+
+         SatPassDataRef operator[](size_t i)
+         {
+            EpochInfo& e(epochs[i]);
+            size_t j(i * nobs);
+            return SatPassDataRef(e.flag, e.userflag, e.ndt, e.toffset,
+                                  obs.data() + j, lli.data() + j,
+                                  ssi.data() + j, nobs);
+         }
+
+         SatPassDataConstRef operator[](size_t i) const
+         {
+            const EpochInfo& e(epochs[i]);
+            size_t j(i * nobs);
+            return SatPassDataConstRef(e.flag, e.userflag, e.ndt, e.toffset,
+                                       obs.data() + j, lli.data() + j,
+                                       ssi.data() + j, nobs);
+         }
+
+      private:
+            /// the per-epoch members of SatPassData
+         struct EpochInfo
+         {
+            EpochInfo() : flag(SatPass::OK), userflag(0), ndt(0), toffset(0.0) {}
+            unsigned short flag;
+            unsigned int userflag;
+            unsigned int ndt;
+            double toffset;
+         };
+
+         unsigned int nobs; ///< number of data types
+         std::vector<EpochInfo> epochs;
+         std::vector<double> obs;
+         std::vector<unsigned short> lli, ssi;
+      }; // end class SatPassArena
+
       // --------------- private member data -----------------------------
          /**
           Status flag for use exclusively by the caller. It is set to 0
@@ -181,8 +362,8 @@ namespace gnsstk
          /// number of timetags with good data in the data arrays.
       unsigned int ngood;
 
-         /// ALL data in the pass, stored in SatPassData objects, in time order
-      std::vector<SatPassData> spdvector;
+         /// ALL data in the pass, in time order
+      SatPassArena spdvector;
 
       // --------------- private member functions ------------------------
 
@@ -236,6 +417,7 @@ namespace gnsstk
           @param lenient   if true (default), be lenient in reading the RINEX format
           @param beginTime reject data before this time (BEGINNING_OF_TIME)
           @param endTime   reject data after this time (END_OF TIME)
+          @param nthreads  number of files to read at once (0 for all threads)
           @return -1 if the filenames list is empty, otherwise return the number
                        of files successfully read (may be less than the number input).
           @throw gnsstk::Exception if there are exceptions while reading, if the data
@@ -247,7 +429,7 @@ namespace gnsstk
                                        double dt, std::vector<SatPass>& SPList,
                                        std::vector<RinexSatID> exSats,
                                        bool lenient, Epoch beginTime,
-                                       Epoch endTime);
+                                       Epoch endTime, unsigned nthreads);
 
       // ------------------ configuration --------------------------------
          /**
@@ -910,6 +1092,41 @@ namespace gnsstk
 
    }; // end class SatPass
 
+   inline SatPass::SatPassDataRef&
+   SatPass::SatPassDataRef::operator=(const SatPassDataConstRef& right)
+   {
+      if (right.data != data)
+      {
+         flag     = right.flag;
+         userflag = right.userflag;
+         ndt      = right.ndt;
+         toffset  = right.toffset;
+         std::copy(right.data, right.data + nobs, data);
+         std::copy(right.lli, right.lli + nobs, lli);
+         std::copy(right.ssi, right.ssi + nobs, ssi);
+      }
+      return *this;
+   }
+
+   inline SatPass::SatPassDataRef&
+   SatPass::SatPassDataRef::operator=(const SatPassDataRef& right)
+   {
+      return *this = SatPassDataConstRef(right);
+   }
+
+   inline SatPass::SatPassDataRef&
+   SatPass::SatPassDataRef::operator=(const SatPassData& right)
+   {
+      flag     = right.flag;
+      userflag = right.userflag;
+      ndt      = right.ndt;
+      toffset  = right.toffset;
+      std::copy(right.data.begin(), right.data.begin() + nobs, data);
+      std::copy(right.lli.begin(), right.lli.begin() + nobs, lli);
+      std::copy(right.ssi.begin(), right.ssi.begin() + nobs, ssi);
+      return *this;
+   }
+
       /**
        Stream output for SatPass.
        @param os output stream to write to
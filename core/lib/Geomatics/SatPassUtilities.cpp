@@ -39,9 +39,12 @@
 /// @file SatPassUtilities.cpp Various utilities using SatPass
 
 #include <algorithm>
+#include <exception>
+#include <memory>
 
 #include "Stats.hpp"
 #include "logstream.hpp"
+#include "parallel_for.hpp"
 #include "stl_helpers.hpp"
 
 #include "Rinex3ObsData.hpp"
@@ -246,12 +249,127 @@ namespace gnsstk
       }
    } // end removeMilliseconds()
 
+   namespace
+   {
+         /* One RINEX obs file used by SatPassFromRinexFiles(), either read
+            in full ahead of time or streamed from the open file. */
+      struct RinexObsFileContents
+      {
+         RinexObsFileContents() : isObs(false), nrec(0) {}
+            /// false if the file could not be opened or has no obs header
+         bool isObs;
+         RinexObsHeader header;
+            /// records within the time limits, in file order, if read ahead
+         vector<RinexObsData> records;
+            /// exception thrown while reading records, after those above
+         exception_ptr error;
+            /// the open file, positioned after the header, if streaming
+         unique_ptr<RinexObsStream> strm;
+            /// time limits, used when streaming
+         Epoch beginTime, endTime;
+            /// index of the next record to return, if read ahead
+         size_t nrec;
+            /// the last record read, if streaming
+         RinexObsData obsdata;
+
+            /* Get the next record within the time limits, or null at the end
+               of the data; rethrows any exception thrown by the reader. */
+         const RinexObsData* next()
+         {
+            if (strm)
+            {
+               while (1)
+               {
+                  *strm >> obsdata;
+                  if (strm->eof() || !strm->good() ||
+                      obsdata.time > endTime)
+                  {
+                     return nullptr;
+                  }
+                  if (obsdata.time >= beginTime)
+                  {
+                     return &obsdata;
+                  }
+               }
+            }
+            if (nrec < records.size())
+            {
+               return &records[nrec++];
+            }
+            if (error)
+            {
+               rethrow_exception(error);
+            }
+            return nullptr;
+         }
+      };
+
+         /* Open one file and read its header, leaving rofc.strm positioned at
+            the first record. */
+      void openRinexObsFile(const string& filename, const Epoch& beginTime,
+                            const Epoch& endTime, RinexObsFileContents& rofc)
+      {
+         if (filename.empty())
+         {
+            return;
+         }
+         unique_ptr<RinexObsStream> RinFile(
+            new RinexObsStream(filename.c_str()));
+         if (!*RinFile)
+         {
+            return;
+         }
+         RinFile->exceptions(fstream::failbit);
+
+            // is it a Rinex Obs file? ... read the header
+         try
+         {
+            *RinFile >> rofc.header;
+         }
+         catch (Exception& e)
+         {
+            return;
+         }
+         rofc.isObs = true;
+         rofc.beginTime = beginTime;
+         rofc.endTime = endTime;
+         rofc.strm = std::move(RinFile);
+      }
+
+         /* Read the header and the records between beginTime and endTime
+            of one file; this is the expensive part of SatPassFromRinexFiles()
+            and is done for several files at once. */
+      void readRinexObsFile(const string& filename, const Epoch& beginTime,
+                            const Epoch& endTime, RinexObsFileContents& rofc)
+      {
+         openRinexObsFile(filename, beginTime, endTime, rofc);
+         if (!rofc.strm)
+         {
+            return;
+         }
+         try
+         {
+            const RinexObsData *obsdata;
+            while ((obsdata = rofc.next()) != nullptr)
+            {
+               rofc.records.push_back(*obsdata);
+            }
+         }
+         catch (...)
+         {
+            rofc.error = current_exception();
+         }
+         rofc.strm.reset();
+      }
+   } // namespace
+
       // -----------------------------------------------------------------------------
       // prototype is in SatPass.hpp as a friend
    int SatPassFromRinexFiles(vector<string>& filenames,
                              vector<string>& obstypes, double dtin,
                              vector<SatPass>& SPList, vector<RinexSatID> exSats,
-                             bool lenient, Epoch beginTime, Epoch endTime)
+                             bool lenient, Epoch beginTime, Epoch endTime,
+                             unsigned nthreads)
    {
       try
       {
@@ -274,8 +392,6 @@ namespace gnsstk
          vector<unsigned short> lli(obstypes.size(), 0);
          map<RinexSatID, int> indexForSat;
          map<RinexSatID, int>::const_iterator satit;
-         RinexObsHeader header;
-         RinexObsData obsdata;
          const string timfmt(
             string("%F %10.3g = %04Y/%02m/%02d %02H:%02M:%02S"));
 
@@ -301,33 +417,37 @@ namespace gnsstk
          for (i = 0; i < SPList.size(); i++)
             indexForSat[SPList[i].getSat()] = i;
 
-            // loop over file names
-         for (int nfile = 0; nfile < filenames.size(); nfile++)
+            /* with several threads, read the files several at a time, then
+               process their records in time order as if read one after the
+               other; with one, stream the records from each file in turn */
+         const unsigned nread(numThreads(nthreads, filenames.size()));
+         vector<RinexObsFileContents> contents;
+         for (size_t nfile = 0; nfile < filenames.size(); nfile++)
          {
-            string filename = filenames[nfile];
-
-               // does the file exist?
-            RinexObsStream RinFile(filename.c_str());
-            if (filename.empty() || !RinFile)
+            if (nread == 1)
             {
-                  // cerr << "Error: input file " << filename << " does not
-                  // exist.\n";
-               continue;
+               contents = vector<RinexObsFileContents>(1);
+               openRinexObsFile(filenames[nfile], beginTime, endTime,
+                                contents[0]);
             }
-            RinFile.exceptions(fstream::failbit);
-               // RinFile.beLenient(lenient);
-
-               // is it a Rinex Obs file? ... read the header
-            try
+            else if (nfile % nread == 0)
             {
-               RinFile >> header;
+               size_t nbatch(std::min(size_t(nread), filenames.size() - nfile));
+               contents = vector<RinexObsFileContents>(nbatch);
+               parallelFor(nbatch, nread, [&](size_t k) {
+                  readRinexObsFile(filenames[nfile + k], beginTime, endTime,
+                                   contents[k]);
+               });
             }
-            catch (Exception& e)
+            const string& filename = filenames[nfile];
+            RinexObsFileContents& rofc(contents[nfile % nread]);
+            if (!rofc.isObs)
             {
                   // cerr << "Error: input file " << filename << " is not a Rinex
                   // obs file\n";
                continue;
             }
+            const RinexObsHeader& header(rofc.header);
 
                // to return the number of files read
             nfiles++;
@@ -354,9 +474,10 @@ namespace gnsstk
                // loop over epochs in the file
             while (1)
             {
+               const RinexObsData *next;
                try
                {
-                  RinFile >> obsdata;
+                  next = rofc.next();
                }
                catch (Exception& e)
                {
@@ -364,26 +485,16 @@ namespace gnsstk
                      << "Reading RINEX obs threw exception " << e.what();
                   GNSSTK_RETHROW(e);
                }
-
-               if (RinFile.eof() || !RinFile.good())
+               if (next == nullptr)
                {
                   break;
                }
+               const RinexObsData& obsdata(*next);
 
                RinexObsData::RinexSatMap::const_iterator it;
                RinexObsData::RinexObsTypeMap::const_iterator jt;
 
-                  // test time limits
-               if (obsdata.time < beginTime)
-               {
-                  continue;
-               }
-               if (obsdata.time > endTime)
-               {
-                  break;
-               }
-
-                  /* lenient readers
+                     /* lenient readers
                      if(!obsdata.whatLenient.empty())
                        oss << " Warning - lenient RINEX reader at "
                           << printTime(obsdata.time,"%04Y/%02m/%02d %02H:%02M:%02S:
@@ -587,7 +698,7 @@ namespace gnsstk
 
             } // end loop over obs data in file
 
-            RinFile.close();
+            rofc = RinexObsFileContents();
 
          } // end loop over RINEX files
 
@@ -74,6 +74,10 @@ namespace gnsstk
        @param lenient   if true (default), be lenient in reading the RINEX format
        @param beginTime reject data before this time (BEGINNING_OF_TIME)
        @param endTime   reject data after this time (END_OF TIME)
+       @param nthreads  number of files to read at once, each on its own
+                         thread, 0 for one per hardware thread; the result
+                         does not depend on it. Up to this many files are
+                         held in memory.
        @return -1 if the filenames list is empty, otherwise return the number of
                       files successfully read (may be less than the number input).
        @throw gnsstk::Exception if there are exceptions while reading, if the
@@ -86,7 +90,8 @@ namespace gnsstk
       std::vector<RinexSatID> exSats = std::vector<RinexSatID>(),
       bool lenient                   = true,
       gnsstk::Epoch beginTime         = gnsstk::CommonTime::BEGINNING_OF_TIME,
-      gnsstk::Epoch endTime           = gnsstk::CommonTime::END_OF_TIME);
+      gnsstk::Epoch endTime           = gnsstk::CommonTime::END_OF_TIME,
+      unsigned nthreads               = 1);
 
    // -------------------------------------------------------------------------------
       /**
@@ -197,28 +197,20 @@ namespace gnsstk
       int initializeWithBinaryFile(std::string filename)
       {
          int iret = SolarSystemEphemeris::initializeWithBinaryFile(filename);
+         setConventionFromEphemeris();
+         return iret;
+      }
 
-         // if not defined, set IERS convention to the default; otherwise test it.
-         if (iersconv == IERSConvention::Unknown)
-         {
-            if (EphNumber() == 403)
-            {
-               iersconv = IERSConvention::IERS1996;
-            }
-            else if (EphNumber() == 405)
-            {
-               iersconv = IERSConvention::IERS2010; // the default
-            }
-            else
-            {
-               LOG(ERROR) << "Unknown ephemeris number " << EphNumber();
-            }
-         }
-         else
-         {
-            testIERSvsEphemeris(iersconv, EphNumber());
-         }
-
+         /**
+          Overloaded function to memory-map the ephemeris file, with the same
+          check of the IERS convention as initializeWithBinaryFile(). Cf.
+          SolarSystemEphemeris::initializeWithMappedFile(std::string filename).
+          @throw Exception
+         */
+      int initializeWithMappedFile(std::string filename)
+      {
+         int iret = SolarSystemEphemeris::initializeWithMappedFile(filename);
+         setConventionFromEphemeris();
          return iret;
       }
 
@@ -477,6 +469,31 @@ namespace gnsstk
       }
 
    private:
+         /// If the IERS convention is not defined, set it to the default for
+         /// the ephemeris just loaded; otherwise test it against the ephemeris.
+      void setConventionFromEphemeris()
+      {
+         if (iersconv == IERSConvention::Unknown)
+         {
+            if (EphNumber() == 403)
+            {
+               iersconv = IERSConvention::IERS1996;
+            }
+            else if (EphNumber() == 405)
+            {
+               iersconv = IERSConvention::IERS2010; // the default
+            }
+            else
+            {
+               LOG(ERROR) << "Unknown ephemeris number " << EphNumber();
+            }
+         }
+         else
+         {
+            testIERSvsEphemeris(iersconv, EphNumber());
+         }
+      }
+
          /**
           IERS convention in use with this instance of the class. This is
           determined either by reading the SolarSystemEphemeris number (403 ->
@@ -54,6 +54,14 @@
 #include "StringUtils.hpp"
 #include "TimeConverters.hpp"
 #include "logstream.hpp"
+// system
+#include <cmath>
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 //------------------------------------------------------------------------------------
 using namespace std;
@@ -931,6 +939,13 @@ namespace gnsstk
             return;
          }
 
+            // a mapped ephemeris does not use the stream or current record
+         if (isMapped())
+         {
+            relativePositionVelocity(MJD, target, center, pv, kilometers);
+            return;
+         }
+
             // get the right record from the file
          double JD(MJD + MJD_TO_JD);
          iret = seekToJD(JD);
@@ -964,11 +979,92 @@ namespace gnsstk
             }
          }
 
+            // compute from the current record
+         relativeFromRecord(&coefficients[0], MJD, target, center, pv,
+                            kilometers);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (exception& e)
+      {
+         Exception E("std except: " + string(e.what()));
+         GNSSTK_THROW(E);
+      }
+      catch (...)
+      {
+         Exception e("Unknown exception");
+         GNSSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void SolarSystemEphemeris::relativePositionVelocity(
+               double MJD, SolarSystemEphemeris::Planet target,
+               SolarSystemEphemeris::Planet center, double pv[6],
+               bool kilometers) const
+   {
+      try
+      {
+         for (int i = 0; i < 6; i++)
+            pv[i] = 0.0;
+
+         if (target == center)
+         {
+            return;
+         }
+
+         const double *record;
+         int iret = findMappedRecord(MJD + MJD_TO_JD, record);
+         if (iret == retEarly || iret == retLate)
+         {
+            Exception e(string("Requested time is ") +
+                        (iret == retEarly ? string("before") : string("after")) +
+                        string(" the range spanned by the ephemeris."));
+            GNSSTK_THROW(e);
+         }
+         else if (iret)
+         {
+            Exception e(string("Ephemeris not mapped"));
+            GNSSTK_THROW(e);
+         }
+
+         relativeFromRecord(record, MJD, target, center, pv, kilometers);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (exception& e)
+      {
+         Exception E("std except: " + string(e.what()));
+         GNSSTK_THROW(E);
+      }
+      catch (...)
+      {
+         Exception e("Unknown exception");
+         GNSSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+      // private
+   void SolarSystemEphemeris::relativeFromRecord(
+               const double *record, double MJD,
+               SolarSystemEphemeris::Planet target,
+               SolarSystemEphemeris::Planet center, double pv[6],
+               bool kilometers) const
+   {
+      try
+      {
+         int i;
+
             // compute Nutations or Librations
          if (target == idNutations || target == idLibrations)
          {
-            inertialPositionVelocity(
-               MJD, target == idNutations ? NUTATIONS : LIBRATIONS, pv);
+            evaluateRecord(
+               record, MJD, target == idNutations ? NUTATIONS : LIBRATIONS, pv);
             return;
          }
 
@@ -1003,6 +1099,7 @@ namespace gnsstk
 
             /* Earth and Moon need special treatment - get moon and Earth-moon
                barycenter */
+         const double EMRAT = constants.find("EMRAT")->second;
          double pvmoon[6], pvembary[6], Eratio, Mratio;
 
             // special cases of Earth AND Moon: Moon result is always geocentric
@@ -1019,20 +1116,20 @@ namespace gnsstk
          if ((target == idEarth && center != idMoon) ||
              (center == idEarth && target != idMoon))
          {
-            Eratio = 1.0 / (1.0 + constants["EMRAT"]);
-            inertialPositionVelocity(MJD, MOON, pvmoon);
+            Eratio = 1.0 / (1.0 + EMRAT);
+            evaluateRecord(record, MJD, MOON, pvmoon);
          }
          if ((target == idMoon && center != idEarth) ||
              (center == idMoon && target != idEarth))
          {
-            Mratio = constants["EMRAT"] / (1.0 + constants["EMRAT"]);
-            inertialPositionVelocity(MJD, EMBARY, pvembary);
+            Mratio = EMRAT / (1.0 + EMRAT);
+            evaluateRecord(record, MJD, EMBARY, pvembary);
          }
 
             // compute states for target and center
          double pvtarget[6], pvcenter[6];
-         inertialPositionVelocity(MJD, TARGET, pvtarget);
-         inertialPositionVelocity(MJD, CENTER, pvcenter);
+         evaluateRecord(record, MJD, TARGET, pvtarget);
+         evaluateRecord(record, MJD, CENTER, pvcenter);
 
             /* handle the Earth/Moon special cases
                convert from E-M barycenter to Earth */
@@ -1074,7 +1171,7 @@ namespace gnsstk
 
          if (!kilometers)
          {
-            double AU = constants["AU"];
+            double AU = constants.find("AU")->second;
             for (i = 0; i < 6; i++)
                pv[i] /= AU;
          }
@@ -1166,6 +1263,9 @@ namespace gnsstk
          double AU, EMRAT;
          string word;
 
+            // an earlier initializeWithMappedFile() no longer applies
+         unmapFile();
+
             // open the input binary file
          istrm.open(filename.c_str(), ios::in | ios::binary);
          if (!istrm.is_open())
@@ -1562,10 +1662,19 @@ namespace gnsstk
       // private
    void SolarSystemEphemeris::inertialPositionVelocity(
       double MJD, SolarSystemEphemeris::computeID which, double PV[6])
+   {
+      evaluateRecord(&coefficients[0], MJD, which, PV);
+   }
+
+   //---------------------------------------------------------------------------------
+      // private
+   void SolarSystemEphemeris::evaluateRecord(
+      const double *record, double MJD, SolarSystemEphemeris::computeID which,
+      double PV[6]) const
    {
       try
       {
-         int i, j, i0, ncomp, offset;
+         int i, j, i0, ncomp;
 
          for (i = 0; i < 6; i++)
          {
@@ -1576,12 +1685,12 @@ namespace gnsstk
             return;
          }
 
-            /* coefficients[0,1] give span of JD's in which coefficients[2,...] are
-               applicable coefficients[0,1] are even days JDs - 2452xxx.5 =>
+            /* record[0,1] give span of JD's in which record[2,...] are
+               applicable record[0,1] are even days JDs - 2452xxx.5 =>
                secOfDay() for these == 0. */
          double T, Tbeg, Tspan, Tspan0;
-         Tbeg   = coefficients[0];
-         Tspan0 = Tspan = coefficients[1] - coefficients[0];
+         Tbeg   = record[0];
+         Tspan0 = Tspan = record[1] - record[0];
          i0    = c_offset[which] - 1; // index of first coefficient in array
          ncomp = (which == NUTATIONS ? 2 : 3); // number of components returned
 
@@ -1591,7 +1700,7 @@ namespace gnsstk
             Tspan /= double(c_nsets[which]);
             for (j = c_nsets[which]; j > 0; j--)
             {
-               Tbeg = coefficients[0] + double(j - 1) * Tspan;
+               Tbeg = record[0] + double(j - 1) * Tspan;
                if (MJD > Tbeg - MJD_TO_JD)
                { // == with j==1 is the default
                   i0 += (j - 1) * ncomp * c_ncoeff[which];
@@ -1603,40 +1712,143 @@ namespace gnsstk
             // normalized time
          T = 2.0 * (MJD - (Tbeg - MJD_TO_JD)) / Tspan - 1.0;
 
-            // interpolate
+            /* generate the Chebyshevs and their derivatives once for all
+               components; they live on the stack unless N is unusually large */
+         const int NSTACK = 32;
          int N = c_ncoeff[which];
-         vector<double> C(N, 0.0); // Chebyshev
-         vector<double> U(N, 0.0); // derivative of Chebyshev
-         for (i = 0; i < ncomp; i++)
-         { // loop over components
+         double Cbuf[NSTACK], Ubuf[NSTACK];
+         vector<double> Cvec, Uvec;
+         double *C = Cbuf, *U = Ubuf;
+         if (N > NSTACK)
+         {
+            Cvec.resize(N);
+            Uvec.resize(N);
+            C = &Cvec[0];
+            U = &Uvec[0];
+         }
 
-               // seed the Chebyshev recursions
-            C[0] = 1;
-            C[1] = T; // C[2] = 2*T*T-1;
-            U[0] = 0;
-            U[1] = 1; // U[2] = 4*T;
+            // seed the Chebyshev recursions
+         C[0] = 1;
+         C[1] = T; // C[2] = 2*T*T-1;
+         U[0] = 0;
+         U[1] = 1; // U[2] = 4*T;
+         for (j = 2; j < N; j++)
+         {
+            C[j] = 2 * T * C[j - 1] - C[j - 2];
+            U[j] = 2 * T * U[j - 1] + 2 * C[j - 1] - U[j - 2];
+         }
 
-               // generate the Chebyshevs
-            for (j = 2; j < N; j++)
-            {
-               C[j] = 2 * T * C[j - 1] - C[j - 2];
-               U[j] = 2 * T * U[j - 1] + 2 * C[j - 1] - U[j - 2];
-            }
+         const double vfact = 2 * double(c_nsets[which]) / Tspan0;
+         for (i = 0; i < ncomp; i++)
+         { // loop over components
+            const double *coef = record + i0 + i * N;
 
                // compute P and V
-               // done above PV[i] = PV[i+3] = 0.0;
             for (j = N - 1; j > -1; j--) // POS
             {
-               PV[i] += coefficients[i0 + j + i * N] * C[j];
+               PV[i] += coef[j] * C[j];
             }
             for (j = N - 1; j > 0; j--) // j>0 b/c U[0]=0             // VEL
             {
-               PV[i + ncomp] += coefficients[i0 + j + i * N] * U[j];
+               PV[i + ncomp] += coef[j] * U[j];
             }
 
                // convert velocity to 'per day'
-            PV[i + ncomp] *= 2 * double(c_nsets[which]) / Tspan0;
+            PV[i + ncomp] *= vfact;
+         }
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (exception& e)
+      {
+         Exception E("std except: " + string(e.what()));
+         GNSSTK_THROW(E);
+      }
+      catch (...)
+      {
+         Exception e("Unknown exception");
+         GNSSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   int SolarSystemEphemeris::initializeWithMappedFile(const string& filename)
+   {
+      try
+      {
+         readBinaryHeader(filename);
+         if (EphemerisNumber == -1)
+         {
+            istrm.close();
+            return retEphN;
+         }
+
+            // the data records follow the two header records
+         size_t dataOffset = size_t(istrm.tellg());
+         size_t recBytes   = size_t(Ncoeff) * sizeof(double);
+         istrm.seekg(0, ios_base::end);
+         size_t fileBytes = size_t(istrm.tellg());
+         long nrec = long((fileBytes - dataOffset) / recBytes);
+         if (fileBytes <= dataOffset || nrec == 0)
+         {
+            istrm.close();
+            return retStrm;
+         }
+
+#ifndef WIN32
+         istrm.close();
+         int fd = ::open(filename.c_str(), O_RDONLY);
+         if (fd < 0)
+         {
+            return retStrm;
+         }
+         void *base = ::mmap(nullptr, fileBytes, PROT_READ, MAP_SHARED, fd, 0);
+         ::close(fd);
+         if (base == MAP_FAILED)
+         {
+            return retStrm;
+         }
+         mappedBase   = base;
+         mappedLength = fileBytes;
+         mappedData = reinterpret_cast<const double *>(
+            static_cast<const char *>(base) + dataOffset);
+#else
+            // no mmap(): read all the data records into one contiguous buffer
+         mappedBuffer.resize(size_t(nrec) * Ncoeff);
+         istrm.seekg(dataOffset, ios_base::beg);
+         readBinary((char *)&mappedBuffer[0], size_t(nrec) * recBytes);
+         istrm.close();
+         mappedData = &mappedBuffer[0];
+#endif
+         mappedRecords = nrec;
+         mappedStartJD = mappedData[0];
+
+            // records must be contiguous and at the fixed interval, so that
+            // findMappedRecord() can index them directly
+         for (long n = 0; n < nrec; n++)
+         {
+            const double *rec = mappedData + n * Ncoeff;
+            if (rec[0] != mappedStartJD + double(n) * interval ||
+                rec[1] != rec[0] + interval)
+            {
+               ostringstream oss;
+               oss << "ERROR: record " << n + 1 << fixed << setprecision(6)
+                   << " spans " << rec[0] << " to " << rec[1]
+                   << ", not the fixed interval " << interval << " from "
+                   << mappedStartJD;
+               unmapFile();
+               Exception e(oss.str());
+               GNSSTK_THROW(e);
+            }
          }
+
+         EphemerisNumber = int(constants["DENUM"]);
+         LOG(DEBUG) << "initializeWithMappedFile maps " << nrec
+                    << " records, EphemerisNumber " << EphemerisNumber;
+
+         return 0;
       }
       catch (Exception& e)
       {
@@ -1654,5 +1866,61 @@ namespace gnsstk
       }
    }
 
+   //---------------------------------------------------------------------------------
+      // private
+   int SolarSystemEphemeris::findMappedRecord(double JD,
+                                              const double *& record) const
+   {
+      if (mappedData == nullptr)
+      {
+         return retEphN;
+      }
+      if (JD < mappedStartJD)
+      {
+         return retEarly;
+      }
+
+      long n = long(std::floor((JD - mappedStartJD) / interval));
+         // the end time of the last record belongs to that record
+      if (n >= mappedRecords)
+      {
+         n = mappedRecords - 1;
+      }
+      record = mappedData + n * Ncoeff;
+
+         // guard against rounding in the division at record boundaries
+      if (JD < record[0] && n > 0)
+      {
+         record -= Ncoeff;
+      }
+      else if (JD > record[1])
+      {
+         if (n + 1 >= mappedRecords)
+         {
+            return retLate;
+         }
+         record += Ncoeff;
+      }
+
+      return 0;
+   }
+
+   //---------------------------------------------------------------------------------
+      // private
+   void SolarSystemEphemeris::unmapFile()
+   {
+#ifndef WIN32
+      if (mappedBase != nullptr)
+      {
+         ::munmap(mappedBase, mappedLength);
+      }
+#endif
+      mappedBase   = nullptr;
+      mappedLength = 0;
+      mappedData   = nullptr;
+      mappedRecords = 0;
+      mappedBuffer.clear();
+   }
+
    //---------------------------------------------------------------------------------
 } // end namespace gnsstk
@@ -133,7 +133,16 @@ namespace gnsstk
           Constructor. Set EphemerisNumber to -1 to indicate that nothing has
           been read yet.
          */
-      SolarSystemEphemeris() : EphemerisNumber(-1){};
+      SolarSystemEphemeris()
+            : EphemerisNumber(-1), mappedData(nullptr), mappedRecords(0),
+              mappedStartJD(0.0), mappedBase(nullptr), mappedLength(0)
+      {
+      }
+
+         /** Destructor. Release the mapping made by
+          initializeWithMappedFile(). Objects can't be copied or assigned, as
+          they own the mapping and the input stream. */
+      ~SolarSystemEphemeris() { unmapFile(); }
 
       //------------------------------------------------------------------
       // reading and writing ASCII (JPL) files
@@ -240,6 +249,29 @@ namespace gnsstk
          */
       int initializeWithBinaryFile(const std::string& filename);
 
+         /**
+          Open the given binary file, read the header and memory-map the data
+          records, as an alternative to initializeWithBinaryFile(). Records
+          are required to be contiguous and of length 'interval', so the record
+          for any time is located by direct arithmetic, and the Chebyshev
+          series are evaluated in place in the mapped data; nothing is copied
+          and no member data is modified while computing, so that
+          relativePositionVelocity() may be called concurrently from many
+          threads. Where mmap() is not available the data records are read
+          into a single contiguous buffer instead.
+          @param filename  name of binary file to be mapped.
+          @return 0 success,
+                 -3 the file could not be mapped or contains no data records,
+                 -4 header could not be read.
+          @throw Exception if the records are not contiguous or not at the
+                 fixed interval given in the header.
+         */
+      int initializeWithMappedFile(const std::string& filename);
+
+         /// @return true if the ephemeris was initialized with
+         /// initializeWithMappedFile().
+      bool isMapped() const { return mappedData != nullptr; }
+
       //------------------------------------------------------------------
       // utilizing the ephemeris
 
@@ -280,6 +312,17 @@ namespace gnsstk
                                             Planet center, double PV[6],
                                             bool kilometers = true);
 
+         /**
+          Const, thread-safe version of relativeInertialPositionVelocity(),
+          available only after initializeWithMappedFile(); arguments and
+          results are identical.
+          @throw Exception if the ephemeris is not mapped, or if the given
+          time is outside the range spanned by the ephemeris.
+         */
+      void relativePositionVelocity(double MJD, Planet target, Planet center,
+                                    double PV[6],
+                                    bool kilometers = true) const;
+
          /**
           Return the value of 1 AU (Astronomical Unit) in km. If the file header
           has not been read, return -1.0.
@@ -446,6 +489,39 @@ namespace gnsstk
          */
       void inertialPositionVelocity(double MJD, computeID which, double PV[6]);
 
+         /**
+          Evaluate the Chebyshev series for one body in the given data record
+          (Ncoeff doubles, as in coefficients); this is the computation behind
+          inertialPositionVelocity(), which passes the current record.
+          @param  record  data record whose time limits include MJD.
+          @param  MJD     time (Modified Julian Date) of interest (system TDB).
+          @param  which   computeID of the body of interest.
+          @param  PV      double(6) array containing the inertial position and
+                            velocity relative to the solar system barycenter.
+         */
+      void evaluateRecord(const double *record, double MJD, computeID which,
+                          double PV[6]) const;
+
+         /**
+          Compute position and velocity of target relative to center from a
+          single data record; the body of relativeInertialPositionVelocity().
+         */
+      void relativeFromRecord(const double *record, double MJD, Planet target,
+                              Planet center, double PV[6],
+                              bool kilometers) const;
+
+         /**
+          Find the mapped data record whose time limits include JD.
+          @param JD     the time (Julian Date) of interest
+          @param record on success, points to the record.
+          @return 0 success, -1 before the first record, -2 after the last,
+                 -4 the ephemeris is not mapped.
+         */
+      int findMappedRecord(double JD, const double *& record) const;
+
+         /// Release the mapping or buffer made by initializeWithMappedFile().
+      void unmapFile();
+
       //------------------------------------------------------------------
       // member data
 
@@ -533,6 +609,24 @@ namespace gnsstk
          */
       std::vector<double> coefficients;
 
+         /**
+          First data record of the ephemeris mapped by
+          initializeWithMappedFile(), or null. Record i starts at
+          mappedData + i*Ncoeff and covers mappedStartJD + i*interval.
+         */
+      const double *mappedData;
+      long mappedRecords;   ///< number of records at mappedData
+      double mappedStartJD; ///< start time (JD) of the first mapped record
+      void *mappedBase;     ///< return value of mmap(), or null
+      size_t mappedLength;  ///< length of the mapping in bytes
+         /// holds the data records where mmap() is not available
+      std::vector<double> mappedBuffer;
+
+   private:
+         // Not copyable, as it may own a mapping or a stream.
+      SolarSystemEphemeris(const SolarSystemEphemeris&);
+      SolarSystemEphemeris& operator=(const SolarSystemEphemeris&);
+
    }; // end class SolarSystemEphemeris
 
 } // end namespace gnsstk
@@ -0,0 +1,281 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file StationDisplacement.cpp
+    class gnsstk::StationDisplacement computes the tidal displacements of many
+    sites over many epochs, sharing the per-epoch work among the sites.
+*/
+
+//------------------------------------------------------------------------------------
+#include "StationDisplacement.hpp"
+#include <cmath>
+#include "GNSSconstants.hpp"
+#include "SolidEarthTides.hpp"
+#include "SunEarthSatGeometry.hpp"
+
+//------------------------------------------------------------------------------------
+using namespace std;
+
+namespace gnsstk
+{
+   //---------------------------------------------------------------------------------
+   int StationDisplacement::addSite(const string& name, const Position& pos)
+   {
+      try
+      {
+         Position p(pos);
+         p.transformTo(Position::Cartesian);
+         Matrix<double> R(northEastUpGeodetic(p));
+
+            // R has rows N,E,U in XYZ; store its transpose, NEU to XYZ
+         for (int i = 0; i < 3; i++)
+         {
+            for (int j = 0; j < 3; j++)
+            {
+               rotations.push_back(R(j, i));
+            }
+         }
+         names.push_back(name);
+         positions.push_back(p);
+         oceanHarm.push_back(vector<double>());
+         atmCoeff.push_back(vector<double>());
+
+         return int(names.size()) - 1;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   int StationDisplacement::setOceanLoading(OceanLoadTides& store)
+   {
+      try
+      {
+         int n(0);
+         for (size_t i = 0; i < names.size(); i++)
+         {
+            oceanHarm[i].clear();
+            if (store.isValid(names[i]))
+            {
+               store.getHarmonics(names[i], oceanHarm[i]);
+               n++;
+            }
+         }
+         return n;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   int StationDisplacement::setAtmLoading(const AtmLoadTides& store)
+   {
+      int n(0);
+      for (size_t i = 0; i < names.size(); i++)
+      {
+         atmCoeff[i].clear();
+         try
+         {
+            const vector<double>& c(store.getCoefficients(names[i]));
+            for (size_t k = 0; k < c.size(); k++)
+            {
+               atmCoeff[i].push_back(c[k] / 1000.0); // mm to m
+            }
+            n++;
+         }
+         catch (Exception&)
+         { // site not in the store
+         }
+      }
+      return n;
+   }
+
+   //---------------------------------------------------------------------------------
+   void StationDisplacement::computeEpoch(const EpochData& ed, double *disp,
+                                          unsigned effects) const
+   {
+      try
+      {
+         const int nsites(int(names.size()));
+         int i, j, k;
+
+            // per-epoch arguments of the loading tides
+         vector<double> cosArg, sinArg;
+         if (effects & OceanLoading)
+         {
+            OceanLoadTides::tideArguments(ed.time, cosArg, sinArg);
+         }
+         double atmArg[4] = {0.0, 0.0, 0.0, 0.0};
+         if (effects & AtmLoading)
+         {
+            EphTime ttag(ed.time);
+            ttag.convertSystemTo(TimeSystem::UTC);
+            ttag += ed.UT1mUTC;
+            const double dayfr(ttag.secOfDay() / 86400.0);
+            atmArg[0] = ::cos(2 * PI * dayfr);
+            atmArg[1] = ::sin(2 * PI * dayfr);
+            atmArg[2] = ::cos(4 * PI * dayfr);
+            atmArg[3] = ::sin(4 * PI * dayfr);
+         }
+         const int nharm(OceanLoadTides::numberOfHarmonics());
+
+         for (j = 0; j < nsites; j++)
+         {
+            double *d = disp + 3 * j;
+            d[0] = d[1] = d[2] = 0.0;
+
+            if (effects & SolidTide)
+            {
+               Triple t = computeSolidEarthTides(positions[j], ed.time, ed.sun,
+                                                 ed.moon, EMRAT, SERAT, iers);
+               for (k = 0; k < 3; k++)
+                  d[k] += t[k];
+            }
+            if (effects & PolarTide)
+            {
+               Triple t = computePolarTides(positions[j], ed.time, ed.xp, ed.yp,
+                                            iers);
+               for (k = 0; k < 3; k++)
+                  d[k] += t[k];
+            }
+
+               // loading displacements are in NEU
+            double neu[3] = {0.0, 0.0, 0.0};
+            bool haveNEU(false);
+            if ((effects & OceanLoading) && !oceanHarm[j].empty())
+            {
+               const double *h = &oceanHarm[j][0];
+               for (k = 0; k < 3; k++)
+               {
+                  const double *hc = h + 2 * k * nharm, *hs = hc + nharm;
+                  double sum(0.0);
+                  for (i = 0; i < nharm; i++)
+                  {
+                     sum += hc[i] * cosArg[i] + hs[i] * sinArg[i];
+                  }
+                  neu[k] += sum;
+               }
+               haveNEU = true;
+            }
+            if ((effects & AtmLoading) && !atmCoeff[j].empty())
+            {
+                  // coefficient rows are U, N, E
+               const double *c = &atmCoeff[j][0];
+               for (k = 0; k < 4; k++)
+               {
+                  neu[2] += c[k] * atmArg[k];
+                  neu[0] += c[4 + k] * atmArg[k];
+                  neu[1] += c[8 + k] * atmArg[k];
+               }
+               haveNEU = true;
+            }
+            if (haveNEU)
+            {
+               const double *R = &rotations[9 * j];
+               for (k = 0; k < 3; k++)
+               {
+                  d[k] += R[3 * k] * neu[0] + R[3 * k + 1] * neu[1] +
+                          R[3 * k + 2] * neu[2];
+               }
+            }
+         }
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (exception& e)
+      {
+         Exception E("std except: " + string(e.what()));
+         GNSSTK_THROW(E);
+      }
+      catch (...)
+      {
+         Exception e("Unknown exception");
+         GNSSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void StationDisplacement::compute(SolarSystem& ss, const vector<EphTime>& times,
+                                     vector<double>& disp, unsigned effects)
+   {
+      try
+      {
+         iers  = ss.getConvention();
+         EMRAT = ss.ratioEarthToMoonMass();
+         SERAT = ss.ratioSunToEarthMass();
+
+         const size_t nsites(names.size());
+         disp.assign(3 * nsites * times.size(), 0.0);
+         if (nsites == 0)
+            return;
+
+         EpochData ed;
+         for (size_t i = 0; i < times.size(); i++)
+         {
+            ed.time = times[i];
+            if (effects & SolidTide)
+            {
+               ed.sun  = ss.solarPosition(times[i]);
+               ed.moon = ss.lunarPosition(times[i]);
+            }
+            ed.xp = ed.yp = ed.UT1mUTC = 0.0;
+            if (effects & (PolarTide | AtmLoading))
+            {
+               EphTime ttag(times[i]);
+               ttag.convertSystemTo(TimeSystem::UTC);
+               EarthOrientation eo = ss.getEOP(ttag.dMJD());
+               ed.xp      = eo.xp;
+               ed.yp      = eo.yp;
+               ed.UT1mUTC = eo.UT1mUTC;
+            }
+            computeEpoch(ed, &disp[3 * nsites * i], effects);
+         }
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+} // end namespace gnsstk
@@ -0,0 +1,200 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file StationDisplacement.hpp
+    class gnsstk::StationDisplacement computes the tidal displacements of many
+    sites over many epochs, sharing the per-epoch work among the sites. */
+
+#ifndef CLASS_STATIONDISPLACEMENT_INCLUDE
+#define CLASS_STATIONDISPLACEMENT_INCLUDE
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <string>
+#include <vector>
+// GNSSTk
+#include "AtmLoadTides.hpp"
+#include "EphTime.hpp"
+#include "Exception.hpp"
+#include "IERSConvention.hpp"
+#include "OceanLoadTides.hpp"
+#include "Position.hpp"
+#include "SolarSystem.hpp"
+
+//------------------------------------------------------------------------------------
+namespace gnsstk
+{
+
+      /**
+       Site displacement engine for networks of stations. Combines the solid
+       Earth tide (computeSolidEarthTides()), the pole tide
+       (computePolarTides()), ocean loading (OceanLoadTides) and atmospheric
+       loading (AtmLoadTides) for a list of sites, and evaluates them on a
+       list of epochs.
+
+       Used one site and one epoch at a time, these models repeat a lot of
+       work: each call to OceanLoadTides::computeDisplacement() derives the
+       342 tides from the 11 standard ones with cubic splines, three times,
+       and every site needs the same Sun, Moon and EOP at each epoch. Here the
+       site-specific part of ocean loading is reduced once, by
+       OceanLoadTides::getHarmonics(), to cosine and sine coefficients of the
+       342 astronomical arguments; at each epoch those arguments, the Sun and
+       Moon positions, the EOPs and the atmospheric tide arguments are computed
+       once and applied to all the sites.
+
+       Sites are added with addSite(); the loading stores are then attached
+       with setOceanLoading() and setAtmLoading(), which copy what is needed,
+       so the stores need not outlive this object. A site that is not found
+       in a loading store gets no displacement from that effect. The results
+       are ECEF XYZ displacements in meters, in contiguous arrays of
+       3*numberOfSites() doubles per epoch.
+      */
+   class StationDisplacement
+   {
+   public:
+         /// Bit flags selecting the effects to compute
+      enum Effect
+      {
+         SolidTide    = 1,
+         PolarTide    = 2,
+         OceanLoading = 4,
+         AtmLoading   = 8,
+         AllEffects   = 15
+      };
+
+         /// Everything that is common to all sites at one epoch
+      struct EpochData
+      {
+         EphTime time;       ///< time of interest
+         Position sun;       ///< ECEF position of the Sun (m)
+         Position moon;      ///< ECEF position of the Moon (m)
+         double xp, yp;      ///< polar motion (arcsec)
+         double UT1mUTC;     ///< UT1-UTC (seconds)
+      };
+
+         /// Constructor
+      StationDisplacement(IERSConvention conv = IERSConvention::IERS2010)
+            : iers(conv), EMRAT(81.30056), SERAT(332946.050894783285912)
+      {}
+
+         /// Set the IERS convention used by the solid Earth and pole tides.
+      void setConvention(const IERSConvention& conv) { iers = conv; }
+
+         /// Set the Earth-to-Moon and Sun-to-Earth mass ratios (default DE405).
+      void setMassRatios(double emrat, double serat)
+      {
+         EMRAT = emrat;
+         SERAT = serat;
+      }
+
+         /**
+          Add a site; call before setOceanLoading() and setAtmLoading().
+          @param name  site name, as used in the loading files.
+          @param pos   nominal position of the site.
+          @return index of the site in the output arrays.
+         */
+      int addSite(const std::string& name, const Position& pos);
+
+         /// @return the number of sites
+      int numberOfSites() const { return int(names.size()); }
+
+         /// @return the name of the site at index i
+      const std::string& getName(int i) const { return names[i]; }
+
+         /**
+          Copy the ocean loading harmonics of every site found in the store.
+          @return the number of sites found.
+          @throw Exception if OceanLoadTides::getHarmonics() fails.
+         */
+      int setOceanLoading(OceanLoadTides& store);
+
+         /**
+          Copy the atmospheric loading coefficients of every site found in the
+          store.
+          @return the number of sites found.
+         */
+      int setAtmLoading(const AtmLoadTides& store);
+
+         /**
+          Compute the displacement of every site at one epoch.
+          @param ed       Sun, Moon and EOP at the epoch.
+          @param disp     output array of 3*numberOfSites() doubles, the ECEF
+                          XYZ displacement of each site in turn (m).
+          @param effects  OR of Effect flags.
+          @throw Exception if the time system is unknown.
+         */
+      void computeEpoch(const EpochData& ed, double *disp,
+                        unsigned effects = AllEffects) const;
+
+         /**
+          Compute the displacement of every site at every epoch. The Sun, Moon
+          and EOP come from the SolarSystem object, as do the IERS convention
+          and the mass ratios, which replace those of this object.
+          @param ss       SolarSystem with ephemeris and EOPs covering times.
+          @param times    epochs of interest.
+          @param disp     output, 3*numberOfSites()*times.size() doubles;
+                          component k of site j at epoch i is at
+                          disp[3*(i*numberOfSites()+j)+k] (m).
+          @param effects  OR of Effect flags.
+          @throw Exception if the ephemeris or EOPs do not cover the times.
+         */
+      void compute(SolarSystem& ss, const std::vector<EphTime>& times,
+                   std::vector<double>& disp, unsigned effects = AllEffects);
+
+   private:
+      IERSConvention iers; ///< used by solid Earth and pole tides
+      double EMRAT;        ///< Earth-to-Moon mass ratio
+      double SERAT;        ///< Sun-to-Earth mass ratio
+
+      std::vector<std::string> names;  ///< site names
+      std::vector<Position> positions; ///< nominal site positions
+
+         /// per site, the rotation from NEU to ECEF XYZ, row major
+      std::vector<double> rotations;
+
+         /// per site, OceanLoadTides::getHarmonics(), or empty
+      std::vector<std::vector<double>> oceanHarm;
+
+         /// per site, AtmLoadTides::getCoefficients() in m, or empty
+      std::vector<std::vector<double>> atmCoeff;
+
+   }; // end class StationDisplacement
+
+} // end namespace gnsstk
+
+#endif // CLASS_STATIONDISPLACEMENT_INCLUDE
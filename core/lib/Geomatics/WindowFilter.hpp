@@ -43,15 +43,17 @@
        This class implements a statistical filter that uses 'windowed' averages.
     There are several statistical filters implemented as classes. These classes are
     templates; the template parameter should be a float (probably double);
-    it is used to construct gnsstk::Stats<T>, gnsstk::TwoSampleStats<T> and
-    gnsstk::SeqStats<T>, which are fundamental to these algorithms.
+    it is used to construct gnsstk::SlidingStats<T>, gnsstk::Stats<T> and
+    gnsstk::TwoSampleStats<T>, which are fundamental to these algorithms.
        All the filters look for outliers and discontinuities (slips) in a timeseries.
     The first difference filter analyses the simple first difference of the
     data. The window filter uses a 2-pane sliding window centered on the data
     point in question; statistics on the data in each to the 2 panes are
     computed and used in the analysis.
-       The window filter uses 1- and 2-sample statistics in Stats.hpp, along with a
-    wrapper class (StatsFilterBase, this module) that provides a single
+       The window filter uses 1- and 2-sample statistics in SlidingStats.hpp,
+    which are updated in O(1) as points move through the window and are
+    accurate for long series and large xdata, along with a wrapper class
+    (StatsFilterBase, this module) that provides a single
     interface for the two statistics, allowing WindowFilter::filter() to use
     either type of filter interchangably. Two-sample stats are used when an
     xdata array ("time") is given along with the data array; this is appropriate
@@ -91,7 +93,9 @@
     need to call the constructor again. */
 
 #include "RobustStats.hpp"
+#include "SlidingStats.hpp"
 #include "Stats.hpp"
+#include <algorithm>
 #include <deque>
 #include <vector>
 //#include "StringUtils.hpp"       // TEMP
@@ -187,10 +191,10 @@ namespace gnsstk
       inline unsigned int N() const { return S.N(); }
 
          /// Add data to the statistics; in 1-sample stats the x is ignored
-      void Add(const T& x, const T& y) { S.Add(y); }
+      void Add(const T& x, const T& y) { S.Add(T(), y); }
 
          /// Subtract data from the statistics; in 1-sample stats the x is ignored
-      void Subtract(const T& x, const T& y) { S.Subtract(y); }
+      void Subtract(const T& x, const T& y) { S.Subtract(T(), y); }
 
          /// return computed standard deviation
       T StdDev() const { return S.StdDev(); }
@@ -223,7 +227,7 @@ namespace gnsstk
       std::string asString() const { return S.asString(); }
 
    private:
-      gnsstk::Stats<T> S;
+      gnsstk::SlidingStats<T> S;
 
    }; // end class OneSampleStatsFilter
 
@@ -282,7 +286,7 @@ namespace gnsstk
       std::string asString() const { return TSS.asString(); }
 
    private:
-      gnsstk::TwoSampleStats<T> TSS;
+      gnsstk::SlidingStats<T> TSS;
 
    }; // end class TwoSampleStatsFilter
 
@@ -488,6 +492,12 @@ namespace gnsstk
          */
       std::vector<Analysis> analvec;
 
+         /// comparison for the binary search of analvec by index
+      static bool lessIndex(const Analysis& A, unsigned int index)
+      {
+         return A.index < index;
+      }
+
    public:
          /**
           vector of FilterHit, generated and returned by analyze();
@@ -1453,20 +1463,15 @@ namespace gnsstk
          return;
       }
 
-      bool notfound(true);
-      for (i = 0; i < analvec.size(); i++)
-      {
-         if (analvec[i].index == sg.index)
-         {
-            j        = i;
-            notfound = false;
-            break;
-         }
-      }
-      if (notfound)
+      // analvec is filled in order of index
+      typename std::vector<Analysis>::const_iterator it =
+         std::lower_bound(analvec.begin(), analvec.end(), sg.index,
+                          lessIndex);
+      if (it == analvec.end() || it->index != sg.index)
       {
          return;
       }
+      j = it - analvec.begin();
 
       // stats on sigma       // TD would like the same for step....how to
       // implement
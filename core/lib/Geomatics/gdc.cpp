@@ -47,6 +47,7 @@
 #include "gdc.hpp"
 #include "GNSSconstants.hpp"
 #include "logstream.hpp"
+#include "parallel_for.hpp"
 #include "stl_helpers.hpp"
 
 using namespace std;
@@ -240,6 +241,40 @@ namespace gnsstk
       }
    } // end int gdc::DiscontinuityCorrector(SatPass& SP, string& retMsg, int GLOn)
 
+   //---------------------------------------------------------------------------------
+      // Call DC(SatPass) for a list of SatPass, each on a copy of this gdc
+   vector<int> gdc::DiscontinuityCorrector(vector<SatPass>& SPList,
+                                           vector<string>& retMsgs,
+                                           vector<vector<string> >& cmds,
+                                           unsigned nthreads)
+   {
+      try
+      {
+         vector<int> iret(SPList.size(), 0);
+         retMsgs = vector<string>(SPList.size());
+         cmds    = vector<vector<string> >(SPList.size());
+
+         parallelFor(SPList.size(), nthreads, [&](size_t i) {
+            gdc worker(*this);
+            worker.ForceUniqueNumber(unique + i);
+            iret[i] = worker.DiscontinuityCorrector(SPList[i], retMsgs[i],
+                                                    cmds[i]);
+         });
+         unique += SPList.size();
+
+         return iret;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (std::exception& e)
+      {
+         Exception E("std except: " + string(e.what()));
+         GNSSTK_THROW(E);
+      }
+   } // end gdc::DiscontinuityCorrector(vector<SatPass>&, ...)
+
    //---------------------------------------------------------------------------------
       /* Call to DC without SatPass.
          Flags on input must be either 1(OK) or 0(BAD), as in SatPass */
@@ -465,6 +465,27 @@ namespace gnsstk
                                  std::vector<std::string>& cmds,
                                  int GLOn = -99);
 
+      //---------------------------------------------------------------------------
+         /**
+          Call DiscontinuityCorrector(SatPass&,...) for each SatPass in a list,
+          using up to nthreads threads. Each pass is processed by a copy of
+          this object, so all use the current configuration, and the results
+          are those of calling DiscontinuityCorrector() on each pass in turn,
+          except that pass i always gets the unique number
+          getUniqueNumber()+i+1. Only the order of the output may differ; at
+          high debug levels lines from different passes may be interleaved.
+          On return the unique number has been increased by SPList.size().
+          @param SPList   SatPass objects to process, corrected in place.
+          @param retMsgs  returned, retMsg for each pass, parallel to SPList
+          @param cmds     returned, editing commands for each pass
+          @param nthreads number of threads, 0 for one per hardware thread
+          @return return values of DiscontinuityCorrector() for each pass
+          @throw Exception the first exception thrown by any pass
+         */
+      std::vector<int> DiscontinuityCorrector(
+         std::vector<SatPass>& SPList, std::vector<std::string>& retMsgs,
+         std::vector<std::vector<std::string> >& cmds, unsigned nthreads = 0);
+
       //---------------------------------------------------------------------------
          /**
           Overloaded version that accepts input data in parallel arrays.
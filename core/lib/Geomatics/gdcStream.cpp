@@ -0,0 +1,407 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file gdcStream.cpp GNSSTk Discontinuity Corrector, streaming version.
+    Detect and fix cycle slips in dual-frequency phase data one epoch at a
+    time, with a latency of a few epochs, for real-time processing.
+*/
+
+#include "gdcStream.hpp"
+#include <algorithm>
+#include <cmath>
+#include "FreqConsts.hpp"
+#include "StringUtils.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+   //---------------------------------------------------------------------------------
+      /* Classify the candidate point, given its residual rc from the window
+         prediction and the residuals rf of the following points.
+         A slip requires the future to be offset (median beyond the threshold
+         for a mean) and the candidate to be nearer the new level than the old
+         one; otherwise the candidate alone is tested against the threshold
+         for one point.
+         return 0 for good, 1 for outlier, 2 for slip, with step */
+   static int classify(double rc, const vector<double>& rf, double fineStep,
+                       double sig, double nsig, int npast, double& step)
+   {
+      double thrPoint = std::max(fineStep, nsig * sig);
+      if (rf.size() > 0)
+      {
+         double thrMean = std::max(
+            fineStep, nsig * sig * ::sqrt(1.0 / rf.size() + 1.0 / npast));
+         vector<double> srt(rf);
+         sort(srt.begin(), srt.end());
+         size_t n = srt.size();
+         double med = (n % 2 ? srt[n / 2] : 0.5 * (srt[n / 2 - 1] + srt[n / 2]));
+         if (::fabs(med) > thrMean && ::fabs(rc - med) < ::fabs(rc))
+         {
+               // average the points that are at the new level
+            double sum(rc);
+            int cnt(1);
+            for (size_t i = 0; i < rf.size(); i++)
+            {
+               if (::fabs(rf[i] - med) < ::fabs(rf[i]))
+               {
+                  sum += rf[i];
+                  cnt++;
+               }
+            }
+            step = sum / cnt;
+            return 2;
+         }
+      }
+      return (::fabs(rc) > thrPoint ? 1 : 0);
+   }
+
+   //---------------------------------------------------------------------------------
+   gdcStream::gdcStream(double DT)
+         : dt(DT), MaxGap(10), width(20), lookahead(5), WLfineStep(0.7),
+           GFfineStep(0.7), nsigma(4.0)
+   {
+   }
+
+   //---------------------------------------------------------------------------------
+   bool gdcStream::setParameter(const string& label, double value)
+   {
+      if (label == "MaxGap")
+         MaxGap = int(value);
+      else if (label == "width")
+      {
+            // a fit needs at least three points
+         if (value < 3)
+         {
+            InvalidParameter ip("gdcStream: width must be at least 3, not " +
+                                StringUtils::asString(value));
+            GNSSTK_THROW(ip);
+         }
+         width = int(value);
+      }
+      else if (label == "lookahead")
+      {
+         if (value < 0)
+         {
+            InvalidParameter ip("gdcStream: lookahead must not be negative,"
+                                " not " + StringUtils::asString(value));
+            GNSSTK_THROW(ip);
+         }
+         lookahead = int(value);
+      }
+      else if (label == "WLfineStep")
+         WLfineStep = value;
+      else if (label == "GFfineStep")
+         GFfineStep = value;
+      else if (label == "nsigma")
+         nsigma = value;
+      else
+         return false;
+      return true;
+   }
+
+   //---------------------------------------------------------------------------------
+   double gdcStream::getParameter(const string& label) const
+   {
+      if (label == "MaxGap")
+         return MaxGap;
+      if (label == "width")
+         return width;
+      if (label == "lookahead")
+         return lookahead;
+      if (label == "WLfineStep")
+         return WLfineStep;
+      if (label == "GFfineStep")
+         return GFfineStep;
+      if (label == "nsigma")
+         return nsigma;
+      Exception e("gdcStream: unknown parameter " + label);
+      GNSSTK_THROW(e);
+   }
+
+   //---------------------------------------------------------------------------------
+   void gdcStream::add(const RinexSatID& sat, const Epoch& t, double L1,
+                       double L2, double P1, double P2, vector<Decision>& out,
+                       bool ok)
+   {
+      try
+      {
+         SatState& st(states[sat]);
+         if (!st.init)
+         {
+            int chan(0);
+            if (sat.system == SatelliteSystem::Glonass)
+            {
+               map<RinexSatID, int>::const_iterator it = GLOchan.find(sat);
+               if (it == GLOchan.end())
+               {
+                  Exception e("gdcStream: GLONASS channel not set for " +
+                              sat.toString());
+                  GNSSTK_THROW(e);
+               }
+               chan = it->second;
+            }
+               // as in gdc
+            st.wl1  = getWavelength(sat.system, 1, chan);
+            st.wl2  = getWavelength(sat.system, 2, chan);
+            st.beta = getBeta(sat.system, 1, 2);
+            double alpha = getAlpha(sat.system, 1, 2);
+            if (st.wl1 == 0.0 || st.wl2 == 0.0 || alpha == 0.0)
+            {
+               Exception e("gdcStream: no L1/L2 frequencies for " +
+                           sat.toString());
+               GNSSTK_THROW(e);
+            }
+            st.wlWL     = st.wl2 * (st.beta + 1.0) / alpha;
+            st.wlGF     = st.wl2 - st.wl1;
+            st.lastTime = t;
+            st.init     = true;
+         }
+         else if (t <= st.lastTime)
+         {
+            Exception e("gdcStream: time tags must increase for " +
+                        sat.toString());
+            GNSSTK_THROW(e);
+         }
+         st.lastTime = t;
+
+         Pending p;
+         p.time = t;
+         p.x = p.WL = p.GF = 0.0;
+         p.mark = 0;
+         p.good = (ok && L1 != 0.0 && L2 != 0.0 && P1 != 0.0 && P2 != 0.0);
+
+            // a large gap ends the Arc; check on bad points too, so that
+            // a long run of them can't hold back the decisions
+         if (st.inArc && (t - st.lastGood) / dt - 1.0 > MaxGap + 1.e-6)
+         {
+            while (decide(sat, st, out, true))
+               ;
+            st.inArc = false;
+            st.window.clear();
+         }
+
+         if (p.good)
+         {
+               // WLC = (WLphase - NLrange) in units of WLwl; LGF in GFwl
+            double wl1(st.wl1), wl2(st.wl2), beta(st.beta);
+            double WL = ((beta * wl1 * L1 - wl2 * L2) / (beta - 1.0) -
+                         (beta * P1 + P2) / (beta + 1.0)) / st.wlWL;
+            double GF = (wl1 * L1 - wl2 * L2) / st.wlGF;
+            if (!st.inArc)
+            {
+               st.inArc    = true;
+               st.arcBegin = t;
+               st.WLbias   = WL;
+               st.GFbias   = GF;
+               st.WLfix = st.GFfix = 0.0;
+               p.mark      = Arc::BEG;
+            }
+            p.x         = t - st.arcBegin;
+            p.WL        = WL - st.WLbias;
+            p.GF        = GF - st.GFbias;
+            st.lastGood = t;
+         }
+         st.pending.push_back(p);
+
+         while (decide(sat, st, out, false))
+            ;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void gdcStream::flush(const RinexSatID& sat, vector<Decision>& out)
+   {
+      map<RinexSatID, SatState>::iterator it = states.find(sat);
+      if (it == states.end())
+         return;
+      while (decide(sat, it->second, out, true))
+         ;
+      it->second.inArc = false;
+      it->second.window.clear();
+   }
+
+   //---------------------------------------------------------------------------------
+   void gdcStream::flush(vector<Decision>& out)
+   {
+      map<RinexSatID, SatState>::iterator it;
+      for (it = states.begin(); it != states.end(); ++it)
+         flush(it->first, out);
+   }
+
+   //---------------------------------------------------------------------------------
+   void gdcStream::fitWindow(const SatState& st, double& WL0, double& WLsig,
+                             double& GF0, double& GFrate, double& GFsig,
+                             double& xref) const
+   {
+      const int n(st.window.size());
+      double sx(0.0), sw(0.0), sg(0.0);
+      for (int i = 0; i < n; i++)
+      {
+         sx += st.window[i].x;
+         sw += st.window[i].WL;
+         sg += st.window[i].GF;
+      }
+      xref = sx / n;
+      WL0  = sw / n;
+      GF0  = sg / n;
+
+      double sww(0.0), sxx(0.0), sxg(0.0);
+      for (int i = 0; i < n; i++)
+      {
+         double dx(st.window[i].x - xref), dw(st.window[i].WL - WL0);
+         sww += dw * dw;
+         sxx += dx * dx;
+         sxg += dx * (st.window[i].GF - GF0);
+      }
+      WLsig  = ::sqrt(sww / (n - 1));
+      GFrate = (sxx > 0.0 ? sxg / sxx : 0.0);
+
+      double sgg(0.0);
+      for (int i = 0; i < n; i++)
+      {
+         double r = st.window[i].GF - GF0 - GFrate * (st.window[i].x - xref);
+         sgg += r * r;
+      }
+      GFsig = (n > 2 ? ::sqrt(sgg / (n - 2)) : 0.0);
+   }
+
+   //---------------------------------------------------------------------------------
+   bool gdcStream::decide(const RinexSatID& sat, SatState& st,
+                          vector<Decision>& out, bool flushing)
+   {
+      if (st.pending.empty())
+         return false;
+
+      const Pending& c(st.pending.front());
+      Decision d;
+      d.sat  = sat;
+      d.time = c.time;
+      d.flag = OK;
+      d.mark = c.mark;
+      d.NWL = d.NGF = 0;
+      d.WLstep = d.GFstep = d.WL = d.GF = 0.0;
+
+      if (!c.good)
+      {
+         d.flag = BAD;
+         out.push_back(d);
+         st.pending.pop_front();
+         return true;
+      }
+
+         // the good points that follow
+      vector<const Pending*> fut;
+      for (size_t i = 1; i < st.pending.size() && int(fut.size()) < lookahead;
+           i++)
+      {
+         if (st.pending[i].good)
+            fut.push_back(&st.pending[i]);
+      }
+      if (!flushing && int(fut.size()) < lookahead)
+         return false;
+
+      if (st.window.size() >= 3)
+      {
+         double WL0, WLsig, GF0, GFrate, GFsig, xref, step;
+         const int np(st.window.size());
+         fitWindow(st, WL0, WLsig, GF0, GFrate, GFsig, xref);
+
+            // WL
+         vector<double> rf;
+         for (size_t i = 0; i < fut.size(); i++)
+            rf.push_back(fut[i]->WL - st.WLfix - WL0);
+         double rc = c.WL - st.WLfix - WL0;
+         int res = classify(rc, rf, WLfineStep, WLsig, nsigma, np, step);
+         if (res == 1)
+         {
+            d.flag = WLOUTLIER;
+         }
+         else if (res == 2)
+         {
+            long N   = long(step + (step > 0.0 ? 0.5 : -0.5));
+            d.mark  |= Arc::WLSLIP | Arc::WLFIX;
+            d.WLstep = step;
+            d.NWL    = N;
+            st.WLfix += N;
+            st.GFfix += N * st.wl2 / st.wlGF;
+         }
+
+            // GF, after any WL fix
+         if (d.flag == OK)
+         {
+            rf.clear();
+            for (size_t i = 0; i < fut.size(); i++)
+               rf.push_back(fut[i]->GF - st.GFfix - GF0 -
+                            GFrate * (fut[i]->x - xref));
+            rc  = c.GF - st.GFfix - GF0 - GFrate * (c.x - xref);
+            res = classify(rc, rf, GFfineStep, GFsig, nsigma, np, step);
+            if (res == 1)
+            {
+               d.flag = GFOUTLIER;
+            }
+            else if (res == 2)
+            {
+               long N   = long(step + (step > 0.0 ? 0.5 : -0.5));
+               d.mark  |= Arc::GFSLIP | Arc::GFFIX;
+               d.GFstep = step;
+               d.NGF    = N;
+               st.GFfix += N;
+            }
+         }
+      }
+
+      d.WL = c.WL - st.WLfix;
+      d.GF = c.GF - st.GFfix;
+      if (d.flag == OK)
+      {
+         Past pp = {c.x, d.WL, d.GF};
+         st.window.push_back(pp);
+         if (int(st.window.size()) > width)
+            st.window.pop_front();
+      }
+      out.push_back(d);
+      st.pending.pop_front();
+      return true;
+   }
+
+} // end namespace gnsstk
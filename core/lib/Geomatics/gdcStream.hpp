@@ -0,0 +1,232 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+    @file gdcStream.hpp GNSSTk Discontinuity Corrector, streaming version.
+    Detect and fix cycle slips in dual-frequency phase data one epoch at a
+    time, with a latency of a few epochs, for real-time processing. */
+
+#ifndef GNSSTK_DISCONTINUITY_CORRECTOR_STREAM_INCLUDE
+#define GNSSTK_DISCONTINUITY_CORRECTOR_STREAM_INCLUDE
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Epoch.hpp"
+#include "Exception.hpp"
+#include "RinexSatID.hpp"
+#include "gdc.hpp"
+
+namespace gnsstk
+{
+   //---------------------------------------------------------------------------------
+      /**
+       Class gdcStream is a streaming counterpart of class gdc. gdc needs a
+       complete SatPass; gdcStream ingests one epoch of L1, L2, P1, P2 at a
+       time, per satellite, and returns a decision for each epoch as soon as
+       it can be made, that is once 'lookahead' more good epochs of the same
+       satellite have been seen (or at a gap, or at flush()).
+
+       As in gdc, the data are reduced to the wide-lane (Melbourne-Wubbena)
+       combination WL, in units of the WL wavelength, and the geometry-free
+       phase GF, in units of the GF wavelength. For each satellite a sliding
+       window of the last 'width' accepted points is kept; WL is predicted by
+       the window mean, GF by a straight line fit to the window (to follow
+       the ionosphere). The candidate epoch and the 'lookahead' epochs after
+       it are compared with the prediction: if the future is offset from the
+       prediction, and the candidate agrees with the future, there is a slip
+       at the candidate; if only the candidate is off, it is an outlier.
+       Slips are fixed as gdc fixes them: WL by N = nearest integer of the WL
+       step, removing N from WL and N*wl2/wlGF from GF, then GF by the nearest
+       integer of the remaining GF step. Thus the net slips reported, NWL and
+       NGF, follow the conventions of gdc's Arc::Arcinfo::Nslip.
+
+       The state per satellite is bounded by width + lookahead + MaxGap
+       epochs, since a gap longer than MaxGap, even one of bad points, ends
+       the Arc and forces the pending decisions. The configuration uses the
+       same labels as gdc where the meaning is the same: MaxGap, width,
+       WLfineStep and GFfineStep, plus lookahead, the latency in epochs, and
+       nsigma, the multiple of the window noise that, if larger than the fine
+       step, replaces it as the threshold.
+
+       Limitations: the first three points of an Arc are accepted without a
+       test, since the window cannot yet predict; and since a decision can
+       not be revised, the statistics are less robust than those of gdc,
+       which sees the whole pass.
+      */
+   class gdcStream
+   {
+   public:
+         /// Values of Decision::flag; the same as those of gdc
+      enum Flag
+      {
+         OK        = 0, ///< good data
+         BAD       = 1, ///< bad on input (flag, or missing data)
+         WLOUTLIER = 2, ///< outlier on WL
+         GFOUTLIER = 3  ///< outlier on GF
+      };
+
+         /// Result for one input epoch
+      struct Decision
+      {
+         RinexSatID sat; ///< satellite
+         Epoch time;     ///< time tag of the epoch
+         unsigned flag;  ///< one of Flag
+            /// OR of Arc::BEG, Arc::WLSLIP, Arc::WLFIX, Arc::GFSLIP, Arc::GFFIX
+         unsigned mark;
+         int NWL;        ///< WL slip fixed at this epoch, WL wavelengths
+         int NGF;        ///< GF slip fixed at this epoch, GF wavelengths
+         double WLstep;  ///< estimated WL step at this epoch, WL wavelengths
+         double GFstep;  ///< estimated GF step at this epoch, GF wavelengths
+         double WL;      ///< WL after fixing, relative to start of Arc (wl)
+         double GF;      ///< GF after fixing, relative to start of Arc (wl)
+      };
+
+         /**
+          Constructor.
+          @param DT nominal time spacing of the data in seconds; gaps are
+                    measured in units of DT.
+         */
+      gdcStream(double DT = 30.0);
+
+         /**
+          Set a parameter; labels are MaxGap, width, lookahead, WLfineStep,
+          GFfineStep and nsigma.
+          @return true if successful, false if the label is not valid
+          @throw InvalidParameter if width is less than 3 or lookahead is
+                 negative
+         */
+      bool setParameter(const std::string& label, double value);
+
+         /// Get a parameter; throw if the label is not valid @throw Exception
+      double getParameter(const std::string& label) const;
+
+         /**
+          Set the GLONASS frequency channel of a satellite; required before
+          the first call to add() for a GLONASS satellite.
+         */
+      void setGLOchannel(const RinexSatID& sat, int n) { GLOchan[sat] = n; }
+
+         /**
+          Add one epoch of data for one satellite, and append to out the
+          decisions that have become possible, oldest first; epochs of each
+          satellite come out in the order they went in.
+          NB phases are in cycles, ranges in meters; a zero value means
+          missing data.
+          @param sat  satellite
+          @param t    time tag; must increase for each satellite
+          @param L1,L2,P1,P2 data
+          @param out  vector<Decision> to which decisions are appended
+          @param ok   false if the data are known to be bad
+          @throw Exception if time does not increase, or a GLONASS channel has
+                  not been set
+         */
+      void add(const RinexSatID& sat, const Epoch& t, double L1, double L2,
+               double P1, double P2, std::vector<Decision>& out,
+               bool ok = true);
+
+         /// Decide all pending epochs of one satellite, and reset it
+      void flush(const RinexSatID& sat, std::vector<Decision>& out);
+
+         /// Decide all pending epochs of all satellites, and reset them
+      void flush(std::vector<Decision>& out);
+
+   private:
+         /// one epoch waiting for a decision
+      struct Pending
+      {
+         Epoch time;
+         double x;      ///< seconds since start of Arc
+         double WL, GF; ///< combinations less the Arc biases, before fixing
+         bool good;     ///< usable data
+         unsigned mark; ///< BEG, if this starts an Arc
+      };
+
+         /// one point of the sliding window
+      struct Past
+      {
+         double x, WL, GF; ///< time and fixed combinations
+      };
+
+         /// state of one satellite
+      struct SatState
+      {
+         SatState() : init(false), inArc(false) {}
+         bool init;          ///< wavelengths have been set
+         bool inArc;         ///< an Arc has begun
+         double wl1, wl2;    ///< L1 and L2 wavelengths (m)
+         double beta;        ///< f1/f2
+         double wlWL, wlGF;  ///< WL and GF wavelengths (m)
+         Epoch arcBegin;     ///< time of the first point of the Arc
+         Epoch lastTime;     ///< time of the latest input
+         Epoch lastGood;     ///< time of the latest good input
+         double WLbias;      ///< WL at the first point of the Arc (wl)
+         double GFbias;      ///< GF at the first point of the Arc (wl)
+         double WLfix;       ///< accumulated fixes of WL (wl)
+         double GFfix;       ///< accumulated fixes of GF (wl)
+         std::deque<Pending> pending; ///< epochs not yet decided
+         std::deque<Past> window;     ///< last accepted points
+      };
+
+         /// decide the oldest pending epoch, if possible or if flushing
+      bool decide(const RinexSatID& sat, SatState& st,
+                  std::vector<Decision>& out, bool flushing);
+
+         /// fit the window, returning prediction coefficients and noise
+      void fitWindow(const SatState& st, double& WL0, double& WLsig,
+                     double& GF0, double& GFrate, double& GFsig,
+                     double& xref) const;
+
+      double dt;        ///< nominal data spacing (s)
+      int MaxGap;       ///< largest gap within an Arc (points)
+      int width;        ///< width of the sliding window (points)
+      int lookahead;    ///< number of future points used (latency)
+      double WLfineStep; ///< WL slip threshold (WL wavelengths)
+      double GFfineStep; ///< GF slip threshold (GF wavelengths)
+      double nsigma;    ///< threshold as a multiple of the noise
+
+      std::map<RinexSatID, int> GLOchan;     ///< GLONASS channels
+      std::map<RinexSatID, SatState> states; ///< state of each satellite
+
+   }; // end class gdcStream
+
+} // end namespace gnsstk
+
+#endif // GNSSTK_DISCONTINUITY_CORRECTOR_STREAM_INCLUDE
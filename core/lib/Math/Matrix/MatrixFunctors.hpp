@@ -45,6 +45,7 @@
 #include <cmath>
 #include <limits>
 #include <algorithm>
+#include "MatrixKernels.hpp"
 
 namespace gnsstk
 {
@@ -606,6 +607,10 @@ namespace gnsstk
 
          size_t N=m.rows(),i,j,k;
          double d;
+         if(MatrixKernels::useBlocked(N,N,N)) {
+            blocked(m);
+            return;
+         }
          Matrix<T> P(m);
          U = Matrix<T>(m.rows(),m.cols(),T(0));
 
@@ -660,29 +665,55 @@ namespace gnsstk
             MatrixException e("Vector size does not match dimension of Cholesky");
             GNSSTK_THROW(e);
          }
-         size_t i,j,N=L.rows();
+         size_t i,N=L.rows();
 
+            // solve column by column, so L is accessed with unit stride
          Vector<T> y(b.size());
-         y(0) = b(0)/L(0,0);
-         for(i=1; i<N; i++) {
-            y(i) = b(i);
-            for(j=0; j<i; j++) y(i)-=L(i,j)*y(j);
-            y(i) /= L(i,i);
-         }
+         for(i=0; i<N; i++) y(i) = b(i);
+         MatrixKernels::solveLower(N, L.begin(), N, y.begin());
+         MatrixKernels::solveLowerTranspose(N, L.begin(), N, y.begin());
             // b is now x
-         b(N-1) = y(N-1)/L(N-1,N-1);
-         for(i=N-1; ; i--) {
-            b(i) = y(i);
-            for(j=i+1; j<N; j++) b(i)-=L(j,i)*b(j);
-            b(i) /= L(i,i);
-            if(i==0) break;
-         }
+         for(i=0; i<N; i++) b(i) = y(i);
 
       }  // end Cholesky::backSub
 
          /// Lower triangular and Upper triangular Cholesky decompositions
       Matrix<T> L, U;
 
+   protected:
+         /** Compute L and U for a large matrix using the blocked
+          * kernel.  U is found as the lower factor of the matrix with
+          * its rows and columns reversed, i.e. U = J*chol(J*m*J)*J
+          * where J is the exchange matrix.
+          * @throw MatrixException
+          */
+      template <class BaseClass>
+      void blocked(const ConstMatrixBase<T, BaseClass>& m)
+      {
+         size_t N=m.rows(),i,j;
+         L = m;
+         if(!MatrixKernels::cholesky(N, L.begin(), N)) {
+            MatrixException e("Cholesky fails - eigenvalue <= 0");
+            GNSSTK_THROW(e);
+         }
+         for(j=1; j<N; j++)
+            for(i=0; i<j; i++)
+               L(i,j) = T(0);
+
+         Matrix<T> P(N,N);
+         for(j=0; j<N; j++)
+            for(i=0; i<N; i++)
+               P(i,j) = m(N-1-i,N-1-j);
+         if(!MatrixKernels::cholesky(N, P.begin(), N)) {
+            MatrixException e("Cholesky fails - eigenvalue <= 0");
+            GNSSTK_THROW(e);
+         }
+         U = Matrix<T>(N,N,T(0));
+         for(j=0; j<N; j++)
+            for(i=0; i<=j; i++)
+               U(i,j) = P(N-1-i,N-1-j);
+      }
+
    }; // end class Cholesky
 
       /** Compute the Cholesky decomposition using the Cholesky-Crout
@@ -713,6 +744,18 @@ namespace gnsstk
 
          int N = m.rows(), i, j, k;
          double sum;
+         if(MatrixKernels::useBlocked(N,N,N)) {
+            (*this).L = m;
+            if(!MatrixKernels::cholesky(N, (*this).L.begin(), N)) {
+               MatrixException e("CholeskyCrout fails - eigenvalue <= 0");
+               GNSSTK_THROW(e);
+            }
+            for(j=1; j<N; j++)
+               for(i=0; i<j; i++)
+                  (*this).L(i,j) = T(0);
+            (*this).U = transpose((*this).L);
+            return;
+         }
          (*this).L = Matrix<T>(N,N, 0.0);
 
          for(j=0; j<N; j++) {
@@ -765,6 +808,11 @@ namespace gnsstk
       inline void operator() (const ConstMatrixBase<T, BaseClass>& m)
       {
          A = m;
+         if(MatrixKernels::useBlocked(A.rows(),A.cols(),A.cols())) {
+            MatrixKernels::householder(A.rows(), A.cols(), A.begin(),
+                                       A.rows());
+            return;
+         }
          size_t i,j,k;
          Vector<T> v(A.rows());
          T sum,alpha;
@@ -0,0 +1,361 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file MatrixKernels.hpp
+ * Cache-blocked kernels on raw column-major storage used by the
+ * Matrix operators and functors for large matrices.
+ */
+
+#ifndef GNSSTK_MATRIX_KERNELS_HPP
+#define GNSSTK_MATRIX_KERNELS_HPP
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "MathBase.hpp"
+
+#ifdef GNSSTK_USE_BLAS
+extern "C"
+{
+      // Fortran BLAS/LAPACK entry points; declared here so that no
+      // particular cblas/lapacke header is required.
+   void dgemm_(const char *transa, const char *transb, const int *m,
+               const int *n, const int *k, const double *alpha,
+               const double *a, const int *lda, const double *b,
+               const int *ldb, const double *beta, double *c,
+               const int *ldc);
+   void dtrsv_(const char *uplo, const char *trans, const char *diag,
+               const int *n, const double *a, const int *lda, double *x,
+               const int *incx);
+   void dpotrf_(const char *uplo, const int *n, double *a, const int *lda,
+                int *info);
+}
+#endif
+
+namespace gnsstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /** Low-level linear algebra kernels operating on contiguous
+       * column-major arrays, i.e. element (i,j) of an array with
+       * leading dimension ld is at a[i + j*ld], which is the layout
+       * used by Matrix<T>.  All inner loops run with unit stride so
+       * the compiler can vectorize them, and the outer loops are
+       * blocked so that the working set of each block fits in cache.
+       *
+       * When the library is built with USE_BLAS=ON and a system
+       * BLAS/LAPACK is found, the double precision versions of
+       * multiply(), cholesky(), solveLower() and solveLowerTranspose()
+       * are routed to dgemm, dpotrf and dtrsv.
+       *
+       * The Matrix operators and functors only use these kernels
+       * when the problem is at least minBlockedDim in size, so results
+       * for small matrices are unchanged. */
+   namespace MatrixKernels
+   {
+         /// Edge length, in elements, of the square blocks.
+      const std::size_t blockSize = 64;
+
+         /// Smallest dimension for which the kernels are used by Matrix.
+      const std::size_t minBlockedDim = 32;
+
+         /** Return true if a product or decomposition with the given
+          * dimensions is large enough to use the kernels. */
+      inline bool useBlocked(std::size_t m, std::size_t n, std::size_t k)
+      {
+         return (m*n*k >= minBlockedDim*minBlockedDim*minBlockedDim);
+      }
+
+         /** Compute C += A*B where A is m x k, B is k x n and C is m x n.
+          * The summation order over k is the same as the textbook
+          * triple loop, so results are identical to it.
+          * @param[in] m number of rows of A and C.
+          * @param[in] n number of columns of B and C.
+          * @param[in] k number of columns of A and rows of B.
+          * @param[in] a column-major storage of A.
+          * @param[in] lda leading dimension of a.
+          * @param[in] b column-major storage of B.
+          * @param[in] ldb leading dimension of b.
+          * @param[in,out] c column-major storage of C.
+          * @param[in] ldc leading dimension of c. */
+      template <class T>
+      void multiply(std::size_t m, std::size_t n, std::size_t k,
+                    const T *a, std::size_t lda,
+                    const T *b, std::size_t ldb,
+                    T *c, std::size_t ldc)
+      {
+         for (std::size_t j0 = 0; j0 < n; j0 += blockSize)
+         {
+            const std::size_t j1 = std::min(n, j0 + blockSize);
+            for (std::size_t p0 = 0; p0 < k; p0 += blockSize)
+            {
+               const std::size_t p1 = std::min(k, p0 + blockSize);
+               for (std::size_t i0 = 0; i0 < m; i0 += blockSize)
+               {
+                  const std::size_t i1 = std::min(m, i0 + blockSize);
+                  for (std::size_t j = j0; j < j1; j++)
+                  {
+                     T *cj = c + j*ldc;
+                     for (std::size_t p = p0; p < p1; p++)
+                     {
+                        const T bpj = b[p + j*ldb];
+                        const T *ap = a + p*lda;
+                        for (std::size_t i = i0; i < i1; i++)
+                           cj[i] += ap[i] * bpj;
+                     }
+                  }
+               }
+            }
+         }
+      }
+
+         /** In-place Cholesky factorization A = L*transpose(L) of the
+          * n x n symmetric positive definite matrix A.  Only the lower
+          * triangle of A is referenced, and it is overwritten with L;
+          * the strict upper triangle is left untouched.
+          * @return false if A is not positive definite. */
+      template <class T>
+      bool cholesky(std::size_t n, T *a, std::size_t lda)
+      {
+         for (std::size_t k0 = 0; k0 < n; k0 += blockSize)
+         {
+            const std::size_t k1 = std::min(n, k0 + blockSize);
+               // factor the panel of columns k0..k1-1
+            for (std::size_t j = k0; j < k1; j++)
+            {
+               T *aj = a + j*lda;
+               for (std::size_t p = k0; p < j; p++)
+               {
+                  const T ljp = a[j + p*lda];
+                  const T *ap = a + p*lda;
+                  for (std::size_t i = j; i < n; i++)
+                     aj[i] -= ap[i] * ljp;
+               }
+               if (!(aj[j] > T(0)))
+                  return false;
+               aj[j] = SQRT(aj[j]);
+               const T d = T(1) / aj[j];
+               for (std::size_t i = j+1; i < n; i++)
+                  aj[i] *= d;
+            }
+               // update the trailing lower triangle with the panel
+            for (std::size_t j = k1; j < n; j++)
+            {
+               T *aj = a + j*lda;
+               for (std::size_t p = k0; p < k1; p++)
+               {
+                  const T ljp = a[j + p*lda];
+                  const T *ap = a + p*lda;
+                  for (std::size_t i = j; i < n; i++)
+                     aj[i] -= ap[i] * ljp;
+               }
+            }
+         }
+         return true;
+      }
+
+         /** Solve L*x = b in place, where L is the n x n lower
+          * triangular matrix stored in l; x overwrites b. */
+      template <class T>
+      void solveLower(std::size_t n, const T *l, std::size_t ldl, T *x)
+      {
+         for (std::size_t j = 0; j < n; j++)
+         {
+            const T *lj = l + j*ldl;
+            x[j] /= lj[j];
+            const T xj = x[j];
+            for (std::size_t i = j+1; i < n; i++)
+               x[i] -= lj[i] * xj;
+         }
+      }
+
+         /** Solve transpose(L)*x = b in place, where L is the n x n
+          * lower triangular matrix stored in l; x overwrites b. */
+      template <class T>
+      void solveLowerTranspose(std::size_t n, const T *l, std::size_t ldl,
+                               T *x)
+      {
+         for (std::size_t i = n; i-- > 0; )
+         {
+            const T *li = l + i*ldl;
+            T sum = x[i];
+            for (std::size_t j = i+1; j < n; j++)
+               sum -= li[j] * x[j];
+            x[i] = sum / li[i];
+         }
+      }
+
+         /** Apply the first nr reflectors of a panel starting at
+          * column j0 to the column x, in order.  Used by householder(). */
+      template <class T>
+      void applyReflectors(std::size_t m, std::size_t j0, std::size_t nr,
+                           const T *panel, const T *beta,
+                           const char *active, T *x)
+      {
+         const T EPS(1.e-200);
+         for (std::size_t jj = 0; jj < nr; jj++)
+         {
+            if (!active[jj])
+               continue;
+            const std::size_t j = j0 + jj;
+            const T *v = panel + jj*m;
+            T alpha(0);
+            for (std::size_t i = j; i < m; i++)
+               alpha += x[i] * v[i];
+            alpha *= beta[jj];
+            if (alpha*alpha < EPS)
+               continue;
+            for (std::size_t i = j; i < m; i++)
+               x[i] += alpha * v[i];
+         }
+      }
+
+         /** Householder triangularization of the m x n matrix A, in
+          * place.  This is the same transformation as the Householder
+          * functor (including its treatment of the last column and
+          * its thresholds), but reflectors are generated a panel of
+          * blockSize columns at a time and then applied together to
+          * each trailing column, so each trailing column is streamed
+          * through cache once per panel rather than once per column.
+          * On return A is upper triangular; elements below the
+          * diagonal are zero. */
+      template <class T>
+      void householder(std::size_t m, std::size_t n, T *a, std::size_t lda)
+      {
+         if (m < 2 || n < 2)
+            return;
+         const T EPS(1.e-200);
+         const std::size_t nref = std::min(m-1, n-1);
+         std::vector<T> panel(m*blockSize), beta(blockSize);
+         std::vector<char> active(blockSize);
+
+         for (std::size_t j0 = 0; j0 < nref; j0 += blockSize)
+         {
+            const std::size_t jb = std::min(blockSize, nref - j0);
+               // generate the reflectors of this panel
+            for (std::size_t jj = 0; jj < jb; jj++)
+            {
+               const std::size_t j = j0 + jj;
+               T *aj = a + j*lda;
+               applyReflectors(m, j0, jj, &panel[0], &beta[0], &active[0],
+                               aj);
+               T *v = &panel[jj*m];
+               T sum(0);
+               for (std::size_t i = j; i < m; i++)
+               {
+                  v[i] = aj[i];
+                  aj[i] = T(0);
+                  sum += v[i]*v[i];
+               }
+               active[jj] = (sum >= EPS);
+               if (!active[jj])
+                  continue;
+               sum = SQRT(sum);
+               if (v[j] > T(0)) sum = -sum;
+               aj[j] = sum;
+               v[j] -= sum;
+               beta[jj] = T(1) / (sum*v[j]);
+            }
+               // apply them to every column to the right of the panel
+            for (std::size_t k = j0 + jb; k < n; k++)
+               applyReflectors(m, j0, jb, &panel[0], &beta[0], &active[0],
+                               a + k*lda);
+         }
+      }
+
+#ifdef GNSSTK_USE_BLAS
+      template <>
+      inline void multiply<double>(std::size_t m, std::size_t n,
+                                   std::size_t k,
+                                   const double *a, std::size_t lda,
+                                   const double *b, std::size_t ldb,
+                                   double *c, std::size_t ldc)
+      {
+         const char no('N');
+         const int im(m), in(n), ik(k), ilda(lda), ildb(ldb), ildc(ldc);
+         const double one(1.0);
+         if (m == 0 || n == 0 || k == 0)
+            return;
+         dgemm_(&no, &no, &im, &in, &ik, &one, a, &ilda, b, &ildb, &one,
+                c, &ildc);
+      }
+
+      template <>
+      inline bool cholesky<double>(std::size_t n, double *a, std::size_t lda)
+      {
+         const char lo('L');
+         const int in(n), ilda(lda);
+         int info(0);
+         if (n == 0)
+            return true;
+         dpotrf_(&lo, &in, a, &ilda, &info);
+         return (info == 0);
+      }
+
+      template <>
+      inline void solveLower<double>(std::size_t n, const double *l,
+                                     std::size_t ldl, double *x)
+      {
+         const char lo('L'), no('N');
+         const int in(n), ildl(ldl), one(1);
+         if (n == 0)
+            return;
+         dtrsv_(&lo, &no, &no, &in, l, &ildl, x, &one);
+      }
+
+      template <>
+      inline void solveLowerTranspose<double>(std::size_t n, const double *l,
+                                              std::size_t ldl, double *x)
+      {
+         const char lo('L'), tr('T'), no('N');
+         const int in(n), ildl(ldl), one(1);
+         if (n == 0)
+            return;
+         dtrsv_(&lo, &tr, &no, &in, l, &ildl, x, &one);
+      }
+#endif
+
+   } // namespace MatrixKernels
+
+      //@}
+
+}  // namespace
+
+#endif
@@ -821,6 +821,16 @@ namespace gnsstk
       }
 
       Matrix<T> toReturn(l.rows(), r.cols(), T(0));
+      if (MatrixKernels::useBlocked(l.rows(), r.cols(), l.cols()))
+      {
+            // copying to contiguous storage is O(n^2), the product O(n^3)
+         const Matrix<T> lm(l), rm(r);
+         MatrixKernels::multiply(lm.rows(), rm.cols(), lm.cols(),
+                                 lm.begin(), lm.rows(),
+                                 rm.begin(), rm.rows(),
+                                 toReturn.begin(), toReturn.rows());
+         return toReturn;
+      }
       size_t i, j, k;
       for (i = 0; i < toReturn.rows(); i++)
          for (j = 0; j < toReturn.cols(); j++)
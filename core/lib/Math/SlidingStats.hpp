@@ -0,0 +1,253 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file SlidingStats.hpp
+/// One- and two-sample statistics on a sliding window of data
+
+#ifndef INCLUDE_GNSSTK_SLIDINGSTATS_INCLUDE
+#define INCLUDE_GNSSTK_SLIDINGSTATS_INCLUDE
+
+#include <cmath>
+#include <deque>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace gnsstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+   //---------------------------------------------------------------------------
+   /// Two-sample statistics of (x,y) data in a sliding window, where samples
+   /// are added at one end and removed from the other, as in the window
+   /// filters (WindowFilter, FDiffFilter, FirstDiffFilter).
+   /// The sums are kept about the current averages (Welford updates) rather
+   /// than as raw sums, so there is no cancellation when x or y is large
+   /// compared to its spread, e.g. x in seconds of a day of 1Hz data. The
+   /// samples in the window are kept, and the sums are recomputed from them
+   /// after every N() calls to Subtract(), so rounding errors do not
+   /// accumulate over a long series; Add() and Subtract() are O(1) amortized.
+   /// Subtract() of a sample that is not the oldest is allowed but is O(N).
+   /// Results are those of TwoSampleStats (Variance with 1/(N-1), etc.);
+   /// one-sample statistics of y are available through Add(y), Average(),
+   /// Variance() and StdDev(). Minimum and maximum are not kept.
+   template <class T> class SlidingStats
+   {
+   public:
+      /// constructor
+      SlidingStats() { Reset(); }
+
+      /// reset, i.e. ignore earlier data and restart sampling
+      inline void Reset(void)
+      {
+         window.clear();
+         nsub = 0;
+         aveX = aveY = Sxx = Syy = Sxy = T();
+      }
+
+      /// add a sample to the window
+      void Add(const T& x, const T& y)        // SlidingStats
+      {
+         window.push_back(std::make_pair(x, y));
+         T n(window.size());
+         T dx(x - aveX), dy(y - aveY);
+         aveX += dx / n;
+         aveY += dy / n;
+         Sxx += dx * (x - aveX);
+         Syy += dy * (y - aveY);
+         Sxy += dx * (y - aveY);
+      }
+
+      /// add a sample for one-sample statistics (x = 0)
+      inline void Add(const T& y) { Add(T(), y); }
+
+      /// remove a sample from the window; it must have been added.
+      void Subtract(const T& x, const T& y)   // SlidingStats
+      {
+         if(window.empty()) return;
+         if(window.front().first == x && window.front().second == y)
+            window.pop_front();
+         else {
+            typename std::deque< std::pair<T,T> >::iterator it;
+            for(it = window.begin(); it != window.end(); ++it)
+               if(it->first == x && it->second == y) break;
+            if(it == window.end()) return;
+            window.erase(it);
+         }
+         if(window.empty()) { Reset(); return; }
+
+         T n(window.size());
+         T dx(x - aveX), dy(y - aveY);
+         aveX -= dx / n;
+         aveY -= dy / n;
+         Sxx -= dx * (x - aveX);
+         Syy -= dy * (y - aveY);
+         Sxy -= dx * (y - aveY);
+         if(Sxx < T()) Sxx = T();
+         if(Syy < T()) Syy = T();
+
+         if(++nsub >= window.size() && nsub >= 16) Recompute();
+      }
+
+      /// remove a sample added with Add(y)
+      inline void Subtract(const T& y) { Subtract(T(), y); }
+
+      // accessors -------------------------------------------------------
+
+      /// the number of samples in the window
+      inline unsigned int N(void) const { return window.size(); }
+
+      /// return the average of X
+      inline T AverageX(void) const { return aveX; }
+
+      /// return the average of Y
+      inline T AverageY(void) const { return aveY; }
+
+      /// return the variance of X
+      inline T VarianceX(void) const
+         { return (N() > 1 ? Sxx / T(N()-1) : T()); }
+
+      /// return the variance of Y
+      inline T VarianceY(void) const
+         { return (N() > 1 ? Syy / T(N()-1) : T()); }
+
+      /// return the standard deviation of X
+      inline T StdDevX(void) const { return std::sqrt(VarianceX()); }
+
+      /// return the standard deviation of Y
+      inline T StdDevY(void) const { return std::sqrt(VarianceY()); }
+
+      /// one-sample statistics: the average of Y
+      inline T Average(void) const { return aveY; }
+
+      /// one-sample statistics: the variance of Y
+      inline T Variance(void) const { return VarianceY(); }
+
+      /// one-sample statistics: the standard deviation of Y
+      inline T StdDev(void) const { return StdDevY(); }
+
+      /// return slope of best-fit line Y=slope*X + intercept
+      inline T Slope(void) const
+         { return (N() > 0 && Sxx > T() ? Sxy / Sxx : T()); }
+
+      /// return intercept of best-fit line Y=slope*X + intercept
+      inline T Intercept(void) const
+         { return (N() > 0 ? aveY - Slope() * aveX : T()); }
+
+      /// return the predicted Y at the given X, using Slope and Intercept
+      inline T Evaluate(T x) const { return aveY + Slope() * (x - aveX); }
+
+      /// return correlation
+      inline T Correlation(void) const
+      {
+         if(N() < 2 || Sxx <= T() || Syy <= T()) return T();
+         return Sxy / std::sqrt(Sxx * Syy);
+      }
+
+      /// return conditional variance = (uncertainty y given x)^2
+      inline T VarianceYX(void) const
+      {
+         if(N() < 3) return T();
+         T corr(Correlation());
+         return (VarianceY() * (T(N()-1)/T(N()-2)) * (T(1) - corr*corr));
+      }
+
+      /// return conditional uncertainty = uncertainty y given x
+      inline T SigmaYX(void) const { return std::sqrt(VarianceYX()); }
+
+      /// return uncertainty in slope
+      inline T SigmaSlope(void) const
+      {
+         if(N() < 3 || Sxx <= T()) return T();
+         return (SigmaYX() / std::sqrt(Sxx));
+      }
+
+      /// Write SlidingStats as a short 1-line string
+      std::string asString(std::string msg=std::string(), int w=7, int p=4) const
+      {
+         std::ostringstream oss;
+         oss << "stats(sld):" << (msg.empty() ? "" : " "+msg)
+             << " N " << std::setw(w) << N() << std::fixed << std::setprecision(p)
+             << "  AveX " << std::setw(w) << AverageX()
+             << "  AveY " << std::setw(w) << AverageY()
+             << "  StdY " << std::setw(w) << StdDevY()
+             << "  Int " << std::setw(w) << Intercept()
+             << "  Slp " << std::setw(w) << Slope()
+             << "  CSig " << std::setw(w) << SigmaYX();
+         return oss.str();
+      }
+
+   private:
+      /// recompute the sums from the samples in the window
+      void Recompute(void)
+      {
+         typename std::deque< std::pair<T,T> >::const_iterator it;
+         T n(window.size()), sx(0), sy(0);
+         for(it = window.begin(); it != window.end(); ++it) {
+            sx += it->first;
+            sy += it->second;
+         }
+         aveX = sx / n;
+         aveY = sy / n;
+         Sxx = Syy = Sxy = T();
+         for(it = window.begin(); it != window.end(); ++it) {
+            T dx(it->first - aveX), dy(it->second - aveY);
+            Sxx += dx * dx;
+            Syy += dy * dy;
+            Sxy += dx * dy;
+         }
+         nsub = 0;
+      }
+
+      std::deque< std::pair<T,T> > window; ///< samples in the window, in order
+      unsigned int nsub;   ///< calls to Subtract() since the last Recompute()
+      T aveX;              ///< average of x
+      T aveY;              ///< average of y
+      T Sxx;               ///< sum of (x-aveX)^2
+      T Syy;               ///< sum of (y-aveY)^2
+      T Sxy;               ///< sum of (x-aveX)(y-aveY)
+
+   }; // end class SlidingStats
+
+      //@}
+
+}  // namespace
+
+#endif   // INCLUDE_GNSSTK_SLIDINGSTATS_INCLUDE
@@ -59,7 +59,10 @@ namespace gnsstk
            cacheHour(-1),
            cacheSunSpots(std::numeric_limits<double>::quiet_NaN()),
            cacheGood(false),
-           cacheFourierGood(false)
+           cacheFourierGood(false),
+           basisMonth(-1),
+           basisHour(-1),
+           basisGood(false)
    {
    }
 
@@ -89,15 +92,17 @@ namespace gnsstk
       {
          GNSSTK_ASSERT(whenUTC.changeTimeSystem(gnsstk::TimeSystem::UTC,&btsc));
       }
-         // Compute the interpolated ITU-R coefficients AF2, Am3
-         // (cacheF2 and cacheFM3)
-      interpolate(whenUTC, effSunSpots);
-         // interpolate should have called validateCache so we have a
-         // valid cacheFourierGood setting.  validateCache will also
-         // have set cacheHour to the value corresponding to when, so
-         // we don't need to recompute it.
+         // Check the cache first, as the Fourier coefficients may
+         // have come from fourierFromBasis() without the interpolated
+         // coefficients they would otherwise be computed from.
+      validateCache(whenUTC, effSunSpots);
       if (!cacheFourierGood)
       {
+            // Compute the interpolated ITU-R coefficients AF2, Am3
+            // (cacheF2 and cacheFM3).  validateCache will have set
+            // cacheHour to the value corresponding to when, so we
+            // don't need to recompute it.
+         interpolate(whenUTC, effSunSpots);
          unsigned idx = 0; // computed cache 1D array index
          double t = (15.0 * cacheHour - 180.0) * PI / 180.0;            //eq.49
             // compute Fourier time series for foF2
@@ -135,6 +140,89 @@ namespace gnsstk
    }
 
 
+   void CCIR ::
+   fourierBasis(const CommonTime& when)
+   {
+      DEBUGTRACE_FUNCTION();
+      gnsstk::BasicTimeSystemConverter btsc;
+      CivilTime whenUTC(when);
+      if (whenUTC.getTimeSystem() != gnsstk::TimeSystem::UTC)
+      {
+         GNSSTK_ASSERT(whenUTC.changeTimeSystem(gnsstk::TimeSystem::UTC,&btsc));
+      }
+      double utHour = whenUTC.getUTHour();
+      if (basisGood && (basisMonth == whenUTC.month) &&
+          (fabs(basisHour - utHour) <= UTHourEpsilon))
+      {
+         return;
+      }
+         // effective sun spot counts of 0 and 100 select the low and
+         // high solar activity grids exactly (eq.44, eq.46)
+      fourier(whenUTC, 0.0);
+      basisCF2[LowSolarActIdx] = cacheCF2;
+      basisCM3[LowSolarActIdx] = cacheCM3;
+      fourier(whenUTC, 100.0);
+      basisCF2[HighSolarActIdx] = cacheCF2;
+      basisCM3[HighSolarActIdx] = cacheCM3;
+      basisMonth = whenUTC.month;
+      basisHour = utHour;
+      basisGood = true;
+   }
+
+
+   void CCIR ::
+   fourierFromBasis(double effSunSpots)
+   {
+      GNSSTK_ASSERT(basisGood);
+      double effSunSpotCount = effSunSpots / 100.0;
+      const std::vector<double>& lowF2(basisCF2[LowSolarActIdx]);
+      const std::vector<double>& highF2(basisCF2[HighSolarActIdx]);
+      const std::vector<double>& lowM3(basisCM3[LowSolarActIdx]);
+      const std::vector<double>& highM3(basisCM3[HighSolarActIdx]);
+      for (unsigned degree = 0; degree < F2MaxDegree; degree++)
+      {
+         cacheCF2[degree] = lowF2[degree] * (1.0 - effSunSpotCount) +
+            highF2[degree] * effSunSpotCount;
+      }
+      for (unsigned degree = 0; degree < FM3MaxDegree; degree++)
+      {
+         cacheCM3[degree] = lowM3[degree] * (1.0 - effSunSpotCount) +
+            highM3[degree] * effSunSpotCount;
+      }
+         // The interpolated grids in cacheF2 and cacheFM3 no longer
+         // match, but the Fourier coefficients do, so fourier() will
+         // use them as long as time and sun spots stay the same.
+      cacheMonth = basisMonth;
+      cacheHour = basisHour;
+      cacheSunSpots = effSunSpots;
+      cacheGood = false;
+      cacheFourierGood = true;
+   }
+
+
+   void CCIR ::
+   getCoefficients(unsigned month, int cond, std::vector<double>& af2,
+                   std::vector<double>& am3)
+   {
+      af2.resize(F2MaxDegree*F2MaxOrder);
+      am3.resize(FM3MaxDegree*FM3MaxOrder);
+      for (unsigned degree = 0; degree < F2MaxDegree; degree++)
+      {
+         for (unsigned order = 0; order < F2MaxOrder; order++)
+         {
+            af2[degree*F2MaxOrder+order] = ccirF2(month, cond, degree, order);
+         }
+      }
+      for (unsigned degree = 0; degree < FM3MaxDegree; degree++)
+      {
+         for (unsigned order = 0; order < FM3MaxOrder; order++)
+         {
+            am3[degree*FM3MaxOrder+order] = ccirFm3(month, cond, degree, order);
+         }
+      }
+   }
+
+
    void CCIR ::
    interpolateF2(const CommonTime& when, double effSunSpots)
    {
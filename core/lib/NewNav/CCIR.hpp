@@ -88,6 +88,29 @@ namespace gnsstk
           *   sun spot number. */
       void fourier(const CommonTime& when, double effSunSpots);
 
+         /** Compute the Fourier time series for foF2 and M(3000)F2 at
+          * both the low and high solar activity conditions for the
+          * given time.  Since the series are linear in the effective
+          * sun spot number, fourierFromBasis() can then produce them
+          * for any effective sun spot number with one multiply-add
+          * per coefficient, instead of re-interpolating the CCIR
+          * grids.  Nothing is done if the basis is already computed
+          * for the same month and UT hour.
+          * @param[in] when The time at which to interpolate the F2
+          *   layer coefficients. */
+      void fourierBasis(const CommonTime& when);
+
+         /** Set the Fourier coefficients returned by getCF2() and
+          * getCM3() for the time given to fourierBasis() and the
+          * given effective sun spot number.  The result matches that
+          * of fourier() to within rounding, and a following call to
+          * fourier() with the same time and sun spot number will use
+          * it rather than recompute.
+          * @param[in] effSunSpots Effective sun spot number, aka Azr.
+          * @pre fourierBasis() has been called.
+          * @throw AssertionFailure if fourierBasis() has not been called. */
+      void fourierFromBasis(double effSunSpots);
+
          /** Get the F2 layer Fourier coefficients used in Legendre
           * expansion, as generated by fourier().
           * @param[in] degree The coefficient index.
@@ -116,6 +139,19 @@ namespace gnsstk
                  : std::numeric_limits<double>::quiet_NaN());
       }
 
+         /** Get the raw CCIR coefficients for a month and solar
+          * activity condition, for users that expand them in their
+          * own way.
+          * @param[in] month The month of the data, 1-12.
+          * @param[in] cond The solar conditions, low activity=0, high
+          *   activity=1.
+          * @param[out] af2 The F2 layer coefficients, indexed by
+          *   degree*F2MaxOrder+order.
+          * @param[out] am3 The transmission factor coefficients,
+          *   indexed by degree*FM3MaxOrder+order. */
+      void getCoefficients(unsigned month, int cond, std::vector<double>& af2,
+                           std::vector<double>& am3);
+
    private:
          /** Check to see if the currently cached Fourier coefficients
           * match the specified time and sun spot number.
@@ -221,6 +257,16 @@ namespace gnsstk
       bool cacheGood;
          /// Cache state information for Fourier data.
       bool cacheFourierGood;
+         /// Month of the Fourier basis computed by fourierBasis().
+      unsigned basisMonth;
+         /// UT hour of the Fourier basis computed by fourierBasis().
+      double basisHour;
+         /// CF2 coefficients at low and high solar activity.
+      std::vector<double> basisCF2[F2SolarActCond];
+         /// Cm3 coefficients at low and high solar activity.
+      std::vector<double> basisCM3[F2SolarActCond];
+         /// Cache state information for the Fourier basis.
+      bool basisGood;
 
       friend class ::CCIR_T;
    };
@@ -36,6 +36,7 @@
 //                            release, distribution is unlimited.
 //
 //==============================================================================
+#include <algorithm>
 #include "GLOCBits.hpp"
 #include "GLOCNavEph.hpp"
 #include "TimeString.hpp"
@@ -49,6 +50,7 @@ using namespace std;
 namespace gnsstk
 {
    const double GLOCNavEph::we = 7.2921151467e-5;
+   bool GLOCNavEph::denseDefault = false;
 
 
    GLOCNavEph ::
@@ -63,7 +65,8 @@ namespace gnsstk
            taucdot(std::numeric_limits<double>::quiet_NaN()),
            tauDelta(std::numeric_limits<double>::quiet_NaN()),
            tauGPS(std::numeric_limits<double>::quiet_NaN()),
-           step(60.0)
+           step(60.0),
+           dense(denseDefault)
    {
       signal.messageType = NavMessageType::Ephemeris;
          // 3x 3 second strings.
@@ -86,40 +89,55 @@ namespace gnsstk
    getXvt(const CommonTime& when, Xvt& xvt, const ObsID& oid)
    {
       DEBUGTRACE_FUNCTION();
+         // Convert broadcast values from km to m, which is what the
+         // differential equations use.
+      double x0[3] = { pos[0]*1000.0, pos[1]*1000.0, pos[2]*1000.0 };
+      double v0[3] = { vel[0]*1000.0, vel[1]*1000.0, vel[2]*1000.0 };
+      double accel[3] = { acc[0]*1000.0, acc[1]*1000.0, acc[2]*1000.0 };
+      double x[3], v[3];
+      double dt = when - Toe;
          // If the exact epoch is found, let's return the values
       if (when == Toe)
       {
-         xvt.x[0] = pos[0]*1.e3;   // m
-         xvt.x[1] = pos[1]*1.e3;   // m
-         xvt.x[2] = pos[2]*1.e3;   // m
-         xvt.v[0] = vel[0]*1.e3;  // m/sec
-         xvt.v[1] = vel[1]*1.e3;  // m/sec
-         xvt.v[2] = vel[2]*1.e3;  // m/sec
-            // In the GLONASS system, 'clkbias' already includes the
-            // relativistic correction, therefore we must substract
-            // the latter from the former.
-         xvt.relcorr = xvt.computeRelativityCorrection();
-            // Added negation here to match the SP3 sign
-         xvt.clkbias = -(clkBias + freqBias * (when - Toe) - xvt.relcorr);
-         xvt.clkdrift = freqBias;
-         xvt.frame = RefFrame(RefFrameSys::PZ90, when);
-         xvt.health = toXvtHealth(header.health);
-         return true;
+         std::copy(x0, x0+3, x);
+         std::copy(v0, v0+3, v);
+      }
+      else if (!dense || !denseXv(dt, x0, v0, accel, x, v))
+      {
+         integrate(when, x0, v0, accel, x, v);
       }
+      xvt.x[0] = x[0];
+      xvt.x[1] = x[1];
+      xvt.x[2] = x[2];
+      xvt.v[0] = v[0];
+      xvt.v[1] = v[1];
+      xvt.v[2] = v[2];
+         // In the GLONASS system, 'clkbias' already includes the relativistic
+         // correction, therefore we must substract the late from the former.
+      xvt.relcorr = xvt.computeRelativityCorrection();
+         // Added negation here to match the SP3 sign
+      xvt.clkbias = -(clkBias + freqBias * dt - xvt.relcorr);
+      xvt.clkdrift = freqBias;
+      xvt.frame = RefFrame(RefFrameSys::PZ90, when);
+      xvt.health = toXvtHealth(header.health);
+      return true;
+   }
+
+
+   void GLOCNavEph ::
+   integrate(const CommonTime& when, const double x0[3], const double v0[3],
+             const double accel[3], double x[3], double v[3]) const
+   {
       bool simplified = (std::fabs(when - Toe) <= 900);
-      Vector<double> initialState(6), accel(3), k1(6), k2(6), k3(6),
-         k4(6), tempRes(6), a1(3), a23(3), a4(3);
-         // Convert broadcast values from km to m, which is what the
-         // differential equations use.
-      initialState(0)  = pos[0]*1000.0;
-      initialState(2)  = pos[1]*1000.0;
-      initialState(4)  = pos[2]*1000.0;
-      initialState(1)  = vel[0]*1000.0;
-      initialState(3)  = vel[1]*1000.0;
-      initialState(5)  = vel[2]*1000.0;
-      accel(0) = acc[0]*1000.0;
-      accel(1) = acc[1]*1000.0;
-      accel(2) = acc[2]*1000.0;
+      double initialState[6], k1[6], k2[6], k3[6], k4[6], tempRes[6];
+         // long-term corrections, zero unless set below
+      double a1[3] = {0,0,0}, a23[3] = {0,0,0}, a4[3] = {0,0,0};
+      initialState[0] = x0[0];
+      initialState[2] = x0[1];
+      initialState[4] = x0[2];
+      initialState[1] = v0[0];
+      initialState[3] = v0[1];
+      initialState[5] = v0[2];
          // Integrate satellite state to desired epoch using the given step
       double rkStep(step);
       if ((when - Toe) < 0.0)
@@ -153,20 +171,26 @@ namespace gnsstk
             if (std::fabs(dt) >= 900)
             {
                dt = workEpoch-Toe;
-               a1 = 1000.0 * ltdmp.geta(dt);
-               a23 = 1000.0 * ltdmp.geta(dt+(rkStep/2.0));
-               a4 = 1000.0 * ltdmp.geta(dt+rkStep);
+               getLT(dt, a1);
+               getLT(dt+(rkStep/2.0), a23);
+               getLT(dt+rkStep, a4);
             }
          }
-         k1 = derivative(initialState, accel, a1, simplified);
-         tempRes = initialState + k1*rkStep/2.0;
-         k2 = derivative(tempRes, accel, a23, simplified);
-         tempRes = initialState + k2*rkStep/2.0;
-         k3 = derivative(tempRes, accel, a23, simplified);
-         tempRes = initialState + k3*rkStep;
-         k4 = derivative(tempRes, accel, a4, simplified);
-         initialState = initialState +
-            (k1/6.0 + k2/3.0 + k3/3.0 + k4/6.0) * rkStep;
+         derivative(initialState, accel, a1, simplified, k1);
+         for (unsigned i = 0; i < 6; i++)
+            tempRes[i] = initialState[i] + k1[i]*rkStep/2.0;
+         derivative(tempRes, accel, a23, simplified, k2);
+         for (unsigned i = 0; i < 6; i++)
+            tempRes[i] = initialState[i] + k2[i]*rkStep/2.0;
+         derivative(tempRes, accel, a23, simplified, k3);
+         for (unsigned i = 0; i < 6; i++)
+            tempRes[i] = initialState[i] + k3[i]*rkStep;
+         derivative(tempRes, accel, a4, simplified, k4);
+         for (unsigned i = 0; i < 6; i++)
+         {
+            initialState[i] = initialState[i] +
+               (k1[i]/6.0 + k2[i]/3.0 + k3[i]/3.0 + k4[i]/6.0) * rkStep;
+         }
             // If we are within tolerance of the target time, we are done.
          workEpoch += rkStep;
          if (std::fabs(when - workEpoch) < tolerance)
@@ -174,21 +198,39 @@ namespace gnsstk
             done = true;
          }
       }  // while (!done)
-      xvt.x[0] = initialState(0);
-      xvt.x[1] = initialState(2);
-      xvt.x[2] = initialState(4);
-      xvt.v[0] = initialState(1);
-      xvt.v[1] = initialState(3);
-      xvt.v[2] = initialState(5);
-         // In the GLONASS system, 'clkbias' already includes the relativistic
-         // correction, therefore we must substract the late from the former.
-      xvt.relcorr = xvt.computeRelativityCorrection();
-         // Added negation here to match the SP3 sign
-      xvt.clkbias = -(clkBias + freqBias * (when - Toe) - xvt.relcorr);
-      xvt.clkdrift = freqBias;
-      xvt.frame = RefFrame(RefFrameSys::PZ90, when);
-      xvt.health = toXvtHealth(header.health);
-      return true;
+      x[0] = initialState[0];
+      x[1] = initialState[2];
+      x[2] = initialState[4];
+      v[0] = initialState[1];
+      v[1] = initialState[3];
+      v[2] = initialState[5];
+   }
+
+
+   bool GLOCNavEph ::
+   denseXv(double dt, const double x0[3], const double v0[3],
+           const double accel[3], double x[3], double v[3])
+   {
+         // The simplified and long-term algorithms are different
+         // equations of motion, so each gets its own dense orbit.
+      bool simplified = (std::fabs(dt) <= 900) || !haveLTDMP();
+      GLODenseOrbit& dorb(simplified ? orbit : ltOrbit);
+      if (!dorb.isSet(x0, v0, accel))
+      {
+         dorb.reset(x0, v0, accel);
+      }
+      OrbitForce force(accel, simplified ? nullptr : this);
+      return dorb.evaluate(dt, force, x, v);
+   }
+
+
+   void GLOCNavEph ::
+   getLT(double dt, double lt[3]) const
+   {
+      Vector<double> a(ltdmp.geta(dt));
+      lt[0] = 1000.0 * a[0];
+      lt[1] = 1000.0 * a[1];
+      lt[2] = 1000.0 * a[2];
    }
 
 
@@ -245,6 +287,9 @@ namespace gnsstk
             // 15 minutes.
          endFit = Toe + 900.0;
       }
+         // the ephemeris may have changed
+      orbit.clear();
+      ltOrbit.clear();
    }
 
 
@@ -374,53 +419,46 @@ namespace gnsstk
    }
 
 
-   Vector<double> GLOCNavEph ::
-   derivative(const Vector<double>& inState, const Vector<double>& accel,
-              const Vector<double>& lt, bool simplified)
+   void GLOCNavEph ::
+   derivative(const double inState[6], const double accel[3],
+              const double lt[3], bool simplified, double dxt[6])
       const
    {
-         // We will need some important PZ90 ellipsoid values
-      PZ90Ellipsoid pz90;
-      const double mu = pz90.gm();          // 398600.44e9;
-      const double ae = pz90.a();           // 6378136
-      const double j02 = -pz90.j20();       // 1082625.7e-9
-         /** @todo figure out a reasonable way to handle the fact that
-          * FDMA nav uses a less precise value for omega_e.  Maybe a
-          * different PZ90Ellipsoid class? */
-      const double we = 7.2921151467e-5;
-         // Let's start getting the current satellite position and velocity
-      double  x(inState(0));          // X coordinate
-      double  y(inState(2));          // Y coordinate
-      double  z(inState(4));          // Z coordinate
-      double r2(x*x + y*y + z*z);
-      double r(std::sqrt(r2));
-      double xmu(mu/r2);
-      double rho(ae/r);
-      double xr(x/r);
-      double yr(y/r);
-      double zr(z/r);
-      double zr2(zr*zr);
-      double k1(-1.5*j02*xmu*rho*rho);
-      double  cm(k1*(1.0-5.0*zr2));
-      double cmz(k1*(3.0-5.0*zr2));
-      double k2(cm-xmu);
-      double gloAx(k2*xr + we*we*x + 2.0*we*inState(3) + accel(0));
-      double gloAy(k2*yr + we*we*y - 2.0*we*inState(1) + accel(1));
-      double gloAz((cmz-xmu)*zr + accel(2));
+      double x[3] = { inState[0], inState[2], inState[4] };
+      double v[3] = { inState[1], inState[3], inState[5] };
+      double a[3];
+      GLODenseOrbit::pz90Accel(we, x, v, accel, a);
       if (!simplified)
       {
-         gloAx += lt[0];
-         gloAy += lt[1];
-         gloAz += lt[2];
+         a[0] += lt[0];
+         a[1] += lt[1];
+         a[2] += lt[2];
       }
-      Vector<double> dxt({
-            inState(1), gloAx,
-            inState(3), gloAy,
-            inState(5), gloAz });
-      return dxt;
+      dxt[0] = inState[1];
+      dxt[1] = a[0];
+      dxt[2] = inState[3];
+      dxt[3] = a[1];
+      dxt[4] = inState[5];
+      dxt[5] = a[2];
    }  // derivative()
 
 
+   void GLOCNavEph::OrbitForce ::
+   accel(double t, const double pos[3], const double vel[3], double acc[3])
+      const
+   {
+      GLODenseOrbit::pz90Accel(GLOCNavEph::we, pos, vel, ls, acc);
+      if (eph != nullptr)
+      {
+         double lt[3];
+         eph->getLT(t, lt);
+         acc[0] += lt[0];
+         acc[1] += lt[1];
+         acc[2] += lt[2];
+      }
+   }
+
+
    double GLOCNavEph ::
    factorToSigma(int8_t factor)
    {
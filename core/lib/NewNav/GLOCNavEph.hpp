@@ -43,6 +43,7 @@
 #include "GLOCSatType.hpp"
 #include "GLOCRegime.hpp"
 #include "GLOCNavLTDMP.hpp"
+#include "GLODenseOrbit.hpp"
 #include "gnsstk_export.h"
 
 namespace gnsstk
@@ -88,6 +89,8 @@ namespace gnsstk
           *   and 4 hours.  The long-term algorithm requires the data
           *   from the LTDMP strings (31-32), so if those are absent
           *   for a long-term request, getXvt will indicate failure.
+          * @note If dense is true, each algorithm's orbit is
+          *   integrated once and interpolated (see GLODenseOrbit).
           * @param[in] when The time at which to compute the xvt.
           * @param[out] xvt The resulting computed position/velocity.
           * @param[in] oid Value is ignored - GLONASS does not have
@@ -167,8 +170,62 @@ namespace gnsstk
           * @note The default value is suggested in ICD-GLONASS-CDMA
           *   General Edition Appendix J. */
       double step;
+         /** If true, getXvt() interpolates the dense output of a
+          * single adaptive integration of this ephemeris rather than
+          * integrating from Toe on every call.  The results agree
+          * with the Runge-Kutta algorithm to well below the accuracy
+          * of the broadcast orbit, but are not identical.
+          * @warning getXvt() then fills in the dense orbits as they
+          *   are used, so an object (e.g. one shared through a
+          *   NavLibrary) must not be used by several threads at once
+          *   with dense set.
+          * @note Call fixFit() after changing ltdmp of an object that
+          *   has already been used. */
+      bool dense;
+
+         /// The initial value of dense for new objects (false).
+      GNSSTK_EXPORT static bool denseDefault;
 
    private:
+         /// Equations of motion for the dense orbits.
+      class OrbitForce : public GLODenseOrbit::Force
+      {
+      public:
+            /** @param[in] accel The luni-solar acceleration in m/s**2.
+             * @param[in] lt The ephemeris whose long-term corrections
+             *   are to be applied, or nullptr for the simplified
+             *   algorithm. */
+         OrbitForce(const double accel[3], const GLOCNavEph *lt)
+               : ls(accel), eph(lt)
+         {}
+         void accel(double t, const double pos[3], const double vel[3],
+                    double acc[3]) const override;
+         const double *ls;
+         const GLOCNavEph *eph;
+      };
+
+         /** Integrate from Toe to \a when with the Runge-Kutta algorithm.
+          * @param[in] when The time at which to compute the state.
+          * @param[in] x0 The position at Toe in m.
+          * @param[in] v0 The velocity at Toe in m/s.
+          * @param[in] accel The luni-solar acceleration in m/s**2.
+          * @param[out] x The position at \a when in m.
+          * @param[out] v The velocity at \a when in m/s. */
+      void integrate(const CommonTime& when, const double x0[3],
+                     const double v0[3], const double accel[3],
+                     double x[3], double v[3]) const;
+
+         /** Compute the state \a dt seconds from Toe from the dense
+          * orbit, (re)starting it as needed.  Arguments as integrate().
+          * @return false if \a dt is beyond the span of the dense orbit. */
+      bool denseXv(double dt, const double x0[3], const double v0[3],
+                   const double accel[3], double x[3], double v[3]);
+
+         /** Get the long-term corrections in m/s**2.
+          * @param[in] dt The time since Toe in seconds.
+          * @param[out] lt The corrections [ax,ay,az]. */
+      void getLT(double dt, double lt[3]) const;
+
          /** Function implementing the derivative of GLONASS orbital model.
           * @see ICD GLONASS CDMA General Description Appendix J.2.1.
           * @param[in] inState The input state vector consisting of
@@ -179,11 +236,15 @@ namespace gnsstk
           * @param[in] simplified If true, use the simplified
           *   algorithm from appendix J.2.1.  If false, use the
           *   long-term algorithm from J.3.1.
-          * @return A vector containing [x',Vx',Y',Vy',Z',Vz']. */
-      Vector<double> derivative(const Vector<double>& inState,
-                                const Vector<double>& accel,
-                                const Vector<double>& lt,
-                                bool simplified) const;
+          * @param[out] dxt The derivative [x',Vx',Y',Vy',Z',Vz']. */
+      void derivative(const double inState[6], const double accel[3],
+                      const double lt[3], bool simplified,
+                      double dxt[6]) const;
+
+         /// Dense output of the simplified algorithm's orbit.
+      GLODenseOrbit orbit;
+         /// Dense output of the long-term algorithm's orbit.
+      GLODenseOrbit ltOrbit;
    };
 
       //@}
@@ -0,0 +1,450 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "GLODenseOrbit.hpp"
+#include "PZ90Ellipsoid.hpp"
+
+namespace gnsstk
+{
+   const double GLODenseOrbit::posTol = 1e-5;
+   const double GLODenseOrbit::velTol = 1e-8;
+   const double GLODenseOrbit::maxStep = 300.0;
+   const double GLODenseOrbit::diffStep = 1.0;
+
+      // Dormand-Prince 5(4) coefficients.
+   static const double dpC2 = 1.0/5.0, dpC3 = 3.0/10.0, dpC4 = 4.0/5.0,
+      dpC5 = 8.0/9.0;
+   static const double dpA21 = 1.0/5.0;
+   static const double dpA31 = 3.0/40.0, dpA32 = 9.0/40.0;
+   static const double dpA41 = 44.0/45.0, dpA42 = -56.0/15.0,
+      dpA43 = 32.0/9.0;
+   static const double dpA51 = 19372.0/6561.0, dpA52 = -25360.0/2187.0,
+      dpA53 = 64448.0/6561.0, dpA54 = -212.0/729.0;
+   static const double dpA61 = 9017.0/3168.0, dpA62 = -355.0/33.0,
+      dpA63 = 46732.0/5247.0, dpA64 = 49.0/176.0, dpA65 = -5103.0/18656.0;
+   static const double dpA71 = 35.0/384.0, dpA73 = 500.0/1113.0,
+      dpA74 = 125.0/192.0, dpA75 = -2187.0/6784.0, dpA76 = 11.0/84.0;
+      // difference between the 5th and 4th order solutions
+   static const double dpE1 = 71.0/57600.0, dpE3 = -71.0/16695.0,
+      dpE4 = 71.0/1920.0, dpE5 = -17253.0/339200.0, dpE6 = 22.0/525.0,
+      dpE7 = -1.0/40.0;
+      /// Most nodes kept when sampling, and the largest gap filled in.
+   static const long maxGridNodes = 1024;
+   static const long maxGridGap = 64;
+      /// Piece number of a node that can't be interpolated.
+   static const long badPiece = std::numeric_limits<long>::min();
+
+
+   GLODenseOrbit ::
+   GLODenseOrbit(double maxSpan)
+         : maxSpan(maxSpan),
+           initialized(false),
+           sampled(false),
+           hFwd(0),
+           hBwd(0),
+           gridStart(0),
+           gridSpacing(0),
+           extraAcc{0, 0, 0}
+   {
+   }
+
+
+   void GLODenseOrbit ::
+   reset(const double pos[3], const double vel[3], const double acc[3])
+   {
+      clear();
+      for (unsigned i = 0; i < 3; i++)
+      {
+         extraAcc[i] = (acc ? acc[i] : 0.0);
+      }
+      Node n;
+      n.t = 0;
+      n.piece = 0;
+      for (unsigned i = 0; i < 3; i++)
+      {
+         n.y[i] = pos[i];
+         n.y[i+3] = n.dy[i] = vel[i];
+            // filled in by the first evaluate()
+         n.dy[i+3] = std::numeric_limits<double>::quiet_NaN();
+      }
+      fwd.push_back(n);
+      bwd.push_back(n);
+      hFwd = 60.0;
+      hBwd = -60.0;
+      initialized = true;
+   }
+
+
+   void GLODenseOrbit ::
+   resetSampled(double spacing)
+   {
+      clear();
+      gridSpacing = spacing;
+      sampled = true;
+      initialized = true;
+   }
+
+
+   void GLODenseOrbit ::
+   clear()
+   {
+      fwd.clear();
+      bwd.clear();
+      grid.clear();
+      gridStart = 0;
+      gridSpacing = 0;
+      initialized = false;
+      sampled = false;
+   }
+
+
+   bool GLODenseOrbit ::
+   isSet(const double pos[3], const double vel[3], const double acc[3]) const
+   {
+      if (!initialized || sampled || fwd.empty())
+         return false;
+      for (unsigned i = 0; i < 3; i++)
+      {
+         if (extraAcc[i] != (acc ? acc[i] : 0.0))
+            return false;
+      }
+      const Node& n(fwd[0]);
+      return ((n.y[0] == pos[0]) && (n.y[1] == pos[1]) &&
+              (n.y[2] == pos[2]) && (n.y[3] == vel[0]) &&
+              (n.y[4] == vel[1]) && (n.y[5] == vel[2]));
+   }
+
+
+   bool GLODenseOrbit ::
+   evaluate(double t, const Force& force, double pos[3], double vel[3])
+   {
+      if (!initialized || sampled || (std::fabs(t) > maxSpan))
+         return false;
+      if (std::isnan(fwd[0].dy[3]))
+      {
+         force.accel(0, fwd[0].y, fwd[0].y+3, fwd[0].dy+3);
+         std::copy(fwd[0].dy+3, fwd[0].dy+6, bwd[0].dy+3);
+      }
+      if (t >= 0)
+      {
+         while ((fwd.size() < 2) || (fwd.back().t < t))
+            step(fwd, hFwd, force);
+            // first node with time >= t
+         NodeList::const_iterator i = std::lower_bound(
+            fwd.begin(), fwd.end(), t,
+            [](const Node& n, double v) { return n.t < v; });
+         if (i == fwd.begin())
+            ++i;
+         interpolate(*(i-1), *i, t, pos, vel);
+      }
+      else
+      {
+         while (bwd.back().t > t)
+            step(bwd, hBwd, force);
+            // first node with time <= t
+         NodeList::const_iterator i = std::lower_bound(
+            bwd.begin(), bwd.end(), t,
+            [](const Node& n, double v) { return n.t > v; });
+         interpolate(*(i-1), *i, t, pos, vel);
+      }
+      return true;
+   }
+
+
+   bool GLODenseOrbit ::
+   evaluate(double t, const Sampler& sampler, double pos[3], double vel[3])
+   {
+      if (!initialized || !sampled || (std::fabs(t) > maxSpan))
+         return false;
+      long i = (long)std::floor(t / gridSpacing);
+      long gridEnd = gridStart + (long)grid.size();
+      if (grid.empty() || (i+1 < gridStart - maxGridGap) ||
+          (i > gridEnd + maxGridGap) ||
+          (std::max(i+2, gridEnd) - std::min(i, gridStart) > maxGridNodes))
+      {
+            // not near the nodes we have, start over
+         grid.clear();
+         gridStart = gridEnd = i;
+      }
+      Node n;
+      while (gridEnd < i+2)
+      {
+         sampleNode(gridEnd, sampler, n);
+         grid.push_back(n);
+         gridEnd++;
+      }
+      if (i < gridStart)
+      {
+         NodeList before;
+         for (long j = i; j < gridStart; j++)
+         {
+            sampleNode(j, sampler, n);
+            before.push_back(n);
+         }
+         grid.insert(grid.begin(), before.begin(), before.end());
+         gridStart = i;
+      }
+      const Node& n0(grid[i-gridStart]);
+      const Node& n1(grid[i-gridStart+1]);
+      if ((n0.piece != n1.piece) || (n0.piece == badPiece))
+         return false;
+      interpolateSampled(n0, n1, t, pos, vel);
+      return true;
+   }
+
+
+   void GLODenseOrbit ::
+   pz90Accel(double we, const double pos[3], const double vel[3],
+             const double extra[3], double acc[3])
+   {
+         // We will need some important PZ90 ellipsoid values
+      PZ90Ellipsoid pz90;
+      const double mu = pz90.gm();          // 398600.44e9;
+      const double ae = pz90.a();           // 6378136
+      const double j02 = -pz90.j20();       // 1082625.7e-9
+      double  x(pos[0]);
+      double  y(pos[1]);
+      double  z(pos[2]);
+      double r2(x*x + y*y + z*z);
+      double r(std::sqrt(r2));
+      double xmu(mu/r2);
+      double rho(ae/r);
+      double xr(x/r);
+      double yr(y/r);
+      double zr(z/r);
+      double zr2(zr*zr);
+      double k1(-1.5*j02*xmu*rho*rho);
+      double  cm(k1*(1.0-5.0*zr2));
+         // ICD says 1-5, which is incorrect.
+      double cmz(k1*(3.0-5.0*zr2));
+      double k2(cm-xmu);
+      acc[0] = k2*xr + (we*we*x) + (2.0*we*vel[1]) + extra[0];
+         // ICD says +2, which is incorrect.
+      acc[1] = k2*yr + (we*we*y) + (-2.0*we*vel[0]) + extra[1];
+      acc[2] = (cmz-xmu)*zr + extra[2];
+   }
+
+
+   void GLODenseOrbit ::
+   step(NodeList& list, double& h, const Force& force)
+   {
+         // The stage derivatives of the state [pos,vel] are
+         // [vel,acc], kept in kv and ka.
+      double kv[7][3], ka[7][3], p[3], v[3], ep, ev, err;
+      while (true)
+      {
+         const Node& n(list.back());
+         const double *np = n.y, *nv = n.y+3;
+         for (unsigned j = 0; j < 3; j++)
+         {
+            kv[0][j] = n.dy[j];
+            ka[0][j] = n.dy[j+3];
+         }
+            // stage 2
+         for (unsigned j = 0; j < 3; j++)
+         {
+            p[j] = np[j] + h*(dpA21*kv[0][j]);
+            v[j] = nv[j] + h*(dpA21*ka[0][j]);
+            kv[1][j] = v[j];
+         }
+         force.accel(n.t + dpC2*h, p, v, ka[1]);
+            // stage 3
+         for (unsigned j = 0; j < 3; j++)
+         {
+            p[j] = np[j] + h*(dpA31*kv[0][j] + dpA32*kv[1][j]);
+            v[j] = nv[j] + h*(dpA31*ka[0][j] + dpA32*ka[1][j]);
+            kv[2][j] = v[j];
+         }
+         force.accel(n.t + dpC3*h, p, v, ka[2]);
+            // stage 4
+         for (unsigned j = 0; j < 3; j++)
+         {
+            p[j] = np[j] + h*(dpA41*kv[0][j] + dpA42*kv[1][j] +
+                              dpA43*kv[2][j]);
+            v[j] = nv[j] + h*(dpA41*ka[0][j] + dpA42*ka[1][j] +
+                              dpA43*ka[2][j]);
+            kv[3][j] = v[j];
+         }
+         force.accel(n.t + dpC4*h, p, v, ka[3]);
+            // stage 5
+         for (unsigned j = 0; j < 3; j++)
+         {
+            p[j] = np[j] + h*(dpA51*kv[0][j] + dpA52*kv[1][j] +
+                              dpA53*kv[2][j] + dpA54*kv[3][j]);
+            v[j] = nv[j] + h*(dpA51*ka[0][j] + dpA52*ka[1][j] +
+                              dpA53*ka[2][j] + dpA54*ka[3][j]);
+            kv[4][j] = v[j];
+         }
+         force.accel(n.t + dpC5*h, p, v, ka[4]);
+            // stage 6
+         for (unsigned j = 0; j < 3; j++)
+         {
+            p[j] = np[j] + h*(dpA61*kv[0][j] + dpA62*kv[1][j] +
+                              dpA63*kv[2][j] + dpA64*kv[3][j] +
+                              dpA65*kv[4][j]);
+            v[j] = nv[j] + h*(dpA61*ka[0][j] + dpA62*ka[1][j] +
+                              dpA63*ka[2][j] + dpA64*ka[3][j] +
+                              dpA65*ka[4][j]);
+            kv[5][j] = v[j];
+         }
+         force.accel(n.t + h, p, v, ka[5]);
+            // 5th order solution, whose derivative is the 7th stage
+         Node next;
+         next.t = n.t + h;
+         next.piece = 0;
+         for (unsigned j = 0; j < 3; j++)
+         {
+            next.y[j] = np[j] + h*(dpA71*kv[0][j] + dpA73*kv[2][j] +
+                                   dpA74*kv[3][j] + dpA75*kv[4][j] +
+                                   dpA76*kv[5][j]);
+            next.y[j+3] = nv[j] + h*(dpA71*ka[0][j] + dpA73*ka[2][j] +
+                                     dpA74*ka[3][j] + dpA75*ka[4][j] +
+                                     dpA76*ka[5][j]);
+            next.dy[j] = kv[6][j] = next.y[j+3];
+         }
+         force.accel(next.t, next.y, next.y+3, next.dy+3);
+         err = 0;
+         for (unsigned j = 0; j < 3; j++)
+         {
+            ep = h*(dpE1*kv[0][j] + dpE3*kv[2][j] + dpE4*kv[3][j] +
+                    dpE5*kv[4][j] + dpE6*kv[5][j] + dpE7*kv[6][j]);
+            ev = h*(dpE1*ka[0][j] + dpE3*ka[2][j] + dpE4*ka[3][j] +
+                    dpE5*ka[4][j] + dpE6*ka[5][j] + dpE7*next.dy[j+3]);
+            err = std::max(err, std::max(std::fabs(ep) / posTol,
+                                         std::fabs(ev) / velTol));
+         }
+            // standard step size control, limited to maxStep so that
+            // the Hermite interpolation remains accurate.
+         double factor = (err > 0 ? 0.9 * std::pow(err, -0.2) : 5.0);
+         factor = std::min(5.0, std::max(0.2, factor));
+         double hNext = std::min(maxStep, std::fabs(h) * factor);
+         if (err <= 1.0)
+         {
+            list.push_back(next);
+            h = (h < 0 ? -hNext : hNext);
+            return;
+         }
+         h = (h < 0 ? -hNext : hNext);
+      }
+   }
+
+
+      /** Quintic Hermite basis functions for the value and first and
+       * second derivatives at s=0 (b[0..2]) and s=1 (b[3..5]), and
+       * their derivatives with respect to s (d). */
+   static void hermite5(double s, double b[6], double d[6])
+   {
+      double s2 = s*s, s3 = s2*s, s4 = s3*s, s5 = s4*s;
+      b[0] = 1.0 - 10.0*s3 + 15.0*s4 - 6.0*s5;
+      b[1] = s - 6.0*s3 + 8.0*s4 - 3.0*s5;
+      b[2] = 0.5*s2 - 1.5*s3 + 1.5*s4 - 0.5*s5;
+      b[3] = 10.0*s3 - 15.0*s4 + 6.0*s5;
+      b[4] = -4.0*s3 + 7.0*s4 - 3.0*s5;
+      b[5] = 0.5*s3 - s4 + 0.5*s5;
+      d[0] = -30.0*s2 + 60.0*s3 - 30.0*s4;
+      d[1] = 1.0 - 18.0*s2 + 32.0*s3 - 15.0*s4;
+      d[2] = s - 4.5*s2 + 6.0*s3 - 2.5*s4;
+      d[3] = -d[0];
+      d[4] = -12.0*s2 + 28.0*s3 - 15.0*s4;
+      d[5] = 1.5*s2 - 4.0*s3 + 2.5*s4;
+   }
+
+
+   void GLODenseOrbit ::
+   interpolate(const Node& n0, const Node& n1, double t,
+               double pos[3], double vel[3])
+   {
+      double h = n1.t - n0.t, hh = h*h;
+      double b[6], d[6];
+      hermite5((t - n0.t) / h, b, d);
+         // position from position, velocity and acceleration, and
+         // velocity as its derivative
+      for (unsigned j = 0; j < 3; j++)
+      {
+         pos[j] = b[0]*n0.y[j] + b[1]*h*n0.dy[j] + b[2]*hh*n0.dy[j+3] +
+            b[3]*n1.y[j] + b[4]*h*n1.dy[j] + b[5]*hh*n1.dy[j+3];
+         vel[j] = (d[0]*n0.y[j] + d[3]*n1.y[j]) / h +
+            d[1]*n0.dy[j] + d[2]*h*n0.dy[j+3] +
+            d[4]*n1.dy[j] + d[5]*h*n1.dy[j+3];
+      }
+   }
+
+
+   void GLODenseOrbit ::
+   interpolateSampled(const Node& n0, const Node& n1, double t,
+                      double pos[3], double vel[3])
+   {
+      double h = n1.t - n0.t, hh = h*h;
+      double b[6], d[6], y[6];
+      hermite5((t - n0.t) / h, b, d);
+      for (unsigned j = 0; j < 6; j++)
+      {
+         y[j] = b[0]*n0.y[j] + b[1]*h*n0.dy[j] + b[2]*hh*n0.d2y[j] +
+            b[3]*n1.y[j] + b[4]*h*n1.dy[j] + b[5]*hh*n1.d2y[j];
+      }
+      std::copy(y, y+3, pos);
+      std::copy(y+3, y+6, vel);
+   }
+
+
+   void GLODenseOrbit ::
+   sampleNode(long i, const Sampler& sampler, Node& n) const
+   {
+      double ym[6], yp[6];
+      n.t = i * gridSpacing;
+      n.piece = sampler.piece(n.t);
+      if ((sampler.piece(n.t - diffStep) != n.piece) ||
+          (sampler.piece(n.t + diffStep) != n.piece) ||
+          !sampler.sample(n.t, n.y, n.y+3) ||
+          !sampler.sample(n.t - diffStep, ym, ym+3) ||
+          !sampler.sample(n.t + diffStep, yp, yp+3))
+      {
+         n.piece = badPiece;
+         return;
+      }
+         // central differences
+      for (unsigned j = 0; j < 6; j++)
+      {
+         n.dy[j] = (yp[j] - ym[j]) / (2.0 * diffStep);
+         n.d2y[j] = (yp[j] - 2.0*n.y[j] + ym[j]) / (diffStep * diffStep);
+      }
+   }
+}
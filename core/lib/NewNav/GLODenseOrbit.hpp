@@ -0,0 +1,259 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#ifndef GNSSTK_GLODENSEORBIT_HPP
+#define GNSSTK_GLODENSEORBIT_HPP
+
+#include <vector>
+
+namespace gnsstk
+{
+      /// @ingroup NavFactory
+      //@{
+
+      /** Dense output for GLONASS orbits.
+       *
+       * GLONASS ephemerides are propagated by numerically integrating
+       * the equations of motion from the reference time.  Doing that
+       * for every getXvt() call makes the cost of a call grow with
+       * the distance from the reference time.  This class instead
+       * integrates the orbit once, lazily, with an adaptive
+       * Dormand-Prince 5(4) integrator, and keeps the position,
+       * velocity and acceleration at each step.  A position and
+       * velocity at any time within the integrated span is then
+       * obtained by quintic Hermite interpolation between the two
+       * surrounding nodes, which costs the same regardless of the
+       * time of interest and does not allocate memory.
+       *
+       * The integration proceeds outward from the reference time in
+       * both directions and is extended as needed, with a step
+       * sequence that depends only on the equations of motion, so the
+       * results do not depend on the order in which times are
+       * requested.
+       *
+       * Orbits that are computed analytically (e.g. GLOFNavAlm) can
+       * use the same interpolation by sampling the analytic model on
+       * a regular grid of nodes (see Sampler).  The velocity of such
+       * models is not necessarily the derivative of the position, so
+       * position and velocity are interpolated separately, using
+       * derivatives obtained by numerical differentiation.  Such
+       * models may also have discontinuities, so the sampler labels
+       * each time with a piece number and an interval that crosses
+       * from one piece to another is never interpolated.
+       *
+       * All times are in seconds relative to the reference time of
+       * the orbit, positions are in meters and velocities in m/s.
+       *
+       * @note The nodes are filled in by evaluate(), so a single
+       *   object must not be used by several threads at once. */
+   class GLODenseOrbit
+   {
+   public:
+         /// Equations of motion for orbits that must be integrated.
+      class Force
+      {
+      public:
+         virtual ~Force() {}
+            /** Compute the acceleration of the satellite.
+             * @param[in] t The time relative to the reference time.
+             * @param[in] pos The satellite position in m.
+             * @param[in] vel The satellite velocity in m/s.
+             * @param[out] acc The acceleration in m/s**2. */
+         virtual void accel(double t, const double pos[3], const double vel[3],
+                            double acc[3]) const = 0;
+      };
+
+         /// Source of nodes for orbits that are computed analytically.
+      class Sampler
+      {
+      public:
+         virtual ~Sampler() {}
+            /** Compute the state of the satellite.
+             * @param[in] t The time relative to the reference time.
+             * @param[out] pos The satellite position in m.
+             * @param[out] vel The satellite velocity in m/s.
+             * @return false if the state could not be computed. */
+         virtual bool sample(double t, double pos[3], double vel[3])
+            const = 0;
+            /** Identify the continuous piece of the model that
+             * contains a time.  The default implementation has a
+             * single piece.
+             * @param[in] t The time relative to the reference time.
+             * @return a number that differs between adjacent pieces. */
+         virtual long piece(double t) const
+         { return 0; }
+      };
+
+         /** Create an empty orbit.
+          * @param[in] maxSpan The largest time from the reference
+          *   time, in seconds, for which evaluate() will compute a
+          *   state.  This bounds the memory used. */
+      GLODenseOrbit(double maxSpan = 86400.0);
+
+         /** Discard all nodes and set the state at the reference time
+          * for integration.
+          * @param[in] pos The satellite position in m.
+          * @param[in] vel The satellite velocity in m/s.
+          * @param[in] acc The constant additional acceleration in
+          *   m/s**2 used by the Force, e.g. the broadcast luni-solar
+          *   acceleration, or null if there is none.  It is only
+          *   recorded for isSet(). */
+      void reset(const double pos[3], const double vel[3],
+                 const double acc[3] = nullptr);
+
+         /** Discard all nodes and set up for sampling on a regular grid.
+          * @param[in] spacing The time between nodes in seconds. */
+      void resetSampled(double spacing);
+
+         /// Discard all nodes, leaving the orbit unset.
+      void clear();
+
+         /** @return true if reset() was called with the given
+          * initial state and additional acceleration (null being the
+          * same as zero), and clear() hasn't been called since. */
+      bool isSet(const double pos[3], const double vel[3],
+                 const double acc[3] = nullptr) const;
+
+         /// @return true if resetSampled() was called with spacing.
+      bool isSampled(double spacing) const
+      { return sampled && (gridSpacing == spacing); }
+
+         /** Compute the satellite position and velocity, integrating
+          * the orbit as far as needed.
+          * @param[in] t The time relative to the reference time.
+          * @param[in] force The equations of motion, which must be the
+          *   same for all calls following reset().
+          * @param[out] pos The satellite position in m.
+          * @param[out] vel The satellite velocity in m/s.
+          * @return false if t is outside of maxSpan or reset() has not
+          *   been called. */
+      bool evaluate(double t, const Force& force, double pos[3],
+                    double vel[3]);
+
+         /** Compute the satellite position and velocity, sampling the
+          * model as needed.
+          * @param[in] t The time relative to the reference time.
+          * @param[in] sampler The analytic model, which must be the
+          *   same for all calls following resetSampled().
+          * @param[out] pos The satellite position in m.
+          * @param[out] vel The satellite velocity in m/s.
+          * @return false if t is outside of maxSpan, resetSampled()
+          *   has not been called, the model could not be sampled, or
+          *   the grid interval containing t spans a discontinuity. */
+      bool evaluate(double t, const Sampler& sampler, double pos[3],
+                    double vel[3]);
+
+         /// @return the number of nodes currently stored.
+      size_t size() const
+      { return fwd.size() + bwd.size() + grid.size(); }
+
+         /** Compute the GLONASS equations of motion in the PZ-90
+          * rotating frame, with the central body term, the J2 term,
+          * and the given additional acceleration (luni-solar and any
+          * long-term corrections).
+          * @see ICD GLONASS CDMA General Description Appendix J.2.1.
+          * @param[in] we The angular velocity of the Earth in rad/s.
+          * @param[in] pos The satellite position in m.
+          * @param[in] vel The satellite velocity in m/s.
+          * @param[in] extra The additional acceleration in m/s**2.
+          * @param[out] acc The acceleration in m/s**2. */
+      static void pz90Accel(double we, const double pos[3],
+                            const double vel[3], const double extra[3],
+                            double acc[3]);
+
+         /// Tolerance on the position error of one step in m.
+      static const double posTol;
+         /// Tolerance on the velocity error of one step in m/s.
+      static const double velTol;
+         /// Largest integration step in seconds.
+      static const double maxStep;
+         /// Half the interval used for numerical derivatives of samples.
+      static const double diffStep;
+
+   private:
+         /** The state at one time, and the piece number of that time.
+          * Integrated nodes use y = [pos,vel] and dy = [vel,acc].
+          * Sampled nodes also use d2y, with derivatives of position
+          * and velocity that are computed independently. */
+      struct Node
+      {
+         double t;
+         double y[6];
+         double dy[6];
+         double d2y[6];
+         long piece;
+      };
+      typedef std::vector<Node> NodeList;
+
+         /** Take one accepted integration step from the last node of
+          * list, adapting the step size h, and append the new node. */
+      void step(NodeList& list, double& h, const Force& force);
+
+         /** Interpolate between two integrated nodes.
+          * @pre n0.t <= t <= n1.t or n1.t <= t <= n0.t. */
+      static void interpolate(const Node& n0, const Node& n1, double t,
+                              double pos[3], double vel[3]);
+
+         /** Interpolate between two sampled nodes.
+          * @pre n0.t <= t <= n1.t. */
+      static void interpolateSampled(const Node& n0, const Node& n1,
+                                     double t, double pos[3], double vel[3]);
+
+         /** Sample grid node index i into n.  If the sampler fails or
+          * the samples needed for the derivatives are not all in the
+          * same piece, n.piece is set to badPiece. */
+      void sampleNode(long i, const Sampler& sampler, Node& n) const;
+
+      double maxSpan;    ///< Limit on |t| in evaluate().
+      bool initialized;  ///< True once reset() or resetSampled() is called.
+      bool sampled;      ///< True if nodes come from a Sampler.
+      NodeList fwd;      ///< Integrated nodes at t >= 0, ascending.
+      NodeList bwd;      ///< Integrated nodes at t <= 0, descending.
+      double hFwd;       ///< Next step size for fwd.
+      double hBwd;       ///< Next step size for bwd (negative).
+      NodeList grid;     ///< Sampled nodes, consecutive grid indices.
+      long gridStart;    ///< Grid index of grid[0].
+      double gridSpacing;///< Time between sampled nodes.
+      double extraAcc[3];///< Additional acceleration given to reset().
+   };
+
+      //@}
+
+}
+
+#endif // GNSSTK_GLODENSEORBIT_HPP
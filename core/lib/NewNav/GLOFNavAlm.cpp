@@ -54,6 +54,8 @@ namespace gnsstk
    const double GLOFNavAlm::C20 = -1082.62575e-6;
    const double GLOFNavAlm::J = (-3.0/2.0) * C20;
    const double GLOFNavAlm::C20Term = (3.0/2.0) * C20;
+   bool GLOFNavAlm::denseDefault = false;
+   const double GLOFNavAlm::denseSpacing = 120.0;
 
 
    GLOFNavAlm ::
@@ -67,7 +69,10 @@ namespace gnsstk
            tLambdanA(std::numeric_limits<double>::quiet_NaN()),
            deltaTnA(std::numeric_limits<double>::quiet_NaN()),
            deltaTdotnA(std::numeric_limits<double>::quiet_NaN()),
-           freqnA(-1)
+           freqnA(-1),
+           dense(denseDefault),
+              // almanacs are used for a long time
+           orbit(30 * 86400.0)
    {
       signal.messageType = NavMessageType::Almanac;
       msgLenSec = 4.0;
@@ -85,7 +90,32 @@ namespace gnsstk
    bool GLOFNavAlm ::
    getXvt(const CommonTime& when, Xvt& xvt, const ObsID& oid)
    {
-      bool rv = math.getXvt(when, xvt, *this);
+      bool rv = false;
+      if (dense)
+      {
+         if (!orbit.isSampled(denseSpacing))
+         {
+            orbit.resetSampled(denseSpacing);
+         }
+         double x[3], v[3];
+         OrbitSampler sampler(*this);
+         if (orbit.evaluate(when - Toa, sampler, x, v))
+         {
+            for (unsigned i = 0; i < 3; i++)
+            {
+               xvt.x[i] = x[i];
+               xvt.v[i] = v[i];
+            }
+            xvt.frame = RefFrame(RefFrameSys::PZ90, when);
+            xvt.relcorr = xvt.computeRelativityCorrection();
+            rv = true;
+         }
+      }
+         // not dense, or not possible to interpolate at this time
+      if (!rv)
+      {
+         rv = math.getXvt(when, xvt, *this);
+      }
       xvt.health = (healthBits ? Xvt::Healthy : Xvt::Unhealthy);
       return rv;
    }
@@ -112,6 +142,8 @@ namespace gnsstk
       endFit.setTimeSystem(beginFit.getTimeSystem());
          // other computed data
       setSemiMajorAxisIncl();
+         // the almanac may have changed
+      orbit.clear();
    }
 
 
@@ -586,6 +618,39 @@ namespace gnsstk
    }
 
 
+   bool GLOFNavAlm::OrbitSampler ::
+   sample(double t, double pos[3], double vel[3]) const
+   {
+      Xvt xvt;
+      if (!alm.math.getXvt(alm.Toa + t, xvt, alm))
+      {
+         return false;
+      }
+      for (unsigned i = 0; i < 3; i++)
+      {
+         pos[i] = xvt.x[i];
+         vel[i] = xvt.v[i];
+      }
+      return true;
+   }
+
+
+   long GLOFNavAlm::OrbitSampler ::
+   piece(double t) const
+   {
+         // Only neighboring nodes are compared, so the numbers of the
+         // period and of the day need only be distinct modulo 1000.
+      CommonTime when(alm.Toa + t);
+      double W;
+      std::modf(t / alm.math.getTdeltap(), &W);
+      long day;
+      double sod;
+      when.get(day, sod);
+      long per = (long)std::fmod(W, 1000.0);
+      return (((day % 1000) + 1000) % 1000) * 2000 + per + 1000;
+   }
+
+
    GLOFNavAlm::NumberCruncher::Deltas ::
    Deltas()
          : deltaa(std::numeric_limits<double>::quiet_NaN()),
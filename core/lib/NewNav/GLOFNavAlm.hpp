@@ -40,6 +40,7 @@
 #define GNSSTK_GLOFNAVALM_HPP
 
 #include "GLOFNavData.hpp"
+#include "GLODenseOrbit.hpp"
 #include "PZ90Ellipsoid.hpp"
 #include "gnsstk_export.h"
 
@@ -201,6 +202,9 @@ namespace gnsstk
          static double integrateEin(double Mi, double epsi);
 
          bool getXvt(const CommonTime& when, Xvt& xvt, const GLOFNavAlm& alm);
+            /// @return Tdeltap, the draconian period used by getXvt().
+         double getTdeltap() const
+         { return Tdeltap; }
       private:
             /** Yet more abstraction, as these data get computed
              * multiple times.  What are they? *shrug*. */
@@ -290,6 +294,36 @@ namespace gnsstk
          // data above and calling fixFit() when decoding a GLONASS
          // almanac.
       NumberCruncher math;  ///< Retain as much computed data as possible.
+         /** If true, getXvt() interpolates between states computed on
+          * a regular grid of times (see GLODenseOrbit) rather than
+          * evaluating the almanac at every time.
+          * @note Call fixFit() after changing the almanac data of an
+          *   object that has already been used. */
+      bool dense;
+
+         /// The initial value of dense for new objects (false).
+      GNSSTK_EXPORT static bool denseDefault;
+         /// Spacing in seconds of the states used when dense is true.
+      GNSSTK_EXPORT static const double denseSpacing;
+
+   private:
+         /// Source of states for the dense orbit.
+      class OrbitSampler : public GLODenseOrbit::Sampler
+      {
+      public:
+         OrbitSampler(GLOFNavAlm& a)
+               : alm(a)
+         {}
+            /// Evaluate the almanac.
+         bool sample(double t, double pos[3], double vel[3]) const override;
+            /** The almanac algorithm changes at each draconian period
+             * and at midnight (sidereal time). */
+         long piece(double t) const override;
+         GLOFNavAlm& alm;
+      };
+
+         /// Dense output of the orbit, filled in by getXvt().
+      GLODenseOrbit orbit;
    };
 
       //@}
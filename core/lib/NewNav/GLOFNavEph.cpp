@@ -36,6 +36,7 @@
 //                            release, distribution is unlimited.
 //
 //==============================================================================
+#include <algorithm>
 #include "GLOFNavEph.hpp"
 #include "TimeString.hpp"
 #include "PZ90Ellipsoid.hpp"
@@ -46,6 +47,9 @@ using namespace std;
 
 namespace gnsstk
 {
+   bool GLOFNavEph::denseDefault = false;
+
+
    GLOFNavEph ::
    GLOFNavEph()
          : clkBias(std::numeric_limits<double>::quiet_NaN()),
@@ -60,7 +64,8 @@ namespace gnsstk
            accIndex(-1),
            dayCount(-1),
               // recommended by ICD, good balance of performance and accuracy
-           step(60.0)
+           step(60.0),
+           dense(denseDefault)
    {
       signal.messageType = NavMessageType::Ephemeris;
       msgLenSec = 8.0;
@@ -79,39 +84,52 @@ namespace gnsstk
    getXvt(const CommonTime& when, Xvt& xvt, const ObsID& oid)
    {
       DEBUGTRACE_FUNCTION();
+         // Convert broadcast values from km to m, which is what the
+         // differential equations use.
+      double x0[3] = { pos[0]*1000.0, pos[1]*1000.0, pos[2]*1000.0 };
+      double v0[3] = { vel[0]*1000.0, vel[1]*1000.0, vel[2]*1000.0 };
+      double accel[3] = { acc[0]*1000.0, acc[1]*1000.0, acc[2]*1000.0 };
+      double x[3], v[3];
+      double dt = when - Toe;
          // If the exact epoch is found, let's return the values
       if (when == Toe)
       {
-         xvt.x[0] = pos[0]*1.e3;   // m
-         xvt.x[1] = pos[1]*1.e3;   // m
-         xvt.x[2] = pos[2]*1.e3;   // m
-         xvt.v[0] = vel[0]*1.e3;  // m/sec
-         xvt.v[1] = vel[1]*1.e3;  // m/sec
-         xvt.v[2] = vel[2]*1.e3;  // m/sec
-            // In the GLONASS system, 'clkbias' already includes the
-            // relativistic correction, therefore we must substract
-            // the latter from the former.
-         xvt.relcorr = xvt.computeRelativityCorrection();
-            // Added negation here to match the SP3 sign
-         xvt.clkbias = -(clkBias + freqBias * (when - Toe) - xvt.relcorr);
-         xvt.clkdrift = freqBias;
-         xvt.frame = RefFrame(RefFrameSys::PZ90, when);
-         xvt.health = toXvtHealth(health);
-         return true;
+         std::copy(x0, x0+3, x);
+         std::copy(v0, v0+3, v);
       }
-      Vector<double> initialState(6), accel(3), k1(6), k2(6), k3(6),
-                     k4(6), tempRes(6);
-         // Convert broadcast values from km to m, which is what the
-         // differential equations use.
-      initialState(0)  = pos[0]*1000.0;
-      initialState(2)  = pos[1]*1000.0;
-      initialState(4)  = pos[2]*1000.0;
-      initialState(1)  = vel[0]*1000.0;
-      initialState(3)  = vel[1]*1000.0;
-      initialState(5)  = vel[2]*1000.0;
-      accel(0) = acc[0]*1000.0;
-      accel(1) = acc[1]*1000.0;
-      accel(2) = acc[2]*1000.0;
+      else if (!dense || !denseXv(dt, x0, v0, accel, x, v))
+      {
+         integrate(when, x0, v0, accel, x, v);
+      }
+      xvt.x[0] = x[0];
+      xvt.x[1] = x[1];
+      xvt.x[2] = x[2];
+      xvt.v[0] = v[0];
+      xvt.v[1] = v[1];
+      xvt.v[2] = v[2];
+         // In the GLONASS system, 'clkbias' already includes the relativistic
+         // correction, therefore we must substract the late from the former.
+      xvt.relcorr = xvt.computeRelativityCorrection();
+            // Added negation here to match the SP3 sign
+      xvt.clkbias = -(clkBias + freqBias * dt - xvt.relcorr);
+      xvt.clkdrift = freqBias;
+      xvt.frame = RefFrame(RefFrameSys::PZ90, when);
+      xvt.health = toXvtHealth(health);
+      return true;
+   }
+
+
+   void GLOFNavEph ::
+   integrate(const CommonTime& when, const double x0[3], const double v0[3],
+             const double accel[3], double x[3], double v[3]) const
+   {
+      double initialState[6], k1[6], k2[6], k3[6], k4[6], tempRes[6];
+      initialState[0] = x0[0];
+      initialState[2] = x0[1];
+      initialState[4] = x0[2];
+      initialState[1] = v0[0];
+      initialState[3] = v0[1];
+      initialState[5] = v0[2];
          // Integrate satellite state to desired epoch using the given step
       double rkStep(step);
       if ((when - Toe) < 0.0)
@@ -139,15 +157,21 @@ namespace gnsstk
                rkStep = (when - workEpoch);
             }
          }
-         k1 = derivative(initialState, accel);
-         tempRes = initialState + k1*rkStep/2.0;
-         k2 = derivative(tempRes, accel);
-         tempRes = initialState + k2*rkStep/2.0;
-         k3 = derivative(tempRes, accel);
-         tempRes = initialState + k3*rkStep;
-         k4 = derivative(tempRes, accel);
-         initialState = initialState +
-            (k1/6.0 + k2/3.0 + k3/3.0 + k4/6.0) * rkStep;
+         derivative(initialState, accel, k1);
+         for (unsigned i = 0; i < 6; i++)
+            tempRes[i] = initialState[i] + k1[i]*rkStep/2.0;
+         derivative(tempRes, accel, k2);
+         for (unsigned i = 0; i < 6; i++)
+            tempRes[i] = initialState[i] + k2[i]*rkStep/2.0;
+         derivative(tempRes, accel, k3);
+         for (unsigned i = 0; i < 6; i++)
+            tempRes[i] = initialState[i] + k3[i]*rkStep;
+         derivative(tempRes, accel, k4);
+         for (unsigned i = 0; i < 6; i++)
+         {
+            initialState[i] = initialState[i] +
+               (k1[i]/6.0 + k2[i]/3.0 + k3[i]/3.0 + k4[i]/6.0) * rkStep;
+         }
             // If we are within tolerance of the target time, we are done.
          workEpoch += rkStep;
          if (std::fabs(when - workEpoch) < tolerance)
@@ -155,21 +179,25 @@ namespace gnsstk
             done = true;
          }
       }  // while (!done)
-      xvt.x[0] = initialState(0);
-      xvt.x[1] = initialState(2);
-      xvt.x[2] = initialState(4);
-      xvt.v[0] = initialState(1);
-      xvt.v[1] = initialState(3);
-      xvt.v[2] = initialState(5);
-         // In the GLONASS system, 'clkbias' already includes the relativistic
-         // correction, therefore we must substract the late from the former.
-      xvt.relcorr = xvt.computeRelativityCorrection();
-            // Added negation here to match the SP3 sign
-      xvt.clkbias = -(clkBias + freqBias * (when - Toe) - xvt.relcorr);
-      xvt.clkdrift = freqBias;
-      xvt.frame = RefFrame(RefFrameSys::PZ90, when);
-      xvt.health = toXvtHealth(health);
-      return true;
+      x[0] = initialState[0];
+      x[1] = initialState[2];
+      x[2] = initialState[4];
+      v[0] = initialState[1];
+      v[1] = initialState[3];
+      v[2] = initialState[5];
+   }
+
+
+   bool GLOFNavEph ::
+   denseXv(double dt, const double x0[3], const double v0[3],
+           const double accel[3], double x[3], double v[3])
+   {
+      if (!orbit.isSet(x0, v0, accel))
+      {
+         orbit.reset(x0, v0, accel);
+      }
+      OrbitForce force(accel);
+      return orbit.evaluate(dt, force, x, v);
    }
 
 
@@ -189,6 +217,8 @@ namespace gnsstk
       unsigned kludge = (interval > 0 ? interval : 30);
          // half the interval in seconds = interval*60/2 = interval*30
       endFit = Toe + (kludge*30.0 + 30.0);
+         // the ephemeris may have changed
+      orbit.clear();
    }
 
 
@@ -421,44 +451,28 @@ namespace gnsstk
    } // getSidTime()
 
 
-   Vector<double> GLOFNavEph ::
-   derivative(const Vector<double>& inState, const Vector<double>& accel)
+   void GLOFNavEph ::
+   derivative(const double inState[6], const double accel[3], double dxt[6])
       const
    {
-         // We will need some important PZ90 ellipsoid values
-      PZ90Ellipsoid pz90;
-      const double mu = pz90.gm();          // 398600.44e9;
-      const double ae = pz90.a();           // 6378136
-      const double j02 = -pz90.j20();       // 1082625.7e-9
-      const double we = pz90.angVelocity(); // 7.292115e-5
-         // Let's start getting the current satellite position and velocity
-      double  x(inState(0));          // X coordinate
-      double  y(inState(2));          // Y coordinate
-      double  z(inState(4));          // Z coordinate
-      double r2(x*x + y*y + z*z);
-      double r(std::sqrt(r2));
-      double xmu(mu/r2);
-      double rho(ae/r);
-      double xr(x/r);
-      double yr(y/r);
-      double zr(z/r);
-      double zr2(zr*zr);
-      double k1(-1.5*j02*xmu*rho*rho);
-      double  cm(k1*(1.0-5.0*zr2));
-         // ICD says 1-5, which is incorrect.
-      double cmz(k1*(3.0-5.0*zr2));
-      double k2(cm-xmu);
-      double gloAx(k2*xr + (we*we*x) + (2.0*we*inState(3)) + accel(0));
-         // ICD says +2, which is incorrect.
-      double gloAy(k2*yr + (we*we*y) + (-2.0*we*inState(1)) + accel(1));
-      double gloAz((cmz-xmu)*zr + accel(2));
-      Vector<double> dxt(6, 0.0);
-      dxt(0) = inState(1);       // Set X'  = Vx
-      dxt(1) = gloAx;            // Set Vx' = gloAx
-      dxt(2) = inState(3);       // Set Y'  = Vy
-      dxt(3) = gloAy;            // Set Vy' = gloAy
-      dxt(4) = inState(5);       // Set Z'  = Vz
-      dxt(5) = gloAz;            // Set Vz' = gloAz
-      return dxt;
+      double x[3] = { inState[0], inState[2], inState[4] };
+      double v[3] = { inState[1], inState[3], inState[5] };
+      double a[3];
+      GLODenseOrbit::pz90Accel(PZ90Ellipsoid().angVelocity(), x, v, accel, a);
+      dxt[0] = inState[1];       // Set X'  = Vx
+      dxt[1] = a[0];             // Set Vx' = gloAx
+      dxt[2] = inState[3];       // Set Y'  = Vy
+      dxt[3] = a[1];             // Set Vy' = gloAy
+      dxt[4] = inState[5];       // Set Z'  = Vz
+      dxt[5] = a[2];             // Set Vz' = gloAz
    }  // derivative()
+
+
+   void GLOFNavEph::OrbitForce ::
+   accel(double t, const double pos[3], const double vel[3], double acc[3])
+      const
+   {
+      GLODenseOrbit::pz90Accel(PZ90Ellipsoid().angVelocity(), pos, vel, ls,
+                               acc);
+   }
 }
@@ -40,6 +40,8 @@
 #define GNSSTK_GLOFNAVEPH_HPP
 
 #include "GLOFNavData.hpp"
+#include "GLODenseOrbit.hpp"
+#include "gnsstk_export.h"
 
 namespace gnsstk
 {
@@ -64,6 +66,10 @@ namespace gnsstk
       bool validate() const override;
 
          /** Compute the satellites position and velocity at a time.
+          * If dense is true, the orbit is integrated once and
+          * interpolated (see GLODenseOrbit), otherwise it is
+          * integrated from Toe to \a when with the Runge-Kutta
+          * algorithm using the given step.
           * @param[in] when The time at which to compute the xvt.
           * @param[out] xvt The resulting computed position/velocity.
           * @param[in] oid Value is ignored - GLONASS does not have
@@ -132,11 +138,60 @@ namespace gnsstk
       CommonTime Toe;     ///< Orbit epoch (t_b).
          /// Integration step for Runge-Kutta algorithm (1 second by default)
       double step;
+         /** If true, getXvt() interpolates the dense output of a
+          * single adaptive integration of this ephemeris rather than
+          * integrating from Toe on every call.  The results agree
+          * with the Runge-Kutta algorithm to well below the accuracy
+          * of the broadcast orbit, but are not identical.
+          * @warning getXvt() then fills in the dense orbit as it is
+          *   used, so an object (e.g. one shared through a
+          *   NavLibrary) must not be used by several threads at once
+          *   with dense set. */
+      bool dense;
+
+         /// The initial value of dense for new objects (false).
+      GNSSTK_EXPORT static bool denseDefault;
 
    private:
-         /// Function implementing the derivative of GLONASS orbital model.
-      Vector<double> derivative(const Vector<double>& inState,
-                                const Vector<double>& accel) const;
+         /// Equations of motion for the dense orbit.
+      class OrbitForce : public GLODenseOrbit::Force
+      {
+      public:
+            /// @param[in] accel The luni-solar acceleration in m/s**2.
+         OrbitForce(const double accel[3])
+               : ls(accel)
+         {}
+         void accel(double t, const double pos[3], const double vel[3],
+                    double acc[3]) const override;
+         const double *ls;
+      };
+
+         /** Integrate from Toe to \a when with the Runge-Kutta algorithm.
+          * @param[in] when The time at which to compute the state.
+          * @param[in] x0 The position at Toe in m.
+          * @param[in] v0 The velocity at Toe in m/s.
+          * @param[in] accel The luni-solar acceleration in m/s**2.
+          * @param[out] x The position at \a when in m.
+          * @param[out] v The velocity at \a when in m/s. */
+      void integrate(const CommonTime& when, const double x0[3],
+                     const double v0[3], const double accel[3],
+                     double x[3], double v[3]) const;
+
+         /** Compute the state \a dt seconds from Toe from the dense
+          * orbit, (re)starting it as needed.  Arguments as integrate().
+          * @return false if \a dt is beyond the span of the dense orbit. */
+      bool denseXv(double dt, const double x0[3], const double v0[3],
+                   const double accel[3], double x[3], double v[3]);
+
+         /** Function implementing the derivative of GLONASS orbital model.
+          * @param[in] inState The state vector [x, x', y, y', z, z'].
+          * @param[in] accel The acceleration values, [x'', y'', z''].
+          * @param[out] dxt The derivative [x',Vx',Y',Vy',Z',Vz']. */
+      void derivative(const double inState[6], const double accel[3],
+                      double dxt[6]) const;
+
+         /// Dense output of the orbit, filled in by getXvt().
+      GLODenseOrbit orbit;
    };
 
       //@}
@@ -413,6 +413,22 @@ namespace gnsstk
    }
 
 
+   void MultiFormatNavDataFactory ::
+   setLazyLoad(bool lazy, unsigned maxFiles)
+   {
+      NavDataFactoryWithStoreFile::setLazyLoad(lazy, maxFiles);
+      for (auto& i : NDFUniqIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactoryWithStoreFile *fact =
+            dynamic_cast<NavDataFactoryWithStoreFile*>(i.second.get());
+         if (fact != nullptr)
+         {
+            fact->setLazyLoad(lazy, maxFiles);
+         }
+      }
+   }
+
+
    bool MultiFormatNavDataFactory ::
    addFactory(NavDataFactoryPtr& fact)
    {
@@ -283,6 +283,12 @@ namespace gnsstk
           *   next load. */
       void addTypeFilter(NavMessageType nmt) override;
 
+         /** Choose whether each of the factories loads files
+          * immediately or only when they are needed.  The limit on
+          * loaded files applies to each factory separately.
+          * @copydetails NavDataFactoryWithStoreFile::setLazyLoad() */
+      void setLazyLoad(bool lazy, unsigned maxFiles = 0) override;
+
          /** Method for loading data.  This will iterate over the
           * available factories, calling their load method until one
           * succeeds, since failure typically indicates an invalid
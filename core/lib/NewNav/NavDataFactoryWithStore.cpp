@@ -953,6 +953,121 @@ namespace gnsstk
    }
 
 
+   void NavDataFactoryWithStore ::
+   removeNavData(const NavDataPtr& nd)
+   {
+      auto mti = data.find(nd->signal.messageType);
+      if (mti != data.end())
+      {
+         auto sati = mti->second.find(nd->signal);
+         if (sati != mti->second.end())
+         {
+            auto ti = sati->second.find(nd->getUserTime());
+            if ((ti != sati->second.end()) && (ti->second == nd))
+            {
+               sati->second.erase(ti);
+               if (sati->second.empty())
+               {
+                  mti->second.erase(sati);
+                  if (mti->second.empty())
+                     data.erase(mti);
+               }
+            }
+         }
+      }
+      auto nmti = nearestData.find(nd->signal.messageType);
+      if (nmti != nearestData.end())
+      {
+         auto sati = nmti->second.find(nd->signal);
+         if (sati != nmti->second.end())
+         {
+            auto ti = sati->second.find(nd->getNearTime());
+            if (ti != sati->second.end())
+            {
+               ti->second.remove(nd);
+               if (ti->second.empty())
+               {
+                  sati->second.erase(ti);
+                  if (sati->second.empty())
+                  {
+                     nmti->second.erase(sati);
+                     if (nmti->second.empty())
+                        nearestData.erase(nmti);
+                  }
+               }
+            }
+         }
+      }
+      TimeOffsetData *todp = dynamic_cast<TimeOffsetData*>(nd.get());
+      if (todp != nullptr)
+      {
+         TimeCvtSet conversions = todp->getConversions();
+         for (const auto& ci : conversions)
+         {
+            auto oci = offsetData.find(ci);
+            if (oci == offsetData.end())
+               continue;
+            auto oei = oci->second.find(nd->getUserTime());
+            if (oei == oci->second.end())
+               continue;
+            auto osi = oei->second.find(nd->signal);
+            if ((osi != oei->second.end()) && (osi->second == nd))
+            {
+               oei->second.erase(osi);
+               if (oei->second.empty())
+               {
+                  oci->second.erase(oei);
+                  if (oci->second.empty())
+                     offsetData.erase(oci);
+               }
+            }
+         }
+      }
+         // Forget unique time offsets, so they can be added again.
+      if (auto stodp = std::dynamic_pointer_cast<StdNavTimeOffset>(nd))
+      {
+         auto svi = touBySV.find(nd->signal.xmitSat);
+         if (svi != touBySV.end())
+         {
+            auto ui = svi->second.find(stodp);
+            if ((ui != svi->second.end()) && (*ui == stodp))
+               svi->second.erase(ui);
+         }
+         auto sigi = touBySig.find(nd->signal);
+         if (sigi != touBySig.end())
+         {
+            auto ui = sigi->second.find(stodp);
+            if ((ui != sigi->second.end()) && (*ui == stodp))
+               sigi->second.erase(ui);
+         }
+      }
+   }
+
+
+   void NavDataFactoryWithStore ::
+   restoreNavData(const NavDataPtr& nd)
+   {
+      NavMap& nm(data[nd->signal.messageType][nd->signal]);
+      if (nm.find(nd->getUserTime()) == nm.end())
+      {
+         nm[nd->getUserTime()] = nd;
+      }
+      TimeOffsetData *todp = dynamic_cast<TimeOffsetData*>(nd.get());
+      if (todp != nullptr)
+      {
+         TimeCvtSet conversions = todp->getConversions();
+         for (const auto& ci : conversions)
+         {
+            OffsetMap& om(offsetData[ci][nd->getUserTime()]);
+            if (om.find(nd->signal) == om.end())
+            {
+               om[nd->signal] = nd;
+            }
+         }
+      }
+   }
+
+
    bool NavDataFactoryWithStore ::
    updateInitialFinal(const CommonTime& begin, const CommonTime& end)
    {
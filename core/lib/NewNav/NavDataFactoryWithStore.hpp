@@ -159,6 +159,12 @@ namespace gnsstk
       bool addNavData(const NavDataPtr& nd, NavMessageMap& navMap,
                       NavNearMessageMap& navNearMap, OffsetCvtMap& ofsMap);
 
+         /** Remove a nav message from the internal store.  Entries
+          * holding a different object with the same key are left
+          * alone.  The initial and final times are not changed.
+          * @param[in] nd The nav data to remove. */
+      void removeNavData(const NavDataPtr& nd);
+
          /** Determine the earliest time for which this object can successfully
           * determine the Xvt for any object.
           * @return The initial time, or CommonTime::END_OF_TIME if no
@@ -452,6 +458,14 @@ namespace gnsstk
           * @post initialTime and/or finalTime may be updated. */
       bool updateInitialFinal(const CommonTime& begin, const CommonTime& end);
 
+         /** Put a nav message back into the internal store wherever
+          * its key is no longer in use, after removeNavData() has
+          * removed another message with the same key.  Only the
+          * User-order and time offset storage is affected, as the
+          * Nearest storage keeps every message.
+          * @param[in] nd The nav data to restore. */
+      void restoreNavData(const NavDataPtr& nd);
+
          /// Internal storage of navigation data for User searches
       NavMessageMap data;
          /// Internal storage of navigation data for Nearest searches
@@ -0,0 +1,262 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+#include "NavDataFactoryWithStoreFile.hpp"
+#include "NavDataFactoryStoreCallback.hpp"
+#include "NavFit.hpp"
+#include "OrbitData.hpp"
+
+namespace gnsstk
+{
+   class NavDataFactoryWithStoreFile::SpanCallback
+      : public NavDataFactoryCallback
+   {
+   public:
+      SpanCallback(NavDataFactoryWithStoreFile* ndf)
+            : fact(ndf), found(false)
+      {}
+
+         /** Extend the span to include the times of navOut, and the
+          * factory's initial and final times as addNavData() would.
+          * @param[in] navOut The data to process in the callback.
+          * @return true if successful. */
+      bool process(const NavDataPtr& navOut) override
+      {
+         NavFit *nf = dynamic_cast<NavFit*>(navOut.get());
+         OrbitData *odp = dynamic_cast<OrbitData*>(navOut.get());
+         if (nf != nullptr)
+         {
+            if (!fact->updateInitialFinal(nf->beginFit, nf->endFit))
+               return false;
+            extend(nf->beginFit);
+            extend(nf->endFit);
+         }
+         else if (odp != nullptr)
+         {
+            if (!fact->updateInitialFinal(odp->timeStamp, odp->timeStamp))
+               return false;
+         }
+         extend(navOut->timeStamp);
+         extend(navOut->getUserTime());
+         extend(navOut->getNearTime());
+         return true;
+      }
+
+         /// Add t, ignoring its time system, to the span.
+      void extend(const CommonTime& t)
+      {
+         CommonTime anyT(t);
+         anyT.setTimeSystem(TimeSystem::Any);
+         if (!found)
+         {
+            begin = end = anyT;
+            found = true;
+         }
+         else if (anyT < begin)
+            begin = anyT;
+         else if (end < anyT)
+            end = anyT;
+      }
+
+      NavDataFactoryWithStoreFile *fact;
+         /// true if any data have been processed.
+      bool found;
+         /// The span of the data processed.
+      CommonTime begin, end;
+   };
+
+
+   bool NavDataFactoryWithStoreFile ::
+   addDataSource(const std::string& source)
+   {
+      if (!lazyLoad)
+      {
+         return loadIntoMap(source, data, nearestData, offsetData);
+      }
+      CommonTime begin, end;
+      if (lazyFiles.getTimeSpan(source, begin, end))
+      {
+            // already added
+         return true;
+      }
+      SpanCallback cb(this);
+      if (!process(source, cb))
+      {
+         return false;
+      }
+      if (cb.found)
+      {
+         LazyFile lf;
+         lazyFiles.addFile(source, lf, cb.begin, cb.end);
+         lastLoadValid = false;
+      }
+      return true;
+   }
+
+
+   bool NavDataFactoryWithStoreFile ::
+   find(const NavMessageID& nmid, const CommonTime& when,
+        NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
+        NavSearchOrder order)
+   {
+      loadForTime(when);
+      return NavDataFactoryWithStore::find(nmid, when, navOut, xmitHealth,
+                                           valid, order);
+   }
+
+
+   bool NavDataFactoryWithStoreFile ::
+   getOffset(TimeSystem fromSys, TimeSystem toSys,
+             const CommonTime& when, NavDataPtr& offset,
+             SVHealth xmitHealth, NavValidityType valid)
+   {
+      loadForTime(when);
+      return NavDataFactoryWithStore::getOffset(fromSys, toSys, when, offset,
+                                                xmitHealth, valid);
+   }
+
+
+   void NavDataFactoryWithStoreFile ::
+   clear()
+   {
+      NavDataFactoryWithStore::clear();
+      lazyFiles.clear();
+      lastLoadValid = false;
+   }
+
+
+   void NavDataFactoryWithStoreFile ::
+   setLazyLoad(bool lazy, unsigned maxFiles)
+   {
+      lazyLoad = lazy;
+      lazyFiles.setMaxLoaded(maxFiles);
+   }
+
+
+   void NavDataFactoryWithStoreFile ::
+   loadForTime(const CommonTime& when)
+   {
+      if (!lazyLoad || (lazyFiles.nfiles() == 0))
+         return;
+         // Searches for many satellites at the same time are the
+         // common case, so skip the search for the files needed.
+      CommonTime anyWhen(when);
+      anyWhen.setTimeSystem(TimeSystem::Any);
+      if (lastLoadValid && (anyWhen == lastLoadTime))
+         return;
+      std::vector<std::string> needed = lazyFiles.getFilesForTime(anyWhen);
+      for (const auto& fn : needed)
+      {
+         if (!lazyFiles.useFile(fn))
+            loadFile(fn);
+      }
+      std::vector<std::string> unused = lazyFiles.trimLoaded(needed.size());
+      for (const auto& fn : unused)
+      {
+         unloadFile(fn);
+      }
+      lastLoadTime = anyWhen;
+      lastLoadValid = true;
+   }
+
+
+   void NavDataFactoryWithStoreFile ::
+   loadFile(const std::string& filename)
+   {
+         // Load into separate maps first so the data from this file
+         // can be told apart from that of other files.
+      NavMessageMap navMap;
+      NavNearMessageMap navNearMap;
+      OffsetCvtMap ofsMap;
+      LazyFile& lf(lazyFiles.getHeader(filename));
+      lf.records.clear();
+      loadIntoMap(filename, navMap, navNearMap, ofsMap);
+      for (auto& mti : navMap)
+      {
+         for (auto& sati : mti.second)
+         {
+            for (auto& ti : sati.second)
+            {
+               data[mti.first][sati.first][ti.first] = ti.second;
+               lf.records.push_back(ti.second);
+            }
+         }
+      }
+      for (auto& mti : navNearMap)
+      {
+         for (auto& sati : mti.second)
+         {
+            for (auto& ti : sati.second)
+            {
+               NavDataPtrList& ndl(nearestData[mti.first][sati.first][ti.first]);
+               ndl.splice(ndl.end(), ti.second);
+            }
+         }
+      }
+      for (auto& oci : ofsMap)
+      {
+         for (auto& oei : oci.second)
+         {
+            for (auto& osi : oei.second)
+            {
+               offsetData[oci.first][oei.first][osi.first] = osi.second;
+            }
+         }
+      }
+   }
+
+
+   void NavDataFactoryWithStoreFile ::
+   unloadFile(const std::string& filename)
+   {
+      LazyFile& lf(lazyFiles.getHeader(filename));
+      for (const auto& nd : lf.records)
+      {
+         removeNavData(nd);
+      }
+      std::vector<NavDataPtr>().swap(lf.records);
+         // Other loaded files may hold data with the same keys as
+         // the data just removed.
+      for (const auto& fn : lazyFiles.getLoadedFiles())
+      {
+         for (const auto& nd : lazyFiles.getHeader(fn).records)
+         {
+            restoreNavData(nd);
+         }
+      }
+   }
+}
@@ -41,28 +41,88 @@
 
 #include "NavDataFactoryWithStore.hpp"
 #include "NavDataFactoryCallback.hpp"
+#include "FileStore.hpp"
 
 namespace gnsstk
 {
       /// @ingroup NavFactory
       //@{
 
-      /// Define an interface for loading nav data from a file
+      /** Define an interface for loading nav data from a file.
+       *
+       * By default, addDataSource() loads the whole file.  After
+       * setLazyLoad(true), addDataSource() only reads the file to
+       * determine the span of time its data cover, and the data are
+       * loaded by the first find() or getOffset() that needs them,
+       * i.e. one whose time is within the file's span (or, if no
+       * file's span includes the time, the nearest files before and
+       * after it).  A limit on the number of files loaded at once
+       * keeps memory use proportional to the span of time being
+       * searched rather than the number of files added; the least
+       * recently used files are unloaded to stay within it.
+       *
+       * @note In lazy mode, methods other than find() and
+       *   getOffset(), such as count(), getAvailableSats() and
+       *   edit(), only see the data of the files currently loaded.
+       *   getInitialTime() and getFinalTime() cover all files.
+       * @note Factories that override addDataSource() and find(),
+       *   such as SP3NavDataFactory, always load files immediately.
+       */
    class NavDataFactoryWithStoreFile : public NavDataFactoryWithStore
    {
    public:
       NavDataFactoryWithStoreFile()
+            : lazyLoad(false), lastLoadValid(false)
       {}
 
          /// Clean up.
       virtual ~NavDataFactoryWithStoreFile()
       {
       }
-         /** Load a file into the default map, NavDataFactoryWithStore::data.
+         /** Load a file into the default map,
+          * NavDataFactoryWithStore::data, or in lazy mode, record
+          * the span of time it covers for loading later.
           * @param[in] source The path to the file to load.
           * @return true on success, false on failure. */
-      bool addDataSource(const std::string& source) override
-      { return loadIntoMap(source, data, nearestData, offsetData); }
+      bool addDataSource(const std::string& source) override;
+
+         /// @copydoc NavDataFactoryWithStore::find()
+         /// @note In lazy mode, the files needed are loaded first.
+      bool find(const NavMessageID& nmid, const CommonTime& when,
+                NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
+                NavSearchOrder order) override;
+
+         /// @copydoc NavDataFactoryWithStore::getOffset()
+         /// @note In lazy mode, the files needed are loaded first.
+      bool getOffset(TimeSystem fromSys, TimeSystem toSys,
+                     const CommonTime& when, NavDataPtr& offset,
+                     SVHealth xmitHealth = SVHealth::Any,
+                     NavValidityType valid = NavValidityType::ValidOnly)
+         override;
+
+         /// Remove all data, and in lazy mode all files, from the store.
+      void clear() override;
+
+         /** Choose whether addDataSource() loads files immediately
+          * (the default) or only when they are needed.  This should
+          * be called before adding any data sources.
+          * @param[in] lazy true to load files when needed.
+          * @param[in] maxFiles The maximum number of files to keep
+          *   loaded at once in lazy mode, 0 for no limit.  More may
+          *   be loaded if a single search needs them. */
+      virtual void setLazyLoad(bool lazy, unsigned maxFiles = 0);
+
+         /// Return true if files are loaded only when needed.
+      bool getLazyLoad() const
+      { return lazyLoad; }
+
+         /// Return the number of files added in lazy mode.
+      unsigned numLazyFiles() const
+      { return lazyFiles.nfiles(); }
+
+         /// Return the number of files added in lazy mode that are loaded.
+      unsigned numLoadedFiles() const
+      { return lazyFiles.nloaded(); }
 
          /** Abstract method that should be overridden by specific
           * file-reading factory classes in order to load the data
@@ -91,6 +151,41 @@ namespace gnsstk
           * @return true on success, false on failure. */
       virtual bool process(const std::string& filename,
                            NavDataFactoryCallback& cb) = 0;
+
+   protected:
+         /** Load the files needed for a search at time when that
+          * aren't already loaded, and unload the least recently used
+          * files beyond the limit.  Does nothing unless in lazy mode.
+          * @param[in] when The time of the search. */
+      void loadForTime(const CommonTime& when);
+
+   private:
+         /// What is kept for each file added in lazy mode.
+      struct LazyFile
+      {
+            /// The data loaded from the file, empty if not loaded.
+         std::vector<NavDataPtr> records;
+            /// Used by FileStore::dump().
+         void dump(std::ostream& s) const
+         { s << "  " << records.size() << " records loaded" << std::endl; }
+      };
+
+         /// Load a file added in lazy mode into the internal store.
+      void loadFile(const std::string& filename);
+         /// Remove a file added in lazy mode from the internal store.
+      void unloadFile(const std::string& filename);
+
+         /// Records the span of time covered by each file in lazy mode.
+      class SpanCallback;
+
+         /// true if files are loaded only when needed.
+      bool lazyLoad;
+         /// Files added in lazy mode, with their spans and data.
+      FileStore<LazyFile> lazyFiles;
+         /// Time of the last loadForTime(), without time system.
+      CommonTime lastLoadTime;
+         /// true if the files for lastLoadTime are still loaded.
+      bool lastLoadValid;
    };
 
       //@}
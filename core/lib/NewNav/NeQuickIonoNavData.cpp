@@ -37,6 +37,8 @@
 //
 //==============================================================================
 #include <cmath>
+#include <map>
+#include <mutex>
 #include <string.h>
 #include "NeQuickIonoNavData.hpp"
 #include "TimeString.hpp"
@@ -120,7 +122,9 @@ namespace gnsstk
    NeQuickIonoNavData ::
    NeQuickIonoNavData()
          : ai{0,0,0},
-           idf{false,false,false,false,false}
+           idf{false,false,false,false,false},
+           useF2Grid(false),
+           f2GridStep(1.0)
    {
    }
 
@@ -206,6 +210,50 @@ namespace gnsstk
          // Obtain receiver modified dip latitude
       MODIP modip;
       CCIR ccir;
+      return integrateTEC(civ, rxgeo, svgeo, modip, ccir, false);
+   }
+
+
+   std::vector<double> NeQuickIonoNavData ::
+   getTEC(const CommonTime& when,
+          const std::vector<Position>& rxgeo,
+          const std::vector<Position>& svgeo)
+      const
+   {
+      DEBUGTRACE_FUNCTION();
+      if ((rxgeo.size() != 1) && (rxgeo.size() != svgeo.size()))
+      {
+         InvalidParameter exc("Receiver position count " +
+                              std::to_string(rxgeo.size()) +
+                              " does not match satellite position count " +
+                              std::to_string(svgeo.size()));
+         GNSSTK_THROW(exc);
+      }
+      std::vector<double> rv(svgeo.size(), 0.0);
+      if (svgeo.empty())
+      {
+         return rv;
+      }
+      CivilTime civ(when);
+      MODIP modip;
+      CCIR ccir;
+      ccir.fourierBasis(when);
+      for (unsigned i = 0; i < svgeo.size(); i++)
+      {
+         const Position& rx(rxgeo.size() == 1 ? rxgeo[0] : rxgeo[i]);
+         rv[i] = integrateTEC(civ, rx, svgeo[i], modip, ccir, true);
+      }
+      return rv;
+   }
+
+
+   double NeQuickIonoNavData ::
+   integrateTEC(const CivilTime& when, const Position& rxgeo,
+                const Position& svgeo, const MODIP& modip, CCIR& ccirData,
+                bool useBasis)
+      const
+   {
+      DEBUGTRACE_FUNCTION();
          // pre-determine in a somewhat clumsy, but probably faster
          // method than elevation() if the satellite is directly above
          // the station.
@@ -218,6 +266,17 @@ namespace gnsstk
       DEBUGTRACE("computing azu");
       double modip_u = modip.stModip(rxgeo);
       double azu = getEffIonoLevel(modip_u);
+      std::shared_ptr<const F2Grid> gridPtr;
+      const F2Grid *grid = nullptr;
+      if (useF2Grid)
+      {
+         gridPtr = getF2Grid(when, ccirData, modip);
+         grid = gridPtr.get();
+      }
+      else if (useBasis)
+      {
+         ccirData.fourierFromBasis(ModelParameters::effSunSpots(azu));
+      }
       DEBUGTRACE("azu = " << azu);
       DEBUGTRACE("vertical=" << vertical);
       DEBUGTRACE("rxgeo.geodeticLatitude()=" << rxgeo.geodeticLatitude());
@@ -249,8 +308,9 @@ namespace gnsstk
          {
             rv += integrateGaussKronrod(ip.integHeights[i-1],
                                         ip.integHeights[i],
-                                        rxgeo, svgeo, modip, modip_u, ccir, civ,
-                                        azu, ip.intThresh[i-1], vertical);
+                                        rxgeo, svgeo, modip, modip_u, ccirData,
+                                        when, azu, ip.intThresh[i-1], vertical,
+                                        0, grid);
          }
       }
          // scale as per eq.151 and eq.202
@@ -284,15 +344,17 @@ namespace gnsstk
    double NeQuickIonoNavData ::
    getSED(double dist, const Position& rxgeo, const Position& svgeo,
           const MODIP& modip, CCIR& ccirData, const CivilTime& when,
-          double azu)
+          double azu, const F2Grid *grid)
       const
    {
       DEBUGTRACE_FUNCTION();
       DEBUGTRACE("height_km=" << setprecision(15) << dist);
       Position current(rxgeo.getRayPosition(dist * 1000.0, svgeo));
-      double modip_u = modip.stModip(current);
+         // MODIP is only needed for foF2 and M(3000)F2, already
+         // folded into the grid if there is one.
+      double modip_u = (grid == nullptr ? modip.stModip(current) : 0.0);
       DEBUGTRACE("constructing SED iono");
-      ModelParameters iono(modip_u, current, azu, ccirData, when);
+      ModelParameters iono(modip_u, current, azu, ccirData, when, grid);
       double electronDensity = iono.electronDensity(current);
       DEBUGTRACE("electron density=" << setprecision(15) << scientific
                  << electronDensity);
@@ -303,7 +365,7 @@ namespace gnsstk
    double NeQuickIonoNavData ::
    getVED(double dist, const Position& rxgeo, const Position& svgeo,
           double modip_u, CCIR& ccirData, const CivilTime& when,
-          double azu)
+          double azu, const F2Grid *grid)
       const
    {
       DEBUGTRACE_FUNCTION();
@@ -312,7 +374,7 @@ namespace gnsstk
       Position current(rxgeo.geocentricLatitude(), rxgeo.longitude(), dist*1000,
                        Position::Geodetic, &elModel);
       DEBUGTRACE("constructing VED iono");
-      ModelParameters iono(modip_u, current, azu, ccirData, when);
+      ModelParameters iono(modip_u, current, azu, ccirData, when, grid);
       double electronDensity = iono.electronDensity(current);
       return electronDensity;
    }
@@ -335,7 +397,7 @@ namespace gnsstk
 
    NeQuickIonoNavData::ModelParameters ::
    ModelParameters(double modip_u, const Position& pos, double az,
-                   CCIR& ccirData, const CivilTime& when)
+                   CCIR& ccirData, const CivilTime& when, const F2Grid *grid)
          : fXeff(effSolarZenithAngle(pos,when)),
            ffoF1(0.0), // default to 0, see eq.37
            ccir(ccirData)
@@ -345,7 +407,7 @@ namespace gnsstk
       DEBUGTRACE("pos = " << pos);
       DEBUGTRACE("solar_12_month_running_mean_of_2800_MHZ_noise_flux=" << az);
          // get the effective sunspot number
-      fAzr = sqrt(167273+(az-DEFAULT_IONO_LEVEL)*1123.6)-408.99;        // eq.19
+      fAzr = effSunSpots(az);
       switch (when.month)
       {
          case 1:
@@ -408,9 +470,16 @@ namespace gnsstk
       DEBUGTRACE("seas=" << seas);
       DEBUGTRACE("ee=" << scientific << ee);
       DEBUGTRACE("seasp=" << seasp);
-         // Compute the fourier time series for foF2 and M(3000)F2
-      ccir.fourier(when, fAzr);
-      legendre(modip_u, pos);
+      if (grid == nullptr)
+      {
+            // Compute the fourier time series for foF2 and M(3000)F2
+         ccir.fourier(when, fAzr);
+         legendre(modip_u, pos);
+      }
+      else
+      {
+         grid->lookup(phi, lambda, fAzr, ffoF2, fM3000F2);
+      }
       fNmF2 = FREQ2NE_D * ffoF2 * ffoF2;                                //eq.77
          // Compute peak electron density height for each layer
       height();
@@ -448,6 +517,13 @@ namespace gnsstk
    }
 
 
+   double NeQuickIonoNavData::ModelParameters ::
+   effSunSpots(double az)
+   {
+      return sqrt(167273+(az-DEFAULT_IONO_LEVEL)*1123.6)-408.99;        // eq.19
+   }
+
+
    AngleReduced NeQuickIonoNavData::ModelParameters ::
    solarDeclination(const CivilTime& when)
    {
@@ -814,6 +890,275 @@ namespace gnsstk
    }
 
 
+   std::shared_ptr<const NeQuickIonoNavData::F2Grid> NeQuickIonoNavData ::
+   getF2Grid(const CivilTime& when, CCIR& ccirData, const MODIP& modip)
+      const
+   {
+      std::shared_ptr<const F2Grid> rv(std::atomic_load(&f2Grid));
+      if (rv && rv->isCurrent(when, f2GridStep))
+      {
+         return rv;
+      }
+         // Build a new grid rather than updating the shared one,
+         // which other threads may be reading.  Threads that get
+         // here at the same time each build their own, and the last
+         // one stored is kept.
+      std::shared_ptr<F2Grid> grid = std::make_shared<F2Grid>();
+      grid->update(when, f2GridStep, ccirData, modip);
+      rv = grid;
+      std::atomic_store(&f2Grid, rv);
+      return rv;
+   }
+
+
+   NeQuickIonoNavData::F2Grid ::
+   F2Grid()
+         : month(0),
+           hour(-1),
+           step(0),
+           nLat(0),
+           nLon(0)
+   {
+   }
+
+
+   void NeQuickIonoNavData::F2Grid ::
+   update(const CivilTime& when, double step, CCIR& ccirData,
+          const MODIP& modip)
+   {
+      DEBUGTRACE_FUNCTION();
+         // nodes are needed at both poles and at +/-180 longitude
+      double cells = 90.0 / step;
+      if (!(step > 0) || (std::fabs(cells - std::round(cells)) > 1e-9))
+      {
+         InvalidParameter exc("F2 grid step " + std::to_string(step) +
+                              " is not a positive divisor of 90 degrees");
+         GNSSTK_THROW(exc);
+      }
+      CivilTime whenUTC(toUTC(when));
+      double utHour = whenUTC.getUTHour();
+      if ((month != whenUTC.month) || (this->step != step) || !monthGrid)
+      {
+         nLat = unsigned(std::lround(180.0 / step)) + 1;
+         nLon = unsigned(std::lround(360.0 / step)) + 1;
+         monthGrid = getMonthGrid(whenUTC.month, step, nLat, nLon, ccirData,
+                                  modip);
+         month = whenUTC.month;
+         this->step = step;
+         hour = -1;
+      }
+      if (hour == utHour)
+      {
+         return;
+      }
+         // Fourier series terms, as in CCIR::fourier()
+      double t = (15.0 * utHour - 180.0) * PI / 180.0;                  //eq.49
+      double T[CCIR::F2MaxOrder];
+      T[0] = 1.0;
+      for (unsigned k = 0; k < 6; k++)
+      {
+         T[2*k+1] = sin((k+1)*t);
+         T[2*k+2] = cos((k+1)*t);
+      }
+      const unsigned F2 = CCIR::F2MaxOrder, M3 = CCIR::FM3MaxOrder;
+      const unsigned stride = 2 * (F2 + M3);
+      const MonthGrid& mg(*monthGrid);
+      nodes.resize(4 * nLat * nLon);
+      for (unsigned n = 0; n < nLat * nLon; n++)
+      {
+         const double *src = &mg[n * stride];
+         double *node = &nodes[4 * n];
+         node[0] = node[1] = node[2] = node[3] = 0.0;
+         for (unsigned h = 0; h < F2; h++)
+         {
+            node[0] += T[h] * src[h];
+            node[1] += T[h] * src[F2 + h];
+         }
+         for (unsigned h = 0; h < M3; h++)
+         {
+            node[2] += T[h] * src[2*F2 + h];
+            node[3] += T[h] * src[2*F2 + M3 + h];
+         }
+      }
+      hour = utHour;
+   }
+
+
+   bool NeQuickIonoNavData::F2Grid ::
+   isCurrent(const CivilTime& when, double step) const
+   {
+      if (!monthGrid || (this->step != step))
+      {
+         return false;
+      }
+      CivilTime whenUTC(toUTC(when));
+      return ((month == whenUTC.month) && (hour == whenUTC.getUTHour()));
+   }
+
+
+   CivilTime NeQuickIonoNavData::F2Grid ::
+   toUTC(const CivilTime& when)
+   {
+      CivilTime rv(when);
+      if (rv.getTimeSystem() != gnsstk::TimeSystem::UTC)
+      {
+         gnsstk::BasicTimeSystemConverter btsc;
+         GNSSTK_ASSERT(rv.changeTimeSystem(gnsstk::TimeSystem::UTC,&btsc));
+      }
+      return rv;
+   }
+
+
+   std::shared_ptr<const NeQuickIonoNavData::F2Grid::MonthGrid>
+   NeQuickIonoNavData::F2Grid ::
+   getMonthGrid(unsigned month, double step, unsigned nLat, unsigned nLon,
+                CCIR& ccirData, const MODIP& modip)
+   {
+      static std::mutex cacheMutex;
+      static std::map<std::pair<unsigned,double>,
+                      std::weak_ptr<const MonthGrid> > cache;
+      std::lock_guard<std::mutex> lock(cacheMutex);
+      std::weak_ptr<const MonthGrid>& entry(cache[std::make_pair(month,step)]);
+      std::shared_ptr<const MonthGrid> rv(entry.lock());
+      if (rv)
+      {
+         return rv;
+      }
+      DEBUGTRACE("building F2 month grid " << month << " step " << step);
+      const unsigned F2 = CCIR::F2MaxOrder, M3 = CCIR::FM3MaxOrder;
+      const unsigned stride = 2 * (F2 + M3);
+      std::vector<double> af2[2], am3[2];
+      for (int cond = 0; cond < 2; cond++)
+      {
+         ccirData.getCoefficients(month, cond, af2[cond], am3[cond]);
+      }
+      std::shared_ptr<MonthGrid> grid =
+         std::make_shared<MonthGrid>(stride * nLat * nLon, 0.0);
+      double bF2[CCIR::F2MaxDegree], bM3[CCIR::FM3MaxDegree];
+      for (unsigned i = 0; i < nLat; i++)
+      {
+         double lat = std::min(-90.0 + i * step, 90.0);
+         for (unsigned j = 0; j < nLon; j++)
+         {
+            Position pos(lat, -180.0 + j * step, 0.0, Position::Geodetic);
+            legendreTerms(modip.stModip(pos), pos, bF2, bM3);
+            double *node = &(*grid)[(i * nLon + j) * stride];
+            for (unsigned cond = 0; cond < 2; cond++)
+            {
+               const double *a = &af2[cond][0];
+               double *dst = node + cond * F2;
+               for (unsigned d = 0; d < CCIR::F2MaxDegree; d++)
+               {
+                  for (unsigned h = 0; h < F2; h++)
+                  {
+                     dst[h] += a[d*F2 + h] * bF2[d];
+                  }
+               }
+               a = &am3[cond][0];
+               dst = node + 2*F2 + cond * M3;
+               for (unsigned d = 0; d < CCIR::FM3MaxDegree; d++)
+               {
+                  for (unsigned h = 0; h < M3; h++)
+                  {
+                     dst[h] += a[d*M3 + h] * bM3[d];
+                  }
+               }
+            }
+         }
+      }
+      entry = grid;
+      return grid;
+   }
+
+
+   void NeQuickIonoNavData::F2Grid ::
+   legendreTerms(double modip_u, const Position& pos,
+                 double bF2[CCIR::F2MaxDegree], double bM3[CCIR::FM3MaxDegree])
+   {
+         // This follows ModelParameters::legendre(), which see.
+      double M[F2LayerMODIPCoeffCount];                                 //eq.52
+      double P[F2LayerLongCoeffCount];                                  //eq.53
+      double S[F2LayerLongCoeffCount];                                  //eq.54
+      double C[F2LayerLongCoeffCount];                                  //eq.55
+      const unsigned Q[] {12,12,9,5,2,1,1,1,1};                         //eq.63
+      const int K[] {-12, 12, 36, 54, 64, 68, 70, 72, 74};              //eq.66
+      const unsigned R[] {7,8,6,3,2,1,1};                               //eq.71
+      const int H[] {-7,7,23,35,41,45,47};                              //eq.74
+      double sinModip = sin(modip_u * DEG2RAD);
+      double cosPhi = cos(pos.geodeticLatitude() * DEG2RAD);
+      double lambdaRad = pos.longitude() * DEG2RAD;
+      M[0] = 1.0;                                                       //eq.56
+      for (unsigned k = 1; k<F2LayerMODIPCoeffCount; k++)
+      {
+         M[k] = M[k-1] * sinModip;                                      //eq.57
+      }
+      P[0] = 1.0;
+      for (unsigned n = 1; n < F2LayerLongCoeffCount; n++)
+      {
+         P[n] = P[n-1] * cosPhi;                                        //eq.58
+         S[n-1] = sin(n * lambdaRad);                                   //eq.59
+         C[n-1] = cos(n * lambdaRad);                                   //eq.60
+      }
+      for (unsigned k = 0; k<F2LayerMODIPCoeffCount; k++)
+      {
+         bF2[k] = M[k];                                                 //eq.61
+      }
+      for (unsigned n = 1; n<F2LayerLongCoeffCount; n++)
+      {
+         for (unsigned k=0; k<Q[n]; k++)
+         {
+            bF2[K[n]+2*k] = C[n-1] * M[k] * P[n];                       //eq.67
+            bF2[K[n]+2*k+1] = S[n-1] * M[k] * P[n];
+         }
+      }
+      for (unsigned k=0; k<F2TransFactorCoeffCount; k++)
+      {
+         bM3[k] = M[k];                                                 //eq.69
+      }
+      for (unsigned n = 1; n<F2TransFactorCoeffCount; n++)
+      {
+         for (unsigned k=0; k<R[n]; k++)
+         {
+            bM3[H[n]+2*k] = C[n-1] * M[k] * P[n];                       //eq.75
+            bM3[H[n]+2*k+1] = S[n-1] * M[k] * P[n];
+         }
+      }
+   }
+
+
+   void NeQuickIonoNavData::F2Grid ::
+   lookup(double lat, double lon, double effSunSpots,
+          double& foF2, double& m3000F2) const
+   {
+      double y = (std::max(-90.0, std::min(90.0, lat)) + 90.0) / step;
+      double x = fmod(lon + 180.0, 360.0);
+      if (x < 0)
+      {
+         x += 360.0;
+      }
+      x /= step;
+      unsigned i = std::min(unsigned(y), nLat - 2);
+      unsigned j = std::min(unsigned(x), nLon - 2);
+      double fy = y - i;
+      double fx = x - j;
+      const double *n00 = &nodes[4 * (i * nLon + j)];
+      const double *n01 = n00 + 4;
+      const double *n10 = n00 + 4 * nLon;
+      const double *n11 = n10 + 4;
+      double w00 = (1 - fy) * (1 - fx), w01 = (1 - fy) * fx;
+      double w10 = fy * (1 - fx), w11 = fy * fx;
+      double v[4];
+      for (unsigned k = 0; k < 4; k++)
+      {
+         v[k] = w00 * n00[k] + w01 * n01[k] + w10 * n10[k] + w11 * n11[k];
+      }
+         // same sun spot interpolation as eq.44 and eq.46
+      double effSunSpotCount = effSunSpots / 100.0;
+      foF2 = v[0] * (1.0 - effSunSpotCount) + v[1] * effSunSpotCount;
+      m3000F2 = v[2] * (1.0 - effSunSpotCount) + v[3] * effSunSpotCount;
+   }
+
+
    NeQuickIonoNavData::IntegrationParameters ::
    IntegrationParameters(const Position& rx, const Position& sv,
                          const Position& Pp, bool vertical)
@@ -914,7 +1259,8 @@ namespace gnsstk
                          const Position& rxgeo, const Position& svgeo,
                          const MODIP& modip, double modipSta, CCIR& ccirData,
                          const CivilTime& when, double azu, double tolerance,
-                         bool vertical, unsigned recursionLevel)
+                         bool vertical, unsigned recursionLevel,
+                         const F2Grid *grid)
       const
    {
       DEBUGTRACE_FUNCTION();
@@ -991,11 +1337,11 @@ namespace gnsstk
          DEBUGTRACE("i=" << i << "  x=" << x);
          if (vertical)
          {
-            y = getVED(x, rxgeo, svgeo, modipSta, ccirData, when, azu);
+            y = getVED(x, rxgeo, svgeo, modipSta, ccirData, when, azu, grid);
          }
          else
          {
-            y = getSED(x, rxgeo, svgeo, modip, ccirData, when, azu);
+            y = getSED(x, rxgeo, svgeo, modip, ccirData, when, azu, grid);
          }
          DEBUGTRACE("GKI ED = " << scientific << y);
             // Accumulate on to the k15 total
@@ -1028,11 +1374,13 @@ namespace gnsstk
             // equal halves and recurse.
          rv = integrateGaussKronrod(heightPt1, heightPt1 + h2, rxgeo, svgeo,
                                     modip, modipSta, ccirData, when, azu,
-                                    tolerance, vertical, recursionLevel+1);
+                                    tolerance, vertical, recursionLevel+1,
+                                    grid);
          DEBUGTRACE("pResult(4) = " << scientific << rv);
          rv += integrateGaussKronrod(heightPt1 + h2, heightPt2, rxgeo, svgeo,
                                      modip, modipSta, ccirData, when, azu,
-                                     tolerance, vertical, recursionLevel+1);
+                                     tolerance, vertical, recursionLevel+1,
+                                     grid);
          DEBUGTRACE("pResult(5) = " << scientific << rv);
       }
       return rv;
@@ -39,6 +39,7 @@
 #ifndef GNSSTK_NEQUICKIONODATA_HPP
 #define GNSSTK_NEQUICKIONODATA_HPP
 
+#include <memory>
 #include "IonoNavData.hpp"
 #include "CivilTime.hpp"
 #include "CCIR.hpp"
@@ -103,7 +104,9 @@ namespace gnsstk
           * @param[in] rxgeo The receiver's geodetic position.
           * @param[in] svgeo The observed satellite's geodetic position.
           * @param[in] band The carrier band of the signal being corrected.
-          * @return The ionospheric delay, in meters, on band. */
+          * @return The ionospheric delay, in meters, on band.
+          * @throw InvalidParameter if useF2Grid is set and
+          *   f2GridStep is not valid. */
       double getIonoCorr(const CommonTime& when,
                          const Position& rxgeo,
                          const Position& svgeo,
@@ -114,11 +117,35 @@ namespace gnsstk
           * @param[in] when The time when the RF signal was received.
           * @param[in] rxgeo The position of the GNSS receiver's antenna.
           * @param[in] svgeo The position of the transmitting satellite.
-          * @return The total electron content in TEC units. */
+          * @return The total electron content in TEC units.
+          * @throw InvalidParameter if useF2Grid is set and
+          *   f2GridStep is not valid. */
       double getTEC(const CommonTime& when,
                     const Position& rxgeo,
                     const Position& svgeo) const;
 
+         /** Get the total electron content for a batch of rays at
+          * the same time.  The CCIR Fourier expansions for the time
+          * are computed once at both solar activity levels, and each
+          * ray derives its own from them for its receiver's
+          * effective ionization level, so receivers at different
+          * modified dip latitudes do not cause the CCIR grids to be
+          * re-interpolated.  The MODIP and CCIR tables are shared by
+          * all rays.  The results match getTEC() for each ray to
+          * within rounding.
+          * @param[in] when The time when the RF signals were received.
+          * @param[in] rxgeo The positions of the GNSS receivers'
+          *   antennas, either one for all rays or one per ray.
+          * @param[in] svgeo The positions of the transmitting satellites.
+          * @return The total electron content in TEC units for each
+          *   element of svgeo.
+          * @throw InvalidParameter if the size of rxgeo is neither 1
+          *   nor the size of svgeo, or if useF2Grid is set and
+          *   f2GridStep is not valid. */
+      std::vector<double> getTEC(const CommonTime& when,
+                                 const std::vector<Position>& rxgeo,
+                                 const std::vector<Position>& svgeo) const;
+
          /** a<sub>i</sub> terms of NeQuick model in solar flux units,
           * solar flux units/degree, solar flux
           * units/degree<sup>2</sup>.  Refer to Galileo-OS-SIS-ICD. */
@@ -131,6 +158,22 @@ namespace gnsstk
          // needs to be defined once.
       bool idf[5]; ///< Ionospheric disturbance flag for regions 1-5 (0-4).
 
+         /** If true, getTEC() obtains foF2 and M(3000)F2 at each
+          * integration point by bilinear interpolation in grids that
+          * are computed once per month and UT hour (see F2Grid),
+          * instead of evaluating MODIP and the CCIR Legendre
+          * expansions at every point.  Defaults to false, which
+          * gives the exact model of \cite galileo:iono.  The grids
+          * are kept in this object between calls, and are never
+          * changed once built, so getTEC() may be called from
+          * several threads at once. */
+      bool useF2Grid;
+         /** Grid spacing in degrees of latitude and longitude used
+          * when useF2Grid is true.  Must be positive and divide 90
+          * evenly, otherwise getTEC() throws InvalidParameter.
+          * Defaults to 1.0. */
+      double f2GridStep;
+
          /** Similar to standard exp() function, but with the exponent
           * clipped to +/- 80, per F2.1.2.3 \cite galileo:iono
           * @param[in] x The exponent to raise e to.
@@ -150,6 +193,23 @@ namespace gnsstk
           * @return The effective ionization level Az in solar flux units. */
       double getEffIonoLevel(double modip_u) const;
 
+      class F2Grid;
+
+         /** Integrate the total electron content for one ray using
+          * the given, possibly shared, MODIP and CCIR objects.
+          * @param[in] when The time when the RF signal was received.
+          * @param[in] rxgeo The position of the GNSS receiver's antenna.
+          * @param[in] svgeo The position of the transmitting satellite.
+          * @param[in] modip A pre-constructed MODIP object to use.
+          * @param[in] ccirData A pre-constructed CCIR object to use.
+          * @param[in] useBasis If true, ccirData.fourierBasis() has
+          *   been called for when, and the Fourier coefficients for
+          *   this ray are derived from it.
+          * @return The total electron content in TEC units. */
+      double integrateTEC(const CivilTime& when, const Position& rxgeo,
+                          const Position& svgeo, const MODIP& modip,
+                          CCIR& ccirData, bool useBasis) const;
+
          /// Aggregate the model parameters as defined in section 2.5.5
       class ModelParameters
       {
@@ -163,9 +223,19 @@ namespace gnsstk
              *   ionospheric model data.
              * @param[in] when The time of the observation being
              *   modeled (month and hour of day are used).
+             * @param[in] grid If not null, foF2 and M(3000)F2 are
+             *   looked up in this grid, already updated for when,
+             *   and modip_u and ccirData are not used for them.
              * @post fAzr, ffoE, fNmE, ffoF1, fNmF1, fNmF2 are set. */
          ModelParameters(double modip_u, const Position& pos, double az,
-                         CCIR& ccirData, const CivilTime& when);
+                         CCIR& ccirData, const CivilTime& when,
+                         const F2Grid *grid = nullptr);
+
+            /** Compute the effective sun spot number (eq.19).
+             * @param[in] az The effective ionization level in solar
+             *   flux units.
+             * @return The effective sun spot number Azr. */
+         static double effSunSpots(double az);
 
             /** Compute the sine and cosine of the solar
              * declination. (sec 2.5.4.6)
@@ -287,6 +357,99 @@ namespace gnsstk
          friend class ::NeQuickIonoNavData_T;
       };
 
+         /** Grids of foF2 and M(3000)F2 over geodetic latitude and
+          * longitude.  For each month, and each of the low and high
+          * solar activity conditions, the CCIR Legendre expansions
+          * are evaluated once per node for each term of the daily
+          * Fourier series (13 for foF2, 9 for M(3000)F2).  These
+          * month grids depend on nothing else, so they are shared by
+          * all F2Grid objects using the same month and spacing.  For
+          * a given UT hour they are then summed into a grid holding,
+          * for each node, foF2 and M(3000)F2 at low and high solar
+          * activity in 32 contiguous bytes, from which lookup()
+          * interpolates bilinearly.  Both quantities are linear in
+          * the effective sun spot number, so that grid serves every
+          * receiver.  MODIP needs no grid of its own, as it only
+          * enters the integration through these two quantities and
+          * is folded into them.
+          *
+          * The values at the nodes are exact, and the interpolation
+          * error scales with the square of the spacing.  Against
+          * the exact model, the largest slant TEC differences on the
+          * \cite galileo:iono validation rays are about 5% for a
+          * 2.5 degree spacing, 0.6% for 1 degree (the default) and
+          * 0.15% for 0.5 degree.  A month grid takes 44 doubles per
+          * node, about 23 MB at 1 degree. */
+      class F2Grid
+      {
+      public:
+            /// Create an empty grid.
+         F2Grid();
+
+            /** Make the grid ready for the month and UT hour of
+             * when, building the month grids if necessary.
+             * @param[in] when The time of the observations.
+             * @param[in] step Grid spacing in degrees, which must
+             *   evenly divide 90.
+             * @param[in] ccirData The CCIR object to get the
+             *   coefficients from.
+             * @param[in] modip The MODIP object to use.
+             * @throw InvalidParameter if step is not positive or
+             *   does not evenly divide 90. */
+         void update(const CivilTime& when, double step, CCIR& ccirData,
+                     const MODIP& modip);
+
+            /** Check whether the grid is ready for the month and UT
+             * hour of when at the given spacing.
+             * @param[in] when The time of the observations.
+             * @param[in] step Grid spacing in degrees.
+             * @return true if update() would not change the grid. */
+         bool isCurrent(const CivilTime& when, double step) const;
+
+            /** Get foF2 and M(3000)F2 by bilinear interpolation.
+             * @param[in] lat Geodetic latitude in degrees.
+             * @param[in] lon Longitude in degrees, any range.
+             * @param[in] effSunSpots Effective sun spot number, aka Azr.
+             * @param[out] foF2 F2 layer critical frequency in MHz.
+             * @param[out] m3000F2 F2 layer transmission factor. */
+         void lookup(double lat, double lon, double effSunSpots,
+                     double& foF2, double& m3000F2) const;
+
+            /** Compute the Legendre terms (eq.61, eq.67, eq.69,
+             * eq.75) by which the CF2 and Cm3 Fourier coefficients
+             * are multiplied to get foF2 and M(3000)F2.
+             * @param[in] modip_u Modified dip latitude in degrees.
+             * @param[in] pos The geodetic position of the observer.
+             * @param[out] bF2 The terms for each CF2 coefficient.
+             * @param[out] bM3 The terms for each Cm3 coefficient. */
+         static void legendreTerms(double modip_u, const Position& pos,
+                                   double bF2[CCIR::F2MaxDegree],
+                                   double bM3[CCIR::FM3MaxDegree]);
+
+      private:
+            /// Get when in UTC.
+         static CivilTime toUTC(const CivilTime& when);
+
+            /// Per-node Fourier terms for one month, see class doc.
+         typedef std::vector<double> MonthGrid;
+
+            /** Get the month grid for a month and spacing, building
+             * it if no F2Grid is using it yet. */
+         static std::shared_ptr<const MonthGrid>
+         getMonthGrid(unsigned month, double step, unsigned nLat,
+                      unsigned nLon, CCIR& ccirData, const MODIP& modip);
+
+         std::shared_ptr<const MonthGrid> monthGrid; ///< Current month grid.
+         unsigned month;   ///< Month of the grids, 0 if none.
+         double hour;      ///< UT hour of the grids.
+         double step;      ///< Grid spacing in degrees.
+         unsigned nLat;    ///< Number of latitude nodes, -90 to 90.
+         unsigned nLon;    ///< Number of longitude nodes, -180 to 180.
+            /** foF2 low, foF2 high, M(3000)F2 low, M(3000)F2 high
+             * for each node, longitude varying fastest. */
+         std::vector<double> nodes;
+      };
+
          /// Class to contain data used when integrating TEC.
       class IntegrationParameters
       {
@@ -328,11 +491,13 @@ namespace gnsstk
           * @param[in] when The time when the RF signal was received.
           * @param[in] azu Effective ionization level, in solar flux
           *   units, at the modified dip latitude of the receiver.
+          * @param[in] grid If not null, the grid to get foF2 and
+          *   M(3000)F2 from.
           * @return The electron density in TECU.
           */
       double getSED(double dist, const Position& rxgeo, const Position& svgeo,
                     const MODIP& modip, CCIR& ccirData, const CivilTime& when,
-                    double azu)
+                    double azu, const F2Grid *grid = nullptr)
          const;
 
          /** Get the electron density at a distance along a path where
@@ -346,11 +511,13 @@ namespace gnsstk
           * @param[in] when The time when the RF signal was received.
           * @param[in] azu Effective ionization level, in solar flux
           *   units, at the modified dip latitude of the receiver.
+          * @param[in] grid If not null, the grid to get foF2 and
+          *   M(3000)F2 from.
           * @return The electron density in TECU.
           */
       double getVED(double dist, const Position& rxgeo, const Position& svgeo,
                     double modip_u, CCIR& ccirData, const CivilTime& when,
-                    double azu)
+                    double azu, const F2Grid *grid = nullptr)
          const;
 
          /** Perform Gauss-Kronrod integration of the TEC along the
@@ -375,6 +542,8 @@ namespace gnsstk
           * @param[in] recursionLevel integrateGaussKronrod will
           *   recurse if the results are not within tolerance, up to
           *   RecursionMax (defined in cpp file) times.
+          * @param[in] grid If not null, the grid to get foF2 and
+          *   M(3000)F2 from.
           * @return The integrated TEC. */
       double integrateGaussKronrod(double heightPt1, double heightPt2,
                                    const Position& rxgeo, const Position& svgeo,
@@ -382,7 +551,8 @@ namespace gnsstk
                                    CCIR& ccirData,
                                    const CivilTime& when, double azu,
                                    double tolerance, bool vertical,
-                                   unsigned recursionLevel = 0)
+                                   unsigned recursionLevel = 0,
+                                   const F2Grid *grid = nullptr)
          const;
 
          /** Galileo ellipsoid model for ionospheric modeling.  This
@@ -394,6 +564,25 @@ namespace gnsstk
       GalileoIonoEllipsoid elModel;
 
    private:
+         /** Get the grid for the month and UT hour of when at
+          * f2GridStep, building it if the last one used is for
+          * another time.
+          * @param[in] when The time of the observations.
+          * @param[in] ccirData The CCIR object to get the
+          *   coefficients from.
+          * @param[in] modip The MODIP object to use.
+          * @return The grid, which is not changed by later calls.
+          * @throw InvalidParameter if f2GridStep is not valid. */
+      std::shared_ptr<const F2Grid> getF2Grid(const CivilTime& when,
+                                              CCIR& ccirData,
+                                              const MODIP& modip) const;
+
+         /** Last grid used when useF2Grid is true, kept between
+          * calls.  Only accessed with std::atomic_load and
+          * std::atomic_store, and a grid is never modified once
+          * stored here, so threads may share it. */
+      mutable std::shared_ptr<const F2Grid> f2Grid;
+
          /// Number of degrees longitude per hour.
       static constexpr double DEGREE_PER_HOUR = 15.0;
 
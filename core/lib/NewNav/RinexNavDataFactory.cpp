@@ -36,6 +36,8 @@
 //                            release, distribution is unlimited.
 //
 //==============================================================================
+#include <functional>
+#include <sstream>
 #include "RinexNavDataFactory.hpp"
 #include "Rinex3NavStream.hpp"
 #include "Rinex3NavHeader.hpp"
@@ -62,15 +64,21 @@
 #include "RinexTimeOffset.hpp"
 #include "TimeString.hpp"
 #include "NavDataFactoryStoreCallback.hpp"
+#include "parallel_for.hpp"
 
 using namespace std;
 
 static const std::string dts("%Y/%03j/%02H:%02M:%02S %P");
 
+   /** Smallest amount of a file to give each thread; files smaller
+    * than two of these are read on one thread. */
+static const std::streamoff minChunkSize = 128 * 1024;
+
 namespace gnsstk
 {
    RinexNavDataFactory ::
    RinexNavDataFactory()
+         : numReadThreads(0)
    {
       supportedSignals.insert(NavSignalID(SatelliteSystem::GPS,
                                           CarrierBand::L1,
@@ -116,13 +124,35 @@ namespace gnsstk
    process(const std::string& filename,
            NavDataFactoryCallback& cb)
    {
+         /// The records of one piece of the file, read on one thread.
+      struct Chunk
+      {
+         Chunk()
+               : begin(0), end(-1),
+                 firstTime(CommonTime::BEGINNING_OF_TIME), ok(true)
+         {}
+         std::streamoff begin;   ///< offset of the first record
+         std::streamoff end;     ///< offset to stop at, -1 for EOF
+         NavDataPtrList navOut;  ///< converted data, in file order
+         CommonTime firstTime;   ///< time of the first record
+         bool ok;                ///< false if reading stopped early
+         std::string error;      ///< description of an exception
+      };
+
+         /// Give the data read by readRecords() to a function.
+      class FnCallback : public NavDataFactoryCallback
+      {
+      public:
+         FnCallback(const std::function<bool(const NavDataPtr&)>& f)
+               : fn(f)
+         {}
+         bool process(const NavDataPtr& navOut) override
+         { return fn(navOut); }
+         std::function<bool(const NavDataPtr&)> fn;
+      };
       bool rv = true;
-      bool processEph = (procNavTypes.count(NavMessageType::Ephemeris) > 0);
-      bool processHea = (procNavTypes.count(NavMessageType::Health) > 0);
       bool processTim = (procNavTypes.count(NavMessageType::TimeOffset) > 0);
       bool processIono = (procNavTypes.count(NavMessageType::Iono) > 0);
-      bool processISC = (procNavTypes.count(NavMessageType::ISC) > 0);
-      bool ionoProcessed = false;
          // check the validity
       bool check = false;
       bool expect = false;
@@ -145,7 +175,6 @@ namespace gnsstk
       {
          Rinex3NavStream is(filename.c_str(), ios::in);
          Rinex3NavHeader head;
-         Rinex3NavData data;
          if (!is)
             return false;
          is >> head;
@@ -177,114 +206,125 @@ namespace gnsstk
          }
          if (!is)
             return false;
-         while (is)
+
+            // We have to delay processing of iono data until we get
+            // a data record with a timestamp so we can have some sort
+            // of reasonable time stamp on the iono data.
+         bool ionoDone = !processIono;
+         auto passIono = [&](const CommonTime& when)
          {
-            is >> data;
-            if (processIono && !ionoProcessed)
+            if (ionoDone)
+               return true;
+            ionoDone = true;
+            NavDataPtrList ionoList;
+               // iono correction information only exists in RINEX headers.
+               /// @todo what about embedded RINEX headers?
+            if (!convertToIono(when, head, ionoList))
             {
-                  // We have to delay processing of iono data until we
-                  // get a data record with a timestamp so we can have
-                  // some sort of reasonable time stamp on the iono
-                  // data.
-               ionoProcessed = true;
-               NavDataPtrList ionoList;
-                  // iono correction information only exists in RINEX headers.
-                  /// @todo what about embedded RINEX headers?
-               if (!convertToIono(data.time, head, ionoList))
-               {
-                  return false;
-               }
-               for (auto& i : ionoList)
+               return false;
+            }
+            for (auto& i : ionoList)
+            {
+               if (check)
                {
-                  if (check)
-                  {
-                     if (i->validate() == expect)
-                     {
-                        if (!cb.process(i))
-                           return false;
-                     }
-                  }
-                  else
+                  if (i->validate() == expect)
                   {
                      if (!cb.process(i))
                         return false;
                   }
                }
-            }
-            if (!is)
-            {
-               if (is.eof())
-                  break;
                else
-                  return false; // some other error
-            }
-            NavDataPtr eph, isc;
-            NavDataPtrList health;
-            if (processEph)
-            {
-               if (!convertToOrbit(data, eph))
-                  return false;
-            }
-            if (processHea)
-            {
-               if (!convertToHealth(data, health))
-                  return false;
-            }
-            if (processISC)
-            {
-               if (!convertToISC(data, isc))
-                  return false;
-            }
-            if (check)
-            {
-               if (processEph)
                {
-                  if (eph->validate() == expect)
-                  {
-                     if (!cb.process(eph))
-                        return false;
-                  }
+                  if (!cb.process(i))
+                     return false;
                }
-               if (processHea)
-               {
-                  for (const auto& hp : health)
-                  {
-                     if (hp->validate() == expect)
+            }
+            return true;
+         };
+
+            // Large files are split at record boundaries into
+            // several chunks per thread, each read by its own stream.
+         std::streamoff dataStart = is.tellg();
+         is.seekg(0, ios::end);
+         std::streamoff fileEnd = is.tellg();
+         unsigned nthreads = numThreads(numReadThreads,
+                                        (fileEnd - dataStart) / minChunkSize);
+         is.clear();
+         is.seekg(dataStart);
+         if (nthreads == 1)
+         {
+               // Pass the data on as each record is read, so that a
+               // callback returning false stops the reading.
+            CommonTime firstTime(CommonTime::BEGINNING_OF_TIME);
+            FnCallback pass([&](const NavDataPtr& navOut)
+                            {
+                               return (passIono(firstTime) &&
+                                       cb.process(navOut));
+                            });
+            return (readRecords(is, -1, pass, firstTime) &&
+                    passIono(firstTime));
+         }
+
+         std::vector<Chunk> chunks(nthreads * 4);
+         chunks[0].begin = dataStart;
+         for (size_t i = 1; i < chunks.size(); i++)
+         {
+            chunks[i].begin = std::max(
+               chunks[i-1].begin,
+               is.findRecord(dataStart +
+                             (fileEnd - dataStart) * i / chunks.size()));
+            chunks[i-1].end = chunks[i].begin;
+         }
+         parallelFor(chunks.size(), nthreads,
+                     [&](size_t i)
                      {
-                        if (!cb.process(hp))
-                           return false;
-                     }
-                  }
-               }
-               if (processISC && (isc != nullptr))
-               {
-                  if (isc->validate() == expect)
-                  {
-                     if (!cb.process(isc))
-                        return false;
-                  }
-               }
+                        Chunk& chunk(chunks[i]);
+                        if (chunk.begin == chunk.end)
+                           return;
+                        FnCallback collect([&chunk](const NavDataPtr& navOut)
+                                           {
+                                              chunk.navOut.push_back(navOut);
+                                              return true;
+                                           });
+                        try
+                        {
+                           Rinex3NavStream strm(filename.c_str(), ios::in);
+                           strm.header = is.header;
+                           strm.headerRead = true;
+                           strm.seekg(chunk.begin);
+                           chunk.ok = strm && readRecords(strm, chunk.end,
+                                                          collect,
+                                                          chunk.firstTime);
+                        }
+                        catch (gnsstk::Exception& exc)
+                        {
+                           ostringstream oss;
+                           oss << exc;
+                           chunk.error = oss.str();
+                           chunk.ok = false;
+                        }
+                        catch (std::exception& exc)
+                        {
+                           chunk.error = exc.what();
+                           chunk.ok = false;
+                        }
+                     });
+
+         if (!passIono(chunks[0].firstTime))
+            return false;
+            // Pass on the data in file order, up to the first error.
+         for (const auto& chunk : chunks)
+         {
+            for (const auto& i : chunk.navOut)
+            {
+               if (!cb.process(i))
+                  return false;
             }
-            else
+            if (!chunk.ok)
             {
-               if (processEph)
-               {
-                  if (!cb.process(eph))
-                     return false;
-               }
-               if (processHea)
-               {
-                  for (const auto& hp : health)
-                  {
-                     if (!cb.process(hp))
-                        return false;
-                  }
-               }
-               if (processISC && (isc != nullptr))
-               {
-                  if (!cb.process(isc))
-                     return false;
-               }
+               if (!chunk.error.empty())
+                  cerr << chunk.error << endl;
+               return false;
             }
          }
       }
@@ -307,6 +347,88 @@ namespace gnsstk
    }
 
 
+   bool RinexNavDataFactory ::
+   readRecords(Rinex3NavStream& strm, std::streamoff end,
+               NavDataFactoryCallback& cb, CommonTime& firstTime) const
+   {
+      bool processEph = (procNavTypes.count(NavMessageType::Ephemeris) > 0);
+      bool processHea = (procNavTypes.count(NavMessageType::Health) > 0);
+      bool processISC = (procNavTypes.count(NavMessageType::ISC) > 0);
+      bool check = (navValidity == NavValidityType::ValidOnly) ||
+         (navValidity == NavValidityType::InvalidOnly);
+      bool expect = (navValidity == NavValidityType::ValidOnly);
+      bool first = true;
+      Rinex3NavData data;
+      string line;
+      while (true)
+      {
+            // Skip blank lines, which the reader ignores, so the
+            // position checked is that of the next record.
+         int c;
+         while (((c = strm.peek()) == '\n') || (c == '\r'))
+         {
+            getline(strm, line);
+            strm.lineNumber++;
+         }
+         if ((c == EOF) || ((end >= 0) && (strm.tellg() >= end)))
+            break;
+         strm >> data;
+         if (!strm)
+         {
+            if (strm.eof())
+               break;
+            else
+               return false; // some other error
+         }
+         if (first)
+         {
+            firstTime = data.time;
+            first = false;
+         }
+         NavDataPtr eph, isc;
+         NavDataPtrList health;
+         if (processEph)
+         {
+            if (!convertToOrbit(data, eph))
+               return false;
+         }
+         if (processHea)
+         {
+            if (!convertToHealth(data, health))
+               return false;
+         }
+         if (processISC)
+         {
+            if (!convertToISC(data, isc))
+               return false;
+         }
+         if (processEph && (!check || (eph->validate() == expect)))
+         {
+            if (!cb.process(eph))
+               return false;
+         }
+         if (processHea)
+         {
+            for (const auto& hp : health)
+            {
+               if ((!check || (hp->validate() == expect)) &&
+                   !cb.process(hp))
+               {
+                  return false;
+               }
+            }
+         }
+         if (processISC && (isc != nullptr) &&
+             (!check || (isc->validate() == expect)))
+         {
+            if (!cb.process(isc))
+               return false;
+         }
+      }
+      return true;
+   }
+
+
    std::string RinexNavDataFactory ::
    getFactoryFormats() const
    {
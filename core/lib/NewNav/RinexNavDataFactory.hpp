@@ -41,6 +41,7 @@
 
 #include "NavDataFactoryWithStoreFile.hpp"
 #include "Rinex3NavData.hpp"
+#include "Rinex3NavStream.hpp"
 #include "GPSLNavEph.hpp"
 
 namespace gnsstk
@@ -53,6 +54,11 @@ namespace gnsstk
        *   RINEX NAV does not support the identification of the codes
        *   contained in the files.  As such, this factory only
        *   "produces" L1 C/A tagged data for LNav.
+       *
+       * Large files are split at record boundaries into pieces that
+       * are read and converted on separate threads (see
+       * setNumThreads()).  The data are still passed on in file
+       * order, so the results don't depend on the number of threads.
        */
    class RinexNavDataFactory : public NavDataFactoryWithStoreFile
    {
@@ -84,6 +90,18 @@ namespace gnsstk
          /// Return a comma-separated list of formats supported by this factory.
       std::string getFactoryFormats() const override;
 
+         /** Set the number of threads used to read a file.  Files
+          * too small to be worth splitting are always read on one
+          * thread.
+          * @param[in] n The number of threads, 0 for one per hardware
+          *   thread (the default). */
+      void setNumThreads(unsigned n)
+      { numReadThreads = n; }
+
+         /// Get the number of threads used to read a file.
+      unsigned getNumThreads() const
+      { return numReadThreads; }
+
          /** Convert RINEX nav data to a system/code-appropriate
           * OrbitData object.
           * @param[in] navIn The RINEX nav message data to convert.
@@ -216,6 +234,29 @@ namespace gnsstk
           * @param[in] sisa The signal in space accuracy index.
           * @return The signal accuracy in meters. */
       static double encodeSISA(uint8_t sisa);
+
+   private:
+         /** Read records from a stream and convert them to the
+          * objects process() passes to its callback, in order.
+          * @param[in,out] strm The stream to read, positioned at the
+          *   start of a record, with its header already read.
+          * @param[in] end Stop at the first record that starts at or
+          *   after this byte offset, or -1 to read to the end of
+          *   the file.
+          * @param[in] cb Given the converted data of each record as
+          *   it is read.
+          * @param[out] firstTime Set to the time of the first record
+          *   read, before any of its data are given to cb.
+          * @return false if a record couldn't be read or converted,
+          *   or cb returned false.
+          * @throw Exception if a record is badly formatted.
+          */
+      bool readRecords(Rinex3NavStream& strm, std::streamoff end,
+                       NavDataFactoryCallback& cb,
+                       CommonTime& firstTime) const;
+
+         /// Number of threads to read files with, 0 for all.
+      unsigned numReadThreads;
    };
 
       //@}
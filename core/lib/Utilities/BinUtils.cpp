@@ -74,5 +74,96 @@ namespace gnsstk
 
       // GLONASS L3: 24 23 18 17 14 11 10 7 6 5 4 3 1 +1
       // 1100 0011 0010 0110 0111 1101: c3267d
+
+
+      CRCTable :: CRCTable(const CRCParam& p)
+            : params(p),
+              crcmask(((((uint32_t)1 << (p.order - 1)) - 1) << 1) | 1)
+      {
+         if (params.order < 8)
+         {
+            return;
+         }
+         uint32_t crchighbit = (uint32_t)1 << (params.order - 1);
+         for (uint32_t i = 0; i < 256; i++)
+         {
+            uint32_t crc = params.refin ? reflect(i, 8) : i;
+            crc <<= params.order - 8;
+            for (int j = 0; j < 8; j++)
+            {
+               uint32_t bit = crc & crchighbit;
+               crc <<= 1;
+               if (bit)
+               {
+                  crc ^= params.polynom;
+               }
+            }
+            if (params.refin)
+            {
+               crc = reflect(crc, params.order);
+            }
+            table[i] = crc & crcmask;
+         }
+      }
+
+
+      uint32_t CRCTable :: compute(const unsigned char *data,
+                                   unsigned long len,
+                                   uint32_t initial) const
+      {
+         if (params.order < 8)
+         {
+            CRCParam p(params);
+            p.initial = initial;
+            return computeCRC(data, len, p);
+         }
+
+            // The table works on the "direct" form of the initial value,
+            // so convert a non-direct one first.
+         uint32_t crc = initial;
+         if (!params.direct)
+         {
+            uint32_t crchighbit = (uint32_t)1 << (params.order - 1);
+            for (int i = 0; i < params.order; i++)
+            {
+               uint32_t bit = crc & crchighbit;
+               crc <<= 1;
+               if (bit)
+               {
+                  crc ^= params.polynom;
+               }
+            }
+            crc &= crcmask;
+         }
+
+         if (params.refin)
+         {
+            crc = reflect(crc, params.order);
+            for (unsigned long i = 0; i < len; i++)
+            {
+               crc = (crc >> 8) ^ table[(crc ^ data[i]) & 0xff];
+            }
+         }
+         else
+         {
+            int shift = params.order - 8;
+            for (unsigned long i = 0; i < len; i++)
+            {
+               crc = (crc << 8) ^ table[((crc >> shift) ^ data[i]) & 0xff];
+            }
+         }
+
+         if (params.refout != params.refin)
+         {
+            crc = reflect(crc, params.order);
+         }
+         crc ^= params.final;
+         crc &= crcmask;
+         return crc;
+      }
+
+
+      const CRCTable CRC16Table(CRC16);
+      const CRCTable CRC32Table(CRC32);
    }
 }
@@ -325,6 +325,50 @@ namespace gnsstk
                                  unsigned long len,
                                  const CRCParam& params);
 
+         /**
+          * Table-driven CRC computation, giving the same results as
+          * computeCRC() eight times as fast or better.  The 256-entry
+          * table is built once per set of parameters, so keep a
+          * CRCTable around (e.g. CRC16Table, CRC32Table) rather than
+          * building one per message.  Orders below 8 fall back to
+          * computeCRC().
+          */
+      class CRCTable
+      {
+      public:
+            /// Build the table for the CRC described by params.
+         explicit CRCTable(const CRCParam& params);
+
+            /** Compute the CRC of len bytes at data.
+             * @param[in] data data to process CRC on.
+             * @param[in] len length of data to process (in bytes).
+             * @return the CRC value, as computeCRC(data, len, params). */
+         uint32_t compute(const unsigned char *data, unsigned long len) const
+         { return compute(data, len, params.initial); }
+
+            /** Compute the CRC of len bytes at data using a different
+             * initial value, e.g. the CRC of preceding data.
+             * @return the CRC value, as computeCRC(data, len, p) where
+             *   p is params with initial replaced. */
+         uint32_t compute(const unsigned char *data,
+                          unsigned long len,
+                          uint32_t initial) const;
+
+            /// The CRC parameters the table was built for.
+         const CRCParam& getParams() const
+         { return params; }
+
+      private:
+         CRCParam params;
+         uint32_t crcmask;   ///< mask of the order low bits
+         uint32_t table[256];
+      };
+
+         /// Table for CRC-16
+      GNSSTK_EXPORT extern const CRCTable CRC16Table;
+         /// Table for CRC-32
+      GNSSTK_EXPORT extern const CRCTable CRC32Table;
+
          /**
           * Calculate an Exclusive-OR Checksum on the string \a str.
           * @param[in] str The encoded data for which the checksum is
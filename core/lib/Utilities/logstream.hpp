@@ -47,6 +47,7 @@
 #include <sstream>
 #include <string>
 #include <iostream>
+#include <mutex>
 #include "gnsstk_export.h"
 
 namespace gnsstk
@@ -281,8 +282,11 @@ public:
    /// @endcode
    static std::ostream*& Stream();
 
-   /// used internally
+   /// used internally; messages from different threads are not interleaved
    static void Output(const std::string& msg);
+
+   /// used internally, to serialize Output()
+   static std::mutex& Mutex();
 };
 
 inline std::ostream*& ConfigureLOGstream::Stream()
@@ -291,8 +295,15 @@ inline std::ostream*& ConfigureLOGstream::Stream()
    return pStream;
 }
 
+inline std::mutex& ConfigureLOGstream::Mutex()
+{
+   static std::mutex mtx;
+   return mtx;
+}
+
 inline void ConfigureLOGstream::Output(const std::string& msg)
 {
+   std::lock_guard<std::mutex> lock(Mutex());
    std::ostream *pStream = Stream();
    if(!pStream) return;
    *pStream << msg << std::flush;
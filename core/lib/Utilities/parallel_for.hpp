@@ -0,0 +1,140 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file parallel_for.hpp
+ * Run independent pieces of work on a set of threads.
+ */
+
+#ifndef GNSSTK_PARALLEL_FOR_HPP
+#define GNSSTK_PARALLEL_FOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace gnsstk
+{
+      /** @addtogroup datastructsgroup */
+      //@{
+
+      /** Number of threads to use for n pieces of work when the caller
+       * asks for nthreads; 0 means one per hardware thread.
+       * @param[in] nthreads number of threads requested, 0 for all.
+       * @param[in] n number of pieces of work.
+       * @return a number of threads between 1 and n (1 if n is 0). */
+   inline unsigned numThreads(unsigned nthreads, std::size_t n)
+   {
+      if (nthreads == 0)
+      {
+         nthreads = std::thread::hardware_concurrency();
+         if (nthreads == 0)
+            nthreads = 1;
+      }
+      if (n < nthreads)
+         nthreads = (n == 0 ? 1 : static_cast<unsigned>(n));
+      return nthreads;
+   }
+
+      /** Call func(i) for i = 0, ..., n-1, using up to nthreads
+       * threads. Indices are handed out one at a time, so the calls
+       * may take very different times. With one thread func is called
+       * in order on the calling thread.
+       * If a call throws, no further indices are started, and the
+       * first exception is rethrown on the calling thread after all
+       * threads have finished.
+       * @param[in] n number of calls to make.
+       * @param[in] nthreads number of threads, 0 for one per hardware
+       *   thread.
+       * @param[in] func callable taking a std::size_t index. Calls with
+       *   different indices must be independent. */
+   template <class Func>
+   void parallelFor(std::size_t n, unsigned nthreads, Func func)
+   {
+      nthreads = numThreads(nthreads, n);
+      if (nthreads == 1)
+      {
+         for (std::size_t i = 0; i < n; i++)
+            func(i);
+         return;
+      }
+
+      std::atomic<std::size_t> next(0);
+      std::atomic<bool> failed(false);
+      std::exception_ptr error;
+      auto work = [&]() {
+         std::size_t i;
+         while (!failed && (i = next++) < n)
+         {
+            try
+            {
+               func(i);
+            }
+            catch (...)
+            {
+               if (!failed.exchange(true))
+                  error = std::current_exception();
+            }
+         }
+      };
+
+      std::vector<std::thread> threads;
+      try
+      {
+         for (unsigned t = 1; t < nthreads; t++)
+            threads.push_back(std::thread(work));
+      }
+      catch (std::system_error&)
+      {
+            // carry on with the threads already started
+      }
+      work();
+      for (std::size_t t = 0; t < threads.size(); t++)
+         threads[t].join();
+      if (error)
+         std::rethrow_exception(error);
+   }
+
+      //@}
+
+}  // namespace gnsstk
+
+#endif  // GNSSTK_PARALLEL_FOR_HPP
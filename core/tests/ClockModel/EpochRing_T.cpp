@@ -0,0 +1,115 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "ObsEpochMap.hpp"
+#include "ORDEpoch.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+
+class EpochRing_T
+{
+public:
+   unsigned ringTest()
+   {
+      TUDEF("EpochRing", "operator[]");
+      gnsstk::CommonTime t0(gnsstk::CommonTime::BEGINNING_OF_TIME);
+      t0.setTimeSystem(gnsstk::TimeSystem::GPS);
+      TUTHROW(gnsstk::ObsEpochRing(0));
+      gnsstk::ObsEpochRing ring(4);
+      TUASSERT(ring.empty());
+      TUASSERTE(size_t, 4, ring.capacity());
+
+      for (int i = 0; i < 10; i++)
+      {
+         gnsstk::ObsEpoch& oe(ring[t0 + 30.*i]);
+         TUASSERT(oe.empty());
+         oe.time = t0 + 30.*i;
+         oe.rxClock = double(i);
+         oe[gnsstk::SatID(i+1, gnsstk::SatelliteSystem::GPS)];
+      }
+      TUASSERTE(size_t, 4, ring.size());
+      TUASSERTE(gnsstk::CommonTime, t0 + 180., ring.timeAt(0));
+      TUASSERTE(gnsstk::CommonTime, t0 + 270., ring.timeAt(3));
+      TUASSERTFE(6.0, (double)ring.front().rxClock);
+      TUASSERTFE(9.0, (double)ring.back().rxClock);
+         // reused storage was reset
+      TUASSERTE(size_t, 1, ring.front().size());
+
+      TUASSERT(ring.find(t0 + 150.) == NULL);
+      TUASSERT(ring.find(t0 + 200.) == NULL);
+      TUASSERT(ring.find(t0 + 240.) != NULL);
+      TUASSERTFE(8.0, (double)ring.find(t0 + 240.)->rxClock);
+      TUASSERTE(size_t, 2, ring.lowerBound(t0 + 230.));
+
+         // an existing epoch is returned, an earlier new one is an error
+      TUASSERTFE(7.0, (double)ring[t0 + 210.].rxClock);
+      TUASSERTE(size_t, 4, ring.size());
+      TUTHROW(ring[t0 + 200.]);
+      TUTHROW(ring.at(4));
+
+      ring.eraseBefore(t0 + 240.);
+      TUASSERTE(size_t, 2, ring.size());
+      TUASSERTE(gnsstk::CommonTime, t0 + 240., ring.timeAt(0));
+      ring[t0 + 300.].rxClock = 10.0;
+      TUASSERTE(size_t, 3, ring.size());
+      TUASSERTFE(10.0, (double)ring.back().rxClock);
+
+      ring.clear();
+      TUASSERT(ring.empty());
+      TUASSERT(ring.find(t0 + 300.) == NULL);
+
+      gnsstk::ORDEpochRing ords(2);
+      ords[t0].time = t0;
+      TUASSERTE(size_t, 1, ords.size());
+      TURETURN();
+   }
+};
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   EpochRing_T testClass;
+
+   errorTotal += testClass.ringTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
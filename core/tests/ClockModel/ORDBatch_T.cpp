@@ -0,0 +1,261 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "ORDBatch.hpp"
+#include "ObsRngDev.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+
+#include "CivilTime.hpp"
+#include "GPSLNavEph.hpp"
+#include "GPSWeekSecond.hpp"
+#include "NavDataFactoryWithStore.hpp"
+#include "SimpleTropModel.hpp"
+#include "WGS84Ellipsoid.hpp"
+
+//=============================================================================
+// ORDBatch must give the same ORDs as an ObsRngDev for each satellite,
+// constructed with the same arguments. The ephemerides are made up, and
+// held in memory, so that no data files are needed.
+//=============================================================================
+
+class TestFactory : public gnsstk::NavDataFactoryWithStore
+{
+public:
+   TestFactory()
+   {
+      supportedSignals.insert(gnsstk::NavSignalID(gnsstk::SatelliteSystem::GPS,
+                                                 gnsstk::CarrierBand::L1,
+                                                 gnsstk::TrackingCode::CA,
+                                                 gnsstk::NavType::GPSLNAV));
+   }
+   bool addDataSource(const std::string& source) override
+   { return false; }
+   std::string getFactoryFormats() const override
+   { return "Test"; }
+};
+
+
+class ORDBatch_T
+{
+public:
+   ORDBatch_T()
+   {
+      rxpos.setGeodetic(30.387577, -97.727607, 240);
+      ct = gnsstk::GPSWeekSecond(2200, 7800.0);
+      ndfp = std::make_shared<TestFactory>();
+      TestFactory *fact = dynamic_cast<TestFactory*>(ndfp.get());
+      for (int prn = 1; prn <= 8; prn++)
+      {
+         std::shared_ptr<gnsstk::GPSLNavEph> eph =
+            std::make_shared<gnsstk::GPSLNavEph>();
+         eph->signal.messageType = gnsstk::NavMessageType::Ephemeris;
+         eph->signal.system = gnsstk::SatelliteSystem::GPS;
+         eph->signal.obs.type = gnsstk::ObservationType::NavMsg;
+         eph->signal.obs.band = gnsstk::CarrierBand::L1;
+         eph->signal.obs.code = gnsstk::TrackingCode::CA;
+         eph->signal.nav = gnsstk::NavType::GPSLNAV;
+         eph->signal.sat = gnsstk::SatID(prn, gnsstk::SatelliteSystem::GPS);
+         eph->signal.xmitSat = eph->signal.sat;
+         eph->Toe = eph->Toc = gnsstk::GPSWeekSecond(2200, 7200.0);
+         eph->xmitTime = eph->xmit2 = eph->xmit3 =
+            gnsstk::GPSWeekSecond(2200, 3600.0);
+         eph->timeStamp = eph->xmitTime;
+         eph->health = gnsstk::SVHealth::Healthy;
+         eph->healthBits = 0;
+         eph->iodc = eph->iode = 10 + prn;
+         eph->Ahalf = 5153.7;
+         eph->A = eph->Ahalf * eph->Ahalf;
+         eph->ecc = 0.01;
+         eph->i0 = 0.96;
+         eph->OMEGA0 = 0.8 * prn;
+         eph->OMEGAdot = -8.e-9;
+         eph->M0 = 0.7 * prn;
+         eph->w = 0.5;
+         eph->dn = 4.5e-9;
+         eph->af0 = 1.e-5 * prn;
+         eph->af1 = 1.e-12;
+         eph->fixFit();
+         fact->addNavData(eph);
+         sats.push_back(eph->signal.sat);
+         pr1.push_back(2.2e7 + 1000. * prn);
+         pr2.push_back(2.2e7 + 1000. * prn + 3. + 0.5 * prn);
+      }
+      navLib.addFactory(ndfp);
+
+      double a[] = {1,2,3,4}; double b[] = {4,3,2,1};
+      ims.addIonoModel(gnsstk::GPSWeekSecond(2200, 0.0), gnsstk::IonoModel(a,b));
+   }
+
+      /// compare the results for sat i with an ObsRngDev
+   void compare(gnsstk::TestUtil& testFramework,
+                const gnsstk::ORDBatch& batch, size_t i,
+                const gnsstk::ObsRngDev& exp)
+   {
+      TUASSERT(batch.valid[i] == 1);
+      TUASSERTE(gnsstk::SatID, exp.svid, batch.sat[i]);
+      TUASSERTFE(exp.ord, batch.ord[i]);
+      TUASSERTFE((double)exp.rho, batch.rho[i]);
+      TUASSERTFE((double)exp.trop, batch.trop[i]);
+      TUASSERTFE((float)exp.elevation, batch.elevation[i]);
+      TUASSERTFE((float)exp.azimuth, batch.azimuth[i]);
+      TUASSERTE(bool, exp.iono.is_valid(), batch.haveIono);
+      if (exp.iono.is_valid())
+      {
+         TUASSERTFE((double)exp.iono, batch.iono[i]);
+      }
+      gnsstk::ObsRngDev got(batch.getORD(i));
+      TUASSERTFE(exp.ord, got.ord);
+      TUASSERTE(gnsstk::CommonTime, exp.obstime, got.obstime);
+   }
+
+   unsigned singleTest()
+   {
+      TUDEF("ORDBatch", "compute");
+      gnsstk::ORDBatch batch(navLib, em);
+      TUASSERTE(size_t, sats.size(), batch.compute(ct, rxpos, sats, pr1));
+      TUASSERTE(size_t, sats.size(), batch.size());
+      for (size_t i = 0; i < sats.size(); i++)
+         compare(testFramework, batch,
+                 i, gnsstk::ObsRngDev(pr1[i], sats[i], ct, rxpos, navLib, em));
+
+         // with an iono model; also a later epoch reusing the state
+      batch.setIonoModel(&ims, gnsstk::CarrierBand::L1);
+      gnsstk::CommonTime ct2(ct + 30.);
+      TUASSERTE(size_t, sats.size(), batch.compute(ct2, rxpos, sats, pr1));
+      for (size_t i = 0; i < sats.size(); i++)
+         compare(testFramework, batch, i,
+                 gnsstk::ObsRngDev(pr1[i], sats[i], ct2, rxpos, navLib, em,
+                                   ims, gnsstk::CarrierBand::L1));
+
+         // user trop model, and iono
+      gnsstk::SimpleTropModel stm(18.8889, 1021.2176, 77.7777);
+      batch.setTropModel(&stm);
+      TUASSERTE(size_t, sats.size(), batch.compute(ct, rxpos, sats, pr1));
+      for (size_t i = 0; i < sats.size(); i++)
+         compare(testFramework, batch, i,
+                 gnsstk::ObsRngDev(pr1[i], sats[i], ct, rxpos, navLib, em,
+                                   stm, ims, gnsstk::CarrierBand::L1));
+
+         // SV time, default trop, at another receiver
+      gnsstk::ORDBatch batchTx(navLib, em, true);
+      gnsstk::Position rx2;
+      rx2.setGeodetic(40., 10., 100.);
+      batchTx.compute(ct, rxpos, sats, pr1);
+      TUASSERTE(size_t, sats.size(), batchTx.compute(ct, rx2, sats, pr1));
+      for (size_t i = 0; i < sats.size(); i++)
+         compare(testFramework, batchTx, i,
+                 gnsstk::ObsRngDev(pr1[i], sats[i], ct, rx2, navLib, em,
+                                   true));
+      TURETURN();
+   }
+
+   unsigned dualTest()
+   {
+      TUDEF("ORDBatch", "computeDual");
+      gnsstk::ORDBatch batch(navLib, em);
+      TUASSERTE(size_t, sats.size(),
+                batch.computeDual(ct, rxpos, sats, pr1, pr2));
+      for (size_t i = 0; i < sats.size(); i++)
+         compare(testFramework, batch, i,
+                 gnsstk::ObsRngDev(pr1[i], pr2[i], sats[i], ct, rxpos,
+                                   navLib, em));
+
+      gnsstk::SimpleTropModel stm(18.8889, 1021.2176, 77.7777);
+      batch.setTropModel(&stm);
+      TUASSERTE(size_t, sats.size(),
+                batch.computeDual(ct, rxpos, sats, pr1, pr2));
+      for (size_t i = 0; i < sats.size(); i++)
+         compare(testFramework, batch, i,
+                 gnsstk::ObsRngDev(pr1[i], pr2[i], sats[i], ct, rxpos,
+                                   navLib, em, stm));
+      TURETURN();
+   }
+
+   unsigned missingTest()
+   {
+      TUDEF("ORDBatch", "compute");
+      gnsstk::ORDBatch batch(navLib, em);
+      std::vector<gnsstk::SatID> s(sats);
+      std::vector<double> p(pr1);
+      s.insert(s.begin() + 2, gnsstk::SatID(30, gnsstk::SatelliteSystem::GPS));
+      p.insert(p.begin() + 2, 2.1e7);
+      TUASSERTE(size_t, sats.size(), batch.compute(ct, rxpos, s, p));
+      TUASSERTE(size_t, s.size(), batch.size());
+      TUASSERT(batch.valid[2] == 0);
+      TUASSERT(batch.valid[3] == 1);
+      TUASSERTFE(gnsstk::ObsRngDev(pr1[2], sats[2], ct, rxpos, navLib, em).ord,
+                 batch.ord[3]);
+
+      gnsstk::ORDEpoch oe;
+      batch.getORDEpoch(oe);
+      TUASSERTE(size_t, sats.size(), oe.ords.size());
+      TUASSERTE(gnsstk::CommonTime, ct, oe.time);
+      TUASSERT(oe.ords.find(s[2]) == oe.ords.end());
+      TUASSERTFE(batch.ord[0], oe.ords[sats[0]].getORD());
+
+      p.pop_back();
+      TUTHROW(batch.compute(ct, rxpos, s, p));
+      TURETURN();
+   }
+
+   gnsstk::NavLibrary navLib;
+   gnsstk::NavDataFactoryPtr ndfp;
+   gnsstk::WGS84Ellipsoid em;
+   gnsstk::IonoModelStore ims;
+   gnsstk::Position rxpos;
+   gnsstk::CommonTime ct;
+   std::vector<gnsstk::SatID> sats;
+   std::vector<double> pr1, pr2;
+};
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   ORDBatch_T testClass;
+
+   errorTotal += testClass.singleTest();
+   errorTotal += testClass.dualTest();
+   errorTotal += testClass.missingTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,243 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file PeriodicCodeGen_T.cpp Test the C/A, L2C and L5 code generators
+
+#include <iostream>
+#include <vector>
+#include "CACodeGen.hpp"
+#include "L2CCodeGen.hpp"
+#include "L5CodeGen.hpp"
+#include "ParallelCodeGen.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class PeriodicCodeGen_T
+{
+public:
+      /// First 10 C/A chips against IS-GPS-200 table 3-Ia
+   unsigned caTest();
+      /// CM and CL codes against the IS-GPS-200 table 3-IIa states
+   unsigned l2cTest();
+      /// I5 and Q5 codes against the IS-GPS-705 table 3-Ia XB states
+   unsigned l5Test();
+      /// Packed ranges, wrapping and the threaded interface
+   unsigned getChipsTest();
+
+      /// Get n chips starting at chip first, one at a time, packed msb first
+   static unsigned long firstChips(const PeriodicCodeGen& gen, long first,
+                                   int n)
+   {
+      unsigned long rv = 0;
+      for (int i = 0; i < n; i++)
+         rv = (rv << 1) | gen.getChip(first + i);
+      return rv;
+   }
+};
+
+
+unsigned PeriodicCodeGen_T ::
+caTest()
+{
+   TUDEF("CACodeGen", "CACodeGen");
+      // octal, first chip in the msb
+   const unsigned long first10[32] =
+   {
+      01440, 01620, 01710, 01744, 01133, 01455, 01131, 01454,
+      01626, 01504, 01642, 01750, 01764, 01772, 01775, 01776,
+      01156, 01467, 01633, 01715, 01746, 01763, 01063, 01706,
+      01743, 01761, 01770, 01774, 01127, 01453, 01625, 01712
+   };
+   for (int prn = 1; prn <= 32; prn++)
+   {
+      CACodeGen gen(prn);
+      TUASSERTE(int, prn, gen.getPRNID());
+      TUASSERTE(long, 1023, gen.getLength());
+      TUASSERTE(unsigned long, first10[prn-1], firstChips(gen, 0, 10));
+         // the code repeats
+      TUASSERTE(unsigned long, first10[prn-1], firstChips(gen, 1023, 10));
+   }
+   TUTHROW(CACodeGen(0));
+   TUTHROW(CACodeGen(64));
+   TURETURN();
+}
+
+
+unsigned PeriodicCodeGen_T ::
+l2cTest()
+{
+   TUDEF("L2CCodeGen", "L2CCodeGen");
+      /* The register shifts toward stage 27, the output, with the output
+         fed back into the stages tapped by the polynomial.  Run it forward
+         from the initial states and back from the PRN 1 end states. */
+   const uint32_t taps = 0445112474, mask = 0777777777;
+   const uint32_t endState[2] = { 0552566002, 0267724236 };
+   for (int c = 0; c < 2; c++)
+   {
+      L2CCodeGen::Code code = (c ? L2CCodeGen::CL : L2CCodeGen::CM);
+      for (int prn = 1; prn <= L2CCodeGen::MAX_PRN; prn++)
+      {
+         L2CCodeGen gen(prn, code);
+         TUASSERTE(int, c ? 767250 : 10230, gen.getLength());
+         uint32_t reg = (c ? L2CCodeGen::CLInit[prn-1] :
+                         L2CCodeGen::CMInit[prn-1]);
+         bool ok = true;
+         for (long i = 0; i < 64; i++)
+         {
+            uint32_t out = reg & 1;
+            ok = ok && (gen.getChip(i) == int(out));
+            reg >>= 1;
+            if (out)
+               reg ^= taps;
+         }
+         TUASSERT(ok);
+      }
+      L2CCodeGen gen(1, code);
+      TUASSERT(gen.getCode() == code);
+      uint32_t reg = endState[c];
+      bool ok = true;
+      for (long i = gen.getLength() - 1; i >= gen.getLength() - 64; i--)
+      {
+         ok = ok && (gen.getChip(i) == int(reg & 1));
+            // undo one shift; stage 1 is always tapped
+         uint32_t out = (reg >> 26) & 1;
+         reg = (((reg ^ (out ? taps : 0)) << 1) | out) & mask;
+      }
+      TUASSERT(ok);
+   }
+   TUTHROW(L2CCodeGen(0, L2CCodeGen::CM));
+   TUTHROW(L2CCodeGen(38, L2CCodeGen::CL));
+   TURETURN();
+}
+
+
+unsigned PeriodicCodeGen_T ::
+l5Test()
+{
+   TUDEF("L5CodeGen", "L5CodeGen");
+      /* XA starts at all ones, so the first 13 chips are the complement of
+         the XB state after the advance, stage 13 first.  PRN 1 states,
+         stages 1-13: I5 0101011100100, Q5 1001011001100. */
+   const unsigned long first13[2] = { 015425, 014626 };
+   for (int c = 0; c < 2; c++)
+   {
+      L5CodeGen gen(1, c ? L5CodeGen::Q5 : L5CodeGen::I5);
+      TUASSERTE(long, 10230, gen.getLength());
+      TUASSERTE(unsigned long, first13[c], firstChips(gen, 0, 13));
+   }
+      // each PRN has its own code, and the code repeats
+   L5CodeGen i1(1, L5CodeGen::I5), i2(2, L5CodeGen::I5);
+   TUASSERT(firstChips(i1, 0, 64) != firstChips(i2, 0, 64));
+   TUASSERTE(unsigned long, firstChips(i1, 0, 40), firstChips(i1, 10230, 40));
+   TUTHROW(L5CodeGen(0, L5CodeGen::I5));
+   TUTHROW(L5CodeGen(38, L5CodeGen::Q5));
+   TURETURN();
+}
+
+
+unsigned PeriodicCodeGen_T ::
+getChipsTest()
+{
+   TUDEF("PeriodicCodeGen", "getChips");
+   CACodeGen ca(7);
+   L2CCodeGen cm(5, L2CCodeGen::CM);
+   const PeriodicCodeGen *gens[2] = { &ca, &cm };
+      // unaligned starts, ranges across the end of the period and
+      // longer than it, and partial last words
+   const long starts[] = { 0, 1, 63, 64, 1000, 10229, 123456 };
+   const long lengths[] = { 1, 63, 64, 65, 1023, 3000 };
+   for (int g = 0; g < 2; g++)
+   {
+      const PeriodicCodeGen& gen(*gens[g]);
+      bool ok = true;
+      for (long first : starts)
+      {
+         for (long num : lengths)
+         {
+            vector<uint64_t> words(numChipWords(num) + 1, ~uint64_t(0));
+            gen.getChips(first, num, words.data());
+            for (long i = 0; i < numChipWords(num) * 64; i++)
+            {
+               int chip = (words[i/64] >> (63 - i%64)) & 1;
+               ok = ok && (chip == (i < num ? gen.getChip(first + i) : 0));
+            }
+               // nothing written past the range
+            ok = ok && (words.back() == ~uint64_t(0));
+         }
+      }
+      TUASSERT(ok);
+   }
+   uint64_t word;
+   TUTHROW(ca.getChips(-1, 10, &word));
+   TUTHROW(ca.getChips(0, -1, &word));
+
+      // many PRNs at once give the same chips as one at a time
+   vector<CACodeGen> all;
+   for (int prn = 1; prn <= CACodeGen::MAX_PRN; prn++)
+      all.push_back(CACodeGen(prn));
+   vector< vector<uint64_t> > words;
+   getChips(all, 500, 5000, words, 4);
+   TUASSERTE(size_t, all.size(), words.size());
+   bool ok = true;
+   for (size_t k = 0; k < all.size(); k++)
+   {
+      vector<uint64_t> one(numChipWords(5000));
+      all[k].getChips(500, 5000, one.data());
+      ok = ok && (one == words[k]);
+   }
+   TUASSERT(ok);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   PeriodicCodeGen_T testClass;
+
+   errorTotal += testClass.caTest();
+   errorTotal += testClass.l2cTest();
+   errorTotal += testClass.l5Test();
+   errorTotal += testClass.getChipsTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
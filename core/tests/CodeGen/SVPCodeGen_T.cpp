@@ -0,0 +1,206 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file SVPCodeGen_T.cpp Test the P-code generator
+
+#include <iostream>
+#include <vector>
+#include "SVPCodeGen.hpp"
+#include "CodeBuffer.hpp"
+#include "X1Sequence.hpp"
+#include "X2Sequence.hpp"
+#include "GPSWeekZcount.hpp"
+#include "ParallelCodeGen.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class SVPCodeGen_T
+{
+public:
+      /// First 12 chips of the week against IS-GPS-200 table 3-Ia
+   unsigned firstChipsTest();
+      /// getChips( ) against getCurrentSixSeconds( ) over whole periods
+   unsigned sixSecondsTest();
+      /// Ranges that start mid-word and run into the next period
+   unsigned rangeTest();
+
+      /// Chip k of a CodeBuffer, which holds 32 chips per element
+   static int bufChip(const CodeBuffer& pcb, long k)
+   {
+      return (pcb[k/MAX_BIT] >> (MAX_BIT - 1 - k%MAX_BIT)) & 1;
+   }
+
+      /// Chip k of words packed by getChips( )
+   static int wordChip(const vector<uint64_t>& words, long k)
+   {
+      return (words[k/MAX_BIT64] >> (MAX_BIT64 - 1 - k%MAX_BIT64)) & 1;
+   }
+
+   static CommonTime zTime(long zcount)
+   {
+      return GPSWeekZcount(1000, zcount).convertToCommonTime();
+   }
+};
+
+
+unsigned SVPCodeGen_T ::
+firstChipsTest()
+{
+   TUDEF("SVPCodeGen", "getChips");
+      // octal, first chip in the msb
+   const unsigned long first12[10] =
+   {
+      04444, 04000, 04222, 04333, 04377, 04355, 04344, 04340, 04342, 04343
+   };
+   for (int prn = 1; prn <= 37; prn++)
+   {
+      SVPCodeGen gen(prn, zTime(0));
+      uint64_t word;
+      gen.getChips(0, 12, &word);
+      TUASSERTE(unsigned long,
+                prn <= 10 ? first12[prn-1] : first12[9], word >> 52);
+         // unused bits are zero
+      TUASSERTE(uint64_t, 0, word & 0xfffffffffffffULL);
+   }
+   SVPCodeGen gen(1, zTime(0));
+   uint64_t word;
+   TUTHROW(gen.getChips(-1, 12, &word));
+   TUTHROW(gen.getChips(0, -1, &word));
+   TUTHROW(SVPCodeGen(211, zTime(0)));
+   TURETURN();
+}
+
+
+unsigned SVPCodeGen_T ::
+sixSecondsTest()
+{
+   TUDEF("SVPCodeGen", "getChips");
+      // start of week, mid-week and the end-of-week period; PRN 38 uses
+      // the PRN 1 code a day later
+   const long zcounts[] = { 0, 201600, 403196 };
+   const int prns[] = { 1, 37, 38 };
+   vector<uint64_t> words(numChipWords(NUM_6SEC_CHIPS));
+   for (long z : zcounts)
+   {
+      for (int prn : prns)
+      {
+         SVPCodeGen gen(prn, zTime(z));
+         CodeBuffer pcb(prn);
+         gen.getChips(0, NUM_6SEC_CHIPS, words.data());
+         gen.getCurrentSixSeconds(pcb);
+         bool ok = true;
+         for (long j = 0; j < NUM_6SEC_WORDS; j++)
+         {
+            uint64_t half = (words[j/2] >> (j%2 ? 0 : MAX_BIT)) & 0xffffffff;
+            ok = ok && (half == (pcb[j] & 0xffffffff));
+         }
+            // the period is an odd number of 32 chip words
+         ok = ok && ((words.back() & 0xffffffff) == 0);
+         TUASSERT(ok);
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned SVPCodeGen_T ::
+rangeTest()
+{
+   TUDEF("SVPCodeGen", "getChips");
+   const long zcounts[] = { 201600, 403196 };
+   const long num = 300;
+   for (long z : zcounts)
+   {
+      SVPCodeGen gen(5, zTime(z));
+      CodeBuffer pcb0(5), pcb1(5);
+      vector<uint64_t> mid(numChipWords(num)), across(numChipWords(num));
+      gen.getChips(12345, num, mid.data());
+      gen.getChips(NUM_6SEC_CHIPS - 100, num, across.data());
+      gen.getCurrentSixSeconds(pcb0);
+      gen.increment4ZCounts();
+      gen.getCurrentSixSeconds(pcb1);
+      bool ok = true;
+      for (long k = 0; k < num; k++)
+      {
+         ok = ok && (wordChip(mid, k) == bufChip(pcb0, 12345 + k));
+         long c = NUM_6SEC_CHIPS - 100 + k;
+         ok = ok && (wordChip(across, k) ==
+                     (c < NUM_6SEC_CHIPS ? bufChip(pcb0, c) :
+                      bufChip(pcb1, c - NUM_6SEC_CHIPS)));
+      }
+      TUASSERT(ok);
+   }
+
+      // many SVs at once give the same chips as one at a time
+   vector<SVPCodeGen> gens;
+   for (int prn = 1; prn <= 8; prn++)
+      gens.push_back(SVPCodeGen(prn, zTime(1000)));
+   vector< vector<uint64_t> > words;
+   getChips(gens, 1000, 5000, words, 4);
+   TUASSERTE(size_t, gens.size(), words.size());
+   bool ok = true;
+   for (size_t k = 0; k < gens.size(); k++)
+   {
+      vector<uint64_t> one(numChipWords(5000));
+      gens[k].getChips(1000, 5000, one.data());
+      ok = ok && (one == words[k]);
+   }
+   TUASSERT(ok);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SVPCodeGen_T testClass;
+
+      // the X1 and X2 sequences are shared by all generators
+   X1Sequence::allocateMemory();
+   X2Sequence::allocateMemory();
+
+   errorTotal += testClass.firstChipsTest();
+   errorTotal += testClass.sixSecondsTest();
+   errorTotal += testClass.rangeTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,408 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <stdio.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#ifndef WIN32
+#include <unistd.h>
+#endif
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "TestUtil.hpp"
+#include "YDSTime.hpp"
+#include "FileSpecIndex.hpp"
+#include "FileUtils.hpp"
+#include "build_config.h"
+
+using namespace std;
+
+class FileSpecIndex_T
+{
+public:
+   FileSpecIndex_T();
+   ~FileSpecIndex_T();
+
+      /// Make sure the constructor rejects tokens without widths.
+   unsigned constructorTest();
+      /// Compare index searches with FileSpecFind::find().
+   unsigned findTest();
+      /// Make sure FileSpecFind::find() uses an added index.
+   unsigned addIndexTest();
+      /// Check that refresh() picks up added and removed files.
+   unsigned refreshTest();
+      /// Check that an index saved and loaded gives the same results.
+   unsigned saveLoadTest();
+
+private:
+      /// Create the directory holding path, and an empty file at path.
+   void makeFile(const std::string& path);
+      /// Create the test files for one station and day.
+   void makeDay(const std::string& sta, const std::string& doy);
+      /// Remove the test files for one station and day.
+   void removeDay(const std::string& sta, const std::string& doy);
+      /// Compare an index search with FileSpecFind.
+   bool sameAsGlob(const gnsstk::FileSpecIndex& index,
+                   const gnsstk::CommonTime& start,
+                   const gnsstk::CommonTime& end,
+                   const gnsstk::FileSpecFind::Filter& filter);
+
+      /// File separator, but short.
+   std::string fs;
+      /// Top of the test tree.
+   std::string tld;
+      /// FileSpec of the test files.
+   std::string searchSpec;
+      /// Files and directories created, in creation order.
+   std::vector<std::string> made;
+};
+
+
+FileSpecIndex_T ::
+FileSpecIndex_T()
+      : fs(gnsstk::getFileSep()),
+        tld(gnsstk::getPathTestTemp() + gnsstk::getFileSep() +
+            "test_output_FileSpecIndex")
+{
+   searchSpec = tld + fs + "%04Y" + fs + "%05n" + fs + "%03j" + fs +
+      "x-%05n-%04Y-%03j-%02H.dat";
+   makeDay("10000", "211");
+   makeDay("10000", "212");
+   makeDay("10001", "211");
+   makeDay("10001", "213");
+      // a file that doesn't match the spec
+   makeFile(tld + fs + "2018" + fs + "10000" + fs + "211" + fs + "README");
+}
+
+
+FileSpecIndex_T ::
+~FileSpecIndex_T()
+{
+   for (auto i = made.rbegin(); i != made.rend(); i++)
+   {
+      if (remove(i->c_str()) != 0)
+         rmdir(i->c_str());
+   }
+}
+
+
+void FileSpecIndex_T ::
+makeFile(const std::string& path)
+{
+   string dir = path.substr(0, path.find_last_of(fs));
+   string::size_type i = tld.length();
+   if (!gnsstk::FileUtils::fileAccessCheck(tld))
+   {
+      gnsstk::FileUtils::makeDir(tld, 0755);
+      made.push_back(tld);
+   }
+   while ((i = path.find(fs, i+1)) != string::npos)
+   {
+      string sub = path.substr(0, i);
+      if (!gnsstk::FileUtils::fileAccessCheck(sub))
+      {
+         gnsstk::FileUtils::makeDir(sub, 0755);
+         made.push_back(sub);
+      }
+   }
+   ofstream f(path.c_str());
+   made.push_back(path);
+}
+
+
+void FileSpecIndex_T ::
+makeDay(const std::string& sta, const std::string& doy)
+{
+   for (const string hour : { "00", "06", "12", "18" })
+   {
+      makeFile(tld + fs + "2018" + fs + sta + fs + doy + fs + "x-" + sta +
+               "-2018-" + doy + "-" + hour + ".dat");
+   }
+}
+
+
+void FileSpecIndex_T ::
+removeDay(const std::string& sta, const std::string& doy)
+{
+   string dir = tld + fs + "2018" + fs + sta + fs + doy;
+   for (const string hour : { "00", "06", "12", "18" })
+   {
+      string path = dir + fs + "x-" + sta + "-2018-" + doy + "-" + hour +
+         ".dat";
+      remove(path.c_str());
+   }
+   rmdir(dir.c_str());
+}
+
+
+bool FileSpecIndex_T ::
+sameAsGlob(const gnsstk::FileSpecIndex& index,
+           const gnsstk::CommonTime& start,
+           const gnsstk::CommonTime& end,
+           const gnsstk::FileSpecFind::Filter& filter)
+{
+   list<string> expected = gnsstk::FileSpecFind::find(searchSpec, start, end,
+                                                     filter);
+   list<string> got = index.find(start, end, filter);
+   expected.sort();
+   got.sort();
+   if (expected != got)
+   {
+      cerr << "expected " << expected.size() << " files, got " << got.size()
+           << endl;
+      return false;
+   }
+   return true;
+}
+
+
+unsigned FileSpecIndex_T ::
+constructorTest()
+{
+   TUDEF("FileSpecIndex", "FileSpecIndex");
+   TUTHROW(gnsstk::FileSpecIndex(tld + fs + "%x-%04Y.dat"));
+   TUTHROW(gnsstk::FileSpecIndex(tld + fs + "%04Y%"));
+   try
+   {
+      gnsstk::FileSpecIndex index(tld + fs + "%3x-%04Y.dat");
+      TUPASS("text with width");
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc;
+      TUFAIL("Unexpected exception");
+   }
+   TURETURN();
+}
+
+
+unsigned FileSpecIndex_T ::
+findTest()
+{
+   TUDEF("FileSpecIndex", "find");
+   using ListSize = list<string>::size_type;
+   try
+   {
+      gnsstk::FileSpecIndex index(searchSpec);
+      index.scan(3);
+      TUASSERTE(size_t, 16, index.getNumFiles());
+      gnsstk::FileSpecFind::Filter none;
+      TUASSERTE(ListSize, 16,
+                index.find(gnsstk::CommonTime::BEGINNING_OF_TIME,
+                           gnsstk::CommonTime::END_OF_TIME).size());
+      TUASSERT(sameAsGlob(index, gnsstk::YDSTime(2018,211,0),
+                          gnsstk::YDSTime(2018,212,0), none));
+      TUASSERT(sameAsGlob(index, gnsstk::YDSTime(2018,211,21600),
+                          gnsstk::YDSTime(2018,211,21600), none));
+      TUASSERT(sameAsGlob(index, gnsstk::YDSTime(2018,211,20000),
+                          gnsstk::YDSTime(2018,213,50000), none));
+      TUASSERT(sameAsGlob(index, gnsstk::YDSTime(2018,214,0),
+                          gnsstk::YDSTime(2018,220,0), none));
+         // single epoch
+      list<string> files = index.find(gnsstk::YDSTime(2018,211,21600),
+                                      gnsstk::YDSTime(2018,211,21600));
+      TUASSERTE(ListSize, 2, files.size());
+         // results are in time order
+      files = index.find(gnsstk::YDSTime(2018,211,0),
+                         gnsstk::YDSTime(2018,214,0));
+      TUASSERTE(ListSize, 16, files.size());
+      TUASSERTE(string, tld + fs + "2018" + fs + "10000" + fs + "211" + fs +
+                "x-10000-2018-211-00.dat", files.front());
+      TUASSERTE(string, tld + fs + "2018" + fs + "10001" + fs + "213" + fs +
+                "x-10001-2018-213-18.dat", files.back());
+      gnsstk::FileSpecFind::Filter filter;
+      filter.insert(gnsstk::FileSpecFind::Filter::value_type(
+                       gnsstk::FileSpec::station, "10001"));
+      TUASSERT(sameAsGlob(index, gnsstk::YDSTime(2018,211,0),
+                          gnsstk::YDSTime(2018,214,0), filter));
+      TUASSERTE(ListSize, 8,
+                index.find(gnsstk::YDSTime(2018,211,0),
+                           gnsstk::YDSTime(2018,214,0), filter).size());
+      filter.insert(gnsstk::FileSpecFind::Filter::value_type(
+                       gnsstk::FileSpec::station, "10000"));
+      TUASSERTE(ListSize, 16,
+                index.find(gnsstk::YDSTime(2018,211,0),
+                           gnsstk::YDSTime(2018,214,0), filter).size());
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc;
+      TUFAIL("Unexpected exception");
+   }
+   TURETURN();
+}
+
+
+unsigned FileSpecIndex_T ::
+addIndexTest()
+{
+   TUDEF("FileSpecFind", "addIndex");
+   using ListSize = list<string>::size_type;
+   try
+   {
+      std::shared_ptr<gnsstk::FileSpecIndex> index =
+         std::make_shared<gnsstk::FileSpecIndex>(searchSpec);
+         // an empty index, so its results can be told apart
+      gnsstk::FileSpecFind::addIndex(index);
+      TUASSERTE(ListSize, 0,
+                gnsstk::FileSpecFind::find(
+                   searchSpec, gnsstk::CommonTime::BEGINNING_OF_TIME,
+                   gnsstk::CommonTime::END_OF_TIME).size());
+      index->scan();
+      TUASSERTE(ListSize, 16,
+                gnsstk::FileSpecFind::find(
+                   searchSpec, gnsstk::CommonTime::BEGINNING_OF_TIME,
+                   gnsstk::CommonTime::END_OF_TIME).size());
+      gnsstk::FileSpecFind::removeIndex(searchSpec);
+      TUASSERTE(ListSize, 16,
+                gnsstk::FileSpecFind::find(
+                   searchSpec, gnsstk::CommonTime::BEGINNING_OF_TIME,
+                   gnsstk::CommonTime::END_OF_TIME).size());
+         // text tokens are replaced before looking for an index
+      string textSpec = tld + fs + "%04Y" + fs + "%05n" + fs + "%03j" + fs +
+         "%x-%05n-%04Y-%03j-%02H.dat";
+      gnsstk::FileSpec::FSTStringMap fsts;
+      fsts[gnsstk::FileSpec::text] = "x";
+      gnsstk::FileSpecFind::addIndex(
+         std::make_shared<gnsstk::FileSpecIndex>(searchSpec));
+      TUASSERTE(ListSize, 0,
+                gnsstk::FileSpecFind::find(
+                   textSpec, gnsstk::CommonTime::BEGINNING_OF_TIME,
+                   gnsstk::CommonTime::END_OF_TIME, fsts).size());
+      gnsstk::FileSpecFind::clearIndexes();
+      TUASSERTE(ListSize, 16,
+                gnsstk::FileSpecFind::find(
+                   textSpec, gnsstk::CommonTime::BEGINNING_OF_TIME,
+                   gnsstk::CommonTime::END_OF_TIME, fsts).size());
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc;
+      TUFAIL("Unexpected exception");
+   }
+   gnsstk::FileSpecFind::clearIndexes();
+   TURETURN();
+}
+
+
+unsigned FileSpecIndex_T ::
+refreshTest()
+{
+   TUDEF("FileSpecIndex", "refresh");
+   try
+   {
+      gnsstk::FileSpecIndex index(searchSpec);
+      index.scan();
+      gnsstk::FileSpecFind::Filter none;
+      makeDay("10000", "215");
+      makeDay("10002", "211");
+      makeFile(tld + fs + "2018" + fs + "10001" + fs + "211" + fs +
+               "x-10001-2018-211-03.dat");
+      removeDay("10001", "213");
+      TUASSERT(index.refresh() > 0);
+      TUASSERTE(size_t, 21, index.getNumFiles());
+      TUASSERT(sameAsGlob(index, gnsstk::CommonTime::BEGINNING_OF_TIME,
+                          gnsstk::CommonTime::END_OF_TIME, none));
+      TUASSERT(sameAsGlob(index, gnsstk::YDSTime(2018,211,0),
+                          gnsstk::YDSTime(2018,212,0), none));
+      removeDay("10000", "215");
+      removeDay("10002", "211");
+      index.refresh();
+      TUASSERTE(size_t, 13, index.getNumFiles());
+      TUASSERT(sameAsGlob(index, gnsstk::CommonTime::BEGINNING_OF_TIME,
+                          gnsstk::CommonTime::END_OF_TIME, none));
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc;
+      TUFAIL("Unexpected exception");
+   }
+   TURETURN();
+}
+
+
+unsigned FileSpecIndex_T ::
+saveLoadTest()
+{
+   TUDEF("FileSpecIndex", "save");
+   string fileName = gnsstk::getPathTestTemp() + fs +
+      "test_output_FileSpecIndex.idx";
+   try
+   {
+      gnsstk::FileSpecIndex index(searchSpec);
+      index.scan();
+      index.save(fileName);
+      TUCSM("load");
+      gnsstk::FileSpecIndex loaded(searchSpec);
+      loaded.load(fileName);
+      TUASSERTE(size_t, index.getNumFiles(), loaded.getNumFiles());
+      TUASSERTE(size_t, index.getNumDirs(), loaded.getNumDirs());
+      TUASSERT(index.find(gnsstk::YDSTime(2018,211,20000),
+                          gnsstk::YDSTime(2018,213,0)) ==
+               loaded.find(gnsstk::YDSTime(2018,211,20000),
+                           gnsstk::YDSTime(2018,213,0)));
+      gnsstk::FileSpecIndex other(tld + fs + "%04Y.dat");
+      TUTHROW(other.load(fileName));
+      TUTHROW(loaded.load(fileName + ".missing"));
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc;
+      TUFAIL("Unexpected exception");
+   }
+   remove(fileName.c_str());
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   FileSpecIndex_T testClass;
+
+   errorTotal += testClass.constructorTest();
+   errorTotal += testClass.findTest();
+   errorTotal += testClass.addIndexTest();
+   errorTotal += testClass.refreshTest();
+   errorTotal += testClass.saveLoadTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
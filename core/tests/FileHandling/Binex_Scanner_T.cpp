@@ -0,0 +1,338 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "BinexScanner.hpp"
+#include "TestUtil.hpp"
+#include "build_config.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using namespace gnsstk;
+
+class BinexScanner_T
+{
+public:
+   BinexScanner_T();
+
+   unsigned scanBufferTest();
+   unsigned extractTest();
+   unsigned selectTest();
+   unsigned badDataTest();
+   unsigned fileTest();
+
+private:
+      /// Records of every flag combination and CRC size, and their bytes.
+   vector<BinexData> records;
+   string bytes;
+      /// Offset of each record in bytes.
+   vector<size_t> offsets;
+
+      /// Scan all of scanner, checking the records against records.
+   void checkAll(TestUtil& testFramework, BinexScanner& scanner);
+};
+
+
+BinexScanner_T ::
+BinexScanner_T()
+{
+   const BinexData::SyncByte flags[] = { 0x00, 0x08, 0x10, 0x18,
+                                         0x20, 0x28, 0x30, 0x38 };
+      // message sizes giving 1-, 2- and 4-byte CRCs
+   const size_t sizes[] = { 0, 20, 200, 5000 };
+   ostringstream oss;
+   BinexData::RecordID id = 0;
+   for (unsigned f = 0; f < 8; f++)
+   {
+      for (unsigned s = 0; s < 4; s++)
+      {
+         BinexData rec;
+         rec.setRecordFlags(flags[f]);
+         rec.setRecordID(id++ % 3 == 0 ? 0x7f : 0x01);
+         if (sizes[s] > 0)
+         {
+            size_t offset = 0;
+            rec.updateMessageData(offset, BinexData::UBNXI(1000 + id));
+            rec.updateMessageData(offset, BinexData::MGFZI(-98765 * (long)id));
+            uint32_t u32 = 0x01020304 + id;
+            rec.updateMessageData(offset, u32, sizeof(u32));
+            string pad(sizes[s] - offset, '\0');
+            for (size_t i = 0; i < pad.size(); i++)
+               pad[i] = (char)(i * 7 + id);
+            rec.updateMessageData(offset, pad, pad.size());
+         }
+         offsets.push_back(oss.str().size());
+         rec.putRecord(oss);
+         records.push_back(rec);
+      }
+   }
+   bytes = oss.str();
+}
+
+
+void BinexScanner_T ::
+checkAll(TestUtil& testFramework, BinexScanner& scanner)
+{
+   BinexScanner::Record rec;
+   size_t i = 0;
+   while (scanner.next(rec))
+   {
+      if (i >= records.size())
+      {
+         TUFAIL("too many records");
+         return;
+      }
+      TUASSERTE(BinexData::RecordID, records[i].getRecordID(), rec.recID);
+      TUASSERTE(uint64_t, offsets[i], rec.offset);
+      TUASSERTE(size_t, records[i].getMessageLength(), rec.messageLength);
+      TUASSERTE(size_t, records[i].getRecordSize(), rec.size);
+      TUASSERT(string((const char*)rec.message, rec.messageLength) ==
+               records[i].getMessageData());
+      BinexData copy;
+      rec.toBinexData(copy);
+      TUASSERT(copy == records[i]);
+      i++;
+   }
+   TUASSERTE(size_t, records.size(), i);
+}
+
+
+unsigned BinexScanner_T ::
+scanBufferTest()
+{
+   TUDEF("BinexScanner", "next");
+   BinexScanner scanner(bytes.data(), bytes.size());
+   checkAll(testFramework, scanner);
+   TUASSERTE(uint64_t, bytes.size(), scanner.getOffset());
+   TUASSERTE(unsigned long, 0, scanner.getNumSkipped());
+   TUASSERTE(uint64_t, 0, scanner.getNumDiscarded());
+      // empty input
+   BinexScanner empty(bytes.data(), 0);
+   BinexScanner::Record rec;
+   TUASSERT(!empty.next(rec));
+   TURETURN();
+}
+
+
+unsigned BinexScanner_T ::
+extractTest()
+{
+   TUDEF("BinexScanner::Record", "extractMessageData");
+   BinexScanner scanner(bytes.data(), bytes.size());
+   BinexScanner::Record rec;
+   size_t i = 0;
+   while (scanner.next(rec))
+   {
+      BinexData& orig = records[i++];
+      if (orig.getMessageLength() == 0)
+      {
+         size_t offset = 0;
+         BinexData::UBNXI u;
+         TUTHROW(rec.extractMessageData(offset, u));
+         continue;
+      }
+      size_t offset = 0, origOffset = 0;
+      BinexData::UBNXI u, origU;
+      BinexData::MGFZI m, origM;
+      uint32_t u32, origU32;
+      rec.extractMessageData(offset, u);
+      orig.extractMessageData(origOffset, origU);
+      TUASSERTE(unsigned long, (unsigned long)origU, (unsigned long)u);
+      rec.extractMessageData(offset, m);
+      orig.extractMessageData(origOffset, origM);
+      TUASSERTE(long long, (long long)origM, (long long)m);
+      rec.extractMessageData(offset, u32);
+      orig.extractMessageData(origOffset, origU32, sizeof(origU32));
+      TUASSERTE(uint32_t, origU32, u32);
+      TUASSERTE(size_t, origOffset, offset);
+      offset = rec.messageLength - 2;
+      TUTHROW(rec.extractMessageData(offset, u32));
+   }
+   TURETURN();
+}
+
+
+unsigned BinexScanner_T ::
+selectTest()
+{
+   TUDEF("BinexScanner", "select");
+   BinexScanner scanner(bytes.data(), bytes.size());
+   scanner.select(0x7f);
+   BinexScanner::Record rec;
+   size_t found = 0, expected = 0;
+   for (size_t i = 0; i < records.size(); i++)
+   {
+      if (records[i].getRecordID() == 0x7f)
+         expected++;
+   }
+   while (scanner.next(rec))
+   {
+      TUASSERTE(BinexData::RecordID, 0x7f, rec.recID);
+      found++;
+   }
+   TUASSERTE(size_t, expected, found);
+   TUASSERTE(unsigned long, records.size() - expected,
+             scanner.getNumSkipped());
+      // skipped records aren't checked, so damage to one goes unseen
+   string damaged(bytes);
+   size_t r = 1;
+   TUASSERT(records[r].getRecordID() != 0x7f);
+   damaged[offsets[r] + records[r].getHeadLength()] ^= 0x55;
+   BinexScanner scanner2(damaged.data(), damaged.size());
+   scanner2.select(0x7f);
+   found = 0;
+   while (scanner2.next(rec))
+      found++;
+   TUASSERTE(size_t, expected, found);
+   scanner2.clearSelection();
+   TURETURN();
+}
+
+
+unsigned BinexScanner_T ::
+badDataTest()
+{
+   TUDEF("BinexScanner", "next");
+   BinexScanner::Record rec;
+
+      // damage the message of record r
+   size_t r = 5;
+   string damaged(bytes);
+   damaged[offsets[r] + records[r].getHeadLength() + 3] ^= 0x01;
+   {
+      BinexScanner scanner(damaged.data(), damaged.size());
+      for (size_t i = 0; i < r; i++)
+         TUASSERT(scanner.next(rec));
+      TUTHROW(scanner.next(rec));
+      TUASSERTE(uint64_t, offsets[r] + 1, scanner.getOffset());
+   }
+   {
+      BinexScanner scanner(damaged.data(), damaged.size());
+      scanner.setCheckCRC(false);
+      size_t found = 0;
+      while (scanner.next(rec))
+         found++;
+      TUASSERTE(size_t, records.size(), found);
+   }
+   {
+         // with resync the damaged record is lost but the rest are found
+      BinexScanner scanner(damaged.data(), damaged.size());
+      scanner.setResync(true);
+      size_t found = 0;
+      while (scanner.next(rec))
+      {
+         TUASSERT(rec.offset != offsets[r]);
+         found++;
+      }
+      TUASSERTE(size_t, records.size() - 1, found);
+      TUASSERT(scanner.getNumDiscarded() >= records[r].getRecordSize() - 10);
+   }
+
+      // garbage in front, and a record cut short at the end
+   string garbage("\x01\x02\xc2\x00\x7f junk", 10);
+   string noisy = garbage + bytes.substr(0, bytes.size() - 3);
+   {
+      BinexScanner scanner(noisy.data(), noisy.size());
+      TUTHROW(scanner.next(rec));
+   }
+   {
+      BinexScanner scanner(noisy.data(), noisy.size());
+      scanner.setResync(true);
+      size_t found = 0;
+      while (scanner.next(rec))
+      {
+         TUASSERTE(uint64_t, offsets[found] + garbage.size(), rec.offset);
+         found++;
+      }
+      TUASSERTE(size_t, records.size() - 1, found);
+      TUASSERTE(uint64_t, noisy.size(), scanner.getOffset());
+   }
+   TURETURN();
+}
+
+
+unsigned BinexScanner_T ::
+fileTest()
+{
+   TUDEF("BinexScanner", "BinexScanner(filename)");
+   string fn = getPathTestTemp() + getFileSep() + "BinexScanner_T.bnx";
+   {
+      ofstream ofs(fn.c_str(), ios::out | ios::binary);
+      ofs.write(bytes.data(), bytes.size());
+   }
+   {
+      BinexScanner scanner(fn);
+      checkAll(testFramework, scanner);
+   }
+   {
+         // small blocks, so records straddle reads and grow the buffer
+      BinexScanner scanner(fn, false, 64);
+      TUASSERT(!scanner.isMapped());
+      checkAll(testFramework, scanner);
+      TUASSERTE(uint64_t, bytes.size(), scanner.getOffset());
+   }
+   {
+      BinexScanner scanner(fn, false, 64);
+      scanner.select(0x01);
+      BinexScanner::Record rec;
+      while (scanner.next(rec))
+      {
+         TUASSERTE(BinexData::RecordID, 0x01, rec.recID);
+      }
+   }
+   TUTHROW(BinexScanner scanner(fn + ".missing"));
+   remove(fn.c_str());
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   BinexScanner_T testClass;
+
+   errorTotal += testClass.scanBufferTest();
+   errorTotal += testClass.extractTest();
+   errorTotal += testClass.selectTest();
+   errorTotal += testClass.badDataTest();
+   errorTotal += testClass.fileTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
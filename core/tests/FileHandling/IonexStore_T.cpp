@@ -0,0 +1,372 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include "IonexStore.hpp"
+#include "IonexStream.hpp"
+#include "YDSTime.hpp"
+#include "TestUtil.hpp"
+#include "build_config.h"
+
+using namespace std;
+
+class IonexStore_T
+{
+public:
+   IonexStore_T();
+      /// Check getIonexValue against analytically known maps
+   unsigned getIonexValueTest();
+      /// Check that the batch getIonexValue matches the single version
+   unsigned getIonexValueBatchTest();
+      /// Check getIonexValue with unevenly spaced epochs
+   unsigned unevenEpochTest();
+      /// Check the handling of undefined grid values and bad requests
+   unsigned errorTest();
+      /// Check that loading maps on demand gives the same values
+   unsigned lazyLoadTest();
+
+      /** Write a file of TEC maps every two hours for day \a day
+       * after t0, with map number k at 2k hours after t0.
+       * @return the file name. */
+   std::string writeDay(int day);
+
+      /// TEC value used to fill the grid for map number k.
+   static double tecFn(double lat, double lon, int k)
+   { return (k+1) * (20.0 + 0.1*lat + 0.02*(lon+180.0)); }
+
+      /// Build a global 2.5x5 degree map of type at hour.
+   static gnsstk::IonexData makeMap(const gnsstk::IonexData::IonexValType& t,
+                                   double hour, int k);
+
+      /// Make a pierce point at lat/lon degrees.
+   static gnsstk::Position ipp(double lat, double lon);
+
+   gnsstk::CommonTime t0;
+};
+
+
+IonexStore_T ::
+IonexStore_T()
+      : t0(gnsstk::YDSTime(2020, 268, 0.0))
+{
+}
+
+
+gnsstk::IonexData IonexStore_T ::
+makeMap(const gnsstk::IonexData::IonexValType& t, double hour, int k)
+{
+   gnsstk::IonexData iod;
+   iod.mapID = k+1;
+   iod.type = t;
+   iod.time = gnsstk::YDSTime(2020, 268, hour*3600.0);
+   iod.exponent = -1;
+   iod.lat[0] = 87.5;
+   iod.lat[1] = -87.5;
+   iod.lat[2] = -2.5;
+   iod.lon[0] = -180.0;
+   iod.lon[1] = 180.0;
+   iod.lon[2] = 5.0;
+   iod.hgt[0] = 450.0;
+   iod.hgt[1] = 450.0;
+   iod.hgt[2] = 0.0;
+   iod.dim[0] = 71;
+   iod.dim[1] = 73;
+   iod.dim[2] = 1;
+   iod.data.resize(71*73);
+   for (int i = 0; i < 71; i++)
+   {
+      for (int j = 0; j < 73; j++)
+      {
+         double v = tecFn(87.5 - 2.5*i, -180.0 + 5.0*j, k);
+            // RMS maps are a tenth of the TEC maps
+         iod.data[i*73+j] = (t == gnsstk::IonexData::RMS) ? 0.1*v : v;
+      }
+   }
+   iod.valid = true;
+   return iod;
+}
+
+
+gnsstk::Position IonexStore_T ::
+ipp(double lat, double lon)
+{
+   return gnsstk::Position(lat, lon, 6378137.0+450e3,
+                           gnsstk::Position::Geocentric);
+}
+
+
+unsigned IonexStore_T ::
+getIonexValueTest()
+{
+   TUDEF("IonexStore", "getIonexValue");
+   gnsstk::IonexStore store;
+   for (int k = 0; k < 3; k++)
+   {
+      store.addMap(makeMap(gnsstk::IonexData::TEC, 2.0*k, k));
+      store.addMap(makeMap(gnsstk::IonexData::RMS, 2.0*k, k));
+   }
+   TUASSERTE(gnsstk::CommonTime, t0, store.getInitialTime());
+   gnsstk::Triple v;
+   double lat = 41.3, lon = 12.7;
+      // the maps are linear in latitude and longitude so bilinear
+      // interpolation is exact up to float storage
+   TUCATCH(v = store.getIonexValue(t0+3600.0, ipp(lat, lon),
+                                   gnsstk::IonexStoreStrategy::Consecutive));
+   double expect = 0.5*(tecFn(lat, lon, 0) + tecFn(lat, lon, 1));
+   TUASSERTFEPS(expect, v[0], 1e-4);
+   TUASSERTFEPS(0.1*expect, v[1], 1e-5);
+   TUASSERTFE(6378137.0+450e3, v[2]);
+      // nearest map
+   TUCATCH(v = store.getIonexValue(t0+5000.0, ipp(lat, lon),
+                                   gnsstk::IonexStoreStrategy::Nearest));
+   TUASSERTFEPS(tecFn(lat, lon, 1), v[0], 1e-4);
+      // the final epoch
+   TUCATCH(v = store.getIonexValue(t0+4*3600.0, ipp(lat, lon),
+                                   gnsstk::IonexStoreStrategy::Consecutive));
+   TUASSERTFEPS(tecFn(lat, lon, 2), v[0], 1e-4);
+      // each map is rotated by the time from its epoch
+   TUCATCH(v = store.getIonexValue(t0+3600.0, ipp(lat, lon),
+                                   gnsstk::IonexStoreStrategy::ConsRot));
+   expect = 0.5*(tecFn(lat, lon+15.0, 0) + tecFn(lat, lon-15.0, 1));
+   TUASSERTFEPS(expect, v[0], 1e-4);
+      // rotating across the date line wraps around the grid
+   TUCATCH(v = store.getIonexValue(t0+1800.0, ipp(lat, 177.0),
+                                   gnsstk::IonexStoreStrategy::Rotated));
+   TUASSERTFEPS(tecFn(lat, -175.5, 0), v[0], 1e-4);
+   TURETURN();
+}
+
+
+unsigned IonexStore_T ::
+getIonexValueBatchTest()
+{
+   TUDEF("IonexStore", "getIonexValue(batch)");
+   gnsstk::IonexStore store;
+   for (int k = 0; k < 3; k++)
+   {
+      store.addMap(makeMap(gnsstk::IonexData::TEC, 2.0*k, k));
+      store.addMap(makeMap(gnsstk::IonexData::RMS, 2.0*k, k));
+   }
+   std::vector<gnsstk::Position> pts;
+   for (double lat = -85.0; lat <= 85.0; lat += 7.3)
+   {
+      for (double lon = 0.0; lon < 360.0; lon += 11.1)
+      {
+         pts.push_back(ipp(lat, lon));
+      }
+   }
+   gnsstk::CommonTime t(t0+9876.5);
+   for (gnsstk::IonexStoreStrategy s : gnsstk::IonexStoreStrategyIterator())
+   {
+      if (s == gnsstk::IonexStoreStrategy::Unknown)
+      {
+         continue;
+      }
+      std::vector<gnsstk::Triple> values;
+      TUCATCH(store.getIonexValue(t, pts, values, s));
+      TUASSERTE(size_t, pts.size(), values.size());
+      for (size_t i = 0; i < pts.size(); i++)
+      {
+         gnsstk::Triple v = store.getIonexValue(t, pts[i], s);
+         TUASSERTFE(v[0], values[i][0]);
+         TUASSERTFE(v[1], values[i][1]);
+         TUASSERTFE(v[2], values[i][2]);
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned IonexStore_T ::
+unevenEpochTest()
+{
+   TUDEF("IonexStore", "getIonexValue");
+   gnsstk::IonexStore store;
+      // added out of order, and with a gap
+   store.addMap(makeMap(gnsstk::IonexData::TEC, 2.0, 1));
+   store.addMap(makeMap(gnsstk::IonexData::TEC, 0.0, 0));
+   store.addMap(makeMap(gnsstk::IonexData::TEC, 5.0, 2));
+   double lat = -33.3, lon = 151.2;
+   gnsstk::Triple v;
+   TUCATCH(v = store.getIonexValue(t0+4*3600.0, ipp(lat, lon),
+                                   gnsstk::IonexStoreStrategy::Consecutive));
+   double expect = (tecFn(lat, lon, 1) + 2.0*tecFn(lat, lon, 2)) / 3.0;
+   TUASSERTFEPS(expect, v[0], 1e-4);
+      // no RMS maps were loaded
+   TUASSERTFE(0.0, v[1]);
+   TUCATCH(v = store.getIonexValue(t0+1800.0, ipp(lat, lon),
+                                   gnsstk::IonexStoreStrategy::Consecutive));
+   expect = 0.75*tecFn(lat, lon, 0) + 0.25*tecFn(lat, lon, 1);
+   TUASSERTFEPS(expect, v[0], 1e-4);
+   TURETURN();
+}
+
+
+unsigned IonexStore_T ::
+errorTest()
+{
+   TUDEF("IonexStore", "getIonexValue");
+   gnsstk::IonexStore store;
+   gnsstk::IonexData iod(makeMap(gnsstk::IonexData::TEC, 0.0, 0));
+      // undefined value at the grid point (40N, 10E)
+   iod.data[19*73+38] = 999.9;
+   store.addMap(iod);
+   store.addMap(makeMap(gnsstk::IonexData::TEC, 2.0, 1));
+   TUTHROW(store.getIonexValue(t0+60.0, ipp(41.0, 11.0),
+                               gnsstk::IonexStoreStrategy::Consecutive));
+   TUCATCH(store.getIonexValue(t0+60.0, ipp(-41.0, 11.0),
+                               gnsstk::IonexStoreStrategy::Consecutive));
+      // outside the time span or grid
+   TUTHROW(store.getIonexValue(t0-60.0, ipp(-41.0, 11.0),
+                               gnsstk::IonexStoreStrategy::Consecutive));
+   TUTHROW(store.getIonexValue(t0+7300.0, ipp(-41.0, 11.0),
+                               gnsstk::IonexStoreStrategy::Consecutive));
+   TUTHROW(store.getIonexValue(t0+60.0, ipp(89.0, 11.0),
+                               gnsstk::IonexStoreStrategy::Consecutive));
+   TUTHROW(store.getIonexValue(t0+60.0, ipp(-41.0, 11.0),
+                               gnsstk::IonexStoreStrategy::Unknown));
+   TURETURN();
+}
+
+
+std::string IonexStore_T ::
+writeDay(int day)
+{
+   std::string fn = gnsstk::getPathTestTemp() + gnsstk::getFileSep() +
+      "test_output_IonexStore_" + gnsstk::StringUtils::asString(day) +
+      ".inx";
+   gnsstk::IonexHeader hdr;
+   hdr.version = 1.0;
+   hdr.fileType = "I";
+   hdr.system = "GPS";
+   hdr.fileProgram = "IonexStore_T";
+   hdr.fileAgency = "ARL:UT";
+   hdr.date = "2020-09-24";
+   hdr.firstEpoch = t0 + day*86400.0;
+   hdr.lastEpoch = t0 + (day+1)*86400.0;
+   hdr.interval = 7200;
+   hdr.numMaps = 13;
+   hdr.mappingFunction = "NONE";
+   hdr.elevation = 0.0;
+   hdr.baseRadius = 6371.0;
+   hdr.mapDims = 2;
+   hdr.hgt[0] = hdr.hgt[1] = 450.0;
+   hdr.hgt[2] = 0.0;
+   hdr.lat[0] = 87.5;
+   hdr.lat[1] = -87.5;
+   hdr.lat[2] = -2.5;
+   hdr.lon[0] = -180.0;
+   hdr.lon[1] = 180.0;
+   hdr.lon[2] = 5.0;
+   hdr.exponent = -1;
+   hdr.valid = true;
+   gnsstk::IonexStream strm(fn.c_str(), std::ios::out);
+   strm << hdr;
+   for (int i = 0; i < 13; i++)
+   {
+      int k = day*12 + i;
+      gnsstk::IonexData iod(makeMap(gnsstk::IonexData::TEC, 0.0, k));
+      iod.time = t0 + k*7200.0;
+      strm << iod;
+   }
+   return fn;
+}
+
+
+unsigned IonexStore_T ::
+lazyLoadTest()
+{
+   TUDEF("IonexStore", "setLazyLoad");
+   gnsstk::IonexStore eager, lazy;
+   lazy.setLazyLoad(true);
+   lazy.setMaxLoaded(1);
+   TUASSERT(lazy.getLazyLoad());
+   std::vector<std::string> files;
+   for (int day = 0; day < 4; day++)
+   {
+      files.push_back(writeDay(day));
+      TUCATCH(eager.loadFile(files.back()));
+      TUCATCH(lazy.loadFile(files.back()));
+   }
+   TUASSERTE(unsigned, 0, lazy.nloaded());
+   TUASSERTE(gnsstk::CommonTime, eager.getInitialTime(),
+             lazy.getInitialTime());
+   TUASSERTE(gnsstk::CommonTime, eager.getFinalTime(), lazy.getFinalTime());
+   const double hours[] = { 1.0, 50.0, 30.5, 95.9, 0.0, 48.0, 23.5, 72.0,
+                            96.0, 47.0 };
+   gnsstk::Position pt(ipp(-33.3, 151.2));
+   for (double h : hours)
+   {
+      gnsstk::Triple ev, lv;
+      TUCATCH(ev = eager.getIonexValue(t0 + h*3600.0, pt));
+      TUCATCH(lv = lazy.getIonexValue(t0 + h*3600.0, pt));
+      TUASSERTFE(ev[0], lv[0]);
+         // only the files needed for one time are kept
+      TUASSERT(lazy.nloaded() <= 2);
+   }
+      // 24:00 on a day is covered by two files, which are both kept
+   TUCATCH(lazy.getIonexValue(t0 + 48.0*3600.0, pt));
+   TUASSERTE(unsigned, 2, lazy.nloaded());
+   TUCATCH(lazy.getIonexValue(t0 + 60.0*3600.0, pt));
+   TUASSERTE(unsigned, 1, lazy.nloaded());
+   TUTHROW(lazy.getIonexValue(t0 + 97.0*3600.0, pt));
+   lazy.clear();
+   TUASSERTE(unsigned, 0, lazy.nfiles());
+   for (const auto& fn : files)
+   {
+      std::remove(fn.c_str());
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   IonexStore_T testClass;
+
+   errorTotal += testClass.getIonexValueTest();
+   errorTotal += testClass.getIonexValueBatchTest();
+   errorTotal += testClass.unevenEpochTest();
+   errorTotal += testClass.errorTest();
+   errorTotal += testClass.lazyLoadTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
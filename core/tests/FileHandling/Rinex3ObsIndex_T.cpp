@@ -0,0 +1,461 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+#include <cstdio>
+#include <fstream>
+#ifndef WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "Rinex3ObsIndex.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "CivilTime.hpp"
+#include "StringUtils.hpp"
+#include "TestUtil.hpp"
+#include "build_config.h"
+
+using namespace std;
+
+class Rinex3ObsIndex_T
+{
+public:
+   Rinex3ObsIndex_T();
+
+   unsigned buildTest();
+   unsigned seekTest();
+   unsigned saveLoadTest();
+   unsigned readTest();
+   unsigned ver2Test();
+   unsigned previousTimeTest();
+
+      /** Write a GPS observation file with numEpochs 1 s epochs and
+       * an auxiliary comment record with no time after epoch
+       * auxAfter.
+       * @return the file name. */
+   std::string writeFile(const std::string& name, double version,
+                         int numEpochs, int auxAfter);
+
+      /// Return true if two records hold the same data.
+   static bool sameRecord(const gnsstk::Rinex3ObsData& a,
+                          const gnsstk::Rinex3ObsData& b);
+
+      /// Read every record of fn with a stream.
+   static std::vector<gnsstk::Rinex3ObsData> readAll(const std::string& fn);
+
+   gnsstk::CommonTime t0;
+   std::string fn3, fn2;
+};
+
+
+Rinex3ObsIndex_T ::
+Rinex3ObsIndex_T()
+      : t0(gnsstk::CivilTime(2016, 10, 2, 11, 15, 30.0,
+                             gnsstk::TimeSystem::GPS))
+{
+   fn3 = writeFile("test_output_Rinex3ObsIndex_302.16o", 3.02, 600, 299);
+   fn2 = writeFile("test_output_Rinex3ObsIndex_211.16o", 2.11, 300, 149);
+}
+
+
+std::string Rinex3ObsIndex_T ::
+writeFile(const std::string& name, double version, int numEpochs,
+          int auxAfter)
+{
+   using gnsstk::Rinex3ObsHeader;
+   std::string fn = gnsstk::getPathTestTemp() + gnsstk::getFileSep() + name;
+   Rinex3ObsHeader hdr;
+   hdr.fileProgram = "Rinex3ObsIndex_T";
+   hdr.fileSysSat.system = gnsstk::SatelliteSystem::GPS;
+   hdr.date = "20161002 120000 UTC";
+   hdr.fileAgency = "ARL:UT";
+   hdr.valid |= Rinex3ObsHeader::validRunBy;
+   hdr.markerName = "TEST";
+   hdr.valid |= Rinex3ObsHeader::validMarkerName;
+   hdr.observer = "Observer";
+   hdr.agency = "ARL:UT";
+   hdr.valid |= Rinex3ObsHeader::validObserver;
+   hdr.recNo = "1";
+   hdr.recType = "Receiver";
+   hdr.recVers = "1.0";
+   hdr.valid |= Rinex3ObsHeader::validReceiver;
+   hdr.antNo = "1";
+   hdr.antType = "Antenna";
+   hdr.valid |= Rinex3ObsHeader::validAntennaType;
+   hdr.antennaPosition = gnsstk::Triple(-740289.9, -5457071.7, 3207245.6);
+   hdr.valid |= Rinex3ObsHeader::validAntennaPosition;
+   hdr.antennaDeltaHEN = gnsstk::Triple(0, 0, 0);
+   hdr.valid |= Rinex3ObsHeader::validAntennaDeltaHEN;
+   hdr.firstObs = t0;
+   hdr.valid |= Rinex3ObsHeader::validFirstTime;
+   hdr.interval = 1;
+   hdr.valid |= Rinex3ObsHeader::validInterval;
+   hdr.valid |= Rinex3ObsHeader::validSystemPhaseShift;
+   std::vector<gnsstk::RinexObsID> types;
+   types.push_back(gnsstk::RinexObsID("GC1C", version));
+   types.push_back(gnsstk::RinexObsID("GL1C", version));
+   hdr.mapObsTypes["G"] = types;
+   hdr.valid |= Rinex3ObsHeader::validNumObs;
+   hdr.valid |= Rinex3ObsHeader::validSystemNumObs;
+   hdr.validEoH = true;
+   hdr.version = 3.02;
+   hdr.valid |= Rinex3ObsHeader::validVersion;
+   if (version < 3)
+   {
+      hdr.prepareVer2Write();
+   }
+
+   gnsstk::Rinex3ObsStream strm(fn, std::ios::out | std::ios::trunc);
+   strm.exceptions(std::ios::failbit);
+   strm << hdr;
+   for (int i = 0; i < numEpochs; i++)
+   {
+      gnsstk::Rinex3ObsData rod;
+      rod.time = t0 + double(i);
+      rod.epochFlag = 0;
+      for (int prn = 1 + i % 3; prn <= 12; prn += 3)
+      {
+         std::vector<gnsstk::RinexDatum> data(2);
+         data[0].data = 2.0e7 + prn * 1000.0 + i;
+         data[1].data = 1.0e8 + prn * 1000.0 + i * 0.5;
+         rod.obs[gnsstk::RinexSatID(prn, gnsstk::SatelliteSystem::GPS)] =
+            data;
+      }
+      rod.numSVs = rod.obs.size();
+      strm << rod;
+      if (i == auxAfter)
+      {
+            // write the record by hand, as the RINEX 2 writer doesn't
+            // write epoch lines with no time
+         if (version < 3)
+            strm << std::string(28, ' ') << "4  1" << std::endl;
+         else
+            strm << ">" << std::string(30, ' ') << "4  1" << std::endl;
+         strm << gnsstk::StringUtils::leftJustify("auxiliary comment", 60)
+              << "COMMENT" << std::endl;
+      }
+   }
+   return fn;
+}
+
+
+bool Rinex3ObsIndex_T ::
+sameRecord(const gnsstk::Rinex3ObsData& a, const gnsstk::Rinex3ObsData& b)
+{
+   if ((a.time != b.time) || (a.epochFlag != b.epochFlag) ||
+       (a.numSVs != b.numSVs) || (a.obs.size() != b.obs.size()))
+   {
+      return false;
+   }
+   for (const auto& i : a.obs)
+   {
+      auto j = b.obs.find(i.first);
+      if ((j == b.obs.end()) || (j->second.size() != i.second.size()))
+         return false;
+      for (size_t k = 0; k < i.second.size(); k++)
+      {
+         if (i.second[k].data != j->second[k].data)
+            return false;
+      }
+   }
+   return true;
+}
+
+
+std::vector<gnsstk::Rinex3ObsData> Rinex3ObsIndex_T ::
+readAll(const std::string& fn)
+{
+   std::vector<gnsstk::Rinex3ObsData> rv;
+   gnsstk::Rinex3ObsStream strm(fn);
+   gnsstk::Rinex3ObsHeader hdr;
+   gnsstk::Rinex3ObsData rod;
+   strm >> hdr;
+   while (strm >> rod)
+   {
+      rv.push_back(rod);
+   }
+   return rv;
+}
+
+
+unsigned Rinex3ObsIndex_T ::
+buildTest()
+{
+   TUDEF("Rinex3ObsIndex", "build");
+   gnsstk::Rinex3ObsIndex index;
+   TUCATCH(index.build(fn3));
+      // 600 epochs and one auxiliary record
+   TUASSERTE(size_t, 601, index.size());
+   TUASSERTE(std::string, fn3, index.getFileName());
+   TUASSERT(index.isCurrent());
+   const gnsstk::Rinex3ObsIndex::EntryList& entries(index.getEntries());
+   TUASSERTE(gnsstk::CommonTime, t0, entries.front().time);
+   TUASSERTE(gnsstk::CommonTime, t0 + 599.0, entries.back().time);
+      // the auxiliary record gets the time of the record before it
+   TUASSERTE(gnsstk::CommonTime, t0 + 299.0, entries[300].time);
+   TUASSERTE(gnsstk::CommonTime, t0 + 300.0, entries[301].time);
+   bool sorted = true;
+   for (size_t i = 1; i < entries.size(); i++)
+   {
+      sorted &= (entries[i-1].time <= entries[i].time);
+      sorted &= (entries[i-1].offset < entries[i].offset);
+   }
+   TUASSERT(sorted);
+      // each offset is the start of an epoch line
+   std::ifstream in(fn3.c_str());
+   std::string line;
+   in.seekg(entries[450].offset);
+   std::getline(in, line);
+   TUASSERTE(std::string, "> 2016 10 02 11 22 59", line.substr(0, 21));
+   TUASSERTE(size_t, 0, index.find(gnsstk::CommonTime::BEGINNING_OF_TIME));
+   TUASSERTE(size_t, 0, index.find(t0));
+   TUASSERTE(size_t, 2, index.find(t0 + 1.5));
+   TUASSERTE(size_t, 299, index.find(t0 + 299.0));
+   TUASSERTE(size_t, 301, index.find(t0 + 299.5));
+   TUASSERTE(size_t, 601, index.find(t0 + 600.0));
+   TUTHROW(index.build(fn3 + ".missing"));
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsIndex_T ::
+seekTest()
+{
+   TUDEF("Rinex3ObsStream", "seekTime");
+   gnsstk::Rinex3ObsIndex index;
+   TUCATCH(index.build(fn3));
+   std::vector<gnsstk::Rinex3ObsData> all = readAll(fn3);
+   TUASSERTE(size_t, 601, all.size());
+   gnsstk::Rinex3ObsStream strm(fn3);
+   gnsstk::Rinex3ObsData rod;
+   TUASSERT(strm.seekTime(index, t0 + 250.0));
+   TUASSERT(static_cast<bool>(strm >> rod));
+   TUASSERT(sameRecord(all[250], rod));
+      // reading continues normally from there, through the
+      // auxiliary record
+   bool same = true;
+   for (size_t i = 251; i < 320; i++)
+   {
+      same &= static_cast<bool>(strm >> rod) && sameRecord(all[i], rod);
+   }
+   TUASSERT(same);
+   TUASSERTE(int, 4, all[300].epochFlag);
+      // seek backwards
+   TUASSERT(strm.seekTime(index, t0 + 10.2));
+   TUASSERT(static_cast<bool>(strm >> rod));
+   TUASSERT(sameRecord(all[11], rod));
+   TUASSERTE(unsigned, index.getEntries()[12].lineNumber, strm.lineNumber);
+      // nothing after the last epoch
+   TUASSERT(!strm.seekTime(index, t0 + 1000.0));
+   TUASSERT(!(strm >> rod));
+   TUASSERT(strm.seekTime(index, t0 + 599.0));
+   TUASSERT(static_cast<bool>(strm >> rod));
+   TUASSERT(sameRecord(all[600], rod));
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsIndex_T ::
+saveLoadTest()
+{
+   TUDEF("Rinex3ObsIndex", "loadOrBuild");
+   std::string idxName = gnsstk::Rinex3ObsIndex::getIndexName(fn3);
+   std::remove(idxName.c_str());
+   gnsstk::Rinex3ObsIndex built, loaded, saved;
+   TUASSERTE(bool, false, built.loadOrBuild(fn3));
+   TUASSERTE(bool, true, loaded.loadOrBuild(fn3));
+   TUASSERTE(size_t, built.size(), loaded.size());
+   bool same = true;
+   for (size_t i = 0; i < built.size(); i++)
+   {
+      const gnsstk::Rinex3ObsIndex::Entry& a(built.getEntries()[i]);
+      const gnsstk::Rinex3ObsIndex::Entry& b(loaded.getEntries()[i]);
+      same &= ((a.time == b.time) && (a.offset == b.offset) &&
+               (a.lineNumber == b.lineNumber));
+   }
+   TUASSERT(same);
+   TUASSERT(loaded.isCurrent());
+   TUASSERTE(gnsstk::TimeSystem, gnsstk::TimeSystem::GPS,
+             loaded.getEntries()[0].time.getTimeSystem());
+      // explicit save and load
+   std::string otherName = idxName + "2";
+   TUCATCH(built.save(otherName));
+   TUCATCH(saved.load(otherName));
+   TUASSERTE(size_t, built.size(), saved.size());
+   TUASSERTE(std::string, fn3, saved.getFileName());
+   TUTHROW(saved.load(fn3));
+   TUASSERTE(size_t, built.size(), saved.size());
+      // a damaged index is rebuilt
+   {
+      std::ofstream out(idxName.c_str());
+      out << "Rinex3ObsIndex 1" << std::endl << fn3 << std::endl
+          << "garbage" << std::endl;
+   }
+   TUASSERTE(bool, false, loaded.loadOrBuild(fn3));
+   TUASSERTE(size_t, built.size(), loaded.size());
+   TUASSERTE(bool, true, loaded.loadOrBuild(fn3));
+      // as is one whose entry count can't be right
+   {
+      std::ofstream out(idxName.c_str());
+      out << "Rinex3ObsIndex 1" << std::endl << fn3 << std::endl
+          << "1 1 1000000000000000000 2" << std::endl
+          << "0 0 0 0 0" << std::endl;
+   }
+   TUTHROW(saved.load(idxName));
+   TUASSERTE(size_t, built.size(), saved.size());
+   TUASSERTE(bool, false, loaded.loadOrBuild(fn3));
+   TUASSERTE(size_t, built.size(), loaded.size());
+   std::remove(idxName.c_str());
+#ifndef WIN32
+      // failing to save the index isn't an error
+   TUASSERTE(int, 0, mkdir(idxName.c_str(), 0755));
+   TUASSERTE(bool, false, loaded.loadOrBuild(fn3));
+   TUASSERTE(size_t, built.size(), loaded.size());
+   TUASSERTE(bool, false, loaded.loadOrBuild(fn3, false));
+   rmdir(idxName.c_str());
+#endif
+   std::remove(otherName.c_str());
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsIndex_T ::
+readTest()
+{
+   TUDEF("Rinex3ObsIndex", "read");
+   gnsstk::Rinex3ObsIndex index;
+   TUCATCH(index.build(fn3));
+   std::vector<gnsstk::Rinex3ObsData> all = readAll(fn3), data;
+   for (unsigned nthreads : {1, 4})
+   {
+      TUCATCH(index.read(data, gnsstk::CommonTime::BEGINNING_OF_TIME,
+                         gnsstk::CommonTime::END_OF_TIME, nthreads));
+      TUASSERTE(size_t, all.size(), data.size());
+      bool same = (all.size() == data.size());
+      for (size_t i = 0; same && (i < all.size()); i++)
+      {
+         same = sameRecord(all[i], data[i]);
+      }
+      TUASSERT(same);
+   }
+      // a window, which includes the auxiliary record
+   TUCATCH(index.read(data, t0 + 250.0, t0 + 350.0, 3));
+   TUASSERTE(size_t, 101, data.size());
+   bool same = (data.size() == 101);
+   for (size_t i = 0; same && (i < data.size()); i++)
+   {
+      same = sameRecord(all[250+i], data[i]);
+   }
+   TUASSERT(same);
+   TUCATCH(index.read(data, t0 + 1000.0, t0 + 2000.0));
+   TUASSERTE(size_t, 0, data.size());
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsIndex_T ::
+ver2Test()
+{
+   TUDEF("Rinex3ObsIndex", "build");
+   gnsstk::Rinex3ObsIndex index;
+   TUCATCH(index.build(fn2));
+   TUASSERTE(size_t, 301, index.size());
+   std::vector<gnsstk::Rinex3ObsData> all = readAll(fn2), data;
+   TUASSERTE(size_t, 301, all.size());
+   TUASSERTE(gnsstk::CommonTime, t0 + 149.0, index.getEntries()[150].time);
+   TUCATCH(index.read(data, gnsstk::CommonTime::BEGINNING_OF_TIME,
+                      gnsstk::CommonTime::END_OF_TIME, 4));
+   bool same = (all.size() == data.size());
+   for (size_t i = 0; same && (i < all.size()); i++)
+   {
+      same = sameRecord(all[i], data[i]);
+   }
+   TUASSERT(same);
+      // the auxiliary record gets the time of the record before it,
+      // even when that record was skipped by seeking
+   gnsstk::Rinex3ObsStream strm(fn2);
+   gnsstk::Rinex3ObsData rod;
+   TUCATCH(strm.seekRecord(index, 150));
+   TUASSERT(static_cast<bool>(strm >> rod));
+   TUASSERTE(int, 4, rod.epochFlag);
+   TUASSERTE(gnsstk::CommonTime, t0 + 149.0, rod.time);
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsIndex_T ::
+previousTimeTest()
+{
+   TUDEF("Rinex3ObsData", "getRecord");
+      // The time for RINEX 2 records with no time comes from the
+      // stream that read them, not from whatever stream was read
+      // last.
+   gnsstk::Rinex3ObsStream strmA(fn2), strmB(fn2);
+   gnsstk::Rinex3ObsHeader hdr;
+   gnsstk::Rinex3ObsData rod;
+   strmA >> hdr;
+   strmB >> hdr;
+   for (int i = 0; i < 150; i++)
+   {
+      strmA >> rod;
+   }
+   TUASSERTE(gnsstk::CommonTime, t0 + 149.0, rod.time);
+   strmB >> rod;
+   TUASSERTE(gnsstk::CommonTime, t0, rod.time);
+   TUASSERT(static_cast<bool>(strmA >> rod));
+   TUASSERTE(int, 4, rod.epochFlag);
+   TUASSERTE(gnsstk::CommonTime, t0 + 149.0, rod.time);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   Rinex3ObsIndex_T testClass;
+
+   errorTotal += testClass.buildTest();
+   errorTotal += testClass.seekTest();
+   errorTotal += testClass.saveLoadTest();
+   errorTotal += testClass.readTest();
+   errorTotal += testClass.ver2Test();
+   errorTotal += testClass.previousTimeTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
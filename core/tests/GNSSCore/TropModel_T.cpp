@@ -37,17 +37,188 @@
 //==============================================================================
 
 #include "TestUtil.hpp"
+#include "GlobalTropModel.hpp"
+#include "NeillTropModel.hpp"
+#include "GCATTropModel.hpp"
+#include "SaasTropModel.hpp"
+#include "YDSTime.hpp"
 #include <iostream>
+#include <vector>
 
 class TropModel_T
 {
-        public:
-		TropModel_T(){}// Default Constructor, set the precision value
-		~TropModel_T() {} // Default Desructor
+public:
+   TropModel_T();
+
+      /// Check the GlobalTropModel batch against the scalar interface
+   unsigned globalComponentsTest();
+      /// Check the NeillTropModel batch against the scalar interface
+   unsigned neillComponentsTest();
+      /// Check the GCATTropModel batch against the scalar interface
+   unsigned gcatComponentsTest();
+      /// Check the default TropModel batch against the scalar interface
+   unsigned defaultComponentsTest();
+
+      /** Receiver positions, elevations and times for a batch of
+       * observations grouped by station and time, with several
+       * elevations each. */
+   std::vector<gnsstk::Position> rx;
+   std::vector<double> elev;
+   std::vector<gnsstk::CommonTime> tt;
 };
 
 
-int main() //Main function to initialize and run all tests above
+TropModel_T ::
+TropModel_T()
+{
+   const double stations[4][3] = { { 40.0, 255.0, 1600.0 },
+                                   { -33.9, 18.4, 30.0 },
+                                   { 78.2, 15.6, 450.0 },
+                                   { 5.0, 280.0, 10.0 } };
+   const double elevations[6] = { -5.0, 2.0, 4.0, 15.0, 45.0, 89.0 };
+   gnsstk::CommonTime times[2] = { gnsstk::YDSTime(2021, 12, 3600.0),
+                                   gnsstk::YDSTime(2021, 200, 43200.0) };
+   for (int t = 0; t < 2; t++)
+   {
+      for (int s = 0; s < 4; s++)
+      {
+         gnsstk::Position p(stations[s][0], stations[s][1], stations[s][2],
+                            gnsstk::Position::Geodetic);
+         p.transformTo(gnsstk::Position::Cartesian);
+         for (int e = 0; e < 6; e++)
+         {
+            rx.push_back(p);
+            elev.push_back(elevations[e]);
+            tt.push_back(times[t]);
+         }
+      }
+   }
+}
+
+
+unsigned TropModel_T ::
+globalComponentsTest()
+{
+   TUDEF("GlobalTropModel", "getComponents");
+   gnsstk::GlobalTropModel batch, scalar;
+   batch.setHumidity(70.0);
+   scalar.setHumidity(70.0);
+   std::vector<gnsstk::TropModel::Components> comps;
+      // twice, to use the station cache the second time
+   for (int pass = 0; pass < 2; pass++)
+   {
+      TUCATCH(batch.getComponents(rx, elev, tt, comps));
+      TUASSERTE(size_t, elev.size(), comps.size());
+      for (size_t i = 0; i < elev.size(); i++)
+      {
+         scalar.setParameters(tt[i], rx[i]);
+         TUASSERTFE(scalar.dry_zenith_delay(), comps[i].dryZenith);
+         TUASSERTFE(scalar.wet_zenith_delay(), comps[i].wetZenith);
+         TUASSERTFE(scalar.correction(elev[i]), comps[i].delay());
+         if (elev[i] >= 0.0)
+         {
+            TUASSERTFE(scalar.dry_mapping_function(elev[i]),
+                       comps[i].dryMap);
+            TUASSERTFE(scalar.wet_mapping_function(elev[i]),
+                       comps[i].wetMap);
+         }
+      }
+   }
+      // single receiver and time for the whole batch
+   std::vector<gnsstk::Position> rx1(1, rx[30]);
+   std::vector<gnsstk::CommonTime> tt1(1, tt[30]);
+   TUCATCH(batch.getComponents(rx1, elev, tt1, comps));
+   scalar.setParameters(tt[30], rx[30]);
+   for (size_t i = 0; i < elev.size(); i++)
+   {
+      TUASSERTFE(scalar.correction(elev[i]), comps[i].delay());
+   }
+      // the batch does not set up the model's own receiver and time
+   TUASSERT(!batch.isValid());
+   std::vector<gnsstk::CommonTime> tt2(2, tt[0]);
+   TUTHROW(batch.getComponents(rx, elev, tt2, comps));
+   TURETURN();
+}
+
+
+unsigned TropModel_T ::
+neillComponentsTest()
+{
+   TUDEF("NeillTropModel", "getComponents");
+   gnsstk::NeillTropModel batch, scalar;
+   std::vector<gnsstk::TropModel::Components> comps;
+   TUCATCH(batch.getComponents(rx, elev, tt, comps));
+   TUASSERTE(size_t, elev.size(), comps.size());
+   for (size_t i = 0; i < elev.size(); i++)
+   {
+      scalar.setAllParameters(tt[i], rx[i]);
+      TUASSERTFE(scalar.dry_zenith_delay(), comps[i].dryZenith);
+      TUASSERTFE(scalar.wet_zenith_delay(), comps[i].wetZenith);
+      TUASSERTFE(scalar.correction(elev[i]), comps[i].delay());
+      if (elev[i] >= 0.0)
+      {
+         TUASSERTFE(scalar.dry_mapping_function(elev[i]), comps[i].dryMap);
+         TUASSERTFE(scalar.wet_mapping_function(elev[i]), comps[i].wetMap);
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned TropModel_T ::
+gcatComponentsTest()
+{
+   TUDEF("GCATTropModel", "getComponents");
+   gnsstk::GCATTropModel batch, scalar;
+   std::vector<gnsstk::TropModel::Components> comps;
+   TUCATCH(batch.getComponents(rx, elev, tt, comps));
+   TUASSERTE(size_t, elev.size(), comps.size());
+   for (size_t i = 0; i < elev.size(); i++)
+   {
+      scalar.setReceiverHeight(rx[i].getAltitude());
+         // correction() sums the zenith delays before mapping
+      TUASSERTFEPS(scalar.correction(elev[i]), comps[i].delay(), 1e-12);
+      if (elev[i] >= 0.0)
+      {
+         TUASSERTFE(scalar.dry_mapping_function(elev[i]), comps[i].dryMap);
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned TropModel_T ::
+defaultComponentsTest()
 {
-	return 0; //Return the total number of errors
+   TUDEF("TropModel", "getComponents");
+   gnsstk::SaasTropModel batch, scalar;
+   batch.setWeather(15.0, 1000.0, 60.0);
+   scalar.setWeather(15.0, 1000.0, 60.0);
+   std::vector<gnsstk::TropModel::Components> comps;
+   TUCATCH(batch.getComponents(rx, elev, tt, comps));
+   TUASSERTE(size_t, elev.size(), comps.size());
+   for (size_t i = 0; i < elev.size(); i++)
+   {
+      scalar.setReceiverHeight(rx[i].getHeight());
+      scalar.setReceiverLatitude(rx[i].getGeodeticLatitude());
+      scalar.setDayOfYear(static_cast<gnsstk::YDSTime>(tt[i]).doy);
+      TUASSERTFE(scalar.correction(elev[i]), comps[i].delay());
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   TropModel_T testClass;
+
+   errorTotal += testClass.globalComponentsTest();
+   errorTotal += testClass.neillComponentsTest();
+   errorTotal += testClass.gcatComponentsTest();
+   errorTotal += testClass.defaultComponentsTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+   return errorTotal;
 }
@@ -0,0 +1,248 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cmath>
+#include "AntennaStore.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class AntennaStore_T
+{
+public:
+      /// Check the gridded PCVs against AntexData
+   unsigned pcvTest();
+      /// Check the batch interface
+   unsigned batchTest();
+      /// Check handles and errors
+   unsigned handleTest();
+
+      /** Make a valid antenna; azimuths 0 to azmax in steps of daz (none if
+          daz is 0), zenith angles 0 to zenmax in steps of dzen, with a NOAZI
+          entry if noazi */
+   AntexData makeAntenna(bool rx, double daz, double azmax, double dzen,
+                         double zenmax, double scale = 1.0, bool noazi = true);
+};
+
+
+AntexData AntennaStore_T ::
+makeAntenna(bool rx, double daz, double azmax, double dzen, double zenmax,
+            double scale, bool noazi)
+{
+   AntexData ant;
+   ant.valid = AntexData::allValid13;
+   ant.isRxAntenna = rx;
+   const char *freqs[2] = {"G01", "G02"};
+   for (int f = 0; f < 2; f++)
+   {
+      AntexData::antennaPCOandPCVData data;
+      data.PCOvalue[0] = 1.0 + f;
+      data.PCOvalue[1] = -2.0;
+      data.PCOvalue[2] = 60.0 + 30.0 * f;
+      data.hasAzimuth = (daz > 0.0);
+      for (double zen = 0.0; noazi && zen <= zenmax + 1.e-9; zen += dzen)
+         data.PCVvalue[-1.0][zen] = scale * (0.001 * zen * zen - 3.0 * f);
+      if (data.hasAzimuth)
+      {
+         for (double az = 0.0; az <= azmax + 1.e-9; az += daz)
+         {
+            for (double zen = 0.0; zen <= zenmax + 1.e-9; zen += dzen)
+            {
+               data.PCVvalue[az][zen] =
+                  scale * (0.001 * zen * zen + 2.0 * sin(az * 0.0174533) *
+                           sin(zen * 0.0523599) - 3.0 * f);
+            }
+         }
+      }
+      ant.freqPCVmap[freqs[f]] = data;
+   }
+   return ant;
+}
+
+
+unsigned AntennaStore_T ::
+pcvTest()
+{
+   TUDEF("AntennaStore", "getPhaseCenterVariation");
+   AntennaStore store;
+   AntexData rx = makeAntenna(true, 5.0, 360.0, 5.0, 90.0);
+      // without a 360 degree row; AntexData would wrap from the last
+      // azimuth to the NOAZI entry, so leave that out
+   AntexData rxwrap = makeAntenna(true, 10.0, 350.0, 5.0, 80.0, 1.0, false);
+   AntexData sv = makeAntenna(false, 0.0, 0.0, 1.0, 14.0);
+   store.addAntenna("RX", rx);
+   store.addAntenna("RXWRAP", rxwrap);
+   store.addAntenna("SV", sv);
+
+   const char *names[3] = {"RX", "RXWRAP", "SV"};
+   AntexData *ants[3] = {&rx, &rxwrap, &sv};
+   for (int a = 0; a < 3; a++)
+   {
+      for (int f = 0; f < 2; f++)
+      {
+         string freq(f ? "G02" : "G01");
+         int h = store.getPCVHandle(names[a], freq);
+         double maxerr = 0.0;
+            // include nodes, cell interiors, negative and large azimuths,
+            // and angles beyond the ends of the zenith grid
+         for (double az = -30.0; az <= 400.0; az += 2.5)
+         {
+            for (double el = 0.0; el <= 90.0; el += 0.7)
+            {
+               double want = ants[a]->getPhaseCenterVariation(freq, az, el);
+               double got = store.getPhaseCenterVariation(h, az, el);
+               maxerr = max(maxerr, fabs(want - got));
+            }
+            double want = ants[a]->getPhaseCenterVariation(freq, az, 90.0);
+            maxerr = max(maxerr,
+                         fabs(want - store.getPhaseCenterVariation(h, az, 90.)));
+         }
+         TUASSERTFEPS(0.0, maxerr, 1.e-10);
+            // azimuths far outside [0,360) in either direction
+         TUASSERTE(double, store.getPhaseCenterVariation(h, 355.0, 40.0),
+                   store.getPhaseCenterVariation(h, -725.0, 40.0));
+         TUASSERTE(double,
+                   store.getPhaseCenterVariation(h, fmod(1.e20, 360.), 40.0),
+                   store.getPhaseCenterVariation(h, 1.e20, 40.0));
+         TUASSERTE(double,
+                   store.getPhaseCenterVariation(h, 360.-fmod(1.e20, 360.),
+                                                 40.0),
+                   store.getPhaseCenterVariation(h, -1.e20, 40.0));
+
+         Triple pco = ants[a]->getPhaseCenterOffset(freq);
+         Triple got = store.getPhaseCenterOffset(h);
+         for (int i = 0; i < 3; i++)
+            TUASSERTE(double, pco[i], got[i]);
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned AntennaStore_T ::
+batchTest()
+{
+   TUDEF("AntennaStore", "getPhaseCenterVariation");
+   AntennaStore store;
+   AntexData rx = makeAntenna(true, 5.0, 360.0, 5.0, 90.0);
+   store.addAntenna("RX", rx);
+   int h = store.getPCVHandle("RX", "G02");
+
+   vector<double> az, el, pcv;
+   for (int i = 0; i < 1000; i++)
+   {
+      az.push_back(fmod(i * 37.3, 360.0));
+      el.push_back(fmod(i * 7.9, 90.0));
+   }
+   store.getPhaseCenterVariation(h, az, el, pcv);
+   TUASSERTE(size_t, az.size(), pcv.size());
+   double maxerr = 0.0;
+   for (size_t i = 0; i < az.size(); i++)
+      maxerr = max(maxerr,
+                   fabs(pcv[i] - rx.getPhaseCenterVariation("G02", az[i], el[i])));
+   TUASSERTFEPS(0.0, maxerr, 1.e-10);
+
+   el[10] = 91.0;
+   TUTHROW(store.getPhaseCenterVariation(h, az, el, pcv));
+   el.pop_back();
+   TUTHROW(store.getPhaseCenterVariation(h, az, el, pcv));
+   TURETURN();
+}
+
+
+unsigned AntennaStore_T ::
+handleTest()
+{
+   TUDEF("AntennaStore", "getPCVHandle");
+   AntennaStore store;
+   AntexData rx = makeAntenna(true, 5.0, 360.0, 5.0, 90.0);
+   store.addAntenna("RX", rx);
+
+   int h1 = store.getPCVHandle("RX", "G01");
+   int h2 = store.getPCVHandle("RX", "G02");
+   TUASSERT(h1 != h2);
+   TUASSERTE(int, h1, store.getPCVHandle("RX", "G01"));
+   TUTHROW(store.getPCVHandle("RX", "G05"));
+   TUTHROW(store.getPCVHandle("NONE", "G01"));
+   TUTHROW(store.getPhaseCenterVariation(h2 + 1, 0.0, 45.0));
+   TUTHROW(store.getPhaseCenterVariation(-1, 0.0, 45.0));
+   TUTHROW(store.getPhaseCenterVariation(h1, 0.0, -1.0));
+
+      // replacing the antenna recompiles the grid under the same handle
+   AntexData rx2 = makeAntenna(true, 5.0, 360.0, 5.0, 90.0, 2.0);
+   store.addAntenna("RX", rx2);
+   TUASSERTE(int, h1, store.getPCVHandle("RX", "G01"));
+   TUASSERTFEPS(rx2.getPhaseCenterVariation("G01", 33.0, 21.0),
+                store.getPhaseCenterVariation(h1, 33.0, 21.0), 1.e-10);
+
+      // a replacement that cannot be gridded leaves the store unchanged
+   AntexData rx3 = makeAntenna(true, 7.0, 350.0, 5.0, 90.0, 3.0), stored;
+   TUTHROW(store.addAntenna("RX", rx3));
+   TUASSERTFEPS(rx2.getPhaseCenterVariation("G01", 33.0, 21.0),
+                store.getPhaseCenterVariation(h1, 33.0, 21.0), 1.e-10);
+   TUASSERTFEPS(rx2.getPhaseCenterVariation("G02", 33.0, 21.0),
+                store.getPhaseCenterVariation(h2, 33.0, 21.0), 1.e-10);
+   TUASSERT(store.getAntenna("RX", stored));
+   TUASSERTFEPS(rx2.getPhaseCenterVariation("G02", 33.0, 21.0),
+                stored.getPhaseCenterVariation("G02", 33.0, 21.0), 1.e-10);
+
+      // azimuths that do not close the circle cannot be gridded
+   AntexData bad = makeAntenna(true, 7.0, 350.0, 5.0, 90.0);
+   store.addAntenna("BAD", bad);
+   TUTHROW(store.getPCVHandle("BAD", "G01"));
+
+   store.clear();
+   TUTHROW(store.getPhaseCenterVariation(h1, 0.0, 45.0));
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   AntennaStore_T testClass;
+
+   errorTotal += testClass.pcvTest();
+   errorTotal += testClass.batchTest();
+   errorTotal += testClass.handleTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,302 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cmath>
+#include "EarthRotationTable.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class EarthRotationTable_T
+{
+public:
+   EarthRotationTable_T();
+      /// Check the interpolated rotation and rate against the direct values
+   unsigned accuracyTest();
+      /// Check the batch transforms
+   unsigned batchTest();
+      /// Check errors for bad requests
+   unsigned errorTest();
+      /// Check that the EOPStore cache returns the uncached results
+   unsigned eopCacheTest();
+
+      /// Direct computation of the rotation at t
+   Matrix<double> direct(const EphTime& t, const IERSConvention& conv);
+
+      /// synthetic, smoothly varying EOPs for a few days
+   EOPStore store;
+   EphTime beg, end;
+};
+
+
+EarthRotationTable_T ::
+EarthRotationTable_T()
+      : beg(58003, 0.0, TimeSystem::UTC), end(58004, 0.0, TimeSystem::UTC)
+{
+   for (int mjd = 58000; mjd <= 58008; mjd++)
+   {
+      EarthOrientation eo;
+      double d   = mjd - 58000;
+      eo.xp      = 0.05 + 0.1 * sin(d / 50.0);
+      eo.yp      = 0.30 + 0.1 * cos(d / 50.0);
+      eo.UT1mUTC = -0.20 - 0.0012 * d;
+      store.addEOP(mjd, eo);
+   }
+}
+
+
+Matrix<double> EarthRotationTable_T ::
+direct(const EphTime& t, const IERSConvention& conv)
+{
+   EphTime tu(t);
+   tu.convertSystemTo(TimeSystem::UTC);
+   EarthOrientation eo = store.getEOP(tu.dMJD(), conv);
+   return eo.ECEFtoInertial(t);
+}
+
+
+unsigned EarthRotationTable_T ::
+accuracyTest()
+{
+   TUDEF("EarthRotationTable", "ECEFtoInertial");
+   IERSConvention convs[3] = {IERSConvention::IERS1996,
+                              IERSConvention::IERS2003,
+                              IERSConvention::IERS2010};
+   for (int c = 0; c < 3; c++)
+   {
+      EarthRotationTable table;
+      table.compute(store, convs[c], beg, end);
+      TUASSERT(table.isValid());
+      TUASSERTE(int, 289, table.size());
+
+      double maxR = 0.0, maxRdot = 0.0;
+         // times off the nodes, including the ends of the table
+      for (double sec = 0.0; sec <= 86400.0; sec += 433.7)
+      {
+         EphTime t(beg);
+         t += sec;
+         Matrix<double> R, Rdot;
+         table.ECEFtoInertial(t, R, Rdot);
+         Matrix<double> D = direct(t, convs[c]);
+            // central difference of the direct computation
+         EphTime tm(t), tp(t);
+         tm += -0.5;
+         tp += 0.5;
+         Matrix<double> Ddot = direct(tp, convs[c]) - direct(tm, convs[c]);
+         for (int i = 0; i < 3; i++)
+         {
+            for (int j = 0; j < 3; j++)
+            {
+               maxR    = max(maxR, fabs(R(i, j) - D(i, j)));
+               maxRdot = max(maxRdot, fabs(Rdot(i, j) - Ddot(i, j)));
+            }
+         }
+      }
+         // elements are O(1), rates O(7.3e-5)/s
+      TUASSERT(maxR < 1.e-12);
+      TUASSERT(maxRdot < 1.e-12);
+   }
+   TURETURN();
+}
+
+
+unsigned EarthRotationTable_T ::
+batchTest()
+{
+   TUDEF("EarthRotationTable", "ECEFtoInertial");
+   EarthRotationTable table;
+   table.compute(store, IERSConvention::IERS2010, beg, end, 600.0, 8);
+
+   vector<EphTime> times;
+   vector<Triple> pos, vel, ipos, ivel, epos, evel;
+   for (int k = 0; k < 50; k++)
+   {
+      EphTime t(beg);
+      t += 1000.0 * (k / 2); // pairs of equal times
+      times.push_back(t);
+      pos.push_back(Triple(6378137.0 * cos(0.1 * k), 6378137.0 * sin(0.1 * k),
+                           1000.0 * k));
+      vel.push_back(Triple(0.0, 0.0, 0.0));
+   }
+   table.ECEFtoInertial(times, pos, vel, ipos, ivel);
+   TUASSERTE(size_t, pos.size(), ipos.size());
+   TUASSERTE(size_t, pos.size(), ivel.size());
+   for (size_t k = 0; k < pos.size(); k++)
+   {
+      Matrix<double> R, Rdot;
+      table.ECEFtoInertial(times[k], R, Rdot);
+      for (int i = 0; i < 3; i++)
+      {
+         double p = R(i, 0) * pos[k][0] + R(i, 1) * pos[k][1] +
+                    R(i, 2) * pos[k][2];
+         double v = Rdot(i, 0) * pos[k][0] + Rdot(i, 1) * pos[k][1] +
+                    Rdot(i, 2) * pos[k][2];
+         TUASSERTFEPS(p, ipos[k][i], 1.e-6);
+         TUASSERTFEPS(v, ivel[k][i], 1.e-9);
+      }
+         // a point fixed on the Earth moves at omega * distance from the axis
+      double rxy = ::sqrt(pos[k][0] * pos[k][0] + pos[k][1] * pos[k][1]);
+      TUASSERTFEPS(7.2921151e-5 * rxy, ivel[k].mag(), 1.e-3);
+   }
+
+   TUCSM("InertialtoECEF");
+   table.InertialtoECEF(times, ipos, ivel, epos, evel);
+   for (size_t k = 0; k < pos.size(); k++)
+   {
+      for (int i = 0; i < 3; i++)
+      {
+         TUASSERTFEPS(pos[k][i], epos[k][i], 1.e-6);
+         TUASSERTFEPS(0.0, evel[k][i], 1.e-7);
+      }
+   }
+
+      // one time for all positions, no velocities
+   vector<EphTime> one(1, times[7]);
+   vector<Triple> none;
+   table.InertialtoECEF(one, ipos, none, epos, evel);
+   TUASSERTE(size_t, 0, evel.size());
+   Matrix<double> R = table.ECEFtoInertial(times[7]);
+   for (int i = 0; i < 3; i++)
+   {
+      double p = R(0, i) * ipos[3][0] + R(1, i) * ipos[3][1] +
+                 R(2, i) * ipos[3][2];
+      TUASSERTFEPS(p, epos[3][i], 1.e-6);
+   }
+   TURETURN();
+}
+
+
+unsigned EarthRotationTable_T ::
+errorTest()
+{
+   TUDEF("EarthRotationTable", "compute");
+   EarthRotationTable table;
+   TUTHROW(table.ECEFtoInertial(beg));
+   TUTHROW(table.compute(store, IERSConvention::IERS2010, end, beg));
+   TUTHROW(table.compute(store, IERSConvention::IERS2010, beg, end, 0.0));
+   TUTHROW(table.compute(store, IERSConvention::IERS2010, beg, end, 300., 1));
+      // store does not cover this
+   EphTime late(58010, 0.0, TimeSystem::UTC), later(58011, 0.0, TimeSystem::UTC);
+   TUTHROW(table.compute(store, IERSConvention::IERS2010, late, later));
+   TUASSERT(!table.isValid());
+
+   TUCSM("ECEFtoInertial");
+   table.compute(store, IERSConvention::IERS1996, beg, end, 900.0, 6);
+   EphTime t(beg);
+   t += -1.0;
+   TUTHROW(table.ECEFtoInertial(t));
+   t = end;
+   t += 1.0;
+   TUTHROW(table.ECEFtoInertial(t));
+   TUCATCH(table.ECEFtoInertial(end));
+      // the same instant in TT is inside the table
+   EphTime tt(beg);
+   tt.convertSystemTo(TimeSystem::TT);
+   TUCATCH(table.ECEFtoInertial(tt));
+
+   vector<EphTime> times(2, beg);
+   vector<Triple> pos(3), vel, opos, ovel;
+   TUTHROW(table.ECEFtoInertial(times, pos, vel, opos, ovel));
+   times.resize(3, beg);
+   vel.resize(2);
+   TUTHROW(table.ECEFtoInertial(times, pos, vel, opos, ovel));
+   TURETURN();
+}
+
+
+unsigned EarthRotationTable_T ::
+eopCacheTest()
+{
+   TUDEF("EOPStore", "getEOP");
+   EOPStore fresh;
+   for (int mjd = 58000; mjd <= 58008; mjd++)
+   {
+      EarthOrientation eo;
+      double d   = mjd - 58000;
+      eo.xp      = 0.05 + 0.1 * sin(d / 50.0);
+      eo.yp      = 0.30 + 0.1 * cos(d / 50.0);
+      eo.UT1mUTC = -0.20 - 0.0012 * d;
+      fresh.addEOP(mjd, eo);
+   }
+      /* interleave days, times and conventions in the cached store; each
+         result must match a query of a store that has not seen any other */
+   double mjds[6] = {58003.25, 58003.75, 58005.5, 58003.75, 58003.75, 58001.1};
+   for (int k = 0; k < 6; k++)
+   {
+      IERSConvention conv = (k == 4 ? IERSConvention::IERS1996
+                                    : IERSConvention::IERS2010);
+      EOPStore single(fresh);
+      EarthOrientation e1 = store.getEOP(mjds[k], conv);
+      EarthOrientation e2 = single.getEOP(mjds[k], conv);
+      TUASSERTE(double, e2.xp, e1.xp);
+      TUASSERTE(double, e2.yp, e1.yp);
+      TUASSERTE(double, e2.UT1mUTC, e1.UT1mUTC);
+      TUASSERTE(IERSConvention, e2.convention, e1.convention);
+   }
+
+      // changing the store must not leave stale results
+   EOPStore changing(fresh);
+   EarthOrientation before = changing.getEOP(58003.5, IERSConvention::IERS2010);
+   EarthOrientation eo;
+   eo.xp = 1.0;
+   eo.yp = 1.0;
+   eo.UT1mUTC = 0.1;
+   changing.addEOP(58004, eo);
+   EarthOrientation after = changing.getEOP(58003.5, IERSConvention::IERS2010);
+   TUASSERT(before.xp != after.xp);
+   changing.edit(58000, 58004);
+   TUTHROW(changing.getEOP(58004.5, IERSConvention::IERS2010));
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   EarthRotationTable_T testClass;
+
+   errorTotal += testClass.accuracyTest();
+   errorTotal += testClass.batchTest();
+   errorTotal += testClass.errorTest();
+   errorTotal += testClass.eopCacheTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
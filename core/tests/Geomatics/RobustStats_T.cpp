@@ -0,0 +1,223 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file RobustStats_T.cpp Test the selection-based robust statistics
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "RobustStats.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class RobustStats_T
+{
+public:
+      /// deterministic pseudo-random data in [0,1)
+   static vector<double> makeData(unsigned int n, unsigned long seed)
+   {
+      vector<double> v(n);
+      for(unsigned int i=0; i<n; i++) {
+         seed = (1103515245UL*seed + 12345UL) % 2147483648UL;
+         v[i] = double(seed)/2147483648.0;
+      }
+      return v;
+   }
+
+      /// median of a sorted copy
+   static double sortedMedian(vector<double> v)
+   {
+      sort(v.begin(), v.end());
+      size_t n(v.size());
+      return (n % 2 ? v[n/2] : (v[n/2-1] + v[n/2])/2.);
+   }
+
+   unsigned sortTest()
+   {
+      TUDEF("RobustStats", "QSort");
+      vector<double> v(makeData(1001, 7)), ref(v);
+      sort(ref.begin(), ref.end());
+      QSort(&v[0], v.size());
+      TUASSERT(v == ref);
+
+         // keep a parallel array
+      vector<double> x(makeData(500, 9));
+      vector<int> key(x.size());
+      for(unsigned int i=0; i<key.size(); i++) key[i] = i;
+      vector<double> x0(x);
+      QSort(&x[0], &key[0], x.size());
+      bool ok(is_sorted(x.begin(), x.end()));
+      for(unsigned int i=0; i<key.size(); i++)
+         if(x0[key[i]] != x[i]) ok = false;
+      TUASSERT(ok);
+      TURETURN();
+   }
+
+   unsigned medianTest()
+   {
+      TUDEF("RobustStats", "Median");
+      for(unsigned int n=2; n<40; n++) {
+         vector<double> v(makeData(n, n)), v0(v);
+         double ref(sortedMedian(v));
+         TUASSERTE(double, ref, Robust::Median(&v[0], n));
+         TUASSERT(v == v0);                            // saved
+         TUASSERTE(double, ref, Robust::Median(&v[0], n, false));
+         sort(v.begin(), v.end()); sort(v0.begin(), v0.end());
+         TUASSERT(v == v0);                            // only reordered
+      }
+
+         // MAD against the sorted computation
+      vector<double> v(makeData(1000, 3)), v0(v);
+      double M, ref(sortedMedian(v));
+      vector<double> dev(v.size());
+      for(unsigned int i=0; i<v.size(); i++) dev[i] = ::fabs(v[i]-ref);
+      double mad(Robust::MedianAbsoluteDeviation(&v[0], v.size(), M));
+      TUASSERTE(double, ref, M);
+      TUASSERTE(double, sortedMedian(dev)/RobustTuningE, mad);
+      TUASSERT(v == v0);
+      TUASSERTE(double, mad, Robust::MAD(&v[0], v.size(), M, false));
+
+      TUTHROW(Robust::Median((double *)0, 5));
+      TUTHROW(Robust::Median(&v[0], 1));
+      TURETURN();
+   }
+
+   unsigned weightedTest()
+   {
+      TUDEF("RobustStats", "WeightedMedian");
+         // equal weights give the median, for odd and even n
+      for(unsigned int n=1; n<30; n++) {
+         vector<double> v(makeData(n, 11*n)), w(n, 2.5);
+         TUASSERTE(double, sortedMedian(v), Robust::WeightedMedian(&v[0], &w[0], n));
+      }
+
+         // compare to the cumulative weight of the sorted data
+      vector<double> v(makeData(777, 5)), w(makeData(777, 6));
+      vector< pair<double,double> > vw;
+      double wtot(0);
+      for(unsigned int i=0; i<v.size(); i++) {
+         vw.push_back(make_pair(v[i], w[i]));
+         wtot += w[i];
+      }
+      sort(vw.begin(), vw.end());
+      double cum(0), ref(0);
+      for(unsigned int i=0; i<vw.size(); i++) {
+         cum += vw[i].second;
+         if(cum >= wtot/2) { ref = vw[i].first; break; }
+      }
+      TUASSERTE(double, ref, Robust::WeightedMedian(&v[0], &w[0], v.size()));
+
+         // a heavy point is the weighted median
+      double x[5] = { 1., 2., 3., 4., 5. }, wt[5] = { 1., 1., 1., 1., 10. };
+      TUASSERTE(double, 5., Robust::WeightedMedian(x, wt, 5));
+         // exactly half the weight on either side; zero weights are skipped
+      double w0[5] = { 1., 0., 1., 0., 2. };
+      TUASSERTE(double, 4., Robust::WeightedMedian(x, w0, 5));
+      double w1[5] = { 1., 1., 0., 0., 2. };
+      TUASSERTE(double, 3.5, Robust::WeightedMedian(x, w1, 5));
+      double x2[6] = { 6., 5., 4., 3., 2., 1. }, w2[6] = { 1., 0., 0., 1., 0., 0. };
+      TUASSERTE(double, 4.5, Robust::WeightedMedian(x2, w2, 6));
+         // weights of 0, 1 and 2 often split the weight exactly in half
+      for(unsigned int n=2; n<40; n++) {
+         vector<double> vi(makeData(n, 3*n)), wi(makeData(n, 5*n));
+         for(unsigned int i=0; i<n; i++) wi[i] = ::floor(3*wi[i]);
+         wi[0] += 1.;
+         vector< pair<double,double> > sorted;
+         double half(0);
+         for(unsigned int i=0; i<n; i++) {
+            sorted.push_back(make_pair(vi[i], wi[i]));
+            half += wi[i]/2;
+         }
+         sort(sorted.begin(), sorted.end());
+         unsigned int k(0), j;
+         for(cum = 0; cum + sorted[k].second < half; k++)
+            cum += sorted[k].second;
+         ref = sorted[k].first;
+         if(cum + sorted[k].second == half) {
+            for(j = k+1; sorted[j].second == 0.; j++);
+            ref = (ref + sorted[j].first)/2;
+         }
+         TUASSERTE(double, ref, Robust::WeightedMedian(&vi[0], &wi[0], n));
+      }
+      wt[4] = -1.;
+      TUTHROW(Robust::WeightedMedian(x, wt, 5));
+      double zero[5] = { 0., 0., 0., 0., 0. };
+      TUTHROW(Robust::WeightedMedian(x, zero, 5));
+      TURETURN();
+   }
+
+   unsigned parallelTest()
+   {
+      TUDEF("RobustStats", "ParallelMedian");
+      for(unsigned int n=300000; n<=300001; n++) {
+         vector<double> v(makeData(n, 17)), v0(v);
+         double M, Mp, mad(Robust::MAD(&v[0], n, M));
+         TUASSERTE(double, M, Robust::ParallelMedian(&v[0], n, 4));
+         TUASSERTE(double, mad, Robust::ParallelMAD(&v[0], n, Mp, 4));
+         TUASSERTE(double, M, Mp);
+         TUASSERT(v == v0);
+      }
+
+         // heavily repeated data, and data that defeats the sample
+      vector<double> v(300000, 1.);
+      for(unsigned int i=0; i<v.size(); i+=3) v[i] = 2.;
+      TUASSERTE(double, 1., Robust::ParallelMedian(&v[0], v.size(), 4));
+      for(unsigned int i=0; i<v.size(); i++) v[i] = (i % 8 ? 1.e6+i : i);
+      TUASSERTE(double, Robust::Median(&v[0], v.size()),
+                Robust::ParallelMedian(&v[0], v.size(), 4));
+      TURETURN();
+   }
+};
+
+int main()
+{
+   unsigned errorTotal = 0;
+   RobustStats_T testClass;
+
+   errorTotal += testClass.sortTest();
+   errorTotal += testClass.medianTest();
+   errorTotal += testClass.weightedTest();
+   errorTotal += testClass.parallelTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,302 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file SRIFilter_T.cpp Test the sparse updates of SRIFilter against
+/// the dense ones.
+
+#include <iostream>
+#include <vector>
+
+#include "TestUtil.hpp"
+#include "SRIFilter.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class SRIFilter_T
+{
+public:
+   SRIFilter_T();
+   unsigned measurementUpdateSparseTest();
+   unsigned timeUpdateSparseTest();
+   unsigned marginalizeTest();
+
+      /// Initial, weakly constrained filter: biases 0..N-2, common state N-1
+   SRIFilter initial() const;
+      /** Partials and data for one epoch; bias k is observed with the
+          common state unless k%step == skip. */
+   void epoch(int ep, unsigned step, unsigned skip,
+              SparseMatrix<double>& H, Vector<double>& D) const;
+
+   static const unsigned N = 9;
+   double eps;
+};
+
+
+const unsigned SRIFilter_T::N;
+
+
+SRIFilter_T ::
+SRIFilter_T()
+      : eps(1.e-10)
+{
+}
+
+
+SRIFilter SRIFilter_T ::
+initial() const
+{
+   Matrix<double> R(N, N, 0.0);
+   Vector<double> Z(N, 0.0);
+   for (unsigned i = 0; i < N; i++)
+   {
+      R(i,i) = 0.1;
+   }
+   return SRIFilter(R, Z, Namelist(N));
+}
+
+
+void SRIFilter_T ::
+epoch(int ep, unsigned step, unsigned skip,
+      SparseMatrix<double>& H, Vector<double>& D) const
+{
+   H = SparseMatrix<double>(N-1, N);
+   D = Vector<double>(N-1, 0.0);
+   for (unsigned k = 0; k < N-1; k++)
+   {
+      if (k % step == skip)
+      {
+         continue;                     // leaves an empty row
+      }
+      H(k,k) = 1.0;
+      H(k,N-1) = 1.0 + 0.1*k;
+      D(k) = 10.0*(k+1) + ::sin(0.7*ep + k);
+   }
+}
+
+
+unsigned SRIFilter_T ::
+measurementUpdateSparseTest()
+{
+   TUDEF("SRIFilter", "measurementUpdateSparse");
+
+   SRIFilter dense(initial()), sparse(initial());
+   SparseMatrix<double> H, CM(N-1, N-1);
+   Vector<double> D, Dd, Ds, Xd, Xs;
+   Matrix<double> Cd, Cs;
+   for (unsigned k = 0; k < N-1; k++)
+   {
+      CM(k,k) = 0.01*(k+1);
+   }
+
+   for (int ep = 0; ep < 5; ep++)
+   {
+      epoch(ep, 3, ep % 3, H, D);
+      Dd = Ds = D;
+      dense.measurementUpdate(H, Dd, CM);
+      sparse.measurementUpdateSparse(H, Ds, CM);
+      dense.getStateAndCovariance(Xd, Cd);
+      sparse.getStateAndCovariance(Xs, Cs);
+      TUASSERTFEPS(Xd, Xs, eps);
+      TUASSERTFEPS(Cd, Cs, eps);
+   }
+
+      // partials involving only one bias do not touch the other rows
+   SRIFilter single(initial());
+   H = SparseMatrix<double>(1, N);
+   D = Vector<double>(1, 2.0);
+   H(0,3) = 1.0;
+   single.measurementUpdateSparse(H, D);
+   Matrix<double> R(single.getR());
+   TUASSERTFE(0.1, R(0,0));
+   TUASSERTFE(0.0, R(3,N-1));
+   TUASSERTFE(::sqrt(1.01), ::fabs(R(3,3)));
+
+      // dimensions are checked
+   Ds = Vector<double>(N, 0.0);
+   TUTHROW(sparse.measurementUpdateSparse(H, Ds));
+   TURETURN();
+}
+
+
+unsigned SRIFilter_T ::
+timeUpdateSparseTest()
+{
+   TUDEF("SRIFilter", "timeUpdateSparse");
+
+   SRIFilter dense(initial()), sparse(initial()), kept(initial());
+   SRIFilter::RowStructure rs;
+   SparseMatrix<double> H;
+   Vector<double> D, Xd, Xs, Xk;
+   Matrix<double> Cd, Cs, Ck;
+
+      // random walk on biases 1 and 4
+   vector<unsigned int> indexes;
+   indexes.push_back(1);
+   indexes.push_back(4);
+   Vector<double> sigma(2);
+   sigma(0) = 0.5;
+   sigma(1) = 2.0;
+
+   for (int ep = 0; ep < 5; ep++)
+   {
+      epoch(ep, 4, 2, H, D);
+      dense.measurementUpdate(H, D);
+      epoch(ep, 4, 2, H, D);
+      sparse.measurementUpdateSparse(H, D);
+         // row structure kept across the updates
+      epoch(ep, 4, 2, H, D);
+      kept.measurementUpdateSparse(H, D, SRINullSparseMatrix, rs);
+
+      Matrix<double> PhiInv(ident<double>(N)), Rw(2, 2, 0.0), G(N, 2, 0.0),
+         Rwx(2, N, 0.0);
+      Vector<double> Zw(2, 0.0);
+      for (unsigned k = 0; k < 2; k++)
+      {
+         Rw(k,k) = 1.0/sigma(k);
+         G(indexes[k],k) = 1.0;
+      }
+      dense.timeUpdate(PhiInv, Rw, G, Zw, Rwx);
+      sparse.timeUpdateSparse(indexes, sigma);
+      kept.timeUpdateSparse(indexes, sigma, rs);
+
+      dense.getStateAndCovariance(Xd, Cd);
+      sparse.getStateAndCovariance(Xs, Cs);
+      kept.getStateAndCovariance(Xk, Ck);
+      TUASSERTFEPS(Xd, Xs, eps);
+      TUASSERTFEPS(Cd, Cs, eps);
+      TUASSERTFEPS(Xd, Xk, eps);
+      TUASSERTFEPS(Cd, Ck, eps);
+   }
+
+   sigma(1) = 0.0;
+   TUTHROW(sparse.timeUpdateSparse(indexes, sigma));
+   indexes[1] = N;
+   sigma(1) = 1.0;
+   TUTHROW(sparse.timeUpdateSparse(indexes, sigma));
+   TURETURN();
+}
+
+
+unsigned SRIFilter_T ::
+marginalizeTest()
+{
+   TUDEF("SRI", "marginalize");
+
+   SRIFilter srif(initial());
+   SparseMatrix<double> H;
+   Vector<double> D, X, Xm;
+   Matrix<double> C, Cm;
+   for (int ep = 0; ep < 3; ep++)
+   {
+      epoch(ep, 5, 1, H, D);
+      srif.measurementUpdate(H, D);
+   }
+      // couple everything, so every sweep has work to do
+   Matrix<double> Hd(1, N, 1.0);
+   D = Vector<double>(1, 3.0);
+   srif.measurementUpdate(Hd, D);
+   srif.getStateAndCovariance(X, C);
+
+      // drop 0, 3 and 4; the rest keep their state and covariance
+   vector<unsigned int> drops;
+   drops.push_back(4);
+   drops.push_back(0);
+   drops.push_back(3);
+   drops.push_back(4);
+   Namelist NL(srif.getNames());
+   SRIFilter marg(srif);
+   marg.marginalize(drops);
+   TUASSERTE(unsigned, N-3, marg.size());
+   marg.getStateAndCovariance(Xm, Cm);
+
+   vector<unsigned int> keep;
+   for (unsigned i = 0; i < N; i++)
+   {
+      if (i != 0 && i != 3 && i != 4)
+      {
+         keep.push_back(i);
+      }
+   }
+   for (unsigned i = 0; i < keep.size(); i++)
+   {
+      TUASSERTE(string, NL.getName(keep[i]), marg.getName(i));
+      TUASSERTFEPS(X(keep[i]), Xm(i), eps);
+      for (unsigned j = 0; j < keep.size(); j++)
+      {
+         TUASSERTFEPS(C(keep[i], keep[j]), Cm(i, j), eps);
+      }
+   }
+   Matrix<double> R(marg.getR());
+   for (unsigned i = 0; i < R.rows(); i++)
+   {
+      for (unsigned j = 0; j < i; j++)
+      {
+         TUASSERTFE(0.0, R(i, j));
+      }
+   }
+
+      // by name, ignoring names that are not there
+   Namelist dropNL;
+   dropNL += NL.getName(3);
+   dropNL += string("notAState");
+   marg = srif;
+   marg.marginalize(dropNL);
+   TUASSERTE(unsigned, N-1, marg.size());
+   TUASSERTE(int, -1, marg.getNames().index(NL.getName(3)));
+
+   drops[0] = N;
+   TUTHROW(marg.marginalize(drops));
+   TURETURN();
+}
+
+
+int main()
+{
+   SRIFilter_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.measurementUpdateSparseTest();
+   errorTotal += testClass.timeUpdateSparseTest();
+   errorTotal += testClass.marginalizeTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
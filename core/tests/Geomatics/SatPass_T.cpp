@@ -0,0 +1,407 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include "build_config.h"
+#include "gdc.hpp"
+#include "SatPassUtilities.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class SatPass_T
+{
+public:
+   SatPass_T();
+      /// Storage, copy, split and decimate of a SatPass
+   unsigned storageTest();
+      /// SatPassFromRinexFiles reading files one at a time and concurrently
+   unsigned rinexTest();
+      /// gdc on a list of SatPass, one at a time and concurrently
+   unsigned gdcTest();
+
+      /** Synthetic dual-frequency data for satellite k at epoch n; returns
+          false if there is no data (a gap in satellite 2). */
+   bool getData(int k, int n, vector<double>& data);
+      /// SatPass list with all satellites' data for epochs [n0, n1)
+   vector<SatPass> makeList(int n0, int n1);
+      /// true if the two lists hold identical data
+   bool sameData(vector<SatPass>& a, vector<SatPass>& b);
+
+   vector<string> obstypes;
+   Epoch beg;
+   double DT;
+   int nsats;
+};
+
+
+SatPass_T ::
+SatPass_T()
+      : DT(30.0), nsats(8)
+{
+   obstypes.push_back("L1");
+   obstypes.push_back("L2");
+   obstypes.push_back("P1");
+   obstypes.push_back("P2");
+   beg = Epoch(CivilTime(2021, 6, 1, 0, 0, 0.0, TimeSystem::GPS));
+}
+
+
+bool SatPass_T ::
+getData(int k, int n, vector<double>& data)
+{
+   if (k == 2 && n >= 400 && n < 480)
+      return false;
+   const double wl1(C_MPS / L1_FREQ_GPS), wl2(C_MPS / L2_FREQ_GPS);
+   const double beta(L1_FREQ_GPS / L2_FREQ_GPS);
+   mt19937 gen(1000 * k + n);
+   uniform_real_distribution<double> uni(-1.0, 1.0);
+   double t = n * DT;
+   double rho = 2.2e7 + 1.0e6 * sin(0.0002 * t + k);
+   double I1 = 4.0 + 0.3 * k + sin(t / 5000.0);
+   double N1(1000.0 * k), N2(-700.0 * k);
+   if (k % 2 == 1 && n >= 300 + 20 * k)
+   {  // a cycle slip in odd satellites
+      N1 += 7;
+      N2 += 5;
+   }
+   data.resize(4);
+   data[0] = (rho - I1) / wl1 + N1 + 0.005 * uni(gen);
+   data[1] = (rho - beta * beta * I1) / wl2 + N2 + 0.005 * uni(gen);
+   data[2] = rho + I1 + 0.3 * uni(gen);
+   data[3] = rho + beta * beta * I1 + 0.3 * uni(gen);
+   return true;
+}
+
+
+vector<SatPass> SatPass_T ::
+makeList(int n0, int n1)
+{
+   vector<SatPass> SPList;
+   vector<double> data;
+   for (int k = 1; k <= nsats; k++)
+   {
+      SatPass sp(RinexSatID(k, SatelliteSystem::GPS), DT, obstypes);
+      for (int n = n0; n < n1; n++)
+      {
+         if (!getData(k, n, data))
+            continue;
+         Epoch t(beg);
+         t += n * DT;
+         if (sp.addData(t, obstypes, data) == -1)
+         {  // gap, start a new pass
+            SPList.push_back(sp);
+            sp = SatPass(sp.getSat(), DT, obstypes);
+            sp.addData(t, obstypes, data);
+         }
+      }
+      SPList.push_back(sp);
+   }
+   return SPList;
+}
+
+
+bool SatPass_T ::
+sameData(vector<SatPass>& a, vector<SatPass>& b)
+{
+   if (a.size() != b.size())
+      return false;
+   for (size_t i = 0; i < a.size(); i++)
+   {
+      if (a[i].getSat() != b[i].getSat() || a[i].size() != b[i].size() ||
+          a[i].getNgood() != b[i].getNgood())
+         return false;
+      for (unsigned j = 0; j < a[i].size(); j++)
+      {
+         if (a[i].time(j) != b[i].time(j) ||
+             a[i].getFlag(j) != b[i].getFlag(j))
+            return false;
+         for (size_t k = 0; k < obstypes.size(); k++)
+         {
+            if (a[i].data(j, obstypes[k]) != b[i].data(j, obstypes[k]) ||
+                a[i].LLI(j, obstypes[k]) != b[i].LLI(j, obstypes[k]) ||
+                a[i].SSI(j, obstypes[k]) != b[i].SSI(j, obstypes[k]))
+               return false;
+         }
+      }
+   }
+   return true;
+}
+
+
+unsigned SatPass_T ::
+storageTest()
+{
+   TUDEF("SatPass", "addData");
+   RinexSatID sat(5, SatelliteSystem::GPS);
+   vector<string> ots(obstypes);
+   ots.push_back("C1");
+   SatPass sp(sat, DT, ots);
+   vector<double> data(5);
+   vector<unsigned short> lli(5, 0), ssi(5, 7);
+   for (int n = 0; n < 100; n++)
+   {
+      for (int k = 0; k < 5; k++)
+         data[k] = 100.0 * n + k;
+      lli[1] = n % 2;
+      Epoch t(beg);
+      t += n * DT;
+      TUASSERTE(int, n, sp.addData(t, ots, data, lli, ssi,
+                                   (n == 10 ? SatPass::BAD : SatPass::OK)));
+   }
+   TUASSERTE(unsigned, 100, sp.size());
+   TUASSERTE(int, 99, sp.getNgood());
+   TUASSERTE(unsigned short, SatPass::BAD, sp.getFlag(10));
+   TUASSERTFE(4204.0, sp.data(42, "C1"));
+   TUASSERTFE(4201.0, sp.data(42, "L2"));
+   TUASSERTE(unsigned short, 1, sp.LLI(43, "L2"));
+   TUASSERTE(unsigned short, 7, sp.SSI(43, "P1"));
+   Epoch t(beg);
+   t += 42 * DT;
+   TUASSERTE(Epoch, t, sp.time(42));
+   sp.data(42, "C1") = -1.0;
+   TUASSERTFE(-1.0, sp.data(42, "C1"));
+
+      // out of order, and the wrong number of data
+   TUASSERTE(int, -2, sp.addData(t, ots, data, lli, ssi));
+   t += 100 * DT;
+   data.pop_back();
+   TUTHROW(sp.addData(t, obstypes, data));
+
+      // copies are deep
+   SatPass cp(sat, DT, ots);
+   cp = sp;
+   cp.data(0, "L1") = 5.0;
+   TUASSERTFE(0.0, sp.data(0, "L1"));
+   TUASSERTFE(-1.0, cp.data(42, "C1"));
+
+      // split keeps all the obs types
+   SatPass second(sat, DT);
+   TUASSERT(cp.split(60, second));
+   TUASSERTE(unsigned, 60, cp.size());
+   TUASSERTE(unsigned, 40, second.size());
+   TUASSERTFE(6004.0, second.data(0, "C1"));
+   TUASSERTE(unsigned short, 7, second.SSI(39, "C1"));
+   t = beg;
+   t += 99 * DT;
+   TUASSERTE(Epoch, t, second.time(39));
+
+      // decimate
+   sp.decimate(4);
+   TUASSERTE(unsigned, 25, sp.size());
+   TUASSERTFE(800.0, sp.data(2, "L1"));
+   TUASSERTE(unsigned short, SatPass::OK, sp.getFlag(2));
+   t = beg;
+   t += 8 * DT;
+   TUASSERTE(Epoch, t, sp.time(2));
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+rinexTest()
+{
+   TUDEF("SatPassUtilities", "SatPassFromRinexFiles");
+
+      // three files of 240 epochs, the passes continue across them
+   RinexObsHeader header;
+   header.version = 2.11;
+   header.fileType = "Observation";
+   header.system = RinexSatID(-1, SatelliteSystem::GPS);
+   header.fileProgram = "SatPass_T";
+   header.fileAgency = "test";
+   header.date = "2021/06/01";
+   header.markerName = "TEST";
+   header.observer = "test";
+   header.agency = "test";
+   header.recNo = "1";
+   header.recType = "test";
+   header.recVers = "1";
+   header.antNo = "1";
+   header.antType = "test";
+   header.antennaPosition = Triple(-740000.0, -5457000.0, 3207000.0);
+   header.antennaOffset = Triple(0.0, 0.0, 0.0);
+   header.wavelengthFactor[0] = header.wavelengthFactor[1] = 1;
+   header.valid = RinexObsHeader::versionValid | RinexObsHeader::runByValid |
+                  RinexObsHeader::markerNameValid |
+                  RinexObsHeader::observerValid |
+                  RinexObsHeader::receiverValid |
+                  RinexObsHeader::antennaTypeValid |
+                  RinexObsHeader::antennaPositionValid |
+                  RinexObsHeader::antennaOffsetValid |
+                  RinexObsHeader::waveFactValid |
+                  RinexObsHeader::obsTypeValid | RinexObsHeader::endValid;
+
+   string tmp(getPathTestTemp() + getFileSep());
+   vector<string> files;
+   for (int f = 2; f >= 0; f--)
+   {
+      files.push_back(tmp + "SatPass_T_" + StringUtils::asString(f) + ".obs");
+      vector<SatPass> SPL(makeList(240 * f, 240 * (f + 1)));
+      TUASSERTE(int, 0, SatPassToRinex2File(files.back(), header, SPL));
+   }
+   files.push_back(tmp + "SatPass_T_nonexistent.obs");
+
+   vector<SatPass> serial, parallel, expected(makeList(0, 720));
+   vector<string> ots1(obstypes), ots2(obstypes);
+   vector<string> files1(files), files2(files);
+   TUASSERTE(int, 3, SatPassFromRinexFiles(files1, ots1, DT, serial));
+   TUASSERTE(int, 3,
+             SatPassFromRinexFiles(files2, ots2, DT, parallel,
+                                   vector<RinexSatID>(), true,
+                                   CommonTime::BEGINNING_OF_TIME,
+                                   CommonTime::END_OF_TIME, 3));
+   TUASSERT(sameData(serial, parallel));
+
+      // one pass per satellite, except for the gap
+   TUASSERTE(size_t, size_t(nsats + 1), serial.size());
+   sort(serial.begin(), serial.end());
+   size_t ngot(0);
+   for (size_t i = 0; i < serial.size(); i++)
+   {
+      int k = serial[i].getSat().id;
+      for (unsigned j = 0; j < serial[i].size(); j++)
+      {
+         vector<double> data;
+         int n = int(0.5 + (serial[i].time(j) - beg) / DT);
+         TUASSERT(getData(k, n, data));
+         for (size_t m = 0; m < obstypes.size(); m++)
+            TUASSERTFEPS(data[m], serial[i].data(j, obstypes[m]), 1.e-3);
+         ngot++;
+      }
+   }
+   TUASSERTE(size_t, size_t(720 * nsats - 80), ngot);
+
+      // and with time limits
+   Epoch t0(beg), t1(beg);
+   t0 += 100 * DT;
+   t1 += 500 * DT;
+   serial.clear();
+   parallel.clear();
+   files1 = files2 = files;
+   SatPassFromRinexFiles(files1, ots1, DT, serial, vector<RinexSatID>(), true,
+                         t0, t1);
+   SatPassFromRinexFiles(files2, ots2, DT, parallel, vector<RinexSatID>(),
+                         true, t0, t1, 0);
+   TUASSERT(sameData(serial, parallel));
+   TUASSERTE(Epoch, t0, serial[0].getFirstTime());
+
+   for (size_t f = 0; f < 3; f++)
+      std::remove(files[f].c_str());
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+gdcTest()
+{
+   TUDEF("gdc", "DiscontinuityCorrector");
+   vector<SatPass> SPList(makeList(0, 720)), SPL1, SPL4;
+   for (size_t i = 0; i < SPList.size(); i++)
+   {
+      SatPass second(SPList[i].getSat(), DT);
+      if (SPList[i].split(400, second) && second.size() > 0)
+         SPL1.push_back(second);
+      SPL1.push_back(SPList[i]);
+   }
+   SPL4 = SPL1;
+
+   gdc serial, parallel;
+   serial.setParameter("doFix", 1);
+   serial.setParameter("doCmds", 1);
+   parallel.setParameter("doFix", 1);
+   parallel.setParameter("doCmds", 1);
+   vector<string> msgs1, msgs4;
+   vector<vector<string> > cmds1, cmds4;
+   vector<int> ret1(serial.DiscontinuityCorrector(SPL1, msgs1, cmds1, 1));
+   vector<int> ret4(parallel.DiscontinuityCorrector(SPL4, msgs4, cmds4, 4));
+   TUASSERTE(int, int(SPL1.size()), serial.getUniqueNumber());
+   TUASSERTE(int, int(SPL4.size()), parallel.getUniqueNumber());
+   TUASSERT(ret1 == ret4);
+   TUASSERT(msgs1 == msgs4);
+   TUASSERT(cmds1 == cmds4);
+   TUASSERT(sameData(SPL1, SPL4));
+
+      // the same as one call per pass
+   gdc single;
+   single.setParameter("doFix", 1);
+   single.setParameter("doCmds", 1);
+   vector<SatPass> SPLs(makeList(0, 720)), tmp;
+   for (size_t i = 0; i < SPLs.size(); i++)
+   {
+      SatPass second(SPLs[i].getSat(), DT);
+      if (SPLs[i].split(400, second) && second.size() > 0)
+         tmp.push_back(second);
+      tmp.push_back(SPLs[i]);
+   }
+   for (size_t i = 0; i < tmp.size(); i++)
+   {
+      string msg;
+      vector<string> cmds;
+      int iret = single.DiscontinuityCorrector(tmp[i], msg, cmds);
+      TUASSERTE(int, ret1[i], iret);
+      TUASSERTE(string, msgs1[i], msg);
+      TUASSERT(cmds1[i] == cmds);
+   }
+   TUASSERT(sameData(SPL1, tmp));
+
+      // slips of 7,5 cycles in the odd satellites were fixed
+   bool fixed(false);
+   for (size_t i = 0; i < cmds1.size(); i++)
+      fixed = fixed || !cmds1[i].empty();
+   TUASSERT(fixed);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SatPass_T testClass;
+
+   errorTotal += testClass.storageTest();
+   errorTotal += testClass.rinexTest();
+   errorTotal += testClass.gdcTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,312 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "SolarSystemEphemeris.hpp"
+#include "TestUtil.hpp"
+#include "build_config.h"
+
+using namespace std;
+using namespace gnsstk;
+
+/** Build a small synthetic ephemeris (ASCII header and data written here,
+ * then converted to binary) so that the stream and mapped modes of
+ * SolarSystemEphemeris can be compared without JPL files. */
+class SolarSystemEphemeris_T
+{
+public:
+   SolarSystemEphemeris_T();
+   ~SolarSystemEphemeris_T();
+      /// Check that the mapped mode reproduces the stream mode exactly
+   unsigned mappedVsStreamTest();
+      /// Check the mapped evaluation against an independent Chebyshev sum
+   unsigned chebyshevTest();
+      /// Check range and initialization errors of the mapped mode
+   unsigned mappedErrorTest();
+
+      /// Write the ASCII files and convert them to binary
+   void makeFiles();
+
+   static const int NCHEB = 7;   ///< Chebyshev coefficients per component
+   static const int NREC  = 5;   ///< number of data records
+   static constexpr double JD0  = 2451536.5; ///< start of the first record
+   static constexpr double SPAN = 32.0;      ///< days per record
+   static const int nsets[13];
+
+      /// coefficient k of component c of set s for body b in record r
+   static double coeff(int r, int b, int s, int c, int k)
+   {
+      return (1000.0 * (b + 1) + 10.0 * r + s + 0.5 * c) / (1.0 + k * k) *
+         (k % 2 ? -1.0 : 1.0);
+   }
+
+   int offset[13], Ncoeff;
+   string headerFile, dataFile, binFile;
+};
+
+const int SolarSystemEphemeris_T::nsets[13] =
+{ 4, 2, 2, 1, 1, 1, 1, 1, 1, 8, 2, 4, 4 };
+
+
+SolarSystemEphemeris_T ::
+SolarSystemEphemeris_T()
+{
+   string dir = getPathTestTemp() + getFileSep();
+   headerFile = dir + "SolarSystemEphemeris_T.header";
+   dataFile = dir + "SolarSystemEphemeris_T.asc";
+   binFile = dir + "SolarSystemEphemeris_T.bin";
+   Ncoeff = 2;
+   for (int b = 0; b < 13; b++)
+   {
+      offset[b] = Ncoeff + 1;
+      Ncoeff += (b == 11 ? 2 : 3) * NCHEB * nsets[b];
+   }
+   makeFiles();
+}
+
+
+SolarSystemEphemeris_T ::
+~SolarSystemEphemeris_T()
+{
+   std::remove(headerFile.c_str());
+   std::remove(dataFile.c_str());
+   std::remove(binFile.c_str());
+}
+
+
+void SolarSystemEphemeris_T ::
+makeFiles()
+{
+   ofstream hs(headerFile.c_str());
+   hs << "KSIZE= " << 2*Ncoeff << "    NCOEFF= " << Ncoeff << "\n\n"
+      << "GROUP   1010\n\n"
+      << "Synthetic Ephemeris DE999\n"
+      << "Start Epoch: JED= " << fixed << setprecision(1) << JD0 << "\n"
+      << "Final Epoch: JED= " << JD0 + NREC*SPAN << "\n\n"
+      << "GROUP   1030\n\n"
+      << "  " << JD0 << "  " << JD0 + NREC*SPAN << "  " << SPAN << "\n\n"
+      << "GROUP   1040\n\n"
+      << "     3\n  DENUM   EMRAT   AU\n\n"
+      << "GROUP   1041\n\n"
+      << "     3\n  999.0  81.30056  149597870.691\n\n"
+      << "GROUP   1050\n\n";
+   for (int b = 0; b < 13; b++)
+      hs << " " << offset[b];
+   hs << "\n";
+   for (int b = 0; b < 13; b++)
+      hs << " " << NCHEB;
+   hs << "\n";
+   for (int b = 0; b < 13; b++)
+      hs << " " << nsets[b];
+   hs << "\n\nGROUP   1070\n\n";
+   hs.close();
+
+   ofstream ds(dataFile.c_str());
+   ds << scientific << setprecision(17);
+   for (int r = 0; r < NREC; r++)
+   {
+      vector<double> rec;
+      rec.push_back(JD0 + r*SPAN);
+      rec.push_back(JD0 + (r+1)*SPAN);
+      for (int b = 0; b < 13; b++)
+         for (int s = 0; s < nsets[b]; s++)
+            for (int c = 0; c < (b == 11 ? 2 : 3); c++)
+               for (int k = 0; k < NCHEB; k++)
+                  rec.push_back(coeff(r, b, s, c, k));
+      while (rec.size() % 3)
+         rec.push_back(0.0);
+      ds << "     " << r+1 << "  " << Ncoeff << "\n";
+      for (size_t i = 0; i < rec.size(); i += 3)
+         ds << "  " << rec[i] << "  " << rec[i+1] << "  " << rec[i+2] << "\n";
+   }
+   ds.close();
+
+   SolarSystemEphemeris sse;
+   sse.readASCIIheader(headerFile);
+   vector<string> files(1, dataFile);
+   sse.readASCIIdata(files);
+   sse.writeBinaryFile(binFile);
+}
+
+
+unsigned SolarSystemEphemeris_T ::
+mappedVsStreamTest()
+{
+   TUDEF("SolarSystemEphemeris", "initializeWithMappedFile");
+   SolarSystemEphemeris streamed, mapped;
+   TUASSERTE(int, 0, streamed.initializeWithBinaryFile(binFile));
+   TUASSERTE(int, 0, mapped.initializeWithMappedFile(binFile));
+   TUASSERT(!streamed.isMapped());
+   TUASSERT(mapped.isMapped());
+   TUASSERTE(int, 999, mapped.EphNumber());
+   TUASSERTFE(streamed.startTimeMJD(), mapped.startTimeMJD());
+   TUASSERTFE(streamed.endTimeMJD(), mapped.endTimeMJD());
+
+   TUCSM("relativeInertialPositionVelocity");
+      /* MJD of the first record start. Interior record boundaries are
+         skipped: there the stream mode keeps whichever of the two records it
+         read last, and this synthetic ephemeris is not continuous. */
+   double mjd0 = JD0 - MJD_TO_JD, pv1[6], pv2[6], pv3[6];
+   for (double dt = 0.0; dt <= NREC*SPAN; dt += 0.75)
+   {
+      if (dt > 0.0 && dt < NREC*SPAN && fmod(dt, SPAN) == 0.0)
+         continue;
+      double mjd = mjd0 + dt;
+      for (int t = 1; t <= 15; t++)
+      {
+         for (int c = 1; c <= 13; c += 3)
+         {
+            SolarSystemEphemeris::Planet target(
+               static_cast<SolarSystemEphemeris::Planet>(t));
+            SolarSystemEphemeris::Planet center(
+               static_cast<SolarSystemEphemeris::Planet>(c));
+            streamed.relativeInertialPositionVelocity(mjd, target, center, pv1);
+            mapped.relativeInertialPositionVelocity(mjd, target, center, pv2);
+            const SolarSystemEphemeris& cmapped(mapped);
+            cmapped.relativePositionVelocity(mjd, target, center, pv3, false);
+               // nutations and librations are not scaled by AU
+            double scale = (t >= SolarSystemEphemeris::idNutations ? 1.0
+                            : 1.0 / mapped.AU());
+            for (int i = 0; i < 6; i++)
+            {
+               TUASSERTE(double, pv1[i], pv2[i]);
+               TUASSERTFEPS(pv1[i] * scale, pv3[i], 1e-15);
+            }
+         }
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned SolarSystemEphemeris_T ::
+chebyshevTest()
+{
+   TUDEF("SolarSystemEphemeris", "relativePositionVelocity");
+   SolarSystemEphemeris mapped;
+   TUASSERTE(int, 0, mapped.initializeWithMappedFile(binFile));
+      // the Sun (body 10) relative to the barycenter, in each record and set
+   const int b = 10;
+   double pv[6];
+   for (int r = 0; r < NREC; r++)
+   {
+      for (double frac = 0.05; frac < 1.0; frac += 0.1)
+      {
+         double jd = JD0 + (r + frac)*SPAN;
+         double setSpan = SPAN / nsets[b];
+         int s = int(floor(frac * nsets[b]));
+         double T = 2.0 * (jd - (JD0 + r*SPAN + s*setSpan)) / setSpan - 1.0;
+         mapped.relativePositionVelocity(
+            jd - MJD_TO_JD, SolarSystemEphemeris::idSun,
+            SolarSystemEphemeris::idSolarSystemBarycenter, pv);
+         for (int c = 0; c < 3; c++)
+         {
+            double pos = 0.0, vel = 0.0, th = acos(T);
+            for (int k = 0; k < NCHEB; k++)
+            {
+               pos += coeff(r, b, s, c, k) * cos(k * th);
+                  // d/dT cos(k acos T) = k sin(k th) / sin(th)
+               vel += coeff(r, b, s, c, k) * k * sin(k * th) / sin(th);
+            }
+            vel *= 2.0 / setSpan;
+            TUASSERTFEPS(pos, pv[c], 1e-9);
+            TUASSERTFEPS(vel, pv[c+3], 1e-9);
+         }
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned SolarSystemEphemeris_T ::
+mappedErrorTest()
+{
+   TUDEF("SolarSystemEphemeris", "relativePositionVelocity");
+   SolarSystemEphemeris sse;
+   double pv[6], mjd0 = JD0 - MJD_TO_JD;
+      // not initialized
+   TUTHROW(sse.relativePositionVelocity(
+              mjd0 + 1, SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv));
+   TUASSERTE(int, 0, sse.initializeWithMappedFile(binFile));
+   TUCATCH(sse.relativePositionVelocity(
+              mjd0, SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv));
+   TUCATCH(sse.relativePositionVelocity(
+              mjd0 + NREC*SPAN, SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv));
+   TUTHROW(sse.relativePositionVelocity(
+              mjd0 - 1e-3, SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv));
+   TUTHROW(sse.relativePositionVelocity(
+              mjd0 + NREC*SPAN + 1e-3, SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv));
+      // switching back to the stream mode drops the mapping
+   TUASSERTE(int, 0, sse.initializeWithBinaryFile(binFile));
+   TUASSERT(!sse.isMapped());
+   TUTHROW(sse.relativePositionVelocity(
+              mjd0 + 1, SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv));
+   TUCATCH(sse.relativeInertialPositionVelocity(
+              mjd0 + 1, SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv));
+      // a missing file
+   SolarSystemEphemeris missing;
+   TUTHROW(missing.initializeWithMappedFile(binFile + ".missing"));
+   TUASSERT(!missing.isMapped());
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SolarSystemEphemeris_T testClass;
+
+   errorTotal += testClass.mappedVsStreamTest();
+   errorTotal += testClass.chebyshevTest();
+   errorTotal += testClass.mappedErrorTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
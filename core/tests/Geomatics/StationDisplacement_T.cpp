@@ -0,0 +1,309 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cmath>
+#include <fstream>
+#include "StationDisplacement.hpp"
+#include "SolidEarthTides.hpp"
+#include "SunEarthSatGeometry.hpp"
+#include "TestUtil.hpp"
+#include "build_config.h"
+
+using namespace std;
+using namespace gnsstk;
+
+class StationDisplacement_T
+{
+public:
+   StationDisplacement_T();
+      /// Check the harmonic ocean loading against OceanLoadTides
+   unsigned oceanTest();
+      /// Check the atmospheric loading against AtmLoadTides
+   unsigned atmTest();
+      /// Check solid Earth and pole tides, and the combination
+   unsigned solidPolarTest();
+
+      /// Write synthetic BLQ and ATL files and load the stores
+   void setUp();
+      /// Rotate NEU to ECEF XYZ at pos
+   Triple toXYZ(const Position& pos, const Triple& neu);
+      /// Synthetic Sun, Moon and EOP at t
+   StationDisplacement::EpochData epoch(const EphTime& t);
+
+   StationDisplacement engine;
+   OceanLoadTides ocean;
+   AtmLoadTides atm;
+   vector<string> names;
+   vector<Position> sites;
+   string blqFile, atlFile;
+};
+
+
+StationDisplacement_T ::
+StationDisplacement_T()
+{
+   blqFile = getPathTestTemp() + getFileSep() + "StationDisplacement_T.blq";
+   atlFile = getPathTestTemp() + getFileSep() + "StationDisplacement_T.atl";
+   names.push_back("ALPHA");
+   names.push_back("BRAVO");
+   names.push_back("NOLOAD");
+   sites.push_back(Position(-740289.9, -5457071.7, 3207245.6));
+   sites.push_back(Position(4075580.4, 931854.0, 4801568.2));
+   sites.push_back(Position(-2341333.0, -3539049.5, 4745791.3));
+   setUp();
+}
+
+
+void StationDisplacement_T ::
+setUp()
+{
+      // amplitudes (m) of U, W, S and phases (deg) of U, W, S for
+      // M2 S2 N2 K2 K1 O1 P1 Q1 Mf Mm Ssa; the last site has none.
+   ofstream blq(blqFile.c_str());
+   blq << "$$ synthetic ocean loading\n";
+   for (int s = 0; s < 2; s++)
+   {
+      blq << "  " << names[s] << "\n";
+      blq << "$$ lon/lat: " << (s ? 12.9 : -97.7) << " " << (s ? 49.1 : 30.3)
+          << " 0.0\n";
+      for (int r = 0; r < 6; r++)
+      {
+         for (int i = 0; i < 11; i++)
+         {
+            double v;
+            if (r < 3)
+               v = (0.012 - 0.001 * i + 0.002 * r + 0.003 * s) * (i < 8 ? 1 : 0.2);
+            else
+               v = fmod(37.0 * i + 71.0 * r + 113.0 * s, 360.0) - 180.0;
+            blq << " " << v;
+         }
+         blq << "\n";
+      }
+   }
+   blq.close();
+
+      // rows U, N, E of (cos1, sin1, cos2, sin2), mm
+   ofstream atl(atlFile.c_str());
+   for (int s = 0; s < 2; s++)
+   {
+      atl << names[s] << "\n";
+      atl << "$$ station " << names[s] << "; coord.(long,lat) "
+          << (s ? 12.9 : -97.7) << " " << (s ? 49.1 : 30.3) << "\n";
+      for (int r = 0; r < 3; r++)
+      {
+         for (int k = 0; k < 4; k++)
+            atl << " " << (0.3 * (r + 1) - 0.2 * k + 0.1 * s);
+         atl << "\n";
+      }
+   }
+   atl.close();
+
+   vector<string> want;
+   ocean.initializeSites(want, blqFile);
+   want.clear();
+   atm.initializeSites(want, atlFile);
+
+   for (size_t i = 0; i < names.size(); i++)
+      engine.addSite(names[i], sites[i]);
+}
+
+
+Triple StationDisplacement_T ::
+toXYZ(const Position& pos, const Triple& neu)
+{
+   Position p(pos);
+   Matrix<double> R(northEastUpGeodetic(p));
+   Triple xyz;
+   for (int i = 0; i < 3; i++)
+      xyz[i] = R(0, i) * neu[0] + R(1, i) * neu[1] + R(2, i) * neu[2];
+   return xyz;
+}
+
+
+StationDisplacement::EpochData StationDisplacement_T ::
+epoch(const EphTime& t)
+{
+   StationDisplacement::EpochData ed;
+   double d = t.dMJD() - 58000.0;
+   ed.time = t;
+   ed.sun  = Position(1.49e11 * cos(0.0172 * d + 6.3 * d),
+                      -1.49e11 * sin(0.0172 * d + 6.3 * d), 0.6e11);
+   ed.moon = Position(3.84e8 * cos(6.07 * d), -3.84e8 * sin(6.07 * d),
+                      1.2e8 * sin(0.23 * d));
+   ed.xp      = 0.05 + 0.01 * d;
+   ed.yp      = 0.30 - 0.02 * d;
+   ed.UT1mUTC = -0.2;
+   return ed;
+}
+
+
+unsigned StationDisplacement_T ::
+oceanTest()
+{
+   TUDEF("StationDisplacement", "computeEpoch");
+   TUASSERTE(int, 2, engine.setOceanLoading(ocean));
+   TUASSERTE(int, 3, engine.numberOfSites());
+
+   double maxerr = 0.0, maxdisp = 0.0;
+   vector<double> disp(3 * names.size());
+   for (double sec = 0.0; sec < 3 * 86400.0; sec += 3777.7)
+   {
+      EphTime t(58000, sec, TimeSystem::UTC);
+      engine.computeEpoch(epoch(t), &disp[0],
+                          StationDisplacement::OceanLoading);
+      for (int s = 0; s < 2; s++)
+      {
+         Triple xyz = toXYZ(sites[s], ocean.computeDisplacement(names[s], t));
+         for (int k = 0; k < 3; k++)
+         {
+            maxerr  = max(maxerr, fabs(xyz[k] - disp[3 * s + k]));
+            maxdisp = max(maxdisp, fabs(xyz[k]));
+         }
+      }
+         // no coefficients, no displacement
+      for (int k = 0; k < 3; k++)
+         TUASSERTE(double, 0.0, disp[6 + k]);
+   }
+   TUASSERT(maxdisp > 0.01);
+   TUASSERTFEPS(0.0, maxerr, 1.e-8);
+
+      // the harmonics alone reproduce computeDisplacement()
+   vector<double> harm, cosArg, sinArg;
+   ocean.getHarmonics(names[0], harm);
+   int n = OceanLoadTides::numberOfHarmonics();
+   TUASSERTE(size_t, size_t(6 * n), harm.size());
+   EphTime t(58001, 1234.5, TimeSystem::UTC);
+   OceanLoadTides::tideArguments(t, cosArg, sinArg);
+   Triple neu = ocean.computeDisplacement(names[0], t);
+   for (int k = 0; k < 3; k++)
+   {
+      double sum = 0.0;
+      for (int j = 0; j < n; j++)
+         sum += harm[2 * k * n + j] * cosArg[j] +
+                harm[(2 * k + 1) * n + j] * sinArg[j];
+      TUASSERTFEPS(neu[k], sum, 1.e-8);
+   }
+   TUTHROW(ocean.getHarmonics("UNKNOWN", harm));
+   TURETURN();
+}
+
+
+unsigned StationDisplacement_T ::
+atmTest()
+{
+   TUDEF("StationDisplacement", "computeEpoch");
+   TUASSERTE(int, 2, engine.setAtmLoading(atm));
+   TUTHROW(atm.getCoefficients("UNKNOWN"));
+
+   vector<double> disp(3 * names.size());
+   for (double sec = 0.0; sec < 86400.0; sec += 2111.1)
+   {
+      EphTime t(58000, sec, TimeSystem::GPS);
+      StationDisplacement::EpochData ed = epoch(t);
+      engine.computeEpoch(ed, &disp[0], StationDisplacement::AtmLoading);
+      for (int s = 0; s < 2; s++)
+      {
+         Triple xyz =
+            toXYZ(sites[s], atm.computeDisplacement(names[s], t, ed.UT1mUTC));
+         for (int k = 0; k < 3; k++)
+            TUASSERTFEPS(xyz[k], disp[3 * s + k], 1.e-12);
+      }
+      for (int k = 0; k < 3; k++)
+         TUASSERTE(double, 0.0, disp[6 + k]);
+   }
+   TURETURN();
+}
+
+
+unsigned StationDisplacement_T ::
+solidPolarTest()
+{
+   TUDEF("StationDisplacement", "computeEpoch");
+   engine.setOceanLoading(ocean);
+   engine.setAtmLoading(atm);
+
+   vector<double> disp(3 * names.size()), part(3 * names.size()),
+      sum(3 * names.size());
+   for (double sec = 0.0; sec < 86400.0; sec += 7200.0)
+   {
+      EphTime t(58002, sec, TimeSystem::UTC);
+      StationDisplacement::EpochData ed = epoch(t);
+      engine.computeEpoch(ed, &disp[0],
+                          StationDisplacement::SolidTide |
+                             StationDisplacement::PolarTide);
+      for (size_t s = 0; s < names.size(); s++)
+      {
+         Triple set = computeSolidEarthTides(sites[s], t, ed.sun, ed.moon);
+         Triple pol = computePolarTides(sites[s], t, ed.xp, ed.yp);
+         for (int k = 0; k < 3; k++)
+            TUASSERTFEPS(set[k] + pol[k], disp[3 * s + k], 1.e-12);
+      }
+
+         // all effects are the sum of the parts
+      fill(sum.begin(), sum.end(), 0.0);
+      unsigned effects[4] = {StationDisplacement::SolidTide,
+                             StationDisplacement::PolarTide,
+                             StationDisplacement::OceanLoading,
+                             StationDisplacement::AtmLoading};
+      for (int e = 0; e < 4; e++)
+      {
+         engine.computeEpoch(ed, &part[0], effects[e]);
+         for (size_t i = 0; i < sum.size(); i++)
+            sum[i] += part[i];
+      }
+      engine.computeEpoch(ed, &disp[0]);
+      for (size_t i = 0; i < sum.size(); i++)
+         TUASSERTFEPS(sum[i], disp[i], 1.e-12);
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   StationDisplacement_T testClass;
+
+   errorTotal += testClass.oceanTest();
+   errorTotal += testClass.atmTest();
+   errorTotal += testClass.solidPolarTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,318 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cmath>
+#include <random>
+#include "FreqConsts.hpp"
+#include "gdcStream.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /// gives the test access to the Arcs found by gdc
+class gdcAccess : public gdc
+{
+public:
+   const map<int, Arc>& getArcs() const { return Arcs; }
+};
+
+class gdcStream_T
+{
+public:
+   gdcStream_T();
+      /// Compare the slips found by gdcStream and by gdc on a synthetic pass
+   unsigned gdcTest();
+      /// Check the latency and order of the decisions
+   unsigned latencyTest();
+      /// Check several satellites interleaved, and errors
+   unsigned multiSatTest();
+
+      /** Synthesize a pass of dual-frequency data with slips, an outlier and
+          a gap. Missing epochs have zero data and flag 0. */
+   void makePass(int seed, vector<double>& L1, vector<double>& L2,
+                 vector<double>& P1, vector<double>& P2, vector<int>& flags);
+
+   RinexSatID sat;
+   Epoch beg;
+   double DT;
+   int npts;
+};
+
+
+gdcStream_T ::
+gdcStream_T()
+      : sat(5, SatelliteSystem::GPS), DT(30.0), npts(400)
+{
+   beg = Epoch(CivilTime(2020, 3, 1, 0, 0, 0.0, TimeSystem::GPS));
+}
+
+
+void gdcStream_T ::
+makePass(int seed, vector<double>& L1, vector<double>& L2, vector<double>& P1,
+         vector<double>& P2, vector<int>& flags)
+{
+   const double wl1 = getWavelength(SatelliteSystem::GPS, 1);
+   const double wl2 = getWavelength(SatelliteSystem::GPS, 2);
+   const double beta = wl2 / wl1;
+   mt19937 gen(seed);
+   uniform_real_distribution<double> uni(0.0, 1.0);
+   auto gauss = [&]() {
+      return ::sqrt(-2.0 * ::log(1.0 - uni(gen))) * ::cos(2 * M_PI * uni(gen));
+   };
+
+   L1.clear(); L2.clear(); P1.clear(); P2.clear(); flags.clear();
+   double n1(1234567.0), n2(-7654321.0);
+   for (int i = 0; i < npts; i++)
+   {
+      double t = i * DT;
+      double rho = 2.2e7 + 600.0 * t - 0.02 * t * t;
+      double I1 = 5.0 + 2.0 * sin(t / 3000.0);
+      double I2 = I1 * beta * beta;
+
+         // slips (n1,n2): WL n1-n2, GF -n1 after the WL fix
+      if (i == 120) { n1 += 3; n2 += 2; }
+      if (i == 200) { n1 += 1; n2 += 1; }
+      if (i == 280) { n1 += 20; n2 += 25; }
+
+      if (i >= 350 && i < 366)
+      {  // gap
+         L1.push_back(0.0); L2.push_back(0.0);
+         P1.push_back(0.0); P2.push_back(0.0);
+         flags.push_back(0);
+         continue;
+      }
+      L1.push_back((rho - I1) / wl1 + n1 + 0.003 * gauss());
+      L2.push_back((rho - I2) / wl2 + n2 + 0.003 * gauss());
+      P1.push_back(rho + I1 + 0.15 * gauss() + (i == 330 ? 8.0 : 0.0));
+      P2.push_back(rho + I2 + 0.15 * gauss());
+      flags.push_back(1);
+   }
+}
+
+
+unsigned gdcStream_T ::
+gdcTest()
+{
+   TUDEF("gdcStream", "add");
+
+   for (int seed = 1; seed <= 5; seed++)
+   {
+      vector<double> L1, L2, P1, P2, dts;
+      vector<int> flags;
+      makePass(seed, L1, L2, P1, P2, flags);
+      for (int i = 0; i < npts; i++)
+         dts.push_back(i * DT);
+
+         // batch
+      gdcAccess batch;
+      string msg;
+      vector<string> cmds;
+      batch.setParameter("debug", -1);
+      batch.DiscontinuityCorrector(sat, DT, beg, L1, L2, P1, P2, dts, flags,
+                                   msg, cmds);
+      map<int, pair<int, int>> gdcSlips;   // index, (NWL, NGF)
+      map<int, Arc>::const_iterator it;
+      for (it = batch.getArcs().begin(); it != batch.getArcs().end(); ++it)
+      {
+         if (it->second.mark & (Arc::WLSLIP | Arc::GFSLIP))
+            gdcSlips[it->first] = make_pair(it->second.WLinfo.Nslip,
+                                            it->second.GFinfo.Nslip);
+      }
+
+         // streaming
+      gdcStream stream(DT);
+      vector<gdcStream::Decision> out;
+      for (int i = 0; i < npts; i++)
+      {
+         Epoch t(beg);
+         t += i * DT;
+         stream.add(sat, t, L1[i], L2[i], P1[i], P2[i], out, flags[i] == 1);
+      }
+      stream.flush(out);
+      TUASSERTE(size_t, size_t(npts), out.size());
+
+      map<int, pair<int, int>> streamSlips;
+      vector<int> begs;
+      for (int i = 0; i < int(out.size()); i++)
+      {
+         if (out[i].mark & (Arc::WLSLIP | Arc::GFSLIP))
+            streamSlips[i] = make_pair(out[i].NWL, out[i].NGF);
+         if (out[i].mark & Arc::BEG)
+            begs.push_back(i);
+      }
+
+         // the injected slips, found and fixed identically
+      map<int, pair<int, int>> expected;
+      expected[120] = make_pair(1, -3);
+      expected[200] = make_pair(0, -1);
+      expected[280] = make_pair(-5, -20);
+      TUASSERT(expected == gdcSlips);
+      TUASSERT(gdcSlips == streamSlips);
+
+         // the outlier, and the Arc after the gap
+      TUASSERTE(unsigned, unsigned(gdcStream::WLOUTLIER), out[330].flag);
+      TUASSERTE(size_t, 2, begs.size());
+      TUASSERTE(int, 0, begs[0]);
+      TUASSERTE(int, 366, begs[1]);
+      for (int i = 350; i < 366; i++)
+         TUASSERTE(unsigned, unsigned(gdcStream::BAD), out[i].flag);
+   }
+   TURETURN();
+}
+
+
+unsigned gdcStream_T ::
+latencyTest()
+{
+   TUDEF("gdcStream", "add");
+   vector<double> L1, L2, P1, P2;
+   vector<int> flags;
+   makePass(7, L1, L2, P1, P2, flags);
+
+   gdcStream stream(DT);
+   stream.setParameter("lookahead", 3);
+   TUASSERTE(double, 3.0, stream.getParameter("lookahead"));
+   TUASSERT(!stream.setParameter("nonsense", 1.0));
+   TUTHROW(stream.getParameter("nonsense"));
+   TUTHROW(stream.setParameter("width", 2));
+   TUTHROW(stream.setParameter("lookahead", -1));
+   TUASSERTE(double, 3.0, stream.getParameter("lookahead"));
+
+   vector<gdcStream::Decision> out;
+   for (int i = 0; i < 100; i++)
+   {
+      Epoch t(beg);
+      t += i * DT;
+      size_t before = out.size();
+      stream.add(sat, t, L1[i], L2[i], P1[i], P2[i], out);
+         // each epoch is decided once 3 more have arrived
+      TUASSERTE(size_t, (i < 3 ? 0 : 1), out.size() - before);
+   }
+   for (int i = 0; i < int(out.size()); i++)
+   {
+      Epoch t(beg);
+      t += i * DT;
+      TUASSERTE(Epoch, t, out[i].time);
+   }
+   stream.flush(out);
+   TUASSERTE(size_t, 100, out.size());
+
+      // a good point followed by a long run of bad ones (a satellite that
+      // has set, left in the input as zeros) is decided after MaxGap
+   gdcStream gapStream(DT);
+   gapStream.setParameter("lookahead", 3);
+   gapStream.setParameter("MaxGap", 10);
+   out.clear();
+   size_t maxPending(0);
+   for (int i = 0; i < 200; i++)
+   {
+      Epoch t(beg);
+      t += i * DT;
+      if (i < 100)
+         gapStream.add(sat, t, L1[i], L2[i], P1[i], P2[i], out);
+      else
+         gapStream.add(sat, t, 0.0, 0.0, 0.0, 0.0, out);
+      maxPending = max(maxPending, size_t(i + 1) - out.size());
+   }
+   TUASSERTE(size_t, 200, out.size());
+   TUASSERT(maxPending <= 3 + 10 + 1);
+   TUASSERTE(unsigned, gdcStream::OK, out[99].flag);
+   TUASSERTE(unsigned, gdcStream::BAD, out[199].flag);
+   TURETURN();
+}
+
+
+unsigned gdcStream_T ::
+multiSatTest()
+{
+   TUDEF("gdcStream", "add");
+   vector<double> L1, L2, P1, P2;
+   vector<int> flags;
+   makePass(3, L1, L2, P1, P2, flags);
+
+   RinexSatID sat2(9, SatelliteSystem::GPS);
+   RinexSatID glo(4, SatelliteSystem::Glonass);
+   gdcStream stream(DT);
+   vector<gdcStream::Decision> out, out1, out2;
+   for (int i = 0; i < npts; i++)
+   {
+      Epoch t(beg);
+      t += i * DT;
+      stream.add(sat, t, L1[i], L2[i], P1[i], P2[i], out, flags[i] == 1);
+         // the second satellite has the same data, one epoch later
+      if (i > 0)
+      {
+         t += -DT;
+         stream.add(sat2, t, L1[i - 1], L2[i - 1], P1[i - 1], P2[i - 1], out,
+                    flags[i - 1] == 1);
+      }
+   }
+   stream.flush(out);
+   for (size_t i = 0; i < out.size(); i++)
+      (out[i].sat == sat ? out1 : out2).push_back(out[i]);
+   TUASSERTE(size_t, size_t(npts), out1.size());
+   TUASSERTE(size_t, size_t(npts - 1), out2.size());
+   for (int i = 0; i < npts - 1; i++)
+   {
+      TUASSERTE(unsigned, out1[i].mark, out2[i].mark);
+      TUASSERTE(unsigned, out1[i].flag, out2[i].flag);
+   }
+
+   Epoch t(beg);
+   TUTHROW(stream.add(sat, t, L1[0], L2[0], P1[0], P2[0], out));
+   TUTHROW(stream.add(glo, t, L1[0], L2[0], P1[0], P2[0], out));
+   stream.setGLOchannel(glo, -2);
+   TUCATCH(stream.add(glo, t, L1[0], L2[0], P1[0], P2[0], out));
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   gdcStream_T testClass;
+
+   errorTotal += testClass.gdcTest();
+   errorTotal += testClass.latencyTest();
+   errorTotal += testClass.multiSatTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,188 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file ClockDeviation_T.cpp Test ClockDeviationStream against known answers
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "ClockDeviation.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class ClockDeviation_T
+{
+public:
+   ClockDeviation_T()
+   {
+         // deterministic Gaussian white noise, unit sigma (Box-Muller)
+      unsigned long seed(4321);
+      const double twopi(6.283185307179586);
+      for(unsigned int i=0; i<100000; i += 2) {
+         double u[2];
+         for(unsigned int k=0; k<2; k++) {
+            seed = (1103515245UL*seed + 12345UL) % 2147483648UL;
+            u[k] = (double(seed) + 1.0)/2147483649.0;
+         }
+         double r(std::sqrt(-2.0*std::log(u[0])));
+         noise.push_back(r*std::cos(twopi*u[1]));
+         noise.push_back(r*std::sin(twopi*u[1]));
+      }
+   }
+
+      /// linear frequency drift D: every second difference at tau is
+      /// D*tau^2, so adev = mdev = D*tau/sqrt(2), and hdev = 0
+   unsigned driftTest()
+   {
+      TUDEF("ClockDeviationStream", "drift");
+      const double tau0(30.0), D(1.e-14), eps(1.e-9);
+      ClockDeviationStream cds(tau0, 64);
+      vector<double> phase;
+      for(unsigned int i=0; i<1000; i++) {
+         double t(tau0*i), x(2.e-6 + 3.e-11*t + 0.5*D*t*t);
+         cds.add(x);
+         phase.push_back(x);
+      }
+      vector<DeviationPoint> devs(cds.getDeviations());
+      TUASSERTE(size_t, 7, devs.size());
+      for(unsigned int k=0; k<devs.size(); k++) {
+         const DeviationPoint& dp(devs[k]);
+         const double ref(D*dp.tau/std::sqrt(2.0));
+         TUASSERTE(unsigned, 1U << k, dp.m);
+         TUASSERTFE(tau0*dp.m, dp.tau);
+         TUASSERTFEPS(ref, dp.adev, eps*ref);
+         TUASSERTFEPS(ref, dp.mdev, eps*ref);
+         TUASSERTFEPS(dp.tau*ref/std::sqrt(3.0), dp.tdev, eps*dp.tau*ref);
+         TUASSERT(dp.hdev < 1.e-6*ref);
+         TUASSERTE(unsigned long, 1000 - 2*dp.m, dp.nAllan);
+         TUASSERTE(unsigned long, 1000 - 3*dp.m + 1, dp.nMod);
+         TUASSERTE(unsigned long, 1000 - 3*dp.m, dp.nHadamard);
+      }
+
+         // the batch computation gives the same answer
+      vector<DeviationPoint> batch(ClockDeviationStream::compute(
+         phase, tau0, ClockDeviationStream::octaveFactors(phase.size()), 2));
+      TUASSERTE(size_t, 9, batch.size());
+      for(unsigned int k=0; k<devs.size(); k++) {
+         TUASSERTE(unsigned, devs[k].m, batch[k].m);
+         TUASSERTFEPS(devs[k].adev, batch[k].adev, eps*devs[k].adev);
+         TUASSERTFEPS(devs[k].mdev, batch[k].mdev, eps*devs[k].mdev);
+         TUASSERTE(unsigned long, devs[k].nHadamard, batch[k].nHadamard);
+      }
+      TUTHROW(ClockDeviationStream(0.0, 8));
+      TUTHROW(ClockDeviationStream(1.0, 0));
+      TURETURN();
+   }
+
+      /// white phase noise of sigma s: the second and third differences
+      /// have variances 6*s^2 and 20*s^2 at every m, so
+      /// adev = sqrt(3)*s/tau and hdev = sqrt(10/3)*s/tau
+   unsigned whitePhaseTest()
+   {
+      TUDEF("ClockDeviationStream", "white phase");
+      const double tau0(1.0), s(1.e-9);
+      ClockDeviationStream cds(tau0, 16);
+      for(unsigned int i=0; i<noise.size(); i++)
+         cds.add(s*noise[i]);
+      vector<DeviationPoint> devs(cds.getDeviations());
+      TUASSERTE(size_t, 5, devs.size());
+      for(unsigned int k=0; k<devs.size(); k++) {
+         const double tau(devs[k].tau);
+         TUASSERTFEPS(std::sqrt(3.0)*s/tau, devs[k].adev, 0.02*s/tau);
+         TUASSERTFEPS(std::sqrt(10.0/3.0)*s/tau, devs[k].hdev, 0.02*s/tau);
+            // modified Allan falls as tau^-3/2
+         if(k > 0)
+            TUASSERT(devs[k].mdev < devs[k-1].mdev/2.0);
+      }
+
+         // a gap: no differences across it, the sums are pooled
+      ClockDeviationStream gap(tau0, 4);
+      for(unsigned int i=0; i<noise.size()/2; i++)
+         gap.add(s*noise[i]);
+      gap.restart();
+      for(unsigned int i=noise.size()/2; i<noise.size(); i++)
+         gap.add(s*noise[i]);
+      TUASSERTE(unsigned long, noise.size(), gap.size());
+      vector<DeviationPoint> gdevs(gap.getDeviations());
+      TUASSERTE(unsigned long, noise.size() - 4, gdevs[0].nAllan);
+      TUASSERTFEPS(devs[0].adev, gdevs[0].adev, 0.01*devs[0].adev);
+      gap.reset();
+      TUASSERTE(unsigned long, 0, gap.size());
+      TUASSERT(gap.getDeviations().empty());
+      TURETURN();
+   }
+
+      /// dump() must not change the format of the caller's stream
+   unsigned dumpTest()
+   {
+      TUDEF("ClockDeviationStream", "dump");
+      ClockDeviationStream cds(1.0, 4);
+      for(unsigned int i=0; i<100; i++)
+         cds.add(1.e-9*noise[i]);
+      ostringstream oss;
+      oss << 1.5;
+      const ios_base::fmtflags flags(oss.flags());
+      const streamsize prec(oss.precision());
+      oss << cds;
+      TUASSERT(flags == oss.flags());
+      TUASSERTE(streamsize, prec, oss.precision());
+      oss.str("");
+      oss << 2.5;
+      TUASSERTE(string, "2.5", oss.str());
+      TURETURN();
+   }
+
+   vector<double> noise;
+};
+
+int main()
+{
+   unsigned errorTotal = 0;
+   ClockDeviation_T testClass;
+
+   errorTotal += testClass.driftTest();
+   errorTotal += testClass.whitePhaseTest();
+   errorTotal += testClass.dumpTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
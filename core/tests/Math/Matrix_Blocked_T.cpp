@@ -0,0 +1,166 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <iostream>
+#include <cmath>
+
+#include "Matrix.hpp"
+#include "Vector.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+   // Deterministic, well-conditioned test data; the blocked paths are
+   // only taken for matrices larger than MatrixKernels::minBlockedDim.
+gnsstk::Matrix<double> testMatrix(size_t r, size_t c, double seed)
+{
+   gnsstk::Matrix<double> m(r,c);
+   for (size_t i = 0; i < r; i++)
+      for (size_t j = 0; j < c; j++)
+         m(i,j) = std::sin(seed + 0.37*i + 1.13*j) + (i==j ? 2.0 : 0.0);
+   return m;
+}
+
+   // textbook product used as the reference
+gnsstk::Matrix<double> naiveMult(const gnsstk::Matrix<double>& l,
+                                 const gnsstk::Matrix<double>& r)
+{
+   gnsstk::Matrix<double> rv(l.rows(), r.cols(), 0.0);
+   for (size_t i = 0; i < rv.rows(); i++)
+      for (size_t j = 0; j < rv.cols(); j++)
+         for (size_t k = 0; k < l.cols(); k++)
+            rv(i,j) += l(i,k) * r(k,j);
+   return rv;
+}
+
+
+int multiplyTest()
+{
+   TUDEF("Matrix", "operator*(blocked)");
+      // sizes straddling the block size and not multiples of it
+   size_t dims[][3] = { {40,50,45}, {130,70,97}, {65,129,64} };
+   for (unsigned t = 0; t < 3; t++)
+   {
+      gnsstk::Matrix<double> A(testMatrix(dims[t][0], dims[t][1], t)),
+         B(testMatrix(dims[t][1], dims[t][2], t+0.5));
+      gnsstk::Matrix<double> ref(naiveMult(A,B)), got(A*B);
+      TUASSERTE(size_t, ref.rows(), got.rows());
+      TUASSERTE(size_t, ref.cols(), got.cols());
+      TUASSERTFEPS(ref, got, 1e-12);
+   }
+      // slices take the same path via a contiguous copy
+   gnsstk::Matrix<double> A(testMatrix(100,100,3.0));
+   gnsstk::MatrixSlice<double> S(A, 10, 20, 60, 50);
+   gnsstk::Matrix<double> Sm(S);
+   TUASSERTFEPS(naiveMult(Sm,transpose(Sm)), S*transpose(Sm), 1e-12);
+   TURETURN();
+}
+
+
+int choleskyTest()
+{
+   TUDEF("Cholesky", "operator()(blocked)");
+   size_t N = 150;
+   gnsstk::Matrix<double> X(testMatrix(N,N,1.0));
+   gnsstk::Matrix<double> A(naiveMult(X,transpose(X)));
+   double eps = 1e-9;
+
+   gnsstk::Cholesky<double> C;
+   C(A);
+   TUASSERTFEPS(A, naiveMult(C.L, transpose(C.L)), eps);
+   TUASSERTFEPS(A, naiveMult(C.U, transpose(C.U)), eps);
+   bool triang = true;
+   for (size_t i = 0; i < N; i++)
+      for (size_t j = i+1; j < N; j++)
+         if (C.L(i,j) != 0.0 || C.U(j,i) != 0.0)
+            triang = false;
+   TUASSERT(triang);
+
+   gnsstk::Vector<double> x(N), b(N);
+   for (size_t i = 0; i < N; i++)
+      x(i) = std::cos(0.1*i);
+   b = A * x;
+   C.backSub(b);
+   TUASSERTFEPS(x, b, 1e-8);
+
+   gnsstk::CholeskyCrout<double> CC;
+   CC(A);
+   TUASSERTFEPS(C.L, CC.L, eps);
+   TUASSERTFEPS(A, naiveMult(transpose(CC.U), CC.U), eps);
+
+      // not positive definite
+   A(N/2,N/2) = -1.0;
+   TUTHROW(C(A));
+   TUTHROW(CC(A));
+   TURETURN();
+}
+
+
+int householderTest()
+{
+   TUDEF("Householder", "operator()(blocked)");
+      // tall, with the last (data) column left unreduced
+   size_t r = 140, c = 90;
+   gnsstk::Matrix<double> A(testMatrix(r,c,2.0));
+   gnsstk::Householder<double> HH;
+   HH(A);
+   TUASSERTE(size_t, r, HH.A.rows());
+   TUASSERTE(size_t, c, HH.A.cols());
+   bool triang = true;
+   for (size_t j = 0; j+1 < c; j++)
+      for (size_t i = j+1; i < r; i++)
+         if (HH.A(i,j) != 0.0)
+            triang = false;
+   TUASSERT(triang);
+      // Q is orthogonal, so transpose(R)*R == transpose(A)*A
+   TUASSERTFEPS(naiveMult(transpose(A),A),
+                naiveMult(transpose(HH.A),HH.A), 1e-9);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   errorTotal += multiplyTest();
+   errorTotal += choleskyTest();
+   errorTotal += householderTest();
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+   return errorTotal;
+}
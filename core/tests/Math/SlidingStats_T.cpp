@@ -0,0 +1,197 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file SlidingStats_T.cpp Test SlidingStats against Stats and TwoSampleStats
+
+#include <cmath>
+#include <deque>
+#include <iostream>
+#include <vector>
+#include "SlidingStats.hpp"
+#include "Stats.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class SlidingStats_T
+{
+public:
+   SlidingStats_T()
+   {
+         // deterministic pseudo-random noise in [-0.5,0.5)
+      unsigned long seed(12345);
+      for(unsigned int i=0; i<2000; i++) {
+         seed = (1103515245UL*seed + 12345UL) % 2147483648UL;
+         noise.push_back(double(seed)/2147483648.0 - 0.5);
+      }
+   }
+
+      /// compare the sliding window with TwoSampleStats of each window
+   unsigned windowTest()
+   {
+      TUDEF("SlidingStats", "Add/Subtract");
+      const unsigned int W(20);
+      const double eps(1.e-9);
+      SlidingStats<double> ss;
+      for(unsigned int i=0; i<noise.size(); i++) {
+         double x(30.*i), y(5. + 0.01*x + noise[i]);
+         ss.Add(x, y);
+         if(i >= W) {
+            double xo(30.*(i-W));
+            ss.Subtract(xo, 5. + 0.01*xo + noise[i-W]);
+         }
+         if(i % 97 != 0 || i < W) continue;
+
+         TwoSampleStats<double> tss;
+         for(unsigned int j=i+1-W; j<=i; j++)
+            tss.Add(30.*j, 5. + 0.3*j + noise[j]);
+         TUASSERTE(unsigned int, tss.N(), ss.N());
+         TUASSERTFEPS(tss.AverageX(), ss.AverageX(), eps);
+         TUASSERTFEPS(tss.AverageY(), ss.AverageY(), eps);
+         TUASSERTFEPS(tss.VarianceX(), ss.VarianceX(), eps*tss.VarianceX());
+         TUASSERTFEPS(tss.VarianceY(), ss.VarianceY(), eps);
+         TUASSERTFEPS(tss.Slope(), ss.Slope(), eps);
+         TUASSERTFEPS(tss.Intercept(), ss.Intercept(), eps*10000);
+         TUASSERTFEPS(tss.Correlation(), ss.Correlation(), eps);
+         TUASSERTFEPS(tss.VarianceYX(), ss.VarianceYX(), eps);
+         TUASSERTFEPS(tss.SigmaSlope(), ss.SigmaSlope(), eps);
+         TUASSERTFEPS(tss.Evaluate(30.*i), ss.Evaluate(30.*i), eps);
+      }
+
+         // subtract out of order, then empty the window
+      SlidingStats<double> s2;
+      TwoSampleStats<double> t2;
+      for(unsigned int i=0; i<5; i++) {
+         s2.Add(i, noise[i]);
+         if(i != 2) t2.Add(i, noise[i]);
+      }
+      s2.Subtract(2., noise[2]);
+      TUASSERTE(unsigned int, 4, s2.N());
+      TUASSERTFEPS(t2.Slope(), s2.Slope(), eps);
+      TUASSERTFEPS(t2.VarianceY(), s2.VarianceY(), eps);
+      s2.Subtract(99., 99.);                       // not in the window
+      TUASSERTE(unsigned int, 4, s2.N());
+      for(unsigned int i=0; i<5; i++)
+         if(i != 2) s2.Subtract(i, noise[i]);
+      TUASSERTE(unsigned int, 0, s2.N());
+      TUASSERTFE(0.0, s2.AverageY());
+      TUASSERTFE(0.0, s2.VarianceY());
+      TUASSERTFE(0.0, s2.Slope());
+
+      TURETURN();
+   }
+
+      /// compare one-sample use with Stats
+   unsigned oneSampleTest()
+   {
+      TUDEF("SlidingStats", "Average/StdDev");
+      const unsigned int W(8);
+      SlidingStats<double> ss;
+      for(unsigned int i=0; i<200; i++) {
+         ss.Add(noise[i]);
+         if(i >= W) ss.Subtract(noise[i-W]);
+         Stats<double> st;
+         for(unsigned int j=(i >= W ? i+1-W : 0); j<=i; j++)
+            st.Add(noise[j]);
+         TUASSERTE(unsigned int, st.N(), ss.N());
+         TUASSERTFEPS(st.Average(), ss.Average(), 1.e-12);
+         TUASSERTFEPS(st.StdDev(), ss.StdDev(), 1.e-12);
+         TUASSERTFE(0.0, ss.Slope());
+      }
+      TURETURN();
+   }
+
+      /// a day of 1Hz data with large x and y; compare the window at the end
+      /// of the day with a two-pass computation
+   unsigned longSeriesTest()
+   {
+      TUDEF("SlidingStats", "long series");
+      const unsigned int W(60), NPTS(86400);
+      const double x0(1.4e9), y0(2.2e7);
+      SlidingStats<double> ss;
+      deque<double> xs, ys;
+      for(unsigned int i=0; i<NPTS; i++) {
+         double x(x0 + i), y(y0 + 700.*i + 0.01*noise[i % noise.size()]);
+         ss.Add(x, y);
+         xs.push_back(x); ys.push_back(y);
+         if(xs.size() > W) {
+            ss.Subtract(xs.front(), ys.front());
+            xs.pop_front(); ys.pop_front();
+         }
+      }
+
+      double mx(0), my(0), sxx(0), syy(0), sxy(0);
+      for(unsigned int i=0; i<W; i++) { mx += xs[i]; my += ys[i]; }
+      mx /= W; my /= W;
+      for(unsigned int i=0; i<W; i++) {
+         sxx += (xs[i]-mx)*(xs[i]-mx);
+         syy += (ys[i]-my)*(ys[i]-my);
+         sxy += (xs[i]-mx)*(ys[i]-my);
+      }
+      double slope(sxy/sxx), vyx((syy - sxy*sxy/sxx)/(W-2));
+
+      TUASSERTE(unsigned int, W, ss.N());
+      TUASSERTFEPS(mx, ss.AverageX(), 1.e-6);
+      TUASSERTFEPS(my, ss.AverageY(), 1.e-6);
+      TUASSERTFEPS(sxx/(W-1), ss.VarianceX(), 1.e-9);
+      TUASSERTFEPS(slope, ss.Slope(), 1.e-9);
+         // the residual scatter is 1e-2*noise, i.e. ~3e-3; it must not be
+         // lost in the variance of y, which is ~1.5e8
+      TUASSERTFEPS(std::sqrt(vyx), ss.SigmaYX(), 1.e-5);
+      TUASSERT(ss.SigmaYX() > 1.e-3 && ss.SigmaYX() < 1.e-2);
+
+      TURETURN();
+   }
+
+   vector<double> noise;
+};
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SlidingStats_T testClass;
+
+   errorTotal += testClass.windowTest();
+   errorTotal += testClass.oneSampleTest();
+   errorTotal += testClass.longSeriesTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
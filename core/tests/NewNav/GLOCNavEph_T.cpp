@@ -77,6 +77,7 @@ public:
    unsigned getXvtExactTest();
    unsigned getXvtSimpleTest();
    unsigned getXvtLTTest();
+   unsigned getXvtDenseTest();
    unsigned getUserTimeTest();
    unsigned fixFitTest();
    unsigned haveLTDMPTest();
@@ -268,6 +269,82 @@ getXvtLTTest()
 }
 
 
+unsigned GLOCNavEph_T ::
+getXvtDenseTest()
+{
+   TUDEF("GLOCNavEph", "getXvt(dense)");
+   gnsstk::GLOCNavEph uut, ref;
+   gnsstk::Xvt got, exp;
+   uut.pos[0] = 2290.0216875;
+   uut.vel[0] = -0.43945587147;
+   uut.acc[0] = -2.2591848392e-9;
+   uut.ltdmp.dax0 = -1.3642421e-12;
+   uut.ltdmp.ax1 = -1.6237011735e-13;
+   uut.ltdmp.ax2 = 1.7485470537e-16;
+   uut.ltdmp.ax3 = -1.0455562943e-20;
+   uut.ltdmp.ax4 = 5.3011452831e-26;
+   uut.pos[1] = 19879.8775810;
+   uut.vel[1] = 2.12254652940;
+   uut.acc[1] = 2.4629116524e-9;
+   uut.ltdmp.day0 = 1.1368684e-12;
+   uut.ltdmp.ay1 = 1.2870815524e-12;
+   uut.ltdmp.ay2 = 2.6054733458e-17;
+   uut.ltdmp.ay3 = -2.2786344334e-20;
+   uut.ltdmp.ay4 = 1.0112818152e-24;
+   uut.pos[2] = 15820.0775420;
+   uut.vel[2] = -2.61032191480;
+   uut.acc[2] = -3.3505784813e-9;
+   uut.ltdmp.daz0 = -1.5916158e-12;
+   uut.ltdmp.az1 = -1.3594680937e-13;
+   uut.ltdmp.az2 = -1.5930995672e-17;
+   uut.ltdmp.az3 = 1.1662419456e-20;
+   uut.ltdmp.az4 = -5.5518137243e-25;
+   uut.tb = uut.ltdmp.tb31 = uut.ltdmp.tb32 = 30600;
+   uut.Toe = gnsstk::YDSTime(2013, 12, uut.tb, gnsstk::TimeSystem::GLO);
+   ref = uut;
+   ref.step = 1.0;
+   uut.dense = true;
+      // simplified algorithm only, no LTDMP
+   for (double dt = -900; dt <= 3600; dt += 97.3)
+   {
+      TUASSERTE(bool, true, uut.getXvt(uut.Toe + dt, got));
+      TUASSERTE(bool, true, ref.getXvt(ref.Toe + dt, exp));
+      for (unsigned i = 0; i < 3; i++)
+      {
+         TUASSERTFEPS(exp.x[i], got.x[i], 1e-4);
+         TUASSERTFEPS(exp.v[i], got.v[i], 1e-7);
+      }
+   }
+      // enable the LTDMP, which selects a different algorithm
+      // beyond 15 minutes.
+   uut.header11.svid = uut.ltdmp.header31.svid = uut.ltdmp.header32.svid = 1;
+   ref.header11.svid = ref.ltdmp.header31.svid = ref.ltdmp.header32.svid = 1;
+   for (double dt = 14400; dt >= -900; dt -= 197.3)
+   {
+      TUASSERTE(bool, true, uut.getXvt(uut.Toe + dt, got));
+      TUASSERTE(bool, true, ref.getXvt(ref.Toe + dt, exp));
+      for (unsigned i = 0; i < 3; i++)
+      {
+         TUASSERTFEPS(exp.x[i], got.x[i], 1e-4);
+         TUASSERTFEPS(exp.v[i], got.v[i], 1e-7);
+      }
+   }
+      // ICD example, as in getXvtLTTest.  The example was computed
+      // with 1 minute Runge-Kutta steps, which differ from the dense
+      // orbit (and from 1 second steps) by about a millimeter.
+   TUASSERTE(bool, true,
+             uut.getXvt(gnsstk::YDSTime(2013, 12, 45000,
+                                        gnsstk::TimeSystem::GLO), got));
+   TUASSERTFEPS(-5994716.3090, got.x[0], 5e-3);
+   TUASSERTFEPS(-2219.22119660, got.v[0], 1e-6);
+   TUASSERTFEPS(9242469.6773, got.x[1], 5e-3);
+   TUASSERTFEPS(-2241.57215710, got.v[1], 5e-6);
+   TUASSERTFEPS(-22981999.9270, got.x[2], 5e-3);
+   TUASSERTFEPS(-325.35557997, got.v[2], 1e-6);
+   TURETURN();
+}
+
+
 unsigned GLOCNavEph_T ::
 getUserTimeTest()
 {
@@ -348,6 +425,7 @@ int main()
    errorTotal += testClass.getXvtExactTest();
    errorTotal += testClass.getXvtSimpleTest();
    errorTotal += testClass.getXvtLTTest();
+   errorTotal += testClass.getXvtDenseTest();
    errorTotal += testClass.getUserTimeTest();
    errorTotal += testClass.fixFitTest();
    errorTotal += testClass.haveLTDMPTest();
@@ -0,0 +1,250 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#include <cmath>
+#include "TestUtil.hpp"
+#include "GLODenseOrbit.hpp"
+
+   /// Circular motion with angular rate w, an exact solution is known.
+class CircleForce : public gnsstk::GLODenseOrbit::Force
+{
+public:
+   CircleForce(double rate)
+         : w(rate), calls(0)
+   {}
+   void accel(double t, const double pos[3], const double vel[3],
+              double acc[3]) const override
+   {
+      calls++;
+      for (unsigned i = 0; i < 3; i++)
+         acc[i] = -w*w*pos[i];
+   }
+   static void truth(double w, double r, double t, double pos[3],
+                     double vel[3])
+   {
+      pos[0] = r*std::cos(w*t);
+      pos[1] = r*std::sin(w*t);
+      pos[2] = 0;
+      vel[0] = -r*w*std::sin(w*t);
+      vel[1] = r*w*std::cos(w*t);
+      vel[2] = 0;
+   }
+   double w;
+   mutable unsigned long calls;
+};
+
+
+   /** The same circular motion, computed analytically, with a jump
+    * in position at t=1000. Velocities are scaled so that they are
+    * not the derivative of the position. */
+class CircleSampler : public gnsstk::GLODenseOrbit::Sampler
+{
+public:
+   CircleSampler(double rate, double radius)
+         : w(rate), r(radius)
+   {}
+   bool sample(double t, double pos[3], double vel[3]) const override
+   {
+      CircleForce::truth(w, r, t, pos, vel);
+      if (t >= 1000)
+         pos[2] = 10;
+      for (unsigned i = 0; i < 3; i++)
+         vel[i] *= 1.01;
+      return true;
+   }
+   long piece(double t) const override
+   { return (t < 1000 ? 0 : 1); }
+   double w, r;
+};
+
+
+class GLODenseOrbit_T
+{
+public:
+   unsigned integrateTest();
+   unsigned sampleTest();
+   unsigned pz90AccelTest();
+};
+
+
+unsigned GLODenseOrbit_T ::
+integrateTest()
+{
+   TUDEF("GLODenseOrbit", "evaluate(Force)");
+      // roughly a GLONASS orbit
+   const double w = 1.5e-4, r = 25.5e6;
+   double p0[3], v0[3], pos[3], vel[3], ep[3], ev[3];
+   CircleForce::truth(w, r, 0, p0, v0);
+   CircleForce force(w);
+   gnsstk::GLODenseOrbit uut(20000);
+   TUASSERTE(bool, false, uut.evaluate(0, force, pos, vel));
+   TUASSERTE(bool, false, uut.isSet(p0, v0));
+   uut.reset(p0, v0);
+   TUASSERTE(bool, true, uut.isSet(p0, v0));
+      // the additional acceleration is part of the initial state
+   const double acc0[3] = { 0, 0, 0 }, acc1[3] = { 0, 1e-6, 0 };
+   TUASSERTE(bool, true, uut.isSet(p0, v0, acc0));
+   TUASSERTE(bool, false, uut.isSet(p0, v0, acc1));
+   uut.reset(p0, v0, acc1);
+   TUASSERTE(bool, false, uut.isSet(p0, v0));
+   TUASSERTE(bool, true, uut.isSet(p0, v0, acc1));
+   uut.reset(p0, v0);
+   TUASSERTE(bool, true, uut.evaluate(0, force, pos, vel));
+   for (unsigned i = 0; i < 3; i++)
+   {
+      TUASSERTFE(p0[i], pos[i]);
+      TUASSERTFE(v0[i], vel[i]);
+   }
+   for (double t = -14400; t <= 14400; t += 77.7)
+   {
+      TUASSERTE(bool, true, uut.evaluate(t, force, pos, vel));
+      CircleForce::truth(w, r, t, ep, ev);
+      for (unsigned i = 0; i < 3; i++)
+      {
+         TUASSERTFEPS(ep[i], pos[i], 1e-3);
+         TUASSERTFEPS(ev[i], vel[i], 1e-7);
+      }
+   }
+      // the orbit is integrated once, so more evaluations in the
+      // same span don't compute any more accelerations
+   uut.evaluate(14400, force, pos, vel);
+   uut.evaluate(-14400, force, pos, vel);
+   size_t nodes = uut.size();
+   unsigned long calls = force.calls;
+   for (double t = -14400; t <= 14400; t += 1.3)
+   {
+      uut.evaluate(t, force, pos, vel);
+   }
+   TUASSERTE(size_t, nodes, uut.size());
+   TUASSERTE(unsigned long, calls, force.calls);
+      // steps are no larger than maxStep
+   TUASSERT(nodes >= 2 * 14400 / gnsstk::GLODenseOrbit::maxStep);
+      // limit of the span
+   TUASSERTE(bool, true, uut.evaluate(20000, force, pos, vel));
+   TUASSERTE(bool, false, uut.evaluate(20000.5, force, pos, vel));
+   TUASSERTE(bool, false, uut.evaluate(-20000.5, force, pos, vel));
+      // a different initial state
+   v0[0] += 1.0;
+   TUASSERTE(bool, false, uut.isSet(p0, v0));
+   uut.clear();
+   TUASSERTE(size_t, 0, uut.size());
+   TUASSERTE(bool, false, uut.evaluate(0, force, pos, vel));
+   TURETURN();
+}
+
+
+unsigned GLODenseOrbit_T ::
+sampleTest()
+{
+   TUDEF("GLODenseOrbit", "evaluate(Sampler)");
+   const double w = 1.5e-4, r = 25.5e6;
+   double pos[3], vel[3], ep[3], ev[3];
+   CircleSampler sampler(w, r);
+   CircleForce force(w);
+   gnsstk::GLODenseOrbit uut(86400);
+   TUASSERTE(bool, false, uut.evaluate(0, sampler, pos, vel));
+   uut.resetSampled(120);
+   TUASSERTE(bool, true, uut.isSampled(120));
+   TUASSERTE(bool, false, uut.isSampled(60));
+      // integration and sampling are exclusive
+   TUASSERTE(bool, false, uut.evaluate(0, force, pos, vel));
+   for (double t = -5000; t < 5000; t += 33.3)
+   {
+      bool ok = uut.evaluate(t, sampler, pos, vel);
+         // the interval containing the jump can't be interpolated
+      TUASSERTE(bool, ((t < 960) || (t >= 1080)), ok);
+      if (!ok)
+         continue;
+      sampler.sample(t, ep, ev);
+      for (unsigned i = 0; i < 3; i++)
+      {
+         TUASSERTFEPS(ep[i], pos[i], 1e-3);
+         TUASSERTFEPS(ev[i], vel[i], 1e-7);
+      }
+   }
+      // far from the nodes so far, and back again
+   TUASSERTE(bool, true, uut.evaluate(80000, sampler, pos, vel));
+   sampler.sample(80000, ep, ev);
+   TUASSERTFEPS(ep[0], pos[0], 1e-3);
+   TUASSERTE(bool, true, uut.evaluate(-100, sampler, pos, vel));
+   sampler.sample(-100, ep, ev);
+   TUASSERTFEPS(ep[1], pos[1], 1e-3);
+   TUASSERT(uut.size() < 1024);
+   TUASSERTE(bool, false, uut.evaluate(86400.5, sampler, pos, vel));
+   TURETURN();
+}
+
+
+unsigned GLODenseOrbit_T ::
+pz90AccelTest()
+{
+   TUDEF("GLODenseOrbit", "pz90Accel");
+   double pos[3] = { 25.5e6, 0, 0 }, vel[3] = { 0, 0, 0 },
+      extra[3] = { 0, 0, 1e-6 }, acc[3];
+   double we = 7.2921151467e-5;
+   gnsstk::GLODenseOrbit::pz90Accel(we, pos, vel, extra, acc);
+      // central body and J2 in the equatorial plane, and centrifugal
+   double mu = 398600.4418e9, ae = 6378136.0, j2 = 1082625.75e-9;
+   double r = pos[0];
+   TUASSERTFEPS(-mu/(r*r) * (1.0 + 1.5*j2*(ae/r)*(ae/r)) + we*we*r, acc[0],
+                1e-9);
+   TUASSERTFE(0.0, acc[1]);
+   TUASSERTFE(1e-6, acc[2]);
+      // Coriolis
+   vel[1] = 1000;
+   gnsstk::GLODenseOrbit::pz90Accel(we, pos, vel, extra, acc);
+   TUASSERTFEPS(-mu/(r*r) * (1.0 + 1.5*j2*(ae/r)*(ae/r)) + we*we*r +
+                2.0*we*1000, acc[0], 1e-9);
+   TURETURN();
+}
+
+
+int main()
+{
+   GLODenseOrbit_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.integrateTest();
+   errorTotal += testClass.sampleTest();
+   errorTotal += testClass.pz90AccelTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -61,6 +61,7 @@ public:
    unsigned constructorTest();
    unsigned validateTest();
    unsigned getXvtTest();
+   unsigned getXvtDenseTest();
    unsigned getUserTimeTest();
    unsigned fixFitTest();
       /** This isn't a real test, it was code implemented in an
@@ -176,6 +177,59 @@ getXvtTest()
 }
 
 
+unsigned GLOFNavAlm_T ::
+getXvtDenseTest()
+{
+   TUDEF("GLOFNavAlm", "getXvt(dense)");
+   gnsstk::GLOFNavAlm uut;
+   uut.lambdanA = -0.189986229 * gnsstk::PI;
+   uut.tLambdanA = 27122.09375;
+   uut.deltainA = 0.011929512 * gnsstk::PI;
+   uut.deltaTnA = -2655.76171875;
+   uut.deltaTdotnA = 0.000549316;
+   uut.eccnA = 0.001482010;
+   uut.omeganA = 0.440277100 * gnsstk::PI;
+   uut.Toa = gnsstk::YDSTime(2001, 249, uut.tLambdanA, gnsstk::TimeSystem::GLO);
+   uut.setSemiMajorAxisIncl();
+   gnsstk::GLOFNavAlm ref(uut);
+   gnsstk::Xvt got, exp;
+   uut.dense = true;
+      // ICD example time, as in getXvtTest
+   gnsstk::YDSTime toi(2001, 249, 33300, gnsstk::TimeSystem::GLO);
+   TUASSERTE(bool, true, uut.getXvt(toi, got));
+   TUASSERTFEPS(10945967.138109738, got.x[0], 0.2);
+   TUASSERTFEPS(13079860.921750335, got.x[1], 0.2);
+   TUASSERTFEPS(18922063.556836389, got.x[2], 0.2);
+   TUASSERTFEPS(-3375.4834789088281, got.v[0], 1e-4);
+   TUASSERTFEPS(-161.72513071304218, got.v[1], 1e-4);
+   TUASSERTFEPS(2060.8444711932389, got.v[2], 1e-4);
+   TUASSERTFE(1.5097189886318696151e-09, got.relcorr);
+   TUASSERTE(gnsstk::Xvt::HealthStatus, gnsstk::Xvt::Unhealthy, got.health);
+      // Across several days, including midnights and changes in the
+      // number of draconian periods, where the almanac algorithm is
+      // not continuous.
+   for (double dt = -3600; dt < 3*86400; dt += 1234.5)
+   {
+      TUASSERTE(bool, true, uut.getXvt(uut.Toa + dt, got));
+      TUASSERTE(bool, true, ref.getXvt(ref.Toa + dt, exp));
+      for (unsigned i = 0; i < 3; i++)
+      {
+            // the almanac itself has decimeter-level numerical noise
+         TUASSERTFEPS(exp.x[i], got.x[i], 0.2);
+         TUASSERTFEPS(exp.v[i], got.v[i], 1e-4);
+      }
+   }
+      // the first second of a day can't be interpolated, so it's
+      // computed directly
+   gnsstk::YDSTime midnight(2001, 250, 0.5, gnsstk::TimeSystem::GLO);
+   TUASSERTE(bool, true, uut.getXvt(midnight, got));
+   TUASSERTE(bool, true, ref.getXvt(midnight, exp));
+   TUASSERTFE(exp.x[0], got.x[0]);
+   TUASSERTFE(exp.v[2], got.v[2]);
+   TURETURN();
+}
+
+
 unsigned GLOFNavAlm_T ::
 getUserTimeTest()
 {
@@ -349,6 +403,7 @@ int main()
    errorTotal += testClass.constructorTest();
    errorTotal += testClass.validateTest();
    errorTotal += testClass.getXvtTest();
+   errorTotal += testClass.getXvtDenseTest();
    errorTotal += testClass.getUserTimeTest();
    errorTotal += testClass.fixFitTest();
    // errorTotal += testClass.blahTest();
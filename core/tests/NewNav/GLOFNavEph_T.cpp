@@ -58,6 +58,7 @@ public:
    unsigned constructorTest();
    unsigned validateTest();
    unsigned getXvtTest();
+   unsigned getXvtDenseTest();
    unsigned getUserTimeTest();
    unsigned fixFitTest();
 };
@@ -191,6 +192,77 @@ getXvtTest()
 }
 
 
+unsigned GLOFNavEph_T ::
+getXvtDenseTest()
+{
+   TUDEF("GLOFNavEph", "getXvt(dense)");
+   gnsstk::GLOFNavEph uut, ref;
+   gnsstk::Xvt got, exp;
+   uut.pos[0] = 15553.6342773;
+   uut.pos[1] = -19901.1298828;
+   uut.pos[2] = 3553.3354492200001;
+   uut.vel[0] = -0.41938495636000001;
+   uut.vel[1] = 0.32419204711900002;
+   uut.vel[2] = 3.5266609191899998;
+   uut.acc[0] = 0;
+   uut.acc[1] = -9.3132257461499999e-10;
+   uut.acc[2] = -1.86264514923e-09;
+   uut.clkBias = 5.0653703510800001e-05;
+   uut.freqBias = 1.8189894035500001e-12;
+   uut.health = gnsstk::SVHealth::Healthy;
+   uut.Toe = gnsstk::CivilTime(2006, 10, 1, 0, 15, 0, gnsstk::TimeSystem::GLO);
+   ref = uut;
+      // Use a small step for the truth, so the comparison isn't
+      // limited by the error of the Runge-Kutta integration.
+   ref.step = 1.0;
+   TUASSERTE(bool, false, uut.dense);
+   uut.dense = true;
+      // out of order, and across the whole fit interval
+   for (double dt = 930; dt >= -930; dt -= 61.7)
+   {
+      TUASSERTE(bool, true, uut.getXvt(uut.Toe + dt, got));
+      TUASSERTE(bool, true, ref.getXvt(ref.Toe + dt, exp));
+      for (unsigned i = 0; i < 3; i++)
+      {
+         TUASSERTFEPS(exp.x[i], got.x[i], 1e-4);
+         TUASSERTFEPS(exp.v[i], got.v[i], 1e-7);
+      }
+      TUASSERTFE(exp.clkbias, got.clkbias);
+      TUASSERTFE(exp.relcorr, got.relcorr);
+      TUASSERTE(gnsstk::Xvt::HealthStatus, exp.health, got.health);
+   }
+      // same as the Runge-Kutta algorithm using the default step size
+   TUASSERTE(bool, true, uut.getXvt(uut.Toe + 306, got));
+   TUASSERTFEPS(15414234.528740599751, got.x[0], 1e-3);
+   TUASSERTFEPS(-19781497.388851653785, got.x[1], 1e-3);
+   TUASSERTFEPS(4628091.6837431369349, got.x[2], 1e-3);
+   TUASSERTFEPS(-490.60674449595484248, got.v[0], 1e-6);
+   TUASSERTFEPS(458.15034225547964297, got.v[1], 1e-6);
+   TUASSERTFEPS(3496.5690971077401628, got.v[2], 1e-6);
+      // a changed ephemeris is picked up
+   uut.pos[0] += 1.0;
+   ref.pos[0] += 1.0;
+   TUASSERTE(bool, true, uut.getXvt(uut.Toe + 306, got));
+   TUASSERTE(bool, true, ref.getXvt(ref.Toe + 306, exp));
+   TUASSERTFEPS(exp.x[0], got.x[0], 1e-4);
+      // so is a change to the luni-solar acceleration alone
+   double before = got.x[1];
+   uut.acc[1] += 1e-8;
+   ref.acc[1] += 1e-8;
+   TUASSERTE(bool, true, uut.getXvt(uut.Toe + 306, got));
+   TUASSERTE(bool, true, ref.getXvt(ref.Toe + 306, exp));
+   TUASSERTFEPS(exp.x[1], got.x[1], 1e-4);
+   TUASSERT(fabs(got.x[1] - before) > 0.1);
+      // beyond the span of the dense orbit, the Runge-Kutta
+      // algorithm is used.
+   ref.step = uut.step;
+   TUASSERTE(bool, true, uut.getXvt(uut.Toe + 90000, got));
+   TUASSERTE(bool, true, ref.getXvt(ref.Toe + 90000, exp));
+   TUASSERTFE(exp.x[0], got.x[0]);
+   TURETURN();
+}
+
+
 unsigned GLOFNavEph_T ::
 getUserTimeTest()
 {
@@ -249,6 +321,7 @@ int main()
    errorTotal += testClass.constructorTest();
    errorTotal += testClass.validateTest();
    errorTotal += testClass.getXvtTest();
+   errorTotal += testClass.getXvtDenseTest();
    errorTotal += testClass.getUserTimeTest();
    errorTotal += testClass.fixFitTest();
 
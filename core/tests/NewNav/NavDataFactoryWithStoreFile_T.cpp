@@ -0,0 +1,304 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+#include "NavDataFactoryWithStoreFile.hpp"
+#include "NavDataFactoryStoreCallback.hpp"
+#include "GPSWeekSecond.hpp"
+#include "GPSLNavEph.hpp"
+#include "StringUtils.hpp"
+#include "TestUtil.hpp"
+
+namespace gnsstk
+{
+   std::ostream& operator<<(std::ostream& s, const gnsstk::CommonTime& t)
+   {
+      s << t.asString();
+      return s;
+   }
+}
+
+
+   /** A factory that makes ephemerides for three satellites every
+    * two hours for a day, instead of reading files.  Source "dayN"
+    * is day N after t0.  Source "aN" is the same as "dayN" with an
+    * extra ephemeris for satellite 9 at 10:00 the following day.
+    * Other sources are invalid. */
+class TestFactory : public gnsstk::NavDataFactoryWithStoreFile
+{
+public:
+   TestFactory()
+         : t0(gnsstk::GPSWeekSecond(2101,0.0)), loadCount(0)
+   {
+      supportedSignals.insert(gnsstk::NavSignalID(
+                                 gnsstk::SatelliteSystem::GPS,
+                                 gnsstk::CarrierBand::L1,
+                                 gnsstk::TrackingCode::CA,
+                                 gnsstk::NavType::GPSLNAV));
+   }
+
+   bool loadIntoMap(const std::string& filename,
+                    gnsstk::NavMessageMap& navMap,
+                    gnsstk::NavNearMessageMap& navNearMap,
+                    OffsetCvtMap& ofsMap) override
+   {
+      loadCount++;
+      gnsstk::NavDataFactoryStoreCallback cb(this, navMap, navNearMap,
+                                             ofsMap);
+      return process(filename, cb);
+   }
+
+   bool process(const std::string& filename,
+                gnsstk::NavDataFactoryCallback& cb) override
+   {
+      bool extra;
+      if (filename.compare(0, 3, "day") == 0)
+         extra = false;
+      else if (filename.compare(0, 1, "a") == 0)
+         extra = true;
+      else
+         return false;
+      int day = gnsstk::StringUtils::asInt(
+         filename.substr(filename.find_first_of("0123456789")));
+      gnsstk::CommonTime dayStart(t0 + day * 86400.0);
+      for (unsigned long prn = 1; prn <= 3; prn++)
+      {
+         for (int hour = 0; hour < 24; hour += 2)
+         {
+            if (!cb.process(makeEph(prn, dayStart + hour * 3600.0)))
+               return false;
+         }
+      }
+      if (extra && !cb.process(makeEph(9, dayStart + 34 * 3600.0)))
+         return false;
+      return true;
+   }
+
+   std::string getFactoryFormats() const override
+   { return "TEST"; }
+
+      /// Make an ephemeris with a four hour fit interval starting at t.
+   gnsstk::NavDataPtr makeEph(unsigned long prn, const gnsstk::CommonTime& t)
+   {
+      std::shared_ptr<gnsstk::GPSLNavEph> eph =
+         std::make_shared<gnsstk::GPSLNavEph>();
+      eph->timeStamp = t;
+      eph->xmitTime = eph->xmit2 = eph->xmit3 = t;
+      eph->Toe = eph->Toc = t + 3600.0;
+      eph->beginFit = t;
+      eph->endFit = t + 4 * 3600.0;
+      eph->signal = makeID(prn);
+      return eph;
+   }
+
+   static gnsstk::NavMessageID makeID(unsigned long prn)
+   {
+      gnsstk::SatID sat(prn, gnsstk::SatelliteSystem::GPS);
+      return gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(sat, sat, gnsstk::ObsID(
+                                   gnsstk::ObservationType::NavMsg,
+                                   gnsstk::CarrierBand::L1,
+                                   gnsstk::TrackingCode::CA),
+                                gnsstk::NavType::GPSLNAV),
+         gnsstk::NavMessageType::Ephemeris);
+   }
+
+   gnsstk::CommonTime t0;
+      /// Number of calls to loadIntoMap.
+   unsigned loadCount;
+};
+
+
+class NavDataFactoryWithStoreFile_T
+{
+public:
+      /// Check that lazy loading finds the same data as loading all.
+   unsigned findTest();
+      /// Check what is loaded and unloaded in lazy mode.
+   unsigned lazyLoadTest();
+      /// Check that unloading restores data overwritten by the file.
+   unsigned unloadTest();
+
+      /// Search both factories for prn at when and compare.
+   bool sameResult(TestFactory& eager, TestFactory& lazy,
+                   unsigned long prn, const gnsstk::CommonTime& when);
+};
+
+
+bool NavDataFactoryWithStoreFile_T ::
+sameResult(TestFactory& eager, TestFactory& lazy,
+           unsigned long prn, const gnsstk::CommonTime& when)
+{
+   gnsstk::NavDataPtr eagerOut, lazyOut;
+   bool eagerRV = eager.find(TestFactory::makeID(prn), when, eagerOut,
+                             gnsstk::SVHealth::Any,
+                             gnsstk::NavValidityType::Any,
+                             gnsstk::NavSearchOrder::User);
+   bool lazyRV = lazy.find(TestFactory::makeID(prn), when, lazyOut,
+                           gnsstk::SVHealth::Any,
+                           gnsstk::NavValidityType::Any,
+                           gnsstk::NavSearchOrder::User);
+   if (eagerRV != lazyRV)
+      return false;
+   return (!eagerRV || (eagerOut->timeStamp == lazyOut->timeStamp));
+}
+
+
+unsigned NavDataFactoryWithStoreFile_T ::
+findTest()
+{
+   TUDEF("NavDataFactoryWithStoreFile", "find");
+   TestFactory eager, lazy;
+   lazy.setLazyLoad(true, 2);
+   for (int day = 0; day < 10; day++)
+   {
+      std::string source("day" + gnsstk::StringUtils::asString(day));
+      TUASSERT(eager.addDataSource(source));
+      TUASSERT(lazy.addDataSource(source));
+   }
+   TUASSERTE(unsigned, 10, eager.loadCount);
+   TUASSERTE(unsigned, 0, lazy.loadCount);
+   TUASSERTE(gnsstk::CommonTime, eager.getInitialTime(),
+             lazy.getInitialTime());
+   TUASSERTE(gnsstk::CommonTime, eager.getFinalTime(), lazy.getFinalTime());
+      // jump around in time, including before, after and on the
+      // boundaries between days
+   const double offsets[] = { 3.5, 0.0, 1.0, 7.3, 2.99, 9.99, 10.5, -1.0,
+                              4.0 + 1.0/24, 3.01, 8.5, 0.5 };
+   for (double days : offsets)
+   {
+      for (unsigned long prn = 1; prn <= 4; prn++)
+      {
+         gnsstk::CommonTime when(lazy.t0 + days * 86400.0);
+         TUASSERT(sameResult(eager, lazy, prn, when));
+      }
+      TUASSERT(lazy.numLoadedFiles() <= 2);
+   }
+   TURETURN();
+}
+
+
+unsigned NavDataFactoryWithStoreFile_T ::
+lazyLoadTest()
+{
+   TUDEF("NavDataFactoryWithStoreFile", "setLazyLoad");
+   TestFactory fact;
+   fact.setLazyLoad(true, 2);
+   TUASSERT(fact.getLazyLoad());
+   TUASSERT(fact.addDataSource("day3"));
+   TUASSERT(fact.addDataSource("day4"));
+   TUASSERT(fact.addDataSource("day5"));
+   TUASSERT(!fact.addDataSource("bogus"));
+      // adding twice is harmless
+   TUASSERT(fact.addDataSource("day5"));
+   TUASSERTE(unsigned, 3, fact.numLazyFiles());
+   TUASSERTE(unsigned, 0, fact.numLoadedFiles());
+   TUASSERTE(size_t, 0, fact.size());
+   gnsstk::NavDataPtr navOut;
+   gnsstk::NavMessageID nmid(TestFactory::makeID(2));
+      // only day 3 covers 10:30 on day 3
+   TUASSERT(fact.find(nmid, fact.t0 + 3.4375*86400.0, navOut,
+                      gnsstk::SVHealth::Any, gnsstk::NavValidityType::Any,
+                      gnsstk::NavSearchOrder::User));
+   TUASSERTE(unsigned, 1, fact.loadCount);
+   TUASSERTE(unsigned, 1, fact.numLoadedFiles());
+   TUASSERTE(size_t, 36, fact.size());
+      // the last fit interval of day 3 covers 01:00 on day 4
+   TUASSERT(fact.find(nmid, fact.t0 + (4.0 + 1.0/24)*86400.0, navOut,
+                      gnsstk::SVHealth::Any, gnsstk::NavValidityType::Any,
+                      gnsstk::NavSearchOrder::User));
+   TUASSERTE(unsigned, 2, fact.loadCount);
+   TUASSERTE(unsigned, 2, fact.numLoadedFiles());
+   TUASSERTE(size_t, 72, fact.size());
+      // day 3 is the least recently used
+   TUASSERT(fact.find(nmid, fact.t0 + 5.5*86400.0, navOut,
+                      gnsstk::SVHealth::Any, gnsstk::NavValidityType::Any,
+                      gnsstk::NavSearchOrder::User));
+   TUASSERTE(unsigned, 3, fact.loadCount);
+   TUASSERTE(unsigned, 2, fact.numLoadedFiles());
+   TUASSERTE(size_t, 72, fact.size());
+   TUASSERT(!fact.find(nmid, fact.t0 + 3.0*86400.0 - 1.0, navOut,
+                       gnsstk::SVHealth::Any, gnsstk::NavValidityType::Any,
+                       gnsstk::NavSearchOrder::User));
+   TUASSERTE(unsigned, 4, fact.loadCount);
+   fact.clear();
+   TUASSERTE(unsigned, 0, fact.numLazyFiles());
+   TUASSERTE(size_t, 0, fact.size());
+   TURETURN();
+}
+
+
+unsigned NavDataFactoryWithStoreFile_T ::
+unloadTest()
+{
+   TUDEF("NavDataFactoryWithStoreFile", "find");
+   TestFactory fact;
+   fact.setLazyLoad(true, 2);
+   TUASSERT(fact.addDataSource("a3"));
+   TUASSERT(fact.addDataSource("day3"));
+   TUASSERT(fact.addDataSource("day4"));
+   gnsstk::NavDataPtr navOut;
+      // loads a3, then day3 which replaces all but one of its ephemerides
+   TUASSERT(fact.find(TestFactory::makeID(1), fact.t0 + 3.5*86400.0, navOut,
+                      gnsstk::SVHealth::Any, gnsstk::NavValidityType::Any,
+                      gnsstk::NavSearchOrder::User));
+   TUASSERTE(size_t, 37, fact.size());
+      // loads day4 and unloads day3, which must put back a3's
+      // ephemerides
+   TUASSERT(fact.find(TestFactory::makeID(9), fact.t0 + (4.0+10.5/24)*86400.0,
+                      navOut, gnsstk::SVHealth::Any,
+                      gnsstk::NavValidityType::Any,
+                      gnsstk::NavSearchOrder::User));
+   TUASSERTE(unsigned, 2, fact.numLoadedFiles());
+   TUASSERTE(size_t, 73, fact.size());
+   TURETURN();
+}
+
+
+int main()
+{
+   NavDataFactoryWithStoreFile_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.findTest();
+   errorTotal += testClass.lazyLoadTest();
+   errorTotal += testClass.unloadTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
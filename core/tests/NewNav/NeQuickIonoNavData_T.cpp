@@ -37,6 +37,7 @@
 //
 //==============================================================================
 
+#include <thread>
 #include "TestUtil.hpp"
 #include "NeQuickIonoNavData.hpp"
 #include "MODIP.hpp"
@@ -94,6 +95,10 @@ public:
    unsigned thicknessTest();
       /// Test NeQuickIonoNavData::getTEC (implicitly getSED, getVED).
    unsigned getTECTest();
+      /// Test the batch NeQuickIonoNavData::getTEC against the single ray one.
+   unsigned getTECBatchTest();
+      /// Test NeQuickIonoNavData::getTEC using the foF2/M(3000)F2 grids.
+   unsigned getTECGridTest();
       /// Test NeQuickIonoNavData::getIonoCorr
    unsigned getIonoCorrTest();
 
@@ -886,6 +891,128 @@ getTECTest()
 }
 
 
+unsigned NeQuickIonoNavData_T ::
+getTECBatchTest()
+{
+   TUDEF("NeQuickIonoNavData", "getTEC(batch)");
+   unsigned numTests = sizeof(testDataTEC)/sizeof(testDataTEC[0]);
+   TestClass uut;
+      // process runs of test data that share coefficients and time
+      // as one batch, which mixes many stations in one call.
+   unsigned first = 0;
+   while (first < numTests)
+   {
+      const TestDataTEC& td(testDataTEC[first]);
+      std::vector<gnsstk::Position> rx, sv;
+      unsigned last = first;
+      while ((last < numTests) &&
+             (testDataTEC[last].coefficients == td.coefficients) &&
+             (testDataTEC[last].ct == td.ct))
+      {
+         rx.push_back(testDataTEC[last].station);
+         sv.push_back(testDataTEC[last].satellite);
+         last++;
+      }
+      uut.ai[0] = td.coefficients[0];
+      uut.ai[1] = td.coefficients[1];
+      uut.ai[2] = td.coefficients[2];
+      std::vector<double> tec = uut.getTEC(td.ct, rx, sv);
+      TUASSERTE(size_t, sv.size(), tec.size());
+      for (unsigned i = 0; i < tec.size(); i++)
+      {
+         const TestDataTEC& tdi(testDataTEC[first+i]);
+         double single = uut.getTEC(tdi.ct, tdi.station, tdi.satellite);
+         TUASSERTFEPS(single, tec[i], 1e-9 * fabs(single));
+         TUASSERTFEPS(tdi.expTEC, tec[i], docEps);
+      }
+         // one receiver for all the satellites
+      tec = uut.getTEC(td.ct, std::vector<gnsstk::Position>(1, rx[0]), sv);
+      for (unsigned i = 0; i < tec.size(); i++)
+      {
+         double single = uut.getTEC(td.ct, rx[0], sv[i]);
+         TUASSERTFEPS(single, tec[i], 1e-9 * fabs(single));
+      }
+      first = last;
+   }
+      // mismatched receiver/satellite counts
+   std::vector<gnsstk::Position> two(2, testDataTEC[0].station),
+      three(3, testDataTEC[0].satellite);
+   TUTHROW(uut.getTEC(testDataTEC[0].ct, two, three));
+   TURETURN();
+}
+
+
+unsigned NeQuickIonoNavData_T ::
+getTECGridTest()
+{
+   TUDEF("NeQuickIonoNavData", "getTEC(grid)");
+   unsigned numTests = sizeof(testDataTEC)/sizeof(testDataTEC[0]);
+   TestClass uut;
+      // Bilinear interpolation error falls off with the square of the
+      // grid spacing, so check the coarse spacing and the default.
+   double maxErr[2] = { 0, 0 };
+   const double steps[2] = { 2.5, 1.0 };
+   for (unsigned s = 0; s < 2; s++)
+   {
+      for (unsigned testNum = 0; testNum < numTests; testNum++)
+      {
+         const TestDataTEC& td(testDataTEC[testNum]);
+         uut.ai[0] = td.coefficients[0];
+         uut.ai[1] = td.coefficients[1];
+         uut.ai[2] = td.coefficients[2];
+         uut.useF2Grid = false;
+         double exact = uut.getTEC(td.ct, td.station, td.satellite);
+         uut.useF2Grid = true;
+         uut.f2GridStep = steps[s];
+         double grid = uut.getTEC(td.ct, td.station, td.satellite);
+         maxErr[s] = std::max(maxErr[s], fabs(grid-exact)/exact);
+      }
+   }
+   TUASSERT(maxErr[0] < 0.08);
+   TUASSERT(maxErr[1] < 0.01);
+      // Rays at different times need different grids; threads
+      // sharing the object must each get the grid for their own ray.
+   std::vector<double> serial(numTests), threaded(numTests);
+   uut.ai[0] = testDataTEC[0].coefficients[0];
+   uut.ai[1] = testDataTEC[0].coefficients[1];
+   uut.ai[2] = testDataTEC[0].coefficients[2];
+   for (unsigned testNum = 0; testNum < numTests; testNum++)
+   {
+      const TestDataTEC& td(testDataTEC[testNum]);
+      serial[testNum] = uut.getTEC(td.ct, td.station, td.satellite);
+   }
+   std::vector<std::thread> threads;
+   for (unsigned t = 0; t < 4; t++)
+   {
+      threads.emplace_back([&uut, &threaded, numTests, t]()
+      {
+         for (unsigned testNum = t; testNum < numTests; testNum += 4)
+         {
+            const TestDataTEC& td(testDataTEC[testNum]);
+            threaded[testNum] = uut.getTEC(td.ct, td.station, td.satellite);
+         }
+      });
+   }
+   for (auto& thread : threads)
+   {
+      thread.join();
+   }
+   for (unsigned testNum = 0; testNum < numTests; testNum++)
+   {
+      TUASSERTFE(serial[testNum], threaded[testNum]);
+   }
+      // invalid grid spacing
+   const TestDataTEC& td(testDataTEC[0]);
+   uut.f2GridStep = 0.0;
+   TUTHROW(uut.getTEC(td.ct, td.station, td.satellite));
+   uut.f2GridStep = -1.0;
+   TUTHROW(uut.getTEC(td.ct, td.station, td.satellite));
+   uut.f2GridStep = 0.7;
+   TUTHROW(uut.getTEC(td.ct, td.station, td.satellite));
+   TURETURN();
+}
+
+
 inline double getFactor(gnsstk::CarrierBand band)
 {
    double freq = gnsstk::getFrequency(band);
@@ -945,6 +1072,8 @@ int main(int argc, char *argv[])
    errorTotal += testClass.effSolarZenithAngleTest();
    errorTotal += testClass.thicknessTest();
    errorTotal += testClass.getTECTest();
+   errorTotal += testClass.getTECBatchTest();
+   errorTotal += testClass.getTECGridTest();
    errorTotal += testClass.getIonoCorrTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
@@ -62,6 +62,11 @@
 #include "GLOFNavISC.hpp"
 #include "RinexTimeOffset.hpp"
 #include "GALWeekSecond.hpp"
+#include "GPSWeekSecond.hpp"
+#include "Rinex3NavStream.hpp"
+#include "build_config.h"
+#include <cstdio>
+#include <sstream>
 
 namespace gnsstk
 {
@@ -112,6 +117,19 @@ public:
    { return data; }
 };
 
+   /// Count the data passed on, asking to stop after a given number.
+class StopCallback : public gnsstk::NavDataFactoryCallback
+{
+public:
+   StopCallback(unsigned limit)
+         : count(0), stopAt(limit)
+   {}
+   bool process(const gnsstk::NavDataPtr& navOut) override
+   { return ++count < stopAt; }
+   unsigned count;
+   unsigned stopAt;
+};
+
 /// Automated tests for gnsstk::RinexNavDataFactory
 class RinexNavDataFactory_T
 {
@@ -124,6 +142,14 @@ public:
    unsigned loadIntoMapQZSSTest();
    unsigned decodeSISATest();
    unsigned encodeSISATest();
+      /// Make sure reading on several threads gives the same results.
+   unsigned parallelTest();
+      /** Write a mixed-system RINEX 3 nav file with hours hours of
+       * records, a blank line every 100 records and, if badRecord
+       * is not negative, an invalid line in that record.
+       * @return the file name. */
+   std::string writeNavFile(const std::string& name, int hours,
+                            int badRecord = -1);
       /** Use dynamic_cast to verify that the contents of nmm are the
        * right class.
        * @param[in] testFramework The test framework created by TUDEF,
@@ -1163,6 +1189,137 @@ loadIntoMapTest()
 }
 
 
+std::string RinexNavDataFactory_T ::
+writeNavFile(const std::string& name, int hours, int badRecord)
+{
+   std::string fn = gnsstk::getPathTestTemp() + gnsstk::getFileSep() + name;
+   gnsstk::Rinex3NavHeader hdr;
+   hdr.version = 3.04;
+   hdr.setFileSystem("M");
+   hdr.fileProgram = "RinexNavDF_T";
+   hdr.fileAgency = "ARL:UT";
+   hdr.date = "20200405 000000 UTC";
+   hdr.valid = gnsstk::Rinex3NavHeader::validVersion |
+      gnsstk::Rinex3NavHeader::validRunBy |
+      gnsstk::Rinex3NavHeader::validEoH;
+   gnsstk::Rinex3NavStream strm(fn.c_str(), std::ios::out | std::ios::trunc);
+   strm << hdr;
+   gnsstk::CommonTime t0 = gnsstk::GPSWeekSecond(2100, 0.0);
+   int count = 0;
+   for (int hour = 0; hour < hours; hour++)
+   {
+      for (const std::string& sys : {"G", "E", "R", "C"})
+      {
+         gnsstk::RinexSatID sat(sys + "01");
+         for (int prn = 1; prn <= 24; prn++)
+         {
+            gnsstk::Rinex3NavData rnd;
+            rnd.satSys = sys;
+            rnd.PRNID = prn;
+            rnd.sat = gnsstk::RinexSatID(prn, sat.system);
+            rnd.time = t0 + 3600.0 * hour;
+            if (sys == "E")
+               rnd.time.setTimeSystem(gnsstk::TimeSystem::GAL);
+            else if (sys == "R")
+               rnd.time.setTimeSystem(gnsstk::TimeSystem::UTC);
+            else if (sys == "C")
+               rnd.time.setTimeSystem(gnsstk::TimeSystem::BDT);
+            gnsstk::GPSWeekSecond ws(rnd.time);
+            rnd.weeknum = ws.week;
+            rnd.Toc = ws.sow;
+            rnd.Toe = ws.sow;
+            rnd.xmitTime = ws.sow - 60;
+            rnd.Ahalf = 5153.6 + prn;
+            rnd.ecc = 0.001 * prn;
+            rnd.M0 = 0.1 * hour;
+            rnd.af0 = 1e-6 * prn;
+            rnd.datasources = 517;
+            rnd.px = 1000.0 * prn;
+            if (count == badRecord)
+            {
+               strm << sys << "xx garbage" << std::endl;
+            }
+            else
+            {
+               strm << rnd;
+            }
+            if (++count % 100 == 0)
+            {
+               strm << std::endl;
+            }
+         }
+      }
+   }
+   return fn;
+}
+
+
+unsigned RinexNavDataFactory_T ::
+parallelTest()
+{
+   TUDEF("RinexNavDataFactory", "setNumThreads");
+   std::string fn = writeNavFile("test_output_RinexNavDataFactory_par.rnx",
+                                 12);
+   TestClass f1, f4;
+   TUASSERTE(unsigned, 0, f1.getNumThreads());
+   f1.setNumThreads(1);
+   f4.setNumThreads(4);
+   TUASSERTE(unsigned, 4, f4.getNumThreads());
+   TUASSERT(f1.addDataSource(fn));
+   TUASSERT(f4.addDataSource(fn));
+   TUASSERT(f1.size() > 1000);
+   TUASSERTE(size_t, f1.size(), f4.size());
+   std::ostringstream s1, s4;
+   for (auto& i : f1.getData())
+      for (auto& j : i.second)
+         for (auto& k : j.second)
+            k.second->dump(s1, gnsstk::DumpDetail::Full);
+   for (auto& i : f4.getData())
+      for (auto& j : i.second)
+         for (auto& k : j.second)
+            k.second->dump(s4, gnsstk::DumpDetail::Full);
+   TUASSERT(s1.str() == s4.str());
+   TUASSERTE(gnsstk::CommonTime, f1.getInitialTime(), f4.getInitialTime());
+   TUASSERTE(gnsstk::CommonTime, f1.getFinalTime(), f4.getFinalTime());
+
+      // record boundaries
+   gnsstk::Rinex3NavStream strm(fn.c_str());
+   gnsstk::Rinex3NavHeader hdr;
+   strm >> hdr;
+   std::streamoff dataStart = strm.tellg();
+   strm.seekg(0, std::ios::end);
+   std::streamoff fileEnd = strm.tellg();
+   TUASSERTE(std::streamoff, dataStart, strm.findRecord(dataStart));
+   std::streamoff mid = strm.findRecord((dataStart + fileEnd) / 2);
+   TUASSERT(mid > dataStart);
+   TUASSERT(mid < fileEnd);
+   TUASSERTE(std::streamoff, mid, strm.findRecord(mid - 10));
+   gnsstk::Rinex3NavData rnd;
+   strm.seekg(mid);
+   TUASSERT(static_cast<bool>(strm >> rnd));
+   TUASSERTE(std::streamoff, fileEnd, strm.findRecord(fileEnd - 10));
+
+      // an error part way through the file stops both the same way
+   std::string badFn = writeNavFile(
+      "test_output_RinexNavDataFactory_bad.rnx", 12, 700);
+   TestClass b1, b4;
+   b1.setNumThreads(1);
+   b4.setNumThreads(4);
+   TUASSERT(!b1.addDataSource(badFn));
+   TUASSERT(!b4.addDataSource(badFn));
+
+      // a callback returning false stops the processing
+   StopCallback stop1(5), stop4(5);
+   TUASSERT(!b1.process(fn, stop1));
+   TUASSERTE(unsigned, 5, stop1.count);
+   TUASSERT(!b4.process(fn, stop4));
+   TUASSERTE(unsigned, 5, stop4.count);
+   std::remove(fn.c_str());
+   std::remove(badFn.c_str());
+   TURETURN();
+}
+
+
 unsigned RinexNavDataFactory_T ::
 decodeSISATest()
 {
@@ -1386,6 +1543,7 @@ int main()
    unsigned errorTotal = 0;
 
    errorTotal += testClass.constructorTest();
+   errorTotal += testClass.parallelTest();
    errorTotal += testClass.loadIntoMapTest();
    errorTotal += testClass.loadIntoMapQZSSTest();
    errorTotal += testClass.decodeSISATest();
@@ -0,0 +1,403 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file AshtechFramer_T.cpp Test AshtechFramer and the in-place decoders
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "AshtechFramer.hpp"
+#include "AshtechMBEN.hpp"
+#include "AshtechPBEN.hpp"
+#include "AshtechEPB.hpp"
+#include "BinUtils.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+using gnsstk::BinUtils::encodeVar;
+
+class AshtechFramer_T
+{
+public:
+      /// Field values and checksums from the in-place decoders
+   unsigned decodeTest();
+      /// Messages split across appends at every possible point
+   unsigned splitTest();
+      /// Garbage between messages is skipped and counted
+   unsigned resyncTest();
+      /// Framed messages decode the same as the strings holding them
+   unsigned frameDecodeTest();
+
+      /// A binary MPC, with the checksum off by badSum
+   static string mpcBin(unsigned seq, unsigned prn, uint8_t badSum = 0)
+   {
+      string body = encodeVar<uint16_t>(seq) + encodeVar<uint8_t>(3) +
+         encodeVar<uint8_t>(prn) + encodeVar<uint8_t>(45) +
+         encodeVar<uint8_t>(210) + encodeVar<uint8_t>(7);
+      for (int b = 0; b < 3; b++)
+      {
+         body += encodeVar<uint8_t>(0x10+b) + encodeVar<uint8_t>(24) +
+            encodeVar<uint8_t>(1) + encodeVar<uint8_t>(150+b) +
+            encodeVar<uint8_t>(5);
+         body += encodeVar<double>(123456.25 + b) +
+            encodeVar<double>(0.0725 + b*1e-6) +
+            encodeVar<int32_t>(-12345678 + b) +
+            encodeVar<uint32_t>((20u << 24) | 0x800000 | (1500 + b));
+      }
+      uint8_t csum = badSum;
+      for (char c : body)
+         csum ^= c;
+      return "$PASHR,MPC," + body + encodeVar<uint8_t>(csum) + "\r\n";
+   }
+
+      /// An ASCII MPC, with the checksum off by badSum
+   static string mpcAscii(unsigned seq, unsigned prn, unsigned badSum = 0)
+   {
+      ostringstream oss;
+      oss << setprecision(12) << seq << ",3," << prn << ",45,210,7,";
+      for (int b = 0; b < 3; b++)
+         oss << "16,24,1," << 150+b << ",5,"
+             << 123456.25 + b << "," << 72.5 + b << ",-1234.5678,"
+             << -1.5 << ",20,";
+      string body = oss.str();
+      unsigned csum = badSum;
+      for (char c : body)
+         csum ^= static_cast<uint8_t>(c);
+      return "$PASHR,MPC," + body + to_string(csum) + "\r\n";
+   }
+
+      /// A binary PBN
+   static string pbnBin(int32_t msec)
+   {
+      string body = encodeVar<int32_t>(msec) + "SITE" +
+         encodeVar<double>(-1000000.5) + encodeVar<double>(-5000000.25) +
+         encodeVar<double>(3000000.125) + encodeVar<float>(12.5) +
+         encodeVar<float>(0.25) + encodeVar<float>(-0.5) +
+         encodeVar<float>(0.75) + encodeVar<float>(0.125) +
+         encodeVar<uint16_t>(3);
+      uint16_t csum = 0;
+      for (size_t i = 0; i < body.size(); i += 2)
+         csum += BinUtils::decodeVar<uint16_t>(body, i);
+      return "$PASHR,PBN," + body + encodeVar<uint16_t>(csum) + "\r\n";
+   }
+
+      /// A binary EPB
+   static string epbBin(unsigned prn)
+   {
+      string rv = "$PASHR,EPB," + string(prn < 10 ? "0" : "") +
+         to_string(prn) + ",";
+      for (uint32_t w = 0; w < 30; w++)
+         rv += encodeVar<uint32_t>(0x22c00000 + w);
+      return rv + encodeVar<uint16_t>(0) + "\r\n";
+   }
+
+      /// A message of unknown length, which ends where the next starts
+   static string other()
+   {
+      return string("$PASHR,XYZ,\x01\x02\x80$\xff", 16) + "\r\n";
+   }
+
+      /// Copy the frames found in data appended n bytes at a time
+   static vector<string> frameAll(const string& data, size_t n,
+                                  AshtechFramer& framer)
+   {
+      vector<string> rv;
+      AshtechFramer::Frame frame;
+      for (size_t i = 0; i < data.size(); i += n)
+      {
+         framer.append(data.data() + i, min(n, data.size() - i));
+         while (framer.next(frame))
+            rv.push_back(string(frame.data, frame.length));
+      }
+      framer.finish();
+      while (framer.next(frame))
+         rv.push_back(string(frame.data, frame.length));
+      return rv;
+   }
+};
+
+
+unsigned AshtechFramer_T ::
+decodeTest()
+{
+   TUDEF("AshtechMBEN", "decode");
+   AshtechMBEN mben;
+   string msg = mpcBin(1234, 17);
+   TUASSERTE(size_t, 108, msg.size());
+   mben.decode(msg.data(), msg.size());
+   TUASSERT(mben.good());
+   TUASSERT(!mben.ascii);
+   TUASSERTE(string, "MPC", mben.id);
+   TUASSERTE(unsigned, 1234, mben.seq);
+   TUASSERTE(unsigned, 3, mben.left);
+   TUASSERTE(unsigned, 17, mben.svprn);
+   TUASSERTE(unsigned, 45, mben.el);
+   TUASSERTE(unsigned, 210, mben.az);
+   TUASSERTE(unsigned, 7, mben.chid);
+   TUASSERTE(unsigned, 0x12, mben.p2.warning);
+   TUASSERTE(unsigned, 24, mben.p2.goodbad);
+   TUASSERTE(unsigned, 152, mben.p2.ireg);
+   TUASSERTE(unsigned, 5, mben.p2.qa_phase);
+   TUASSERTE(double, 123458.25, mben.p2.full_phase);
+   TUASSERTE(double, 0.0725 + 2e-6, mben.p2.raw_range);
+   TUASSERTFE(-1234.5676, mben.p2.doppler);
+   TUASSERTFE(-1.502, mben.p2.smoothing);
+   TUASSERTE(unsigned, 20, mben.p2.smooth_cnt);
+
+   msg = mpcBin(1234, 17, 1);
+   mben.decode(msg.data(), msg.size());
+   TUASSERT(mben.crcerr());
+      // an MPC must have all three blocks
+   mben.decode(msg.data(), 52);
+   TUASSERT(!mben.good());
+
+   msg = mpcAscii(4321, 9);
+   mben.decode(msg.data(), msg.size());
+   TUASSERT(mben.good());
+   TUASSERT(mben.ascii);
+   TUASSERTE(unsigned, 4321, mben.seq);
+   TUASSERTE(unsigned, 9, mben.svprn);
+   TUASSERTE(unsigned, 151, mben.p1.ireg);
+   TUASSERTE(double, 123457.25, mben.p1.full_phase);
+   TUASSERTFE(0.0735, mben.p1.raw_range);
+   TUASSERTFE(-1234.5678, mben.p1.doppler);
+   TUASSERTFE(-1.5, mben.p1.smoothing);
+   TUASSERTE(unsigned, 20, mben.p1.smooth_cnt);
+   msg = mpcAscii(4321, 9, 1);
+   mben.decode(msg.data(), msg.size());
+   TUASSERT(mben.crcerr());
+      // truncated
+   msg = mpcAscii(4321, 9);
+   mben.decode(msg.data(), msg.size() - 20);
+   TUASSERT(!mben.good());
+
+   TUCSM("AshtechPBEN::decode");
+   AshtechPBEN pben;
+   msg = pbnBin(345600500);
+   TUASSERTE(size_t, 69, msg.size());
+   pben.decode(msg.data(), msg.size());
+   TUASSERT(pben.good());
+   TUASSERTE(double, 345600.5, pben.sow);
+   TUASSERTE(string, "SITE", pben.sitename);
+   TUASSERTE(double, -5000000.25, pben.navy);
+   TUASSERTE(float, 12.5, pben.navt);
+   TUASSERTE(float, 0.125, pben.navtdot);
+   TUASSERTE(unsigned, 3, pben.pdop);
+   msg[20] ^= 1;
+   pben.decode(msg.data(), msg.size());
+   TUASSERT(pben.crcerr());
+
+   TUCSM("AshtechEPB::decode");
+   AshtechEPB epb;
+   msg = epbBin(23);
+   TUASSERTE(size_t, 138, msg.size());
+   epb.decode(msg.data(), msg.size());
+   TUASSERT(epb.good());
+   TUASSERTE(unsigned, 23, epb.prn);
+   TUASSERTE(long, 0x22c00000, epb.word[1][1]);
+   TUASSERTE(long, 0x22c00000 + 29, epb.word[3][10]);
+   TURETURN();
+}
+
+
+unsigned AshtechFramer_T ::
+splitTest()
+{
+   TUDEF("AshtechFramer", "next");
+   vector<string> msgs = { mpcBin(1, 1), mpcAscii(2, 2), pbnBin(1000),
+                           other(), epbBin(5), mpcBin(3, 3) };
+   string data;
+   for (const string& m : msgs)
+      data += m;
+
+   for (size_t n : { size_t(1), size_t(2), size_t(7), size_t(64),
+                     data.size() })
+   {
+      AshtechFramer framer;
+      vector<string> frames = frameAll(data, n, framer);
+      TUASSERTE(size_t, msgs.size(), frames.size());
+      TUASSERT(frames == msgs);
+      TUASSERTE(unsigned long, 6, framer.getNumMessages());
+      TUASSERTE(unsigned long, 1, framer.getNumAscii());
+      TUASSERTE(uint64_t, 0, framer.getNumDiscarded());
+      TUASSERTE(unsigned long, 0, framer.getNumResyncs());
+      TUASSERTE(unsigned long, 3, framer.getIdCounts().at("MPC"));
+      TUASSERTE(size_t, 0, framer.getNumBuffered());
+   }
+
+      // a message of unknown length isn't complete until the next starts
+   AshtechFramer framer;
+   AshtechFramer::Frame frame;
+   string data2 = other() + "$PASH";
+   framer.append(data2.data(), data2.size());
+   TUASSERT(!framer.next(frame));
+   framer.append("R,", 2);
+   TUASSERT(framer.next(frame));
+   TUASSERTE(string, other(), string(frame.data, frame.length));
+   TUASSERTE(uint64_t, 0, frame.offset);
+   TUASSERT(!frame.ascii);
+   TUASSERTE(string, "XYZ", frame.getId());
+   TURETURN();
+}
+
+
+unsigned AshtechFramer_T ::
+resyncTest()
+{
+   TUDEF("AshtechFramer", "next");
+   string bad = mpcBin(4, 4);
+   bad[106] = 'x';
+   vector<string> junk = { string("junk\0\x01", 6), "$PA", "$PASHR",
+                           "$$$", "$PASHR;MPC,", bad };
+   vector<string> msgs = { mpcBin(1, 1), mpcAscii(2, 2), pbnBin(1000),
+                           epbBin(5), mpcBin(3, 3), mpcAscii(5, 5),
+                           mpcBin(6, 6) };
+   string data;
+   uint64_t numJunk = 0;
+   vector<uint64_t> offsets;
+   for (size_t i = 0; i < msgs.size(); i++)
+   {
+      if (i < junk.size())
+      {
+         data += junk[i];
+         numJunk += junk[i].size();
+      }
+      offsets.push_back(data.size());
+      data += msgs[i];
+   }
+      // and a partial message at the end
+   data += mpcBin(7, 7).substr(0, 50);
+   numJunk += 50;
+
+   for (size_t n : { size_t(1), size_t(5), data.size() })
+   {
+      AshtechFramer framer;
+      AshtechFramer::Frame frame;
+      vector<string> frames;
+      vector<uint64_t> frameOffsets;
+      for (size_t i = 0; i < data.size(); i += n)
+      {
+         framer.append(data.data() + i, min(n, data.size() - i));
+         while (framer.next(frame))
+         {
+            frames.push_back(string(frame.data, frame.length));
+            frameOffsets.push_back(frame.offset);
+         }
+      }
+      framer.finish();
+      TUASSERT(!framer.next(frame));
+      TUASSERT(frames == msgs);
+      TUASSERT(frameOffsets == offsets);
+      TUASSERTE(uint64_t, numJunk, framer.getNumDiscarded());
+      TUASSERTE(unsigned long, junk.size() + 1, framer.getNumResyncs());
+      TUASSERTE(size_t, 0, framer.getNumBuffered());
+   }
+   TURETURN();
+}
+
+
+unsigned AshtechFramer_T ::
+frameDecodeTest()
+{
+   TUDEF("AshtechFramer", "decode");
+   string data = mpcBin(1, 1) + "xx" + mpcAscii(2, 2) + mpcBin(3, 3, 1) +
+      pbnBin(1000) + epbBin(5) + mpcAscii(4, 4, 1);
+   AshtechFramer framer;
+   AshtechFramer::Frame frame;
+   framer.append(data.data(), data.size());
+   framer.finish();
+   unsigned count = 0, crcErrors = 0;
+   while (framer.next(frame))
+   {
+      string str(frame.data, frame.length);
+      ostringstream inPlace, copied;
+      if (frame.isId(AshtechMBEN::mpcId))
+      {
+         AshtechMBEN a, b;
+         a.decode(frame.data, frame.length);
+         b.decode(str);
+         a.dump(inPlace);
+         b.dump(copied);
+         TUASSERTE(bool, frame.ascii, a.ascii);
+         TUASSERTE(bool, b.crcerr(), a.crcerr());
+         crcErrors += a.crcerr();
+      }
+      else if (frame.isId(AshtechPBEN::myId))
+      {
+         AshtechPBEN a, b;
+         a.decode(frame.data, frame.length);
+         b.decode(str);
+         TUASSERT(a.good());
+         a.dump(inPlace);
+         b.dump(copied);
+      }
+      else if (frame.isId(AshtechEPB::myId))
+      {
+         AshtechEPB a, b;
+         a.decode(frame.data, frame.length);
+         b.decode(str);
+         TUASSERT(a.good());
+         a.dump(inPlace);
+         b.dump(copied);
+      }
+      TUASSERT(!inPlace.str().empty());
+      TUASSERTE(string, copied.str(), inPlace.str());
+      count++;
+   }
+   TUASSERTE(unsigned, 6, count);
+   TUASSERTE(unsigned, 2, crcErrors);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   AshtechFramer_T testClass;
+
+   errorTotal += testClass.decodeTest();
+   errorTotal += testClass.splitTest();
+   errorTotal += testClass.resyncTest();
+   errorTotal += testClass.frameDecodeTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -41,6 +41,7 @@
 #include "Exception.hpp"
 #include <iostream>
 #include <cmath>
+#include <vector>
 
 using namespace std;
 
@@ -499,6 +500,71 @@ public:
       crc = computeCRC(data2, len2, gnsstk::BinUtils::CRCCCITT);
       TUASSERTE(unsigned long, 0xbf25, crc);
 
+      return testFramework.countFails();
+   }
+
+      //==========================================================
+      //        Test Suite: crcTableTest()
+      //==========================================================
+      //
+      //        Tests that CRCTable gives the same results as
+      //        computeCRC, including with a non-default initial value.
+      //
+      //==========================================================
+   int crcTableTest(void)
+   {
+      using gnsstk::BinUtils::computeCRC;
+      using gnsstk::BinUtils::CRCParam;
+      using gnsstk::BinUtils::CRCTable;
+      TUDEF("BinUtils", "CRCTable");
+
+      unsigned char data[1000];
+      for (unsigned i = 0; i < sizeof(data); i++)
+         data[i] = (unsigned char)(i * 131 + (i >> 3));
+
+      std::vector<CRCParam> params;
+      params.push_back(gnsstk::BinUtils::CRC32);
+      params.push_back(gnsstk::BinUtils::CRC16);
+      params.push_back(gnsstk::BinUtils::CRCCCITT);
+      params.push_back(gnsstk::BinUtils::CRC24Q);
+      params.push_back(gnsstk::BinUtils::CRCGLOL3);
+      params.push_back(CRCParam(24,0x823ba9,0xffffff,0xffffff,false,false,false));
+      params.push_back(CRCParam(12, 0x80f, 0x123, 0, true, true, false));
+      params.push_back(CRCParam(1, 1, 0, 0, true, false, false));
+
+      const unsigned long lens[] = { 0, 1, 7, 1000 };
+      const uint32_t initials[] = { 0, 0x5a5a5a5a, 0xffffffff };
+      for (unsigned p = 0; p < params.size(); p++)
+      {
+         CRCTable table(params[p]);
+         for (unsigned l = 0; l < 4; l++)
+         {
+            TUASSERTE(unsigned long,
+                      computeCRC(data, lens[l], params[p]),
+                      table.compute(data, lens[l]));
+            for (unsigned i = 0; i < 3; i++)
+            {
+               CRCParam other(params[p]);
+               other.initial = initials[i] &
+                  (0xffffffff >> (32 - params[p].order));
+               TUASSERTE(unsigned long,
+                         computeCRC(data, lens[l], other),
+                         table.compute(data, lens[l], other.initial));
+            }
+         }
+      }
+
+         // chained the way BINEX seeds the message CRC with the head CRC
+      uint32_t first = gnsstk::BinUtils::CRC16Table.compute(data, 300);
+      CRCParam chained(gnsstk::BinUtils::CRC16);
+      chained.initial = first;
+      TUASSERTE(unsigned long,
+                computeCRC(data+300, 700, chained),
+                gnsstk::BinUtils::CRC16Table.compute(data+300, 700, first));
+      TUASSERTE(unsigned long, 0xeaa96e4d,
+                gnsstk::BinUtils::CRC32Table.compute(
+                   (const unsigned char*)"This is a Test!@#$^...", 22));
+
       return testFramework.countFails();
    }
 
@@ -606,6 +672,7 @@ int main (void)
    errorTotal += testClass.encodeVarTest();
    errorTotal += testClass.encodeVarLETest();
    errorTotal += testClass.computeCRCTest();
+   errorTotal += testClass.crcTableTest();
    errorTotal += testClass.xorChecksumTest();
    errorTotal += testClass.countBitsTest();
 
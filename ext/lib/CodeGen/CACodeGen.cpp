@@ -0,0 +1,94 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "Exception.hpp"
+#include "CACodeGen.hpp"
+
+namespace gnsstk
+{
+   const int CACodeGen::MAX_PRN;
+
+      // IS-GPS-200 tables 3-Ia (PRN 1-37) and 3-Ib (PRN 38-63)
+   const int CACodeGen::G2Delay[MAX_PRN] =
+   {
+        5,    6,    7,    8,   17,   18,  139,  140,  141,  251,
+      252,  254,  255,  256,  257,  258,  469,  470,  471,  472,
+      473,  474,  509,  512,  513,  514,  515,  516,  859,  860,
+      861,  862,  863,  950,  947,  948,  950,   67,  103,   91,
+       19,  679,  225,  625,  946,  638,  161, 1001,  554,  280,
+      710,  709,  775,  864,  558,  220,  397,   55,  898,  759,
+      367,  299, 1018
+   };
+
+   CACodeGen::CACodeGen( const int SVPRNID )
+   {
+      if (SVPRNID < 1 || SVPRNID > MAX_PRN)
+      {
+         gnsstk::Exception e("Must provide a prn between 1 and 63");
+         GNSSTK_THROW(e);
+      }
+      PRNID = SVPRNID;
+
+         /*
+            Both registers shift toward stage 10, which is the output.
+            Bit n-1 of g1 and g2 holds stage n.  G1 = 1 + x^3 + x^10,
+            G2 = 1 + x^2 + x^3 + x^6 + x^8 + x^9 + x^10.
+         */
+      std::vector<uint8_t> G1(CA_CODE_LENGTH), G2(CA_CODE_LENGTH);
+      unsigned g1 = 0x3FF;
+      unsigned g2 = 0x3FF;
+      for (long i=0; i<CA_CODE_LENGTH; ++i)
+      {
+         G1[i] = (g1 >> 9) & 1;
+         G2[i] = (g2 >> 9) & 1;
+         unsigned fb1 = ((g1 >> 2) ^ (g1 >> 9)) & 1;
+         unsigned fb2 = ((g2 >> 1) ^ (g2 >> 2) ^ (g2 >> 5) ^ (g2 >> 7) ^
+                         (g2 >> 8) ^ (g2 >> 9)) & 1;
+         g1 = ((g1 << 1) | fb1) & 0x3FF;
+         g2 = ((g2 << 1) | fb2) & 0x3FF;
+      }
+
+      std::vector<uint8_t> chips(CA_CODE_LENGTH);
+      long delay = G2Delay[PRNID-1];
+      for (long i=0; i<CA_CODE_LENGTH; ++i)
+      {
+         chips[i] = G1[i] ^ G2[(i + CA_CODE_LENGTH - delay) % CA_CODE_LENGTH];
+      }
+      setCode(chips);
+   }
+}     // end of namespace
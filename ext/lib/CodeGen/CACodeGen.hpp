@@ -0,0 +1,74 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+//  CACodeGen.hpp - GPS C/A-code generator
+#ifndef CACODEGEN_HPP
+#define CACODEGEN_HPP
+
+#include "PeriodicCodeGen.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup CodeGen
+      //@{
+      /// Number of chips in one period (1 ms) of C/A-code
+   const long CA_CODE_LENGTH = 1023;
+
+      /**
+       *  CACodeGen generates the C/A-code of IS-GPS-200 section 3.3.2.3
+       *  for PRN 1-63.  The code is the sum of the G1 sequence and the
+       *  G2 sequence delayed by a PRN-dependent number of chips (tables
+       *  3-Ia and 3-Ib), both from 10-stage registers initialized to all
+       *  ones.  Chip 0 is the first chip after the 1 ms epoch.
+       */
+   class CACodeGen : public PeriodicCodeGen
+   {
+   public:
+         /** Generate the C/A-code for a PRN.
+          * @throw Exception if SVPRNID is not between 1 and 63. */
+      CACodeGen( const int SVPRNID );
+
+         /// Maximum PRN that has a C/A-code assignment
+      static const int MAX_PRN = 63;
+
+         /// G2 delay in chips for PRN 1-63, indexed by PRN-1
+      static const int G2Delay[MAX_PRN];
+   };
+      //@}
+}     // end of namespace
+#endif // CACODEGEN_HPP
@@ -0,0 +1,101 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "Exception.hpp"
+#include "L2CCodeGen.hpp"
+
+namespace gnsstk
+{
+   const int L2CCodeGen::MAX_PRN;
+
+      // IS-GPS-200 table 3-IIa
+   const uint32_t L2CCodeGen::CMInit[MAX_PRN] =
+   {
+      0742417664, 0756014035, 0002747144, 0066265724, 0601403471,
+      0703232733, 0124510070, 0617316361, 0047541621, 0733031046,
+      0713512145, 0024437606, 0021264003, 0230655351, 0001314400,
+      0222021506, 0540264026, 0205521705, 0064022144, 0120161274,
+      0044023533, 0724744327, 0045743577, 0741201660, 0700274134,
+      0010247261, 0713433445, 0737324162, 0311627434, 0710452007,
+      0722462133, 0050172213, 0500653703, 0755077436, 0136717361,
+      0756675453, 0435506112
+   };
+
+   const uint32_t L2CCodeGen::CLInit[MAX_PRN] =
+   {
+      0624145772, 0506610362, 0220360016, 0710406104, 0001143345,
+      0053023326, 0652521276, 0206124777, 0015563374, 0561522076,
+      0023163525, 0117776450, 0606516355, 0003037343, 0046515565,
+      0671511621, 0605402220, 0002576207, 0525163451, 0266527765,
+      0006760703, 0501474556, 0743747443, 0615534726, 0763621420,
+      0720727474, 0700521043, 0222567263, 0132765304, 0746332245,
+      0102300466, 0255231716, 0437661701, 0717047302, 0222614207,
+      0561123307, 0240713073
+   };
+
+   L2CCodeGen::L2CCodeGen( const int SVPRNID, const Code code )
+         : whichCode(code)
+   {
+      if (SVPRNID < 1 || SVPRNID > MAX_PRN)
+      {
+         gnsstk::Exception e("Must provide a prn between 1 and 37");
+         GNSSTK_THROW(e);
+      }
+      PRNID = SVPRNID;
+
+         /*
+            The register shifts toward stage 27 (the lsb here), which is
+            the output; the output is fed back into each tapped stage.
+            With this arrangement the PRN 1 registers reach the end
+            states of table 3-IIa (552566002 and 267724236) on the last
+            chip of each code.
+         */
+      const uint32_t taps = 0445112474;
+      long len = (code==CM) ? L2CM_CODE_LENGTH : L2CL_CODE_LENGTH;
+      uint32_t reg = (code==CM) ? CMInit[PRNID-1] : CLInit[PRNID-1];
+      std::vector<uint8_t> chips(len);
+      for (long i=0; i<len; ++i)
+      {
+         uint32_t out = reg & 1;
+         chips[i] = out;
+         reg >>= 1;
+         if (out) reg ^= taps;
+      }
+      setCode(chips);
+   }
+}     // end of namespace
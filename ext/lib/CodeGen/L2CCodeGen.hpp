@@ -0,0 +1,89 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+//  L2CCodeGen.hpp - GPS L2C (CM and CL) code generator
+#ifndef L2CCODEGEN_HPP
+#define L2CCODEGEN_HPP
+
+#include "PeriodicCodeGen.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup CodeGen
+      //@{
+      /// Number of chips in one period (20 ms) of L2 CM-code
+   const long L2CM_CODE_LENGTH = 10230;
+      /// Number of chips in one period (1.5 s) of L2 CL-code
+   const long L2CL_CODE_LENGTH = 767250;
+
+      /**
+       *  L2CCodeGen generates the L2 CM- or CL-code of IS-GPS-200 section
+       *  3.3.2.4 for PRN 1-37.  Both codes come from the same 27-stage
+       *  linear shift register, 1 + x^3 + x^4 + x^5 + x^6 + x^9 + x^11 +
+       *  x^13 + x^16 + x^19 + x^21 + x^24 + x^27, started in the
+       *  PRN-dependent initial state of table 3-IIa and reset after
+       *  10230 (CM) or 767250 (CL) chips.  The chips are those of the
+       *  code itself; time multiplexing of CM and CL at 1.023 MHz is left
+       *  to the caller.
+       */
+   class L2CCodeGen : public PeriodicCodeGen
+   {
+   public:
+         /// The two L2C codes
+      enum Code { CM, CL };
+
+         /** Generate the CM- or CL-code for a PRN.
+          * @throw Exception if SVPRNID is not between 1 and 37. */
+      L2CCodeGen( const int SVPRNID, const Code code );
+
+         /// Accessor returning which code was generated
+      Code getCode( ) const { return whichCode; }
+
+         /// Maximum PRN that has an L2C code assignment here
+      static const int MAX_PRN = 37;
+
+         /// Initial register states (octal in the ICD), indexed by PRN-1
+      static const uint32_t CMInit[MAX_PRN];
+      static const uint32_t CLInit[MAX_PRN];
+
+   private:
+      Code whichCode;
+   };
+      //@}
+}     // end of namespace
+#endif // L2CCODEGEN_HPP
@@ -0,0 +1,112 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "Exception.hpp"
+#include "L5CodeGen.hpp"
+
+namespace gnsstk
+{
+   const int L5CodeGen::MAX_PRN;
+
+      // IS-GPS-705 table 3-Ia
+   const int L5CodeGen::I5Advance[MAX_PRN] =
+   {
+       266,  365,  804, 1138, 1509, 1559, 1756, 2084, 2170, 2303,
+      2527, 2687, 2930, 3471, 3940, 4132, 4332, 4924, 5343, 5443,
+      5641, 5816, 5898, 5918, 5955, 6243, 6345, 6477, 6518, 6875,
+      7168, 7187, 7329, 7577, 7720, 7777, 8057
+   };
+
+   const int L5CodeGen::Q5Advance[MAX_PRN] =
+   {
+      1701,  323, 5292, 2020, 5429, 7136, 1041, 5947, 4315,  148,
+       535, 1939, 5206, 5910, 3595, 5135, 6082, 6990, 3546, 1523,
+      4548, 4484, 1893, 3961, 7106, 5299, 4660,  276, 4389, 3783,
+      1591, 1601,  749, 1387, 1661, 3210,  708
+   };
+
+   L5CodeGen::L5CodeGen( const int SVPRNID, const Code code )
+         : whichCode(code)
+   {
+      if (SVPRNID < 1 || SVPRNID > MAX_PRN)
+      {
+         gnsstk::Exception e("Must provide a prn between 1 and 37");
+         GNSSTK_THROW(e);
+      }
+      PRNID = SVPRNID;
+
+         /*
+            Both registers shift toward stage 13, which is the output.
+            Bit n-1 of xa and xb holds stage n.  XA is reset to all ones
+            in place of the state 1111111111101 (stages 1-13), i.e.
+            after 8190 chips.  With this arrangement the PRN 1 XB states
+            after the advance are 0101011100100 (I5) and 1001011001100
+            (Q5), as in table 3-Ia.
+         */
+      const int XB_LENGTH = 8191;
+      const unsigned allOnes = 0x1FFF;
+      const unsigned xaLast = 0x1FFF & ~0x0800;
+      std::vector<uint8_t> XB(XB_LENGTH);
+      unsigned xb = allOnes;
+      for (int i=0; i<XB_LENGTH; ++i)
+      {
+         XB[i] = (xb >> 12) & 1;
+         unsigned fb = (xb ^ (xb >> 2) ^ (xb >> 3) ^ (xb >> 5) ^ (xb >> 6) ^
+                        (xb >> 7) ^ (xb >> 11) ^ (xb >> 12)) & 1;
+         xb = ((xb << 1) | fb) & allOnes;
+      }
+
+      long advance = (code==I5) ? I5Advance[PRNID-1] : Q5Advance[PRNID-1];
+      std::vector<uint8_t> chips(L5_CODE_LENGTH);
+      unsigned xa = allOnes;
+      for (long i=0; i<L5_CODE_LENGTH; ++i)
+      {
+         chips[i] = ((xa >> 12) & 1) ^ XB[(i + advance) % XB_LENGTH];
+         if (xa==xaLast)
+         {
+            xa = allOnes;
+         }
+         else
+         {
+            unsigned fb = ((xa >> 8) ^ (xa >> 9) ^ (xa >> 11) ^ (xa >> 12)) & 1;
+            xa = ((xa << 1) | fb) & allOnes;
+         }
+      }
+      setCode(chips);
+   }
+}     // end of namespace
@@ -0,0 +1,87 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+//  L5CodeGen.hpp - GPS L5 (I5 and Q5) code generator
+#ifndef L5CODEGEN_HPP
+#define L5CODEGEN_HPP
+
+#include "PeriodicCodeGen.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup CodeGen
+      //@{
+      /// Number of chips in one period (1 ms) of L5 I5- or Q5-code
+   const long L5_CODE_LENGTH = 10230;
+
+      /**
+       *  L5CodeGen generates the L5 I5- or Q5-code of IS-GPS-705 section
+       *  3.3.2.2 for PRN 1-37.  The code is the sum of the XA sequence
+       *  (1 + x^9 + x^10 + x^12 + x^13, short-cycled to 8190 chips) and
+       *  the XB sequence (1 + x + x^3 + x^4 + x^6 + x^7 + x^8 + x^12 +
+       *  x^13, 8191 chips) advanced by the PRN-dependent number of chips
+       *  of table 3-Ia.  Both registers start at all ones and are reset
+       *  at the start of each 10230 chip code.  Neuman-Hofman secondary
+       *  codes are not included.
+       */
+   class L5CodeGen : public PeriodicCodeGen
+   {
+   public:
+         /// The two L5 codes
+      enum Code { I5, Q5 };
+
+         /** Generate the I5- or Q5-code for a PRN.
+          * @throw Exception if SVPRNID is not between 1 and 37. */
+      L5CodeGen( const int SVPRNID, const Code code );
+
+         /// Accessor returning which code was generated
+      Code getCode( ) const { return whichCode; }
+
+         /// Maximum PRN that has an L5 code assignment here
+      static const int MAX_PRN = 37;
+
+         /// XB advance in chips, indexed by PRN-1
+      static const int I5Advance[MAX_PRN];
+      static const int Q5Advance[MAX_PRN];
+
+   private:
+      Code whichCode;
+   };
+      //@}
+}     // end of namespace
+#endif // L5CODEGEN_HPP
@@ -54,6 +54,9 @@ namespace gnsstk
       /// Number of bits assumed to be in a unsigned long int
    const int MAX_BIT = 32;
 
+      /// Number of chips packed into each uint64_t by the getChips() methods
+   const int MAX_BIT64 = 64;
+
       /// Maximum PRN Code number (1-n)
    const int MAX_PRN_CODE = 210;
 
@@ -63,6 +66,9 @@ namespace gnsstk
       /// Number of 4 byte unsigned ints necessary to hold 6 sec of P-code
    const long NUM_6SEC_WORDS = 1918125;
 
+      /// Number of P-code chips in 6 sec (four Z-counts)
+   const long NUM_6SEC_CHIPS = NUM_6SEC_WORDS * MAX_BIT;
+
       /// Number of 4 byte unsigned ints necessary to hold an X2 sequence (with leading delay)
    const long NUM_X2_WORDS   = 1918131;
 
@@ -95,6 +101,12 @@ namespace gnsstk
 
       /// The 37 chip delay at the end of every X2A epoch
    const long X2A_EPOCH_DELAY = 37;
+
+      /// Number of uint64_t words needed to hold numChips chips
+   inline long numChipWords( const long numChips )
+   {
+      return (numChips + MAX_BIT64 - 1) / MAX_BIT64;
+   }
    //@}
 } // namespace
 
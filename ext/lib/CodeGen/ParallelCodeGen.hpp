@@ -0,0 +1,84 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+//  ParallelCodeGen.hpp - Generate chips for several SVs on several threads
+#ifndef PARALLELCODEGEN_HPP
+#define PARALLELCODEGEN_HPP
+
+#include <vector>
+#include "gnsstkplatform.h"
+#include "PCodeConst.hpp"
+#include "parallel_for.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup CodeGen
+      //@{
+      /**
+       *  Generate the same chip range for each of a set of code
+       *  generators, one generator at a time per thread.  CodeGen may be
+       *  SVPCodeGen or any class derived from PeriodicCodeGen, or
+       *  anything else with a const getChips(firstChip, numChips,
+       *  words) method that is safe to call from several threads.
+       *
+       *  @param[in] gens the code generators, e.g. one per PRN.
+       *  @param[in] firstChip first chip of the range, as understood by
+       *    CodeGen::getChips( ).
+       *  @param[in] numChips number of chips to generate.
+       *  @param[out] words words[i] holds the chips of gens[i], packed as
+       *    by CodeGen::getChips( ).
+       *  @param[in] nthreads number of threads, 0 for one per hardware
+       *    thread.
+       *  @throw Exception as thrown by CodeGen::getChips( ).
+       */
+   template <class CodeGen>
+   void getChips( const std::vector<CodeGen>& gens,
+                  long firstChip, long numChips,
+                  std::vector< std::vector<uint64_t> >& words,
+                  unsigned nthreads = 0 )
+   {
+      words.resize(gens.size());
+      for (size_t i=0; i<gens.size(); ++i)
+         words[i].resize(numChipWords(numChips));
+      parallelFor(gens.size(), nthreads,
+                  [&](std::size_t i)
+                  { gens[i].getChips(firstChip, numChips, words[i].data()); });
+   }
+      //@}
+}     // end of namespace
+#endif // PARALLELCODEGEN_HPP
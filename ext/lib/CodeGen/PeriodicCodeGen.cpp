@@ -0,0 +1,92 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "Exception.hpp"
+#include "PeriodicCodeGen.hpp"
+
+namespace gnsstk
+{
+   int PeriodicCodeGen::getChip( long i ) const
+   {
+      i %= length;
+      return (bits[i / MAX_BIT64] >> (MAX_BIT64 - 1 - i % MAX_BIT64)) & 1;
+   }
+
+   void PeriodicCodeGen::getChips( long firstChip, long numChips,
+                                   uint64_t* words ) const
+   {
+      if (firstChip < 0 || numChips < 0)
+      {
+         gnsstk::Exception e("Chip range must not be negative");
+         GNSSTK_THROW(e);
+      }
+
+      long numWords = numChipWords(numChips);
+      long i = firstChip % length;
+      for (long j=0; j<numWords; ++j)
+      {
+            // bits holds 64 chips past the end of the period, so this
+            // never needs to wrap in the middle of a word.
+         long ndx = i / MAX_BIT64;
+         int offset = i - ndx * MAX_BIT64;
+         uint64_t word = bits[ndx];
+         if (offset!=0)
+            word = (word << offset) | (bits[ndx+1] >> (MAX_BIT64 - offset));
+         words[j] = word;
+         i += MAX_BIT64;
+         if (i>=length) i -= length;
+      }
+
+         // Clear the chips past the end of the range
+      int numUsed = numChips - (numWords - 1) * MAX_BIT64;
+      if (numWords > 0 && numUsed < MAX_BIT64)
+         words[numWords-1] &= ~(~uint64_t(0) >> numUsed);
+   }
+
+   void PeriodicCodeGen::setCode( const std::vector<uint8_t>& chips )
+   {
+      length = chips.size();
+      long total = length + MAX_BIT64;
+      bits.assign(numChipWords(total) + 1, 0);
+      for (long i=0; i<total; ++i)
+      {
+         if (chips[i % length])
+            bits[i / MAX_BIT64] |= uint64_t(1) << (MAX_BIT64 - 1 - i % MAX_BIT64);
+      }
+   }
+}     // end of namespace
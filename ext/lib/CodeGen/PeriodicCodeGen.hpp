@@ -0,0 +1,105 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+//  PeriodicCodeGen.hpp - Base class for short, periodic GPS ranging codes
+#ifndef PERIODICCODEGEN_HPP
+#define PERIODICCODEGEN_HPP
+
+#include <vector>
+#include "gnsstkplatform.h"
+#include "PCodeConst.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup CodeGen
+      //@{
+      /**
+       *  PeriodicCodeGen holds one period of a ranging code that repeats
+       *  every few thousand to few hundred thousand chips (C/A, L2C, L5)
+       *  and hands out arbitrary chip ranges of it, 64 chips to a word.
+       *  Derived classes generate the code for a particular signal and
+       *  PRN and pass the chips to setCode( ).
+       *
+       *  The code is stored packed msb first, followed by a copy of its
+       *  first 64 chips, so that any 64 chips of the code can be taken
+       *  from two adjacent words no matter where in the period they
+       *  start.  getChips( ) is const and may be used from several
+       *  threads at once (see ParallelCodeGen.hpp).
+       */
+   class PeriodicCodeGen
+   {
+   public:
+      virtual ~PeriodicCodeGen( ) {}
+
+         /// Accessor returning the PRN ID of the code
+      int getPRNID( ) const { return PRNID; }
+
+         /// Number of chips in one period of the code
+      long getLength( ) const { return length; }
+
+         /// Return chip number i (0 or 1) of the code, for any i >= 0.
+      int getChip( long i ) const;
+
+         /**
+          *  Generate numChips chips of the code starting with chip
+          *  firstChip, counted from the start of a code period.  The
+          *  range may be longer than a period and wraps as the code
+          *  does.  The chips are packed 64 to a word in time order, msb
+          *  first, and unused bits of the last word are zero.
+          *  @param[in] firstChip chip number of the first chip; must not
+          *    be negative.
+          *  @param[in] numChips number of chips to generate.
+          *  @param[out] words numChipWords(numChips) words of chips.
+          *  @throw Exception if firstChip or numChips is negative.
+          */
+      void getChips( long firstChip, long numChips, uint64_t* words ) const;
+
+   protected:
+      PeriodicCodeGen( ) : PRNID(0), length(0) {}
+
+         /** Store one period of the code, one chip (0 or 1) per entry.
+          * The period is the size of chips. */
+      void setCode( const std::vector<uint8_t>& chips );
+
+      int PRNID;
+      long length;
+      std::vector<uint64_t> bits;
+   };
+      //@}
+}     // end of namespace
+#endif // PERIODICCODEGEN_HPP
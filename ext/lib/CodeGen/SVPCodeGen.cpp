@@ -57,12 +57,12 @@ namespace gnsstk
       PRNID = SVPRNID;
    }
 
-   void SVPCodeGen::getCurrentSixSeconds( CodeBuffer& pcb )
+   long SVPCodeGen::getX2Start( const gnsstk::CommonTime& dt, bool& eow ) const
    {
          // Compute appropriate X2A offset
       int dayAdvance = (PRNID - 1) / 37;
       int EffPRNID = PRNID - dayAdvance * 37;
-      long X1count = GPSWeekZcount(currentZTime + dayAdvance*86400.0).zcount;
+      long X1count = GPSWeekZcount(dt + dayAdvance*86400.0).zcount;
       long X2count;
 
          /*
@@ -91,11 +91,18 @@ namespace gnsstk
 
          /*
             If this if the final six-second interval of the week,
-            signal the X2 bit sequence generator to use the "end of week"
+            the X2 bit sequence generator must use the "end of week"
             sequence.  Otherwise, use the "regular" sequence.
          */
-      if ( X1count==LAST_6SEC_ZCOUNT_OF_WEEK) X2Seq.setEOWX2Epoch(true);
-       else X2Seq.setEOWX2Epoch(false);
+      eow = (X1count==LAST_6SEC_ZCOUNT_OF_WEEK);
+      return X2count;
+   }
+
+   void SVPCodeGen::getCurrentSixSeconds( CodeBuffer& pcb )
+   {
+      bool eow;
+      long X2count = getX2Start(currentZTime, eow);
+      X2Seq.setEOWX2Epoch(eow);
 
          // Update the time and code state in the CodeBuffer object
       pcb.updateBufferStatus( currentZTime, P_CODE );
@@ -110,6 +117,57 @@ namespace gnsstk
       }
    }
 
+   void SVPCodeGen::getChips( long firstChip, long numChips,
+                              uint64_t* words ) const
+   {
+      if (firstChip < 0 || numChips < 0)
+      {
+         gnsstk::Exception e("Chip range must not be negative");
+         GNSSTK_THROW(e);
+      }
+
+      long numWords = numChipWords(numChips);
+      long period = firstChip / NUM_6SEC_CHIPS;
+      long X1count = firstChip - period * NUM_6SEC_CHIPS;
+      bool eow;
+      long X2count = getX2Start(currentZTime + period * 6.0, eow) + X1count;
+      if (X2count>=MAX_X2_TEST) X2count -= MAX_X2_TEST;
+
+      for (long i=0; i<numWords; ++i)
+      {
+         uint64_t word = X1Seq.chips64(X1count) ^ X2Seq.chips64(X2count, eow);
+         long numLeft = NUM_6SEC_CHIPS - X1count;
+         if (numLeft > MAX_BIT64)
+         {
+            X1count += MAX_BIT64;
+            X2count += MAX_BIT64;
+            if (X2count>=MAX_X2_TEST) X2count -= MAX_X2_TEST;
+         }
+         else
+         {
+               // Move on to the next six second period.  A word that
+               // runs into it takes the rest of its chips from there.
+            ++period;
+            long X2start = getX2Start(currentZTime + period * 6.0, eow);
+            if (numLeft < MAX_BIT64)
+            {
+               uint64_t next = X1Seq.chips64(0) ^ X2Seq.chips64(X2start, eow);
+               word = (word >> (MAX_BIT64 - numLeft) << (MAX_BIT64 - numLeft)) |
+                      (next >> numLeft);
+            }
+            X1count = MAX_BIT64 - numLeft;
+            X2count = X2start + X1count;
+            if (X2count>=MAX_X2_TEST) X2count -= MAX_X2_TEST;
+         }
+         words[i] = word;
+      }
+
+         // Clear the chips past the end of the range
+      int numUsed = numChips - (numWords - 1) * MAX_BIT64;
+      if (numWords > 0 && numUsed < MAX_BIT64)
+         words[numWords-1] &= ~(~uint64_t(0) >> numUsed);
+   }
+
    void SVPCodeGen::increment4ZCounts( )
    {
       currentZTime += 6;    // 6 seconds == 4 Zcounts.
@@ -139,7 +139,36 @@ namespace gnsstk
       **/
       void setCurrentZCount(const gnsstk::GPSZcount& z);
 
+      /**
+       *  Generate numChips chips of P-code starting firstChip chips
+       *  after the current Z-count, without filling a whole CodeBuffer.
+       *  The range may start anywhere and may run across any number of
+       *  six second periods (including the end of week).  The chips are
+       *  packed 64 to a word in time order, msb first, and unused bits
+       *  of the last word are zero.  The current Z-count is not changed.
+       *  Chips are the same as those given by getCurrentSixSeconds( )
+       *  for the corresponding periods.
+       *
+       *  Unlike getCurrentSixSeconds( ), this is const and may be called
+       *  for several SVs on several threads at once (see
+       *  ParallelCodeGen.hpp).
+       *
+       *  @param[in] firstChip offset of the first chip from the
+       *    current Z-count; must not be negative.
+       *  @param[in] numChips number of chips to generate.
+       *  @param[out] words numChipWords(numChips) words of chips.
+       *  @throw Exception if firstChip or numChips is negative.
+       */
+      void getChips( long firstChip, long numChips, uint64_t* words ) const;
+
    private:
+      /**
+       *  Return the X2 chip number that goes with the first X1 chip of the
+       *  six second period starting at dt, and set eow if that period is
+       *  the last of the week.
+       */
+      long getX2Start( const gnsstk::CommonTime& dt, bool& eow ) const;
+
       gnsstk::X1Sequence X1Seq;
       gnsstk::X2Sequence X2Seq;
       gnsstk::CommonTime currentZTime;
@@ -141,6 +141,18 @@ namespace gnsstk
       isInit = true;
    }
 
+      // Slow path of chips64() for the last 63 chips of the sequence.
+   uint64_t X1Sequence::wrapChips64( long i ) const
+   {
+      uint64_t retArg = 0;
+      for (int n=0; n<MAX_BIT64; ++n)
+      {
+         if (i>=NUM_6SEC_CHIPS) i -= NUM_6SEC_CHIPS;
+         retArg = (retArg << 1) | getPackedBit(X1Bits, i++);
+      }
+      return(retArg);
+   }
+
    void X1Sequence::deAllocateMemory()
    {
       if (isInit!=true || X1Bits==0)
@@ -44,6 +44,7 @@
    // Project headers
 #include "gnsstkplatform.h"
 #include "PCodeConst.hpp"
+#include "mergePCodeWords.h"
 
 namespace gnsstk
 {
@@ -110,7 +111,17 @@ namespace gnsstk
              */
          const uint32_t & operator[] ( int i ) const;
 
+            /**
+             *  Given a chip number from 0 to NUM_6SEC_CHIPS-1, return the
+             *  64 chips starting with that chip, msb first.  Chips past
+             *  the end of the six seconds wrap to the beginning, as the
+             *  X1 sequence repeats.
+             */
+         uint64_t chips64( long i ) const;
+
       private:
+         uint64_t wrapChips64( long i ) const;
+
          static uint32_t* X1Bits;
          static bool isInit;
    };
@@ -125,5 +136,11 @@ namespace gnsstk
       return(X1Bits[i]);
    }
 
+   inline uint64_t X1Sequence::chips64( long i ) const
+   {
+      if (i + MAX_BIT64 <= NUM_6SEC_CHIPS) return(extract64(X1Bits, i));
+      return(wrapChips64(i));
+   }
+
 }  // end of namespace
 #endif // X1SEQUENCE_HPP
@@ -229,6 +229,19 @@ namespace gnsstk
       isInit = false;
    }
 
+      // Slow path of chips64() near the end of the sequence.  As in
+      // operator[], the wrap is to bit 37, past the BOW delay chips.
+   uint64_t X2Sequence::wrapChips64( long i, const uint32_t* bits ) const
+   {
+      uint64_t retArg = 0;
+      for (int n=0; n<MAX_BIT64; ++n)
+      {
+         if (i>=MAX_X2_COUNT) i -= MAX_X2_TEST;
+         retArg = (retArg << 1) | getPackedBit(bits, i++);
+      }
+      return(retArg);
+   }
+
    void X2Sequence::setEOWX2Epoch( const bool tf )
    {
       if (tf) bitsP = X2BitsEOW;
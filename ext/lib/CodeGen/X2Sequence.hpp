@@ -183,7 +183,18 @@ namespace gnsstk
              */
          void setEOWX2Epoch( const bool tf );
 
+            /** Given a chip number from -37 to MAX_X2_TEST-1, return the
+             *  64 chips starting with that chip, msb first.  Unlike
+             *  operator[], the buffer is chosen by eow rather than
+             *  setEOWX2Epoch(), so this may be used from several threads
+             *  at once.  Chips past the end of the sequence wrap to its
+             *  beginning (chip 0, not the BOW delay chips).
+             */
+         uint64_t chips64( long i, bool eow ) const;
+
       private:
+         uint64_t wrapChips64( long i, const uint32_t* bits ) const;
+
          uint32_t *bitsP;
          static uint32_t* X2Bits;
          static uint32_t* X2BitsEOW;
@@ -284,6 +295,15 @@ namespace gnsstk
       }
       return(retArg);
    }
+
+   inline uint64_t X2Sequence::chips64( long i, bool eow ) const
+   {
+      long adjustedCount = i + X2A_EPOCH_DELAY;
+      const uint32_t* bits = eow ? X2BitsEOW : X2Bits;
+      if (adjustedCount + MAX_BIT64 <= MAX_X2_COUNT)
+         return(extract64(bits, adjustedCount));
+      return(wrapChips64(adjustedCount, bits));
+   }
    //@}
 }  // end of namespace
 
@@ -62,4 +62,37 @@
       return(outword);
    }
 
+/*
+*   extract64 - Return the 64 bits starting at bit first_bit of an array
+         of bit-packed 32-bit integers (bit 0 is the msb of words[0]).
+         words[first_bit/MAX_BIT + 2] is read unless first_bit falls on
+         a word boundary.
+*/
+   inline uint64_t extract64( const uint32_t* words,
+                              long first_bit )
+   {
+      long ndx = first_bit / gnsstk::MAX_BIT;
+      int offset = first_bit - ndx * gnsstk::MAX_BIT;
+      uint64_t outword = ((uint64_t)words[ndx] << gnsstk::MAX_BIT) |
+                         words[ndx+1];
+      if (offset==0) return(outword);
+
+      outword <<= offset;
+      outword |= words[ndx+2] >> (gnsstk::MAX_BIT - offset);
+
+      return(outword);
+   }
+
+/*
+*   getPackedBit - Return bit number i (0 or 1) of an array of bit-packed
+         32-bit integers.
+*/
+   inline uint64_t getPackedBit( const uint32_t* words,
+                                 long i )
+   {
+      long ndx = i / gnsstk::MAX_BIT;
+      return( (words[ndx] >> (gnsstk::MAX_BIT - 1 - (i - ndx * gnsstk::MAX_BIT)))
+              & 1 );
+   }
+
 #endif   // end of MERGEPCODEWORDS_H
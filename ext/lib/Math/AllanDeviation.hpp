@@ -56,7 +56,11 @@ namespace gnsstk
    //@{
 
 
-   /// Compute the overlapping Allan variance of the phase data provided.
+   /** Compute the overlapping Allan variance of the phase data provided,
+    * at every averaging time; the cost is O(N^2). Phase values of zero
+    * are treated as gaps. For octave-spaced averaging times, continuous
+    * streams of data, or the modified Allan, Hadamard and time
+    * deviations, see ClockDeviationStream. */
    class AllanDeviation
    {
    public:
@@ -113,7 +117,7 @@ namespace gnsstk
       int numGaps;
    };
 
-   std::ostream& operator<<(std::ostream& s, const AllanDeviation& a)
+   inline std::ostream& operator<<(std::ostream& s, const AllanDeviation& a)
    {
       a.dump(s);
       return s;
@@ -0,0 +1,260 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file ClockDeviation.cpp
+ * Overlapping Allan, modified Allan, Hadamard and time deviations of
+ * clock phase data, computed from a stream or from a batch of data.
+ */
+
+#include <cmath>
+#include <iomanip>
+
+#include "ClockDeviation.hpp"
+#include "parallel_for.hpp"
+
+namespace gnsstk
+{
+   ClockDeviationStream::Level ::
+   Level(unsigned mm)
+         : m(mm), d2buf(mm, 0.0), pos(0), nd(0), window(0.0),
+           sumA(0.0), sumM(0.0), sumH(0.0), nA(0), nM(0), nH(0)
+   {
+   }
+
+
+   void ClockDeviationStream::Level ::
+   restart()
+   {
+      pos = 0;
+      nd = 0;
+      window = 0.0;
+   }
+
+
+   void ClockDeviationStream::Level ::
+   addSecond(double d2)
+   {
+      sumA += d2*d2;
+      nA++;
+
+         // modified Allan: square of the sum of m consecutive d2
+      if (nd >= m)
+         window -= d2buf[pos];
+      d2buf[pos] = d2;
+      window += d2;
+      nd++;
+      if (++pos == m)
+      {
+         pos = 0;
+            // the buffer is full; remove any rounding in the running sum
+         window = 0.0;
+         for (unsigned i = 0; i < m; i++)
+            window += d2buf[i];
+      }
+      if (nd >= m)
+      {
+         sumM += window*window;
+         nM++;
+      }
+   }
+
+
+   DeviationPoint ClockDeviationStream::Level ::
+   result(double tau0) const
+   {
+      DeviationPoint dp;
+      dp.m = m;
+      dp.tau = m * tau0;
+      dp.nAllan = nA;
+      dp.nMod = nM;
+      dp.nHadamard = nH;
+      const double tau2(dp.tau*dp.tau), m2(double(m)*double(m));
+      if (nA > 0)
+         dp.adev = std::sqrt(sumA / (2.0 * tau2 * double(nA)));
+      if (nM > 0)
+      {
+         dp.mdev = std::sqrt(sumM / (2.0 * m2 * tau2 * double(nM)));
+         dp.tdev = dp.tau * dp.mdev / std::sqrt(3.0);
+      }
+      if (nH > 0)
+         dp.hdev = std::sqrt(sumH / (6.0 * tau2 * double(nH)));
+      return dp;
+   }
+
+
+   ClockDeviationStream ::
+   ClockDeviationStream(double t0, unsigned mMax)
+         : tau0(t0), mask(0), count(0), total(0)
+   {
+      if (tau0 <= 0.0 || mMax == 0)
+      {
+         Exception e("ClockDeviationStream needs tau0 > 0 and mMax > 0");
+         GNSSTK_THROW(e);
+      }
+      unsigned long m;
+      for (m = 1; m <= mMax; m *= 2)
+         levels.push_back(Level(m));
+      m = levels.back().m;
+      unsigned long size(1);
+      while (size < 3*m + 1)
+         size *= 2;
+      ring.resize(size, 0.0);
+      mask = size - 1;
+   }
+
+
+   void ClockDeviationStream ::
+   add(double x)
+   {
+      ring[count & mask] = x;
+      count++;
+      total++;
+         // newest is at count-1; levels need 2m+1 (Allan) or 3m+1 values
+      const unsigned long i(count - 1);
+      for (size_t k = 0; k < levels.size(); k++)
+      {
+         Level& lev(levels[k]);
+         const unsigned long m(lev.m);
+         if (count < 2*m + 1)
+            break;
+         const double xm(ring[(i - m) & mask]), x2m(ring[(i - 2*m) & mask]);
+         lev.addSecond(x - 2.0*xm + x2m);
+         if (count >= 3*m + 1)
+            lev.addThird(x - 3.0*xm + 3.0*x2m - ring[(i - 3*m) & mask]);
+      }
+   }
+
+
+   void ClockDeviationStream ::
+   restart()
+   {
+      count = 0;
+      for (size_t k = 0; k < levels.size(); k++)
+         levels[k].restart();
+   }
+
+
+   void ClockDeviationStream ::
+   reset()
+   {
+      restart();
+      total = 0;
+      for (size_t k = 0; k < levels.size(); k++)
+         levels[k] = Level(levels[k].m);
+   }
+
+
+   std::vector<DeviationPoint> ClockDeviationStream ::
+   getDeviations() const
+   {
+      std::vector<DeviationPoint> rv;
+      for (size_t k = 0; k < levels.size(); k++)
+         if (levels[k].nA > 0)
+            rv.push_back(levels[k].result(tau0));
+      return rv;
+   }
+
+
+   void ClockDeviationStream ::
+   dump(std::ostream& s) const
+   {
+      std::vector<DeviationPoint> devs(getDeviations());
+      std::ios_base::fmtflags oldFlags(s.flags());
+      std::streamsize oldPrecision(s.precision());
+      s << "# tau adev mdev hdev tdev nAllan" << std::endl;
+      for (size_t k = 0; k < devs.size(); k++)
+      {
+         s.flags(oldFlags);
+         s << devs[k].tau << std::scientific << std::setprecision(6)
+           << " " << devs[k].adev << " " << devs[k].mdev
+           << " " << devs[k].hdev << " " << devs[k].tdev
+           << " " << devs[k].nAllan << std::endl;
+      }
+      s.flags(oldFlags);
+      s.precision(oldPrecision);
+   }
+
+
+   std::vector<DeviationPoint> ClockDeviationStream ::
+   compute(const std::vector<double>& phase, double tau0,
+           const std::vector<unsigned>& mList, unsigned nthreads)
+   {
+      if (tau0 <= 0.0)
+      {
+         Exception e("ClockDeviationStream::compute needs tau0 > 0");
+         GNSSTK_THROW(e);
+      }
+      const unsigned long n(phase.size());
+      std::vector<DeviationPoint> all(mList.size());
+      parallelFor(mList.size(), nthreads,
+                  [&](std::size_t j)
+                  {
+                     const unsigned long m(mList[j]);
+                     if (m == 0 || n < 2*m + 1)
+                        return;
+                     Level lev(m);
+                     for (unsigned long i = 2*m; i < n; i++)
+                     {
+                        const double x(phase[i]), xm(phase[i-m]),
+                           x2m(phase[i-2*m]);
+                        lev.addSecond(x - 2.0*xm + x2m);
+                        if (i >= 3*m)
+                           lev.addThird(x - 3.0*xm + 3.0*x2m - phase[i-3*m]);
+                     }
+                     all[j] = lev.result(tau0);
+                  });
+
+      std::vector<DeviationPoint> rv;
+      for (size_t j = 0; j < all.size(); j++)
+         if (all[j].nAllan > 0)
+            rv.push_back(all[j]);
+      return rv;
+   }
+
+
+   std::vector<unsigned> ClockDeviationStream ::
+   octaveFactors(unsigned long n)
+   {
+      std::vector<unsigned> rv;
+      for (unsigned long m = 1; 2*m + 1 <= n; m *= 2)
+         rv.push_back(m);
+      return rv;
+   }
+
+}  // namespace
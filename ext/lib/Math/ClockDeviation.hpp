@@ -0,0 +1,199 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file ClockDeviation.hpp
+ * Overlapping Allan, modified Allan, Hadamard and time deviations of
+ * clock phase data, computed from a stream or from a batch of data.
+ */
+
+#ifndef GNSSTK_CLOCKDEVIATION_HPP
+#define GNSSTK_CLOCKDEVIATION_HPP
+
+#include <ostream>
+#include <vector>
+
+#include "Exception.hpp"
+
+namespace gnsstk
+{
+   /// @ingroup MathGroup
+   //@{
+
+      /// Deviations of clock phase data at one averaging time tau = m*tau0.
+   struct DeviationPoint
+   {
+      DeviationPoint()
+            : m(0), tau(0), adev(0), mdev(0), hdev(0), tdev(0),
+              nAllan(0), nMod(0), nHadamard(0)
+      {}
+
+      unsigned m;        ///< averaging factor
+      double tau;        ///< averaging time, m*tau0
+      double adev;       ///< overlapping Allan deviation
+      double mdev;       ///< modified Allan deviation
+      double hdev;       ///< overlapping Hadamard deviation
+      double tdev;       ///< time deviation, tau*mdev/sqrt(3)
+      unsigned long nAllan;    ///< number of terms in adev, 0 if undefined
+      unsigned long nMod;      ///< number of terms in mdev and tdev
+      unsigned long nHadamard; ///< number of terms in hdev
+   };
+
+      /** Compute the overlapping Allan, modified Allan, Hadamard and time
+       * deviations of clock phase data (seconds) at octave-spaced
+       * averaging factors m = 1, 2, 4, ..., as the data arrives.
+       *
+       * Each call to add() is O(1) per averaging factor: the second and
+       * third differences at each m come from a ring buffer of the last
+       * 3*mMax+1 phase values, and the modified Allan sums use a running
+       * sum over the last m second differences, which is recomputed from
+       * its own buffer once every m samples so it cannot drift. Memory is
+       * bounded, about 6*mMax doubles, however long the stream runs.
+       *
+       * At a gap in the data call restart(); no differences are formed
+       * across it, but the sums collected so far are kept. The results
+       * are those of the overlapping estimators on each continuous piece
+       * of data, pooled.
+       *
+       * Usage:
+       * @code
+       * ClockDeviationStream cds(1.0, 4096);
+       * for (...) cds.add(phase);
+       * std::vector<DeviationPoint> devs(cds.getDeviations());
+       * @endcode
+       */
+   class ClockDeviationStream
+   {
+   public:
+         /** Constructor.
+          * @param[in] tau0 sample interval of the phase data, seconds.
+          * @param[in] mMax largest averaging factor; the factors are the
+          *   powers of 2 up to mMax.
+          * @throw Exception if tau0 is not positive or mMax is zero. */
+      ClockDeviationStream(double tau0, unsigned mMax);
+
+         /// Add the next phase value (seconds).
+      void add(double phase);
+
+         /// Start a new piece of data, i.e. there is a gap before the next
+         /// call to add(). Sums collected so far are kept.
+      void restart();
+
+         /// Discard all data and sums.
+      void reset();
+
+         /// Return the number of phase values added since the last reset.
+      unsigned long size() const
+      { return total; }
+
+         /// Return the deviations at each averaging factor that has at
+         /// least one second difference.
+      std::vector<DeviationPoint> getDeviations() const;
+
+         /// Write the deviations, one line per tau.
+      void dump(std::ostream& s) const;
+
+         /** Batch computation of the same deviations over a continuous
+          * array of phase data, at any set of averaging factors. Each
+          * factor is one O(N) pass using the running sums of the stream,
+          * and the factors are independent, so they are shared among
+          * threads. Factors with no second difference are omitted.
+          * @param[in] phase phase data (seconds) at interval tau0.
+          * @param[in] tau0 sample interval, seconds.
+          * @param[in] mList averaging factors.
+          * @param[in] nthreads number of threads, 0 for one per hardware
+          *   thread.
+          * @throw Exception if tau0 is not positive. */
+      static std::vector<DeviationPoint>
+      compute(const std::vector<double>& phase, double tau0,
+              const std::vector<unsigned>& mList, unsigned nthreads = 1);
+
+         /// Return the octave-spaced factors 1, 2, 4, ... for which there
+         /// is at least one overlapping Allan term in n phase values.
+      static std::vector<unsigned> octaveFactors(unsigned long n);
+
+   private:
+         /// Sums for one averaging factor.
+      class Level
+      {
+      public:
+         Level(unsigned mm);
+
+            /// forget the second differences (start of a new piece)
+         void restart();
+
+            /// add the next second difference x[i+2m]-2x[i+m]+x[i]
+         void addSecond(double d2);
+
+            /// add the next third difference x[i+3m]-3x[i+2m]+3x[i+m]-x[i]
+         void addThird(double d3)
+         { sumH += d3*d3; nH++; }
+
+            /// compute the deviations from the sums
+         DeviationPoint result(double tau0) const;
+
+         unsigned m;           ///< averaging factor
+         std::vector<double> d2buf; ///< last m second differences
+         unsigned pos;         ///< next slot in d2buf
+         unsigned long nd;     ///< second differences in this piece
+         double window;        ///< sum of d2buf
+         double sumA, sumM, sumH;   ///< sums of squares
+         unsigned long nA, nM, nH;  ///< number of terms in the sums
+      };
+
+      double tau0;                 ///< sample interval, seconds
+      std::vector<Level> levels;   ///< one for each averaging factor
+      std::vector<double> ring;    ///< last phase values, size a power of 2
+      unsigned long mask;          ///< ring.size()-1
+      unsigned long count;         ///< phase values in this piece
+      unsigned long total;         ///< phase values since reset
+   };
+
+      /// Write the deviations of a ClockDeviationStream.
+   inline std::ostream& operator<<(std::ostream& s,
+                                   const ClockDeviationStream& cds)
+   {
+      cds.dump(s);
+      return s;
+   }
+
+   //@}
+
+}  // namespace
+
+#endif
@@ -75,22 +75,34 @@ namespace gnsstk
    //---------------------------------------------------------------------------
    void AshtechALB::decode(const std::string& data)
    {
-      using BinUtils::decodeVar;
+      decode(data.data(), data.size());
+   }
+
+
+   //---------------------------------------------------------------------------
+   void AshtechALB::decode(const char* data, size_t len)
+   {
+      using BinUtils::buntohs;
+      using BinUtils::buntohl;
 
-      string str(data);
       if (debugLevel>1)
-         cout << "ALB " << str.length() << " " << endl;
-      if (str.length() == 138)
+         cout << "ALB " << len << " " << endl;
+
+      clear(fmtbit | lenbit | crcbit);
+      if (len == 138)
       {
          ascii=false;
-         header      = str.substr(0,11); str.erase(0,11);
-         svid         = decodeVar<uint16_t>(str);
-         str.erase(0,1);
-
+         id.assign(data+7, 3);
+         header.assign(data, 11);
+         uint16_t u16;
+         uint32_t u32;
+         buntohs(data, u16, 11);
+         svid = u16;
          for (int w=0; w<10; w++)
-            word[w] = decodeVar<uint32_t>(str);
-
-         (void)decodeVar<uint16_t>(str);   // ignore checksum
+         {
+            buntohl(data, u32, 14 + 4*w);
+            word[w] = u32;
+         }
          clear(ios_base::goodbit);
       }
    }
@@ -36,6 +36,9 @@
 //
 //==============================================================================
 
+#include <cstdlib>
+#include <cstring>
+
 #include "StringUtils.hpp"
 #include "BinUtils.hpp"
 
@@ -158,6 +161,76 @@ namespace gnsstk
     }
 
 
+    //---------------------------------------------------------------------------
+    // Copy the field at p into buff, leaving p at the start of the next one.
+    static size_t copyField(const char*& p, const char* end,
+                            char* buff, size_t size)
+    {
+       const char* q = p;
+       while (q < end && *q != ',' && *q != '\r' && *q != '\n')
+          q++;
+       size_t len = q - p;
+       if (len >= size)
+          len = 0;
+       memcpy(buff, p, len);
+       buff[len] = 0;
+       p = (q < end) ? q+1 : q;
+       return len;
+    }
+
+
+    bool AshtechData::getField(const char*& p, const char* end, double& v)
+    {
+       char buff[64], *e;
+       if (copyField(p, end, buff, sizeof(buff)) == 0)
+          return false;
+       v = strtod(buff, &e);
+       return *e == 0;
+    }
+
+
+    bool AshtechData::getField(const char*& p, const char* end, float& v)
+    {
+       double d;
+       if (!getField(p, end, d))
+          return false;
+       v = d;
+       return true;
+    }
+
+
+    bool AshtechData::getField(const char*& p, const char* end, unsigned& v)
+    {
+       char buff[32], *e;
+       if (copyField(p, end, buff, sizeof(buff)) == 0)
+          return false;
+       v = strtoul(buff, &e, 10);
+       return *e == 0;
+    }
+
+
+    bool AshtechData::getField(const char*& p, const char* end, uint16_t& v)
+    {
+       unsigned u;
+       if (!getField(p, end, u))
+          return false;
+       v = u;
+       return true;
+    }
+
+
+    bool AshtechData::getField(const char*& p, const char* end,
+                               std::string& v)
+    {
+       const char* q = p;
+       while (q < end && *q != ',' && *q != '\r' && *q != '\n')
+          q++;
+       v.assign(p, q - p);
+       p = (q < end) ? q+1 : q;
+       return true;
+    }
+
+
     //---------------------------------------------------------------------------
     void AshtechData::dump(ostream& out) const noexcept
     {
@@ -82,6 +82,16 @@ namespace gnsstk
       virtual void decode(const std::string& str)
       {std::cout<<"AshtechData::decode()"<<std::endl;}
 
+      /** Decode this object from len bytes at data, such as a message
+       * located by AshtechFramer.  The data must be a complete
+       * message, from the preamble through the trailer.  The default
+       * copies the data to a string and calls decode(const std::string&).
+       * @param data the message to read from.
+       * @param len the number of bytes in the message.
+       */
+      virtual void decode(const char* data, size_t len)
+      {decode(std::string(data, len));}
+
       /// Simple accessors for various static thangs.
       virtual std::string getName() const {return "hdr";}
 
@@ -135,6 +145,20 @@ namespace gnsstk
           */
       virtual void readBody(AshtechStream& stream);
 
+         /** Read one comma separated ASCII field starting at p and
+          * move p past the field and its separator.  The field ends at
+          * a comma, a CR or LF, or end.
+          * @param[in,out] p the start of the field.
+          * @param[in] end the end of the message.
+          * @param[out] v the value of the field.
+          * @return false if the field isn't a valid number.
+          */
+      static bool getField(const char*& p, const char* end, double& v);
+      static bool getField(const char*& p, const char* end, float& v);
+      static bool getField(const char*& p, const char* end, unsigned& v);
+      static bool getField(const char*& p, const char* end, uint16_t& v);
+      static bool getField(const char*& p, const char* end, std::string& v);
+
    }; // class AshtechData
 } // namespace gnsstk
 
@@ -41,6 +41,8 @@
 
 #include "AshtechEPB.hpp"
 #include "AshtechStream.hpp"
+#include "GPSWeekSecond.hpp"
+#include "TimeConstants.hpp"
 
 using namespace std;
 
@@ -74,27 +76,90 @@ namespace gnsstk
    //---------------------------------------------------------------------------
    void AshtechEPB::decode(const std::string& data)
    {
-      using BinUtils::decodeVar;
-      using gnsstk::StringUtils::asInt;
+      decode(data.data(), data.size());
+   }
 
-      string str(data);
 
-      if (str.length() == 138)
+   //---------------------------------------------------------------------------
+   void AshtechEPB::decode(const char* data, size_t len)
+   {
+      using BinUtils::buntohl;
+      using gnsstk::StringUtils::asInt;
+
+      clear(fmtbit | lenbit | crcbit);
+      if (len == 138)
       {
          ascii = false;
-         header      = str.substr(0,11); str.erase(0,11);
-         prn         = asInt(str.substr(0,2));
-         str.erase(0,3);
+         id.assign(data+7, 3);
+         header.assign(data, 11);
+         prn = asInt(string(data+11, 2));
 
+         uint32_t u32;
+         const char* p = data + 14;
          for (int s=1; s<=3; s++)
-            for (int w=1; w<=10; w++)
-               word[s][w] = decodeVar<uint32_t>(str);
+         {
+            for (int w=1; w<=10; w++, p+=4)
+            {
+               buntohl(p, u32);
+               word[s][w] = u32;
+            }
+         }
 
-          (void)decodeVar<uint16_t>(str);   // ignore checksum
+          // ignore checksum
           clear(ios_base::goodbit);
       }
    }
 
+
+   //---------------------------------------------------------------------------
+   CommonTime AshtechEPB::getXmitTime(unsigned sf, unsigned week) const
+   {
+      if (sf < 1 || sf > 3)
+      {
+         InvalidRequest exc("Subframe " + StringUtils::asString(sf) +
+                            " is not 1-3");
+         GNSSTK_THROW(exc);
+      }
+         // The HOW gives the start of the next subframe.
+      long sow = ((word[sf][2] >> 13) & 0x1ffff) * 6L - 6;
+      if (sow < 0)
+      {
+         sow += FULLWEEK;
+         week--;
+      }
+      return GPSWeekSecond(week, sow);
+   }
+
+
+   //---------------------------------------------------------------------------
+   void AshtechEPB::getFilterData(unsigned sf, unsigned week, uint32_t* words,
+                                  LNavFilterData& fd) const
+   {
+      fd.timeStamp = getXmitTime(sf, week);
+      fd.prn = prn;
+      fd.carrier = CarrierBand::L1;
+      fd.code = TrackingCode::CA;
+      for (int w=1; w<=10; w++)
+         words[w-1] = word[sf][w] & 0x3fffffff;
+      fd.sf = words;
+   }
+
+
+   //---------------------------------------------------------------------------
+   void AshtechEPB::getPackedNavBits(unsigned sf, unsigned week,
+                                     PackedNavBits& pnb) const
+   {
+      pnb.setTime(getXmitTime(sf, week));
+      pnb.setSatID(SatID(prn, SatelliteSystem::GPS));
+      pnb.setObsID(ObsID(ObservationType::NavMsg, CarrierBand::L1,
+                         TrackingCode::CA));
+      pnb.setNavID(NavID(NavType::GPSLNAV));
+      pnb.reset_num_bits(0);
+      for (int w=1; w<=10; w++)
+         pnb.addUnsignedLong(word[sf][w] & 0x3fffffff, 30, 1);
+      pnb.trimsize();
+   }
+
    //---------------------------------------------------------------------------
    void AshtechEPB::dump(ostream& out) const noexcept
    {
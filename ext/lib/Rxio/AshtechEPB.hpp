@@ -46,6 +46,9 @@
 
 #include "gnsstk_export.h"
 #include "AshtechData.hpp"
+#include "CommonTime.hpp"
+#include "LNavFilterData.hpp"
+#include "PackedNavBits.hpp"
 
 #ifdef SWIG
 %immutable gnsstk::AshtechEPB::myId;
@@ -82,6 +85,44 @@ namespace gnsstk
           */
       virtual void decode(const std::string& data);
 
+         /// Decode in place from a framed message, len bytes from the
+         /// preamble through the trailer (see AshtechFramer).
+      virtual void decode(const char* data, size_t len);
+
+         /** Get the time of transmission of the start of a subframe
+          * from the TOW count in its HOW.
+          * @param[in] sf the subframe, 1-3.
+          * @param[in] week the full GPS week the data was received
+          *   in, which the message doesn't include.
+          * @return the transmit time of the subframe.
+          * @throw InvalidRequest if sf is out of range.
+          */
+      CommonTime getXmitTime(unsigned sf, unsigned week) const;
+
+         /** Fill in a filter data object so a subframe can be passed
+          * to NavFilterMgr::validate().  The words are assumed to
+          * hold the 30 bits of each subframe word right-aligned,
+          * parity included, as LNavFilterData expects.
+          * @param[in] sf the subframe, 1-3.
+          * @param[in] week the full GPS week the data was received in.
+          * @param[out] words storage for the 10 words of the
+          *   subframe, which fd.sf will point to.
+          * @param[out] fd the filter data to fill in.
+          * @throw InvalidRequest if sf is out of range.
+          */
+      void getFilterData(unsigned sf, unsigned week, uint32_t* words,
+                         LNavFilterData& fd) const;
+
+         /** Store a subframe in a PackedNavBits object, for use with
+          * PNBGPSLNavDataFactory and the like.
+          * @param[in] sf the subframe, 1-3.
+          * @param[in] week the full GPS week the data was received in.
+          * @param[out] pnb the object to fill in.
+          * @throw InvalidRequest if sf is out of range.
+          */
+      void getPackedNavBits(unsigned sf, unsigned week,
+                            PackedNavBits& pnb) const;
+
    protected:
          /**
           * @throw std::exception
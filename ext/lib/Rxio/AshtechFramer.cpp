@@ -0,0 +1,301 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "AshtechFramer.hpp"
+#include "AshtechData.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+   const size_t AshtechFramer::headerLength;
+
+   //---------------------------------------------------------------------------
+   AshtechFramer::AshtechFramer()
+   {
+      reset();
+      setBinaryLength("MPC", 108);
+      setBinaryLength("MCA", 52);
+      setBinaryLength("PBN", 69);
+      setBinaryLength("EPB", 138);
+      setBinaryLength("ALB", 138);
+   }
+
+
+   //---------------------------------------------------------------------------
+   void AshtechFramer::reset()
+   {
+      buffer.clear();
+      pos = 0;
+      bufferOffset = 0;
+      finished = false;
+      inSync = true;
+      numAscii = 0;
+      numBinary = 0;
+      numDiscarded = 0;
+      numResyncs = 0;
+      idCounts.clear();
+   }
+
+
+   //---------------------------------------------------------------------------
+   void AshtechFramer::setBinaryLength(const string& msgId, size_t len)
+   {
+      for (size_t i = 0; i < binaryLengths.size(); i++)
+      {
+         if (msgId.compare(0, 3, binaryLengths[i].id, 3) == 0)
+         {
+            binaryLengths[i].length = len;
+            return;
+         }
+      }
+      BinaryLength bl;
+      memset(bl.id, 0, sizeof(bl.id));
+      memcpy(bl.id, msgId.data(), min(msgId.size(), sizeof(bl.id)));
+      bl.length = len;
+      binaryLengths.push_back(bl);
+   }
+
+
+   //---------------------------------------------------------------------------
+   size_t AshtechFramer::getBinaryLength(const char* msgId) const
+   {
+      for (size_t i = 0; i < binaryLengths.size(); i++)
+      {
+         if (memcmp(msgId, binaryLengths[i].id, 3) == 0)
+            return binaryLengths[i].length;
+      }
+      return 0;
+   }
+
+
+   //---------------------------------------------------------------------------
+   void AshtechFramer::append(const char* data, size_t len)
+   {
+         // Drop the data already framed, but only once it's a good
+         // part of the buffer so the data isn't moved for every message.
+      if (pos > 0 && pos >= buffer.size() / 2)
+      {
+         buffer.erase(0, pos);
+         bufferOffset += pos;
+         pos = 0;
+      }
+      buffer.append(data, len);
+   }
+
+
+   //---------------------------------------------------------------------------
+   void AshtechFramer::finish()
+   {
+      finished = true;
+   }
+
+
+   //---------------------------------------------------------------------------
+   void AshtechFramer::discard(size_t n)
+   {
+      if (n == 0)
+         return;
+      if (inSync)
+      {
+         numResyncs++;
+         inSync = false;
+      }
+      if (AshtechData::debugLevel>2)
+         cout << "Tossing " << n << " bytes at offset: 0x" << hex
+              << bufferOffset + pos << dec << endl;
+      numDiscarded += n;
+      pos += n;
+   }
+
+
+   //---------------------------------------------------------------------------
+   void AshtechFramer::emit(Frame& frame, size_t len, bool isAscii)
+   {
+      frame.data = buffer.data() + pos;
+      frame.length = len;
+      frame.offset = bufferOffset + pos;
+      frame.ascii = isAscii;
+      if (isAscii)
+         numAscii++;
+      else
+         numBinary++;
+      idCounts[frame.getId()]++;
+      inSync = true;
+      pos += len;
+   }
+
+
+   //---------------------------------------------------------------------------
+   bool AshtechFramer::next(Frame& frame)
+   {
+      const string& preamble = AshtechData::preamble;
+
+      while (pos < buffer.size())
+      {
+         const char* b = buffer.data();
+         size_t n = buffer.size();
+
+            // Skip to the start of a message.
+         const char* p = static_cast<const char*>(
+            memchr(b + pos, preamble[0], n - pos));
+         if (p == NULL)
+         {
+            discard(n - pos);
+            break;
+         }
+         discard(p - (b + pos));
+
+         size_t avail = n - pos;
+         if (avail < headerLength)
+         {
+               // Not enough to tell if this is a message, but it can
+               // at least be ruled out if what's there doesn't match.
+            size_t cmp = min(avail, preamble.length());
+            if (preamble.compare(0, cmp, p, cmp) != 0)
+            {
+               discard(1);
+               continue;
+            }
+            if (finished)
+               discard(avail);
+            break;
+         }
+         if (preamble.compare(0, preamble.length(), p, preamble.length()) != 0
+             || p[headerLength-1] != ',')
+         {
+            discard(1);
+            continue;
+         }
+
+            // Messages of known binary length are framed by it.
+         size_t binLen = getBinaryLength(p + 7);
+         if (binLen && avail >= binLen && p[binLen-2] == '\r' &&
+             p[binLen-1] == '\n')
+         {
+            emit(frame, binLen, false);
+            return true;
+         }
+
+            // Look for the end of an ASCII message.  A '$' means the
+            // message was cut short by the start of another.
+         size_t i = headerLength;
+         while (i < avail && p[i] >= ' ' && p[i] <= '~' && p[i] != '$')
+            i++;
+         if (i + 1 < avail && p[i] == '\r' && p[i+1] == '\n')
+         {
+            emit(frame, i + 2, true);
+            return true;
+         }
+         if (i + 1 >= avail && (i == avail || p[i] == '\r'))
+         {
+               // need more data
+            if (finished)
+               discard(avail);
+            break;
+         }
+
+            // Binary data.  A '$' in it needn't be the start of
+            // another message.
+         if (binLen)
+         {
+            if (avail < binLen && !finished)
+               break;
+               // wrong length or a bad trailer
+            discard(1);
+            continue;
+         }
+         if (p[i] == '$')
+         {
+            discard(1);
+            continue;
+         }
+
+            // Not of known length, so the message ends where the next
+            // one starts.
+         size_t end = 0;
+         bool partial = false;
+         const char* q = p + headerLength;
+         while ((q = static_cast<const char*>(
+                    memchr(q, preamble[0], p + avail - q))) != NULL)
+         {
+            size_t j = q - p;
+            size_t cmp = min(preamble.length(), avail - j);
+            if (p[j-2] == '\r' && p[j-1] == '\n' &&
+                preamble.compare(0, cmp, q, cmp) == 0)
+            {
+               if (cmp == preamble.length() || finished)
+                  end = j;
+               else
+                  partial = true;
+               break;
+            }
+            q++;
+         }
+         if (end == 0 && finished && !partial && p[avail-2] == '\r' &&
+             p[avail-1] == '\n')
+         {
+            end = avail;
+         }
+         if (end == 0)
+         {
+            if (finished)
+               discard(avail);
+            break;
+         }
+         emit(frame, end, false);
+         return true;
+      }
+
+      return false;
+   }
+
+
+   //---------------------------------------------------------------------------
+   void AshtechFramer::dumpStats(ostream& s) const
+   {
+      s << "messages:" << getNumMessages()
+        << " ascii:" << numAscii
+        << " binary:" << numBinary
+        << " resyncs:" << numResyncs
+        << " discarded bytes:" << numDiscarded << endl;
+      map<string, unsigned long>::const_iterator i;
+      for (i = idCounts.begin(); i != idCounts.end(); i++)
+         s << "  " << i->first << ": " << i->second << endl;
+   }
+} // namespace gnsstk
@@ -0,0 +1,215 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file AshtechFramer.hpp
+ * gnsstk::AshtechFramer - Locate Ashtech messages in a buffer of raw data.
+ */
+
+#ifndef ASHTECHFRAMER_HPP
+#define ASHTECHFRAMER_HPP
+
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace gnsstk
+{
+   /**
+    * Find the boundaries of Ashtech messages in raw receiver data,
+    * as an alternative to AshtechStream for high rate data.  Data is
+    * added in whatever pieces it arrives in and each complete
+    * message is returned as a pointer into the framer's buffer,
+    * which can be given to the decode(const char*, size_t) method of
+    * the matching AshtechData class.  Because the objects being
+    * decoded into are reused and no message is copied, there is no
+    * allocation per message.
+    *
+    * Messages with a known binary length (MPC, MCA, PBN, EPB and ALB
+    * by default) are framed by length and checked for the trailer.
+    * ASCII messages end at the first CR LF.  Other messages end
+    * where the next one starts, as with AshtechStream.  Data that
+    * can't be framed is skipped a byte at a time until the next
+    * preamble, and counted in the statistics.
+    *
+    * @code
+    * AshtechFramer framer;
+    * AshtechFramer::Frame frame;
+    * AshtechMBEN mben;
+    * AshtechEPB epb;
+    * while (source.read(buff, sizeof(buff)) || source.gcount())
+    * {
+    *    framer.append(buff, source.gcount());
+    *    while (framer.next(frame))
+    *    {
+    *       if (frame.isId(AshtechMBEN::mpcId))
+    *          mben.decode(frame.data, frame.length);
+    *       else if (frame.isId(AshtechEPB::myId))
+    *          epb.decode(frame.data, frame.length);
+    *    }
+    * }
+    * @endcode
+    */
+   class AshtechFramer
+   {
+   public:
+         /// A message located by the framer.
+      class Frame
+      {
+      public:
+         Frame() : data(0), length(0), offset(0), ascii(false) {}
+
+            /// The three character message id, e.g. "MPC".
+         std::string getId() const
+         { return std::string(data+7, 3); }
+
+            /// Returns true if the message id is msgId.
+         bool isId(const char* msgId) const
+         { return std::memcmp(data+7, msgId, 3) == 0; }
+
+            /** The message from the preamble through the trailer.
+             * This is only valid until the next append(). */
+         const char* data;
+         size_t length;     ///< Number of bytes in the message.
+         uint64_t offset;   ///< Position of the message in the input.
+         bool ascii;        ///< True if the message was framed as ASCII.
+      };
+
+         /// Number of bytes in the preamble and id, e.g. "$PASHR,MPC,"
+      static const size_t headerLength = 11;
+
+      AshtechFramer();
+
+         /** Add data to be framed.  This invalidates the data
+          * pointers of any frames already returned.
+          * @param[in] data the bytes received.
+          * @param[in] len the number of bytes received.
+          */
+      void append(const char* data, size_t len);
+
+         /** Indicate that no more data will be added.  A message that
+          * can only be framed by finding the start of the next one is
+          * then taken to end at the end of the data, and anything
+          * else left over is discarded.
+          */
+      void finish();
+
+         /// Discard all data and statistics, to start over.
+      void reset();
+
+         /** Get the next complete message.
+          * @param[out] frame the location of the message.
+          * @return false if more data is needed to find a message.
+          */
+      bool next(Frame& frame);
+
+         /** Set the length of a binary message, including the
+          * header and trailer, so it can be framed by length.
+          * @param[in] msgId the three character message id.
+          * @param[in] len the length of the message, or 0 to frame
+          *   it by looking for the next message instead.
+          */
+      void setBinaryLength(const std::string& msgId, size_t len);
+
+         /// Number of messages framed.
+      unsigned long getNumMessages() const
+      { return numAscii + numBinary; }
+
+         /// Number of messages framed as ASCII.
+      unsigned long getNumAscii() const
+      { return numAscii; }
+
+         /// Number of messages framed as binary.
+      unsigned long getNumBinary() const
+      { return numBinary; }
+
+         /// Number of bytes skipped because they couldn't be framed.
+      uint64_t getNumDiscarded() const
+      { return numDiscarded; }
+
+         /// Number of times framing was lost and data skipped.
+      unsigned long getNumResyncs() const
+      { return numResyncs; }
+
+         /// Number of messages framed for each message id.
+      const std::map<std::string, unsigned long>& getIdCounts() const
+      { return idCounts; }
+
+         /// Number of bytes received that haven't been framed yet.
+      size_t getNumBuffered() const
+      { return buffer.size() - pos; }
+
+         /// Write the framing statistics to s.
+      void dumpStats(std::ostream& s) const;
+
+   private:
+         /// Binary length of msgId, or 0 if it isn't known.
+      size_t getBinaryLength(const char* msgId) const;
+
+         /// Skip n bytes that can't be framed.
+      void discard(size_t n);
+
+         /// Fill in frame with the len bytes at pos and move past them.
+      void emit(Frame& frame, size_t len, bool isAscii);
+
+         /// Message ids with their binary lengths.
+      struct BinaryLength
+      {
+         char id[3];
+         size_t length;
+      };
+      std::vector<BinaryLength> binaryLengths;
+
+      std::string buffer;       ///< Data received.
+      size_t pos;               ///< Start of unframed data in buffer.
+      uint64_t bufferOffset;    ///< Position of buffer[0] in the input.
+      bool finished;            ///< True when no more data will be added.
+      bool inSync;              ///< False while data is being skipped.
+
+      unsigned long numAscii;
+      unsigned long numBinary;
+      uint64_t numDiscarded;
+      unsigned long numResyncs;
+      std::map<std::string, unsigned long> idCounts;
+   }; // class AshtechFramer
+} // namespace gnsstk
+
+#endif
@@ -76,67 +76,77 @@ namespace gnsstk
    //---------------------------------------------------------------------------
    void AshtechMBEN::decode(const std::string& data)
    {
-      using gnsstk::BinUtils::decodeVar;
+      decode(data.data(), data.size());
+   }
+
+
+   //---------------------------------------------------------------------------
+   void AshtechMBEN::decode(const char* data, size_t len)
+   {
+      using gnsstk::BinUtils::buntohs;
 
-      string str(data);
+      clear(fmtbit | lenbit | crcbit);
+      if (len < 11)
+         return;
+      id.assign(data+7, 3);
+      header.assign(data, 11);
 
       uint8_t csum=0;
-      if (str.length() == 108 || str.length()==52)
+      if (len == 108 || len==52)
       {
          ascii=false;
-         header = str.substr(0,11); str.erase(0,11);
-
-         seq    = decodeVar<uint16_t>(str);
-         left   = decodeVar<uint8_t>(str);
-         svprn  = decodeVar<uint8_t>(str);
-         el     = decodeVar<uint8_t>(str);
-         az     = decodeVar<uint8_t>(str);
-         chid   = decodeVar<uint8_t>(str);
-
-         ca.decodeBIN(str);
+         if (id == mpcId && len != 108)
+            return;
+
+         const char* p = data + 11;
+         uint16_t u16;
+         buntohs(p, u16);
+         seq    = u16;
+         left   = static_cast<uint8_t>(p[2]);
+         svprn  = static_cast<uint8_t>(p[3]);
+         el     = static_cast<uint8_t>(p[4]);
+         az     = static_cast<uint8_t>(p[5]);
+         chid   = static_cast<uint8_t>(p[6]);
+         p += 7;
+
+         ca.decodeBIN(p);
 
          if (id == mpcId)
          {
-            p1.decodeBIN(str);
-            p2.decodeBIN(str);
+            p1.decodeBIN(p);
+            p2.decodeBIN(p);
          }
 
-         checksum = decodeVar<uint8_t>(str);
+         checksum = static_cast<uint8_t>(*p);
 
          clear();
 
-         int end = data.size() - 3;
+         int end = len - 3;
          for (int i=11; i<end; i++)
             csum ^= data[i];
       }
       else
       {
          ascii=true;
-         header = str.substr(0,11); str.erase(0,11);
-         stringstream iss(str);
-         char c;
-         iss >> seq >> c
-             >> left >> c
-             >> svprn >> c
-             >> el >> c
-             >> az >> c
-             >> chid >> c;
-
-         ca.decodeASCII(iss);
-
-         if (id == mpcId)
-         {
-            p1.decodeASCII(iss);
-            p2.decodeASCII(iss);
-         }
-
-         iss >> checksum;
-
-         if (iss)
+         const char *p = data + 11, *end = data + len;
+         bool ok = getField(p, end, seq) &&
+            getField(p, end, left) &&
+            getField(p, end, svprn) &&
+            getField(p, end, el) &&
+            getField(p, end, az) &&
+            getField(p, end, chid) &&
+            ca.decodeASCII(p, end);
+
+         if (ok && id == mpcId)
+            ok = p1.decodeASCII(p, end) && p2.decodeASCII(p, end);
+
+         if (ok && getField(p, end, checksum))
             clear();
 
-         int end=data.rfind(',');
-         for (int i=11; i<=end; i++)
+         int last = len - 1;
+         while (last >= 0 && data[last] != ',')
+            last--;
+         for (int i=11; i<=last; i++)
             csum ^= data[i];
       }
 
@@ -176,6 +186,50 @@ namespace gnsstk
    }
 
 
+   //---------------------------------------------------------------------------
+   bool AshtechMBEN::code_block::decodeASCII(const char*& p, const char* end)
+   {
+      bool ok = getField(p, end, warning) &&
+         getField(p, end, goodbad) &&
+         getField(p, end, polarity_known) &&
+         getField(p, end, ireg) &&
+         getField(p, end, qa_phase) &&
+         getField(p, end, full_phase) &&
+         getField(p, end, raw_range) &&
+         getField(p, end, doppler) &&
+         getField(p, end, smoothing) &&
+         getField(p, end, smooth_cnt);
+
+      raw_range *= 1e-3; //convert ms to sec
+      return ok;
+   }
+
+
+   //---------------------------------------------------------------------------
+   void AshtechMBEN::code_block::decodeBIN(const char*& p)
+   {
+      using gnsstk::BinUtils::buntohd;
+      using gnsstk::BinUtils::buntohsl;
+      using gnsstk::BinUtils::buntohl;
+      int32_t dop;
+      uint32_t smo;
+      warning        = static_cast<uint8_t>(p[0]);
+      goodbad        = static_cast<uint8_t>(p[1]);
+      polarity_known = static_cast<uint8_t>(p[2]);
+      ireg           = static_cast<uint8_t>(p[3]);
+      qa_phase       = static_cast<uint8_t>(p[4]);
+      buntohd(p, full_phase, 5);
+      buntohd(p, raw_range, 13);
+      buntohsl(p, dop, 21);
+      buntohl(p, smo, 25);
+      p += 29;
+
+      doppler = dop * 1e-4;
+      smoothing = (smo & 0x800000 ? -1e-3 : 1e-3) * (smo & 0x7fffff);
+      smooth_cnt = (smo >> 24) & 0xff;
+   }
+
+
    //---------------------------------------------------------------------------
    void AshtechMBEN::code_block::decodeBIN(string& str)
    {
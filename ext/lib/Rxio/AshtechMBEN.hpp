@@ -112,6 +112,16 @@ namespace gnsstk
              * @throw FFStreamError
              */
          virtual void decodeBIN(std::string& str);
+
+            /** Decode a code block from the ASCII fields at p.
+             * @param[in,out] p the first field, moved past the block.
+             * @param[in] end the end of the message.
+             * @return false if a field couldn't be decoded. */
+         bool decodeASCII(const char*& p, const char* end);
+
+            /** Decode a code block from the 29 binary bytes at p.
+             * @param[in,out] p the first byte, moved past the block. */
+         void decodeBIN(const char*& p);
             /** Translate the ireg value to an SNR in dB*Hz.
              * @param[in] chipRate The chipping rate of the code.
              * @param[in] magnitude The magnitude of the carrier estimate.
@@ -151,6 +161,10 @@ namespace gnsstk
              */
       virtual void decode(const std::string& data) ;
 
+         /// Decode in place from a framed message, len bytes from the
+         /// preamble through the trailer (see AshtechFramer).
+      virtual void decode(const char* data, size_t len);
+
    protected:
             /**
              * @throw std::exception
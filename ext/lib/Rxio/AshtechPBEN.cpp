@@ -76,35 +76,54 @@ namespace gnsstk
    //---------------------------------------------------------------------------
    void AshtechPBEN::decode(const std::string& data)
    {
-      using gnsstk::BinUtils::decodeVar;
+      decode(data.data(), data.size());
+   }
+
+
+   //---------------------------------------------------------------------------
+   void AshtechPBEN::decode(const char* data, size_t len)
+   {
+      using gnsstk::BinUtils::buntohsl;
+      using gnsstk::BinUtils::buntohd;
+      using gnsstk::BinUtils::buntohf;
+      using gnsstk::BinUtils::buntohs;
+
+      clear(fmtbit | lenbit | crcbit);
+      if (len < 11)
+         return;
+      id.assign(data+7, 3);
+      header.assign(data, 11);
 
-      string str(data);
-      if (str.length() == 69)
+      if (len == 69)
       {
          ascii=false;
-         header      = str.substr(0,11); str.erase(0,11);
-         sow         = 1e-3 * decodeVar<int32_t>(str);
-         sitename    = str.substr(0,4); str.erase(0,4);
-         navx        = decodeVar<double>(str);
-         navy        = decodeVar<double>(str);
-         navz        = decodeVar<double>(str);
-         navt        = decodeVar<float>(str);
-         navxdot     = decodeVar<float>(str);
-         navydot     = decodeVar<float>(str);
-         navzdot     = decodeVar<float>(str);
-         navtdot     = decodeVar<float>(str);
-         pdop        = decodeVar<uint16_t>(str);
+         const char* p = data + 11;
+         int32_t msec;
+         uint16_t u16;
+         buntohsl(p, msec, 0);
+         sow         = 1e-3 * msec;
+         sitename.assign(p+4, 4);
+         buntohd(p, navx, 8);
+         buntohd(p, navy, 16);
+         buntohd(p, navz, 24);
+         buntohf(p, navt, 32);
+         buntohf(p, navxdot, 36);
+         buntohf(p, navydot, 40);
+         buntohf(p, navzdot, 44);
+         buntohf(p, navtdot, 48);
+         buntohs(p, u16, 52);
+         pdop        = u16;
          lat =  lon =  alt =  numSV =  hdop =  vdop =  tdop = 0;
+         buntohs(p, checksum, 54);
 
-         checksum = decodeVar<uint16_t>(str);
          clear();
 
          uint16_t csum=0;
-         int len=data.size()-3-11;
-         string body(data.substr(11, len));
-         while (body.size()>1)
-            csum += decodeVar<uint16_t>(body);
-
+         for (unsigned i=0; i+1<len-3-11; i+=2)
+         {
+            buntohs(p, u16, i);
+            csum += u16;
+         }
          if (csum != checksum)
          {
             setstate(crcbit);
@@ -112,29 +131,39 @@ namespace gnsstk
                cout << "checksum error, computed:" << hex << csum
                     << " received:" << checksum << dec << endl;
          }
-
       }
       else
       {
          ascii=true;
-         header = str.substr(0,11); str.erase(0,11);
-         stringstream iss(str);
+         const char *p = data + 11, *end = data + len;
          double latMin,lonMin;
-         char c;
-         iss >> sow >> c
-             >> navx>> c >> navy >> c >> navz >> c
-             >> lat >> c >> latMin >> c >> lon >> c >> lonMin >> c >> alt >> c
-             >> navxdot>> c  >> navydot>> c  >> navzdot >> c
-             >> numSV >> c;
-         getline(iss, sitename, ',');
-         iss >> pdop>> c  >> hdop>> c  >> vdop>> c  >> tdop;
+         bool ok = getField(p, end, sow) &&
+            getField(p, end, navx) &&
+            getField(p, end, navy) &&
+            getField(p, end, navz) &&
+            getField(p, end, lat) &&
+            getField(p, end, latMin) &&
+            getField(p, end, lon) &&
+            getField(p, end, lonMin) &&
+            getField(p, end, alt) &&
+            getField(p, end, navxdot) &&
+            getField(p, end, navydot) &&
+            getField(p, end, navzdot) &&
+            getField(p, end, numSV) &&
+            getField(p, end, sitename) &&
+            getField(p, end, pdop) &&
+            getField(p, end, hdop) &&
+            getField(p, end, vdop) &&
+            getField(p, end, tdop);
 
          // Note that there isn't a checksum on the PBNs
-
-         lat += latMin / 60;
-         lon += lonMin / 60;
+         if (ok)
+         {
+            lat += latMin / 60;
+            lon += lonMin / 60;
+         }
          navt = navtdot = 0;
-         if (iss)
+         if (ok)
             clear();
       }
 
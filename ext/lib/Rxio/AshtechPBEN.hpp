@@ -92,6 +92,10 @@ namespace gnsstk
           */
       virtual void decode(const std::string& data);
 
+         /// Decode in place from a framed message, len bytes from the
+         /// preamble through the trailer (see AshtechFramer).
+      virtual void decode(const char* data, size_t len);
+
    protected:
          /**
           * @throw std::exception